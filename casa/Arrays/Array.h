@@ -654,6 +654,14 @@ public:
     virtual void takeStorage(const IPosition &shape, const T *storage);
     // </group>
 
+    // Reference the data values in the pointer <src>storage</src> without
+    // copying them. The object <src>owner</src> is kept alive as long as
+    // an array uses the storage, so it can be used to keep the data
+    // alive (e.g. a memory-mapped file). After shareStorage() is called,
+    // <src>nrefs()</src> is 1.
+    void shareStorage(const IPosition &shape, T *storage,
+                      const std::shared_ptr<const void>& owner);
+
 
     // Used to iterate through Arrays. Derived classes VectorIterator and
     // MatrixIterator are probably more useful.
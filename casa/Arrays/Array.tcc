@@ -1090,6 +1090,23 @@ void Array<T>::takeStorage(const IPosition &shape, T *storage,
   postTakeStorage();
 }
 
+template<class T>
+void Array<T>::shareStorage(const IPosition &shape, T *storage,
+                            const std::shared_ptr<const void>& owner)
+{
+  preTakeStorage(shape);
+  size_t new_nels = shape.product();
+  // The deleter holds a reference to the owner of the data.
+  data_p = std::shared_ptr<arrays_internal::Storage<T>>
+    (arrays_internal::Storage<T>::MakeFromSharedData(storage, new_nels).release(),
+     [owner](arrays_internal::Storage<T>* st) { delete st; });
+  ArrayBase::assign(ArrayBase(shape));
+  begin_p = data_p->data();
+  setEndIter();
+  assert(ok());
+  postTakeStorage();
+}
+
 template<class T>
 void Array<T>::takeStorage(const IPosition &shape, const T *storage)
 {
@@ -94,6 +94,10 @@ void imag(Array<double> &rarray, const Array<std::complex<double>> &carray)
 void amplitude(Array<float> &rarray, const Array<std::complex<float>> &carray)
 {
   checkArrayShapes (carray, rarray, "amplitude");
+  if (carray.contiguousStorage()  &&  rarray.contiguousStorage()) {
+    arrays_internal::simdAmplitude (carray.data(), rarray.data(), carray.nelements());
+    return;
+  }
   arrayTransform (carray, rarray, std::abs<float>);
 }
 
@@ -27,6 +27,7 @@
 #define CASA_ARRAYMATH_2_H
 
 #include "Array.h"
+#include "ArrayMathSimd.h"
 
 #include <algorithm>
 #include <cassert>
@@ -62,6 +63,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <br>The transform functions distinguish between contiguous and non-contiguous
 // arrays because iterating through a contiguous array can be done in a faster
 // way.
+// <br>For contiguous float, double, and complex arrays the basic arithmetic
+// (+, -, *, /), min/max, sqrt, abs and the amplitude of Complex values use
+// the vectorized kernels in ArrayMathSimd.h (AVX2 or AVX-512 if available).
+// They give the same results as the scalar operations. The functions
+// fastSum and fastMean use a vectorized sum with a different rounding.
+// The phase and the amplitude of DComplex values are not vectorized,
+// because they use atan2 and hypot which have no vector instructions.
 // <br> Similar to the standard transform function these functions do not check
 // if the shapes match. The user is responsible for that.
 // </synopsis>
@@ -185,6 +193,14 @@ inline void arrayContTransform (const Array<L>& left, const Array<R>& right,
                                 Array<RES>& result, BinaryOperator op)
 {
   assert (result.contiguousStorage());
+  if constexpr (arrays_internal::simdBinaryOp<L,R,RES,BinaryOperator>()) {
+    if (left.contiguousStorage()  &&  right.contiguousStorage()) {
+      arrays_internal::simdBinary
+        (arrays_internal::SimdOpOf<L,BinaryOperator>::value,
+         left.data(), right.data(), result.data(), result.nelements());
+      return;
+    }
+  }
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
     std::transform (left.cbegin(), left.cend(), right.cbegin(),
                     result.cbegin(), op);
@@ -201,6 +217,14 @@ inline void arrayContTransform (const Array<L>& left, R right,
                                 Array<RES>& result, BinaryOperator op)
 {
   assert (result.contiguousStorage());
+  if constexpr (arrays_internal::simdBinaryOp<L,R,RES,BinaryOperator>()) {
+    if (left.contiguousStorage()) {
+      arrays_internal::simdBinary
+        (arrays_internal::SimdOpOf<L,BinaryOperator>::value,
+         left.data(), right, result.data(), result.nelements());
+      return;
+    }
+  }
   if (left.contiguousStorage()) {
     myrtransform (left.cbegin(), left.cend(),
                  result.cbegin(), right, op);
@@ -221,6 +245,14 @@ inline void arrayContTransform (L left, const Array<R>& right,
                                 Array<RES>& result, BinaryOperator op)
 {
   assert (result.contiguousStorage());
+  if constexpr (arrays_internal::simdBinaryOp<L,R,RES,BinaryOperator>()) {
+    if (right.contiguousStorage()) {
+      arrays_internal::simdBinary
+        (arrays_internal::SimdOpOf<L,BinaryOperator>::value,
+         left, right.data(), result.data(), result.nelements());
+      return;
+    }
+  }
   if (right.contiguousStorage()) {
     myltransform (right.cbegin(), right.cend(),
                   result.cbegin(), left, op);
@@ -299,6 +331,14 @@ template<typename L, typename R, typename BinaryOperator>
 inline void arrayTransformInPlace (Array<L>& left, const Array<R>& right,
                                    BinaryOperator op)
 {
+  if constexpr (arrays_internal::simdBinaryOp<L,R,L,BinaryOperator>()) {
+    if (left.contiguousStorage()  &&  right.contiguousStorage()) {
+      arrays_internal::simdBinary
+        (arrays_internal::SimdOpOf<L,BinaryOperator>::value,
+         left.data(), right.data(), left.data(), left.nelements());
+      return;
+    }
+  }
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
     std::transform(left.cbegin(), left.cend(), right.cbegin(), left.cbegin(), op);
   } else {
@@ -311,6 +351,14 @@ inline void arrayTransformInPlace (Array<L>& left, const Array<R>& right,
 template<typename L, typename R, typename BinaryOperator>
 inline void arrayTransformInPlace (Array<L>& left, R right, BinaryOperator op)
 {
+  if constexpr (arrays_internal::simdBinaryOp<L,R,L,BinaryOperator>()) {
+    if (left.contiguousStorage()) {
+      arrays_internal::simdBinary
+        (arrays_internal::SimdOpOf<L,BinaryOperator>::value,
+         left.data(), right, left.data(), left.nelements());
+      return;
+    }
+  }
   if (left.contiguousStorage()) {
     myiptransform (left.cbegin(), left.cend(), right, op);
     ////    transformInPlace (left.cbegin(), left.cend(), bind2nd(op, right));
@@ -613,7 +661,18 @@ template<typename T> inline Vector<T> indgen(size_t length, T start, T inc)
 
 
 // Sum of every element of the array.
+// The elements are added in order, so the result does not depend on the
+// platform or instruction set.
 template<typename T> T sum(const Array<T> &a);
+
+// Fast sum of every element of the array.
+// For a contiguous float, double or complex array the elements are
+// accumulated in 16 (float) or 8 (double) partial sums using vector
+// instructions (see ArrayMathSimd.h). It is usually more accurate than
+// <src>sum</src>, but the rounding differs, thus the result can differ in
+// the last bits. The result is the same for all instruction sets.
+// Other arrays use <src>sum</src>.
+template<typename T> T fastSum(const Array<T> &a);
 // 
 // Sum the square of every element of the array.
 template<typename T> T sumsqr(const Array<T> &a);
@@ -627,6 +686,10 @@ template<typename T> T product(const Array<T> &a);
 // of elements of "a".
 template<typename T> T mean(const Array<T> &a);
 
+// The fast mean of "a" is <src>fastSum(a)</src> divided by the number of
+// elements of "a". It can differ in the last bits from <src>mean</src>.
+template<typename T> T fastMean(const Array<T> &a);
+
 // The variance of "a" is the sum of (a(i) - mean(a))**2/(a.nelements() - ddof).
 // Similar to numpy the argument ddof (delta degrees of freedom) tells if the
 // population variance (ddof=0) or the sample variance (ddof=1) is taken.
@@ -597,6 +597,13 @@ template<typename T> void minMax(T &minVal, T &maxVal, const Array<T> &array)
     throw(ArrayError("void minMax(T &min, T &max, const Array<T> &array) - "
                      "Array has no elements"));	
   }
+  if constexpr (std::is_same<T,float>::value  ||  std::is_same<T,double>::value) {
+    if (array.contiguousStorage()) {
+      arrays_internal::simdMinMax (minVal, maxVal, array.data(),
+                                   array.nelements());
+      return;
+    }
+  }
   if (array.contiguousStorage()) {
     // minimal scope as some compilers may spill onto stack otherwise
     T minv = array.data()[0];
@@ -757,6 +764,13 @@ template<typename T> Array<T> sinh(const Array<T> &a)
 
 template<typename T> Array<T> sqrt(const Array<T> &a)
 {
+    if constexpr (std::is_same<T,float>::value  ||  std::is_same<T,double>::value) {
+      if (a.contiguousStorage()) {
+        Array<T> res(a.shape());
+        arrays_internal::simdSqrt (a.data(), res.data(), a.nelements());
+        return res;
+      }
+    }
     return arrayTransformResult (a, [](T a){ return std::sqrt(a);});
 }
 
@@ -797,6 +811,13 @@ template<typename T> Array<T> fabs(const Array<T> &a)
 
 template<typename T> Array<T> abs(const Array<T> &a)
 {
+    if constexpr (std::is_same<T,float>::value  ||  std::is_same<T,double>::value) {
+      if (a.contiguousStorage()) {
+        Array<T> res(a.shape());
+        arrays_internal::simdAbs (a.data(), res.data(), a.nelements());
+        return res;
+      }
+    }
     return arrayTransformResult (a, [](T t){ return std::abs(t); });
 }
 
@@ -920,6 +941,16 @@ template<typename T> T sum(const Array<T> &a)
     std::accumulate(a.begin(),  a.end(),  T(), std::plus<T>());
 }
 
+template<typename T> T fastSum(const Array<T> &a)
+{
+  if constexpr (arrays_internal::SimdType<T>::value) {
+    if (a.contiguousStorage()) {
+      return arrays_internal::simdSum (a.data(), a.nelements());
+    }
+  }
+  return sum(a);
+}
+
 template<typename T> T sumsqr(const Array<T> &a)
 {
   auto sumsqr = [](T left, T right) { return left + right*right;};
@@ -960,6 +991,17 @@ template<typename T> T mean(const Array<T> &a)
     return T(sum(a)/T(1.0*a.nelements()));
 }
 
+// <thrown>
+//    </item> ArrayError
+// </thrown>
+template<typename T> T fastMean(const Array<T> &a)
+{
+    if (a.empty()) {
+	throw(ArrayError("::fastMean(const Array<T> &) - 0 element array"));
+    }
+    return T(fastSum(a)/T(1.0*a.nelements()));
+}
+
 // <thrown>
 //    </item> ArrayError
 // </thrown>
@@ -0,0 +1,780 @@
+//# ArrayMathSimd.cc: Vectorized kernels for contiguous array math
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include "ArrayMathSimd.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define CASA_ARRAYSIMD_X86
+#define CASA_TARGET_AVX2   __attribute__((target("avx2")))
+#define CASA_TARGET_AVX512 __attribute__((target("avx512f")))
+#define CASA_ALWAYS_INLINE inline __attribute__((always_inline))
+//# The vector arguments of the inlined kernel functions do not affect the ABI.
+#pragma GCC diagnostic ignored "-Wpsabi"
+#else
+#define CASA_ALWAYS_INLINE inline
+#endif
+
+namespace casacore {
+namespace arrays_internal {
+
+namespace {
+
+// The number of partial sums used by simdSum. It is a fixed number
+// (the width of an AVX-512 register) making the result independent of
+// the instruction set used.
+template<typename T> struct SumLanes
+  { static constexpr int value = 64 / sizeof(T); };
+
+// Vector of W elements of type T. The generic kernels below are written
+// in terms of it and get inlined in functions compiled for the various
+// instruction sets. A vector of 1 element is the scalar itself.
+// <group>
+template<typename T, int W> struct Vec;
+template<typename T> struct Vec<T,1>
+  { typedef T type; };
+#ifdef CASA_ARRAYSIMD_X86
+template<typename T, int W> struct Vec
+  { typedef T type __attribute__((vector_size(W*sizeof(T)))); };
+#endif
+// </group>
+
+// Integer type with the size of T.
+template<typename T> struct IntOf;
+template<> struct IntOf<float>  { typedef int32_t type; };
+template<> struct IntOf<double> { typedef int64_t type; };
+
+template<typename V, typename T>
+CASA_ALWAYS_INLINE V vload (const T* ptr)
+{
+  V v;
+  memcpy (&v, ptr, sizeof(V));
+  return v;
+}
+
+template<typename V, typename T>
+CASA_ALWAYS_INLINE void vstore (T* ptr, const V& v)
+{
+  memcpy (ptr, &v, sizeof(V));
+}
+
+template<SimdOp OP, typename V>
+CASA_ALWAYS_INLINE V applyOp (V left, V right)
+{
+  if constexpr (OP == SimdOp::Plus) {
+    return left + right;
+  } else if constexpr (OP == SimdOp::Minus) {
+    return left - right;
+  } else if constexpr (OP == SimdOp::Multiplies) {
+    return left * right;
+  } else {
+    return left / right;
+  }
+}
+
+// Apply the operator to two arrays.
+template<typename T, int W, SimdOp OP>
+CASA_ALWAYS_INLINE void kernelBinary (const T* left, const T* right,
+                                      T* result, size_t n)
+{
+  typedef typename Vec<T,W>::type V;
+  size_t i = 0;
+  for (; i+W <= n; i+=W) {
+    vstore (result+i, applyOp<OP> (vload<V>(left+i), vload<V>(right+i)));
+  }
+  for (; i<n; ++i) {
+    result[i] = applyOp<OP> (left[i], right[i]);
+  }
+}
+
+// Apply the operator to an array and a scalar given as a pattern of
+// 16 values alternating with period 2 (to handle complex scalars as well).
+template<typename T, int W, SimdOp OP, bool SCALARLEFT>
+CASA_ALWAYS_INLINE void kernelPattern (const T* arr, const T* pattern,
+                                       T* result, size_t n)
+{
+  size_t i = 0;
+  // A single element cannot hold the pattern, so use the scalar loop.
+  if constexpr (W > 1) {
+    typedef typename Vec<T,W>::type V;
+    const V pv = vload<V>(pattern);
+    for (; i+W <= n; i+=W) {
+      if constexpr (SCALARLEFT) {
+        vstore (result+i, applyOp<OP> (pv, vload<V>(arr+i)));
+      } else {
+        vstore (result+i, applyOp<OP> (vload<V>(arr+i), pv));
+      }
+    }
+  }
+  for (; i<n; ++i) {
+    if constexpr (SCALARLEFT) {
+      result[i] = applyOp<OP> (pattern[i%2], arr[i]);
+    } else {
+      result[i] = applyOp<OP> (arr[i], pattern[i%2]);
+    }
+  }
+}
+
+// Sum the values into the SumLanes partial sums.
+template<typename T, int W>
+CASA_ALWAYS_INLINE void kernelSum (const T* data, size_t n, T* lanes)
+{
+  typedef typename Vec<T,W>::type V;
+  constexpr int NL = SumLanes<T>::value;
+  constexpr int NV = NL / W;
+  V acc[NV];
+  for (int k=0; k<NV; ++k) {
+    acc[k] = V() + T(0);
+  }
+  size_t i = 0;
+  for (; i+NL <= n; i+=NL) {
+    for (int k=0; k<NV; ++k) {
+      acc[k] += vload<V>(data + i + k*W);
+    }
+  }
+  memcpy (lanes, acc, sizeof(acc));
+  for (int j=0; i<n; ++i, ++j) {
+    lanes[j] += data[i];
+  }
+}
+
+// Get the min and max using the same comparisons as the scalar code.
+template<typename T, int W>
+CASA_ALWAYS_INLINE void kernelMinMax (T& minVal, T& maxVal,
+                                      const T* data, size_t n)
+{
+  typedef typename Vec<T,W>::type V;
+  V minv = V() + data[0];
+  V maxv = minv;
+  size_t i = 0;
+  for (; i+W <= n; i+=W) {
+    V v = vload<V>(data+i);
+    minv = v < minv ? v : minv;
+    maxv = v > maxv ? v : maxv;
+  }
+  T mins[W], maxs[W];
+  vstore (mins, minv);
+  vstore (maxs, maxv);
+  T minr = mins[0];
+  T maxr = maxs[0];
+  for (int j=1; j<W; ++j) {
+    if (mins[j] < minr) minr = mins[j];
+    if (maxs[j] > maxr) maxr = maxs[j];
+  }
+  for (; i<n; ++i) {
+    if (data[i] < minr) minr = data[i];
+    if (data[i] > maxr) maxr = data[i];
+  }
+  minVal = minr;
+  maxVal = maxr;
+}
+
+// Clear the sign bit.
+template<typename T, int W>
+CASA_ALWAYS_INLINE void kernelAbs (const T* data, T* result, size_t n)
+{
+  typedef typename IntOf<T>::type I;
+  typedef typename Vec<I,W>::type VI;
+  const VI mask = VI() + std::numeric_limits<I>::max();
+  size_t i = 0;
+  for (; i+W <= n; i+=W) {
+    vstore (result+i, vload<VI>(data+i) & mask);
+  }
+  for (; i<n; ++i) {
+    result[i] = std::abs(data[i]);
+  }
+}
+
+#ifdef CASA_ARRAYSIMD_X86
+
+//# The functions for the various instruction sets.
+//# The generic kernels get compiled for the instruction set when inlined.
+
+template<typename T, SimdOp OP>
+CASA_TARGET_AVX512 void binary512 (const T* left, const T* right,
+                                   T* result, size_t n)
+  { kernelBinary<T, 64/sizeof(T), OP> (left, right, result, n); }
+template<typename T, SimdOp OP>
+CASA_TARGET_AVX2 void binary256 (const T* left, const T* right,
+                                 T* result, size_t n)
+  { kernelBinary<T, 32/sizeof(T), OP> (left, right, result, n); }
+
+template<typename T, SimdOp OP, bool SCALARLEFT>
+CASA_TARGET_AVX512 void pattern512 (const T* arr, const T* pattern,
+                                    T* result, size_t n)
+  { kernelPattern<T, 64/sizeof(T), OP, SCALARLEFT> (arr, pattern, result, n); }
+template<typename T, SimdOp OP, bool SCALARLEFT>
+CASA_TARGET_AVX2 void pattern256 (const T* arr, const T* pattern,
+                                  T* result, size_t n)
+  { kernelPattern<T, 32/sizeof(T), OP, SCALARLEFT> (arr, pattern, result, n); }
+
+template<typename T>
+CASA_TARGET_AVX512 void sum512 (const T* data, size_t n, T* lanes)
+  { kernelSum<T, 64/sizeof(T)> (data, n, lanes); }
+template<typename T>
+CASA_TARGET_AVX2 void sum256 (const T* data, size_t n, T* lanes)
+  { kernelSum<T, 32/sizeof(T)> (data, n, lanes); }
+
+template<typename T>
+CASA_TARGET_AVX512 void minMax512 (T& minVal, T& maxVal,
+                                   const T* data, size_t n)
+  { kernelMinMax<T, 64/sizeof(T)> (minVal, maxVal, data, n); }
+template<typename T>
+CASA_TARGET_AVX2 void minMax256 (T& minVal, T& maxVal,
+                                 const T* data, size_t n)
+  { kernelMinMax<T, 32/sizeof(T)> (minVal, maxVal, data, n); }
+
+template<typename T>
+CASA_TARGET_AVX512 void abs512 (const T* data, T* result, size_t n)
+  { kernelAbs<T, 64/sizeof(T)> (data, result, n); }
+template<typename T>
+CASA_TARGET_AVX2 void abs256 (const T* data, T* result, size_t n)
+  { kernelAbs<T, 32/sizeof(T)> (data, result, n); }
+
+CASA_TARGET_AVX512 void sqrt512 (const float* data, float* result, size_t n)
+{
+  size_t i = 0;
+  for (; i+16 <= n; i+=16) {
+    _mm512_storeu_ps (result+i, _mm512_sqrt_ps (_mm512_loadu_ps (data+i)));
+  }
+  for (; i<n; ++i) {
+    result[i] = std::sqrt(data[i]);
+  }
+}
+CASA_TARGET_AVX512 void sqrt512 (const double* data, double* result, size_t n)
+{
+  size_t i = 0;
+  for (; i+8 <= n; i+=8) {
+    _mm512_storeu_pd (result+i, _mm512_sqrt_pd (_mm512_loadu_pd (data+i)));
+  }
+  for (; i<n; ++i) {
+    result[i] = std::sqrt(data[i]);
+  }
+}
+CASA_TARGET_AVX2 void sqrt256 (const float* data, float* result, size_t n)
+{
+  size_t i = 0;
+  for (; i+8 <= n; i+=8) {
+    _mm256_storeu_ps (result+i, _mm256_sqrt_ps (_mm256_loadu_ps (data+i)));
+  }
+  for (; i<n; ++i) {
+    result[i] = std::sqrt(data[i]);
+  }
+}
+CASA_TARGET_AVX2 void sqrt256 (const double* data, double* result, size_t n)
+{
+  size_t i = 0;
+  for (; i+4 <= n; i+=4) {
+    _mm256_storeu_pd (result+i, _mm256_sqrt_pd (_mm256_loadu_pd (data+i)));
+  }
+  for (; i<n; ++i) {
+    result[i] = std::sqrt(data[i]);
+  }
+}
+
+// Multiply complex values using (ar*br - ai*bi, ar*bi + ai*br) as the
+// C++ operator does. Results with a NaN are recalculated by the C++
+// operator to handle infinities in the same way.
+// If scalarRight=True, only right[0] is used.
+// Nothing is read if n=0, because the arrays can then be null pointers.
+// FMA is not used to get the same results as the scalar code.
+CASA_TARGET_AVX2 void cmul256 (const std::complex<float>* left,
+                               const std::complex<float>* right,
+                               bool scalarRight,
+                               std::complex<float>* result, size_t n)
+{
+  const float* lp = reinterpret_cast<const float*>(left);
+  const float* rp = reinterpret_cast<const float*>(right);
+  float* resp = reinterpret_cast<float*>(result);
+  if (n == 0) {
+    return;
+  }
+  __m256 bs = _mm256_setr_ps (rp[0], rp[1], rp[0], rp[1],
+                              rp[0], rp[1], rp[0], rp[1]);
+  size_t i = 0;
+  for (; i+4 <= n; i+=4) {
+    __m256 a = _mm256_loadu_ps (lp + 2*i);
+    __m256 b = scalarRight ? bs : _mm256_loadu_ps (rp + 2*i);
+    __m256 res = _mm256_addsub_ps
+      (_mm256_mul_ps (_mm256_moveldup_ps(a), b),
+       _mm256_mul_ps (_mm256_movehdup_ps(a), _mm256_permute_ps (b, 0xb1)));
+    if (_mm256_movemask_ps (_mm256_cmp_ps (res, res, _CMP_UNORD_Q)) == 0) {
+      _mm256_storeu_ps (resp + 2*i, res);
+    } else {
+      for (size_t j=i; j<i+4; ++j) {
+        result[j] = left[j] * right[scalarRight ? 0 : j];
+      }
+    }
+  }
+  for (; i<n; ++i) {
+    result[i] = left[i] * right[scalarRight ? 0 : i];
+  }
+}
+CASA_TARGET_AVX2 void cmul256 (const std::complex<double>* left,
+                               const std::complex<double>* right,
+                               bool scalarRight,
+                               std::complex<double>* result, size_t n)
+{
+  const double* lp = reinterpret_cast<const double*>(left);
+  const double* rp = reinterpret_cast<const double*>(right);
+  double* resp = reinterpret_cast<double*>(result);
+  if (n == 0) {
+    return;
+  }
+  __m256d bs = _mm256_setr_pd (rp[0], rp[1], rp[0], rp[1]);
+  size_t i = 0;
+  for (; i+2 <= n; i+=2) {
+    __m256d a = _mm256_loadu_pd (lp + 2*i);
+    __m256d b = scalarRight ? bs : _mm256_loadu_pd (rp + 2*i);
+    __m256d res = _mm256_addsub_pd
+      (_mm256_mul_pd (_mm256_movedup_pd(a), b),
+       _mm256_mul_pd (_mm256_permute_pd (a, 0xf), _mm256_permute_pd (b, 0x5)));
+    if (_mm256_movemask_pd (_mm256_cmp_pd (res, res, _CMP_UNORD_Q)) == 0) {
+      _mm256_storeu_pd (resp + 2*i, res);
+    } else {
+      for (size_t j=i; j<i+2; ++j) {
+        result[j] = left[j] * right[scalarRight ? 0 : j];
+      }
+    }
+  }
+  for (; i<n; ++i) {
+    result[i] = left[i] * right[scalarRight ? 0 : i];
+  }
+}
+
+// The amplitude of a Complex is calculated in double precision, which is
+// what std::abs (i.e. hypotf) does, so the result is the same.
+CASA_TARGET_AVX2 void amplitude256 (const std::complex<float>* data,
+                                    float* result, size_t n)
+{
+  const float* dp = reinterpret_cast<const float*>(data);
+  size_t i = 0;
+  for (; i+4 <= n; i+=4) {
+    __m256 v = _mm256_loadu_ps (dp + 2*i);
+    __m256d lo = _mm256_cvtps_pd (_mm256_castps256_ps128 (v));
+    __m256d hi = _mm256_cvtps_pd (_mm256_extractf128_ps (v, 1));
+    // hadd gives the sums of squares in order 0,2,1,3.
+    __m256d sq = _mm256_hadd_pd (_mm256_mul_pd (lo, lo),
+                                 _mm256_mul_pd (hi, hi));
+    __m128 amp = _mm256_cvtpd_ps (_mm256_sqrt_pd (sq));
+    amp = _mm_permute_ps (amp, _MM_SHUFFLE(3,1,2,0));
+    _mm_storeu_ps (result+i, amp);
+    // A NaN can be the result of an infinite and a NaN value.
+    if (_mm_movemask_ps (_mm_cmpunord_ps (amp, amp)) != 0) {
+      for (size_t j=i; j<i+4; ++j) {
+        result[j] = std::abs(data[j]);
+      }
+    }
+  }
+  for (; i<n; ++i) {
+    result[i] = std::abs(data[i]);
+  }
+}
+#endif
+
+
+// Determine the highest level supported by the CPU.
+SimdLevel detectLevel()
+{
+#ifdef CASA_ARRAYSIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports ("avx512f")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports ("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+  return SimdLevel::Scalar;
+}
+
+std::atomic<int>& currentLevel()
+{
+  static std::atomic<int> level {int(simdMaxLevel())};
+  return level;
+}
+
+inline SimdLevel getLevel()
+{
+  return SimdLevel(currentLevel().load (std::memory_order_relaxed));
+}
+
+
+//# The dispatch functions choosing the kernel for the current level.
+
+template<typename T, SimdOp OP>
+void binaryReal (const T* left, const T* right, T* result, size_t n)
+{
+  switch (getLevel()) {
+#ifdef CASA_ARRAYSIMD_X86
+  case SimdLevel::AVX512:
+    binary512<T,OP> (left, right, result, n);
+    break;
+  case SimdLevel::AVX2:
+    binary256<T,OP> (left, right, result, n);
+    break;
+#endif
+  default:
+    kernelBinary<T,1,OP> (left, right, result, n);
+  }
+}
+
+template<typename T>
+void binaryReal (SimdOp op, const T* left, const T* right, T* result, size_t n)
+{
+  switch (op) {
+  case SimdOp::Plus:
+    binaryReal<T,SimdOp::Plus> (left, right, result, n);
+    break;
+  case SimdOp::Minus:
+    binaryReal<T,SimdOp::Minus> (left, right, result, n);
+    break;
+  case SimdOp::Multiplies:
+    binaryReal<T,SimdOp::Multiplies> (left, right, result, n);
+    break;
+  default:
+    binaryReal<T,SimdOp::Divides> (left, right, result, n);
+  }
+}
+
+template<typename T, SimdOp OP, bool SCALARLEFT>
+void patternReal (const T* arr, const T* pattern, T* result, size_t n)
+{
+  switch (getLevel()) {
+#ifdef CASA_ARRAYSIMD_X86
+  case SimdLevel::AVX512:
+    pattern512<T,OP,SCALARLEFT> (arr, pattern, result, n);
+    break;
+  case SimdLevel::AVX2:
+    pattern256<T,OP,SCALARLEFT> (arr, pattern, result, n);
+    break;
+#endif
+  default:
+    kernelPattern<T,1,OP,SCALARLEFT> (arr, pattern, result, n);
+  }
+}
+
+template<typename T, bool SCALARLEFT>
+void patternReal (SimdOp op, const T* arr, const T* pattern,
+                  T* result, size_t n)
+{
+  switch (op) {
+  case SimdOp::Plus:
+    patternReal<T,SimdOp::Plus,SCALARLEFT> (arr, pattern, result, n);
+    break;
+  case SimdOp::Minus:
+    patternReal<T,SimdOp::Minus,SCALARLEFT> (arr, pattern, result, n);
+    break;
+  case SimdOp::Multiplies:
+    patternReal<T,SimdOp::Multiplies,SCALARLEFT> (arr, pattern, result, n);
+    break;
+  default:
+    patternReal<T,SimdOp::Divides,SCALARLEFT> (arr, pattern, result, n);
+  }
+}
+
+// Apply an operator to a real array and scalar.
+template<typename T, bool SCALARLEFT>
+void scalarReal (SimdOp op, const T* arr, T scalar, T* result, size_t n)
+{
+  T pattern[16];
+  for (int i=0; i<16; ++i) {
+    pattern[i] = scalar;
+  }
+  patternReal<T,SCALARLEFT> (op, arr, pattern, result, n);
+}
+
+// Multiply complex values (also for a scalar right).
+template<typename T>
+void multiplyComplex (const std::complex<T>* left,
+                      const std::complex<T>* right, bool scalarRight,
+                      std::complex<T>* result, size_t n)
+{
+#ifdef CASA_ARRAYSIMD_X86
+  if (getLevel() >= SimdLevel::AVX2) {
+    cmul256 (left, right, scalarRight, result, n);
+    return;
+  }
+#endif
+  for (size_t i=0; i<n; ++i) {
+    result[i] = left[i] * right[scalarRight ? 0 : i];
+  }
+}
+
+template<typename T>
+void binaryComplex (SimdOp op, const std::complex<T>* left,
+                    const std::complex<T>* right,
+                    std::complex<T>* result, size_t n)
+{
+  if (op == SimdOp::Plus  ||  op == SimdOp::Minus) {
+    // Add or subtract the real and imaginary parts as reals.
+    binaryReal (op, reinterpret_cast<const T*>(left),
+                reinterpret_cast<const T*>(right),
+                reinterpret_cast<T*>(result), 2*n);
+  } else if (op == SimdOp::Multiplies) {
+    multiplyComplex (left, right, false, result, n);
+  } else {
+    for (size_t i=0; i<n; ++i) {
+      result[i] = left[i] / right[i];
+    }
+  }
+}
+
+template<typename T, bool SCALARLEFT>
+void scalarComplex (SimdOp op, const std::complex<T>* arr,
+                    std::complex<T> scalar,
+                    std::complex<T>* result, size_t n)
+{
+  if (op == SimdOp::Plus  ||  op == SimdOp::Minus) {
+    T pattern[16];
+    for (int i=0; i<16; i+=2) {
+      pattern[i]   = scalar.real();
+      pattern[i+1] = scalar.imag();
+    }
+    patternReal<T,SCALARLEFT> (op, reinterpret_cast<const T*>(arr), pattern,
+                               reinterpret_cast<T*>(result), 2*n);
+  } else if (op == SimdOp::Multiplies) {
+    // Complex multiplication is commutative (also bitwise).
+    multiplyComplex (arr, &scalar, true, result, n);
+  } else {
+    for (size_t i=0; i<n; ++i) {
+      result[i] = SCALARLEFT ? scalar / arr[i] : arr[i] / scalar;
+    }
+  }
+}
+
+// Sum the values into the partial sums and add those in a fixed order.
+// The partial sums of the even and odd indices are kept separately
+// if nkeep=2 (for complex values).
+template<typename T>
+void sumLanes (const T* data, size_t n, int nkeep, T* result)
+{
+  constexpr int NL = SumLanes<T>::value;
+  T lanes[NL];
+  switch (getLevel()) {
+#ifdef CASA_ARRAYSIMD_X86
+  case SimdLevel::AVX512:
+    sum512 (data, n, lanes);
+    break;
+  case SimdLevel::AVX2:
+    sum256 (data, n, lanes);
+    break;
+#endif
+  default:
+    kernelSum<T,1> (data, n, lanes);
+  }
+  for (int w=NL/2; w>=nkeep; w/=2) {
+    for (int j=0; j<w; ++j) {
+      lanes[j] += lanes[j+w];
+    }
+  }
+  for (int j=0; j<nkeep; ++j) {
+    result[j] = lanes[j];
+  }
+}
+
+template<typename T>
+void minMaxReal (T& minVal, T& maxVal, const T* data, size_t n)
+{
+  switch (getLevel()) {
+#ifdef CASA_ARRAYSIMD_X86
+  case SimdLevel::AVX512:
+    minMax512 (minVal, maxVal, data, n);
+    break;
+  case SimdLevel::AVX2:
+    minMax256 (minVal, maxVal, data, n);
+    break;
+#endif
+  default:
+    kernelMinMax<T,1> (minVal, maxVal, data, n);
+  }
+}
+
+template<typename T>
+void sqrtReal (const T* data, T* result, size_t n)
+{
+  switch (getLevel()) {
+#ifdef CASA_ARRAYSIMD_X86
+  case SimdLevel::AVX512:
+    sqrt512 (data, result, n);
+    break;
+  case SimdLevel::AVX2:
+    sqrt256 (data, result, n);
+    break;
+#endif
+  default:
+    for (size_t i=0; i<n; ++i) {
+      result[i] = std::sqrt(data[i]);
+    }
+  }
+}
+
+template<typename T>
+void absReal (const T* data, T* result, size_t n)
+{
+  switch (getLevel()) {
+#ifdef CASA_ARRAYSIMD_X86
+  case SimdLevel::AVX512:
+    abs512 (data, result, n);
+    break;
+  case SimdLevel::AVX2:
+    abs256 (data, result, n);
+    break;
+#endif
+  default:
+    kernelAbs<T,1> (data, result, n);
+  }
+}
+
+} //# end anonymous namespace
+
+
+SimdLevel simdMaxLevel()
+{
+  static const SimdLevel maxLevel = detectLevel();
+  return maxLevel;
+}
+
+SimdLevel simdLevel()
+{
+  return getLevel();
+}
+
+SimdLevel setSimdLevel (SimdLevel level)
+{
+  if (level > simdMaxLevel()) {
+    level = simdMaxLevel();
+  }
+  currentLevel() = int(level);
+  return level;
+}
+
+
+void simdBinary (SimdOp op, const float* left, const float* right,
+                 float* result, size_t n)
+  { binaryReal (op, left, right, result, n); }
+void simdBinary (SimdOp op, const double* left, const double* right,
+                 double* result, size_t n)
+  { binaryReal (op, left, right, result, n); }
+void simdBinary (SimdOp op, const std::complex<float>* left,
+                 const std::complex<float>* right,
+                 std::complex<float>* result, size_t n)
+  { binaryComplex (op, left, right, result, n); }
+void simdBinary (SimdOp op, const std::complex<double>* left,
+                 const std::complex<double>* right,
+                 std::complex<double>* result, size_t n)
+  { binaryComplex (op, left, right, result, n); }
+
+void simdBinary (SimdOp op, const float* left, float right,
+                 float* result, size_t n)
+  { scalarReal<float,false> (op, left, right, result, n); }
+void simdBinary (SimdOp op, const double* left, double right,
+                 double* result, size_t n)
+  { scalarReal<double,false> (op, left, right, result, n); }
+void simdBinary (SimdOp op, const std::complex<float>* left,
+                 std::complex<float> right,
+                 std::complex<float>* result, size_t n)
+  { scalarComplex<float,false> (op, left, right, result, n); }
+void simdBinary (SimdOp op, const std::complex<double>* left,
+                 std::complex<double> right,
+                 std::complex<double>* result, size_t n)
+  { scalarComplex<double,false> (op, left, right, result, n); }
+
+void simdBinary (SimdOp op, float left, const float* right,
+                 float* result, size_t n)
+  { scalarReal<float,true> (op, right, left, result, n); }
+void simdBinary (SimdOp op, double left, const double* right,
+                 double* result, size_t n)
+  { scalarReal<double,true> (op, right, left, result, n); }
+void simdBinary (SimdOp op, std::complex<float> left,
+                 const std::complex<float>* right,
+                 std::complex<float>* result, size_t n)
+  { scalarComplex<float,true> (op, right, left, result, n); }
+void simdBinary (SimdOp op, std::complex<double> left,
+                 const std::complex<double>* right,
+                 std::complex<double>* result, size_t n)
+  { scalarComplex<double,true> (op, right, left, result, n); }
+
+
+float simdSum (const float* data, size_t n)
+{
+  float result;
+  sumLanes (data, n, 1, &result);
+  return result;
+}
+double simdSum (const double* data, size_t n)
+{
+  double result;
+  sumLanes (data, n, 1, &result);
+  return result;
+}
+std::complex<float> simdSum (const std::complex<float>* data, size_t n)
+{
+  float result[2];
+  sumLanes (reinterpret_cast<const float*>(data), 2*n, 2, result);
+  return std::complex<float> (result[0], result[1]);
+}
+std::complex<double> simdSum (const std::complex<double>* data, size_t n)
+{
+  double result[2];
+  sumLanes (reinterpret_cast<const double*>(data), 2*n, 2, result);
+  return std::complex<double> (result[0], result[1]);
+}
+
+void simdMinMax (float& minVal, float& maxVal, const float* data, size_t n)
+  { minMaxReal (minVal, maxVal, data, n); }
+void simdMinMax (double& minVal, double& maxVal, const double* data, size_t n)
+  { minMaxReal (minVal, maxVal, data, n); }
+
+void simdSqrt (const float* data, float* result, size_t n)
+  { sqrtReal (data, result, n); }
+void simdSqrt (const double* data, double* result, size_t n)
+  { sqrtReal (data, result, n); }
+void simdAbs (const float* data, float* result, size_t n)
+  { absReal (data, result, n); }
+void simdAbs (const double* data, double* result, size_t n)
+  { absReal (data, result, n); }
+
+void simdAmplitude (const std::complex<float>* data, float* result, size_t n)
+{
+#ifdef CASA_ARRAYSIMD_X86
+  if (getLevel() >= SimdLevel::AVX2) {
+    amplitude256 (data, result, n);
+    return;
+  }
+#endif
+  for (size_t i=0; i<n; ++i) {
+    result[i] = std::abs(data[i]);
+  }
+}
+
+} //# NAMESPACE arrays_internal - END
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,177 @@
+//# ArrayMathSimd.h: Vectorized kernels for contiguous array math
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_ARRAYMATHSIMD_H
+#define CASA_ARRAYMATHSIMD_H
+
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace casacore {
+namespace arrays_internal {
+
+// <summary>
+// Vectorized kernels for contiguous Float, Double, Complex and DComplex data.
+// </summary>
+//
+// <synopsis>
+// These functions are used by ArrayMath for contiguous arrays to do the
+// element-wise arithmetic, sum, min/max, sqrt, abs and the Complex
+// amplitude using AVX2 or AVX-512 instructions. The instruction set is chosen at
+// run time from what the CPU supports, so the library can be built for a
+// generic target. A plain loop is used on other CPUs and platforms.
+// <p>
+// The file is compiled without contraction of floating point expressions
+// (e.g., to FMA instructions), otherwise the scalar fallback could differ
+// from the vector kernels.
+// The results are the same for all instruction sets and are the same as
+// the scalar C++ operators, except for the sum. It is accumulated in 16
+// (Float) or 8 (Double) partial sums that are added in a fixed order at
+// the end. This is more accurate than a straight accumulation, but can
+// differ in the last bits. Therefore it is only used by
+// <src>fastSum</src> and <src>fastMean</src>, not by <src>sum</src>.
+// <p>
+// There are no kernels for the phase and the DComplex amplitude, because
+// atan2 and hypot have no vector instructions and an approximation
+// would change the results.
+// The min/max of data with a NaN behave as the scalar comparisons
+// (a NaN is only taken if it is the first element).
+// </synopsis>
+
+// The instruction set levels.
+enum class SimdLevel {Scalar=0, AVX2=1, AVX512=2};
+
+// Get the highest level supported by this CPU (and build).
+SimdLevel simdMaxLevel();
+
+// Get the level currently used.
+SimdLevel simdLevel();
+
+// Set the level to use (mainly for testing and benchmarking).
+// It is limited to the highest supported level.
+// It returns the level that will be used.
+SimdLevel setSimdLevel (SimdLevel level);
+
+// The binary operators having a vectorized kernel.
+enum class SimdOp {None, Plus, Minus, Multiplies, Divides};
+
+// The element types having vectorized kernels.
+template<typename T> struct SimdType : std::false_type {};
+template<> struct SimdType<float> : std::true_type {};
+template<> struct SimdType<double> : std::true_type {};
+template<> struct SimdType<std::complex<float>> : std::true_type {};
+template<> struct SimdType<std::complex<double>> : std::true_type {};
+
+// Map a functor to a SimdOp. The complex division has no kernel.
+// <group>
+template<typename T, typename Op> struct SimdOpOf
+  { static constexpr SimdOp value = SimdOp::None; };
+template<typename T> struct SimdOpOf<T, std::plus<T>>
+  { static constexpr SimdOp value = SimdOp::Plus; };
+template<typename T> struct SimdOpOf<T, std::minus<T>>
+  { static constexpr SimdOp value = SimdOp::Minus; };
+template<typename T> struct SimdOpOf<T, std::multiplies<T>>
+  { static constexpr SimdOp value = SimdOp::Multiplies; };
+template<> struct SimdOpOf<float, std::divides<float>>
+  { static constexpr SimdOp value = SimdOp::Divides; };
+template<> struct SimdOpOf<double, std::divides<double>>
+  { static constexpr SimdOp value = SimdOp::Divides; };
+// </group>
+
+// Tell if a binary operation on the given types can use a kernel.
+template<typename L, typename R, typename RES, typename Op>
+constexpr bool simdBinaryOp()
+{
+  return std::is_same<L,R>::value  &&  std::is_same<L,RES>::value  &&
+    SimdType<L>::value  &&  SimdOpOf<L,Op>::value != SimdOp::None;
+}
+
+// Apply the operator to array and array, array and scalar, or scalar and
+// array. The result can be the same as the (left) input array.
+// <group>
+void simdBinary (SimdOp op, const float* left, const float* right,
+                 float* result, size_t n);
+void simdBinary (SimdOp op, const double* left, const double* right,
+                 double* result, size_t n);
+void simdBinary (SimdOp op, const std::complex<float>* left,
+                 const std::complex<float>* right,
+                 std::complex<float>* result, size_t n);
+void simdBinary (SimdOp op, const std::complex<double>* left,
+                 const std::complex<double>* right,
+                 std::complex<double>* result, size_t n);
+void simdBinary (SimdOp op, const float* left, float right,
+                 float* result, size_t n);
+void simdBinary (SimdOp op, const double* left, double right,
+                 double* result, size_t n);
+void simdBinary (SimdOp op, const std::complex<float>* left,
+                 std::complex<float> right,
+                 std::complex<float>* result, size_t n);
+void simdBinary (SimdOp op, const std::complex<double>* left,
+                 std::complex<double> right,
+                 std::complex<double>* result, size_t n);
+void simdBinary (SimdOp op, float left, const float* right,
+                 float* result, size_t n);
+void simdBinary (SimdOp op, double left, const double* right,
+                 double* result, size_t n);
+void simdBinary (SimdOp op, std::complex<float> left,
+                 const std::complex<float>* right,
+                 std::complex<float>* result, size_t n);
+void simdBinary (SimdOp op, std::complex<double> left,
+                 const std::complex<double>* right,
+                 std::complex<double>* result, size_t n);
+// </group>
+
+// Get the sum of the values.
+// <group>
+float simdSum (const float* data, size_t n);
+double simdSum (const double* data, size_t n);
+std::complex<float> simdSum (const std::complex<float>* data, size_t n);
+std::complex<double> simdSum (const std::complex<double>* data, size_t n);
+// </group>
+
+// Get the minimum and maximum of the values (n must be > 0).
+// <group>
+void simdMinMax (float& minVal, float& maxVal, const float* data, size_t n);
+void simdMinMax (double& minVal, double& maxVal, const double* data, size_t n);
+// </group>
+
+// Get the square root or absolute value of the values.
+// <group>
+void simdSqrt (const float* data, float* result, size_t n);
+void simdSqrt (const double* data, double* result, size_t n);
+void simdAbs (const float* data, float* result, size_t n);
+void simdAbs (const double* data, double* result, size_t n);
+// </group>
+
+// Get the amplitude of Complex values. It is calculated in double
+// precision as std::abs does.
+void simdAmplitude (const std::complex<float>* data, float* result, size_t n);
+
+} //# NAMESPACE arrays_internal - END
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -31,11 +31,14 @@
 #include "../Slice.h"
 #include "../Slicer.h"
 #include "../ArrayError.h"
+#include "../ArrayLogical.h"
 
 #include <boost/test/unit_test.hpp>
 
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <vector>
 
 using namespace casacore;
 
@@ -605,6 +608,28 @@ BOOST_AUTO_TEST_CASE( life_cycle_1 )
   BOOST_CHECK_EQUAL(LifecycleChecker::ctor_count, LifecycleChecker::dtor_count);
 }
 
+BOOST_AUTO_TEST_CASE( share_storage )
+{
+  IPosition const shape(2, 2, 3);
+  std::shared_ptr<std::vector<int>> owner
+    (new std::vector<int>(shape.product(), 5));
+  std::weak_ptr<std::vector<int>> weak(owner);
+  Array<int> b;
+  {
+    Array<int> a;
+    a.shareStorage(shape, owner->data(), owner);
+    BOOST_CHECK(a.data() == owner->data());
+    BOOST_CHECK_EQUAL(a.nrefs(), 1);
+    b.reference(a);
+  }
+  // The array keeps the owner alive.
+  owner.reset();
+  BOOST_CHECK(!weak.expired());
+  BOOST_CHECK(allEQ(b, 5));
+  b.resize();
+  BOOST_CHECK(weak.expired());
+}
+
 // This test-case is no longer valid: deallocation of an array that's
 // allocated with new[] is not supported in Array2.
 /*
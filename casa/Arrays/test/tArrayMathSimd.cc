@@ -0,0 +1,310 @@
+//# tArrayMathSimd.cc: Test the vectorized kernels used by ArrayMath
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include "../ArrayMath.h"
+#include "../ArrayLogical.h"
+#include "../ArrayMathSimd.h"
+#include "../Slicer.h"
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace casacore;
+using namespace casacore::arrays_internal;
+
+// Each kernel is executed for all supported instruction set levels
+// and compared with the scalar C++ result. Arrays with an odd length
+// are used to test the remainder loops as well.
+
+BOOST_AUTO_TEST_SUITE(array_math_simd)
+
+namespace {
+
+  std::vector<SimdLevel> levels()
+  {
+    std::vector<SimdLevel> result{SimdLevel::Scalar};
+    if (simdMaxLevel() >= SimdLevel::AVX2) result.push_back(SimdLevel::AVX2);
+    if (simdMaxLevel() >= SimdLevel::AVX512) result.push_back(SimdLevel::AVX512);
+    return result;
+  }
+
+  // Restore the default level at the end of a test.
+  struct LevelGuard
+  {
+    ~LevelGuard() { setSimdLevel (simdMaxLevel()); }
+  };
+
+  template<typename T> T makeValue (size_t i)
+  {
+    return T(std::sin(double(i)) * 100 + 0.5);
+  }
+  template<> std::complex<float> makeValue (size_t i)
+  {
+    return std::complex<float> (makeValue<float>(i), makeValue<float>(i+7));
+  }
+  template<> std::complex<double> makeValue (size_t i)
+  {
+    return std::complex<double> (makeValue<double>(i), makeValue<double>(i+7));
+  }
+
+  template<typename T> Array<T> makeArray (size_t n, size_t offset=0)
+  {
+    Array<T> arr(IPosition(1, n));
+    for (size_t i=0; i<n; ++i) {
+      arr.data()[i] = makeValue<T>(i+offset);
+    }
+    return arr;
+  }
+
+  // Compare bitwise, so NaN matches NaN.
+  template<typename T> bool equalBits (const Array<T>& a1, const Array<T>& a2)
+  {
+    return a1.shape().isEqual (a2.shape())  &&
+      memcmp (a1.data(), a2.data(), a1.nelements() * sizeof(T)) == 0;
+  }
+
+  template<typename T> void testArithmetic (size_t n)
+  {
+    LevelGuard guard;
+    Array<T> a = makeArray<T>(n);
+    Array<T> b = makeArray<T>(n, 13);
+    T s = makeValue<T>(3);
+    Array<T> expPlus(a.shape()), expMin(a.shape()), expMul(a.shape()),
+      expDiv(a.shape()), expMulS(a.shape()), expSMin(a.shape());
+    for (size_t i=0; i<n; ++i) {
+      expPlus.data()[i] = a.data()[i] + b.data()[i];
+      expMin.data()[i]  = a.data()[i] - b.data()[i];
+      expMul.data()[i]  = a.data()[i] * b.data()[i];
+      expDiv.data()[i]  = a.data()[i] / b.data()[i];
+      expMulS.data()[i] = a.data()[i] * s;
+      expSMin.data()[i] = s - a.data()[i];
+    }
+    for (SimdLevel level : levels()) {
+      setSimdLevel (level);
+      BOOST_CHECK (equalBits (Array<T>(a + b), expPlus));
+      BOOST_CHECK (equalBits (Array<T>(a - b), expMin));
+      BOOST_CHECK (equalBits (Array<T>(a * b), expMul));
+      BOOST_CHECK (equalBits (Array<T>(a * s), expMulS));
+      BOOST_CHECK (equalBits (Array<T>(s * a), expMulS));
+      BOOST_CHECK (equalBits (Array<T>(s - a), expSMin));
+      Array<T> c(a.copy());
+      c /= b;
+      BOOST_CHECK (equalBits (c, expDiv));
+      c.assign_conforming (a);
+      c *= s;
+      BOOST_CHECK (equalBits (c, expMulS));
+      c.assign_conforming (a);
+      c += b;
+      BOOST_CHECK (equalBits (c, expPlus));
+    }
+  }
+
+  template<typename T> void testSum (size_t n)
+  {
+    LevelGuard guard;
+    Array<T> a = makeArray<T>(n);
+    // sum adds the elements in order.
+    T accSum = std::accumulate (a.cbegin(), a.cend(), T());
+    BOOST_CHECK (sum(a) == accSum);
+    setSimdLevel (SimdLevel::Scalar);
+    T expSum = fastSum(a);
+    // The fast sum is more accurate than a straight accumulation.
+    long double total = 0;
+    for (size_t i=0; i<n; ++i) {
+      total += std::real(a.data()[i]);
+    }
+    BOOST_CHECK (std::abs(std::real(expSum) - total) <=
+                 1e-5 * std::abs(total) + 1e-3);
+    for (SimdLevel level : levels()) {
+      setSimdLevel (level);
+      BOOST_CHECK (fastSum(a) == expSum);
+      BOOST_CHECK (sum(a) == accSum);
+      BOOST_CHECK (fastMean(a) == T(expSum / T(1.0*n)));
+      BOOST_CHECK (mean(a) == T(accSum / T(1.0*n)));
+    }
+  }
+
+  template<typename T> void testMinMax (size_t n)
+  {
+    LevelGuard guard;
+    Array<T> a = makeArray<T>(n);
+    a.data()[n/3] = -1000;
+    a.data()[n-1] = 1000;
+    for (SimdLevel level : levels()) {
+      setSimdLevel (level);
+      T minv, maxv;
+      minMax (minv, maxv, a);
+      BOOST_CHECK_EQUAL (minv, -1000);
+      BOOST_CHECK_EQUAL (maxv, 1000);
+      BOOST_CHECK_EQUAL (min(a), -1000);
+      BOOST_CHECK_EQUAL (max(a), 1000);
+      // A NaN is ignored, unless it is the first element.
+      Array<T> c(a.copy());
+      c.data()[n/2] = std::numeric_limits<T>::quiet_NaN();
+      minMax (minv, maxv, c);
+      BOOST_CHECK_EQUAL (minv, -1000);
+      BOOST_CHECK_EQUAL (maxv, 1000);
+      c.data()[0] = std::numeric_limits<T>::quiet_NaN();
+      minMax (minv, maxv, c);
+      BOOST_CHECK (std::isnan(minv)  &&  std::isnan(maxv));
+    }
+  }
+
+  template<typename T> void testUnary (size_t n)
+  {
+    LevelGuard guard;
+    Array<T> a = makeArray<T>(n);
+    a.data()[0] = -0.;
+    a.data()[1] = std::numeric_limits<T>::quiet_NaN();
+    Array<T> expSqrt(a.shape()), expAbs(a.shape());
+    for (size_t i=0; i<n; ++i) {
+      expSqrt.data()[i] = std::sqrt(a.data()[i]);
+      expAbs.data()[i]  = std::abs(a.data()[i]);
+    }
+    for (SimdLevel level : levels()) {
+      setSimdLevel (level);
+      BOOST_CHECK (equalBits (sqrt(a), expSqrt));
+      BOOST_CHECK (equalBits (abs(a), expAbs));
+    }
+  }
+
+  template<typename T> void testAmplitude (size_t n)
+  {
+    LevelGuard guard;
+    typedef std::complex<T> CT;
+    Array<CT> a = makeArray<CT>(n);
+    a.data()[0] = CT(std::numeric_limits<T>::infinity(),
+                     std::numeric_limits<T>::quiet_NaN());
+    a.data()[1] = CT(std::numeric_limits<T>::max(), 1);
+    a.data()[2] = CT(0, std::numeric_limits<T>::denorm_min());
+    Array<T> expAmp(a.shape()), expPhase(a.shape());
+    for (size_t i=0; i<n; ++i) {
+      expAmp.data()[i]   = std::abs(a.data()[i]);
+      expPhase.data()[i] = std::arg(a.data()[i]);
+    }
+    for (SimdLevel level : levels()) {
+      setSimdLevel (level);
+      Array<T> amp = amplitude(a);
+      BOOST_CHECK (amp.data()[0] == std::numeric_limits<T>::infinity());
+      BOOST_CHECK (equalBits (amp, expAmp));
+      BOOST_CHECK (equalBits (phase(a), expPhase));
+    }
+    // All levels give the same result.
+    setSimdLevel (SimdLevel::Scalar);
+    Array<T> expLevel = amplitude(a);
+    for (SimdLevel level : levels()) {
+      setSimdLevel (level);
+      BOOST_CHECK (equalBits (amplitude(a), expLevel));
+    }
+  }
+
+}
+
+BOOST_AUTO_TEST_CASE( arithmetic )
+{
+  testArithmetic<float> (1001);
+  testArithmetic<double> (1001);
+  testArithmetic<std::complex<float>> (1001);
+  testArithmetic<std::complex<double>> (1001);
+  testArithmetic<float> (3);
+  testArithmetic<std::complex<float>> (0);
+  testArithmetic<std::complex<double>> (0);
+}
+
+BOOST_AUTO_TEST_CASE( complex_nonfinite )
+{
+  LevelGuard guard;
+  typedef std::complex<double> CT;
+  const double inf = std::numeric_limits<double>::infinity();
+  Array<CT> a = makeArray<CT>(9);
+  Array<CT> b = makeArray<CT>(9, 5);
+  a.data()[2] = CT(inf, 1);
+  b.data()[5] = CT(inf, inf);
+  Array<CT> exp(a.shape());
+  for (size_t i=0; i<9; ++i) {
+    exp.data()[i] = a.data()[i] * b.data()[i];
+  }
+  for (SimdLevel level : levels()) {
+    setSimdLevel (level);
+    BOOST_CHECK (equalBits (Array<CT>(a * b), exp));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( sums )
+{
+  testSum<float> (100003);
+  testSum<double> (100003);
+  testSum<std::complex<float>> (10007);
+  testSum<std::complex<double>> (10007);
+  testSum<float> (5);
+}
+
+BOOST_AUTO_TEST_CASE( minmax )
+{
+  testMinMax<float> (1003);
+  testMinMax<double> (1003);
+  testMinMax<float> (4);
+}
+
+BOOST_AUTO_TEST_CASE( unary )
+{
+  testUnary<float> (1001);
+  testUnary<double> (1001);
+}
+
+BOOST_AUTO_TEST_CASE( amplitude_phase )
+{
+  // The amplitude is the same as std::abs.
+  testAmplitude<float> (1001);
+  testAmplitude<double> (1001);
+}
+
+BOOST_AUTO_TEST_CASE( noncontiguous )
+{
+  // A non-contiguous array does not use the kernels, but gives
+  // the same result.
+  Array<float> a = makeArray<float>(1000);
+  Array<float> a1 = a(Slicer(IPosition(1,0), IPosition(1,500), IPosition(1,2)));
+  Array<float> a2 = a1.copy();
+  BOOST_CHECK (equalBits (Array<float>(a1 * a1), Array<float>(a2 * a2)));
+  BOOST_CHECK (equalBits (sqrt(a1), sqrt(a2)));
+  BOOST_CHECK_EQUAL (max(a1), max(a2));
+  BOOST_CHECK (std::abs(sum(a1) - sum(a2)) < 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE( level )
+{
+  LevelGuard guard;
+  BOOST_CHECK (setSimdLevel (SimdLevel::Scalar) == SimdLevel::Scalar);
+  BOOST_CHECK (simdLevel() == SimdLevel::Scalar);
+  BOOST_CHECK (setSimdLevel (SimdLevel::AVX512) == simdMaxLevel());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
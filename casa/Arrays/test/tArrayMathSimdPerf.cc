@@ -0,0 +1,142 @@
+//# tArrayMathSimdPerf.cc: Benchmark the vectorized kernels used by ArrayMath
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include "../ArrayMath.h"
+#include "../ArrayMathSimd.h"
+
+#include <chrono>
+#include <complex>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace casacore;
+using namespace casacore::arrays_internal;
+
+// Benchmark of the ArrayMath functions using the vectorized kernels.
+// Each function is timed for all instruction set levels supported by
+// the CPU and the number of elements per nanosecond is shown.
+// Usage: tArrayMathSimdPerf [nelements] [nrepeat]
+
+namespace {
+
+  const char* levelName (SimdLevel level)
+  {
+    switch (level) {
+    case SimdLevel::AVX512: return "avx512";
+    case SimdLevel::AVX2:   return "avx2";
+    default:                return "scalar";
+    }
+  }
+
+  template<typename FUNC>
+  void timeIt (const std::string& name, size_t n, int nrepeat, FUNC func)
+  {
+    std::cout << std::setw(22) << std::left << name;
+    for (int lev=0; lev<=int(simdMaxLevel()); ++lev) {
+      setSimdLevel (SimdLevel(lev));
+      func();     // warm up
+      auto start = std::chrono::steady_clock::now();
+      for (int i=0; i<nrepeat; ++i) {
+        func();
+      }
+      std::chrono::duration<double, std::nano> dur =
+        std::chrono::steady_clock::now() - start;
+      std::cout << "  " << levelName(SimdLevel(lev)) << ' '
+                << std::setw(6) << std::right << std::fixed
+                << std::setprecision(2) << n * nrepeat / dur.count()
+                << std::left;
+    }
+    std::cout << "  elem/ns" << std::endl;
+    setSimdLevel (simdMaxLevel());
+  }
+
+  template<typename T>
+  void benchType (const std::string& type, size_t n, int nrepeat)
+  {
+    Array<T> a(IPosition(1,n));
+    Array<T> b(IPosition(1,n));
+    for (size_t i=0; i<n; ++i) {
+      a.data()[i] = T(i%1000 + 1);
+      b.data()[i] = T(i%999 + 2);
+    }
+    // Multiply by 1 to keep the values the same.
+    T s(1);
+    T res;
+    timeIt (type + " a+b", n, nrepeat, [&]() { Array<T> c(a+b); });
+    timeIt (type + " a*b", n, nrepeat, [&]() { Array<T> c(a*b); });
+    timeIt (type + " a*=s", n, nrepeat, [&]() { a *= s; });
+    timeIt (type + " sum", n, nrepeat, [&]() { res = sum(a); });
+    timeIt (type + " fastSum", n, nrepeat, [&]() { res = fastSum(a); });
+    timeIt (type + " mean", n, nrepeat, [&]() { res = mean(a); });
+    timeIt (type + " fastMean", n, nrepeat, [&]() { res = fastMean(a); });
+    if (std::abs(res) < 0) std::cout << res;     // use the result
+  }
+
+  template<typename T>
+  void benchReal (const std::string& type, size_t n, int nrepeat)
+  {
+    benchType<T> (type, n, nrepeat);
+    Array<T> a(IPosition(1,n));
+    for (size_t i=0; i<n; ++i) {
+      a.data()[i] = T(i%1000) - 500;
+    }
+    T minv, maxv;
+    timeIt (type + " minMax", n, nrepeat, [&]() { minMax(minv, maxv, a); });
+    timeIt (type + " abs", n, nrepeat, [&]() { Array<T> c(abs(a)); });
+    timeIt (type + " sqrt", n, nrepeat, [&]() { Array<T> c(sqrt(a)); });
+    if (minv > maxv) std::cout << minv;
+  }
+
+  template<typename T>
+  void benchComplex (const std::string& type, size_t n, int nrepeat)
+  {
+    typedef std::complex<T> CT;
+    benchType<CT> (type, n, nrepeat);
+    Array<CT> a(IPosition(1,n));
+    for (size_t i=0; i<n; ++i) {
+      a.data()[i] = CT(T(i%1000), T(i%77));
+    }
+    Array<T> res(a.shape());
+    timeIt (type + " amplitude", n, nrepeat, [&]() { amplitude(res, a); });
+    timeIt (type + " phase", n, nrepeat, [&]() { phase(res, a); });
+  }
+
+}
+
+int main (int argc, char* argv[])
+{
+  size_t n = 1000000;
+  int nrepeat = 20;
+  if (argc > 1) n = atol(argv[1]);
+  if (argc > 2) nrepeat = atoi(argv[2]);
+  std::cout << "nelements=" << n << " nrepeat=" << nrepeat
+            << " maxlevel=" << levelName(simdMaxLevel()) << std::endl;
+  benchReal<float> ("Float", n, nrepeat);
+  benchReal<double> ("Double", n, nrepeat);
+  benchComplex<float> ("Complex", n, nrepeat);
+  benchComplex<double> ("DComplex", n, nrepeat);
+  return 0;
+}
@@ -339,6 +339,7 @@ void BucketCache::getSlot (uInt bucketNr)
 	    its_DeleteCallBack (its_Owner, its_Cache[its_ActualSlot]);
 	    its_Cache[its_ActualSlot] = 0;
 	    its_SlotNr[its_BucketNr[its_ActualSlot]] = -1;
+	    nevict_p++;
 	}
     }
     setLRU();
@@ -416,6 +417,18 @@ void BucketCache::initStatistics()
     nread_p   = 0;
     ninit_p   = 0;
     nwrite_p  = 0;
+    nevict_p  = 0;
+}
+
+BucketCacheStatistics BucketCache::statistics() const
+{
+    BucketCacheStatistics stats;
+    stats.naccess = naccess_p;
+    stats.nread   = nread_p;
+    stats.ninit   = ninit_p;
+    stats.nwrite  = nwrite_p;
+    stats.nevict  = nevict_p;
+    return stats;
 }
 
 } //# NAMESPACE CASACORE - END
@@ -211,6 +211,40 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 //   <li> When ready, use HashMap for the internal maps.
 // </todo>
 
+// <summary>
+// Statistics of the usage of a BucketCache
+// </summary>
+// <synopsis>
+// The statistics of one or more caches (e.g., the caches of all
+// hypercubes of a TiledStMan) can be added.
+// A hit is an access of a bucket that was already in the cache.
+// An eviction means that a bucket had to be removed from the cache
+// to make room for another one.
+// </synopsis>
+struct BucketCacheStatistics
+{
+    uInt64 naccess = 0;
+    uInt64 nread   = 0;
+    uInt64 ninit   = 0;
+    uInt64 nwrite  = 0;
+    uInt64 nevict  = 0;
+
+    // Get the number of cache hits.
+    uInt64 nhit() const
+      { return naccess - nread - ninit; }
+
+    BucketCacheStatistics& operator+= (const BucketCacheStatistics& that)
+    {
+        naccess += that.naccess;
+        nread   += that.nread;
+        ninit   += that.ninit;
+        nwrite  += that.nwrite;
+        nevict  += that.nevict;
+        return *this;
+    }
+};
+
+
 
 class BucketCache
 {
@@ -317,6 +351,9 @@ public:
     // Show the statistics.
     void showStatistics (ostream& os) const;
 
+    // Get the statistics.
+    BucketCacheStatistics statistics() const;
+
 private:
     // The file used.
     BucketFile* its_file;
@@ -367,6 +404,7 @@ private:
     uInt nread_p;
     uInt ninit_p;
     uInt nwrite_p;
+    uInt nevict_p;
 
 
     // Copy constructor is not possible.
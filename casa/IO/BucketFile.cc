@@ -215,6 +215,16 @@ void BucketFile::seek (Int64 offset)
     file_p->seek (offset, ByteIO::Begin);
 }
 
+void BucketFile::prefetch (Int64 offset, Int64 length)
+{
+    // Note that the advice does not block; a failure can be ignored.
+    if (fd_p >= 0  &&  length > 0) {
+#ifdef POSIX_FADV_WILLNEED
+        posix_fadvise (fd_p, offset, length, POSIX_FADV_WILLNEED);
+#endif
+    }
+}
+
 Int64 BucketFile::fileSize () const
 {
     // If a buffered file is used, seek in there. Otherwise its internal
@@ -183,6 +183,12 @@ public:
     // This is doing a seek and sets the file pointer to end-of-file.
     virtual Int64 fileSize() const;
 
+    // Tell the operating system that the given part of the file will be
+    // read soon, so it can read it in the background into its file cache.
+    // It is only a hint; nothing is done if the OS does not support it
+    // or if the file is part of a MultiFile.
+    virtual void prefetch (Int64 offset, Int64 length);
+
     // Is the file cached, mapped, or buffered?
     // <group>
     Bool isCached() const;
@@ -0,0 +1,361 @@
+//# ConcurrentBucketCache.cc: Thread-safe cache for buckets in a part of a file
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/IO/ConcurrentBucketCache.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+ConcurrentBucketCache::Pin::Pin()
+  : itsSlot (0)
+{}
+
+ConcurrentBucketCache::Pin::Pin (ConcurrentBucketCache& cache, uInt bucketNr)
+  : itsSlot (cache.pinSlot (bucketNr))
+{}
+
+ConcurrentBucketCache::Pin::~Pin()
+{
+    if (itsSlot != 0) {
+        itsSlot->pinCount--;
+    }
+}
+
+void ConcurrentBucketCache::Pin::pin (ConcurrentBucketCache& cache,
+                                      uInt bucketNr)
+{
+    Slot* slot = cache.pinSlot (bucketNr);
+    if (itsSlot != 0) {
+        itsSlot->pinCount--;
+    }
+    itsSlot = slot;
+}
+
+const char* ConcurrentBucketCache::Pin::data() const
+{
+    return itsSlot->data;
+}
+
+char* ConcurrentBucketCache::Pin::rwData()
+{
+    itsSlot->dirty = true;
+    return itsSlot->data;
+}
+
+
+ConcurrentBucketCache::ConcurrentBucketCache
+                               (BucketFile* file, Int64 startOffset,
+                                uInt bucketSize, uInt nrOfBuckets,
+                                uInt cacheSize, void* ownerObject,
+                                BucketCacheToLocal readCallBack,
+                                BucketCacheFromLocal writeCallBack,
+                                BucketCacheDeleteBuffer deleteCallBack,
+                                uInt nshard)
+: itsFile           (file),
+  itsOwner          (ownerObject),
+  itsReadCallBack   (readCallBack),
+  itsWriteCallBack  (writeCallBack),
+  itsDeleteCallBack (deleteCallBack),
+  itsStartOffset    (startOffset),
+  itsBucketSize     (bucketSize),
+  itsNrOfBuckets    (nrOfBuckets),
+  itsCacheSize      (std::max (cacheSize, 1u)),
+  itsNShardReq      (nshard),
+  itsNAccess        (0),
+  itsNRead          (0),
+  itsNWrite         (0),
+  itsNEvict         (0)
+{
+    AlwaysAssert (itsBucketSize > 0, AipsError);
+    makeShards();
+}
+
+void ConcurrentBucketCache::makeShards()
+{
+    // By default use a shard per 4 buckets with a maximum of 16 shards.
+    uInt nshard = itsNShardReq;
+    if (nshard == 0) {
+        nshard = defaultNShard (itsCacheSize);
+    }
+    nshard = std::min (nshard, itsCacheSize);
+    itsShardSize = (itsCacheSize + nshard - 1) / nshard;
+    itsShards.clear();
+    itsShards.reserve (nshard);
+    for (uInt i=0; i<nshard; ++i) {
+        itsShards.push_back (std::unique_ptr<Shard>(new Shard()));
+        itsShards.back()->clockHand = 0;
+    }
+}
+
+ConcurrentBucketCache::~ConcurrentBucketCache()
+{
+    flush();
+    for (auto& shard : itsShards) {
+        for (auto& slot : shard->slots) {
+            if (slot->data != 0) {
+                itsDeleteCallBack (itsOwner, slot->data);
+            }
+        }
+    }
+}
+
+char* ConcurrentBucketCache::pinBucket (uInt bucketNr)
+{
+    return pinSlot(bucketNr)->data;
+}
+
+void ConcurrentBucketCache::unpinBucket (uInt bucketNr, Bool dirty)
+{
+    Shard& shard = getShard (bucketNr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.slotMap.find (bucketNr);
+    if (iter == shard.slotMap.end()  ||  iter->second->pinCount == 0) {
+        throw AipsError ("ConcurrentBucketCache::unpinBucket: bucket " +
+                         String::toString(bucketNr) + " is not pinned");
+    }
+    if (dirty) {
+        iter->second->dirty = true;
+    }
+    iter->second->pinCount--;
+}
+
+ConcurrentBucketCache::Slot* ConcurrentBucketCache::pinSlot (uInt bucketNr)
+{
+    if (bucketNr >= itsNrOfBuckets) {
+        throw indexError<Int> (bucketNr);
+    }
+    itsNAccess++;
+    Shard& shard = getShard (bucketNr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.slotMap.find (bucketNr);
+    if (iter != shard.slotMap.end()) {
+        Slot* slot = iter->second;
+        slot->pinCount++;
+        slot->referenced = True;
+        return slot;
+    }
+    // Not in the cache, so read it into a free slot.
+    // The shard stays locked, so another thread cannot read it as well.
+    Slot* slot = getSlot (shard);
+    slot->bucketNr = bucketNr;
+    readBucket (*slot);
+    slot->pinCount   = 1;
+    slot->referenced = True;
+    shard.slotMap[bucketNr] = slot;
+    return slot;
+}
+
+ConcurrentBucketCache::Slot* ConcurrentBucketCache::getSlot (Shard& shard)
+{
+    // Use a new slot if the shard is not full yet.
+    uInt nslot = shard.slots.size();
+    if (nslot < itsShardSize) {
+        return addSlot (shard);
+    }
+    // Find a slot using the clock policy. A referenced slot gets a second
+    // chance. Two rounds are sufficient to find an unpinned slot.
+    for (uInt i=0; i<2*nslot; ++i) {
+        Slot& slot = *shard.slots[shard.clockHand];
+        shard.clockHand = (shard.clockHand + 1) % nslot;
+        if (slot.pinCount == 0) {
+            if (slot.referenced) {
+                slot.referenced = False;
+            } else {
+                if (slot.data != 0) {
+                    itsNEvict++;
+                }
+                removeBucket (shard, slot);
+                return &slot;
+            }
+        }
+    }
+    // All slots are pinned, so add an extra slot to the shard.
+    return addSlot (shard);
+}
+
+ConcurrentBucketCache::Slot* ConcurrentBucketCache::addSlot (Shard& shard)
+{
+    shard.slots.push_back (std::unique_ptr<Slot>(new Slot()));
+    Slot* slot = shard.slots.back().get();
+    slot->data       = 0;
+    slot->bucketNr   = 0;
+    slot->pinCount   = 0;
+    slot->dirty      = false;
+    slot->referenced = False;
+    return slot;
+}
+
+void ConcurrentBucketCache::removeBucket (Shard& shard, Slot& slot)
+{
+    if (slot.data != 0) {
+        if (slot.dirty) {
+            writeBucket (slot);
+        }
+        itsDeleteCallBack (itsOwner, slot.data);
+        slot.data = 0;
+        shard.slotMap.erase (slot.bucketNr);
+    }
+}
+
+void ConcurrentBucketCache::readBucket (Slot& slot)
+{
+    std::unique_ptr<char[]> buffer (new char[itsBucketSize]);
+    {
+        std::lock_guard<std::mutex> lock(itsFileMutex);
+        itsFile->seek (itsStartOffset + Int64(slot.bucketNr) * itsBucketSize);
+        itsFile->read (buffer.get(), itsBucketSize);
+    }
+    slot.data  = itsReadCallBack (itsOwner, buffer.get());
+    slot.dirty = false;
+    itsNRead++;
+}
+
+void ConcurrentBucketCache::writeBucket (Slot& slot)
+{
+    std::unique_ptr<char[]> buffer (new char[itsBucketSize]);
+    itsWriteCallBack (itsOwner, buffer.get(), slot.data);
+    {
+        std::lock_guard<std::mutex> lock(itsFileMutex);
+        itsFile->seek (itsStartOffset + Int64(slot.bucketNr) * itsBucketSize);
+        itsFile->write (buffer.get(), itsBucketSize);
+    }
+    slot.dirty = false;
+    itsNWrite++;
+}
+
+Bool ConcurrentBucketCache::flush()
+{
+    Bool written = False;
+    for (auto& shard : itsShards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto& slot : shard->slots) {
+            if (slot->data != 0  &&  slot->dirty) {
+                writeBucket (*slot);
+                written = True;
+            }
+        }
+    }
+    return written;
+}
+
+void ConcurrentBucketCache::clear (Bool doFlush)
+{
+    for (auto& shard : itsShards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto& slot : shard->slots) {
+            if (slot->data != 0  &&  slot->pinCount == 0) {
+                if (! doFlush) {
+                    slot->dirty = false;
+                }
+                removeBucket (*shard, *slot);
+            }
+        }
+    }
+}
+
+void ConcurrentBucketCache::resync (uInt nrOfBuckets)
+{
+    clear (False);
+    itsNrOfBuckets = nrOfBuckets;
+}
+
+void ConcurrentBucketCache::resize (uInt cacheSize)
+{
+    cacheSize = std::max (cacheSize, 1u);
+    if (cacheSize == itsCacheSize) {
+        return;
+    }
+    // Take the slots out of the shards and make the new shards.
+    // The slot objects themselves do not move, so pins stay valid.
+    std::vector<std::unique_ptr<Slot>> slots;
+    for (auto& shard : itsShards) {
+        for (auto& slot : shard->slots) {
+            slots.push_back (std::move(slot));
+        }
+    }
+    itsCacheSize = cacheSize;
+    makeShards();
+    // Put the buckets in their new shards as long as they fit.
+    // A pinned bucket is always kept.
+    for (auto& slot : slots) {
+        if (slot->data != 0) {
+            Shard& shard = getShard (slot->bucketNr);
+            if (shard.slots.size() < itsShardSize  ||  slot->pinCount > 0) {
+                shard.slotMap[slot->bucketNr] = slot.get();
+                shard.slots.push_back (std::move(slot));
+            } else {
+                if (slot->dirty) {
+                    writeBucket (*slot);
+                }
+                itsDeleteCallBack (itsOwner, slot->data);
+            }
+        }
+    }
+}
+
+void ConcurrentBucketCache::initStatistics()
+{
+    itsNAccess = 0;
+    itsNRead   = 0;
+    itsNWrite  = 0;
+    itsNEvict  = 0;
+}
+
+BucketCacheStatistics ConcurrentBucketCache::statistics() const
+{
+    BucketCacheStatistics stats;
+    stats.naccess = itsNAccess;
+    stats.nread   = itsNRead;
+    stats.nwrite  = itsNWrite;
+    stats.nevict  = itsNEvict;
+    return stats;
+}
+
+void ConcurrentBucketCache::showStatistics (ostream& os) const
+{
+    uInt64 naccess = itsNAccess;
+    uInt64 nread   = itsNRead;
+    os << "cacheSize: " << itsCacheSize << " (*" << itsBucketSize
+       << ") in " << itsShards.size() << " shards" << endl;
+    os << "#buckets:  " << itsNrOfBuckets << endl;
+    if (nread > 0) {
+        os << "#reads:    " << nread << endl;
+    }
+    if (itsNWrite > 0) {
+        os << "#writes:   " << itsNWrite << endl;
+    }
+    os << "#accesses: " << naccess;
+    if (naccess > 0) {
+        os << "        hit-rate:  "
+           << 100 * float(naccess - nread) / float(naccess) << "%";
+    }
+    os << endl;
+}
+
+} //# NAMESPACE CASACORE - END
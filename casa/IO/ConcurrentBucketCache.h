@@ -0,0 +1,313 @@
+//# ConcurrentBucketCache.h: Thread-safe cache for buckets in a part of a file
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_CONCURRENTBUCKETCACHE_H
+#define CASA_CONCURRENTBUCKETCACHE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/iosfwd.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Thread-safe cache for buckets in a part of a file
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tConcurrentBucketCache" demos="">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=BucketCache>BucketCache</linkto>
+//   <li> <linkto class=BucketFile>BucketFile</linkto>
+// </prerequisite>
+
+// <etymology>
+// ConcurrentBucketCache is a BucketCache that can be used concurrently
+// by multiple threads.
+// </etymology>
+
+// <synopsis>
+// Class <linkto class=BucketCache>BucketCache</linkto> has the notion of
+// a current bucket and is not thread-safe. ConcurrentBucketCache offers
+// similar functionality for the existing buckets in a file, but can be
+// used by multiple threads at the same time. It uses the same
+// <linkto group=BucketCache_CallBack>callback functions</linkto>
+// to convert the data from and to local format.
+// <p>
+// The cache is divided into shards, each with its own mutex, slots, and
+// map of bucket number to slot. A bucket is held by shard
+// <src>bucketNr % nShard</src>, so threads accessing different buckets
+// hardly ever wait for each other.
+// <br>A bucket is accessed by pinning it, preferably using the
+// nested class <src>Pin</src>. A pinned bucket is never removed from the
+// cache, so its data can safely be used until it is unpinned.
+// The pin count is atomic, so unpinning does not need to lock the shard.
+// If all slots in a shard are pinned, the shard gets an extra slot,
+// thus the cache can temporarily be larger than requested.
+// <br>When a bucket has to be removed from a full shard, the
+// clock (second chance) policy is used: the slots are scanned cyclically;
+// a slot used since the previous scan gets a second chance, otherwise it
+// is reused (after writing it if it has been changed).
+// <p>
+// The file is accessed under a mutex, so the BucketFile object should not
+// be used in another way while the cache is used by multiple threads.
+// The callback functions can be called by multiple threads simultaneously,
+// so they have to be thread-safe.
+// <br>Unlike BucketCache it is not possible to add or remove buckets;
+// it is meant for reading and updating existing buckets. If the file has
+// been changed by another process, function <src>resync</src> tells the
+// new number of buckets. StandardStMan and the TiledStMan hypercubes use
+// it to read the data of a readonly table.
+// Two threads updating the same bucket have to synchronize themselves.
+// </synopsis>
+
+// <motivation>
+// Multiple threads reading the same (read-only) table should be able
+// to share the cached data instead of each opening the table itself.
+// </motivation>
+
+// <example>
+// <srcblock>
+//  // Create a cache for 1000 buckets of 32768 bytes starting at offset 512
+//  // using (at most) 64 buckets in 8 shards. See BucketCache for the
+//  // callback functions.
+//  ConcurrentBucketCache cache (&file, 512, 32768, 1000, 64, 0,
+//                               bToLocal, bFromLocal, bDeleteBuffer, 8);
+//  // Multiple threads can read buckets.
+//  #pragma omp parallel for
+//  for (uInt i=0; i<1000; ++i) {
+//    ConcurrentBucketCache::Pin pin (cache, i);
+//    const char* data = pin.data();
+//    ...
+//  }
+// </srcblock>
+// </example>
+
+class ConcurrentBucketCache
+{
+private:
+    struct Slot;
+
+public:
+    // RAII class to pin a bucket in the cache. The bucket is unpinned
+    // when the object gets destructed.
+    class Pin
+    {
+    public:
+        // Create an object with no bucket pinned yet.
+        Pin();
+
+        // Pin the given bucket (reading it if not in the cache yet).
+        Pin (ConcurrentBucketCache& cache, uInt bucketNr);
+
+        // Unpin the bucket.
+        ~Pin();
+
+        Pin (const Pin&) = delete;
+        Pin& operator= (const Pin&) = delete;
+
+        // Pin the given bucket after unpinning the current one (if any).
+        void pin (ConcurrentBucketCache& cache, uInt bucketNr);
+
+        // Get the bucket data in local format.
+        const char* data() const;
+
+        // Get the bucket data to be changed; the bucket is marked dirty,
+        // so it will be written when removed from the cache or flushed.
+        char* rwData();
+
+    private:
+        Slot* itsSlot;
+    };
+
+    // Create the cache for (a part of) a file.
+    // The file part used starts at startOffset. Its length is
+    // bucketSize*nrOfBuckets bytes.
+    // The cache size (in buckets) is divided over the shards.
+    // If nshard is 0, the number of shards is derived from the cache size.
+    ConcurrentBucketCache (BucketFile* file, Int64 startOffset,
+                           uInt bucketSize, uInt nrOfBuckets, uInt cacheSize,
+                           void* ownerObject,
+                           BucketCacheToLocal readCallBack,
+                           BucketCacheFromLocal writeCallBack,
+                           BucketCacheDeleteBuffer deleteCallBack,
+                           uInt nshard = 0);
+
+    // The destructor flushes the cache.
+    ~ConcurrentBucketCache();
+
+    ConcurrentBucketCache (const ConcurrentBucketCache&) = delete;
+    ConcurrentBucketCache& operator= (const ConcurrentBucketCache&) = delete;
+
+    // Pin a bucket and return a pointer to its data in local format.
+    // The bucket is read if not in the cache yet.
+    // Each call has to be matched by a call to unpinBucket, so it is
+    // better to use class Pin.
+    char* pinBucket (uInt bucketNr);
+
+    // Unpin a bucket. If <src>dirty=True</src>, the bucket is marked as
+    // changed.
+    void unpinBucket (uInt bucketNr, Bool dirty=False);
+
+    // Write all changed buckets. It returns True if buckets were written.
+    // It should not be called while buckets are being changed.
+    Bool flush();
+
+    // Remove all unpinned buckets from the cache (after flushing them
+    // if wanted). It can be used to enforce rereading buckets.
+    void clear (Bool doFlush = True);
+
+    // Clear the cache without flushing and set the number of buckets in
+    // the file. It has to be used if another process has changed the file.
+    // It should not be called while buckets are pinned.
+    void resync (uInt nrOfBuckets);
+
+    // Get the number of buckets in the file.
+    uInt nBucket() const
+      { return itsNrOfBuckets; }
+
+    // Get the requested cache size (in buckets).
+    uInt cacheSize() const
+      { return itsCacheSize; }
+
+    // Change the cache size (in buckets). The buckets in the cache are
+    // kept as much as possible; if the cache gets smaller, unpinned
+    // buckets are removed (after writing them if changed).
+    // If no number of shards was given in the constructor, the number
+    // of shards is derived again from the new cache size.
+    // It should not be called while the cache is used by other threads.
+    void resize (uInt cacheSize);
+
+    // Get the number of shards.
+    uInt nShard() const
+      { return itsShards.size(); }
+
+    // (Re)initialize the cache statistics.
+    void initStatistics();
+
+    // Show the statistics.
+    void showStatistics (ostream& os) const;
+
+    // Get the statistics. Buckets are never initialized, so
+    // <src>ninit</src> is always 0.
+    BucketCacheStatistics statistics() const;
+
+private:
+    // A slot in the cache.
+    struct Slot
+    {
+        char*              data;
+        uInt               bucketNr;
+        std::atomic<uInt>  pinCount;
+        std::atomic<bool>  dirty;
+        Bool               referenced;
+    };
+    // A shard of the cache.
+    struct Shard
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Slot>> slots;
+        std::unordered_map<uInt, Slot*> slotMap;
+        uInt clockHand;
+    };
+
+    // Get the default number of shards for a cache size.
+    static uInt defaultNShard (uInt cacheSize)
+      { return std::min (16u, std::max (1u, cacheSize / 4)); }
+
+    // Make the shards for the current cache size.
+    void makeShards();
+
+    // Get the shard holding the given bucket.
+    Shard& getShard (uInt bucketNr)
+      { return *itsShards[bucketNr % itsShards.size()]; }
+
+    // Pin the bucket and return its slot.
+    Slot* pinSlot (uInt bucketNr);
+
+    // Find a free slot in the shard using the clock policy.
+    // A new slot is added if all slots are pinned.
+    // The shard has to be locked.
+    Slot* getSlot (Shard& shard);
+
+    // Add a slot to the shard.
+    Slot* addSlot (Shard& shard);
+
+    // Remove the bucket from the slot (after writing it if dirty).
+    void removeBucket (Shard& shard, Slot& slot);
+
+    // Read or write a bucket.
+    // <group>
+    void readBucket (Slot& slot);
+    void writeBucket (Slot& slot);
+    // </group>
+
+    // The file used.
+    BucketFile* itsFile;
+    // The owner object.
+    void*       itsOwner;
+    // The callback functions.
+    BucketCacheToLocal      itsReadCallBack;
+    BucketCacheFromLocal    itsWriteCallBack;
+    BucketCacheDeleteBuffer itsDeleteCallBack;
+    // The starting offset of the buckets in the file.
+    Int64       itsStartOffset;
+    // The bucket size.
+    uInt        itsBucketSize;
+    // The nr of buckets in the file.
+    uInt        itsNrOfBuckets;
+    // The requested cache size and the nr of slots per shard.
+    uInt        itsCacheSize;
+    uInt        itsShardSize;
+    // The number of shards given in the constructor (0 = derived).
+    uInt        itsNShardReq;
+    // The shards.
+    std::vector<std::unique_ptr<Shard>> itsShards;
+    // Mutex for accessing the file.
+    std::mutex  itsFileMutex;
+    // The statistics.
+    std::atomic<uInt64> itsNAccess;
+    std::atomic<uInt64> itsNRead;
+    std::atomic<uInt64> itsNWrite;
+    std::atomic<uInt64> itsNEvict;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,228 @@
+//# tConcurrentBucketCache.cc: Test program for class ConcurrentBucketCache
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/IO/ConcurrentBucketCache.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+// <summary>
+// Test program for the ConcurrentBucketCache class.
+// Multiple threads read and update buckets in a small cache.
+// </summary>
+
+const uInt bucketSize = 1024;
+const uInt nbucket    = 200;
+
+// The callback functions simply copy the data.
+char* toLocal (void*, const char* data)
+{
+  char* ptr = new char[bucketSize];
+  memcpy (ptr, data, bucketSize);
+  return ptr;
+}
+void fromLocal (void*, char* data, const char* local)
+{
+  memcpy (data, local, bucketSize);
+}
+void deleteBuffer (void*, char* buffer)
+{
+  delete [] buffer;
+}
+
+// Each bucket is filled with the bucket number (as uInt) plus a value.
+void fillBucket (char* data, uInt bucketNr, uInt value)
+{
+  uInt* ptr = reinterpret_cast<uInt*>(data);
+  for (uInt i=0; i<bucketSize/sizeof(uInt); ++i) {
+    ptr[i] = bucketNr + value;
+  }
+}
+Bool checkBucket (const char* data, uInt bucketNr, uInt value)
+{
+  const uInt* ptr = reinterpret_cast<const uInt*>(data);
+  for (uInt i=0; i<bucketSize/sizeof(uInt); ++i) {
+    if (ptr[i] != bucketNr + value) {
+      return False;
+    }
+  }
+  return True;
+}
+
+void createFile()
+{
+  BucketFile file ("tConcurrentBucketCache_tmp.data");
+  std::vector<char> buf(bucketSize);
+  for (uInt i=0; i<nbucket; ++i) {
+    fillBucket (buf.data(), i, 0);
+    file.write (buf.data(), bucketSize);
+  }
+}
+
+// Read all buckets using multiple threads, each in a different order.
+void readAll (ConcurrentBucketCache& cache, uInt nthread, uInt value)
+{
+  std::atomic<uInt> nerr(0);
+  std::vector<std::thread> threads;
+  for (uInt t=0; t<nthread; ++t) {
+    threads.emplace_back ([&cache, &nerr, t, value]() {
+        for (uInt j=0; j<3*nbucket; ++j) {
+          uInt bucketNr = (j*(2*t+1) + t) % nbucket;
+          ConcurrentBucketCache::Pin pin (cache, bucketNr);
+          if (! checkBucket (pin.data(), bucketNr, value)) {
+            nerr++;
+          }
+        }
+      });
+  }
+  for (auto& thr : threads) {
+    thr.join();
+  }
+  AlwaysAssertExit (nerr == 0);
+}
+
+void testRead (uInt nshard)
+{
+  BucketFile file ("tConcurrentBucketCache_tmp.data", False);
+  file.open();
+  ConcurrentBucketCache cache (&file, 0, bucketSize, nbucket, 16, 0,
+                               toLocal, fromLocal, deleteBuffer, nshard);
+  AlwaysAssertExit (cache.nBucket() == nbucket);
+  readAll (cache, 4, 0);
+  // A pinned bucket stays in the cache while others are read.
+  char* data = cache.pinBucket (3);
+  readAll (cache, 2, 0);
+  AlwaysAssertExit (checkBucket (data, 3, 0));
+  cache.unpinBucket (3);
+  cache.clear();
+  readAll (cache, 1, 0);
+  // A bucket number outside the file cannot be used.
+  Bool ok = False;
+  try {
+    cache.pinBucket (nbucket);
+  } catch (const std::exception&) {
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+  // A Pin can be reused for another bucket.
+  {
+    ConcurrentBucketCache::Pin pin;
+    pin.pin (cache, 5);
+    AlwaysAssertExit (checkBucket (pin.data(), 5, 0));
+    pin.pin (cache, 6);
+    AlwaysAssertExit (checkBucket (pin.data(), 6, 0));
+  }
+  // After a resync fewer buckets can be used.
+  cache.resync (nbucket-1);
+  AlwaysAssertExit (cache.nBucket() == nbucket-1);
+  ok = False;
+  try {
+    cache.pinBucket (nbucket-1);
+  } catch (const std::exception&) {
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+}
+
+void testResize()
+{
+  BucketFile file ("tConcurrentBucketCache_tmp.data", False);
+  file.open();
+  ConcurrentBucketCache cache (&file, 0, bucketSize, nbucket, 1, 0,
+                               toLocal, fromLocal, deleteBuffer);
+  AlwaysAssertExit (cache.nShard() == 1);
+  ConcurrentBucketCache::Pin pin (cache, 3);
+  // Growing keeps the buckets and derives the number of shards again.
+  cache.resize (40);
+  AlwaysAssertExit (cache.cacheSize() == 40  &&  cache.nShard() == 10);
+  ConcurrentBucketCache::Pin pin2 (cache, 3);
+  AlwaysAssertExit (pin2.data() == pin.data());
+  AlwaysAssertExit (cache.statistics().nread == 1);
+  readAll (cache, 4, 10);
+  // Shrinking removes buckets, but not the pinned one.
+  cache.resize (2);
+  AlwaysAssertExit (cache.nShard() == 1);
+  AlwaysAssertExit (checkBucket (pin.data(), 3, 10));
+  readAll (cache, 2, 10);
+  BucketCacheStatistics stats = cache.statistics();
+  AlwaysAssertExit (stats.naccess == 2 + 18*nbucket);
+  AlwaysAssertExit (stats.nevict > 0  &&  stats.ninit == 0);
+}
+
+void testUpdate()
+{
+  {
+    BucketFile file ("tConcurrentBucketCache_tmp.data", True);
+    file.open();
+    ConcurrentBucketCache cache (&file, 0, bucketSize, nbucket, 8, 0,
+                                 toLocal, fromLocal, deleteBuffer);
+    // Update each bucket in parallel; dirty buckets are written when
+    // removed from the cache.
+    std::vector<std::thread> threads;
+    for (uInt t=0; t<4; ++t) {
+      threads.emplace_back ([&cache, t]() {
+          for (uInt i=t; i<nbucket; i+=4) {
+            ConcurrentBucketCache::Pin pin (cache, i);
+            fillBucket (pin.rwData(), i, 10);
+          }
+        });
+    }
+    for (auto& thr : threads) {
+      thr.join();
+    }
+    readAll (cache, 4, 10);
+    // The destructor flushes the remaining buckets.
+  }
+  // Check the file contents using a new cache.
+  BucketFile file ("tConcurrentBucketCache_tmp.data", False);
+  file.open();
+  ConcurrentBucketCache cache (&file, 0, bucketSize, nbucket, 32, 0,
+                               toLocal, fromLocal, deleteBuffer);
+  readAll (cache, 3, 10);
+  cache.showStatistics (cout);
+}
+
+int main()
+{
+  try {
+    createFile();
+    testRead (0);
+    testRead (1);
+    testRead (5);
+    testUpdate();
+    testResize();
+  } catch (const std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -287,6 +287,12 @@ Bool ImageExpr<T>::doGetMaskSlice (Array<Bool>& buffer, const Slicer& section)
   return latticeExpr_p.doGetMaskSlice (buffer, section);
 }
 
+template <class T>
+void ImageExpr<T>::copyDataTo (Lattice<T>& to) const
+{
+  latticeExpr_p.copyDataTo (to);
+}
+
 
 template <class T>
 Bool ImageExpr<T>::lock (FileLocker::LockType type, uInt nattempts)
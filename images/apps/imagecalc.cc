@@ -31,6 +31,8 @@
 #include <casacore/images/Images/ImageProxy.h>
 #include <casacore/images/Images/ImageExpr.h>
 #include <casacore/images/Images/ImageExprParse.h>
+#include <casacore/lattices/LEL/LatticeExprNode.h>
+#include <casacore/casa/OS/Timer.h>
 
 using namespace casacore;
 
@@ -43,10 +45,17 @@ int main(int argc, const char* argv[])
 
     // Read the input parameters.
     Input inputs(1);
-    inputs.version("20080710GvD");
+    inputs.version("20261018");
     inputs.create("in", "", "Input image or image expression", "string");
     inputs.create("out", "", "Output image name (optional)", "string");
     inputs.create("hdf5", "F", "output image in HDF5 format?", "bool");
+    inputs.create("threads", "1",
+                  "Maximum number of threads evaluating the expression (0 = all available)",
+                  "int");
+    inputs.create("fuse", "T",
+                  "Fuse the elementwise operations in the expression?", "bool");
+    inputs.create("timing", "F",
+                  "Show the time needed to evaluate the expression?", "bool");
     inputs.readArguments(argc, argv);
 
     // Get and check the input specification.
@@ -60,6 +69,13 @@ int main(int argc, const char* argv[])
       outName = "/tmp/image.out";
     }
     Bool hdf5 = inputs.getBool("hdf5");
+    Int nthreads = inputs.getInt("threads");
+    if (nthreads < 0) {
+      throw AipsError(" threads must be >= 0");
+    }
+    LatticeExprNode::setNThreads (nthreads);
+    LatticeExprNode::setFusion (inputs.getBool("fuse"));
+    Bool timing = inputs.getBool("timing");
     if (hdf5  &&  !HDF5Object::hasHDF5Support()) {
       cerr << "Support for HDF5 has not been compiled in; revert to PagedImage"
            << endl;
@@ -81,8 +97,14 @@ int main(int argc, const char* argv[])
       }
     } else {
       cout << "Copying '" << imgin << "' to '" << outName << "'" << endl;
+      Timer timer;
       ImageProxy img(imgin, String(), vector<ImageProxy>());
       img.saveAs (outName, True, hdf5, True);
+      if (timing) {
+        cout << "Evaluated " << node.shape().product() << " pixels using at most "
+             << LatticeExprNode::nthreadsUsed() << " threads in "
+             << timer.real() << " sec" << endl;
+      }
     }
   } catch (std::exception& x) {
     cout << x.what() << endl;
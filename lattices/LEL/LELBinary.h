@@ -126,6 +126,16 @@ public:
 // Get class name
    virtual String className() const;    
 
+// Get the operation and the operands (used by LELFused).
+// <group>
+   LELBinaryEnums::Operation operation() const
+      { return op_p; }
+   const std::shared_ptr<LELInterface<T>>& leftExpr() const
+      { return pLeftExpr_p; }
+   const std::shared_ptr<LELInterface<T>>& rightExpr() const
+      { return pRightExpr_p; }
+// </group>
+
   // Handle locking/syncing of a lattice in a lattice expression.
   // <group>
   virtual Bool lock (FileLocker::LockType, uInt nattempts);
@@ -126,6 +126,14 @@ public:
 // Get class name
    virtual String className() const;
 
+// Get the function and its operand (used by LELFused).
+// <group>
+   LELFunctionEnums::Function function() const
+      { return function_p; }
+   const std::shared_ptr<LELInterface<T>>& expr() const
+      { return pExpr_p; }
+// </group>
+
   // Handle locking/syncing of a lattice in a lattice expression.
   // <group>
   virtual Bool lock (FileLocker::LockType, uInt nattempts);
@@ -228,6 +236,14 @@ public:
 // Get class name
    virtual String className() const;
 
+// Get the function and its operand (used by LELFused).
+// <group>
+   LELFunctionEnums::Function function() const
+      { return function_p; }
+   const std::shared_ptr<LELInterface<T>>& expr() const
+      { return pExpr_p; }
+// </group>
+
 // Handle locking/syncing of a lattice in a lattice expression.
    // <group>
    virtual Bool lock (FileLocker::LockType, uInt nattempts);
@@ -0,0 +1,250 @@
+//# LELFused.h: Evaluate the elementwise part of an expression in a single pass
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef LATTICES_LELFUSED_H
+#define LATTICES_LELFUSED_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/lattices/LEL/LELInterface.h>
+#include <casacore/lattices/LEL/LELFunctionEnums.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <map>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+template <class T> class MaskedLattice;
+
+// <summary> This LEL class evaluates fused elementwise operations </summary>
+//
+// <use visibility=local>
+//
+// <reviewed reviewer="" date="yyyy/mm/dd" tests="tLELFused" demos="">
+// </reviewed>
+//
+// <prerequisite>
+//   <li> <linkto class="LatticeExprNode"> LatticeExprNode</linkto>
+//   <li> <linkto class="LELInterface"> LELInterface</linkto>
+//   <li> <linkto class="LELBinary"> LELBinary</linkto>
+//   <li> <linkto class="LELFunction1D"> LELFunction1D</linkto>
+// </prerequisite>
+//
+// <etymology>
+//  The class fuses the elementwise operations of an expression.
+// </etymology>
+//
+// <synopsis>
+// Normally each node in an expression tree evaluates its result in an
+// array with the size of the chunk being evaluated. Thus an expression
+// like <src>sqrt(a*a + b*b) / max(c)</src> makes several chunk-sized
+// temporary arrays, each of which is written and read again.
+// <p>
+// LELFused replaces the elementwise part of an expression tree
+// (the numerical operators +, -, *, / and unary -, and the functions
+// sin, sinh, cos, cosh, exp, log, log10, sqrt, asin, acos, tan, tanh,
+// atan, ceil and floor) by a list of instructions. The other
+// subexpressions (e.g., lattices, conditions, type conversions, and
+// functions of multiple arguments) are the inputs of the instructions.
+// They are evaluated per chunk as usual, whereafter the instructions are
+// executed in a single pass over the chunk in blocks of
+// <src>blockSize</src> elements. The intermediate results are kept in
+// a few block-sized registers, which stay in the cache.
+// <p>
+// Subexpressions occurring multiple times (e.g., <src>a*a</src> in
+// <src>a*a + sqrt(a*a)</src>) are evaluated only once. They are found
+// by giving each input and instruction a key made from its operation
+// and operands. Equal lattice inputs are recognized if they are
+// persistent without a mask and have the same name.
+// Scalar subexpressions like <src>max(c)</src> have already been
+// replaced by their value when preparing the expression (see
+// <linkto class=LELInterface>LELInterface::replaceScalarExpr</linkto>),
+// so they are calculated only once and act as constants.
+// <p>
+// Note that only the intermediate results are fused. Each input is still
+// evaluated per chunk in the usual way before the instructions are
+// executed. A lattice input is referenced without a copy if the lattice
+// can do it (e.g., an ArrayLattice), but for other lattices (e.g., a
+// PagedArray) and for non-elementwise subexpressions the chunk is read
+// or evaluated into a temporary array. Thus the number of chunk-sized
+// arrays is reduced to the number of inputs, but the inputs are not
+// read block by block within the single pass.
+// <p>
+// The mask of the result is the combination of the masks of the inputs,
+// which is the same as when evaluating the tree node by node. Also the
+// values are the same, because the same operations are done in the same
+// order.
+// <p>
+// LatticeExprNode fuses an expression when preparing it for evaluation
+// (unless switched off with <src>LatticeExprNode::setFusion</src>).
+// The resulting plan can be shown with <src>LatticeExprNode::show</src>.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+// ArrayLattice<Float> a(shape), b(shape);
+// LatticeExprNode expr (sqrt(a*a + b*b) / max(b));
+// expr.show (cout);
+// </srcblock>
+// shows something like
+// <srcblock>
+// LELFused: 5 instructions, 2 inputs, 0 shared, 3 registers
+//   in0:
+//     LELLattice shape=[10, 10]
+//   in1:
+//     LELLattice shape=[10, 10]
+//   r0 = in0 * in0
+//   r1 = in1 * in1
+//   r2 = r0 + r1
+//   r1 = sqrt(r2)
+//   out = r1 / 99
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Evaluating expressions on large images was limited by memory bandwidth
+// because of the chunk-sized temporary arrays.
+// </motivation>
+
+
+template <class T> class LELFused : public LELInterface<T>
+{
+  //# Make members of parent class known.
+protected:
+  using LELInterface<T>::setAttr;
+
+public:
+// The number of elements processed by each instruction at a time.
+   static const uInt blockSize = 1024;
+
+// Try to fuse the given expression. If possible, the expression is
+// replaced by a LELFused object and True is returned.
+// It is not done if the top node is not elementwise or if there is
+// nothing to gain (a single instruction without shared subexpressions).
+   static Bool fuse (std::shared_ptr<LELInterface<T>>& expr);
+
+// Destructor
+  ~LELFused();
+
+// Evaluate the inputs and execute the instructions.
+   virtual void eval (LELArray<T>& result,
+                      const Slicer& section) const;
+
+// A fused expression is never a scalar, so an exception is thrown.
+   virtual LELScalar<T> getScalar() const;
+
+// The expression has already been prepared, so it returns False.
+   virtual Bool prepareScalarExpr();
+
+// Get class name
+   virtual String className() const;
+
+// Show the inputs and instructions.
+   virtual void show (ostream& os, uInt indent) const;
+
+// Get the number of instructions, inputs and shared subexpressions.
+// <group>
+   uInt ninstructions() const
+      { return instr_p.size(); }
+   uInt ninputs() const
+      { return inputs_p.size(); }
+   uInt nshared() const
+      { return nshared_p; }
+// </group>
+
+  // Handle locking/syncing of the inputs.
+  // <group>
+  virtual Bool lock (FileLocker::LockType, uInt nattempts);
+  virtual void unlock();
+  virtual Bool hasLock (FileLocker::LockType) const;
+  virtual void resync();
+  // </group>
+
+private:
+// The operations that can be fused.
+   enum OpCode {ADD, SUBTRACT, MULTIPLY, DIVIDE, NEGATE, FUNCTION};
+
+// An operand is an input, a constant, or the result of an instruction.
+   enum OperandType {INPUT, CONSTANT, RESULT};
+   struct Operand {
+      OperandType type;
+      uInt        index;
+   };
+
+// An instruction and the register it writes its result to.
+   struct Instruction {
+      OpCode                     code;
+      LELFunctionEnums::Function function;
+      Operand                    left;
+      Operand                    right;
+      Int                        reg;
+   };
+
+// Construct with the attributes of the expression being fused.
+   explicit LELFused (const LELAttribute& attr);
+
+// Can the node be fused (i.e. is it an elementwise operation on
+// arrays and valid scalar constants)?
+   static Bool isFusable (const LELInterface<T>& node);
+
+// Get the key telling that lattices contain the same data. It is empty
+// if the lattice can only be identified by its object.
+// A persistent unmasked lattice is identified by its name if it is not a
+// view on part of a lattice or a view with other axes.
+   static String latticeKey (const MaskedLattice<T>& lattice);
+
+// Add the node (recursively) to the instructions or inputs.
+   Operand compile (const std::shared_ptr<LELInterface<T>>& node,
+                    std::map<String,Operand>& keys);
+
+// Assign a register to the result of each instruction, reusing registers
+// of results no longer needed. The last instruction writes the output.
+   void assignRegisters();
+
+// Execute the instructions for a block of n elements.
+   void execute (T* out, const std::vector<const T*>& in, T* regs,
+                 size_t n) const;
+
+// Get the key or string representation of an operand.
+   static String operandKey (const Operand& operand);
+   String operandString (const Operand& operand) const;
+
+   std::vector<std::shared_ptr<LELInterface<T>>> inputs_p;
+   std::vector<T>           consts_p;
+   std::vector<Instruction> instr_p;
+   uInt                     nreg_p;
+   uInt                     nshared_p;
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <casacore/lattices/LEL/LELFused.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+#endif
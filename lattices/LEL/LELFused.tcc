@@ -0,0 +1,612 @@
+//# LELFused.tcc: Evaluate the elementwise part of an expression in a single pass
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef LATTICES_LELFUSED_TCC
+#define LATTICES_LELFUSED_TCC
+
+#include <casacore/lattices/LEL/LELFused.h>
+#include <casacore/lattices/LEL/LELBinary.h>
+#include <casacore/lattices/LEL/LELUnary.h>
+#include <casacore/lattices/LEL/LELFunction.h>
+#include <casacore/lattices/LEL/LELLattice.h>
+#include <casacore/lattices/LEL/LELArray.h>
+#include <casacore/lattices/LEL/LELScalar.h>
+#include <casacore/lattices/Lattices/SubLattice.h>
+#include <casacore/lattices/LRegions/LatticeRegion.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+template <class T>
+LELFused<T>::LELFused (const LELAttribute& attr)
+: nreg_p    (0),
+  nshared_p (0)
+{
+   setAttr (attr);
+}
+
+template <class T>
+LELFused<T>::~LELFused()
+{}
+
+template <class T>
+Bool LELFused<T>::fuse (std::shared_ptr<LELInterface<T>>& expr)
+{
+   if (expr->isScalar()  ||  !isFusable(*expr)) {
+      return False;
+   }
+   std::shared_ptr<LELFused<T>> fused (new LELFused<T>(expr->getAttribute()));
+   std::map<String,Operand> keys;
+   fused->compile (expr, keys);
+   if (fused->instr_p.size() < 2  &&  fused->nshared_p == 0) {
+      return False;
+   }
+   fused->assignRegisters();
+   expr = fused;
+   return True;
+}
+
+template <class T>
+Bool LELFused<T>::isFusable (const LELInterface<T>& node)
+{
+   if (node.isScalar()) {
+      return False;
+   }
+   // Get the operands of the node if it is elementwise.
+   const LELInterface<T>* left = 0;
+   const LELInterface<T>* right = 0;
+   if (const LELBinary<T>* bin = dynamic_cast<const LELBinary<T>*>(&node)) {
+      left  = bin->leftExpr().get();
+      right = bin->rightExpr().get();
+   } else if (const LELUnary<T>* un = dynamic_cast<const LELUnary<T>*>(&node)) {
+      if (un->operation() != LELUnaryEnums::MINUS) {
+         return False;
+      }
+      left = un->expr().get();
+   } else if (const LELFunction1D<T>* func =
+              dynamic_cast<const LELFunction1D<T>*>(&node)) {
+      // VALUE removes the mask, so cannot be fused.
+      if (func->function() == LELFunctionEnums::VALUE) {
+         return False;
+      }
+      left = func->expr().get();
+   } else {
+      if constexpr (std::is_floating_point<T>::value) {
+         if (const LELFunctionReal1D<T>* func =
+             dynamic_cast<const LELFunctionReal1D<T>*>(&node)) {
+            switch (func->function()) {
+            case LELFunctionEnums::ASIN:
+            case LELFunctionEnums::ACOS:
+            case LELFunctionEnums::TAN:
+            case LELFunctionEnums::TANH:
+            case LELFunctionEnums::ATAN:
+            case LELFunctionEnums::CEIL:
+            case LELFunctionEnums::FLOOR:
+               left = func->expr().get();
+               break;
+            default:
+               return False;
+            }
+         }
+      }
+      if (left == 0) {
+         return False;
+      }
+   }
+   // A scalar operand must be a valid constant.
+   for (const LELInterface<T>* oper : {left, right}) {
+      if (oper != 0  &&  oper->isScalar()) {
+         const LELUnaryConst<T>* cnst =
+            dynamic_cast<const LELUnaryConst<T>*>(oper);
+         if (cnst == 0  ||  !cnst->getScalar().mask()) {
+            return False;
+         }
+      }
+   }
+   return True;
+}
+
+template <class T>
+String LELFused<T>::latticeKey (const MaskedLattice<T>& lattice)
+{
+   if (!lattice.isPersistent()  ||  lattice.isMasked()
+   ||  lattice.name().empty()) {
+      return String();
+   }
+   // The lattice must be the full lattice with the same axes order, thus
+   // not a section, strided or with removed axes. SubLattice does not
+   // support reordering of axes, but it is checked for completeness.
+   const SubLattice<T>* subLat = dynamic_cast<const SubLattice<T>*>(&lattice);
+   if (subLat != 0  &&  (subLat->getAxesMap().isReordered()  ||
+                         subLat->getAxesMap().isRemoved())) {
+      return String();
+   }
+   const IPosition shape = lattice.shape();
+   const Slicer& slicer = lattice.region().slicer();
+   if (!slicer.start().isEqual (IPosition(shape.size(), 0))
+   ||  !slicer.stride().isEqual (IPosition(shape.size(), 1))
+   ||  !slicer.length().isEqual (shape)) {
+      return String();
+   }
+   return String("L") + lattice.name() + shape.toString();
+}
+
+template <class T>
+typename LELFused<T>::Operand LELFused<T>::compile
+(const std::shared_ptr<LELInterface<T>>& node, std::map<String,Operand>& keys)
+{
+   Operand result;
+   // A scalar operand is a constant (isFusable has checked that).
+   if (node->isScalar()) {
+      T value = node->getScalar().value();
+      String key = "c" + String((const char*)&value, sizeof(T));
+      auto iter = keys.find (key);
+      if (iter != keys.end()) {
+         return iter->second;
+      }
+      result.type  = CONSTANT;
+      result.index = consts_p.size();
+      consts_p.push_back (value);
+      keys[key] = result;
+      return result;
+   }
+   // A non-elementwise node is an input. Lattices are equal if they
+   // have the same key (see latticeKey); otherwise only the same object
+   // (a shared subexpression) is equal.
+   if (! isFusable (*node)) {
+      String key;
+      const LELLattice<T>* lat = dynamic_cast<const LELLattice<T>*>(node.get());
+      if (lat != 0) {
+         key = latticeKey (lat->lattice());
+      }
+      if (key.empty()) {
+         key = "P" + String::toString ((const void*)(node.get()));
+      }
+      auto iter = keys.find (key);
+      if (iter != keys.end()) {
+         // Only count another object for the same lattice as shared.
+         if (inputs_p[iter->second.index].get() != node.get()) {
+            ++nshared_p;
+         }
+         return iter->second;
+      }
+      result.type  = INPUT;
+      result.index = inputs_p.size();
+      inputs_p.push_back (node);
+      keys[key] = result;
+      return result;
+   }
+   // Compile the operands and make the instruction.
+   Instruction instr;
+   instr.function = LELFunctionEnums::NFUNCTIONS;
+   instr.reg = -1;
+   String key;
+   if (const LELBinary<T>* bin = dynamic_cast<const LELBinary<T>*>(node.get())) {
+      instr.left  = compile (bin->leftExpr(), keys);
+      instr.right = compile (bin->rightExpr(), keys);
+      switch (bin->operation()) {
+      case LELBinaryEnums::ADD:
+         instr.code = ADD;
+         break;
+      case LELBinaryEnums::SUBTRACT:
+         instr.code = SUBTRACT;
+         break;
+      case LELBinaryEnums::MULTIPLY:
+         instr.code = MULTIPLY;
+         break;
+      case LELBinaryEnums::DIVIDE:
+         instr.code = DIVIDE;
+         break;
+      default:
+         throw AipsError ("LELFused::compile - unknown operation");
+      }
+      key = operandKey(instr.right);
+   } else {
+      if (const LELUnary<T>* un = dynamic_cast<const LELUnary<T>*>(node.get())) {
+         instr.code = NEGATE;
+         instr.left = compile (un->expr(), keys);
+      } else if (const LELFunction1D<T>* func =
+                 dynamic_cast<const LELFunction1D<T>*>(node.get())) {
+         instr.code = FUNCTION;
+         instr.function = func->function();
+         instr.left = compile (func->expr(), keys);
+      } else {
+         if constexpr (std::is_floating_point<T>::value) {
+            const LELFunctionReal1D<T>* func =
+               dynamic_cast<const LELFunctionReal1D<T>*>(node.get());
+            instr.code = FUNCTION;
+            instr.function = func->function();
+            instr.left = compile (func->expr(), keys);
+         }
+      }
+      instr.right = instr.left;
+   }
+   key = String::toString(Int(instr.code)) + ',' +
+         String::toString(Int(instr.function)) + ',' +
+         operandKey(instr.left) + ',' + key;
+   auto iter = keys.find (key);
+   if (iter != keys.end()) {
+      ++nshared_p;
+      return iter->second;
+   }
+   result.type  = RESULT;
+   result.index = instr_p.size();
+   instr_p.push_back (instr);
+   keys[key] = result;
+   return result;
+}
+
+template <class T>
+void LELFused<T>::assignRegisters()
+{
+   // Find the last instruction using the result of each instruction.
+   const uInt ninstr = instr_p.size();
+   std::vector<uInt> lastUse(ninstr, 0);
+   for (uInt i=0; i<ninstr; ++i) {
+      for (const Operand* oper : {&instr_p[i].left, &instr_p[i].right}) {
+         if (oper->type == RESULT) {
+            lastUse[oper->index] = i;
+         }
+      }
+   }
+   // Assign a register to each result (except the last one which is the
+   // output). A register is released after the instruction that uses it
+   // last, thus it never equals an operand register of that instruction.
+   std::vector<Int> freeRegs;
+   nreg_p = 0;
+   for (uInt i=0; i+1<ninstr; ++i) {
+      if (freeRegs.empty()) {
+         instr_p[i].reg = nreg_p++;
+      } else {
+         instr_p[i].reg = freeRegs.back();
+         freeRegs.pop_back();
+      }
+      for (uInt j=0; j<i; ++j) {
+         if (lastUse[j] == i  &&  instr_p[j].reg >= 0) {
+            freeRegs.push_back (instr_p[j].reg);
+         }
+      }
+   }
+}
+
+template <class T>
+void LELFused<T>::eval (LELArray<T>& result,
+                        const Slicer& section) const
+{
+   // Evaluate all inputs and combine their masks.
+   const IPosition& shape = result.shape();
+   const uInt ninput = inputs_p.size();
+   std::vector<std::unique_ptr<LELArrayRef<T>>> inputs(ninput);
+   std::vector<const T*> inPtr(ninput);
+   Block<Bool> deleteIn(ninput);
+   result.removeMask();
+   Bool firstMask = True;
+   for (uInt i=0; i<ninput; ++i) {
+      inputs[i].reset (new LELArrayRef<T>(shape));
+      inputs_p[i]->evalRef (*inputs[i], section);
+      inPtr[i] = inputs[i]->value().getStorage (deleteIn[i]);
+      if (inputs[i]->isMasked()) {
+         if (firstMask) {
+            // Copy, because combineMask changes the mask in place.
+            result.setMask (inputs[i]->mask().copy());
+            firstMask = False;
+         } else {
+            result.combineMask (*inputs[i]);
+         }
+      }
+   }
+   // Execute the instructions block by block.
+   Array<T> out(shape);
+   T* outPtr = out.data();
+   const size_t nelem = out.nelements();
+   Block<T> regs(std::max(nreg_p, 1u) * blockSize);
+   std::vector<const T*> blockIn(ninput);
+   for (size_t st=0; st<nelem; st+=blockSize) {
+      size_t n = std::min (size_t(blockSize), nelem-st);
+      for (uInt i=0; i<ninput; ++i) {
+         blockIn[i] = inPtr[i] + st;
+      }
+      execute (outPtr + st, blockIn, regs.storage(), n);
+   }
+   for (uInt i=0; i<ninput; ++i) {
+      inputs[i]->value().freeStorage (inPtr[i], deleteIn[i]);
+   }
+   result.value().reference (out);
+}
+
+namespace {
+  // Apply a binary operator elementwise, where an operand can be a scalar.
+  template <typename T, typename OPER>
+  inline void lelFusedBinary (T* out, const T* left, Bool leftScalar,
+                              const T* right, Bool rightScalar,
+                              size_t n, OPER oper)
+  {
+    if (leftScalar) {
+      const T l = *left;
+      for (size_t i=0; i<n; ++i) out[i] = oper(l, right[i]);
+    } else if (rightScalar) {
+      const T r = *right;
+      for (size_t i=0; i<n; ++i) out[i] = oper(left[i], r);
+    } else {
+      for (size_t i=0; i<n; ++i) out[i] = oper(left[i], right[i]);
+    }
+  }
+
+  // Apply a function elementwise.
+  template <typename T, typename FUNC>
+  inline void lelFusedUnary (T* out, const T* in, size_t n, FUNC func)
+  {
+    for (size_t i=0; i<n; ++i) out[i] = func(in[i]);
+  }
+}
+
+template <class T>
+void LELFused<T>::execute (T* out, const std::vector<const T*>& in, T* regs,
+                           size_t n) const
+{
+   const uInt ninstr = instr_p.size();
+   for (uInt k=0; k<ninstr; ++k) {
+      const Instruction& instr = instr_p[k];
+      T* res = (k+1 == ninstr  ?  out : regs + size_t(instr.reg)*blockSize);
+      const T* ptr[2];
+      Bool isConst[2];
+      const Operand* opers[2] = {&instr.left, &instr.right};
+      for (uInt j=0; j<2; ++j) {
+         const Operand& oper = *opers[j];
+         isConst[j] = (oper.type == CONSTANT);
+         switch (oper.type) {
+         case INPUT:
+            ptr[j] = in[oper.index];
+            break;
+         case CONSTANT:
+            ptr[j] = &consts_p[oper.index];
+            break;
+         default:
+            ptr[j] = regs + size_t(instr_p[oper.index].reg)*blockSize;
+         }
+      }
+      // Use the same operators and functions as the LEL classes.
+      switch (instr.code) {
+      case ADD:
+         lelFusedBinary (res, ptr[0], isConst[0], ptr[1], isConst[1], n,
+                         std::plus<T>());
+         break;
+      case SUBTRACT:
+         lelFusedBinary (res, ptr[0], isConst[0], ptr[1], isConst[1], n,
+                         std::minus<T>());
+         break;
+      case MULTIPLY:
+         lelFusedBinary (res, ptr[0], isConst[0], ptr[1], isConst[1], n,
+                         std::multiplies<T>());
+         break;
+      case DIVIDE:
+         lelFusedBinary (res, ptr[0], isConst[0], ptr[1], isConst[1], n,
+                         std::divides<T>());
+         break;
+      case NEGATE:
+         lelFusedUnary (res, ptr[0], n, std::negate<T>());
+         break;
+      case FUNCTION:
+         switch (instr.function) {
+         case LELFunctionEnums::SIN:
+            lelFusedUnary (res, ptr[0], n, [](T v){ return std::sin(v); });
+            break;
+         case LELFunctionEnums::SINH:
+            lelFusedUnary (res, ptr[0], n, [](T v){ return std::sinh(v); });
+            break;
+         case LELFunctionEnums::COS:
+            lelFusedUnary (res, ptr[0], n, [](T v){ return std::cos(v); });
+            break;
+         case LELFunctionEnums::COSH:
+            lelFusedUnary (res, ptr[0], n, [](T v){ return std::cosh(v); });
+            break;
+         case LELFunctionEnums::EXP:
+            lelFusedUnary (res, ptr[0], n, [](T v){ return std::exp(v); });
+            break;
+         case LELFunctionEnums::LOG:
+            lelFusedUnary (res, ptr[0], n, [](T v){ return std::log(v); });
+            break;
+         case LELFunctionEnums::LOG10:
+            lelFusedUnary (res, ptr[0], n, [](T v){ return std::log10(v); });
+            break;
+         case LELFunctionEnums::SQRT:
+            if constexpr (std::is_floating_point<T>::value) {
+               arrays_internal::simdSqrt (ptr[0], res, n);
+            } else {
+               lelFusedUnary (res, ptr[0], n, [](T v){ return std::sqrt(v); });
+            }
+            break;
+         default:
+            if constexpr (std::is_floating_point<T>::value) {
+               switch (instr.function) {
+               case LELFunctionEnums::ASIN:
+                  lelFusedUnary (res, ptr[0], n, [](T v){ return std::asin(v); });
+                  break;
+               case LELFunctionEnums::ACOS:
+                  lelFusedUnary (res, ptr[0], n, [](T v){ return std::acos(v); });
+                  break;
+               case LELFunctionEnums::TAN:
+                  lelFusedUnary (res, ptr[0], n, [](T v){ return std::tan(v); });
+                  break;
+               case LELFunctionEnums::TANH:
+                  lelFusedUnary (res, ptr[0], n, [](T v){ return std::tanh(v); });
+                  break;
+               case LELFunctionEnums::ATAN:
+                  lelFusedUnary (res, ptr[0], n, [](T v){ return std::atan(v); });
+                  break;
+               case LELFunctionEnums::CEIL:
+                  lelFusedUnary (res, ptr[0], n, [](T v){ return std::ceil(v); });
+                  break;
+               case LELFunctionEnums::FLOOR:
+                  lelFusedUnary (res, ptr[0], n, [](T v){ return std::floor(v); });
+                  break;
+               default:
+                  throw AipsError ("LELFused::execute - unknown function");
+               }
+            } else {
+               throw AipsError ("LELFused::execute - unknown function");
+            }
+         }
+         break;
+      }
+   }
+}
+
+template <class T>
+LELScalar<T> LELFused<T>::getScalar() const
+{
+   throw AipsError ("LELFused::getScalar - a fused expression is no scalar");
+}
+
+template <class T>
+Bool LELFused<T>::prepareScalarExpr()
+{
+   return False;
+}
+
+template <class T>
+String LELFused<T>::className() const
+{
+   return String("LELFused");
+}
+
+template <class T>
+String LELFused<T>::operandKey (const Operand& operand)
+{
+   const char* prefix[] = {"i", "c", "r"};
+   return prefix[operand.type] + String::toString(operand.index);
+}
+
+template <class T>
+String LELFused<T>::operandString (const Operand& operand) const
+{
+   switch (operand.type) {
+   case INPUT:
+      return "in" + String::toString(operand.index);
+   case CONSTANT:
+      return String::toString(consts_p[operand.index]);
+   default:
+      if (operand.index+1 == instr_p.size()) {
+         return "out";
+      }
+      return "r" + String::toString(instr_p[operand.index].reg);
+   }
+}
+
+template <class T>
+void LELFused<T>::show (ostream& os, uInt indent) const
+{
+   static const char* funcNames[] = {
+      "sin", "sinh", "asin", "cos", "cosh", "acos", "tan", "tanh", "atan",
+      "atan2", "exp", "log", "log10", "pow", "sqrt", "round", "sign",
+      "ceil", "floor", "abs"};
+   String ind(indent, ' ');
+   os << ind << className() << ": " << instr_p.size() << " instructions, "
+      << inputs_p.size() << " inputs, " << nshared_p << " shared, "
+      << nreg_p << " registers" << endl;
+   for (uInt i=0; i<inputs_p.size(); ++i) {
+      os << ind << "  in" << i << ':' << endl;
+      inputs_p[i]->show (os, indent+4);
+   }
+   for (uInt i=0; i<instr_p.size(); ++i) {
+      const Instruction& instr = instr_p[i];
+      Operand res;
+      res.type  = RESULT;
+      res.index = i;
+      os << ind << "  " << operandString(res) << " = ";
+      String left  = operandString(instr.left);
+      String right = operandString(instr.right);
+      switch (instr.code) {
+      case ADD:
+         os << left << " + " << right;
+         break;
+      case SUBTRACT:
+         os << left << " - " << right;
+         break;
+      case MULTIPLY:
+         os << left << " * " << right;
+         break;
+      case DIVIDE:
+         os << left << " / " << right;
+         break;
+      case NEGATE:
+         os << '-' << left;
+         break;
+      case FUNCTION:
+         os << funcNames[instr.function] << '(' << left << ')';
+         break;
+      }
+      os << endl;
+   }
+}
+
+template <class T>
+Bool LELFused<T>::lock (FileLocker::LockType type, uInt nattempts)
+{
+   for (const auto& input : inputs_p) {
+      if (! input->lock (type, nattempts)) {
+         return False;
+      }
+   }
+   return True;
+}
+template <class T>
+void LELFused<T>::unlock()
+{
+   for (const auto& input : inputs_p) {
+      input->unlock();
+   }
+}
+template <class T>
+Bool LELFused<T>::hasLock (FileLocker::LockType type) const
+{
+   for (const auto& input : inputs_p) {
+      if (! input->hasLock (type)) {
+         return False;
+      }
+   }
+   return True;
+}
+template <class T>
+void LELFused<T>::resync()
+{
+   for (const auto& input : inputs_p) {
+      input->resync();
+   }
+}
+
+} //# NAMESPACE CASACORE - END
+
+
+#endif
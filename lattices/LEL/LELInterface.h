@@ -33,6 +33,7 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/IO/FileLocker.h>
+#include <casacore/casa/iosfwd.h>
 #include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -185,6 +186,11 @@ public:
 // Get class name
    virtual String className() const = 0;
 
+// Show the expression for diagnostic purposes, preceded by
+// <src>indent</src> spaces. By default the class name and the shape
+// are shown. LELFused shows how the expression is evaluated.
+   virtual void show (ostream& os, uInt indent) const;
+
 // If the given expression is a valid scalar, replace it by its result.
 // It returns False if the expression is no scalar or if the expression
 // is an invalid scalar (i.e. with a False mask).
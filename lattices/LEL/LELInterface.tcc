@@ -31,6 +31,7 @@
 #include <casacore/lattices/LEL/LELArray.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -91,6 +92,18 @@ Bool LELInterface<T>::replaceScalarExpr (std::shared_ptr<LELInterface<T>>& expr)
 }
 
 
+template<class T>
+void LELInterface<T>::show (ostream& os, uInt indent) const
+{
+    os << String(indent, ' ') << className();
+    if (isScalar()) {
+        os << " scalar";
+    } else {
+        os << " shape=" << shape();
+    }
+    os << endl;
+}
+
 template<class T>
 Bool LELInterface<T>::lock (FileLocker::LockType, uInt)
 {
@@ -30,6 +30,8 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/lattices/LEL/LELInterface.h>
+#include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -123,6 +125,10 @@ public:
 // Get class name
    virtual String className() const;
 
+// Get the lattice (used by LELFused to find equal lattices).
+   const MaskedLattice<T>& lattice() const
+      { return *pLattice_p; }
+
   // Handle locking/syncing of a lattice in a lattice expression.
   // <group>
   virtual Bool lock (FileLocker::LockType, uInt nattempts);
@@ -133,6 +139,8 @@ public:
 
 private:
    MaskedLattice<T>* pLattice_p;
+   //# Mutex serializing the reads of the lattice.
+   std::shared_ptr<std::recursive_mutex> readMutex_p;
 };
 
 
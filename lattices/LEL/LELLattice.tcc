@@ -29,6 +29,7 @@
 #include <casacore/lattices/LEL/LELLattice.h>
 #include <casacore/lattices/LEL/LELScalar.h>
 #include <casacore/lattices/LEL/LELArray.h>
+#include <casacore/lattices/LEL/LatticeExprNode.h>
 #include <casacore/lattices/Lattices/Lattice.h>
 #include <casacore/lattices/Lattices/SubLattice.h>
 #include <casacore/casa/Arrays/Slicer.h>
@@ -43,7 +44,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 template <class T>
 LELLattice<T>::LELLattice(const Lattice<T>& lattice) 
-: pLattice_p (new SubLattice<T> (lattice))
+: pLattice_p  (new SubLattice<T> (lattice)),
+  readMutex_p (LatticeExprNode::readMutex (lattice))
 {
    setAttr(LELAttribute(False, 
 			lattice.shape(), lattice.niceCursorShape(),
@@ -57,7 +59,8 @@ LELLattice<T>::LELLattice(const Lattice<T>& lattice)
 
 template <class T>
 LELLattice<T>::LELLattice(const MaskedLattice<T>& lattice) 
-: pLattice_p (lattice.cloneML())
+: pLattice_p  (lattice.cloneML()),
+  readMutex_p (LatticeExprNode::readMutex (lattice))
 {
    setAttr(LELAttribute(lattice.isMasked(),
 			lattice.shape(), lattice.niceCursorShape(),
@@ -89,6 +92,8 @@ void LELLattice<T>::eval(LELArray<T>& result,
 	<< pLattice_p.nrefs() << endl;
 #endif
 
+   // A lattice cannot be read by multiple threads at the same time.
+   std::lock_guard<std::recursive_mutex> lock(*readMutex_p);
    Array<T> tmp = pLattice_p->getSlice (section);
    result.value().reference(tmp);
    if (getAttribute().isMasked()) {
@@ -108,6 +113,8 @@ void LELLattice<T>::evalRef(LELArrayRef<T>& result,
 	<< pLattice_p.nrefs() << endl;
 #endif
 
+   // A lattice cannot be read by multiple threads at the same time.
+   std::lock_guard<std::recursive_mutex> lock(*readMutex_p);
    Array<T> tmp;
    pLattice_p->getSlice (tmp, section);
    // Cast to its base class LELArray to use the non-const value function.
@@ -28,6 +28,7 @@
 #include <casacore/lattices/LRegions/LattRegionHolder.h>
 #include <casacore/lattices/LEL/LELArray.h>
 #include <casacore/lattices/LEL/LELScalar.h>
+#include <casacore/lattices/LEL/LatticeExprNode.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 
@@ -145,6 +146,7 @@ void LELRegion::checkTypes (const LattRegionHolder& left,
 
 
 LELRegionAsBool::LELRegionAsBool (const LELRegion& region)
+: readMutex_p (LatticeExprNode::readMutex (String()))
 {
    const LattRegionHolder& reg = region.region();
    if (! reg.isLCRegion()) {
@@ -163,6 +165,8 @@ LELRegionAsBool::~LELRegionAsBool()
 void LELRegionAsBool::eval(LELArray<Bool>& result, 
 			   const Slicer& section) const
 {
+   // A region mask cannot be read by multiple threads at the same time.
+   std::lock_guard<std::recursive_mutex> lock(*readMutex_p);
    Array<Bool> tmp = region_p.getSlice (section);
    result.value().reference(tmp);
 }
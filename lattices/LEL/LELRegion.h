@@ -31,6 +31,8 @@
 #include <casacore/casa/aips.h>
 #include <casacore/lattices/LEL/LELInterface.h>
 #include <casacore/lattices/LRegions/LatticeRegion.h>
+#include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -202,6 +204,8 @@ public:
 private:
 // Member variables.
     LatticeRegion region_p;
+    //# Mutex serializing the reads of the region mask.
+    std::shared_ptr<std::recursive_mutex> readMutex_p;
 };
 
 
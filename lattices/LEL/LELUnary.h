@@ -206,6 +206,14 @@ public:
 // Get class name
    virtual String className() const;    
 
+// Get the operation and the operand (used by LELFused).
+// <group>
+   LELUnaryEnums::Operation operation() const
+      { return op_p; }
+   const std::shared_ptr<LELInterface<T>>& expr() const
+      { return pExpr_p; }
+// </group>
+
   // Handle locking/syncing of a lattice in a lattice expression.
   // <group>
   virtual Bool lock (FileLocker::LockType, uInt nattempts);
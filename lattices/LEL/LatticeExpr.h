@@ -186,6 +186,9 @@ public:
   virtual Bool hasLock (FileLocker::LockType) const;
   // </group>
 
+  // Show how the expression is evaluated.
+  void show (ostream& os) const;
+
   // Resynchronize the Lattice object with the lattice file.
   // This function is only useful if no read-locking is used, ie.
   // if the table lock option is UserNoReadLocking or AutoNoReadLocking.
@@ -220,6 +223,12 @@ public:
 			    const IPosition& stride);
 
   // Copy the data from this lattice to the given lattice.
+  // If switched on with <src>LatticeExprNode::setNThreads</src>, the chunks
+  // (of the output's nice cursor shape) are evaluated in parallel using at
+  // most <src>LatticeExprNode::nthreadsUsed()</src> threads. Each thread
+  // evaluates the expression for its own chunk, whereafter the chunks are
+  // written in order. The reads of each lattice in the expression are
+  // serialized, but different lattices can be read at the same time.
    virtual void copyDataTo (Lattice<T>& to) const;
 
   // Handle the Math operators (+=, -=, *=, /=).
@@ -231,6 +240,9 @@ private:
    // Initialize the object from the expression.
    void init (const LatticeExprNode& expr);
 
+   // Copy the data to the given lattice evaluating the chunks in parallel.
+   void copyDataParallel (Lattice<T>& to) const;
+
 
    LatticeExprNode expr_p;     //# its shape can be undefined
    IPosition       shape_p;    //# this shape is always defined
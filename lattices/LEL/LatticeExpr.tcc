@@ -29,6 +29,7 @@
 #include <casacore/lattices/LEL/LatticeExpr.h>
 #include <casacore/lattices/LEL/LELArray.h>
 #include <casacore/lattices/Lattices/LatticeIterator.h>
+#include <casacore/lattices/Lattices/LatticeStepper.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -159,6 +160,12 @@ Bool LatticeExpr<T>::isWritable() const
    return False;
 }
 
+template<class T>
+void LatticeExpr<T>::show (ostream& os) const
+{
+   expr_p.show (os);
+}
+
 template<class T>
 Bool LatticeExpr<T>::lock (FileLocker::LockType type, uInt nattempts)
 {
@@ -254,8 +261,58 @@ void LatticeExpr<T>::copyDataTo (Lattice<T>& to) const
     T value;
     expr_p.eval (value);
     to.set (value);
-  } else {
+  } else if (LatticeExprNode::nthreadsUsed() <= 1) {
     Lattice<T>::copyDataTo (to);
+  } else {
+    copyDataParallel (to);
+  }
+}
+
+template<class T>
+void LatticeExpr<T>::copyDataParallel (Lattice<T>& to) const
+{
+  // Check the lattice is writable and the shapes conform.
+  AlwaysAssert (to.isWritable(), AipsError);
+  AlwaysAssert (shape_p.isEqual (to.shape()), AipsError);
+  LatticeStepper stepper (to.shape(), to.niceCursorShape(),
+                          LatticeStepper::RESIZE);
+  // Create an iterator for the output to setup the cache.
+  LatticeIterator<T> dummyIter(to, stepper);
+  std::vector<Slicer> sections;
+  for (stepper.reset(); !stepper.atEnd(); stepper++) {
+    sections.push_back (Slicer(stepper.position(), stepper.cursorShape()));
+  }
+  // Evaluate the first chunk serially, because the expression (and its
+  // subexpressions) get prepared at their first evaluation.
+  {
+    LELArray<T> chunk(sections[0].length());
+    expr_p.eval (chunk, sections[0]);
+    to.putSlice (chunk.value(), sections[0].start());
+  }
+  // Evaluate the other chunks in parallel in batches of nthreads chunks,
+  // each in its own buffer. Reading a lattice in the expression is
+  // serialized by its LatticeExprNode::readMutex.
+  const size_t nthr = LatticeExprNode::nthreadsUsed();
+  for (size_t st=1; st<sections.size(); st+=nthr) {
+    const Int n = std::min (nthr, sections.size() - st);
+    std::vector<std::unique_ptr<LELArray<T>>> chunks(n);
+    std::vector<std::exception_ptr> errors(n);
+#pragma omp parallel for num_threads(n)
+    for (Int k=0; k<n; ++k) {
+      try {
+        chunks[k].reset (new LELArray<T>(sections[st+k].length()));
+        expr_p.eval (*chunks[k], sections[st+k]);
+      } catch (...) {
+        errors[k] = std::current_exception();
+      }
+    }
+    // Write the chunks in order.
+    for (Int k=0; k<n; ++k) {
+      if (errors[k]) {
+        std::rethrow_exception (errors[k]);
+      }
+      to.putSlice (chunks[k]->value(), sections[st+k].start());
+    }
   }
 }
 
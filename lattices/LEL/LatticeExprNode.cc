@@ -34,6 +34,7 @@
 #include <casacore/lattices/LEL/LELUnary.h>
 #include <casacore/lattices/LEL/LELCondition.h>
 #include <casacore/lattices/LEL/LELFunction.h>
+#include <casacore/lattices/LEL/LELFused.h>
 #include <casacore/lattices/LEL/LELSpectralIndex.h>
 #include <casacore/lattices/LEL/LELArray.h>
 #include <casacore/lattices/LEL/LELRegion.h>
@@ -47,7 +48,10 @@
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h> 
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/iostream.h>
+#include <atomic>
+#include <map>
 
 
 
@@ -690,15 +694,134 @@ Bool LatticeExprNode::replaceScalarExpr()
    return isInvalid_p;
 }
 
+namespace {
+  // Fuse the elementwise operations when preparing an expression?
+  std::atomic<Bool> theirFusion(True);
+  // Maximum number of threads to evaluate chunks (0 = OpenMP maximum).
+  std::atomic<uInt> theirNThreads(1);
+}
+
+void LatticeExprNode::setFusion (Bool fuse)
+{
+   theirFusion = fuse;
+}
+
+Bool LatticeExprNode::fusion()
+{
+   return theirFusion;
+}
+
+void LatticeExprNode::setNThreads (uInt nthreads)
+{
+   theirNThreads = nthreads;
+}
+
+uInt LatticeExprNode::nthreads()
+{
+   return theirNThreads;
+}
+
+uInt LatticeExprNode::nthreadsUsed()
+{
+   uInt nthr = theirNThreads;
+   return (nthr == 0  ?  OMP::maxThreads() : nthr);
+}
+
+std::shared_ptr<std::recursive_mutex> LatticeExprNode::readMutex
+                                              (const LatticeBase& lattice)
+{
+   String key = lattice.name();
+   if (key.empty()  &&  !lattice.isPaged()) {
+      return std::make_shared<std::recursive_mutex>();
+   }
+   return readMutex (key);
+}
+
+std::shared_ptr<std::recursive_mutex> LatticeExprNode::readMutex
+                                              (const String& key)
+{
+   static std::map<String, std::weak_ptr<std::recursive_mutex>> theirMutexes;
+   static std::mutex theirMapMutex;
+   std::lock_guard<std::mutex> lock(theirMapMutex);
+   std::weak_ptr<std::recursive_mutex>& wptr = theirMutexes[key];
+   std::shared_ptr<std::recursive_mutex> mutex = wptr.lock();
+   if (! mutex) {
+      mutex = std::make_shared<std::recursive_mutex>();
+      wptr = mutex;
+   }
+// Remove the entries of mutexes no longer in use.
+   for (auto iter = theirMutexes.begin(); iter != theirMutexes.end();) {
+      if (iter->second.expired()) {
+         iter = theirMutexes.erase (iter);
+      } else {
+         ++iter;
+      }
+   }
+   return mutex;
+}
+
 void LatticeExprNode::doPrepare() const
 {
    if (!donePrepare_p) {
       LatticeExprNode* This = (LatticeExprNode*)this;
       This->replaceScalarExpr();
+// Fuse the elementwise operations of an array expression.
+      if (!isInvalid_p  &&  fusion()) {
+         switch (dataType()) {
+         case TpFloat:
+            if (LELFused<Float>::fuse (This->pExprFloat_p)) {
+               This->pAttr_p = &pExprFloat_p->getAttribute();
+            }
+            break;
+         case TpDouble:
+            if (LELFused<Double>::fuse (This->pExprDouble_p)) {
+               This->pAttr_p = &pExprDouble_p->getAttribute();
+            }
+            break;
+         case TpComplex:
+            if (LELFused<Complex>::fuse (This->pExprComplex_p)) {
+               This->pAttr_p = &pExprComplex_p->getAttribute();
+            }
+            break;
+         case TpDComplex:
+            if (LELFused<DComplex>::fuse (This->pExprDComplex_p)) {
+               This->pAttr_p = &pExprDComplex_p->getAttribute();
+            }
+            break;
+         default:
+            break;
+         }
+      }
       This->donePrepare_p = True;
    }
 }
 
+void LatticeExprNode::show (ostream& os) const
+{
+   if (!donePrepare_p) {
+      doPrepare();
+   }
+   switch (dataType()) {
+   case TpFloat:
+      pExprFloat_p->show (os, 0);
+      break;
+   case TpDouble:
+      pExprDouble_p->show (os, 0);
+      break;
+   case TpComplex:
+      pExprComplex_p->show (os, 0);
+      break;
+   case TpDComplex:
+      pExprDComplex_p->show (os, 0);
+      break;
+   case TpBool:
+      pExprBool_p->show (os, 0);
+      break;
+   default:
+      throw (AipsError ("LatticeExprNode::show - unknown data type"));
+   }
+}
+
 void LatticeExprNode::eval (LELArray<Float>& result,
 			    const Slicer& section) const
 {
@@ -731,9 +854,7 @@ void LatticeExprNode::eval (LELArray<Double>& result,
 // If first time, try to do optimization.
    DebugAssert (dataType() == TpDouble, AipsError);
    if (!donePrepare_p) {
-      LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      doPrepare();
    }
 // If scalar, remove mask if scalar is valid. Otherwise set False mask.
 // If array, evaluate for this section.
@@ -759,9 +880,7 @@ void LatticeExprNode::eval (LELArray<Complex>& result,
 // If first time, try to do optimization.
    DebugAssert (dataType() == TpComplex, AipsError);
    if (!donePrepare_p) {
-      LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      doPrepare();
    }
 // If scalar, remove mask if scalar is valid. Otherwise set False mask.
 // If array, evaluate for this section.
@@ -787,9 +906,7 @@ void LatticeExprNode::eval (LELArray<DComplex>& result,
 // If first time, try to do optimization.
    DebugAssert (dataType() == TpDComplex, AipsError);
    if (!donePrepare_p) {
-      LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      doPrepare();
    }
 // If scalar, remove mask if scalar is valid. Otherwise set False mask.
 // If array, evaluate for this section.
@@ -815,9 +932,7 @@ void LatticeExprNode::eval (LELArray<Bool>& result,
 // If first time, try to do optimization.
    DebugAssert (dataType() == TpBool, AipsError);
    if (!donePrepare_p) {
-      LatticeExprNode* This = (LatticeExprNode*)this;
-      This->replaceScalarExpr();
-      This->donePrepare_p = True;
+      doPrepare();
    }
 // If scalar, remove mask if scalar is valid. Otherwise set False mask.
 // If array, evaluate for this section.
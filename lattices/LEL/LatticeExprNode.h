@@ -38,6 +38,7 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -47,6 +48,7 @@ template <class T> class Lattice;
 template <class T> class MaskedLattice;
 template <class T> class Block;
 class LCRegion;
+class LatticeBase;
 class Slicer;
 class LattRegionHolder;
 class LatticeExprNode;
@@ -709,6 +711,45 @@ public:
 
 // Replace a scalar subexpression by its result.
    Bool replaceScalarExpr();
+
+// Enable or disable the fusion of the elementwise operations in an
+// expression (see <linkto class=LELFused>LELFused</linkto>).
+// It is enabled by default. It is applied when an expression is
+// prepared, i.e. when it is evaluated the first time.
+// <group>
+   static void setFusion (Bool fuse);
+   static Bool fusion();
+// </group>
+
+// Show how the expression is evaluated (after preparing it).
+   void show (ostream& os) const;
+
+// Set the maximum number of threads used to evaluate the chunks of an
+// expression in parallel when copying it to a lattice (see
+// <linkto class=LatticeExpr>LatticeExpr::copyDataTo</linkto>).
+// 0 means the maximum number of OpenMP threads. Default is 1, thus
+// parallel evaluation has to be switched on explicitly.
+// <group>
+   static void setNThreads (uInt nthreads);
+   static uInt nthreads();
+// </group>
+
+// Get the actual maximum number of threads to use.
+   static uInt nthreadsUsed();
+
+// Get the mutex serializing the reads of a lattice or region in the
+// evaluation of expressions, so chunks can be evaluated in parallel.
+// Lattices with the same name (e.g., the same PagedImage) share a mutex,
+// because they can share a table cache. Paged lattices without a name
+// share the mutex with an empty key, which is also used for regions
+// (their masks can be stored in a table). An in-memory lattice without
+// a name gets a mutex of its own.
+// It is recursive, because a lattice can be an expression itself.
+// <group>
+   static std::shared_ptr<std::recursive_mutex> readMutex
+                                          (const LatticeBase& lattice);
+   static std::shared_ptr<std::recursive_mutex> readMutex (const String& key);
+// </group>
   
 // Make the object from a std::shared_ptr<LELInterface> pointer.
 // Ideally this function is private, but alas it is needed in LELFunction1D,
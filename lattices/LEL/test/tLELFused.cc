@@ -0,0 +1,216 @@
+//# tLELFused.cc: Test the fused evaluation of LEL expressions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#include <casacore/lattices/LEL/LELFused.h>
+#include <casacore/lattices/LEL/LatticeExpr.h>
+#include <casacore/lattices/LEL/LatticeExprNode.h>
+#include <casacore/lattices/Lattices/ArrayLattice.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/SubLattice.h>
+#include <casacore/lattices/LRegions/LCPixelSet.h>
+#include <casacore/lattices/LRegions/LCBox.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <sstream>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test the fusion of the elementwise operations in an LEL expression
+// by comparing the results and masks with the unfused evaluation.
+// </summary>
+
+// Evaluate the expression with and without fusion and compare the results.
+// Return the fused evaluation plan.
+template<typename T>
+String checkExpr (const LatticeExprNode& node, Double tol)
+{
+  LatticeExprNode::setFusion (False);
+  LatticeExpr<T> expr1(node);
+  Array<T> arr1 = expr1.get();
+  Array<Bool> mask1 = expr1.getMask();
+  LatticeExprNode::setFusion (True);
+  LatticeExpr<T> expr2(node);
+  Array<T> arr2 = expr2.get();
+  Array<Bool> mask2 = expr2.getMask();
+  AlwaysAssertExit (allNearAbs (arr1, arr2, tol));
+  AlwaysAssertExit (allEQ (mask1, mask2));
+  // Also evaluate a section.
+  Slicer section(IPosition(2,1,2), IPosition(2,5,3));
+  AlwaysAssertExit (allNearAbs (expr1.getSlice(section),
+                                expr2.getSlice(section), tol));
+  std::ostringstream os;
+  expr2.show (os);
+  return os.str();
+}
+
+// Get the number of shared subexpressions from the plan.
+uInt nshared (const String& plan)
+{
+  String::size_type pos = plan.find (" shared");
+  AlwaysAssertExit (pos != String::npos);
+  String::size_type st = plan.rfind (' ', pos-1);
+  return atoi (plan.substr(st+1, pos-st-1).c_str());
+}
+
+void testFloat()
+{
+  IPosition shape(2,12,9);
+  Array<Float> arra(shape), arrb(shape), arrc(shape);
+  indgen (arra, Float(1), Float(0.5));
+  indgen (arrb, Float(-3), Float(0.25));
+  indgen (arrc, Float(10), Float(-1));
+  ArrayLattice<Float> la(arra), lb(arrb), lc(arrc);
+  LatticeExprNode a(la), b(lb), c(lc);
+  // The maximum is a scalar computed once before the fused loop.
+  String plan = checkExpr<Float> (sqrt(a*a + b*b) / max(c), 1e-5);
+  AlwaysAssertExit (plan.find("LELFused: 5 instructions, 2 inputs") == 0);
+  // A subexpression used twice is evaluated once.
+  LatticeExprNode sq = a*a;
+  plan = checkExpr<Float> (sq + sqrt(sq) - -b, 1e-5);
+  AlwaysAssertExit (nshared(plan) == 1);
+  // Equal subexpressions in other objects are found as well.
+  plan = checkExpr<Float> (sin(a+b) * cos(a+b) + exp(-abs(c)/10), 1e-5);
+  AlwaysAssertExit (nshared(plan) == 1);
+  plan = checkExpr<Float> (atan(tanh(a/10)) + floor(b) - ceil(c) +
+                           log10(a) + log(a) + sinh(b/10) + cosh(b/10), 1e-5);
+  AlwaysAssertExit (plan.find("LELFused") == 0);
+  // Functions that cannot be fused are evaluated as inputs.
+  plan = checkExpr<Float> (round(a) * 2 + iif(b>0, b, c), 1e-5);
+  AlwaysAssertExit (plan.find("LELFused: 2 instructions, 2 inputs") == 0);
+  // A single operation is not fused.
+  plan = checkExpr<Float> (a+b, 0);
+  AlwaysAssertExit (plan.find("LELFused") == String::npos);
+  // A scalar expression is not fused.
+  LatticeExprNode sc = max(a) + 2*min(b);
+  AlwaysAssertExit (sc.isScalar());
+  AlwaysAssertExit (near (sc.getFloat(), max(arra) + 2*min(arrb)));
+}
+
+void testMasked()
+{
+  IPosition shape(2,12,9);
+  Array<Double> arra(shape), arrb(shape);
+  indgen (arra, 1.);
+  indgen (arrb, 0.5, 2.);
+  Array<Bool> m1(shape), m2(shape);
+  for (uInt i=0; i<m1.size(); ++i) {
+    m1.data()[i] = (i%3 != 0);
+    m2.data()[i] = (i%4 != 1);
+  }
+  ArrayLattice<Double> la(arra), lb(arrb);
+  SubLattice<Double> sa(la, LCPixelSet(m1, LCBox(shape)));
+  SubLattice<Double> sb(lb, LCPixelSet(m2, LCBox(shape)));
+  LatticeExprNode a(sa), b(sb), c(lb);
+  // One masked input.
+  String plan = checkExpr<Double> (a*c + c/2, 1e-12);
+  AlwaysAssertExit (plan.find("LELFused") == 0);
+  // Two masked inputs; their masks are combined.
+  plan = checkExpr<Double> (a*b - sqrt(a) + 1, 1e-12);
+  AlwaysAssertExit (plan.find("LELFused") == 0);
+  // The masked lattices are not equal to the unmasked one.
+  plan = checkExpr<Double> (a*a + b*c, 1e-12);
+  AlwaysAssertExit (plan.find("3 inputs") != String::npos);
+  // value() removes the mask, so it cannot be fused.
+  plan = checkExpr<Double> (value(a)*2 + value(b)*3, 1e-12);
+  AlwaysAssertExit (plan.find("2 inputs") != String::npos);
+}
+
+void testComplex()
+{
+  IPosition shape(2,12,9);
+  Array<Complex> arra(shape);
+  indgen (arra, Complex(1,2), Complex(0.5,-0.25));
+  ArrayLattice<Complex> la(arra);
+  LatticeExprNode a(la);
+  String plan = checkExpr<Complex> (a*a - exp(a/10) + sqrt(a) * 2, 1e-4);
+  AlwaysAssertExit (plan.find("LELFused") == 0);
+  Array<DComplex> darra(shape);
+  convertArray (darra, arra);
+  ArrayLattice<DComplex> dla(darra);
+  LatticeExprNode da(dla);
+  plan = checkExpr<DComplex> (da*da + sin(da)/cos(da), 1e-10);
+  AlwaysAssertExit (plan.find("LELFused") == 0);
+}
+
+// Persistent lattices with the same name are evaluated once.
+void testPaged()
+{
+  IPosition shape(2,12,9);
+  Array<Float> arr(shape);
+  indgen (arr);
+  {
+    PagedArray<Float> pa(TiledShape(shape), "tLELFused_tmp.pa");
+    pa.put (arr);
+  }
+  PagedArray<Float> pa1("tLELFused_tmp.pa");
+  PagedArray<Float> pa2("tLELFused_tmp.pa");
+  String plan = checkExpr<Float> (LatticeExprNode(pa1) * 2 +
+                                  LatticeExprNode(pa2) / 2, 1e-5);
+  AlwaysAssertExit (plan.find("1 inputs, 1 shared") != String::npos);
+  // A view of the full lattice is the same lattice.
+  SubLattice<Float> full(pa1, AxesSpecifier(False));
+  plan = checkExpr<Float> (LatticeExprNode(pa1) * 2 -
+                           LatticeExprNode(full) / 2, 1e-5);
+  AlwaysAssertExit (plan.find("1 inputs, 1 shared") != String::npos);
+  // A view with transposed axes of a square lattice has the same name and
+  // shape, but cannot be made, so cannot be mixed up with the lattice.
+  {
+    PagedArray<Float> pa(TiledShape(IPosition(2,9,9)), "tLELFused_tmp.sq");
+    pa.put (arr(Slicer(IPosition(2,0,0), IPosition(2,9,9))));
+  }
+  PagedArray<Float> sq("tLELFused_tmp.sq");
+  Bool thrown = False;
+  try {
+    SubLattice<Float> transposed(sq, AxesSpecifier(IPosition(2,0,1),
+                                                   IPosition(2,1,0)));
+  } catch (const AipsError&) {
+    thrown = True;
+  }
+  AlwaysAssertExit (thrown);
+  LatticeExprNode::setFusion (False);
+  AlwaysAssertExit (! LatticeExprNode::fusion());
+  LatticeExprNode::setFusion (True);
+}
+
+int main()
+{
+  try {
+    testFloat();
+    testMasked();
+    testComplex();
+    testPaged();
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,132 @@
+//# tLatticeExprParallel.cc: Test evaluating an expression in parallel
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#include <casacore/lattices/LEL/LatticeExpr.h>
+#include <casacore/lattices/LEL/LatticeExprNode.h>
+#include <casacore/lattices/Lattices/ArrayLattice.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/TempLattice.h>
+#include <casacore/lattices/Lattices/SubLattice.h>
+#include <casacore/lattices/LRegions/LCPixelSet.h>
+#include <casacore/lattices/LRegions/LCBox.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test copying an expression to a lattice while evaluating its chunks
+// in parallel.
+// </summary>
+
+// Copy the expression using the given number of threads and check
+// the result.
+void checkCopy (const LatticeExprNode& node, const Array<Float>& expected,
+                uInt nthreads)
+{
+  LatticeExprNode::setNThreads (nthreads);
+  AlwaysAssertExit (LatticeExprNode::nthreads() == nthreads);
+  LatticeExpr<Float> expr(node);
+  // Use a small tile shape, so there are many chunks.
+  TiledShape tshape(expr.shape(), IPosition(3,8,5,2));
+  PagedArray<Float> out(tshape, "tLatticeExprParallel_tmp.out");
+  out.copyData (expr);
+  AlwaysAssertExit (allNearAbs (out.get(), expected, 1e-5));
+  // The expression can also be copied to a memory lattice.
+  TempLattice<Float> tmp(tshape, 0);
+  tmp.copyData (expr);
+  AlwaysAssertExit (allNearAbs (tmp.get(), expected, 1e-5));
+}
+
+int main()
+{
+  try {
+    IPosition shape(3,40,30,6);
+    Array<Float> arra(shape), arrb(shape);
+    indgen (arra, Float(1), Float(0.25));
+    indgen (arrb, Float(-5), Float(0.5));
+    {
+      PagedArray<Float> pa(TiledShape(shape, IPosition(3,16,16,3)),
+                           "tLatticeExprParallel_tmp.a");
+      pa.put (arra);
+    }
+    PagedArray<Float> pa("tLatticeExprParallel_tmp.a");
+    // A second paged lattice is read at the same time as the first one.
+    PagedArray<Float> pb(TiledShape(shape, IPosition(3,16,16,3)),
+                         "tLatticeExprParallel_tmp.b");
+    pb.put (arrb);
+    ArrayLattice<Float> lb(arrb);
+    Array<Bool> mask(shape);
+    for (uInt i=0; i<mask.size(); ++i) {
+      mask.data()[i] = (i%7 != 0);
+    }
+    SubLattice<Float> sb(lb, LCPixelSet(mask, LCBox(shape)));
+    // Parallel evaluation is off by default.
+    AlwaysAssertExit (LatticeExprNode::nthreads() == 1);
+    // Lattices with the same name share the read mutex. Other lattices
+    // have their own one.
+    AlwaysAssertExit (LatticeExprNode::readMutex(pa) ==
+                      LatticeExprNode::readMutex
+                      (PagedArray<Float>("tLatticeExprParallel_tmp.a")));
+    AlwaysAssertExit (LatticeExprNode::readMutex(pa) !=
+                      LatticeExprNode::readMutex(lb));
+    AlwaysAssertExit (LatticeExprNode::readMutex(lb) !=
+                      LatticeExprNode::readMutex(lb));
+    LatticeExprNode a(pa), b(lb), mb(sb), pbn(pb);
+    // A nested expression is a lattice in the expression.
+    LatticeExpr<Float> nested(a*2 + 1);
+    Array<Float> expected1 = sqrt(arra*arra + arrb*arrb) / max(arrb);
+    Array<Float> expected2 = (arra*Float(2) + Float(1)) * arrb - arra;
+    Array<Float> expected3 = arrb * Float(3);
+    Array<Float> expected5 = arra * arrb - arrb;
+    Array<Float> expected4 = arrb.copy();
+    for (uInt i=0; i<arra.size(); ++i) {
+      if (arra.data()[i] > 20) {
+        expected4.data()[i] = arra.data()[i];
+      }
+    }
+    for (uInt nthr : {1, 4, 0}) {
+      for (Bool fuse : {True, False}) {
+        LatticeExprNode::setFusion (fuse);
+        checkCopy (sqrt(a*a + b*b) / max(b), expected1, nthr);
+        checkCopy (LatticeExprNode(nested) * b - a, expected2, nthr);
+        checkCopy (mb * 3, expected3, nthr);
+        checkCopy (iif(a > 20, a, b), expected4, nthr);
+        checkCopy (a * pbn - b, expected5, nthr);
+      }
+    }
+    LatticeExprNode::setNThreads (1);
+    LatticeExprNode::setFusion (True);
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,45 @@
+//# LatticeApply.cc: Non-templated base class of LatticeApply
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/lattices/LatticeMath/LatticeApply.h>
+#include <casacore/casa/OS/OMP.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+std::atomic<uInt> LatticeApplyBase::theirNThreads(0);
+
+void LatticeApplyBase::setNThreads (uInt nthreads)
+{
+  theirNThreads = nthreads;
+}
+
+uInt LatticeApplyBase::nthreadsUsed()
+{
+  uInt nthr = theirNThreads;
+  return (nthr == 0  ?  OMP::maxThreads() : nthr);
+}
+
+} //# NAMESPACE CASACORE - END
@@ -29,7 +29,11 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
 #include <casacore/scimath/Mathematics/NumericTraits.h>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -42,6 +46,38 @@ class LatticeProgress;
 class IPosition;
 class LatticeRegion;
 
+
+// <summary>
+// Non-templated base class of LatticeApply
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// This class holds the number of threads used by all
+// <linkto class=LatticeApply>LatticeApply</linkto> instantiations.
+// </synopsis>
+
+class LatticeApplyBase
+{
+public:
+// Set the maximum number of threads used to collapse the lines or chunks.
+// 1 means collapsing serially; 0 (the default) means the number of
+// threads OpenMP can use.
+    static void setNThreads (uInt nthreads);
+
+// Get the maximum number of threads as set by <src>setNThreads</src>.
+    static uInt nthreads()
+      { return theirNThreads; }
+
+protected:
+// Get the actual number of threads to use (resolving 0).
+    static uInt nthreadsUsed();
+
+private:
+    static std::atomic<uInt> theirNThreads;
+};
+
 // <summary>
 // Optimally iterate through a Lattice and apply provided function object
 // </summary>
@@ -101,6 +137,26 @@ class LatticeRegion;
 // the chunk of data passed in. The <src>nstepsDone</src> function
 // in these classes can be used to monitor the progress.
 // <p>
+// The lines or chunks can be collapsed in parallel by multiple threads
+// (see <linkto class=LatticeApplyBase>LatticeApplyBase::setNThreads</linkto>)
+// if the collapser implements the <src>clone</src> and <src>merge</src>
+// functions. The lattices are read and written by the calling thread
+// (because a lattice is not thread-safe), while the data read are
+// collapsed in parallel, each thread using its own clone of the collapser.
+// <ul>
+// <li> <src>lineApply</src> and <src>lineMultiApply</src> distribute the
+//      lines of a tile or chunk over the threads.
+// <li> <src>tiledApply</src> distributes the output chunks (i.e., the tiles
+//      on the axes not collapsed) over the threads, so the tiles of a
+//      chunk are still accumulated in the same order by a single thread.
+//      Thus collapsing the entire lattice to a single value is done
+//      serially. The data of the output chunks processed in parallel
+//      are held in memory.
+// </ul>
+// The values collapsed by each thread and the order in which they are
+// processed are the same as when collapsing serially, so the results are
+// identical.
+// <p>
 // The class is Doubly templated.  Ths first template type
 // is for the data type you are processing.  The second type is
 // for what type you want the results of the processing assigned to.
@@ -132,7 +188,7 @@ class LatticeRegion;
 //# </todo>
 
  
-template <class T, class U=T> class LatticeApply
+template <class T, class U=T> class LatticeApply : public LatticeApplyBase
 {
 public:
 
@@ -248,6 +304,45 @@ private:
     static IPosition _chunkShape(
         uInt axis, const MaskedLattice<T>& latticeIn
     );
+
+    // The data of an output chunk to be collapsed by a thread.
+    struct TiledChunk;
+
+    // Make the clones of the collapser to be used by the threads.
+    // An empty vector is returned if the collapser cannot be cloned or if
+    // a single thread is used.
+    // <group>
+    static std::vector<std::unique_ptr<LineCollapser<T,U>>> makeClones
+    (const LineCollapser<T,U>& collapser, uInt nOutPixelsPerCollapse);
+    static std::vector<std::unique_ptr<TiledCollapser<T,U>>> makeClones
+    (const TiledCollapser<T,U>& collapser, uInt nOutPixelsPerCollapse);
+    // </group>
+
+    // Determine the output shape of a chunk in <src>tiledApply</src>
+    // from the shape of its first cursor. The accumulator sizes before
+    // and after the result axis are returned in n1 and n3.
+    static void initOutChunk (IPosition& outShape, uInt64& n1, uInt64& n3,
+                              const IPosition& cursorShape,
+                              const IPosition& ioMap, uInt resultAxis);
+
+    // Collapse the data of a single tile in <src>tiledApply</src>.
+    static void processTile (TiledCollapser<T,U>& collapser,
+                             const Array<T>& cursor,
+                             const Array<Bool>& mask, Bool useMask,
+                             const IPosition& pos,
+                             const IPosition& collapseAxes, uInt collStart,
+                             const IPosition& iterAxes,
+                             const IPosition& ioMap, uInt resultAxis);
+
+    // Collapse the output chunks in parallel (one chunk per clone) and
+    // write the results.
+    static void collapseChunks
+    (std::vector<TiledChunk>& chunks, TiledCollapser<T,U>& collapser,
+     std::vector<std::unique_ptr<TiledCollapser<T,U>>>& clones,
+     Bool useMask,
+     const IPosition& collapseAxes, uInt collStart,
+     const IPosition& iterAxes, const IPosition& ioMap, uInt resultAxis,
+     MaskedLattice<U>& latticeOut, Lattice<Bool>* maskOut);
 };
 
 } //# NAMESPACE CASACORE - END
@@ -44,7 +44,10 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <exception>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -148,6 +151,8 @@ void LatticeApply<T,U>::lineApply (MaskedLattice<U>& latticeOut,
     Int nResult = latticeOut.shape().product() / nLine;
     AlwaysAssert (nResult==1, AipsError);
     collapser.init (nResult);
+    std::vector<std::unique_ptr<LineCollapser<T,U>>> clones =
+        makeClones (collapser, nResult);
     if (tellProgress != 0) tellProgress->init (nLine);
 
 // Iterate through all the lines.
@@ -185,22 +190,62 @@ void LatticeApply<T,U>::lineApply (MaskedLattice<U>& latticeOut,
 	U* result = array.getStorage (deleteIt);
 	Bool* resultMask = arrayMask.getStorage (deleteMask);
 	uInt n = array.nelements() / nResult;
-	for (uInt i=0; i<n; ++i) {
-	    DebugAssert (! inIter.atEnd(), AipsError);
-	    const IPosition pos (inIter.position());
-	    Vector<Bool> mask;
-	    if (useMask) {
-		// Casting const away is innocent.
-		// Remove degenerate axes to get a 1D array.
-		Array<Bool> tmp;
-		((MaskedLattice<T>&)latticeIn).getMaskSlice
+	if (clones.empty()  ||  n < 2) {
+	    for (uInt i=0; i<n; ++i) {
+		DebugAssert (! inIter.atEnd(), AipsError);
+		const IPosition pos (inIter.position());
+		Vector<Bool> mask;
+		if (useMask) {
+		    // Casting const away is innocent.
+		    // Remove degenerate axes to get a 1D array.
+		    Array<Bool> tmp;
+		    ((MaskedLattice<T>&)latticeIn).getMaskSlice
                           (tmp, Slicer(pos, inIter.cursorShape()), True);
-		mask.reference (tmp);
+		    mask.reference (tmp);
+		}
+		collapser.process (result[i], resultMask[i],
+				   inIter.vectorCursor(), mask, pos);
+		++inIter;
+		if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
+	    }
+	} else {
+	    // Read the lines first, because a lattice is not thread-safe.
+	    // Thereafter each thread collapses a consecutive range of lines.
+	    std::vector<Vector<T>> lines(n);
+	    std::vector<Vector<Bool>> masks(n);
+	    std::vector<IPosition> positions(n);
+	    for (uInt i=0; i<n; ++i) {
+		DebugAssert (! inIter.atEnd(), AipsError);
+		positions[i] = inIter.position();
+		lines[i].reference (inIter.vectorCursor().copy());
+		if (useMask) {
+		    Array<Bool> tmp;
+		    ((MaskedLattice<T>&)latticeIn).getMaskSlice
+			(tmp, Slicer(positions[i], inIter.cursorShape()), True);
+		    masks[i].reference (tmp);
+		}
+		++inIter;
+		if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
+	    }
+	    const Int nthr = std::min (uInt(clones.size()), n);
+	    std::vector<std::exception_ptr> errors(nthr);
+#pragma omp parallel for num_threads(nthr)
+	    for (Int k=0; k<nthr; ++k) {
+		try {
+		    for (uInt i=uInt64(k)*n/nthr; i<uInt64(k+1)*n/nthr; ++i) {
+			clones[k]->process (result[i], resultMask[i],
+					    lines[i], masks[i], positions[i]);
+		    }
+		} catch (...) {
+		    errors[k] = std::current_exception();
+		}
+	    }
+	    for (Int k=0; k<nthr; ++k) {
+		if (errors[k]) {
+		    std::rethrow_exception (errors[k]);
+		}
+		collapser.merge (*clones[k]);
 	    }
-	    collapser.process (result[i], resultMask[i],
-			       inIter.vectorCursor(), mask, pos);
-	    ++inIter;
-	    if (tellProgress != 0) tellProgress->nstepsDone (inIter.nsteps());
 	}
 	array.putStorage (result, deleteIt);
 	arrayMask.putStorage (resultMask, deleteMask);
@@ -257,6 +302,8 @@ void LatticeApply<T,U>::lineMultiApply (PtrBlock<MaskedLattice<U>*>& latticeOut,
         uInt nExpectedIters = inShape.product()/chunkShapeInit.product();
         tellProgress->init(nExpectedIters);
     }
+    std::vector<std::unique_ptr<LineCollapser<T,U>>> clones =
+        makeClones (collapser, nOut);
     uInt nDone = 0;
     for (latIter.reset(); ! latIter.atEnd(); ++latIter) {
         const IPosition cp = latIter.position();
@@ -276,7 +323,48 @@ void LatticeApply<T,U>::lineMultiApply (PtrBlock<MaskedLattice<U>*>& latticeOut,
             resultArray[k] = Array<U>(resultArrayShape);
             resultArrayMask[k] = Array<Bool>(resultArrayShape);
         }
+        // The number of lines in the chunk.
+        const uInt64 nLines = chunkShape.product() / chunkShape[collapseAxis];
         Bool done = False;
+        if (! clones.empty()  &&  nLines > 1) {
+            // Each thread collapses a consecutive range of lines; the
+            // order of the lines is the same as in the serial loop below.
+            const Int nthr = std::min (uInt64(clones.size()), nLines);
+            std::vector<std::exception_ptr> errors(nthr);
+#pragma omp parallel for num_threads(nthr)
+            for (Int t=0; t<nthr; ++t) {
+                try {
+                    Vector<U> res(nOut);
+                    Vector<Bool> resMask(nOut);
+                    for (uInt64 line=uInt64(t)*nLines/nthr;
+                         line<uInt64(t+1)*nLines/nthr; ++line) {
+                        IPosition start = toIPositionInArray
+                            (line, resultArrayShape);
+                        IPosition end(start);
+                        end[collapseAxis] = chunkShape[collapseAxis] - 1;
+                        Vector<T> data(chunk(start, end));
+                        Vector<Bool> mask = useMask
+                            ? Vector<Bool>(maskChunk(start, end))
+                            : noMask;
+                        clones[t]->multiProcess (res, resMask, data, mask,
+                                                 cp + start);
+                        for (uInt k=0; k<nOut; ++k) {
+                            resultArray[k](start) = res[k];
+                            resultArrayMask[k](start) = resMask[k];
+                        }
+                    }
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            }
+            for (Int t=0; t<nthr; ++t) {
+                if (errors[t]) {
+                    std::rethrow_exception (errors[t]);
+                }
+                collapser.merge (*clones[t]);
+            }
+            done = True;
+        }
         while (! done) {
             Vector<T> data(chunk(chunkSliceStart, chunkSliceEnd));
             Vector<Bool> mask = useMask
@@ -465,14 +553,46 @@ void LatticeApply<T,U>::tiledApply (
 	    }
     }
 
+    // Collapse in parallel if possible and if there are multiple output
+    // chunks. The number of threads is limited, so the data of the chunks
+    // held in memory do not exceed a quarter of the free memory.
+    std::vector<std::unique_ptr<TiledCollapser<T,U>>> clones =
+        makeClones (collapser, outShape.product());
+    if (! clones.empty()) {
+        uInt64 nchunks = 1;
+        uInt64 chunkBytes = sizeof(T) + (useMask ? sizeof(Bool) : 0);
+        for (j=0; j<inDim; ++j) {
+            if (std::find (collapseAxes.begin(), collapseAxes.end(), Int(j))
+                != collapseAxes.end()) {
+                chunkBytes *= inShape(j);
+            } else {
+                nchunks *= 1 + trc(j)/inTileShape(j) - blc(j)/inTileShape(j);
+                chunkBytes *= inTileShape(j);
+            }
+        }
+        Int64 memFree = HostInfo::memoryFree();
+        uInt64 maxBytes = (memFree > 0  ?  uInt64(memFree) * 1024 / 4
+                                        :  uInt64(256*1024*1024));
+        uInt64 nthr = std::min (uInt64(clones.size()),
+                                std::min (nchunks, maxBytes / chunkBytes));
+        if (nthr < 2) {
+            clones.clear();
+        } else {
+            clones.resize (nthr);
+        }
+    }
+
     // Iterate through all the tiles.
     // TileStepper is set up in such a way that the collapse axes are iterated
     // fastest. When all collapse axes are handled, thus when the iter axes
     // position changes, we have to write that part.
+    // When collapsing in parallel, the tiles of the next output chunks are
+    // gathered first.
 
     Bool firstTime = True;
     IPosition outPos(outDim, 0);
     IPosition iterPos(outDim, 0);
+    std::vector<TiledChunk> chunks;
     while (! inIter.atEnd()) {
 
         // Calculate the size of each chunk of output data.
@@ -482,21 +602,22 @@ void LatticeApply<T,U>::tiledApply (
 	    const Array<T>& iterCursor = inIter.cursor();
 	    // In order to use the pointers-to-array-data below, the array *must*
 	    // be contiguous or the results will in general be incorrect.
-	    // Ditto for the mask
-	    const Array<T>& cursor = iterCursor.contiguousStorage()
-	    	? iterCursor : iterCursor.copy();
+	    // Ditto for the mask.
+	    // When collapsing in parallel, the cursor is always copied,
+	    // because the iterator reuses its buffer.
+	    const Array<T>& cursor = iterCursor.contiguousStorage()  &&
+	        clones.empty()  ?  iterCursor : iterCursor.copy();
 	    ThrowIf(
 	    	! cursor.contiguousStorage(), "cursor array is not contiguous"
 	    );
 	    const IPosition& cursorShape = cursor.shape();
 	    IPosition pos = inIter.position();
-	    IPosition latPos = pos;
 	    Array<Bool> mask;
 	    if (useMask) {
 	        // Casting const away is innocent.
 	        ((MaskedLattice<T>&)latticeIn).getMaskSlice(mask, Slicer(pos, cursorShape));
 	        if (! mask.contiguousStorage()) {
-	        	mask = mask.copy();
+	        	mask.reference (mask.copy());
 	        	ThrowIf(
 	        		! mask.contiguousStorage(), "mask array is not contiguous"
 	        	);
@@ -508,113 +629,44 @@ void LatticeApply<T,U>::tiledApply (
 		        iterPos(j) = pos(axis);
 	        }
 	    }
-	    if (firstTime  ||  outPos != iterPos) {
-	        if (!firstTime) {
-		        Array<U> result;
-		        Array<Bool> resultMask;
-		        collapser.endAccumulator (result, resultMask, outShape);
-		        latticeOut.putSlice (result, outPos);
-		        if (maskOut != 0) {
-		            maskOut->putSlice (resultMask, outPos);
-		        }
-	        }
-	        firstTime = False;
-	        outPos = iterPos;
-	        uInt64 n1 = 1;
-	        uInt64 n3 = 1;
-	        for (j=0; j<outDim; ++j) {
-		        if (ioMap(j) >= 0) {
-		            outShape(j) = cursorShape(ioMap(j));
-		            if (j < resultAxis) {
-		                n1 *= outShape(j);
-		            }
-                    else {
-		                n3 *= outShape(j);
-		            }
-		        }
-	        }
-	        collapser.initAccumulator (n1, n3);
-	    }
-
-        // Put the collapsed lines into an output buffer
-        // Initialize the cursor position needed in the loop.
-
-	    IPosition curPos (inDim, 0);
-
-        // Determine the increment for the first collapse axes.
-        // This is done by taking the difference between the adresses of two pixels
-        // in the cursor (if there are 2 pixels).
-
-	    IPosition chunkShape (inDim, 1);
-	    for (j=0; j<collStart; ++j) {
-	        const uInt axis = collapseAxes(j);
-	        chunkShape(axis) = cursorShape(axis);
-	    }
-	    uInt nval = chunkShape.product();
-	    const uInt axis = collapseAxes(0);
-
-    	IPosition p0(inDim, 0);
-	    IPosition p1(inDim, 0);
-	    p1[axis] = 1;
-	    // general for Arrays with contiguous or non-contiguous storage.
-	    uInt dataIncr = &(cursor(p1)) - &(cursor(p0));
-	    uInt maskIncr = useMask ? &(mask(p1)) - &(mask(p0)) : 0;
-
-        // Iterate in the outer loop through the iterator axes.
-        // Iterate in the inner loop through the collapse axes.
-
-	    uInt index1 = 0;
-	    uInt index3 = 0;
-	    for (;;) {
-	        for (;;) {
-		        if (useMask) {
-		            collapser.process (
-                        index1, index3, &(cursor(curPos)), &(mask(curPos)),
-				        dataIncr, maskIncr, nval, latPos, chunkShape
-                    );
-		        }
-                else {
-		            collapser.process(
-                        index1, index3,
-				        &(cursor(curPos)), 0,
-				        dataIncr, maskIncr, nval, latPos, chunkShape
-                    );
-		        }
-		        // Increment a collapse axis until all axes are handled.
-		        for (j=collStart; j<collDim; ++j) {
-		            uInt axis = collapseAxes(j);
-		            if (++curPos(axis) < cursorShape(axis)) {
-			            break;
-		            }
-		            curPos(axis) = 0;               // restart this axis
-		        }
-		        if (j == collDim) {
-		            break;                          // all axes are handled
-		        }
+	    if (! clones.empty()) {
+	        if (chunks.empty()  ||  chunks.back().outPos != iterPos) {
+	            if (chunks.size() == clones.size()) {
+	                collapseChunks (chunks, collapser, clones, useMask,
+	                                collapseAxes, collStart, iterAxes,
+	                                ioMap, resultAxis, latticeOut, maskOut);
+	                chunks.clear();
+	            }
+	            chunks.emplace_back();
+	            TiledChunk& chunk = chunks.back();
+	            chunk.outPos = iterPos;
+	            chunk.outShape = outShape;
+	            initOutChunk (chunk.outShape, chunk.n1, chunk.n3,
+	                          cursorShape, ioMap, resultAxis);
 	        }
-	
-            // Increment an iteration axis until all iteration axes are handled.
-	
-	        for (j=0; j<iterDim; ++j) {
-		        uInt arraxis = iterAxes(j);
-		        uInt axis = ioMap(arraxis);
-		        ++latPos(axis);
-		        if (++curPos(axis) < cursorShape(axis)) {
-		            if (arraxis < resultAxis) {
-		                ++index1;
+	        TiledChunk& chunk = chunks.back();
+	        chunk.cursors.push_back (cursor);
+	        chunk.masks.push_back (mask);
+	        chunk.positions.push_back (pos);
+	    } else {
+	        if (firstTime  ||  outPos != iterPos) {
+	            if (!firstTime) {
+		            Array<U> result;
+		            Array<Bool> resultMask;
+		            collapser.endAccumulator (result, resultMask, outShape);
+		            latticeOut.putSlice (result, outPos);
+		            if (maskOut != 0) {
+		                maskOut->putSlice (resultMask, outPos);
 		            }
-                    else {
-		                ++index3;
-			            index1 = 0;
-		            }
-		            break;
-		        }
-		        curPos(axis) = 0;
-		        latPos(axis) = pos(axis);
-	        }
-	        if (j == iterDim) {
-		        break;
+	            }
+	            firstTime = False;
+	            outPos = iterPos;
+	            uInt64 n1, n3;
+	            initOutChunk (outShape, n1, n3, cursorShape, ioMap, resultAxis);
+	            collapser.initAccumulator (n1, n3);
 	        }
+	        processTile (collapser, cursor, mask, useMask, pos,
+	                     collapseAxes, collStart, iterAxes, ioMap, resultAxis);
 	    }
 	    ++inIter;
 	    if (tellProgress != 0) {
@@ -622,17 +674,233 @@ void LatticeApply<T,U>::tiledApply (
         }
     }
 
-    // Write out the last output array.
+    if (! clones.empty()) {
+        collapseChunks (chunks, collapser, clones, useMask,
+                        collapseAxes, collStart, iterAxes,
+                        ioMap, resultAxis, latticeOut, maskOut);
+    } else {
+        // Write out the last output array.
+        Array<U> result;
+        Array<Bool> resultMask;
+        collapser.endAccumulator (result, resultMask, outShape);
+        latticeOut.putSlice (result, outPos);
+        if (maskOut != 0) {
+            maskOut->putSlice (resultMask, outPos);
+        }
+    }
+    if (tellProgress != 0) tellProgress->done();
+}
+
+
+template <class T, class U>
+struct LatticeApply<T,U>::TiledChunk
+{
+    IPosition outPos;
+    IPosition outShape;
+    uInt64 n1;
+    uInt64 n3;
+    std::vector<Array<T>> cursors;
+    std::vector<Array<Bool>> masks;
+    std::vector<IPosition> positions;
     Array<U> result;
     Array<Bool> resultMask;
-    collapser.endAccumulator (result, resultMask, outShape);
-    latticeOut.putSlice (result, outPos);
-    if (maskOut != 0) {
-        maskOut->putSlice (resultMask, outPos);
+};
+
+template <class T, class U>
+std::vector<std::unique_ptr<LineCollapser<T,U>>> LatticeApply<T,U>::makeClones
+(const LineCollapser<T,U>& collapser, uInt nOutPixelsPerCollapse)
+{
+    std::vector<std::unique_ptr<LineCollapser<T,U>>> clones;
+    uInt nthr = nthreadsUsed();
+    for (uInt i=0; i<nthr  &&  nthr>1; ++i) {
+        clones.emplace_back (collapser.clone());
+        if (! clones.back()) {
+            clones.clear();
+            break;
+        }
+        clones.back()->init (nOutPixelsPerCollapse);
     }
-    if (tellProgress != 0) tellProgress->done();
+    return clones;
 }
 
+template <class T, class U>
+std::vector<std::unique_ptr<TiledCollapser<T,U>>> LatticeApply<T,U>::makeClones
+(const TiledCollapser<T,U>& collapser, uInt nOutPixelsPerCollapse)
+{
+    std::vector<std::unique_ptr<TiledCollapser<T,U>>> clones;
+    uInt nthr = nthreadsUsed();
+    for (uInt i=0; i<nthr  &&  nthr>1; ++i) {
+        clones.emplace_back (collapser.clone());
+        if (! clones.back()) {
+            clones.clear();
+            break;
+        }
+        clones.back()->init (nOutPixelsPerCollapse);
+    }
+    return clones;
+}
+
+template <class T, class U>
+void LatticeApply<T,U>::initOutChunk (IPosition& outShape,
+                                      uInt64& n1, uInt64& n3,
+                                      const IPosition& cursorShape,
+                                      const IPosition& ioMap,
+                                      uInt resultAxis)
+{
+    n1 = 1;
+    n3 = 1;
+    for (uInt j=0; j<outShape.nelements(); ++j) {
+        if (ioMap(j) >= 0) {
+            outShape(j) = cursorShape(ioMap(j));
+            if (j < resultAxis) {
+                n1 *= outShape(j);
+            } else {
+                n3 *= outShape(j);
+            }
+        }
+    }
+}
+
+template <class T, class U>
+void LatticeApply<T,U>::processTile (TiledCollapser<T,U>& collapser,
+                                     const Array<T>& cursor,
+                                     const Array<Bool>& mask, Bool useMask,
+                                     const IPosition& pos,
+                                     const IPosition& collapseAxes,
+                                     uInt collStart,
+                                     const IPosition& iterAxes,
+                                     const IPosition& ioMap,
+                                     uInt resultAxis)
+{
+    uInt j;
+    const IPosition& cursorShape = cursor.shape();
+    const uInt inDim = cursorShape.nelements();
+    const uInt collDim = collapseAxes.nelements();
+    const uInt iterDim = iterAxes.nelements();
+    IPosition latPos = pos;
+
+    // Put the collapsed lines into an output buffer
+    // Initialize the cursor position needed in the loop.
+
+    IPosition curPos (inDim, 0);
+
+    // Determine the increment for the first collapse axes.
+    // This is done by taking the difference between the adresses of two pixels
+    // in the cursor (if there are 2 pixels).
+
+    IPosition chunkShape (inDim, 1);
+    for (j=0; j<collStart; ++j) {
+        const uInt axis = collapseAxes(j);
+        chunkShape(axis) = cursorShape(axis);
+    }
+    uInt nval = chunkShape.product();
+    const uInt axis = collapseAxes(0);
+
+    IPosition p0(inDim, 0);
+    IPosition p1(inDim, 0);
+    p1[axis] = 1;
+    // general for Arrays with contiguous or non-contiguous storage.
+    uInt dataIncr = &(cursor(p1)) - &(cursor(p0));
+    uInt maskIncr = useMask ? &(mask(p1)) - &(mask(p0)) : 0;
+
+    // Iterate in the outer loop through the iterator axes.
+    // Iterate in the inner loop through the collapse axes.
+
+    uInt index1 = 0;
+    uInt index3 = 0;
+    for (;;) {
+        for (;;) {
+            if (useMask) {
+                collapser.process (
+                    index1, index3, &(cursor(curPos)), &(mask(curPos)),
+                    dataIncr, maskIncr, nval, latPos, chunkShape
+                );
+            }
+            else {
+                collapser.process(
+                    index1, index3,
+                    &(cursor(curPos)), 0,
+                    dataIncr, maskIncr, nval, latPos, chunkShape
+                );
+            }
+            // Increment a collapse axis until all axes are handled.
+            for (j=collStart; j<collDim; ++j) {
+                uInt axis = collapseAxes(j);
+                if (++curPos(axis) < cursorShape(axis)) {
+                    break;
+                }
+                curPos(axis) = 0;               // restart this axis
+            }
+            if (j == collDim) {
+                break;                          // all axes are handled
+            }
+        }
+
+        // Increment an iteration axis until all iteration axes are handled.
+
+        for (j=0; j<iterDim; ++j) {
+            uInt arraxis = iterAxes(j);
+            uInt axis = ioMap(arraxis);
+            ++latPos(axis);
+            if (++curPos(axis) < cursorShape(axis)) {
+                if (arraxis < resultAxis) {
+                    ++index1;
+                }
+                else {
+                    ++index3;
+                    index1 = 0;
+                }
+                break;
+            }
+            curPos(axis) = 0;
+            latPos(axis) = pos(axis);
+        }
+        if (j == iterDim) {
+            break;
+        }
+    }
+}
+
+template <class T, class U>
+void LatticeApply<T,U>::collapseChunks
+(std::vector<TiledChunk>& chunks, TiledCollapser<T,U>& collapser,
+ std::vector<std::unique_ptr<TiledCollapser<T,U>>>& clones,
+ Bool useMask,
+ const IPosition& collapseAxes, uInt collStart,
+ const IPosition& iterAxes, const IPosition& ioMap, uInt resultAxis,
+ MaskedLattice<U>& latticeOut, Lattice<Bool>* maskOut)
+{
+    const Int nchunk = chunks.size();
+    std::vector<std::exception_ptr> errors(nchunk);
+#pragma omp parallel for num_threads(nchunk)
+    for (Int i=0; i<nchunk; ++i) {
+        try {
+            TiledChunk& chunk = chunks[i];
+            TiledCollapser<T,U>& coll = *clones[i];
+            coll.initAccumulator (chunk.n1, chunk.n3);
+            for (size_t k=0; k<chunk.cursors.size(); ++k) {
+                processTile (coll, chunk.cursors[k], chunk.masks[k], useMask,
+                             chunk.positions[k], collapseAxes, collStart,
+                             iterAxes, ioMap, resultAxis);
+            }
+            coll.endAccumulator (chunk.result, chunk.resultMask,
+                                 chunk.outShape);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
+    // Merge the clones and write the results in the serial order.
+    for (Int i=0; i<nchunk; ++i) {
+        if (errors[i]) {
+            std::rethrow_exception (errors[i]);
+        }
+        collapser.merge (*clones[i]);
+        latticeOut.putSlice (chunks[i].result, chunks[i].outPos);
+        if (maskOut != 0) {
+            maskOut->putSlice (chunks[i].resultMask, chunks[i].outPos);
+        }
+    }
+}
 
 
 template <class T, class U>
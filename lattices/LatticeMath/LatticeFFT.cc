@@ -0,0 +1,119 @@
+//# LatticeFFT.cc: functions for doing FFT's on Lattices.
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/lattices/LatticeMath/LatticeFFT.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/OS/OMP.h>
+#include <algorithm>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+std::atomic<uInt64> LatticeFFT::theirMaxMemory(0);
+std::atomic<uInt>   LatticeFFT::theirNThreads(0);
+
+void LatticeFFT::setMaxMemory (uInt64 nbytes)
+{
+  theirMaxMemory = nbytes;
+}
+
+void LatticeFFT::setNThreads (uInt nthreads)
+{
+  theirNThreads = nthreads;
+}
+
+uInt LatticeFFT::nthreadsUsed()
+{
+  uInt nthr = theirNThreads;
+  return (nthr == 0  ?  OMP::maxThreads() : nthr);
+}
+
+uInt64 LatticeFFT::maxSlabPixels (uInt pixelSize)
+{
+  uInt64 nbytes = theirMaxMemory;
+  if (nbytes == 0) {
+    // Use a quarter of the free memory (given in KBytes).
+    ptrdiff_t memFree = HostInfo::memoryFree();
+    nbytes = (memFree > 0  ?  uInt64(memFree) * 1024 / 4 : 256*1024*1024);
+  }
+  return std::max (uInt64(1), nbytes / pixelSize);
+}
+
+std::vector<std::vector<uInt>> LatticeFFT::planPasses
+(const IPosition& latticeShape, const IPosition& tileShape,
+ const Vector<Bool>& whichAxes, uInt64 maxPixels,
+ std::vector<IPosition>& slabShapes)
+{
+  const uInt ndim = latticeShape.size();
+  // A slab is aligned with the tiles on the axes not transformed,
+  // so each tile is accessed only once per pass.
+  IPosition tileSlab(ndim);
+  for (uInt i=0; i<ndim; ++i) {
+    Int64 len = (i < tileShape.size()  ?  tileShape[i] : 1);
+    tileSlab[i] = std::max (Int64(1), std::min (len, Int64(latticeShape[i])));
+  }
+  std::vector<std::vector<uInt>> passes;
+  slabShapes.clear();
+  uInt axis = 0;
+  while (True) {
+    // Find the next axis to transform (of length > 1).
+    while (axis < ndim  &&  !(whichAxes[axis]  &&  latticeShape[axis] > 1)) {
+      axis++;
+    }
+    if (axis == ndim) {
+      break;
+    }
+    std::vector<uInt> passAxes(1, axis);
+    IPosition slabShape(tileSlab);
+    slabShape[axis] = latticeShape[axis];
+    // Add the next axes to transform as long as the slab fits in memory.
+    for (axis++; axis < ndim; ++axis) {
+      if (whichAxes[axis]  &&  latticeShape[axis] > 1) {
+        IPosition shape(slabShape);
+        shape[axis] = latticeShape[axis];
+        if (uInt64(shape.product()) > maxPixels) {
+          break;
+        }
+        slabShape = shape;
+        passAxes.push_back (axis);
+      }
+    }
+    // If the slab is still too large, reduce the other axes
+    // (starting at the last one).
+    for (uInt i=ndim; i>0  &&  uInt64(slabShape.product()) > maxPixels;) {
+      --i;
+      if (std::find (passAxes.begin(), passAxes.end(), i) == passAxes.end()) {
+        uInt64 rest = slabShape.product() / slabShape[i];
+        slabShape[i] = std::max (uInt64(1), maxPixels / rest);
+      }
+    }
+    passes.push_back (passAxes);
+    slabShapes.push_back (slabShape);
+  }
+  return passes;
+}
+
+} //# NAMESPACE CASACORE - END
@@ -31,10 +31,13 @@
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/scimath/Mathematics/NumericTraits.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
+#include <atomic>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 template <class T> class Lattice;
+class IPosition;
 
 // <summary>Functions for Fourier transforming Lattices</summary>
 
@@ -48,6 +51,23 @@ template <class T> class Lattice;
 // </etymology>
 
 // <synopsis> 
+// The complex->complex transforms (also those done as part of the
+// real->complex and complex->real transforms) are done on slabs of the
+// lattice held in memory. A slab spans the full length of the axes being
+// transformed and a tile on the other axes, so each tile of a tiled
+// lattice (e.g., a PagedArray) is read and written once per pass.
+// As many axes as fit in memory are transformed in a single pass; a
+// 2-dim transform of an image plane that fits in memory takes a single
+// pass. All lines along an axis in a slab are transformed by a single
+// batched FFTW plan (see <linkto class=FFTServer>FFTServer::fft0Axis</linkto>).
+// The lines are transformed in place, so no work buffer of the size of a
+// slab is needed.
+// <br>The slabs are read and written sequentially, but are transformed
+// in parallel by at most <src>nthreadsUsed()</src> threads, each with its
+// own FFTServer. Slabs of the same shape share the plan in the FFTW plan
+// cache.
+// <br>By default the slabs in memory can use a quarter of the free memory.
+// It can be changed using <src>setMaxMemory</src>.
 // </synopsis> 
 
 // <example>
@@ -144,6 +164,53 @@ public:
         const Bool doShift=True, Bool doFast=False
     );
   // </group>
+
+  // Set the maximum memory (in bytes) used for the slabs in memory.
+  // 0 means a quarter of the free memory (which is the default).
+  static void setMaxMemory (uInt64 nbytes);
+
+  // Get the maximum memory (in bytes) used for the slabs in memory.
+  // 0 means a quarter of the free memory.
+  static uInt64 maxMemory()
+    { return theirMaxMemory; }
+
+  // Set the maximum number of threads transforming slabs in parallel.
+  // 0 means the maximum number of OpenMP threads (which is the default).
+  static void setNThreads (uInt nthreads);
+
+  // Get the maximum number of threads as set by <src>setNThreads</src>.
+  static uInt nthreads()
+    { return theirNThreads; }
+
+  // Get the actual maximum number of threads to use.
+  static uInt nthreadsUsed();
+
+private:
+  // Do an in-place complex->complex transform of the given axes.
+  // The lattice is read in slabs (see the synopsis). If <src>doShift</src>
+  // is True, the origin is the center (using FFTServer::fftAxis), otherwise
+  // the first element (using FFTServer::fft0Axis) after which the result is
+  // flipped if <src>doFlip</src> is True.
+  template <class ComplexType> static void cfftSlabs(
+      Lattice<ComplexType> & cLattice, const Vector<Bool> & whichAxes,
+      Bool toFrequency, Bool doShift, Bool doFlip
+  );
+
+  // Determine the passes over the lattice for a complex->complex transform
+  // of the given axes. It returns the axes transformed in each pass and
+  // fills the slab shape of each pass. A slab has at most
+  // <src>maxPixels</src> pixels unless a single line is longer.
+  static std::vector<std::vector<uInt>> planPasses(
+      const IPosition & latticeShape, const IPosition & tileShape,
+      const Vector<Bool> & whichAxes, uInt64 maxPixels,
+      std::vector<IPosition> & slabShapes
+  );
+
+  // Get the maximum number of pixels in a slab for the given pixel size.
+  static uInt64 maxSlabPixels (uInt pixelSize);
+
+  static std::atomic<uInt64> theirMaxMemory;
+  static std::atomic<uInt>   theirNThreads;
 };
 
 // implement template specializations to throw exceptions in the relevant cases.
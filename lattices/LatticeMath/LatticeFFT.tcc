@@ -30,6 +30,7 @@
 #include <casacore/lattices/LatticeMath/LatticeFFT.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Exceptions/Error.h>
@@ -43,6 +44,9 @@
 #include <casacore/lattices/Lattices/TiledLineStepper.h>
 #include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <exception>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -80,39 +84,82 @@ template <class ComplexType> void LatticeFFT::cfft2d(
 
 template <class ComplexType> void LatticeFFT::cfft(Lattice<ComplexType>& cLattice,
 		     const Vector<Bool>& whichAxes, const Bool toFrequency) {
-  const uInt ndim = cLattice.ndim();
-  DebugAssert(ndim > 0, AipsError);
-  DebugAssert(ndim == whichAxes.nelements(), AipsError);
-  FFTServer<typename NumericTraits<ComplexType>::ConjugateType,ComplexType> ffts;
-  const IPosition latticeShape = cLattice.shape();
-  const IPosition tileShape = cLattice.niceCursorShape();
-
-  for (uInt dim = 0; dim < ndim; dim++) {
-    if (whichAxes(dim) == True) {
-      TiledLineStepper ts(latticeShape, tileShape, dim);
-      LatticeIterator<ComplexType> li(cLattice, ts);
-      for (li.reset(); !li.atEnd(); li++) {
-	ffts.fft(li.rwVectorCursor(), toFrequency);
-      }
-    }
-  }
+  DebugAssert(cLattice.ndim() > 0, AipsError);
+  DebugAssert(cLattice.ndim() == whichAxes.nelements(), AipsError);
+  LatticeFFT::cfftSlabs(cLattice, whichAxes, toFrequency, True, False);
 }
 
 template <class ComplexType> void LatticeFFT::cfft0(Lattice<ComplexType>& cLattice,
 		       const Vector<Bool>& whichAxes, const Bool toFrequency) {
-  const uInt ndim = cLattice.ndim();
-  DebugAssert(ndim > 0, AipsError);
-  DebugAssert(ndim == whichAxes.nelements(), AipsError);
-  FFTServer<typename NumericTraits<ComplexType>::ConjugateType,ComplexType> ffts;
-  const IPosition latticeShape = cLattice.shape();
-  const IPosition tileShape = cLattice.niceCursorShape();
+  DebugAssert(cLattice.ndim() > 0, AipsError);
+  DebugAssert(cLattice.ndim() == whichAxes.nelements(), AipsError);
+  LatticeFFT::cfftSlabs(cLattice, whichAxes, toFrequency, False, False);
+}
 
-  for (uInt dim = 0; dim < ndim; dim++) {
-    if (whichAxes(dim) == True) {
-      TiledLineStepper ts(latticeShape, tileShape, dim);
-      LatticeIterator<ComplexType> li(cLattice, ts);
-      for (li.reset(); !li.atEnd(); li++) {
-	ffts.fft0(li.rwVectorCursor(), toFrequency);
+template <class ComplexType> void LatticeFFT::cfftSlabs(
+    Lattice<ComplexType>& cLattice, const Vector<Bool>& whichAxes,
+    Bool toFrequency, Bool doShift, Bool doFlip) {
+  const IPosition latticeShape = cLattice.shape();
+  // The memory limit is shared by the slabs transformed in parallel.
+  const uInt nthr = nthreadsUsed();
+  std::vector<IPosition> slabShapes;
+  const std::vector<std::vector<uInt>> passes =
+    planPasses(latticeShape, cLattice.niceCursorShape(), whichAxes,
+               std::max(uInt64(1), maxSlabPixels(sizeof(ComplexType)) / nthr),
+               slabShapes);
+  if (passes.empty()) {
+    return;
+  }
+  // The lines along an axis are transformed by a single batched plan.
+  // Each thread has its own FFTServer, but slabs of the same shape share
+  // the plan in the FFTW plan cache, so it is made only once.
+  std::vector<FFTServer<typename NumericTraits<ComplexType>::ConjugateType,
+                        ComplexType>> servers(nthr);
+  // Make all cursor axes true axes, so the cursor has the lattice
+  // dimensionality.
+  const IPosition allAxes = IPosition::makeAxisPath(latticeShape.size());
+  for (size_t pass = 0; pass < passes.size(); pass++) {
+    LatticeStepper ls(latticeShape, slabShapes[pass], allAxes, allAxes,
+                      LatticeStepper::RESIZE);
+    // Create an iterator to setup the cache of the lattice.
+    LatticeIterator<ComplexType> li(cLattice, ls);
+    std::vector<Slicer> sections;
+    for (ls.reset(); !ls.atEnd(); ls++) {
+      sections.push_back(Slicer(ls.position(), ls.cursorShape()));
+    }
+    // Lattice I/O is not thread-safe, so the slabs are read and written
+    // sequentially in batches of nthr slabs. The slabs in a batch are
+    // transformed in parallel. An exception cannot leave a parallel loop,
+    // so it is kept and rethrown afterwards.
+    for (size_t st = 0; st < sections.size(); st += nthr) {
+      const Int n = std::min(size_t(nthr), sections.size() - st);
+      std::vector<Array<ComplexType>> slabs(n);
+      for (Int k = 0; k < n; k++) {
+        cLattice.getSlice(slabs[k], sections[st+k]);
+      }
+      std::vector<std::exception_ptr> errors(n);
+#pragma omp parallel for num_threads(n)
+      for (Int k = 0; k < n; k++) {
+        try {
+          for (uInt axis : passes[pass]) {
+            if (doShift) {
+              servers[k].fftAxis(slabs[k], axis, toFrequency);
+            } else {
+              servers[k].fft0Axis(slabs[k], axis, toFrequency);
+              if (doFlip) {
+                servers[k].flipAxis(slabs[k], axis, False);
+              }
+            }
+          }
+        } catch (...) {
+          errors[k] = std::current_exception();
+        }
+      }
+      for (Int k = 0; k < n; k++) {
+        if (errors[k]) {
+          std::rethrow_exception(errors[k]);
+        }
+        cLattice.putSlice(slabs[k], sections[st+k].start());
       }
     }
   }
@@ -153,58 +200,36 @@ template <class ComplexType> void LatticeFFT::rcfft(
   inlocal.put(in.get());
   FFTServer<typename NumericTraits<ComplexType>::ConjugateType,ComplexType> ffts;
 
-    {
-      for (uInt dim = 0; dim < ndim; dim++) {
-	if (whichAxes(dim) == True) {
-	  if (dim == firstAxis) { 
-	    if (inShape(dim) != 1) { // Do real->complex Transforms
-	      LatticeIterator<typename NumericTraits<ComplexType>::ConjugateType> inIter(inlocal,
-					       TiledLineStepper(inShape,
-								tileShape,dim));
-	      LatticeIterator<ComplexType> outIter(out,
-					       TiledLineStepper(outShape,
-								tileShape,dim));
-	      for (inIter.reset(), outIter.reset();
-		   !inIter.atEnd() && !outIter.atEnd(); inIter++, outIter++) {
-		if (doShift) {
-		  if(doFast){
-		    // ffts.flip(inIter.rwVectorCursor(), True, False);
-		    ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-		  }
-		  else{
-		    ffts.fft(outIter.woVectorCursor(), inIter.vectorCursor());
-		  }
-		    
-		} else {
-		  ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-		}
-	      }
-	    } else { // just copy the data
-	      out.copyData(LatticeExpr<ComplexType>(in));
-	    }
-	  }
-	  else { // Do complex->complex transforms
-	    if (inShape(dim) != 1) { 
-	      LatticeIterator<ComplexType> iter(out,
-					    TiledLineStepper(outShape,
-							     tileShape, dim));
-	      for (iter.reset(); !iter.atEnd(); iter++) {
-		if (doShift) {
-		  if(doFast){
-		    ffts.fft0(iter.rwVectorCursor(),True);
-		  }
-		  else{
-		    ffts.fft(iter.rwVectorCursor(),True);
-		  }
-		} else {
-		  ffts.fft0(iter.rwVectorCursor(), True);
-		}
-	      }
-	    }
-	  }
+  // The first axis is treated specially.
+  const uInt dim = firstAxis;
+  if (inShape(dim) != 1) { // Do real->complex Transforms
+    LatticeIterator<typename NumericTraits<ComplexType>::ConjugateType> inIter(inlocal,
+				     TiledLineStepper(inShape,
+						      tileShape,dim));
+    LatticeIterator<ComplexType> outIter(out,
+				     TiledLineStepper(outShape,
+						      tileShape,dim));
+    for (inIter.reset(), outIter.reset();
+	 !inIter.atEnd() && !outIter.atEnd(); inIter++, outIter++) {
+      if (doShift) {
+	if(doFast){
+	  // ffts.flip(inIter.rwVectorCursor(), True, False);
+	  ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
 	}
+	else{
+	  ffts.fft(outIter.woVectorCursor(), inIter.vectorCursor());
+	}
+      } else {
+	ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
       }
     }
+  } else { // just copy the data
+    out.copyData(LatticeExpr<ComplexType>(in));
+  }
+  // Do the complex->complex transforms of the other axes.
+  Vector<Bool> otherAxes(whichAxes.copy());
+  otherAxes(firstAxis) = False;
+  LatticeFFT::cfftSlabs(out, otherAxes, True, doShift && !doFast, False);
 }
 //
 // ----------------MYRCFFT--------------------------------------
@@ -323,55 +348,35 @@ template <class ComplexType> void LatticeFFT::crfft(
   const IPosition tileShape = in.niceCursorShape();
   FFTServer<typename NumericTraits<ComplexType>::ConjugateType,ComplexType> ffts;
 
-  uInt dim = ndim;
-  while (dim != 0) {
-    dim--;
-    if (whichAxes(dim) == True) {
-      if (dim != firstAxis) { // Do complex->complex Transforms
-	if (inShape(dim) != 1) { // no need to do anything unless len > 1
-	  LatticeIterator<ComplexType> iter(in, TiledLineStepper(inShape,
-							     tileShape, dim));
-	  for (iter.reset(); !iter.atEnd(); iter++) {
-	    if (doShift) {
-	      if(doFast){
-		ffts.fft0(iter.rwVectorCursor(), False);
-		ffts.flip(iter.rwVectorCursor(), False, False);
-	      }
-	      else{
-	      //	      ffts.fft(iter.rwVectorCursor(), 2, False);
-	      ffts.fft(iter.rwVectorCursor(),False);
-	      }
-	    } else {
-	      ffts.fft0(iter.rwVectorCursor(), False);
-	    }
-	  }
-	}
-      } else { // the first axis is treated specially
-	if (inShape(dim) != 1) { // Do complex->real transforms
-	  RO_LatticeIterator<ComplexType> inIter(in,
-					     TiledLineStepper(inShape,
-							      tileShape, dim));
-	  LatticeIterator<typename NumericTraits<ComplexType>::ConjugateType> outIter(out,
-					 TiledLineStepper(outShape,
-							  tileShape, dim));
-	  for (inIter.reset(), outIter.reset(); 
-	       !inIter.atEnd() && !outIter.atEnd(); inIter++, outIter++) {
-	    if (doShift) {
-	      if(doFast){
-	       ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-	       ffts.flip(outIter.rwVectorCursor(), False, False);
-	      }else{
-		ffts.fft(outIter.woVectorCursor(), inIter.vectorCursor());
-	      }
-	    } else {
-	      ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
-	    }
-	  }
-	} else { // just copy the data truncating the imaginary parts.
-	  out.copyData(LatticeExpr<typename NumericTraits<ComplexType>::ConjugateType>(real(in)));
+  // Do the complex->complex transforms of the other axes.
+  Vector<Bool> otherAxes(whichAxes.copy());
+  otherAxes(firstAxis) = False;
+  LatticeFFT::cfftSlabs(in, otherAxes, False, doShift && !doFast,
+                        doShift && doFast);
+  // The first axis is treated specially.
+  const uInt dim = firstAxis;
+  if (inShape(dim) != 1) { // Do complex->real transforms
+    RO_LatticeIterator<ComplexType> inIter(in,
+				       TiledLineStepper(inShape,
+							tileShape, dim));
+    LatticeIterator<typename NumericTraits<ComplexType>::ConjugateType> outIter(out,
+				   TiledLineStepper(outShape,
+						    tileShape, dim));
+    for (inIter.reset(), outIter.reset(); 
+	 !inIter.atEnd() && !outIter.atEnd(); inIter++, outIter++) {
+      if (doShift) {
+	if(doFast){
+	 ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
+	 ffts.flip(outIter.rwVectorCursor(), False, False);
+	}else{
+	  ffts.fft(outIter.woVectorCursor(), inIter.vectorCursor());
 	}
+      } else {
+	ffts.fft0(outIter.woVectorCursor(), inIter.vectorCursor());
       }
     }
+  } else { // just copy the data truncating the imaginary parts.
+    out.copyData(LatticeExpr<typename NumericTraits<ComplexType>::ConjugateType>(real(in)));
   }
 }
 
@@ -74,10 +74,36 @@ class IPosition;
 // For example, if you are computing sums of squares for statistical
 // purposes, you might use higher precision (FLoat->Double) for this.
 // No check is made that the template types are self-consistent.
+// <p>
+// A collapser implementing <src>clone</src> (and <src>merge</src> if it
+// keeps state) is collapsed by multiple threads, otherwise serially.
+// Note that no collapser in casacore itself uses <src>lineApply</src>;
+// it is used by collapsers in client code (e.g., moment calculators).
 // </synopsis>
 
 // <example>
+// A collapser summing the values in a line. It keeps the number of lines
+// collapsed, which is merged from the clones.
 // <srcblock>
+// class SumCollapser : public LineCollapser<Float>
+// {
+// public:
+//   virtual void init (uInt) {}
+//   virtual void process (Float& result, Bool& resultMask,
+//                         const Vector<Float>& line,
+//                         const Vector<Bool>& mask, const IPosition&)
+//     { result = sum(line); resultMask = True; ++itsNLines; }
+//   virtual void multiProcess (Vector<Float>&, Vector<Bool>&,
+//                              const Vector<Float>&, const Vector<Bool>&,
+//                              const IPosition&)
+//     { throw AipsError ("SumCollapser::multiProcess not implemented"); }
+//   virtual LineCollapser<Float>* clone() const
+//     { return new SumCollapser(); }
+//   virtual void merge (LineCollapser<Float>& clone)
+//     { SumCollapser& that = dynamic_cast<SumCollapser&>(clone);
+//       itsNLines += that.itsNLines; that.itsNLines = 0; }
+//   uInt64 itsNLines = 0;
+// };
 // </srcblock>
 // </example>
 
@@ -132,6 +158,25 @@ public:
 			       const Vector<T>& line,
 			       const Vector<Bool>& mask,
 			       const IPosition& pos) = 0;
+
+// Make a copy of this collapser, which is used by a worker thread when
+// LatticeApply collapses in parallel (see
+// <linkto class=LatticeApplyBase>LatticeApplyBase::setNThreads</linkto>).
+// The copy must have the same settings, but its own state, so it can be
+// used at the same time as this object. Its <src>init</src> function is
+// called before it is used.
+// <br>The default implementation returns a null pointer, meaning that the
+// collapser cannot be used in parallel, thus the lines are collapsed
+// serially.
+    virtual LineCollapser<T,U>* clone() const;
+
+// Merge the state of a copy made by <src>clone</src> that is not part of
+// the results (e.g., the position of the minimum) into this object and
+// reset it in the copy. The copies are merged in the order of the lines
+// they processed, thus the final state is the same as when collapsing
+// serially.
+// <br>The default implementation does nothing.
+    virtual void merge (LineCollapser<T,U>& clone);
 };
 
 
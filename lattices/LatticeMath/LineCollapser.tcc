@@ -42,6 +42,16 @@ Bool LineCollapser<T,U>::canHandleNullMask() const
     return False;
 }
 
+template<class T, class U>
+LineCollapser<T,U>* LineCollapser<T,U>::clone() const
+{
+    return 0;
+}
+
+template<class T, class U>
+void LineCollapser<T,U>::merge (LineCollapser<T,U>&)
+{}
+
 } //# NAMESPACE CASACORE - END
 
 
@@ -145,6 +145,13 @@ public:
     // Can handle null mask
     virtual Bool canHandleNullMask() const {return True;};
 
+    // Make a copy with the same pixel selection for use in a worker thread.
+    virtual TiledCollapser<T,U>* clone() const;
+
+    // Take over the minimum and maximum location found by the copy
+    // (if it found any).
+    virtual void merge (TiledCollapser<T,U>& clone);
+
     // Find the location of the minimum and maximum data values
     // in the input lattice.
      void minMaxPos(IPosition& minPos, IPosition& maxPos);
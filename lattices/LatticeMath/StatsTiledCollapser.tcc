@@ -294,6 +294,31 @@ void StatsTiledCollapser<T,U>::_convertNPts(
     nptsPtr = storage;
 }
 
+template <class T, class U>
+TiledCollapser<T,U>* StatsTiledCollapser<T,U>::clone() const
+{
+    return new StatsTiledCollapser<T,U> (_range, !_include, !_exclude,
+                                         _fixedMinMax);
+}
+
+template <class T, class U>
+void StatsTiledCollapser<T,U>::merge (TiledCollapser<T,U>& clone)
+{
+    // The copies are merged in the serial order, so the last location
+    // found is the same as when collapsing serially.
+    StatsTiledCollapser<T,U>& other = dynamic_cast<StatsTiledCollapser<T,U>&>(clone);
+    if (other._minpos.nelements() > 0) {
+        _minpos.resize (other._minpos.nelements());
+        _minpos = other._minpos;
+        other._minpos.resize (0);
+    }
+    if (other._maxpos.nelements() > 0) {
+        _maxpos.resize (other._maxpos.nelements());
+        _maxpos = other._maxpos;
+        other._maxpos.resize (0);
+    }
+}
+
 template <class T, class U>
 void StatsTiledCollapser<T,U>::minMaxPos(IPosition& minPos, IPosition& maxPos)
 {
@@ -152,6 +152,25 @@ public:
     virtual void endAccumulator (Array<U>& result, 
                                  Array<Bool>& resultMask,
 				 const IPosition& shape) = 0;
+
+// Make a copy of this collapser, which is used by a worker thread when
+// LatticeApply collapses in parallel (see
+// <linkto class=LatticeApplyBase>LatticeApplyBase::setNThreads</linkto>).
+// The copy must have the same settings, but its own state, so it can be
+// used at the same time as this object. Its <src>init</src> function is
+// called before it is used.
+// <br>The default implementation returns a null pointer, meaning that the
+// collapser cannot be used in parallel, thus the chunks are collapsed
+// serially.
+    virtual TiledCollapser<T,U>* clone() const;
+
+// Merge the state of a copy made by <src>clone</src> that is not part of
+// the results (e.g., the position of the minimum) into this object and
+// reset it in the copy. The copies are merged in the order of the chunks
+// they processed, thus the final state is the same as when collapsing
+// serially.
+// <br>The default implementation does nothing.
+    virtual void merge (TiledCollapser<T,U>& clone);
 };
 
 
@@ -0,0 +1,372 @@
+//# tLatticeApplyParallel.cc: Test collapsing lattices in parallel
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/lattices/LatticeMath/LatticeApply.h>
+#include <casacore/lattices/LatticeMath/LineCollapser.h>
+#include <casacore/lattices/LatticeMath/TiledCollapser.h>
+#include <casacore/lattices/LatticeMath/LatticeStatistics.h>
+#include <casacore/lattices/LatticeMath/LatticeStatsBase.h>
+#include <casacore/lattices/LatticeMath/StatsTiledCollapser.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/ArrayLattice.h>
+#include <casacore/lattices/Lattices/SubLattice.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <atomic>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test that collapsing a lattice in parallel using clones of the collapser
+// gives the same results as collapsing serially.
+// </summary>
+
+// Count the number of clones made and the number of lines collapsed by
+// them to check that the parallel path is taken.
+uInt nclones = 0;
+std::atomic<uInt64> ncloneLines(0);
+
+// Sum the values along a line. It keeps the position of the last line.
+class SumLineCollapser : public LineCollapser<Float>
+{
+public:
+  virtual void init (uInt) {}
+  virtual void process (Float& result, Bool& resultMask,
+                        const Vector<Float>& line, const Vector<Bool>& mask,
+                        const IPosition& pos)
+  {
+    result = 0;
+    resultMask = False;
+    for (uInt i=0; i<line.size(); ++i) {
+      if (mask.empty()  ||  mask[i]) {
+        result += line[i];
+        resultMask = True;
+      }
+    }
+    itsLastPos.resize (pos.size());
+    itsLastPos = pos;
+    if (itsIsClone) {
+      ++ncloneLines;
+    }
+  }
+  virtual void multiProcess (Vector<Float>& result, Vector<Bool>& resultMask,
+                             const Vector<Float>& line,
+                             const Vector<Bool>& mask, const IPosition& pos)
+  {
+    result.resize (2);
+    resultMask.resize (2);
+    process (result[0], resultMask[0], line, mask, pos);
+    result[1] = max(line);
+    resultMask[1] = resultMask[0];
+  }
+  virtual LineCollapser<Float>* clone() const
+  {
+    ++nclones;
+    SumLineCollapser* clone = new SumLineCollapser();
+    clone->itsIsClone = True;
+    return clone;
+  }
+  virtual void merge (LineCollapser<Float>& clone)
+  {
+    SumLineCollapser& other = dynamic_cast<SumLineCollapser&>(clone);
+    if (! other.itsLastPos.empty()) {
+      itsLastPos.resize (other.itsLastPos.size());
+      itsLastPos = other.itsLastPos;
+      other.itsLastPos.resize (0);
+    }
+  }
+  IPosition itsLastPos;
+  Bool itsIsClone = False;
+};
+
+// Sum the values and count the points of the collapsed axes.
+class SumTiledCollapser : public TiledCollapser<Float>
+{
+public:
+  virtual void init (uInt nOutPixelsPerCollapse)
+    { AlwaysAssertExit (nOutPixelsPerCollapse == 2); }
+  virtual void initAccumulator (uInt64 n1, uInt64 n3)
+  {
+    itsSum.resize (n1*n3);
+    itsSum.set (0);
+    itsNpts.resize (n1*n3);
+    itsNpts.set (0);
+    itsN1 = n1;
+  }
+  virtual void process (uInt index1, uInt index3,
+                        const Float* inData, const Bool* inMask,
+                        uInt dataIncr, uInt maskIncr, uInt nrval,
+                        const IPosition&, const IPosition&)
+  {
+    uInt inx = index1 + index3*itsN1;
+    for (uInt i=0; i<nrval; ++i) {
+      if (*inMask) {
+        itsSum[inx] += *inData;
+        itsNpts[inx]++;
+      }
+      inData += dataIncr;
+      inMask += maskIncr;
+    }
+    itsNcall++;
+  }
+  virtual void endAccumulator (Array<Float>& result, Array<Bool>& resultMask,
+                               const IPosition& shape)
+  {
+    result.resize (shape);
+    resultMask.resize (shape);
+    Float* res = result.data();
+    Bool* mask = resultMask.data();
+    uInt n3 = itsSum.size() / itsN1;
+    for (uInt i=0; i<n3; ++i) {
+      for (uInt j=0; j<itsN1; ++j) {
+        *res++ = itsSum[j + i*itsN1];
+        *mask++ = itsNpts[j + i*itsN1] > 0;
+      }
+      for (uInt j=0; j<itsN1; ++j) {
+        *res++ = itsNpts[j + i*itsN1];
+        *mask++ = True;
+      }
+    }
+  }
+  virtual TiledCollapser<Float>* clone() const
+  {
+    ++nclones;
+    return new SumTiledCollapser();
+  }
+  virtual void merge (TiledCollapser<Float>& clone)
+  {
+    SumTiledCollapser& other = dynamic_cast<SumTiledCollapser&>(clone);
+    itsNcall += other.itsNcall;
+    other.itsNcall = 0;
+  }
+  Block<Float> itsSum;
+  Block<uInt> itsNpts;
+  uInt64 itsN1;
+  uInt itsNcall = 0;
+};
+
+// Make a tiled lattice with a mask, so there are multiple tiles.
+void fillLattice (PagedArray<Float>& lat, ArrayLattice<Bool>& mask)
+{
+  Array<Float> arr(lat.shape());
+  Int64 i = 0;
+  for (auto& v : arr) {
+    v = Float((i*7919) % 1009) - 500;
+    ++i;
+  }
+  lat.put (arr);
+  Array<Bool> marr(lat.shape());
+  i = 0;
+  for (auto& v : marr) {
+    v = (i%11 != 3);
+    ++i;
+  }
+  mask.put (marr);
+}
+
+MaskedLattice<Float>* makeOutput (const IPosition& shape,
+                                  ArrayLattice<Float>& lat,
+                                  ArrayLattice<Bool>& mask)
+{
+  lat = ArrayLattice<Float>(shape);
+  mask = ArrayLattice<Bool>(shape);
+  SubLattice<Float>* sub = new SubLattice<Float>(lat, True);
+  sub->setPixelMask (mask, False);
+  return sub;
+}
+
+void testLineApply (const MaskedLattice<Float>& latIn, uInt axis)
+{
+  IPosition outShape = latIn.shape();
+  outShape[axis] = 1;
+  Array<Float> res[2];
+  Array<Bool> mask[2];
+  IPosition lastPos[2];
+  for (uInt i=0; i<2; ++i) {
+    LatticeApplyBase::setNThreads (i==0 ? 1 : 4);
+    ArrayLattice<Float> lat;
+    ArrayLattice<Bool> mlat;
+    std::unique_ptr<MaskedLattice<Float>> latOut
+      (makeOutput (outShape, lat, mlat));
+    SumLineCollapser collapser;
+    nclones = 0;
+    ncloneLines = 0;
+    LatticeApply<Float>::lineApply (*latOut, latIn, collapser, axis);
+    AlwaysAssertExit ((nclones > 0) == (i > 0));
+    // In parallel all lines must have been collapsed by the clones.
+    AlwaysAssertExit (ncloneLines == (i==0 ? 0 : outShape.product()));
+    res[i] = lat.get();
+    mask[i] = mlat.get();
+    lastPos[i] = collapser.itsLastPos;
+  }
+  AlwaysAssertExit (allEQ (res[0], res[1]));
+  AlwaysAssertExit (allEQ (mask[0], mask[1]));
+  AlwaysAssertExit (lastPos[0] == lastPos[1]);
+}
+
+void testLineMultiApply (const MaskedLattice<Float>& latIn, uInt axis)
+{
+  IPosition outShape = latIn.shape();
+  outShape[axis] = 1;
+  Array<Float> res[2][2];
+  Array<Bool> mask[2][2];
+  for (uInt i=0; i<2; ++i) {
+    LatticeApplyBase::setNThreads (i==0 ? 1 : 4);
+    ArrayLattice<Float> lat[2];
+    ArrayLattice<Bool> mlat[2];
+    std::unique_ptr<MaskedLattice<Float>> latOut0
+      (makeOutput (outShape, lat[0], mlat[0]));
+    std::unique_ptr<MaskedLattice<Float>> latOut1
+      (makeOutput (outShape, lat[1], mlat[1]));
+    PtrBlock<MaskedLattice<Float>*> latOut(2);
+    latOut[0] = latOut0.get();
+    latOut[1] = latOut1.get();
+    SumLineCollapser collapser;
+    nclones = 0;
+    ncloneLines = 0;
+    LatticeApply<Float>::lineMultiApply (latOut, latIn, collapser, axis);
+    AlwaysAssertExit ((nclones > 0) == (i > 0));
+    AlwaysAssertExit (ncloneLines == (i==0 ? 0 : outShape.product()));
+    for (uInt j=0; j<2; ++j) {
+      res[i][j] = lat[j].get();
+      mask[i][j] = mlat[j].get();
+    }
+  }
+  for (uInt j=0; j<2; ++j) {
+    AlwaysAssertExit (allEQ (res[0][j], res[1][j]));
+    AlwaysAssertExit (allEQ (mask[0][j], mask[1][j]));
+  }
+}
+
+// The output shape of tiledApply consists of the axes not collapsed
+// followed by an axis containing the collapsed values.
+IPosition makeOutShape (const IPosition& inShape,
+                        const IPosition& collapseAxes, uInt nresult)
+{
+  IPosition outShape = inShape.removeAxes (collapseAxes);
+  outShape.append (IPosition(1, nresult));
+  return outShape;
+}
+
+void testTiledApply (const MaskedLattice<Float>& latIn,
+                     const IPosition& collapseAxes, uInt nthread)
+{
+  IPosition outShape = makeOutShape (latIn.shape(), collapseAxes, 2);
+  Array<Float> res[2];
+  Array<Bool> mask[2];
+  uInt ncall[2];
+  for (uInt i=0; i<2; ++i) {
+    LatticeApplyBase::setNThreads (i==0 ? 1 : nthread);
+    ArrayLattice<Float> lat;
+    ArrayLattice<Bool> mlat;
+    std::unique_ptr<MaskedLattice<Float>> latOut
+      (makeOutput (outShape, lat, mlat));
+    SumTiledCollapser collapser;
+    nclones = 0;
+    LatticeApply<Float>::tiledApply (*latOut, latIn, collapser, collapseAxes,
+                                     outShape.size() - 1);
+    AlwaysAssertExit ((nclones > 0) == (i > 0));
+    res[i] = lat.get();
+    mask[i] = mlat.get();
+    ncall[i] = collapser.itsNcall;
+  }
+  AlwaysAssertExit (allEQ (res[0], res[1]));
+  AlwaysAssertExit (allEQ (mask[0], mask[1]));
+  AlwaysAssertExit (ncall[0] == ncall[1]);
+}
+
+// Collapse using the statistics collapser and compare the min/max position.
+void testStats (const MaskedLattice<Float>& latIn,
+                const IPosition& collapseAxes)
+{
+  IPosition outShape = makeOutShape (latIn.shape(), collapseAxes,
+                                     LatticeStatsBase::NACCUM);
+  Array<Double> res[2];
+  IPosition minPos[2], maxPos[2];
+  for (uInt i=0; i<2; ++i) {
+    LatticeApplyBase::setNThreads (i==0 ? 1 : 3);
+    ArrayLattice<Double> lat(outShape);
+    SubLattice<Double> latOut(lat, True);
+    StatsTiledCollapser<Float,Double> collapser(Vector<Float>(), True, True,
+                                                False);
+    LatticeApply<Float,Double>::tiledApply (latOut, latIn, collapser,
+                                            collapseAxes, outShape.size() - 1);
+    res[i] = lat.get();
+    collapser.minMaxPos (minPos[i], maxPos[i]);
+  }
+  AlwaysAssertExit (allEQ (res[0], res[1]));
+  AlwaysAssertExit (minPos[0] == minPos[1]);
+  AlwaysAssertExit (maxPos[0] == maxPos[1]);
+  // The statistics per plane using LatticeStatistics.
+  Array<Double> sums[2];
+  for (uInt i=0; i<2; ++i) {
+    LatticeApplyBase::setNThreads (i==0 ? 1 : 4);
+    LatticeStatistics<Float> stats(latIn, False, False);
+    stats.forceUseOldTiledApplyMethod();
+    AlwaysAssertExit (stats.setAxes (Vector<Int>(1, 0)));
+    AlwaysAssertExit (stats.getStatistic (sums[i], LatticeStatsBase::SUM));
+  }
+  AlwaysAssertExit (allEQ (sums[0], sums[1]));
+}
+
+int main()
+{
+  try {
+    IPosition shape(3, 32, 24, 20);
+    PagedArray<Float> lat(TiledShape(shape, IPosition(3, 8, 8, 5)),
+                          "tLatticeApplyParallel_tmp.data");
+    ArrayLattice<Bool> mask(shape);
+    fillLattice (lat, mask);
+    SubLattice<Float> latIn(lat);
+    latIn.setPixelMask (mask, False);
+    for (uInt axis=0; axis<shape.size(); ++axis) {
+      testLineApply (latIn, axis);
+      testLineMultiApply (latIn, axis);
+    }
+    testTiledApply (latIn, IPosition(1, 0), 4);
+    testTiledApply (latIn, IPosition(1, 1), 3);
+    testTiledApply (latIn, IPosition(1, 2), 2);
+    testTiledApply (latIn, IPosition(2, 0, 2), 4);
+    testTiledApply (latIn, IPosition(2, 1, 2), 5);
+    testStats (latIn, IPosition(1, 0));
+    testStats (latIn, IPosition(2, 0, 1));
+    // A lattice without a mask; the collapser needs a mask.
+    SubLattice<Float> latNoMask(lat);
+    testTiledApply (latNoMask, IPosition(1, 2), 4);
+    testLineApply (latNoMask, 1);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  LatticeApplyBase::setNThreads (0);
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,160 @@
+//# tLatticeFFTSlab.cc: Test the slab-wise Fourier transforms of Lattices
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#include <casacore/lattices/LatticeMath/LatticeFFT.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/ArrayLattice.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
+#include <casacore/scimath/Mathematics/FFTServer.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicMath/Random.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test the Fourier transforms of tiled lattices using small slabs, so the
+// transforms need multiple passes and partial slabs. The results are
+// compared with transforming the full array in memory.
+// </summary>
+
+Array<Complex> makeData (const IPosition& shape)
+{
+  MLCG gen(1, 2);
+  Uniform rand(&gen, -1, 1);
+  Array<Complex> arr(shape);
+  for (Complex& v : arr) {
+    v = Complex(rand(), rand());
+  }
+  return arr;
+}
+
+// Compare a lattice FFT using the given maximum slab memory with the
+// FFT of the entire array.
+void testCfft (const IPosition& shape, const IPosition& tileShape,
+               uInt64 maxMemory, Bool toFrequency)
+{
+  Array<Complex> data = makeData (shape);
+  Array<Complex> expected = data.copy();
+  FFTServer<Float,Complex> ffts;
+  ffts.fft (expected, toFrequency);
+  PagedArray<Complex> lat(TiledShape(shape, tileShape),
+                          "tLatticeFFTSlab_tmp.data");
+  lat.put (data);
+  LatticeFFT::setMaxMemory (maxMemory);
+  AlwaysAssertExit (LatticeFFT::maxMemory() == maxMemory);
+  LatticeFFT::cfft (lat, toFrequency);
+  AlwaysAssertExit (allNearAbs (lat.get(), expected, 1e-3));
+}
+
+// Transform some axes and the other axes thereafter, which should give
+// the same result as transforming all axes.
+void testCfftAxes (const IPosition& shape, uInt64 maxMemory)
+{
+  Array<Complex> data = makeData (shape);
+  Array<Complex> expected = data.copy();
+  FFTServer<Float,Complex> ffts;
+  ffts.fft0 (expected, True);
+  ArrayLattice<Complex> lat(data);
+  LatticeFFT::setMaxMemory (maxMemory);
+  Vector<Bool> axes(shape.size(), False);
+  axes[1] = True;
+  LatticeFFT::cfft0 (lat, axes, True);
+  LatticeFFT::cfft0 (lat, !axes, True);
+  AlwaysAssertExit (allNearAbs (lat.get(), expected, 1e-3));
+}
+
+// Do a real->complex transform followed by the inverse.
+void testRoundTrip (const IPosition& shape, const IPosition& tileShape,
+                    uInt64 maxMemory, Bool doFast)
+{
+  Array<Float> data = real (makeData (shape));
+  IPosition cshape(shape);
+  cshape[0] = shape[0]/2 + 1;
+  PagedArray<Float> rlat(TiledShape(shape, tileShape),
+                         "tLatticeFFTSlab_tmp.rdata");
+  PagedArray<Complex> clat(TiledShape(cshape, tileShape),
+                           "tLatticeFFTSlab_tmp.cdata");
+  rlat.put (data);
+  LatticeFFT::setMaxMemory (maxMemory);
+  LatticeFFT::rcfft (clat, rlat, True, doFast);
+  // Compare with the transform of the entire array.
+  Array<Complex> expected;
+  FFTServer<Float,Complex> ffts;
+  // Note that FFTServer::fft flips its input unless const.
+  const Array<Float>& cdata = data;
+  if (doFast) {
+    ffts.fft0 (expected, cdata);
+  } else {
+    ffts.fft (expected, cdata);
+  }
+  AlwaysAssertExit (allNearAbs (clat.get(), expected, 1e-3));
+  // The fast versions do not flip the same way, so only the normal
+  // versions give the original data back.
+  if (!doFast) {
+    rlat.set (0);
+    LatticeFFT::crfft (rlat, clat, True, doFast);
+    AlwaysAssertExit (allNearAbs (rlat.get(), data, 1e-4));
+  }
+}
+
+int main()
+{
+  try {
+    const IPosition shape(3, 16, 12, 5);
+    const IPosition tileShape(3, 4, 3, 2);
+    // Slabs are transformed serially and in parallel.
+    for (uInt nthreads : {1, 3}) {
+      LatticeFFT::setNThreads (nthreads);
+      AlwaysAssertExit (LatticeFFT::nthreadsUsed() == nthreads);
+      for (uInt64 maxMemory : {uInt64(0), uInt64(8*16*12*5),
+                               uInt64(8*16*3*2), uInt64(8*16)}) {
+        testCfft (shape, tileShape, maxMemory, True);
+        testCfft (shape, tileShape, maxMemory, False);
+        testCfft (IPosition(2, 9, 7), IPosition(2, 4, 2), maxMemory, True);
+        testCfftAxes (shape, maxMemory);
+        testRoundTrip (shape, tileShape, maxMemory, False);
+        testRoundTrip (IPosition(3, 15, 9, 3), IPosition(3, 4, 4, 2),
+                       maxMemory, False);
+        testRoundTrip (shape, tileShape, maxMemory, True);
+      }
+      // A line does not fit, so a slab is a single line.
+      testCfft (shape, tileShape, 8, True);
+    }
+    LatticeFFT::setNThreads (0);
+    LatticeFFT::setMaxMemory (0);
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
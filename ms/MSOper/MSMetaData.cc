@@ -30,6 +30,9 @@
 #include <casacore/casa/System/ProgressMeter.h>
 #include <casacore/casa/OS/Directory.h>
 #include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/measures/Measures/MeasTable.h>
 #include <casacore/measures/TableMeasures/ArrayQuantColumn.h>
 #include <casacore/ms/MSOper/MSKeys.h>
@@ -48,6 +51,110 @@
 
 namespace casacore {
 
+namespace {
+
+// The version of the persistent cache file.
+const uInt persistentCacheVersion = 1;
+
+// Functions to write and read the values in the persistent cache.
+// They are declared first, because they call each other.
+void putCacheValue(AipsIO& ios, const Quantity& value);
+void getCacheValue(AipsIO& ios, Quantity& value);
+void putCacheValue(AipsIO& ios, const MSMetaData::TimeStampProperties& value);
+void getCacheValue(AipsIO& ios, MSMetaData::TimeStampProperties& value);
+template <class T, class U>
+void putCacheValue(AipsIO& ios, const std::pair<T, U>& value);
+template <class T, class U>
+void getCacheValue(AipsIO& ios, std::pair<T, U>& value);
+template <class T> void putCacheValue(AipsIO& ios, const std::set<T>& value);
+template <class T> void getCacheValue(AipsIO& ios, std::set<T>& value);
+template <class T, class U>
+void putCacheValue(AipsIO& ios, const std::map<T, U>& value);
+template <class T, class U>
+void getCacheValue(AipsIO& ios, std::map<T, U>& value);
+
+template <class T> void putCacheValue(AipsIO& ios, const T& value) {
+    ios << value;
+}
+
+template <class T> void getCacheValue(AipsIO& ios, T& value) {
+    ios >> value;
+}
+
+void putCacheValue(AipsIO& ios, const Quantity& value) {
+    ios << value.getValue() << value.getUnit();
+}
+
+void getCacheValue(AipsIO& ios, Quantity& value) {
+    Double v;
+    String unit;
+    ios >> v >> unit;
+    value = Quantity(v, unit);
+}
+
+void putCacheValue(AipsIO& ios, const MSMetaData::TimeStampProperties& value) {
+    putCacheValue(ios, value.ddIDs);
+    ios << value.nrows;
+}
+
+void getCacheValue(AipsIO& ios, MSMetaData::TimeStampProperties& value) {
+    getCacheValue(ios, value.ddIDs);
+    ios >> value.nrows;
+}
+
+template <class T, class U>
+void putCacheValue(AipsIO& ios, const std::pair<T, U>& value) {
+    putCacheValue(ios, value.first);
+    putCacheValue(ios, value.second);
+}
+
+template <class T, class U>
+void getCacheValue(AipsIO& ios, std::pair<T, U>& value) {
+    getCacheValue(ios, value.first);
+    getCacheValue(ios, value.second);
+}
+
+template <class T> void putCacheValue(AipsIO& ios, const std::set<T>& value) {
+    ios << uInt64(value.size());
+    for (const T& v : value) {
+        putCacheValue(ios, v);
+    }
+}
+
+template <class T> void getCacheValue(AipsIO& ios, std::set<T>& value) {
+    uInt64 n;
+    ios >> n;
+    value.clear();
+    for (uInt64 i=0; i<n; ++i) {
+        T v;
+        getCacheValue(ios, v);
+        value.insert(value.end(), v);
+    }
+}
+
+template <class T, class U>
+void putCacheValue(AipsIO& ios, const std::map<T, U>& value) {
+    ios << uInt64(value.size());
+    for (const auto& kv : value) {
+        putCacheValue(ios, kv.first);
+        putCacheValue(ios, kv.second);
+    }
+}
+
+template <class T, class U>
+void getCacheValue(AipsIO& ios, std::map<T, U>& value) {
+    uInt64 n;
+    ios >> n;
+    value.clear();
+    for (uInt64 i=0; i<n; ++i) {
+        T key;
+        getCacheValue(ios, key);
+        getCacheValue(ios, value[key]);
+    }
+}
+
+}
+
 MSMetaData::MSMetaData(const MeasurementSet *const &ms, const Float maxCacheSizeMB)
     : _ms(ms), _showProgress(False), _cacheMB(0), _maxCacheMB(maxCacheSizeMB),
       _nACRows(0), _nXCRows(0), _nStates(0), _nSpw(0), _nFields(0),
@@ -91,7 +198,12 @@ MSMetaData::MSMetaData(const MeasurementSet *const &ms, const Float maxCacheSize
         File(ms->tableName()).exists() ? 0 : 1, ms
       ),
        _spwInfoStored(False), _forceSubScanPropsToCache(False),
-       _sourceTimes() {}
+       _persistentCache(False),
+       _sourceTimes() {
+    AipsrcValue<Bool>::find(
+        _persistentCache, "ms.metadata.persistentcache", False
+    );
+}
 
 MSMetaData::~MSMetaData() {}
 
@@ -3609,6 +3721,157 @@ void MSMetaData::_getScalarQuantDoubleColumn(
     );
 }
 
+String MSMetaData::_persistentCacheName() const {
+    return _ms->tableName() + "/table.mdcache";
+}
+
+Bool MSMetaData::_getPersistentCacheStamp(
+    uInt& mainCounter, uInt& ddCounter
+) const {
+    if (
+        ! _persistentCache || ! _ms->isRootTable()
+        || ! File(_ms->tableName()).isDirectory()
+    ) {
+        return False;
+    }
+    Table mainTab(*_ms);
+    Table ddTab(_ms->dataDescription());
+    mainCounter = mainTab.getModifyCounter();
+    ddCounter = ddTab.getModifyCounter();
+    // a zero counter means that the table is being written
+    // or that its changes cannot be tracked
+    return mainCounter > 0 && ddCounter > 0;
+}
+
+Bool MSMetaData::_readPersistentCache(
+    std::shared_ptr<std::map<ScanKey, MSMetaData::ScanProperties> >& scanProps,
+    std::shared_ptr<std::map<SubScanKey, MSMetaData::SubScanProperties> >& subScanProps
+) const {
+    uInt mainCounter, ddCounter;
+    if (! _getPersistentCacheStamp(mainCounter, ddCounter)) {
+        return False;
+    }
+    String name = _persistentCacheName();
+    if (! File(name).exists()) {
+        return False;
+    }
+    try {
+        AipsIO ios(name);
+        if (ios.getstart("MSMetaDataCache") != persistentCacheVersion) {
+            return False;
+        }
+        rownr_t nrow;
+        uInt mainCounterCache, ddCounterCache;
+        ios >> nrow >> mainCounterCache >> ddCounterCache;
+        if (
+            nrow != _ms->nrow() || mainCounterCache != mainCounter
+            || ddCounterCache != ddCounter
+        ) {
+            return False;
+        }
+        auto myscanprops = std::make_shared<std::map<ScanKey, ScanProperties>>();
+        uInt64 n;
+        ios >> n;
+        for (uInt64 i=0; i<n; ++i) {
+            ScanKey key;
+            ios >> key.obsID >> key.arrayID >> key.scan;
+            ScanProperties& props = (*myscanprops)[key];
+            getCacheValue(ios, props.firstExposureTime);
+            getCacheValue(ios, props.meanInterval);
+            getCacheValue(ios, props.spwNRows);
+            getCacheValue(ios, props.timeRange);
+            getCacheValue(ios, props.times);
+        }
+        auto myssprops = std::make_shared<std::map<SubScanKey, SubScanProperties>>();
+        ios >> n;
+        for (uInt64 i=0; i<n; ++i) {
+            SubScanKey key;
+            ios >> key.obsID >> key.arrayID >> key.scan >> key.fieldID;
+            SubScanProperties& props = (*myssprops)[key];
+            ios >> props.acRows >> props.xcRows;
+            getCacheValue(ios, props.antennas);
+            ios >> props.beginTime;
+            getCacheValue(ios, props.ddIDs);
+            ios >> props.endTime;
+            getCacheValue(ios, props.meanInterval);
+            getCacheValue(ios, props.firstExposureTime);
+            getCacheValue(ios, props.meanExposureTime);
+            getCacheValue(ios, props.spws);
+            getCacheValue(ios, props.spwNRows);
+            getCacheValue(ios, props.stateIDs);
+            getCacheValue(ios, props.timeProps);
+        }
+        ios.getend();
+        scanProps = myscanprops;
+        subScanProps = myssprops;
+        return True;
+    }
+    catch (const std::exception&) {
+        // a corrupt or incomplete file is ignored
+        return False;
+    }
+}
+
+void MSMetaData::_writePersistentCache(
+    const std::map<ScanKey, MSMetaData::ScanProperties>& scanProps,
+    const std::map<SubScanKey, MSMetaData::SubScanProperties>& subScanProps
+) const {
+    uInt mainCounter, ddCounter;
+    if (! _getPersistentCacheStamp(mainCounter, ddCounter)) {
+        return;
+    }
+    // write a temporary file and rename it, so other processes
+    // never read a partially written file
+    String name = _persistentCacheName();
+    String tmpName = File::newUniqueName(
+        _ms->tableName(), "table.mdcache_"
+    ).absoluteName();
+    try {
+        {
+            AipsIO ios(tmpName, ByteIO::New);
+            ios.putstart("MSMetaDataCache", persistentCacheVersion);
+            ios << _ms->nrow() << mainCounter << ddCounter;
+            ios << uInt64(scanProps.size());
+            for (const auto& kv : scanProps) {
+                const ScanKey& key = kv.first;
+                const ScanProperties& props = kv.second;
+                ios << key.obsID << key.arrayID << key.scan;
+                putCacheValue(ios, props.firstExposureTime);
+                putCacheValue(ios, props.meanInterval);
+                putCacheValue(ios, props.spwNRows);
+                putCacheValue(ios, props.timeRange);
+                putCacheValue(ios, props.times);
+            }
+            ios << uInt64(subScanProps.size());
+            for (const auto& kv : subScanProps) {
+                const SubScanKey& key = kv.first;
+                const SubScanProperties& props = kv.second;
+                ios << key.obsID << key.arrayID << key.scan << key.fieldID;
+                ios << props.acRows << props.xcRows;
+                putCacheValue(ios, props.antennas);
+                ios << props.beginTime;
+                putCacheValue(ios, props.ddIDs);
+                ios << props.endTime;
+                putCacheValue(ios, props.meanInterval);
+                putCacheValue(ios, props.firstExposureTime);
+                putCacheValue(ios, props.meanExposureTime);
+                putCacheValue(ios, props.spws);
+                putCacheValue(ios, props.spwNRows);
+                putCacheValue(ios, props.stateIDs);
+                putCacheValue(ios, props.timeProps);
+            }
+            ios.putend();
+        }
+        RegularFile(tmpName).move(name);
+    }
+    catch (const std::exception&) {
+        // the cache is not essential, so only remove a partial file
+        if (File(tmpName).exists()) {
+            RegularFile(tmpName).remove();
+        }
+    }
+}
+
 void MSMetaData::_computeScanAndSubScanProperties(
     std::shared_ptr<std::map<ScanKey, MSMetaData::ScanProperties> >& scanProps,
     std::shared_ptr<std::map<SubScanKey, MSMetaData::SubScanProperties> >& subScanProps,
@@ -4084,9 +4347,12 @@ void MSMetaData::_getScanAndSubScanProperties(
     }
     std::shared_ptr<std::map<SubScanKey, SubScanProperties> > myssprops;
     std::shared_ptr<std::map<ScanKey, ScanProperties> > myscanprops;
-    _computeScanAndSubScanProperties(
-        myscanprops, myssprops, showProgress
-    );
+    if (! _readPersistentCache(myscanprops, myssprops)) {
+        _computeScanAndSubScanProperties(
+            myscanprops, myssprops, showProgress
+        );
+        _writePersistentCache(*myscanprops, *myssprops);
+    }
     scanProps = myscanprops;
     subScanProps = myssprops;
 
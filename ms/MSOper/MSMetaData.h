@@ -515,6 +515,18 @@ public:
     // is often a good idea to cache it if it will be accessed many times.
     void setForceSubScanPropsToCache(Bool b) { _forceSubScanPropsToCache = b; }
 
+    // If True, the scan and subscan properties (from which, among others, the
+    // scan/field/spw/intent relationships and time ranges are derived) are
+    // saved in the file <src>table.mdcache</src> in the MS directory after
+    // they have been computed. Later MSMetaData objects for the same MS
+    // (e.g., in other processes) read them from that file instead of scanning
+    // the main table, as long as the main and DATA_DESCRIPTION tables have
+    // not changed (which is checked using their modify counters).
+    // It can only be used for an MS that is a root table on disk.
+    // The default is given by the aipsrc variable
+    // <src>ms.metadata.persistentcache</src> (default False).
+    void setPersistentCache(Bool b) { _persistentCache = b; }
+
     // get a data structure, consumable by users, representing a summary of the dataset
     Record getSummary() const;
 
@@ -815,6 +827,7 @@ private:
     const vector<const Table*> _taqlTempTable;
 
     mutable Bool _spwInfoStored, _forceSubScanPropsToCache;
+    Bool _persistentCache;
     vector<std::map<Int, Quantity> > _firstExposureTimeMap;
     mutable vector<Int> _numCorrs, _source_sourceIDs, _field_sourceIDs;
 
@@ -864,6 +877,28 @@ private:
 
     static void _checkTolerance(const Double tol);
 
+    // get the name of the file holding the persistent cache
+    String _persistentCacheName() const;
+
+    // get the modify counters of the main and DATA_DESCRIPTION tables
+    // telling if the persistent cache is still valid. False is returned
+    // if the persistent cache cannot be used.
+    Bool _getPersistentCacheStamp(uInt& mainCounter, uInt& ddCounter) const;
+
+    // read the scan and subscan properties from the persistent cache.
+    // False is returned if it does not exist or is not valid anymore.
+    Bool _readPersistentCache(
+        std::shared_ptr<std::map<ScanKey, MSMetaData::ScanProperties> >& scanProps,
+        std::shared_ptr<std::map<SubScanKey, MSMetaData::SubScanProperties> >& subScanProps
+    ) const;
+
+    // write the scan and subscan properties into the persistent cache.
+    // Nothing is done if that fails (e.g., if the MS is not writable).
+    void _writePersistentCache(
+        const std::map<ScanKey, MSMetaData::ScanProperties>& scanProps,
+        const std::map<SubScanKey, MSMetaData::SubScanProperties>& subScanProps
+    ) const;
+
     void _computeScanAndSubScanProperties(
         std::shared_ptr<std::map<ScanKey, MSMetaData::ScanProperties> >& scanProps,
         std::shared_ptr<std::map<SubScanKey, MSMetaData::SubScanProperties> >& subScanProps,
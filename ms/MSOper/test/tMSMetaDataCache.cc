@@ -0,0 +1,225 @@
+//# tMSMetaDataCache.cc: Test the persistent cache of MSMetaData
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/ms/MSOper/MSMetaData.h>
+#include <casacore/ms/MSOper/MSKeys.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/ms/MeasurementSets/MSDataDescColumns.h>
+#include <casacore/ms/MeasurementSets/MSSpWindowColumns.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <sys/stat.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test the persistent cache of the scan and subscan properties of MSMetaData.
+// </summary>
+
+const String msName("tMSMetaDataCache_tmp.ms");
+const String cacheName(msName + "/table.mdcache");
+
+// Create an MS with 2 scans, each having 2 fields (thus subscans)
+// and 2 spectral windows.
+void createMS()
+{
+  SetupNewTable newtab(msName, MS::requiredTableDesc(), Table::New);
+  MeasurementSet ms(newtab);
+  ms.createDefaultSubtables(Table::New);
+  MSColumns mscols(ms);
+  rownr_t row = 0;
+  for (Int scan=1; scan<=2; ++scan) {
+    for (Int field=0; field<2; ++field) {
+      for (Int t=0; t<5; ++t) {
+        for (Int dd=0; dd<2; ++dd) {
+          for (Int a1=0; a1<3; ++a1) {
+            for (Int a2=a1; a2<3; ++a2) {
+              ms.addRow();
+              Double time = 4.5e9 + 100*(2*(scan-1) + field) + 10*t;
+              mscols.time().put (row, time);
+              mscols.timeCentroid().put (row, time);
+              mscols.interval().put (row, 10.);
+              mscols.exposure().put (row, 9.5);
+              mscols.antenna1().put (row, a1);
+              mscols.antenna2().put (row, a2);
+              mscols.scanNumber().put (row, scan);
+              mscols.fieldId().put (row, field);
+              mscols.dataDescId().put (row, dd);
+              mscols.stateId().put (row, -1);
+              ++row;
+            }
+          }
+        }
+      }
+    }
+  }
+  ms.dataDescription().addRow (2);
+  MSDataDescColumns ddcols(ms.dataDescription());
+  ms.spectralWindow().addRow (2);
+  MSSpWindowColumns spwcols(ms.spectralWindow());
+  for (uInt i=0; i<2; ++i) {
+    ddcols.spectralWindowId().put (i, i);
+    ddcols.polarizationId().put (i, 0);
+    Vector<Double> freqs(4);
+    indgen (freqs, 1e9 + i*1e8, 1e6);
+    spwcols.chanFreq().put (i, freqs);
+    spwcols.chanWidth().put (i, Vector<Double>(4, 1e6));
+    spwcols.numChan().put (i, 4);
+  }
+}
+
+// Get the inode of the cache file to know if it has been rewritten.
+ino_t cacheInode()
+{
+  struct stat buf;
+  AlwaysAssertExit (stat (cacheName.chars(), &buf) == 0);
+  return buf.st_ino;
+}
+
+void compare (const MSMetaData::SubScanProperties& p1,
+              const MSMetaData::SubScanProperties& p2)
+{
+  AlwaysAssertExit (p1.acRows == p2.acRows  &&  p1.xcRows == p2.xcRows);
+  AlwaysAssertExit (p1.antennas == p2.antennas);
+  AlwaysAssertExit (p1.beginTime == p2.beginTime);
+  AlwaysAssertExit (p1.endTime == p2.endTime);
+  AlwaysAssertExit (p1.ddIDs == p2.ddIDs);
+  AlwaysAssertExit (p1.spws == p2.spws);
+  AlwaysAssertExit (p1.spwNRows == p2.spwNRows);
+  AlwaysAssertExit (p1.stateIDs == p2.stateIDs);
+  AlwaysAssertExit (p1.meanExposureTime == p2.meanExposureTime);
+  AlwaysAssertExit (p1.meanInterval.size() == p2.meanInterval.size());
+  for (const auto& kv : p1.meanInterval) {
+    AlwaysAssertExit (kv.second == p2.meanInterval.at(kv.first));
+  }
+  AlwaysAssertExit (p1.firstExposureTime.size() ==
+                    p2.firstExposureTime.size());
+  for (const auto& kv : p1.firstExposureTime) {
+    const auto& fe = p2.firstExposureTime.at(kv.first);
+    AlwaysAssertExit (kv.second.first == fe.first);
+    AlwaysAssertExit (kv.second.second == fe.second);
+  }
+  AlwaysAssertExit (p1.timeProps.size() == p2.timeProps.size());
+  for (const auto& kv : p1.timeProps) {
+    const auto& tp = p2.timeProps.at(kv.first);
+    AlwaysAssertExit (kv.second.ddIDs == tp.ddIDs);
+    AlwaysAssertExit (kv.second.nrows == tp.nrows);
+  }
+}
+
+void testCache()
+{
+  std::shared_ptr<const std::map<SubScanKey, MSMetaData::SubScanProperties> >
+    props1;
+  std::pair<Double, Double> range1;
+  std::map<uInt, std::set<Double> > times1;
+  ScanKey scan2;
+  scan2.obsID = 0;
+  scan2.arrayID = 0;
+  scan2.scan = 2;
+  {
+    // The cache is written when the properties are computed.
+    MeasurementSet ms(msName);
+    MSMetaData md(&ms, 100.);
+    md.setPersistentCache (True);
+    AlwaysAssertExit (! File(cacheName).exists());
+    props1 = md.getSubScanProperties();
+    range1 = md.getTimeRange();
+    times1 = md.getSpwToTimesForScan (scan2);
+    AlwaysAssertExit (File(cacheName).exists());
+    AlwaysAssertExit (props1->size() == 4);
+  }
+  ino_t inode = cacheInode();
+  {
+    // The cache is read (thus not rewritten) and gives the same results.
+    MeasurementSet ms(msName);
+    MSMetaData md(&ms, 100.);
+    md.setPersistentCache (True);
+    std::shared_ptr<const std::map<SubScanKey, MSMetaData::SubScanProperties> >
+      props2 = md.getSubScanProperties();
+    AlwaysAssertExit (cacheInode() == inode);
+    AlwaysAssertExit (props2->size() == props1->size());
+    for (const auto& kv : *props1) {
+      compare (kv.second, props2->at(kv.first));
+    }
+    AlwaysAssertExit (md.getTimeRange() == range1);
+    AlwaysAssertExit (md.getSpwToTimesForScan (scan2) == times1);
+    AlwaysAssertExit (md.getTimeRangeForScan (scan2).second == range1.second);
+  }
+  {
+    // Without the persistent cache the file is not used.
+    MeasurementSet ms(msName);
+    MSMetaData md(&ms, 100.);
+    md.setPersistentCache (False);
+    AlwaysAssertExit (md.getTimeRange() == range1);
+  }
+  {
+    // Change the last scan number, which invalidates the cache.
+    MeasurementSet ms(msName, Table::Update);
+    MSColumns mscols(ms);
+    rownr_t nrow = ms.nrow();
+    for (rownr_t row=nrow-30; row<nrow; ++row) {
+      mscols.scanNumber().put (row, 3);
+    }
+  }
+  {
+    MeasurementSet ms(msName);
+    MSMetaData md(&ms, 100.);
+    md.setPersistentCache (True);
+    std::shared_ptr<const std::map<SubScanKey, MSMetaData::SubScanProperties> >
+      props3 = md.getSubScanProperties();
+    AlwaysAssertExit (props3->size() == 5);
+    AlwaysAssertExit (cacheInode() != inode);
+    inode = cacheInode();
+  }
+  {
+    // A selection does not use the cache.
+    MeasurementSet ms(msName);
+    MeasurementSet sel(ms(ms.col("SCAN_NUMBER") == 1));
+    MSMetaData md(&sel, 100.);
+    md.setPersistentCache (True);
+    AlwaysAssertExit (md.getSubScanProperties()->size() == 2);
+    AlwaysAssertExit (cacheInode() == inode);
+  }
+}
+
+int main()
+{
+  try {
+    createMS();
+    testCache();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
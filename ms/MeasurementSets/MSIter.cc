@@ -174,12 +174,27 @@ void MSIter::construct(
         }
     }
 
+    // Sorting can only be avoided if the comparisons are on plain values.
+    Bool plainCompare = True;
+    for (const auto& cmp : sortCompareFunctions) {
+        if (cmp && cmp->dataType() == TpOther) {
+            plainCompare = False;
+        }
+    }
+
     // Create the table iterators
     for (size_t i=0; i<nMS_p; i++) {
         // create the iterator for each MS
-        tabIter_p[i] = new TableIterator(bms_p[i],sortColumnNames,
-                                         sortCompareFunctions,sortOrders,
-                                         TableIterator::ParSort, true);
+        // No need to sort if the MS is already in iteration order.
+        if (plainCompare && isInIterationOrder(bms_p[i], sortColumnNames)) {
+            tabIter_p[i] = new TableIterator(bms_p[i],sortColumnNames,
+                                             sortCompareFunctions,sortOrders,
+                                             TableIterator::NoSort);
+        } else {
+            tabIter_p[i] = new TableIterator(bms_p[i],sortColumnNames,
+                                             sortCompareFunctions,sortOrders,
+                                             TableIterator::ParSort, true);
+        }
         tabIterAtStart_p[i]=True;
     }
     setMSInfo();
@@ -248,6 +263,88 @@ Bool MSIter::isSubSet (const Vector<rownr_t>& r1, const Vector<rownr_t>& r2) {
   return ok;
 }
 
+Bool MSIter::isInIterationOrder(const Table& tab, const Block<String>& columns)
+{
+  size_t nkey = columns.nelements();
+  rownr_t nrow = tab.nrow();
+  const TableDesc& td = tab.tableDesc();
+  for (size_t i=0; i<nkey; i++) {
+    if (!td.isColumn(columns[i]) ||
+        !td.columnDesc(columns[i]).isScalar() ||
+        (td.columnDesc(columns[i]).dataType() != TpInt &&
+         td.columnDesc(columns[i]).dataType() != TpDouble)) {
+      return False;
+    }
+  }
+  if (nrow < 2) {
+    return True;
+  }
+  // A writer can tell the table is sorted. It cannot be used for a
+  // concatenated table, nor for a selection not in ascending row order.
+  const TableRecord& keys = tab.keywordSet();
+  if (keys.isDefined("SORTED_BY") &&
+      keys.dataType("SORTED_BY") == TpArrayString &&
+      tab.getPartNames().nelements() == 1) {
+    Vector<String> sortedBy = keys.asArrayString("SORTED_BY");
+    Bool match = sortedBy.nelements() >= nkey;
+    for (size_t i=0; match && i<nkey; i++) {
+      match = (sortedBy[i] == columns[i]);
+    }
+    if (match) {
+      if (tab.isRootTable()) {
+        return True;
+      }
+      Vector<rownr_t> rows = tab.rowNumbers();
+      Bool ascending = True;
+      for (rownr_t i=1; ascending && i<rows.nelements(); i++) {
+        ascending = rows[i] > rows[i-1];
+      }
+      if (ascending) {
+        return True;
+      }
+    }
+  }
+  // Check the order of the key values by reading them in chunks.
+  // Each chunk starts with the last row of the previous chunk.
+  const rownr_t chunkSize = 65536;
+  Block<Vector<Int> > intVals(nkey);
+  Block<Vector<Double> > dblVals(nkey);
+  Block<Bool> isInt(nkey);
+  for (size_t i=0; i<nkey; i++) {
+    isInt[i] = (td.columnDesc(columns[i]).dataType() == TpInt);
+  }
+  for (rownr_t st=0; st<nrow-1; st+=chunkSize) {
+    rownr_t nr = std::min(chunkSize+1, nrow-st);
+    Slicer rowRange(IPosition(1,st), IPosition(1,nr));
+    for (size_t i=0; i<nkey; i++) {
+      if (isInt[i]) {
+        ScalarColumn<Int>(tab, columns[i]).getColumnRange(rowRange,
+                                                          intVals[i], True);
+      } else {
+        ScalarColumn<Double>(tab, columns[i]).getColumnRange(rowRange,
+                                                             dblVals[i], True);
+      }
+    }
+    for (rownr_t j=1; j<nr; j++) {
+      for (size_t i=0; i<nkey; i++) {
+        int cmp;
+        if (isInt[i]) {
+          cmp = ObjCompare<Int>::compare(&intVals[i][j-1], &intVals[i][j]);
+        } else {
+          cmp = ObjCompare<Double>::compare(&dblVals[i][j-1], &dblVals[i][j]);
+        }
+        if (cmp > 0) {
+          return False;
+        }
+        if (cmp < 0) {
+          break;
+        }
+      }
+    }
+  }
+  return True;
+}
+
 void MSIter::construct(const Block<Int>& sortColumns,
 		       Bool addDefaultSortColumns)
 {
@@ -348,11 +445,27 @@ void MSIter::construct(const Block<Int>& sortColumns,
   }
   Block<Int> orders(columns.nelements(),TableIterator::Ascending);
 
+  // The order of the values of the sort columns is the iteration order,
+  // unless TIME (compared per interval) is followed by other columns.
+  Bool canUseOrder = True;
+  for (size_t i=0; i+1<columns.nelements(); i++) {
+    if (columns[i]==MS::columnName(MS::TIME)) {
+      canUseOrder = False;
+    }
+  }
+
   // Store the sorted table for future access if possible,
   // reuse it if already there
   for (size_t i=0; i<nMS_p; i++) {
     Bool useIn=False, store=False, useSorted=False;
     Table sorted;
+    // No need to sort (nor store) if the MS is already in iteration order.
+    if (canUseOrder && isInIterationOrder(bms_p[i], columns)) {
+      tabIter_p[i] = new TableIterator(bms_p[i],columns,objComp,orders,
+                                       TableIterator::NoSort);
+      tabIterAtStart_p[i]=True;
+      continue;
+    }
     // check if we already have a sorted table consistent with the requested
     // sort order
     if (!bms_p[i].keywordSet().isDefined("SORT_COLUMNS") ||
@@ -90,6 +90,15 @@ private:
 // examples below.  MSIter implements iteration by time interval for the use of
 // e.g., calibration tasks that want to calculate solutions over some interval
 // of time.  You can iterate over multiple MeasurementSets with this class.
+// <p>
+// If an MS is already in iteration order (e.g., as written by a correlator
+// in ARRAY_ID, FIELD_ID, DATA_DESC_ID, TIME order), MSIter does not sort it,
+// but iterates directly over the contiguous row ranges. A writer can tell
+// that an MS is sorted by defining the table keyword <src>SORTED_BY</src>
+// containing the names of the columns it is sorted on (a Vector of
+// Strings). If that keyword does not exist, MSIter checks the order with
+// a single pass over the sort columns, which stops at the first row out
+// of order.
 // </synopsis>
 //
 // <example>
@@ -425,6 +434,16 @@ protected:
 // Determine if the numbers in r1 are a sorted subset of those in r2
   Bool isSubSet(const Vector<rownr_t>& r1, const Vector<rownr_t>& r2);
 
+  // Determine if the table is already in iteration order, i.e. sorted in
+  // ascending order of the values of the given columns, so sorting can be
+  // avoided. It is true if the table has a keyword SORTED_BY starting with
+  // the given columns (and the rows of a selection are in ascending order).
+  // Otherwise a single pass over the key columns is made, which stops at
+  // the first row that is out of order.
+  // Only columns with data type Int or Double are supported.
+  static Bool isInIterationOrder(const Table& tab,
+                                 const Block<String>& columns);
+
   MSIter* This;
   Block<MeasurementSet> bms_p;
   PtrBlock<TableIterator* > tabIter_p;
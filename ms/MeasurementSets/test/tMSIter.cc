@@ -952,6 +952,71 @@ void iterMSCachedFieldInfo ()
   }
 }
 
+// Check if the rows of each iteration are contiguous in the MS and
+// return the number of iterations.
+size_t checkContiguous (MSIter& msIter)
+{
+  size_t niter = 0;
+  rownr_t nextRow = 0;
+  for (msIter.origin(); msIter.more(); msIter++) {
+    Vector<rownr_t> rows = msIter.table().rowNumbers();
+    for (rownr_t i=0; i<rows.size(); ++i) {
+      AlwaysAssertExit (rows[i] == nextRow + i);
+    }
+    nextRow += rows.size();
+    niter++;
+  }
+  AlwaysAssertExit (nextRow == msIter.ms().nrow());
+  return niter;
+}
+
+// This test checks that an MS already in iteration order is not sorted.
+void iterMSInOrder ()
+{
+  // The MS is in FIELD_ID, TIME order.
+  createMSSeveralDDFeedField(3, 4, 2, 3, 60., "tMSIter_sorted_tmp.ms");
+  {
+    MeasurementSet ms("tMSIter_sorted_tmp.ms", Table::Update);
+    Block<int> sort(2);
+    sort[0] = MS::FIELD_ID;
+    sort[1] = MS::TIME;
+    MSIter msIter(ms, sort, 1., False);
+    AlwaysAssertExit (checkContiguous(msIter) == 3*4);
+    // The sorted table is not stored.
+    AlwaysAssertExit (! ms.keywordSet().isDefined("SORTED_TABLE"));
+    // The same for the generic sort constructor.
+    std::vector<std::pair<String, std::shared_ptr<BaseCompare>>> sortCols;
+    sortCols.push_back(std::make_pair("FIELD_ID", nullptr));
+    sortCols.push_back(std::make_pair("TIME", nullptr));
+    sortCols.push_back(std::make_pair("DATA_DESC_ID", nullptr));
+    MSIter msIter1(ms, sortCols);
+    AlwaysAssertExit (checkContiguous(msIter1) == 3*4*2);
+    // TIME binned in intervals followed by another column cannot use the
+    // order of the values, so the MS is sorted and the sorted table stored.
+    sort.resize(3, True, True);
+    sort[2] = MS::ANTENNA1;
+    MSIter msIter2(ms, sort, 120., False);
+    rownr_t nrow = 0;
+    for (msIter2.origin(); msIter2.more(); msIter2++) {
+      Vector<Int> ant1 = ScalarColumn<Int>(msIter2.table(),
+                                           "ANTENNA1").getColumn();
+      AlwaysAssertExit (allEQ (ant1, ant1[0]));
+      nrow += ant1.size();
+    }
+    AlwaysAssertExit (nrow == ms.nrow());
+    AlwaysAssertExit (ms.keywordSet().isDefined("SORTED_TABLE"));
+  }
+  {
+    // A writer can tell the MS is sorted.
+    MeasurementSet ms("tMSIter_sorted_tmp.ms", Table::Update);
+    ms.rwKeywordSet().define ("SORTED_BY",
+                              Vector<String>(1, "FIELD_ID"));
+    Block<int> sort(1, MS::FIELD_ID);
+    MSIter msIter(ms, sort, 0., False);
+    AlwaysAssertExit (checkContiguous(msIter) == 3);
+  }
+}
+
 int main (int argc, char* argv[])
 {
   try {
@@ -991,6 +1056,7 @@ int main (int argc, char* argv[])
     iterMSCachedDDFeedInfo();
     cout << "########" << endl;
     iterMSCachedFieldInfo();
+    iterMSInOrder();
   } catch (std::exception& x) {
     cerr << "Unexpected exception: " << x.what() << endl;
     return 1;
@@ -0,0 +1,297 @@
+//# ingestms.cc : measure the throughput of writing a MeasurementSet
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/ms/MeasurementSets/MSMainColumns.h>
+#include <casacore/tables/Tables/TableAppender.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Inputs/Input.h>
+#include <casacore/casa/OS/Timer.h>
+#include <iostream>
+#include <iomanip>
+
+using namespace casacore;
+using namespace std;
+
+
+// Define the global variables shared between the main functions.
+String myMsName;
+String myMode;
+int    myNAnt;
+int    myNTime;
+int    myNChan;
+int    myNCorr;
+bool   myFixedShape;
+
+
+void showHelp()
+{
+  cout << "The program measures the throughput of writing a MeasurementSet"
+       << endl;
+  cout << "row by row (a put per cell) and in blocks of rows (a put per column)."
+       << endl;
+  cout << "Run as:" << endl;
+  cout << "      ingestms parm=value parm=value ..." << endl;
+  cout << "Use   ingestms -h   to see the possible parameters." << endl;
+}
+
+bool readParms (int argc, char* argv[])
+{
+  // enable input in no-prompt mode
+  Input params(1);
+  // define the input structure
+  params.version("2026Oct18");
+  params.create ("msname", "",
+                 "Name of the MeasurementSet to create (suffix _cell or _block is added)",
+                 "string");
+  params.create ("mode", "both",
+                 "Write mode: cell (a put per row and cell), block (a put per column per time slot) or both",
+                 "string");
+  params.create ("nant", "32",
+                 "Number of antennas (auto-correlations are included)",
+                 "int");
+  params.create ("ntime", "20",
+                 "Number of time slots",
+                 "int");
+  params.create ("nchan", "64",
+                 "Number of channels",
+                 "int");
+  params.create ("ncorr", "4",
+                 "Number of correlations",
+                 "int");
+  params.create ("fixedshape", "false",
+                 "Define fixed shapes for the array columns?",
+                 "bool");
+  // Fill the input structure from the command line.
+  params.readArguments (argc, argv);
+  // Get the various parameters.
+  myMsName = params.getString ("msname");
+  if (myMsName.empty()) {
+    showHelp();
+    return false;
+  }
+  myMode       = params.getString ("mode");
+  myNAnt       = params.getInt    ("nant");
+  myNTime      = params.getInt    ("ntime");
+  myNChan      = params.getInt    ("nchan");
+  myNCorr      = params.getInt    ("ncorr");
+  myFixedShape = params.getBool   ("fixedshape");
+  if (myMode != "cell"  &&  myMode != "block"  &&  myMode != "both") {
+    throw AipsError ("mode must be cell, block or both");
+  }
+  return true;
+}
+
+// Create the MeasurementSet with the DATA column.
+// The data and flags are stored in a TiledShapeStMan, the other columns in
+// a StandardStMan.
+MeasurementSet createMS (const String& msName)
+{
+  TableDesc td = MS::requiredTableDesc();
+  MS::addColumnToDesc (td, MS::DATA, 2);
+  if (myFixedShape) {
+    IPosition dataShape(2, myNCorr, myNChan);
+    td.rwColumnDesc(MS::columnName(MS::DATA)).setShape (dataShape);
+    td.rwColumnDesc(MS::columnName(MS::FLAG)).setShape (dataShape);
+    td.rwColumnDesc(MS::columnName(MS::WEIGHT)).setShape (IPosition(1, myNCorr));
+    td.rwColumnDesc(MS::columnName(MS::SIGMA)).setShape (IPosition(1, myNCorr));
+  }
+  SetupNewTable newTab(msName, td, Table::New);
+  StandardStMan stanStMan;
+  newTab.bindAll (stanStMan);
+  IPosition tileShape(3, myNCorr, std::min(myNChan, 64), 64);
+  TiledShapeStMan tiledData("TiledData", tileShape);
+  newTab.bindColumn (MS::columnName(MS::DATA), tiledData);
+  TiledShapeStMan tiledFlag("TiledFlag", tileShape);
+  newTab.bindColumn (MS::columnName(MS::FLAG), tiledFlag);
+  MeasurementSet ms(newTab);
+  ms.createDefaultSubtables (Table::New);
+  return ms;
+}
+
+// The values written for a time slot.
+struct SlotData
+{
+  Vector<Int>    ant1;
+  Vector<Int>    ant2;
+  Matrix<Double> uvw;
+  Cube<Complex>  data;
+  Cube<Bool>     flag;
+  Matrix<Float>  weight;
+  Matrix<Float>  sigma;
+};
+
+SlotData makeSlotData()
+{
+  SlotData sd;
+  uInt nbl = myNAnt * (myNAnt+1) / 2;
+  sd.ant1.resize (nbl);
+  sd.ant2.resize (nbl);
+  uInt bl = 0;
+  for (int a1=0; a1<myNAnt; ++a1) {
+    for (int a2=a1; a2<myNAnt; ++a2) {
+      sd.ant1[bl] = a1;
+      sd.ant2[bl] = a2;
+      ++bl;
+    }
+  }
+  sd.uvw.resize (3, nbl);
+  indgen (sd.uvw);
+  sd.data.resize (myNCorr, myNChan, nbl);
+  indgen (sd.data);
+  sd.flag.resize (myNCorr, myNChan, nbl);
+  sd.flag = False;
+  sd.weight.resize (myNCorr, nbl);
+  sd.weight = 1;
+  sd.sigma.resize (myNCorr, nbl);
+  sd.sigma = 1;
+  return sd;
+}
+
+// Write the MS a row at a time using a put per cell.
+void writeCells (MeasurementSet& ms, const SlotData& sd)
+{
+  MSMainColumns cols(ms);
+  uInt nbl = sd.ant1.size();
+  rownr_t row = 0;
+  for (int t=0; t<myNTime; ++t) {
+    Double time = 4.5e9 + t;
+    for (uInt bl=0; bl<nbl; ++bl) {
+      ms.addRow();
+      cols.time().put (row, time);
+      cols.timeCentroid().put (row, time);
+      cols.interval().put (row, 1.);
+      cols.exposure().put (row, 1.);
+      cols.antenna1().put (row, sd.ant1[bl]);
+      cols.antenna2().put (row, sd.ant2[bl]);
+      cols.feed1().put (row, 0);
+      cols.feed2().put (row, 0);
+      cols.dataDescId().put (row, 0);
+      cols.fieldId().put (row, 0);
+      cols.scanNumber().put (row, 1);
+      cols.arrayId().put (row, 0);
+      cols.observationId().put (row, 0);
+      cols.processorId().put (row, 0);
+      cols.stateId().put (row, -1);
+      cols.flagRow().put (row, False);
+      cols.uvw().put (row, sd.uvw.column(bl));
+      cols.data().put (row, sd.data.xyPlane(bl));
+      cols.flag().put (row, sd.flag.xyPlane(bl));
+      cols.weight().put (row, sd.weight.column(bl));
+      cols.sigma().put (row, sd.sigma.column(bl));
+      ++row;
+    }
+  }
+}
+
+// Write the MS a time slot at a time using a put per column.
+void writeBlocks (MeasurementSet& ms, const SlotData& sd)
+{
+  TableAppender appender(ms);
+  uInt nbl = sd.ant1.size();
+  for (int t=0; t<myNTime; ++t) {
+    Double time = 4.5e9 + t;
+    appender.addRows (nbl);
+    appender.fillScalar (MS::columnName(MS::TIME), time);
+    appender.fillScalar (MS::columnName(MS::TIME_CENTROID), time);
+    appender.fillScalar (MS::columnName(MS::INTERVAL), 1.);
+    appender.fillScalar (MS::columnName(MS::EXPOSURE), 1.);
+    appender.putScalar  (MS::columnName(MS::ANTENNA1), sd.ant1);
+    appender.putScalar  (MS::columnName(MS::ANTENNA2), sd.ant2);
+    appender.fillScalar (MS::columnName(MS::FEED1), 0);
+    appender.fillScalar (MS::columnName(MS::FEED2), 0);
+    appender.fillScalar (MS::columnName(MS::DATA_DESC_ID), 0);
+    appender.fillScalar (MS::columnName(MS::FIELD_ID), 0);
+    appender.fillScalar (MS::columnName(MS::SCAN_NUMBER), 1);
+    appender.fillScalar (MS::columnName(MS::ARRAY_ID), 0);
+    appender.fillScalar (MS::columnName(MS::OBSERVATION_ID), 0);
+    appender.fillScalar (MS::columnName(MS::PROCESSOR_ID), 0);
+    appender.fillScalar (MS::columnName(MS::STATE_ID), -1);
+    appender.fillScalar (MS::columnName(MS::FLAG_ROW), False);
+    appender.putArray   (MS::columnName(MS::UVW), sd.uvw);
+    appender.putArray   (MS::columnName(MS::DATA), sd.data);
+    appender.putArray   (MS::columnName(MS::FLAG), sd.flag);
+    appender.putArray   (MS::columnName(MS::WEIGHT), sd.weight);
+    appender.putArray   (MS::columnName(MS::SIGMA), sd.sigma);
+  }
+}
+
+// Create an MS, write it in the given mode and show the throughput.
+void doMode (const String& mode, const SlotData& sd)
+{
+  String msName = myMsName + '_' + mode;
+  Timer timer;
+  {
+    MeasurementSet ms = createMS (msName);
+    if (mode == "cell") {
+      writeCells (ms, sd);
+    } else {
+      writeBlocks (ms, sd);
+    }
+    ms.flush();
+  }
+  double sec = timer.real();
+  double nrow = double(myNTime) * sd.ant1.size();
+  double nbytes = nrow * myNCorr * myNChan * (sizeof(Complex) + sizeof(Bool));
+  cout << setw(6) << mode << ": " << setprecision(3)
+       << sec << " sec  " << nrow/sec << " rows/s  "
+       << nbytes/sec/(1024*1024) << " MB/s (DATA+FLAG)" << endl;
+}
+
+void doAll()
+{
+  SlotData sd = makeSlotData();
+  cout << "Writing " << myNTime << " time slots of " << sd.ant1.size()
+       << " baselines with " << myNCorr << " correlations and "
+       << myNChan << " channels" << endl;
+  if (myMode != "block") {
+    doMode ("cell", sd);
+  }
+  if (myMode != "cell") {
+    doMode ("block", sd);
+  }
+}
+
+int main (int argc, char* argv[])
+{
+  try {
+    if (readParms (argc, argv)) {
+      doAll();
+    }
+  } catch (const std::exception& x) {
+    std::cerr << x.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -325,6 +325,21 @@ public:
   //# void fft0(Array<T> & rValues, const Bool toFrequency=True);
 
   // </group>
+
+  // Complex to complex in-place fft of all lines along the given axis,
+  // thus a 1-dimensional transform of each line. The direction and scaling
+  // are the same as for the <src>fft</src> and <src>fft0</src> functions
+  // above. For <src>fftAxis</src> the origin of each line is its centre,
+  // for <src>fft0Axis</src> its first element.
+  // <br>All lines are transformed by a single (batched) FFTW plan, which
+  // is much faster than transforming the lines one by one, especially
+  // for lines along an axis other than the first one.
+  // <group>
+  void fftAxis(Array<S> & cValues, const uInt whichAxis,
+               const Bool toFrequency=True);
+  void fft0Axis(Array<S> & cValues, const uInt whichAxis,
+                const Bool toFrequency=True);
+  // </group>
   //# Flips the quadrants in a complex Array so that the point at
   //# cData.shape()/2 moves to the origin. This moves, for example, the point
   //# at [8,3] to the origin ([0,0]) in an array of shape [16,7]. Usually two
@@ -342,6 +357,10 @@ public:
   void flip(Array<S> & cData, const Bool toZero, const Bool isHermitian);
   // </group>
 
+  // Flip the data only along the given axis in the same way as
+  // <src>flip</src> does for all axes.
+  void flipAxis(Array<S> & cData, const uInt whichAxis, const Bool toZero);
+
   // N-D in-place complex->complex FFT shift (FFT - phase-mult - inverse FFT)
   // If toFrequency is true, the first FFT will be from time to frequency. 
   // relshift is the freq shift normalised to the bandwidth.
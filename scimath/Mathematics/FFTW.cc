@@ -33,7 +33,13 @@
 # include <omp.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
 
 
 namespace casacore {
@@ -44,6 +50,62 @@ std::mutex FFTW::theirMutex;
 
 #ifdef HAVE_FFTW3
 
+  namespace {
+    // The process-wide plan cache.
+    // The mutex serializes all FFTW planner calls (including the
+    // destruction of plans and the wisdom functions).
+    // It is defined before the maps, so it is destructed after them.
+    struct PlanKey
+    {
+      int kind;                // 0=r2c 1=c2r 2=c2c 3=c2c along axis
+      std::vector<int> shape;
+      int axis;
+      int sign;
+      bool inPlace;
+      int alignIn;
+      int alignOut;
+      unsigned flags;
+      bool operator< (const PlanKey& other) const
+      {
+        return std::tie (kind, shape, axis, sign, inPlace,
+                         alignIn, alignOut, flags) <
+          std::tie (other.kind, other.shape, other.axis, other.sign,
+                    other.inPlace, other.alignIn, other.alignOut,
+                    other.flags);
+      }
+    };
+
+    std::mutex& plannerMutex()
+    {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    std::atomic<int> theirPlanRigor (FFTW::ESTIMATE);
+
+    unsigned planFlags()
+    {
+      switch (theirPlanRigor.load()) {
+      case FFTW::MEASURE:
+        return FFTW_MEASURE;
+      case FFTW::PATIENT:
+        return FFTW_PATIENT;
+      case FFTW::EXHAUSTIVE:
+        return FFTW_EXHAUSTIVE;
+      default:
+        return FFTW_ESTIMATE;
+      }
+    }
+
+    PlanKey makeKey (int kind, const IPosition& shape, int axis, int sign,
+                     const void* in, const void* out, int alignIn,
+                     int alignOut)
+    {
+      return PlanKey{kind, shape.asStdVector(), axis, sign, in == out,
+                     alignIn, alignOut, planFlags()};
+    }
+  }
+
   class FFTWPlan
   {
   public:
@@ -51,7 +113,8 @@ std::mutex FFTW::theirMutex;
       : itsPlan(plan)
     {}
     ~FFTWPlan()
-      { fftw_destroy_plan(itsPlan); }
+      { std::lock_guard<std::mutex> lock(plannerMutex());
+        fftw_destroy_plan(itsPlan); }
     fftw_plan getPlan()
       { return itsPlan; }
   private:
@@ -67,7 +130,8 @@ std::mutex FFTW::theirMutex;
       : itsPlan(plan)
     {}
     ~FFTWPlanf()
-      { fftwf_destroy_plan(itsPlan); }
+      { std::lock_guard<std::mutex> lock(plannerMutex());
+        fftwf_destroy_plan(itsPlan); }
     fftwf_plan getPlan()
       { return itsPlan; }
   private:
@@ -76,9 +140,105 @@ std::mutex FFTW::theirMutex;
     fftwf_plan itsPlan;
   };
 
+  namespace {
+    // A cached plan with the time it was used last.
+    template<typename PlanType>
+    struct CachedPlan
+    {
+      std::shared_ptr<PlanType> plan;
+      uInt64 lastUsed;
+    };
+
+    struct PlanCache
+    {
+      std::map<PlanKey, CachedPlan<FFTWPlan>>  plans;
+      std::map<PlanKey, CachedPlan<FFTWPlanf>> plansf;
+      uInt64 useCounter = 0;
+    };
+
+    PlanCache& planCache()
+    {
+      plannerMutex();        // make sure the mutex outlives the cache
+      static PlanCache cache;
+      return cache;
+    }
+
+    std::atomic<size_t> theirMaxCachedPlans (64);
+
+    // Get a plan from the cache. If not found, it is made and added.
+    // If the cache gets too large, the least recently used plan is removed.
+    template<typename PlanType, typename Maker>
+    std::shared_ptr<PlanType> findPlan
+    (std::map<PlanKey, CachedPlan<PlanType>>& cache,
+     const PlanKey& key, Maker maker)
+    {
+      // Removed plans are destroyed after the lock is released, because
+      // destroying a plan locks the planner mutex.
+      std::vector<std::shared_ptr<PlanType>> removed;
+      std::lock_guard<std::mutex> lock(plannerMutex());
+      uInt64 now = ++planCache().useCounter;
+      auto iter = cache.find (key);
+      if (iter != cache.end()) {
+        iter->second.lastUsed = now;
+        return iter->second.plan;
+      }
+      auto fftwPlan = maker();
+      if (! fftwPlan) {
+        throw std::runtime_error("FFTW could not make a plan");
+      }
+      std::shared_ptr<PlanType> plan(new PlanType(fftwPlan));
+      const size_t maxPlans = std::max (size_t(1), theirMaxCachedPlans.load());
+      while (cache.size() >= maxPlans) {
+        auto oldest = cache.begin();
+        for (auto it = cache.begin(); it != cache.end(); ++it) {
+          if (it->second.lastUsed < oldest->second.lastUsed) {
+            oldest = it;
+          }
+        }
+        removed.push_back (oldest->second.plan);
+        cache.erase (oldest);
+      }
+      cache.insert (std::make_pair (key, CachedPlan<PlanType>{plan, now}));
+      return plan;
+    }
+
+    // Get a buffer of the given size with the same alignment as the given
+    // pointer (the address modulo 64, which covers any SIMD alignment used
+    // by FFTW). It is used to make a plan without overwriting the data if
+    // the planner has to measure.
+    template<typename T>
+    T* alignedLike (std::vector<char>& buffer, size_t nelem, const T* ptr)
+    {
+      buffer.resize (nelem * sizeof(T) + 64);
+      char* p = buffer.data();
+      size_t align = reinterpret_cast<size_t>(ptr) % 64;
+      p += (align + 64 - reinterpret_cast<size_t>(p) % 64) % 64;
+      return reinterpret_cast<T*>(p);
+    }
+
+    // Fill the FFTW dimensions of the lines along an axis.
+    template<typename IODim>
+    void makeAxisDims (const IPosition& shape, uInt axis,
+                       IODim& dim, IODim* howmany)
+    {
+      int before = 1;
+      for (uInt i=0; i<axis; ++i) {
+        before *= shape[i];
+      }
+      int n = shape[axis];
+      int after = shape.product() / (Int64(before) * n);
+      dim.n  = n;
+      dim.is = dim.os = before;
+      howmany[0].n  = before;
+      howmany[0].is = howmany[0].os = 1;
+      howmany[1].n  = after;
+      howmany[1].is = howmany[1].os = before * n;
+    }
+  }
+
     
 
-  FFTW::FFTW() : flags(FFTW_ESTIMATE)
+  FFTW::FFTW()
   { 
     initialize_fftw();
   }
@@ -94,6 +254,7 @@ std::mutex FFTW::theirMutex;
       }
       
 #ifdef HAVE_FFTW3_THREADS
+      std::lock_guard<std::mutex> planLock(plannerMutex());
       fftwf_init_threads();
       fftw_init_threads();
       fftwf_plan_with_nthreads(nthreads);
@@ -119,126 +280,189 @@ std::mutex FFTW::theirMutex;
 
   void FFTW::plan_r2c(const IPosition &size, float *in, std::complex<float> *out) 
   {
-    itsPlanR2Cf.reset( new FFTWPlanf
-      (fftwf_plan_dft_r2c(size.nelements(),
-                          size.asStdVector().data(),
-                          in,
-                          reinterpret_cast<fftwf_complex *>(out), 
-                          flags)) );
+    fftwf_complex* cout = reinterpret_cast<fftwf_complex *>(out);
+    PlanKey key = makeKey (0, size, -1, 0, in, out, fftwf_alignment_of(in),
+                           fftwf_alignment_of((float*)out));
+    itsPlanR2Cf = findPlan (planCache().plansf, key, [&]() {
+        return fftwf_plan_dft_r2c(size.nelements(),
+                                  size.asStdVector().data(),
+                                  in, cout, key.flags); });
   }
 
   void FFTW::plan_r2c(const IPosition &size, double *in, std::complex<double> *out) 
   {
-    itsPlanR2C.reset( new FFTWPlan
-      (fftw_plan_dft_r2c(size.nelements(),
-                         size.asStdVector().data(),
-                         in,
-                         reinterpret_cast<fftw_complex *>(out), 
-                         flags)) );
+    fftw_complex* cout = reinterpret_cast<fftw_complex *>(out);
+    PlanKey key = makeKey (0, size, -1, 0, in, out, fftw_alignment_of(in),
+                           fftw_alignment_of((double*)out));
+    itsPlanR2C = findPlan (planCache().plans, key, [&]() {
+        return fftw_plan_dft_r2c(size.nelements(),
+                                 size.asStdVector().data(),
+                                 in, cout, key.flags); });
   }
 
   void FFTW::plan_c2r(const IPosition &size, std::complex<float> *in, float *out) {
-    itsPlanC2Rf.reset( new FFTWPlanf
-      (fftwf_plan_dft_c2r(size.nelements(),
-                          size.asStdVector().data(),
-                          reinterpret_cast<fftwf_complex *>(in),
-                          out, 
-                          flags)) );
-
+    fftwf_complex* cin = reinterpret_cast<fftwf_complex *>(in);
+    PlanKey key = makeKey (1, size, -1, 0, in, out,
+                           fftwf_alignment_of((float*)in),
+                           fftwf_alignment_of(out));
+    itsPlanC2Rf = findPlan (planCache().plansf, key, [&]() {
+        return fftwf_plan_dft_c2r(size.nelements(),
+                                  size.asStdVector().data(),
+                                  cin, out, key.flags); });
   }
 
   void FFTW::plan_c2r(const IPosition &size, std::complex<double> *in, double *out) {
-    itsPlanC2R.reset( new FFTWPlan
-      (fftw_plan_dft_c2r(size.nelements(),
-                         size.asStdVector().data(),
-                         reinterpret_cast<fftw_complex *>(in), 
-                         out,
-                         flags)) );
+    fftw_complex* cin = reinterpret_cast<fftw_complex *>(in);
+    PlanKey key = makeKey (1, size, -1, 0, in, out,
+                           fftw_alignment_of((double*)in),
+                           fftw_alignment_of(out));
+    itsPlanC2R = findPlan (planCache().plans, key, [&]() {
+        return fftw_plan_dft_c2r(size.nelements(),
+                                 size.asStdVector().data(),
+                                 cin, out, key.flags); });
   }
 
   void FFTW::plan_c2c_forward(const IPosition &size, std::complex<double> *in) {
-    itsPlanC2CF.reset( new FFTWPlan
-      (fftw_plan_dft(size.nelements(),
-                     size.asStdVector().data(),
-                     reinterpret_cast<fftw_complex *>(in), 
-                     reinterpret_cast<fftw_complex *>(in), 
-                     FFTW_FORWARD, flags)) );
-
+    fftw_complex* cin = reinterpret_cast<fftw_complex *>(in);
+    int align = fftw_alignment_of((double*)in);
+    PlanKey key = makeKey (2, size, -1, FFTW_FORWARD, in, in, align, align);
+    itsPlanC2CF = findPlan (planCache().plans, key, [&]() {
+        return fftw_plan_dft(size.nelements(),
+                             size.asStdVector().data(),
+                             cin, cin, FFTW_FORWARD, key.flags); });
   }
     
   void FFTW::plan_c2c_forward(const IPosition &size, std::complex<float> *in) {
-    itsPlanC2CFf.reset( new FFTWPlanf
-      (fftwf_plan_dft(size.nelements(),
-                      size.asStdVector().data(),
-                      reinterpret_cast<fftwf_complex *>(in), 
-                      reinterpret_cast<fftwf_complex *>(in), 
-                      FFTW_FORWARD, flags)) );
+    fftwf_complex* cin = reinterpret_cast<fftwf_complex *>(in);
+    int align = fftwf_alignment_of((float*)in);
+    PlanKey key = makeKey (2, size, -1, FFTW_FORWARD, in, in, align, align);
+    itsPlanC2CFf = findPlan (planCache().plansf, key, [&]() {
+        return fftwf_plan_dft(size.nelements(),
+                              size.asStdVector().data(),
+                              cin, cin, FFTW_FORWARD, key.flags); });
   }
 
   void FFTW::plan_c2c_backward(const IPosition &size, std::complex<double> *in) {
-    itsPlanC2CB.reset( new FFTWPlan
-      (fftw_plan_dft(size.nelements(),
-                     size.asStdVector().data(),
-                     reinterpret_cast<fftw_complex *>(in), 
-                     reinterpret_cast<fftw_complex *>(in), 
-                     FFTW_BACKWARD, flags)) );
-      
+    fftw_complex* cin = reinterpret_cast<fftw_complex *>(in);
+    int align = fftw_alignment_of((double*)in);
+    PlanKey key = makeKey (2, size, -1, FFTW_BACKWARD, in, in, align, align);
+    itsPlanC2CB = findPlan (planCache().plans, key, [&]() {
+        return fftw_plan_dft(size.nelements(),
+                             size.asStdVector().data(),
+                             cin, cin, FFTW_BACKWARD, key.flags); });
   }
     
   void FFTW::plan_c2c_backward(const IPosition &size, std::complex<float> *in) {
-    itsPlanC2CBf.reset( new FFTWPlanf
-      (fftwf_plan_dft(size.nelements(),
-                      size.asStdVector().data(),
-                      reinterpret_cast<fftwf_complex *>(in), 
-                      reinterpret_cast<fftwf_complex *>(in), 
-                      FFTW_BACKWARD, flags)) );
+    fftwf_complex* cin = reinterpret_cast<fftwf_complex *>(in);
+    int align = fftwf_alignment_of((float*)in);
+    PlanKey key = makeKey (2, size, -1, FFTW_BACKWARD, in, in, align, align);
+    itsPlanC2CBf = findPlan (planCache().plansf, key, [&]() {
+        return fftwf_plan_dft(size.nelements(),
+                              size.asStdVector().data(),
+                              cin, cin, FFTW_BACKWARD, key.flags); });
   }
 
-  // the parameters are used only in order to overload this function
-  void FFTW::r2c(const IPosition&, float*, std::complex<float>*) 
+  void FFTW::plan_c2c_axis(const IPosition &shape, uInt axis,
+                           std::complex<float> *in, bool forward) {
+    fftwf_complex* cin = reinterpret_cast<fftwf_complex *>(in);
+    int sign = (forward ? FFTW_FORWARD : FFTW_BACKWARD);
+    int align = fftwf_alignment_of((float*)in);
+    PlanKey key = makeKey (3, shape, axis, sign, in, in, align, align);
+    itsPlanAxisf = findPlan (planCache().plansf, key, [&]() {
+        fftwf_iodim dim;
+        fftwf_iodim howmany[2];
+        makeAxisDims (shape, axis, dim, howmany);
+        // Only FFTW_ESTIMATE leaves the data untouched.
+        std::vector<char> buffer;
+        fftwf_complex* cbuf = (key.flags == FFTW_ESTIMATE  ?  cin :
+                               alignedLike (buffer, shape.product(), cin));
+        return fftwf_plan_guru_dft(1, &dim, 2, howmany, cbuf, cbuf,
+                                   sign, key.flags); });
+  }
+
+  void FFTW::plan_c2c_axis(const IPosition &shape, uInt axis,
+                           std::complex<double> *in, bool forward) {
+    fftw_complex* cin = reinterpret_cast<fftw_complex *>(in);
+    int sign = (forward ? FFTW_FORWARD : FFTW_BACKWARD);
+    int align = fftw_alignment_of((double*)in);
+    PlanKey key = makeKey (3, shape, axis, sign, in, in, align, align);
+    itsPlanAxis = findPlan (planCache().plans, key, [&]() {
+        fftw_iodim dim;
+        fftw_iodim howmany[2];
+        makeAxisDims (shape, axis, dim, howmany);
+        // Only FFTW_ESTIMATE leaves the data untouched.
+        std::vector<char> buffer;
+        fftw_complex* cbuf = (key.flags == FFTW_ESTIMATE  ?  cin :
+                              alignedLike (buffer, shape.product(), cin));
+        return fftw_plan_guru_dft(1, &dim, 2, howmany, cbuf, cbuf,
+                                  sign, key.flags); });
+  }
+
+  // The arrays are given to the new-array execute functions, because
+  // the plan can have been made by another object.
+  void FFTW::r2c(const IPosition&, float* in, std::complex<float>* out) 
   {
-    fftwf_execute(itsPlanR2Cf->getPlan());
+    fftwf_execute_dft_r2c(itsPlanR2Cf->getPlan(), in,
+                          reinterpret_cast<fftwf_complex *>(out));
   }
     
-  void FFTW::r2c(const IPosition&, double*, std::complex<double>*) 
+  void FFTW::r2c(const IPosition&, double* in, std::complex<double>* out) 
   {
-    fftw_execute(itsPlanR2C->getPlan());
+    fftw_execute_dft_r2c(itsPlanR2C->getPlan(), in,
+                         reinterpret_cast<fftw_complex *>(out));
   }
 
-  void FFTW::c2r(const IPosition&, std::complex<float>*, float*)
+  void FFTW::c2r(const IPosition&, std::complex<float>* in, float* out)
   {
-    fftwf_execute(itsPlanC2Rf->getPlan());
+    fftwf_execute_dft_c2r(itsPlanC2Rf->getPlan(),
+                          reinterpret_cast<fftwf_complex *>(in), out);
   }
     
-  void FFTW::c2r(const IPosition&, std::complex<double>*, double*)
+  void FFTW::c2r(const IPosition&, std::complex<double>* in, double* out)
   {
-    fftw_execute(itsPlanC2R->getPlan());
+    fftw_execute_dft_c2r(itsPlanC2R->getPlan(),
+                         reinterpret_cast<fftw_complex *>(in), out);
   }
     
-  void FFTW::c2c(const IPosition&, std::complex<float>*, bool forward)
+  void FFTW::c2c(const IPosition&, std::complex<float>* in, bool forward)
   {
+    fftwf_complex* cin = reinterpret_cast<fftwf_complex *>(in);
     if (forward) {
-      fftwf_execute(itsPlanC2CFf->getPlan());
+      fftwf_execute_dft(itsPlanC2CFf->getPlan(), cin, cin);
     } else {
-      fftwf_execute(itsPlanC2CBf->getPlan());
+      fftwf_execute_dft(itsPlanC2CBf->getPlan(), cin, cin);
     }
   }
     
-  void FFTW::c2c(const IPosition&, std::complex<double>*, bool forward)
+  void FFTW::c2c(const IPosition&, std::complex<double>* in, bool forward)
   {
+    fftw_complex* cin = reinterpret_cast<fftw_complex *>(in);
     if (forward) {
-      fftw_execute(itsPlanC2CF->getPlan());
+      fftw_execute_dft(itsPlanC2CF->getPlan(), cin, cin);
     } else {
-      fftw_execute(itsPlanC2CB->getPlan());
+      fftw_execute_dft(itsPlanC2CB->getPlan(), cin, cin);
     }
   }
 
+  void FFTW::c2c_axis(std::complex<float>* in)
+  {
+    fftwf_complex* cin = reinterpret_cast<fftwf_complex *>(in);
+    fftwf_execute_dft(itsPlanAxisf->getPlan(), cin, cin);
+  }
+
+  void FFTW::c2c_axis(std::complex<double>* in)
+  {
+    fftw_complex* cin = reinterpret_cast<fftw_complex *>(in);
+    fftw_execute_dft(itsPlanAxis->getPlan(), cin, cin);
+  }
+
   FFTW::Plan FFTW::plan_redft00(const IPosition &size, float *in, float *out)
   {
     initialize_fftw();
     
     std::vector<fftwf_r2r_kind> kinds(size.nelements(), FFTW_REDFT00);
     
+    std::lock_guard<std::mutex> lock(plannerMutex());
     return Plan( new FFTWPlanf(
       fftwf_plan_r2r(size.nelements(), size.asStdVector().data(),
                      in, out, kinds.data(), FFTW_ESTIMATE)) );
@@ -250,6 +474,7 @@ std::mutex FFTW::theirMutex;
     
     std::vector<fftw_r2r_kind> kinds(size.nelements(), FFTW_REDFT00);
     
+    std::lock_guard<std::mutex> lock(plannerMutex());
     return Plan( new FFTWPlan(
       fftw_plan_r2r(size.nelements(), size.asStdVector().data(),
                     in, out, kinds.data(), FFTW_ESTIMATE)) );
@@ -264,6 +489,71 @@ std::mutex FFTW::theirMutex;
   {
     fftw_execute_r2r(_plan->getPlan(), in, out);
   }
+
+  void FFTW::setPlanRigor (PlanRigor rigor)
+  {
+    theirPlanRigor = rigor;
+  }
+
+  FFTW::PlanRigor FFTW::planRigor()
+  {
+    return PlanRigor(theirPlanRigor.load());
+  }
+
+  bool FFTW::importWisdom (const std::string& fileName,
+                           const std::string& fileNamef)
+  {
+    initialize_fftw();
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    bool ok = true;
+    if (! fileName.empty()) {
+      ok = fftw_import_wisdom_from_filename (fileName.c_str());
+    }
+    if (! fileNamef.empty()) {
+      ok = fftwf_import_wisdom_from_filename (fileNamef.c_str())  &&  ok;
+    }
+    return ok;
+  }
+
+  bool FFTW::exportWisdom (const std::string& fileName,
+                           const std::string& fileNamef)
+  {
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    bool ok = true;
+    if (! fileName.empty()) {
+      ok = fftw_export_wisdom_to_filename (fileName.c_str());
+    }
+    if (! fileNamef.empty()) {
+      ok = fftwf_export_wisdom_to_filename (fileNamef.c_str())  &&  ok;
+    }
+    return ok;
+  }
+
+  void FFTW::setMaxCachedPlans (size_t nplans)
+  {
+    theirMaxCachedPlans = nplans;
+  }
+
+  size_t FFTW::maxCachedPlans()
+  {
+    return theirMaxCachedPlans;
+  }
+
+  size_t FFTW::nCachedPlans()
+  {
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    return planCache().plans.size() + planCache().plansf.size();
+  }
+
+  void FFTW::clearPlanCache()
+  {
+    PlanCache oldCache;
+    {
+      std::lock_guard<std::mutex> lock(plannerMutex());
+      std::swap (oldCache, planCache());
+    }
+    // The plans are destroyed here, which locks the planner mutex.
+  }
   
 #else
 
@@ -290,6 +580,10 @@ std::mutex FFTW::theirMutex;
   {}
   void FFTW::plan_c2c_backward(const IPosition&, std::complex<float>*)
   {}
+  void FFTW::plan_c2c_axis(const IPosition&, uInt, std::complex<float>*, bool)
+  {}
+  void FFTW::plan_c2c_axis(const IPosition&, uInt, std::complex<double>*, bool)
+  {}
   void FFTW::r2c(const IPosition&, float*, std::complex<float>*) 
   {}
   void FFTW::r2c(const IPosition&, double*, std::complex<double>*) 
@@ -302,6 +596,10 @@ std::mutex FFTW::theirMutex;
   {}
   void FFTW::c2c(const IPosition&, std::complex<double>*, Bool)
   {}
+  void FFTW::c2c_axis(std::complex<float>*)
+  {}
+  void FFTW::c2c_axis(std::complex<double>*)
+  {}
 
   FFTW::Plan FFTW::plan_redft00(const IPosition &, float *, float *)
   { throw std::runtime_error("FFTW not available"); }
@@ -314,6 +612,23 @@ std::mutex FFTW::theirMutex;
   
   void FFTW::Plan::Execute(double *, double *)
   { throw std::runtime_error("FFTW not available"); }
+
+  void FFTW::setPlanRigor (PlanRigor)
+  {}
+  FFTW::PlanRigor FFTW::planRigor()
+  { return ESTIMATE; }
+  bool FFTW::importWisdom (const std::string&, const std::string&)
+  { return false; }
+  bool FFTW::exportWisdom (const std::string&, const std::string&)
+  { return false; }
+  void FFTW::setMaxCachedPlans (size_t)
+  {}
+  size_t FFTW::maxCachedPlans()
+  { return 0; }
+  size_t FFTW::nCachedPlans()
+  { return 0; }
+  void FFTW::clearPlanCache()
+  {}
   
 #endif
 
@@ -31,6 +31,7 @@
 #include <complex>
 #include <memory>
 #include <mutex>
+#include <string>
 
 namespace casacore {
 
@@ -39,7 +40,7 @@ class FFTWPlan;
 class FFTWPlanf;
 
 // <summary> C++ interface to the FFTWw library </summary>
-// <reviewed reviewer="NONE" date="" tests="" demos="">
+// <reviewed reviewer="NONE" date="" tests="tFFTW" demos="">
 // </reviewed>
 // <synopsis>
 // This is a wrapper of FFTW3.
@@ -49,11 +50,32 @@ class FFTWPlanf;
 // The interface is such that the presence of FFTW3 is only visible
 // in the implementation. The header file does not need to know.
 // In this way external code using this class does not need to set HAVE_FFTW.
+// <p>
+// The plans are kept in a process-wide cache, keyed by the shape, type,
+// direction, in-place-ness and alignment of the data. Thus many FFTW objects
+// (e.g., one per thread) transforming the same shape share a single plan,
+// which is made only once. Planning is serialized by a mutex, because FFTW
+// planning is not thread-safe; executing a plan is done with the new-array
+// execute functions of FFTW, which are thread-safe.
+// The cache holds at most <src>maxCachedPlans</src> plans per precision;
+// if full, the least recently used plan is removed from it.
+// <br>Because plans are reused, a higher planning rigor than the default
+// FFTW_ESTIMATE (see <src>setPlanRigor</src>) can be worthwhile. The
+// accumulated FFTW wisdom can be exported to files and imported by a later
+// run, in which case planning takes hardly any time.
 // </synopsis>
 
 class FFTW
 {
 public:
+  // The planning rigor (the FFTW planner flags).
+  enum PlanRigor {
+    ESTIMATE,
+    MEASURE,
+    PATIENT,
+    EXHAUSTIVE
+  };
+
   FFTW() ;
   
   ~FFTW() ;
@@ -67,16 +89,32 @@ public:
   void plan_c2c_forward(const IPosition &size, std::complex<float> *in) ;
   void plan_c2c_backward(const IPosition &size, std::complex<double> *in) ;
   void plan_c2c_backward(const IPosition &size, std::complex<float> *in) ;
+
+  // Plan an in-place complex->complex transform of all lines along the
+  // given axis of a contiguous array with the given shape. Unlike the
+  // other functions, the shape is given in casacore (Fortran) order.
+  // A single plan (using the FFTW advanced interface) transforms all lines.
+  // The data are not overwritten; if the planner has to measure, the plan is
+  // made on a temporary buffer of the same size.
+  // <group>
+  void plan_c2c_axis(const IPosition &shape, uInt axis,
+                     std::complex<float> *in, bool forward);
+  void plan_c2c_axis(const IPosition &shape, uInt axis,
+                     std::complex<double> *in, bool forward);
+  // </group>
   
-  // TODO These overloads do not use their parameters at all. This should
-  // be written to use an interface like plan_redft00().
   // overloaded interface to fftw[f]_execute...
+  // The plan made by the last plan function for the type of transform is
+  // executed on the given arrays, which must have the same alignment
+  // as the arrays used for planning.
   void r2c(const IPosition &size, float *in, std::complex<float> *out) ;
   void r2c(const IPosition &size, double *in, std::complex<double> *out) ;
   void c2r(const IPosition &size, std::complex<float> *in, float *out);
   void c2r(const IPosition &size, std::complex<double> *in, double *out);
   void c2c(const IPosition &size, std::complex<float> *in, bool forward);
   void c2c(const IPosition &size, std::complex<double> *in, bool forward);
+  void c2c_axis(std::complex<float> *in);
+  void c2c_axis(std::complex<double> *in);
 
   class Plan
   {
@@ -103,36 +141,65 @@ public:
   
   static Plan plan_redft00(const IPosition &size, float *in, float *out);
   static Plan plan_redft00(const IPosition &size, double *in, double *out);
+
+  // Set the planning rigor used for new plans. The default is ESTIMATE.
+  // Plans already in the cache are not affected.
+  static void setPlanRigor (PlanRigor rigor);
+
+  // Get the planning rigor used for new plans.
+  static PlanRigor planRigor();
+
+  // Import the double and single precision wisdom from the given files,
+  // which are in the standard FFTW format (as written by
+  // <src>exportWisdom</src> or the fftw-wisdom and fftwf-wisdom tools).
+  // An empty file name means that the wisdom of that precision is not
+  // imported. It returns false if a file could not be read.
+  static bool importWisdom (const std::string& fileName,
+                            const std::string& fileNamef);
+
+  // Export the double and single precision wisdom to the given files.
+  // An empty file name means that the wisdom of that precision is not
+  // exported. It returns false if a file could not be written.
+  static bool exportWisdom (const std::string& fileName,
+                            const std::string& fileNamef);
+
+  // Set the maximum number of plans per precision in the cache.
+  // The default is 64. Plans removed from the cache remain valid in the
+  // FFTW objects using them.
+  static void setMaxCachedPlans (size_t nplans);
+
+  // Get the maximum number of plans per precision in the cache.
+  static size_t maxCachedPlans();
+
+  // Get the number of plans in the cache.
+  static size_t nCachedPlans();
+
+  // Remove all plans from the cache. Plans still in use by FFTW objects
+  // are destroyed when no longer used.
+  static void clearPlanCache();
   
 private:
   static void initialize_fftw();
   
-  std::unique_ptr<FFTWPlanf> itsPlanR2Cf;
-  std::unique_ptr<FFTWPlan>  itsPlanR2C;
+  std::shared_ptr<FFTWPlanf> itsPlanR2Cf;
+  std::shared_ptr<FFTWPlan>  itsPlanR2C;
   
-  std::unique_ptr<FFTWPlanf> itsPlanC2Rf;
-  std::unique_ptr<FFTWPlan>  itsPlanC2R;
+  std::shared_ptr<FFTWPlanf> itsPlanC2Rf;
+  std::shared_ptr<FFTWPlan>  itsPlanC2R;
   
-  std::unique_ptr<FFTWPlanf> itsPlanC2CFf;   // forward
-  std::unique_ptr<FFTWPlan>  itsPlanC2CF;
+  std::shared_ptr<FFTWPlanf> itsPlanC2CFf;   // forward
+  std::shared_ptr<FFTWPlan>  itsPlanC2CF;
   
-  std::unique_ptr<FFTWPlanf> itsPlanC2CBf;   // backward
-  std::unique_ptr<FFTWPlan>  itsPlanC2CB;
-  
-  std::unique_ptr<FFTWPlanf> itsPlanR2Rf;
-  std::unique_ptr<FFTWPlan>  itsPlanR2R;
-  
-  unsigned flags;
+  std::shared_ptr<FFTWPlanf> itsPlanC2CBf;   // backward
+  std::shared_ptr<FFTWPlan>  itsPlanC2CB;
 
+  std::shared_ptr<FFTWPlanf> itsPlanAxisf;   // lines along an axis
+  std::shared_ptr<FFTWPlan>  itsPlanAxis;
+  
   static bool is_initialized_fftw;  // FFTW needs initialization
                                              // only once per process,
                                              // not once per object
                                              
-  // TODO this mutex does not make FFTW thread safe, because
-  // planning an FFT with FFTW is not thread safe either.
-  // So either the plan..() methods should take the mutex, or
-  // FFTW should leave synchronization fully to the user of
-  // this class: currently it's halfway in between.
   static std::mutex theirMutex;          // Initialization mutex
 };    
     
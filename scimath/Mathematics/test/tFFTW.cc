@@ -0,0 +1,256 @@
+//# tFFTW.cc: Test the FFTW plan cache and the batched axis transforms
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/scimath/Mathematics/FFTW.h>
+#include <casacore/scimath/Mathematics/FFTServer.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayIter.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test the process-wide FFTW plan cache, the wisdom functions and the
+// batched transforms along an axis.
+// </summary>
+
+template<typename T, typename S>
+Array<S> makeData (const IPosition& shape)
+{
+  Array<S> arr(shape);
+  Int64 i = 0;
+  for (auto& v : arr) {
+    v = S(T(i%7) - 3, T(i%5) * 0.5);
+    ++i;
+  }
+  return arr;
+}
+
+// Transform each line along the axis separately.
+template<typename T, typename S>
+Array<S> fftLines (const Array<S>& data, uInt axis, Bool toFrequency,
+                   Bool doShift)
+{
+  FFTServer<T,S> server;
+  Array<S> result = data.copy();
+  ArrayIterator<S> iter(result, IPosition(1, axis));
+  while (! iter.pastEnd()) {
+    Array<S> line = iter.array();
+    if (doShift) {
+      server.fft (line, toFrequency);
+    } else {
+      server.fft0 (line, toFrequency);
+    }
+    iter.next();
+  }
+  return result;
+}
+
+template<typename T, typename S>
+void testAxis (const IPosition& shape, T tol)
+{
+  FFTServer<T,S> server;
+  Array<S> data = makeData<T,S> (shape);
+  for (uInt axis=0; axis<shape.size(); ++axis) {
+    for (Bool toFreq : {True, False}) {
+      Array<S> arr0 = data.copy();
+      server.fft0Axis (arr0, axis, toFreq);
+      AlwaysAssertExit (allNearAbs (arr0, fftLines<T,S>(data, axis, toFreq,
+                                                         False), tol));
+      Array<S> arr1 = data.copy();
+      server.fftAxis (arr1, axis, toFreq);
+      AlwaysAssertExit (allNearAbs (arr1, fftLines<T,S>(data, axis, toFreq,
+                                                         True), tol));
+      // Transforming back gives the original data.
+      server.fftAxis (arr1, axis, !toFreq);
+      AlwaysAssertExit (allNearAbs (arr1, data, tol));
+    }
+    // Flipping back and forth gives the original data.
+    Array<S> arr = data.copy();
+    server.flipAxis (arr, axis, True);
+    server.flipAxis (arr, axis, False);
+    AlwaysAssertExit (allEQ (arr, data));
+  }
+}
+
+void testCache()
+{
+  FFTW::clearPlanCache();
+  AlwaysAssertExit (FFTW::nCachedPlans() == 0);
+  IPosition shape(2, 8, 6);
+  Array<Complex> data = makeData<Float,Complex> (shape);
+  Array<Complex> res1 = data.copy();
+  Array<Complex> res2 = data.copy();
+  FFTServer<Float,Complex> server1;
+  server1.fft0 (res1, True);
+  AlwaysAssertExit (FFTW::nCachedPlans() == 1);
+  // Another server with the same shape uses the same plan.
+  FFTServer<Float,Complex> server2;
+  server2.fft0 (res2, True);
+  AlwaysAssertExit (FFTW::nCachedPlans() == 1);
+  AlwaysAssertExit (allEQ (res1, res2));
+  // Other direction, type or precision needs another plan.
+  server2.fft0 (res2, False);
+  AlwaysAssertExit (FFTW::nCachedPlans() == 2);
+  AlwaysAssertExit (allNearAbs (res2, data, 1e-5));
+  Array<DComplex> ddata = makeData<Double,DComplex> (shape);
+  FFTServer<Double,DComplex> server3;
+  server3.fft0 (ddata, True);
+  AlwaysAssertExit (FFTW::nCachedPlans() == 3);
+  server3.fft0Axis (ddata, 1, True);
+  AlwaysAssertExit (FFTW::nCachedPlans() == 4);
+  // Plans in use remain valid after clearing the cache.
+  FFTW::clearPlanCache();
+  AlwaysAssertExit (FFTW::nCachedPlans() == 0);
+  Array<Complex> res3 = data.copy();
+  server1.fft0 (res3, True);
+  AlwaysAssertExit (allEQ (res3, res1));
+  AlwaysAssertExit (FFTW::nCachedPlans() == 0);
+}
+
+// Let multiple threads plan and execute transforms of the same shape.
+void testThreads()
+{
+  FFTW::clearPlanCache();
+  IPosition shape(3, 16, 10, 4);
+  Array<Complex> data = makeData<Float,Complex> (shape);
+  Array<Complex> expected = data.copy();
+  FFTServer<Float,Complex>().fft0 (expected, True);
+  const int nthread = 4;
+  std::vector<Array<Complex>> results(nthread);
+  std::vector<std::thread> threads;
+  for (int i=0; i<nthread; ++i) {
+    threads.emplace_back ([&data, &results, i]() {
+        FFTServer<Float,Complex> server;
+        for (int j=0; j<5; ++j) {
+          results[i] = data.copy();
+          server.fft0 (results[i], True);
+        }
+      });
+  }
+  for (auto& thr : threads) {
+    thr.join();
+  }
+  for (int i=0; i<nthread; ++i) {
+    AlwaysAssertExit (allEQ (results[i], expected));
+  }
+  AlwaysAssertExit (FFTW::nCachedPlans() == 1);
+}
+
+void testWisdom()
+{
+  FFTW::PlanRigor rigor = FFTW::planRigor();
+  FFTW::setPlanRigor (FFTW::MEASURE);
+  AlwaysAssertExit (FFTW::planRigor() == FFTW::MEASURE);
+  // Planning with MEASURE gathers wisdom.
+  Array<Complex> data = makeData<Float,Complex> (IPosition(1,32));
+  Array<Complex> arr = data.copy();
+  FFTServer<Float,Complex> server;
+  server.fft0 (arr, True);
+  server.fft0 (arr, False);
+  AlwaysAssertExit (allNearAbs (arr, data, 1e-5));
+  FFTW::setPlanRigor (rigor);
+  // The double and single precision wisdom are in separate files.
+  AlwaysAssertExit (FFTW::exportWisdom ("tFFTW_tmp.wisdom",
+                                        "tFFTW_tmp.wisdomf"));
+  AlwaysAssertExit (FFTW::importWisdom ("tFFTW_tmp.wisdom",
+                                        "tFFTW_tmp.wisdomf"));
+  AlwaysAssertExit (FFTW::importWisdom ("", "tFFTW_tmp.wisdomf"));
+  unlink ("tFFTW_tmp.wisdom");
+  unlink ("tFFTW_tmp.wisdomf");
+  AlwaysAssertExit (! FFTW::importWisdom ("tFFTW_tmp.nonexisting", ""));
+}
+
+// Planning an axis transform while measuring must not change the data.
+void testAxisMeasure()
+{
+  FFTW::PlanRigor rigor = FFTW::planRigor();
+  FFTW::setPlanRigor (FFTW::MEASURE);
+  FFTW::clearPlanCache();
+  IPosition shape(3, 6, 8, 5);
+  Array<Complex> data = makeData<Float,Complex> (shape);
+  Array<Complex> arr = data.copy();
+  FFTServer<Float,Complex> server;
+  server.fft0Axis (arr, 1, True);
+  server.fft0Axis (arr, 1, False);
+  AlwaysAssertExit (allNearAbs (arr, data, 1e-5));
+  FFTW::setPlanRigor (rigor);
+}
+
+// The cache keeps at most the given number of plans per precision.
+void testCacheLimit()
+{
+  size_t maxPlans = FFTW::maxCachedPlans();
+  FFTW::clearPlanCache();
+  FFTW::setMaxCachedPlans (2);
+  FFTServer<Float,Complex> server;
+  Array<Complex> data = makeData<Float,Complex> (IPosition(2,8,6));
+  Array<Complex> arr = data.copy();
+  server.fft0 (arr, True);
+  for (int n=4; n<=32; n*=2) {
+    Array<Complex> arrn = makeData<Float,Complex> (IPosition(1,n));
+    server.fft0 (arrn, True);
+    AlwaysAssertExit (FFTW::nCachedPlans() <= 2);
+  }
+  // A plan removed from the cache can still be used.
+  FFTServer<Float,Complex> server2;
+  server2.fft0 (arr, False);
+  AlwaysAssertExit (FFTW::nCachedPlans() == 2);
+  AlwaysAssertExit (allNearAbs (arr, data, 1e-5));
+  // The plans of the other precision are kept separately.
+  Array<DComplex> darr = makeData<Double,DComplex> (IPosition(1,8));
+  FFTServer<Double,DComplex>().fft0 (darr, True);
+  AlwaysAssertExit (FFTW::nCachedPlans() == 3);
+  FFTW::setMaxCachedPlans (maxPlans);
+  AlwaysAssertExit (FFTW::maxCachedPlans() == maxPlans);
+  FFTW::clearPlanCache();
+}
+
+int main()
+{
+  try {
+    testCache();
+    testAxis<Float,Complex> (IPosition(1,8), 1e-4);
+    testAxis<Float,Complex> (IPosition(3,6,5,4), 1e-4);
+    testAxis<Double,DComplex> (IPosition(4,3,8,1,7), 1e-10);
+    testThreads();
+    testWisdom();
+    testAxisMeasure();
+    testCacheLimit();
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
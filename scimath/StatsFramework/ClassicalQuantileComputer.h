@@ -462,10 +462,14 @@ private:
         uInt nBins
     );
 
+    // extract data from the given bins. If the points in the bins do not fit
+    // in <src>maxArraySize</src>, they are binned again if
+    // <src>mayRebin</src> is True. Otherwise they are collected and sorted
+    // anyway, so the final bins are always resolved in a single pass.
     std::vector<IndexValueMap> _dataFromSingleBins(
         const std::vector<uInt64>& binNpts, uInt64 maxArraySize,
         const IncludeLimits& binLimits,
-        const std::vector<IndexSet>& dataIndices, uInt nBins
+        const std::vector<IndexSet>& dataIndices, uInt nBins, Bool mayRebin
     );
 
     // get the values for the specified indices in the sorted array of all good
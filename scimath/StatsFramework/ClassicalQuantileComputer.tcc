@@ -33,6 +33,7 @@
 #include <casacore/scimath/StatsFramework/StatisticsData.h>
 #include <casacore/scimath/StatsFramework/StatisticsIncrementer.h>
 
+#include <algorithm>
 #include <iterator>
 
 namespace casacore {
@@ -816,8 +817,10 @@ ClassicalQuantileComputer<CASA_STATP>::_dataFromMultipleBins(
         ++iDesc;
     });
     if (! vnpts.empty()) {
+        // the bins found by this (rebinning) pass are collected in the next
+        // pass, so no more than two passes are needed
         auto dataFromBins = _dataFromSingleBins(
-            vnpts, maxArraySize, vlimits, vindices, nBins
+            vnpts, maxArraySize, vlimits, vindices, nBins, False
         );
         auto iNewToOld = vNewToOld.cbegin();
         auto iVLimits = vlimits.cbegin();
@@ -852,15 +855,15 @@ CASA_STATD std::vector<std::map<uInt64, AccumType>>
 ClassicalQuantileComputer<CASA_STATP>::_dataFromSingleBins(
     const BinCountArray& binNpts, uInt64 maxArraySize,
     const std::vector<LimitPair>& binLimits,
-    const std::vector<IndexSet>& dataIndices, uInt nBins
+    const std::vector<IndexSet>& dataIndices, uInt nBins, Bool mayRebin
 ) {
     // The uInt64 specification is required or else 0 will be interpreted as a
     // uInt and there will be overflow issues for totalNpts > (2**32)-1
     auto totalPts = std::accumulate(binNpts.begin(), binNpts.end(), uInt64(0));
-    if (totalPts <= maxArraySize) {
-        // contents of bin is small enough to be sorted in memory, so
-        // get the bin limits and stuff the good points within those limits
-        // in an array and sort it
+    if (totalPts <= maxArraySize || ! mayRebin) {
+        // contents of bin is small enough to be sorted in memory (or the bins
+        // cannot be refined anymore), so get the bin limits and stuff the
+        // good points within those limits in an array and sort it
         std::vector<DataArray> dataArrays(binLimits.size(), DataArray(0));
         _createDataArrays(dataArrays, binLimits, totalPts);
         auto iNpts = binNpts.cbegin();
@@ -908,7 +911,23 @@ ClassicalQuantileComputer<CASA_STATP>::_dataFromSingleBins(
     else {
         // number of points is too large to fit in an array to be sorted, so
         // rebin those points into smaller bins
-        // we want at least 1000 bins
+        // we want at least 1000 bins. Use more bins if needed to make it
+        // likely that the points in the bins containing the requested indices
+        // fit in maxArraySize after the next pass. Those points are collected
+        // anyway thereafter, so for strongly peaked data more memory can be
+        // used. The bins are limited to MAX_BINS in total, because each
+        // thread holds its own bin counts.
+        uInt64 nIndices = 0;
+        for (const auto& idxSet : dataIndices) {
+            nIndices += idxSet.size();
+        }
+        auto maxBinNpts = *std::max_element(binNpts.cbegin(), binNpts.cend());
+        uInt64 wantedBins = 2 * nIndices * (maxBinNpts / maxArraySize + 1);
+        uInt64 maxBins = std::max(
+            (uInt64)1000,
+            (uInt64)ClassicalStatisticsData::MAX_BINS/binLimits.size()
+        );
+        nBins = max(nBins, (uInt)std::min(wantedBins, maxBins));
         nBins = max(nBins, (uInt)1000);
         std::vector<StatsHistogram<AccumType>> hist;
         for_each(
@@ -970,7 +989,7 @@ ClassicalQuantileComputer<CASA_STATP>::_indicesToValues(
     std::vector<LimitPair> vlimits(1, limits);
     BinCountArray vmynpts(1, mynpts);
     return _dataFromSingleBins(
-        vmynpts, maxArraySize, vlimits, vindices, nBins
+        vmynpts, maxArraySize, vlimits, vindices, nBins, True
     )[0];
 }
 
@@ -128,7 +128,13 @@ public:
     // bins decrease the likelihood that multiple passes of the data set will be
     // necessary, but also increase the amount of memory used. If nBins is set
     // to less than 1,000, it is automatically increased to 1,000; there should
-    // be no reason to ever set nBins to be this small.
+    // be no reason to ever set nBins to be this small. When the points in a bin
+    // have to be binned again, more bins are used if that makes it likely
+    // that the points in the bins containing the requested quantiles fit in
+    // <src>binningThreshholdSizeBytes</src>. These points are collected
+    // thereafter even if they do not fit, so no more than two passes (one
+    // binning and one collecting pass) of the data set are needed, at the
+    // expense of more memory for strongly peaked data.
     virtual AccumType getMedian(
         std::shared_ptr<uInt64> knownNpts=nullptr,
         std::shared_ptr<AccumType> knownMin=nullptr,
@@ -31,6 +31,7 @@
 #include <casacore/scimath/StatsFramework/ClassicalStatisticsData.h>
 #include <casacore/scimath/StatsFramework/StatisticsIncrementer.h>
 #include <casacore/scimath/StatsFramework/StatisticsUtilities.h>
+#include <atomic>
 #include <memory>
 
 #include <iomanip>
@@ -459,87 +460,102 @@ StatsData<AccumType> ClassicalStatistics<CASA_STATP>::_getStatistics() {
     uInt nThreadsMax = StatisticsUtilities<AccumType>::nThreadsMax(
         ds.getDataProvider()
     );
-    std::unique_ptr<StatsData<AccumType>[]> tStats(
-        new StatsData<AccumType>[
-            ClassicalStatisticsData::CACHE_PADDING*nThreadsMax
-        ]
-    );
-    for (uInt i=0; i<nThreadsMax; ++i) {
-        uInt idx8 = ClassicalStatisticsData::CACHE_PADDING*i;
-        tStats[idx8] = _getInitialStats();
-        // set nominal max and mins so accumulate
-        // doesn't segfault
-        tStats[idx8].min.reset (new AccumType(0));
-        tStats[idx8].max.reset (new AccumType(0));
+    // The statistics of each block of BLOCK_SIZE points are accumulated
+    // separately and combined in block order, so the result is the same
+    // for any number of threads. xstats holds the combined statistics of
+    // each chunk in the order of the chunks.
+    std::vector<StatsData<AccumType>> xstats;
+    if (stats.npts > 0) {
+        // we've accumulated some stats previously so we must
+        // account for that here
+        xstats.push_back(stats);
     }
+    std::vector<StatsData<AccumType>> blockStats;
+    const uInt64 blockSize = ClassicalStatisticsData::BLOCK_SIZE;
     while (True) {
         const auto& chunk = ds.initLoopVars();
-        uInt nBlocks, nthreads;
-        uInt64 extra;
-        std::unique_ptr<DataIterator[]> dataIter;
-        std::unique_ptr<MaskIterator[]> maskIter;
-        std::unique_ptr<WeightsIterator[]> weightsIter;
-        std::unique_ptr<uInt64[]> offset;
-        ds.initThreadVars(
-            nBlocks, extra, nthreads, dataIter,
-            maskIter, weightsIter, offset, nThreadsMax
-        );
         if (chunk.weights) {
             stats.weighted = True;
         }
         if (chunk.mask) {
             stats.masked = True;
         }
+        uInt nBlocks = (chunk.count + blockSize - 1) / blockSize;
+        ThrowIf(nBlocks == 0, "Logic error: nBlocks should never be 0");
+        uInt nthreads = std::min(nThreadsMax, nBlocks);
+        blockStats.resize(nBlocks);
+        for (auto& s : blockStats) {
+            s = _getInitialStats();
+            // set nominal max and mins so accumulate
+            // doesn't segfault
+            s.min.reset (new AccumType(0));
+            s.max.reset (new AccumType(0));
+        }
+        // The threads take the next unprocessed block when they are ready,
+        // so a slow block (e.g. with many masked points) does not hold up
+        // the blocks statically assigned to the same thread. Blocks are
+        // taken in ascending order, so the iterators of a thread only need
+        // to be advanced.
+        std::atomic<uInt> nextBlock(0);
 #ifdef _OPENMP
-#pragma omp parallel for num_threads(nthreads)
+#pragma omp parallel num_threads(nthreads)
 #endif
-        for (uInt i=0; i<nBlocks; ++i) {
-            uInt64 ngood = 0;
-            uInt idx8 = StatisticsUtilities<AccumType>::threadIdx();
-            uInt64 dataCount = (chunk.count - offset[idx8])
-                < ClassicalStatisticsData::BLOCK_SIZE
-                ? extra : ClassicalStatisticsData::BLOCK_SIZE;
-            LocationType location(ds.iDataset(), offset[idx8]);
-            _computeStats(
-                tStats[idx8], ngood, location, dataIter[idx8], maskIter[idx8],
-                weightsIter[idx8], dataCount, chunk
-            );
-            ds.incrementThreadIters(
-                dataIter[idx8], maskIter[idx8], weightsIter[idx8],
-                offset[idx8], nthreads
-            );
+        {
+            DataIterator dataIter = chunk.data;
+            MaskIterator maskIter;
+            WeightsIterator weightsIter;
+            if (chunk.mask) {
+                maskIter = chunk.mask->first;
+            }
+            if (chunk.weights) {
+                weightsIter = *chunk.weights;
+            }
+            uInt64 offset = 0;
+            uInt curBlock = 0;
+            for (uInt iBlock = nextBlock++; iBlock < nBlocks;
+                 iBlock = nextBlock++) {
+                if (iBlock > curBlock) {
+                    ds.incrementThreadIters(
+                        dataIter, maskIter, weightsIter, offset,
+                        iBlock - curBlock
+                    );
+                    curBlock = iBlock;
+                }
+                uInt64 ngood = 0;
+                uInt64 dataCount = std::min(
+                    blockSize, chunk.count - iBlock*blockSize
+                );
+                LocationType location(ds.iDataset(), offset);
+                _computeStats(
+                    blockStats[iBlock], ngood, location, dataIter,
+                    maskIter, weightsIter, dataCount, chunk
+                );
+            }
         }
-        for (uInt tid=0; tid<nthreads; ++tid) {
+        std::vector<StatsData<AccumType>> cstats;
+        for (auto& s : blockStats) {
+            // in case no max/min was set, clear the nominal values
+            // set above
+            if (s.minpos.first < 0) {
+                s.min.reset();
+            }
+            if (s.maxpos.first < 0) {
+                s.max.reset();
+            }
+            if (s.npts > 0) {
+                cstats.push_back(s);
+            }
+        }
+        if (! cstats.empty()) {
+            xstats.push_back(StatisticsUtilities<AccumType>::combine(cstats));
             // LattStatsDataProvider relies on min and max
             // being updated after each increment of the data provider
-            uInt idx8 = ClassicalStatisticsData::CACHE_PADDING*tid;
-            _updateDataProviderMaxMin(tStats[idx8]);
+            _updateDataProviderMaxMin(xstats.back());
         }
         if (ds.increment(True)) {
             break;
         }
     }
-    std::vector<StatsData<AccumType>> xstats;
-    for (uInt i=0; i<nThreadsMax; ++i) {
-        // in case no max/min was set, clear the nominal values
-        // set above
-        StatsData<AccumType>& s 
-            = tStats[ClassicalStatisticsData::CACHE_PADDING*i];
-        if (s.minpos.first < 0) {
-            s.min.reset();
-        }
-        if (s.maxpos.first < 0) {
-            s.max.reset();
-        }
-        if(s.npts > 0) {
-            xstats.push_back(s);
-        }
-    }
-    if (stats.npts > 0) {
-        // we've accumulated some stats previously so we must
-        // account for that here
-        xstats.push_back(stats);
-    }
     auto vstats = StatisticsUtilities<AccumType>::combine(xstats);
     stats.masked = vstats.masked;
     stats.max = vstats.max;
@@ -32,5 +32,7 @@ const uInt ClassicalStatisticsData::CACHE_PADDING = 8;
 
 const uInt ClassicalStatisticsData::BLOCK_SIZE = 4000;
 
+const uInt ClassicalStatisticsData::MAX_BINS = 1000000;
+
 }
 
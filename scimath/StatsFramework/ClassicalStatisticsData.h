@@ -43,6 +43,9 @@ public:
 
     static const uInt BLOCK_SIZE;
 
+    // maximum total number of bins used when rebinning data to find quantiles
+    static const uInt MAX_BINS;
+
     ~ClassicalStatisticsData() {}
 
 };
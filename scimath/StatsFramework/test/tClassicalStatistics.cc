@@ -27,6 +27,7 @@
 #include <casacore/casa/Arrays.h>
 #include <casacore/scimath/StatsFramework/ClassicalStatistics.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/OS/OMP.h>
 
 #include <random>
 #include <vector>
@@ -1960,6 +1961,43 @@ int main() {
             cout << "nvar/n " << stats.nvariance/stats.npts << endl;
 
         }
+        {
+            // the accumulated statistics must be the same for any number
+            // of threads, and the median must be correct if the data has to
+            // be binned
+            std::mt19937 gen(17);
+            std::normal_distribution<Double> dist(0, 1);
+            vector<Double> v(1234567);
+            for (auto& x : v) {
+                x = dist(gen);
+            }
+            v[1000] = 1e5;
+            StatsData<Double> sd[2];
+            uInt nthreads[] = {1, 4};
+            for (uInt i=0; i<2; ++i) {
+                OMP::setNumThreads(nthreads[i]);
+                ClassicalStatistics<
+                    Double, vector<Double>::const_iterator,
+                    vector<Bool>::const_iterator
+                > cs;
+                cs.setData(v.cbegin(), v.size());
+                sd[i] = cs.getStatistics();
+                auto median = cs.getMedian(nullptr, nullptr, nullptr, 100000);
+                vector<Double> sorted = v;
+                std::nth_element(
+                    sorted.begin(), sorted.begin() + v.size()/2, sorted.end()
+                );
+                AlwaysAssert(median == sorted[v.size()/2], AipsError);
+            }
+            AlwaysAssert(sd[0].mean == sd[1].mean, AipsError);
+            AlwaysAssert(sd[0].sum == sd[1].sum, AipsError);
+            AlwaysAssert(sd[0].sumsq == sd[1].sumsq, AipsError);
+            AlwaysAssert(sd[0].nvariance == sd[1].nvariance, AipsError);
+            AlwaysAssert(*sd[0].max == 1e5, AipsError);
+            AlwaysAssert(sd[0].maxpos == sd[1].maxpos, AipsError);
+            AlwaysAssert(*sd[0].min == *sd[1].min, AipsError);
+            AlwaysAssert(sd[0].minpos == sd[1].minpos, AipsError);
+        }
     }
     catch (const std::exception& x) {
         cout << x.what() << endl;
@@ -1,13 +1,44 @@
 #include "SiscoReader.h"
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
 
 namespace casacore::sisco {
 
-SiscoReader::SiscoReader(const std::string& filename) : filename_(filename)
+SiscoReader::SiscoReader(const std::string& filename, size_t n_threads, ThreadPool& pool) :
+  filename_(filename),
+  pool_(pool),
+  n_threads_(n_threads == 0 ? pool.NThreads() : n_threads),
+  chunks_(n_threads_ + 1)
 {
 }
 
+SiscoReader::~SiscoReader()
+{
+  Stop();
+}
+
+void SiscoReader::Stop()
+{
+  if(read_thread_.joinable()) {
+    // Ending the lane unblocks the read thread if it waits for Read().
+    stop_ = true;
+    chunks_.write_end();
+    read_thread_.join();
+  }
+}
+
+void SiscoReader::Start()
+{
+  stop_ = false;
+  chunks_.clear();
+  chunk_data_.clear();
+  chunk_item_position_ = 0;
+  baseline_data_.clear();
+  read_thread_ = std::thread([&](){ ReadLoop(); });
+}
+
 void SiscoReader::Open(std::span<std::byte> header_data)
 {
   file_ = std::ifstream(filename_);
@@ -22,6 +53,18 @@ void SiscoReader::Open(std::span<std::byte> header_data)
   
   if(!file_.good())
     throw std::runtime_error("Failed to read header from " + filename_);
+  data_start_ = file_.tellg();
+
+  Start();
+}
+
+void SiscoReader::Rewind()
+{
+  assert(file_.is_open());
+  Stop();
+  file_.clear();
+  file_.seekg(data_start_);
+  Start();
 }
 
 void SiscoReader::Read(size_t baseline_index, std::span<std::complex<float>> data)
@@ -29,9 +72,11 @@ void SiscoReader::Read(size_t baseline_index, std::span<std::complex<float>> dat
   assert(file_.is_open());
   if(chunk_item_position_ * 2 * (kCompressedMantissaSize + kCompressedExponentSize) >= chunk_data_.size())
   {
-    const size_t decompressed_size = ReadChunk(read_buffer_);
-    chunk_data_.resize(decompressed_size);
-    deflate_decompressor.Decompress(read_buffer_, chunk_data_);
+    std::future<std::vector<std::byte>> chunk;
+    if(!chunks_.read(chunk))
+      throw std::runtime_error("Could not read from file " + filename_);
+    // Rethrows an exception from the read thread or inflate workers.
+    chunk_data_ = chunk.get();
     chunk_item_position_ = 0;
   }
   real_data_.resize(data.size());
@@ -58,11 +103,47 @@ void SiscoReader::Read(size_t baseline_index, std::span<std::complex<float>> dat
   chunk_item_position_ += data.size();
 }
 
+void SiscoReader::ReadLoop()
+{
+  try {
+    while(!stop_) {
+      std::shared_ptr<InflateTask> task = std::make_shared<InflateTask>();
+      task->decompressed_size = ReadChunk(task->data);
+      if(task->decompressed_size == 0)
+        break;
+      // Blocks while the maximum number of chunks is ahead.
+      chunks_.write(task->result.get_future());
+      if(stop_)
+        break;
+      pool_.Submit([task]() { Inflate(*task); });
+    }
+  } catch(...) {
+    std::promise<std::vector<std::byte>> failure;
+    failure.set_exception(std::current_exception());
+    chunks_.write(failure.get_future());
+  }
+  chunks_.write_end();
+}
+
+void SiscoReader::Inflate(InflateTask& task)
+{
+  try {
+    thread_local deflate::Decompressor decompressor;
+    std::vector<std::byte> result(task.decompressed_size);
+    decompressor.Decompress(task.data, result);
+    task.result.set_value(std::move(result));
+  } catch(...) {
+    task.result.set_exception(std::current_exception());
+  }
+}
+
 size_t SiscoReader::ReadChunk(std::vector<std::byte>& buffer)
 {
   uint64_t decompressed_size;
   uint64_t compressed_size;
   file_.read(reinterpret_cast<char*>(&decompressed_size), sizeof(decompressed_size));
+  if(file_.eof() && file_.gcount() == 0)
+    return 0;
   file_.read(reinterpret_cast<char*>(&compressed_size), sizeof(compressed_size));
   buffer.resize(compressed_size);
   file_.read(reinterpret_cast<char*>(buffer.data()), compressed_size);
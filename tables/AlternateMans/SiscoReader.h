@@ -1,36 +1,79 @@
 #ifndef SISCO_SISCO_READER_H_
 #define SISCO_SISCO_READER_H_
 
+#include <atomic>
 #include <complex>
 #include <fstream>
+#include <future>
 #include <map>
 #include <span>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Deflate.h"
+#include "Lane.h"
 #include "Sisco.h"
+#include "ThreadPool.h"
 
 namespace casacore::sisco {
 
 /**
  * File interface for data stored in the generated model compression (Sisco)
  * format.
+ *
+ * Chunks are decompressed ahead: after opening, a read thread reads the
+ * compressed chunks and submits them to a @ref ThreadPool, which is by
+ * default shared by all readers. The decompressed chunks are delivered in
+ * order to @ref Read(), which undoes the prediction. That last step is done
+ * in the calling thread, because it depends on the previous rows of the same
+ * baseline.
  */
 class SiscoReader {
  public:
-  SiscoReader(const std::string& filename);
-  SiscoReader(SiscoReader&&) = default;
-  ~SiscoReader() = default;
-  SiscoReader& operator=(SiscoReader&&) = default;
+  /**
+   * @param n_threads Maximum number of chunks that are decompressed in
+   * parallel ahead of @ref Read(). If zero, the number of threads of the
+   * pool is used.
+   * @param pool The pool decompressing the chunks.
+   */
+  SiscoReader(const std::string& filename, size_t n_threads = 0,
+              ThreadPool& pool = ThreadPool::Shared());
+  ~SiscoReader();
+
+  // The read thread refers to this object, so it cannot be copied or moved.
+  SiscoReader(const SiscoReader&) = delete;
+  SiscoReader(SiscoReader&&) = delete;
+  SiscoReader& operator=(const SiscoReader&) = delete;
+  SiscoReader& operator=(SiscoReader&&) = delete;
 
   void Open(std::span<std::byte> header_data);
+
+  /**
+   * Continue reading at the first chunk, as if the file has just been
+   * opened. The open file and the read thread are reused.
+   */
+  void Rewind();
+
   void Read(size_t baseline_index, std::span<std::complex<float>> data);
 
   int PredictLevel() const { return predict_level_; }
 
  private:
+  struct InflateTask {
+    std::vector<std::byte> data;
+    size_t decompressed_size;
+    std::promise<std::vector<std::byte>> result;
+  };
+
+  void Start();
+  void ReadLoop();
+  // Executed by the pool; it only uses the task, so it can finish after
+  // the reader has been stopped or destructed.
+  static void Inflate(InflateTask& task);
+  void Stop();
+
   int predict_level_;
-  std::vector<std::byte> read_buffer_;
   std::vector<std::byte> chunk_data_;
   size_t chunk_item_position_ = 0;
   std::vector<float> real_data_;
@@ -41,14 +84,22 @@ class SiscoReader {
     CompressorState imaginary_state_;
   };
 
-  // Returns the decompressed size
+  // Returns the decompressed size, or zero at the end of the file.
   size_t ReadChunk(std::vector<std::byte>& buffer);
 
   // Indexed by baseline_index.
   std::map<size_t, BaselineData> baseline_data_;
   std::string filename_;
   std::ifstream file_;
-  deflate::Decompressor deflate_decompressor;
+  // Position of the first chunk in the file.
+  std::streampos data_start_;
+  ThreadPool& pool_;
+  size_t n_threads_;
+  // The decompressed chunks in file order. The capacity limits the
+  // number of chunks that are decompressed ahead.
+  aocommon::Lane<std::future<std::vector<std::byte>>> chunks_;
+  std::atomic<bool> stop_ = false;
+  std::thread read_thread_;
 };
 
 }  // namespace casacore::sisco
@@ -22,6 +22,7 @@ SiscoStMan::SiscoStMan(const casacore::String &/*name*/,
     : DataManager() {
   const std::string kDeflateLevelKey = "deflate_level";
   const std::string kPredictLevelKey = "predict_level";
+  const std::string kThreadsKey = "threads";
 
   if (spec.isDefined(kDeflateLevelKey)) {
     deflate_level_ = spec.asInt(kDeflateLevelKey);
@@ -33,11 +34,18 @@ SiscoStMan::SiscoStMan(const casacore::String &/*name*/,
     if (predict_level_ < -1)
       throw std::runtime_error("Invalid value for " + kPredictLevelKey);
   }
+  if (spec.isDefined(kThreadsKey)) {
+    const int n_threads = spec.asInt(kThreadsKey);
+    if (n_threads < 0)
+      throw std::runtime_error("Invalid value for " + kThreadsKey);
+    n_threads_ = n_threads;
+  }
 }
 
 SiscoStMan::SiscoStMan(const SiscoStMan &source)
     : DataManager(),
-      name_(source.name_), deflate_level_(source.deflate_level_), predict_level_(source.predict_level_) {}
+      name_(source.name_), deflate_level_(source.deflate_level_), predict_level_(source.predict_level_),
+      n_threads_(source.n_threads_) {}
 
 SiscoStMan::~SiscoStMan() noexcept = default;
 
@@ -45,6 +53,7 @@ casacore::Record SiscoStMan::dataManagerSpec() const {
   casacore::Record result;
   result.define("deflate_level", deflate_level_);
   result.define("predict_level", predict_level_);
+  result.define("threads", static_cast<int>(n_threads_));
   return result;
 }
 
@@ -81,6 +81,13 @@ class SiscoStMan final : public casacore::DataManager {
 
   int DeflateLevel() const { return deflate_level_; }
   int PredictLevel() const { return predict_level_; }
+  /**
+   * Number of worker threads used for compressing the data, and the
+   * maximum number of chunks that are decompressed ahead while reading.
+   * Zero means that the number of hardware threads is used.
+   * Decompression is done by a thread pool shared by all Sisco columns.
+   */
+  size_t NThreads() const { return n_threads_; }
 
  protected:
  private:
@@ -147,6 +154,7 @@ class SiscoStMan final : public casacore::DataManager {
   std::unique_ptr<SiscoStManColumn> column_;
   int deflate_level_ = 9;
   int predict_level_ = 2;
+  size_t n_threads_ = 0;
 };
 
 }  // namespace casacore
@@ -201,7 +201,7 @@ class SiscoStManColumn final : public StManColumn {
   void OpenWriter() {
     Reset();
     writer_.emplace(parent_.fileName(), parent_.PredictLevel(),
-                    parent_.DeflateLevel());
+                    parent_.DeflateLevel(), parent_.NThreads());
     char header_buffer[kHeaderSize];
     std::fill_n(header_buffer, kHeaderSize, 0);
     std::copy_n(kMagic, kMagicSize, &header_buffer[0]);
@@ -222,20 +222,26 @@ class SiscoStManColumn final : public StManColumn {
   }
 
   void OpenReader() {
-    Reset();
-    reader_.emplace(parent_.fileName());
-    char header_buffer[kHeaderSize];
-    std::span<std::byte> header(reinterpret_cast<std::byte *>(header_buffer),
-                                kHeaderSize);
-    reader_->Open(header);
-    char magic_tag[kMagicSize];
-    short version_major;
-    short version_minor;
-    std::copy_n(&header_buffer[0], kMagicSize, magic_tag);
-    std::copy_n(&header_buffer[kMagicSize], 2,
-                reinterpret_cast<char *>(&version_major));
-    std::copy_n(&header_buffer[kMagicSize + 2], 2,
-                reinterpret_cast<char *>(&version_minor));
+    // When seeking backward, the reader (with its open file and read
+    // thread) is reused.
+    if (reader_) {
+      reader_->Rewind();
+    } else {
+      Reset();
+      reader_.emplace(parent_.fileName(), parent_.NThreads());
+      char header_buffer[kHeaderSize];
+      std::span<std::byte> header(
+          reinterpret_cast<std::byte *>(header_buffer), kHeaderSize);
+      reader_->Open(header);
+      char magic_tag[kMagicSize];
+      short version_major;
+      short version_minor;
+      std::copy_n(&header_buffer[0], kMagicSize, magic_tag);
+      std::copy_n(&header_buffer[kMagicSize], 2,
+                  reinterpret_cast<char *>(&version_major));
+      std::copy_n(&header_buffer[kMagicSize + 2], 2,
+                  reinterpret_cast<char *>(&version_minor));
+    }
     shapes_reader_.emplace(ShapesFilename());
 
     current_row_ = 0;
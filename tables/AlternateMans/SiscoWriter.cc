@@ -1,23 +1,20 @@
 #include "SiscoWriter.h"
 
+#include <algorithm>
 #include <cassert>
 #include <set>
 #include <thread>
 #include <vector>
 
 namespace casacore::sisco {
-namespace {
-/// Concatenate mantissas and exponents into one buffer
-void Concatenate(std::vector<std::byte>& destination, const std::vector<std::byte>& mantissas, const std::vector<std::byte>& exponents, size_t n_elements) {
-  destination.reserve(n_elements * 2 * (kCompressedMantissaSize + kCompressedExponentSize));
-  destination.assign(mantissas.begin(), mantissas.begin() + n_elements * 2 * kCompressedMantissaSize);
-  destination.insert(destination.end(), exponents.begin(), exponents.begin() + n_elements * 2 * kCompressedExponentSize);
-}
-} // namespace
 
-SiscoWriter::SiscoWriter(const std::string& filename, int predict_level, int deflate_level) :
-  filename_(filename), predict_level_(predict_level), deflate_level_(deflate_level)
+SiscoWriter::SiscoWriter(const std::string& filename, int predict_level, int deflate_level, size_t n_threads) :
+  filename_(filename), predict_level_(predict_level), deflate_level_(deflate_level),
+  n_threads_(n_threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : n_threads)
 {
+  prediction_tasks_.reserve(n_threads_);
+  for(size_t i=0; i!=n_threads_; ++i)
+    prediction_tasks_.emplace_back(2);
 }
 
 void SiscoWriter::Open(std::span<const std::byte> header_data) {
@@ -29,16 +26,23 @@ void SiscoWriter::Open(std::span<const std::byte> header_data) {
   signed char predict_level_char = predict_level_;
   file_.write(reinterpret_cast<const char*>(&predict_level_char), 1);
   preprocess_thread_ = std::thread([&](){ PreprocessLoop(); });
-  for(std::thread& worker : deflate_threads_)
-    worker = std::thread([&]() { DeflateWorker(); });
+  for(size_t i=0; i!=n_threads_; ++i)
+    prediction_threads_.emplace_back([&, i]() { PredictionWorker(i); });
+  for(size_t i=0; i!=n_threads_; ++i)
+    deflate_threads_.emplace_back([&]() { DeflateWorker(); });
   write_thread_ = std::thread([&](){ WriteLoop(); });
 }
 
 void SiscoWriter::Close() {
   preprocessing_tasks_.write_end();
   preprocess_thread_.join();
+  for(std::thread& worker : prediction_threads_)
+    worker.join();
+  prediction_threads_.clear();
+  deflate_tasks_.write_end();
   for(std::thread& worker : deflate_threads_)
     worker.join();
+  deflate_threads_.clear();
   write_tasks_.write_end();
   write_thread_.join();
   file_.close();
@@ -61,68 +65,89 @@ void SiscoWriter::Write(size_t baseline_index, std::span<const std::complex<floa
 void SiscoWriter::PreprocessLoop() {
   CompressionTask task;
   size_t n_chunks = 0;
-  size_t chunk_position = 0;
   size_t chunk_size = kDefaultChunkSize;
-  // Times 2 because it is complex data
-  std::vector<std::byte> mantisas_data(chunk_size * 2 * kCompressedMantissaSize);
-  std::byte* mantisa_position = mantisas_data.data();
-  std::vector<std::byte> exponent_data(chunk_size * 2 * kCompressedExponentSize);
-  std::byte* exponent_position = exponent_data.data();
+  std::shared_ptr<PredictionTask> chunk = std::make_shared<PredictionTask>();
+  chunk->index = n_chunks;
 
   while(preprocessing_tasks_.read(task)) {
-    BaselineData& baseline = baseline_data_[task.baseline_index];
     const size_t row_size = task.real_data.size();
 
     // A chunk should contain at least one row, so if this row is
     // larger than the chunk size, enlarge chunk.
     if(row_size > chunk_size) [[unlikely]] {
       chunk_size = row_size;
-      // resize operation may invalidate pointers, so store offsets...
-      const size_t m_offset = mantisa_position - mantisas_data.data();
-      const size_t e_offset = exponent_position - exponent_data.data();
-      mantisas_data.resize(chunk_size * 2 * kCompressedMantissaSize);
-      exponent_data.resize(chunk_size * 2 * kCompressedExponentSize);
-      mantisa_position = mantisas_data.data() + m_offset;
-      exponent_position = exponent_data.data() + e_offset;
     }
 
     // Is chunk full?
-    if(chunk_position + row_size > chunk_size) {
-      DeflateTask deflate_task;
-      deflate_task.index = n_chunks;
-      Concatenate(deflate_task.data, mantisas_data, exponent_data, chunk_position);
-      deflate_tasks_.write(std::move(deflate_task));
-      mantisa_position = mantisas_data.data();
-      exponent_position = exponent_data.data();
-      chunk_position = 0;
+    if(chunk->n_elements + row_size > chunk_size) {
+      SendChunk(std::move(chunk));
       ++n_chunks;
+      chunk = std::make_shared<PredictionTask>();
+      chunk->index = n_chunks;
     }
 
-    chunk_position += row_size;
-    const size_t mantissa_row_size = row_size * kCompressedMantissaSize;
-    const size_t exponent_row_size = row_size * kCompressedExponentSize;
-
-    std::span real_mantissa(mantisa_position, mantissa_row_size);
-    std::span real_exponent(exponent_position, exponent_row_size);
-    Compress2D(predict_level_, baseline.real_state_, task.real_data, real_mantissa, real_exponent);
-    mantisa_position += mantissa_row_size;
-    exponent_position += exponent_row_size;
-
-    std::span imaginary_mantissa(mantisa_position, mantissa_row_size);
-    std::span imaginary_exponent(exponent_position, exponent_row_size);
-    Compress2D(predict_level_, baseline.imaginary_state_, task.imaginary_data, imaginary_mantissa, imaginary_exponent);
-    mantisa_position += mantissa_row_size;
-    exponent_position += exponent_row_size;
+    chunk->row_positions.emplace_back(chunk->n_elements);
+    chunk->n_elements += row_size;
+    chunk->rows.emplace_back(std::move(task));
   }
 
-  if(chunk_position != 0) {
-    DeflateTask deflate_task;
-    deflate_task.index = n_chunks;
-    Concatenate(deflate_task.data, mantisas_data, exponent_data, chunk_position);
-    deflate_tasks_.write(std::move(deflate_task));
+  if(chunk->n_elements != 0) {
+    SendChunk(std::move(chunk));
   }
 
-  deflate_tasks_.write_end();
+  for(aocommon::Lane<std::shared_ptr<PredictionTask>>& lane : prediction_tasks_)
+    lane.write_end();
+}
+
+void SiscoWriter::SendChunk(std::shared_ptr<PredictionTask> chunk) {
+  // Times 2 because it is complex data. All mantissas are stored before
+  // all exponents.
+  chunk->data.resize(chunk->n_elements * 2 * (kCompressedMantissaSize + kCompressedExponentSize));
+  chunk->n_pending_workers = prediction_tasks_.size();
+  for(aocommon::Lane<std::shared_ptr<PredictionTask>>& lane : prediction_tasks_)
+    lane.write(chunk);
+}
+
+void SiscoWriter::PredictionWorker(size_t worker_index) {
+  // Indexed by baseline_index; holds only the baselines of this worker.
+  std::map<size_t, BaselineData> baseline_data;
+  const size_t n_workers = prediction_tasks_.size();
+  std::shared_ptr<PredictionTask> chunk;
+  while(prediction_tasks_[worker_index].read(chunk)) {
+    std::byte* mantissas = chunk->data.data();
+    std::byte* exponents = mantissas + chunk->n_elements * 2 * kCompressedMantissaSize;
+    for(size_t i=0; i!=chunk->rows.size(); ++i) {
+      CompressionTask& row = chunk->rows[i];
+      if(row.baseline_index % n_workers != worker_index)
+        continue;
+
+      BaselineData& baseline = baseline_data[row.baseline_index];
+      const size_t row_size = row.real_data.size();
+      const size_t mantissa_row_size = row_size * kCompressedMantissaSize;
+      const size_t exponent_row_size = row_size * kCompressedExponentSize;
+      std::byte* mantisa_position = mantissas + chunk->row_positions[i] * 2 * kCompressedMantissaSize;
+      std::byte* exponent_position = exponents + chunk->row_positions[i] * 2 * kCompressedExponentSize;
+
+      std::span real_mantissa(mantisa_position, mantissa_row_size);
+      std::span real_exponent(exponent_position, exponent_row_size);
+      Compress2D(predict_level_, baseline.real_state_, row.real_data, real_mantissa, real_exponent);
+      mantisa_position += mantissa_row_size;
+      exponent_position += exponent_row_size;
+
+      std::span imaginary_mantissa(mantisa_position, mantissa_row_size);
+      std::span imaginary_exponent(exponent_position, exponent_row_size);
+      Compress2D(predict_level_, baseline.imaginary_state_, row.imaginary_data, imaginary_mantissa, imaginary_exponent);
+    }
+
+    // The last worker that finishes the chunk passes it on.
+    if(--chunk->n_pending_workers == 0) {
+      DeflateTask deflate_task;
+      deflate_task.index = chunk->index;
+      deflate_task.data = std::move(chunk->data);
+      deflate_tasks_.write(std::move(deflate_task));
+    }
+    chunk.reset();
+  }
 }
 
 void SiscoWriter::DeflateWorker() {
@@ -1,11 +1,15 @@
 #ifndef SISCO_SISCO_WRITER_H_
 #define SISCO_SISCO_WRITER_H_
 
+#include <atomic>
 #include <complex>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <span>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Deflate.h"
 #include "Lane.h"
@@ -16,16 +20,32 @@ namespace casacore::sisco {
 /**
  * File interface for data stored in the generated model compression (Sisco)
  * format.
+ *
+ * Writing is pipelined: rows are collected into chunks by a preprocessing
+ * thread, after which a pool of prediction workers calculates the
+ * predictions and splits the residuals into mantissas and exponents. Each
+ * worker handles a fixed subset of the baselines, so that the rows of a
+ * baseline are predicted in order. A pool of deflate workers compresses the
+ * chunks, and a write thread writes them in order to the file. The written
+ * file is therefore independent of the number of threads.
  */
 class SiscoWriter {
  public:
+  /**
+   * @param n_threads Number of prediction and of deflate worker threads. If
+   * zero, the number of hardware threads is used.
+   */
   SiscoWriter(const std::string& filename, int predict_level,
-              int deflate_level);
-  SiscoWriter(SiscoWriter&&) = default;
+              int deflate_level, size_t n_threads = 0);
   ~SiscoWriter() {
     if (file_.is_open()) Close();
   }
-  SiscoWriter& operator=(SiscoWriter&&) = default;
+
+  // The threads refer to this object, so it cannot be copied or moved.
+  SiscoWriter(const SiscoWriter&) = delete;
+  SiscoWriter(SiscoWriter&&) = delete;
+  SiscoWriter& operator=(const SiscoWriter&) = delete;
+  SiscoWriter& operator=(SiscoWriter&&) = delete;
 
   void Open(std::span<const std::byte> header_data);
   void Write(size_t baseline_index, std::span<const std::complex<float>> data);
@@ -37,6 +57,21 @@ class SiscoWriter {
     std::vector<float> imaginary_data;
     size_t baseline_index;
   };
+  /**
+   * A chunk of rows that is processed by all prediction workers. Each
+   * worker writes the rows of its baselines into disjoint parts of
+   * @c data. The last worker to finish sends the chunk to the deflate
+   * workers.
+   */
+  struct PredictionTask {
+    size_t index;
+    std::vector<CompressionTask> rows;
+    // Start of each row (in number of complex values) within the chunk.
+    std::vector<size_t> row_positions;
+    size_t n_elements = 0;
+    std::vector<std::byte> data;
+    std::atomic<size_t> n_pending_workers;
+  };
   struct DeflateTask {
     size_t index;
     std::vector<std::byte> data;
@@ -53,25 +88,29 @@ class SiscoWriter {
   };
 
   void PreprocessLoop();
+  void SendChunk(std::shared_ptr<PredictionTask> chunk);
+  void PredictionWorker(size_t worker_index);
   void DeflateWorker();
   void WriteLoop();
   void WriteChunk(size_t uncompressed_size, std::span<const std::byte> data);
 
   constexpr static size_t kDefaultChunkSize = 1024 * 1024;
 
-  // Indexed by baseline_index.
-  std::map<size_t, BaselineData> baseline_data_;
   std::ofstream file_;
   std::string filename_;
-  std::vector<std::thread> compression_threads_;
   int predict_level_ = 2;
   int deflate_level_ = 9;
+  size_t n_threads_;
   aocommon::Lane<CompressionTask> preprocessing_tasks_{4096};
+  // One lane per prediction worker.
+  std::vector<aocommon::Lane<std::shared_ptr<PredictionTask>>>
+      prediction_tasks_;
   aocommon::Lane<DeflateTask> deflate_tasks_{10};
   aocommon::Lane<WriteTask> write_tasks_{10};
 
   std::thread preprocess_thread_;
-  std::array<std::thread, 5> deflate_threads_;
+  std::vector<std::thread> prediction_threads_;
+  std::vector<std::thread> deflate_threads_;
   std::thread write_thread_;
 };
 
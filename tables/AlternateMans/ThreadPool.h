@@ -0,0 +1,98 @@
+#ifndef SISCO_THREAD_POOL_H_
+#define SISCO_THREAD_POOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace casacore::sisco {
+
+/**
+ * A fixed number of worker threads that execute submitted tasks in the
+ * order of submission.
+ *
+ * The readers of all Sisco columns share a single pool (see @ref Shared()),
+ * so that the number of decompression threads in a process is bounded,
+ * independent of the number of open columns and of how often they are
+ * reopened. A task should not wait for another task of the pool.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @param n_threads Number of worker threads. If zero, the number of
+   * hardware threads is used.
+   */
+  explicit ThreadPool(size_t n_threads = 0) {
+    if (n_threads == 0)
+      n_threads = std::max(1u, std::thread::hardware_concurrency());
+    threads_.reserve(n_threads);
+    for (size_t i = 0; i != n_threads; ++i)
+      threads_.emplace_back([&]() { Work(); });
+  }
+
+  /**
+   * Finishes the tasks that were already submitted and stops the threads.
+   */
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& thread : threads_) thread.join();
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * The pool shared by all Sisco readers. It uses the number of hardware
+   * threads and is created on first use.
+   */
+  static ThreadPool& Shared() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  size_t NThreads() const { return threads_.size(); }
+
+  /**
+   * Add a task to the queue. It does not block; the caller is responsible
+   * for limiting the number of outstanding tasks. The task should not throw.
+   */
+  void Submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace_back(std::move(task));
+    }
+    condition_.notify_one();
+  }
+
+ private:
+  void Work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      condition_.wait(lock, [&]() { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) return;
+      std::function<void()> task = std::move(tasks_.front());
+      tasks_.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::function<void()>> tasks_;
+  bool stop_ = false;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace casacore::sisco
+
+#endif
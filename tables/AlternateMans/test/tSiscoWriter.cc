@@ -4,6 +4,9 @@
 #include <boost/test/unit_test.hpp>
 
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
 
 namespace casacore::sisco {
 
@@ -85,6 +88,88 @@ BOOST_FIXTURE_TEST_CASE(write, FileFixture) {
   BOOST_CHECK_EQUAL_COLLECTIONS(data_2.begin(), data_2.end(), result_2.begin(), result_2.end());
 }
 
+BOOST_FIXTURE_TEST_CASE(multi_threaded, FileFixture) {
+  // Use rows of several chunks, so that the chunks are predicted and
+  // deflated in parallel.
+  constexpr size_t kNBaselines = 11;
+  constexpr size_t kNRows = 30;
+  constexpr size_t kNChannels = 4000;
+  const auto value = [](size_t row, size_t baseline, size_t channel) {
+    return std::complex<float>(row * 0.5f + channel * 0.25f,
+                               baseline - channel * 0.125f);
+  };
+  const auto write = [&](const std::string& filename, size_t n_threads) {
+    SiscoWriter writer(filename, 2, 9, n_threads);
+    writer.Open(std::span<std::byte>());
+    std::vector<std::complex<float>> data(kNChannels);
+    for (size_t row = 0; row != kNRows; ++row) {
+      for (size_t baseline = 0; baseline != kNBaselines; ++baseline) {
+        for (size_t channel = 0; channel != kNChannels; ++channel)
+          data[channel] = value(row, baseline, channel);
+        writer.Write(baseline, data);
+      }
+    }
+  };
+  const std::string single_filename = kFilename + "-single";
+  write(kFilename, 4);
+  write(single_filename, 1);
+
+  // The file should not depend on the number of threads
+  std::ifstream file_a(kFilename, std::ios::binary);
+  std::ifstream file_b(single_filename, std::ios::binary);
+  const std::vector<char> contents_a{std::istreambuf_iterator<char>(file_a), {}};
+  const std::vector<char> contents_b{std::istreambuf_iterator<char>(file_b), {}};
+  BOOST_CHECK(contents_a == contents_b);
+  std::filesystem::remove(single_filename);
+
+  SiscoReader reader(kFilename, 3);
+  reader.Open(std::span<std::byte>());
+  std::vector<std::complex<float>> result(kNChannels);
+  for (size_t row = 0; row != kNRows; ++row) {
+    for (size_t baseline = 0; baseline != kNBaselines; ++baseline) {
+      reader.Read(baseline, result);
+      for (size_t channel = 0; channel != kNChannels; ++channel)
+        BOOST_CHECK_EQUAL(result[channel], value(row, baseline, channel));
+    }
+  }
+  // Reading beyond the end of the file should fail
+  BOOST_CHECK_THROW(reader.Read(0, result), std::runtime_error);
+
+  // Rewinding starts again at the first row
+  for (size_t i = 0; i != 2; ++i) {
+    reader.Rewind();
+    for (size_t row = 0; row != 2; ++row) {
+      for (size_t baseline = 0; baseline != kNBaselines; ++baseline) {
+        reader.Read(baseline, result);
+        BOOST_CHECK_EQUAL(result[7], value(row, baseline, 7));
+      }
+    }
+  }
+
+  // Readers can share a pool with fewer threads
+  ThreadPool pool(2);
+  std::vector<std::unique_ptr<SiscoReader>> readers;
+  for (size_t i = 0; i != 3; ++i) {
+    readers.emplace_back(std::make_unique<SiscoReader>(kFilename, 1 + i, pool));
+    readers.back()->Open(std::span<std::byte>());
+  }
+  for (size_t row = 0; row != kNRows; ++row) {
+    for (size_t baseline = 0; baseline != kNBaselines; ++baseline) {
+      for (std::unique_ptr<SiscoReader>& shared_reader : readers) {
+        shared_reader->Read(baseline, result);
+        BOOST_CHECK_EQUAL(result[kNChannels - 1],
+                          value(row, baseline, kNChannels - 1));
+      }
+    }
+  }
+
+  // Stop reading before the end of the file
+  SiscoReader partial_reader(kFilename, 2);
+  partial_reader.Open(std::span<std::byte>());
+  partial_reader.Read(0, result);
+  BOOST_CHECK_EQUAL(result[1], value(0, 0, 1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace casacore::sisco
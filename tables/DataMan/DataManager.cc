@@ -162,6 +162,9 @@ void DataManager::setMaximumCacheSize (uInt)
 void DataManager::showCacheStatistics (ostream&) const
 {}
 
+void DataManager::addCacheStatistics (BucketCacheStatistics&) const
+{}
+
 void DataManager::setTsmOption (const TSMOption& tsmOption)
 {
   AlwaysAssert (!multiFile_p, AipsError);
@@ -173,7 +176,10 @@ void DataManager::setMultiFile (const std::shared_ptr<MultiFileBase>& mfile)
   multiFile_p = mfile;
   // Only caching can be used with a MultiFile.
   if (multiFile_p) {
-    tsmOption_p = TSMOption(TSMOption::Cache, 0, tsmOption_p.maxCacheSizeMB());
+    tsmOption_p = TSMOption(TSMOption::Cache, 0, tsmOption_p.maxCacheSizeMB(),
+                            tsmOption_p.prefetchDepth(),
+                            tsmOption_p.adaptiveWindow(),
+                            tsmOption_p.cacheBudgetMB());
   }
 }
 
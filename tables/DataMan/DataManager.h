@@ -48,6 +48,7 @@ class Table;
 class MultiFileBase;
 class Record;
 class AipsIO;
+struct BucketCacheStatistics;
 
 
 // <summary>
@@ -350,6 +351,10 @@ public:
     // Show the data manager's IO statistics. By default it does nothing.
     virtual void showCacheStatistics (std::ostream&) const;
 
+    // Add the statistics of the data manager's bucket caches to
+    // <src>stats</src> (used by TableMetrics). By default it does nothing.
+    virtual void addCacheStatistics (BucketCacheStatistics& stats) const;
+
     // Create a column in the data manager on behalf of a table column.
     // It calls makeXColumn and checks the data type.
     // <group>
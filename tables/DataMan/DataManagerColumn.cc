@@ -286,6 +286,16 @@ void DataManagerColumn::getArrayV (rownr_t, ArrayBase&)
   throw DataManError("getArrayV not implemented"
                      " for column " + columnName());
 }
+Bool DataManagerColumn::getZoneRanges (const Vector<Double>&,
+                                       const Vector<Double>&,
+                                       std::vector<std::pair<rownr_t,rownr_t>>&)
+{
+  return False;
+}
+Bool DataManagerColumn::getArrayViewV (rownr_t, ArrayBase&)
+{
+  return False;
+}
 void DataManagerColumn::putArrayV (rownr_t, const ArrayBase&)
 {
   throw DataManError("putArrayV not implemented"
@@ -32,7 +32,10 @@
 #include <casacore/tables/Tables/ColumnCache.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -335,12 +338,33 @@ public:
     virtual void putScalarColumnCellsV (const RefRows& rownrs,
 					const ArrayBase& dataPtr);
 
+    // Get the ranges of rows (inclusive and in ascending order) that can
+    // contain values in one of the given value ranges (inclusive).
+    // It can be used by a storage manager keeping the minimum and maximum
+    // per block of rows (see <linkto class=StManZoneMap>StManZoneMap</linkto>)
+    // to skip the blocks not matching a selection on a scalar column.
+    // It returns False if not possible.
+    // The default implementation returns False.
+    virtual Bool getZoneRanges (const Vector<Double>& lower,
+                                const Vector<Double>& upper,
+                                std::vector<std::pair<rownr_t,rownr_t>>& rowRanges);
+
     // Get the array value in the given row.
     // The array given in <src>data</src> has to have the correct shape
     // (which is guaranteed by the ArrayColumn get function).
     // The default implementation throws an "invalid operation" exception.
     virtual void getArrayV (rownr_t rownr, ArrayBase& dataPtr);
 
+    // Try to make the array given in <src>dataPtr</src> reference the
+    // array value in the given row directly in the storage manager's
+    // memory (e.g., a memory-mapped file), thus without copying it.
+    // The array must be read-only. Its storage has to keep the referenced
+    // memory alive, so it stays valid after the table is closed, resynced
+    // or reopened for read/write.
+    // It returns False if not possible; the array is unchanged then.
+    // The default implementation returns False.
+    virtual Bool getArrayViewV (rownr_t rownr, ArrayBase& dataPtr);
+
     // Put the array value into the given row.
     // The array given in <src>data</src> has to have the correct shape
     // (which is guaranteed by the ArrayColumn put function).
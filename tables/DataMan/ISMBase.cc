@@ -30,6 +30,7 @@
 #include <casacore/tables/DataMan/ISMIndColumn.h>
 #include <casacore/tables/DataMan/ISMIndex.h>
 #include <casacore/tables/DataMan/StArrayFile.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Utilities/ValType.h>
@@ -203,6 +204,13 @@ void ISMBase::showCacheStatistics (ostream& os) const
     }
 }
 
+void ISMBase::addCacheStatistics (BucketCacheStatistics& stats) const
+{
+    if (cache_p != 0) {
+	stats += cache_p->statistics();
+    }
+}
+
 void ISMBase::showIndexStatistics (ostream& os)
 {
     if (index_p != 0) {
@@ -474,6 +482,9 @@ void ISMBase::removeRow64 (rownr_t rownr)
     uInt nrcol = ncolumn();
     for (i=0; i<nrcol; i++) {
 	colSet_p[i]->remove (bucketRownr, bucket, bucketNrrow, nrrow_p-1);
+	if (colSet_p[i]->getZoneMap()) {
+	    colSet_p[i]->getZoneMap()->removeRow (rownr);
+	}
     }
     // Remove the row from the index.
     Int emptyBucket = getIndex().removeRow (rownr);
@@ -575,6 +586,7 @@ Bool ISMBase::flush (AipsIO& ios, Bool fsync)
 	changed = True;
 	dataChanged_p = False;
     }
+    writeZoneMaps();
     ios.putstart ("ISM", version_p);
     ios << dataManName_p;
     ios.putend();
@@ -597,6 +609,7 @@ rownr_t ISMBase::resync64 (rownr_t nrrow)
     if (iosfile_p != 0) {
         iosfile_p->resync();
     }
+    readZoneMaps();
     return nrrow_p;
 }
 
@@ -631,9 +644,51 @@ rownr_t ISMBase::open64 (rownr_t tabNrrow, AipsIO& ios)
     for (uInt i=0; i<nrcol; i++) {
 	colSet_p[i]->getFile (nrrow_p);
     }
+    readZoneMaps();
     return nrrow_p;
 }
 
+void ISMBase::readZoneMaps()
+{
+    std::map<String,std::unique_ptr<StManZoneMap>> maps =
+      StManZoneMap::readFile (fileName() + 'z', fileName(), nrrow_p,
+                                zoneStamp_p);
+    for (uInt i=0; i<ncolumn(); i++) {
+	ISMColumn* colp = colSet_p[i];
+	auto iter = maps.find (colp->columnName());
+	if (iter != maps.end()  &&
+	    iter->second->dataType() == colp->dataType()) {
+	    colp->setZoneMap (std::move(iter->second));
+	} else {
+	    colp->setZoneMap (std::unique_ptr<StManZoneMap>());
+	}
+    }
+}
+
+void ISMBase::writeZoneMaps()
+{
+    //# The file cannot be part of a MultiFile.
+    if (multiFile()  ||  !table().isWritable()) {
+	return;
+    }
+    std::vector<std::pair<String,StManZoneMap*>> maps;
+    Bool changed = False;
+    for (uInt i=0; i<ncolumn(); i++) {
+	StManZoneMap* zoneMap = colSet_p[i]->getZoneMap();
+	if (zoneMap) {
+	    maps.push_back (std::make_pair (colSet_p[i]->columnName(), zoneMap));
+	    changed = changed || zoneMap->isChanged();
+	}
+    }
+    //# The maps also have to be written if only the data file has changed,
+    //# otherwise its stamp in the file does not match anymore.
+    if (changed  ||  (!maps.empty()  &&
+		      StManZoneMap::fileStamp(fileName()) != zoneStamp_p)) {
+	zoneStamp_p = StManZoneMap::writeFile (fileName() + 'z', fileName(),
+					       nrrow_p, maps);
+    }
+}
+
 StManArrayFile* ISMBase::openArrayFile (ByteIO::OpenOption opt)
 {
     if (iosfile_p == 0) {
@@ -665,6 +720,7 @@ void ISMBase::deleteManager()
       delete file_p;
       file_p = 0;
     }
+    DOos::remove (fileName() + 'z', False, False);
 }
 
 
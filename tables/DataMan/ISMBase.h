@@ -30,6 +30,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/iosfwd.h>
 
@@ -154,6 +155,9 @@ public:
     // Show the statistics of all caches used.
     virtual void showCacheStatistics (ostream& os) const;
 
+    // Add the statistics of the bucket cache.
+    virtual void addCacheStatistics (BucketCacheStatistics& stats) const;
+
     // Show the index statistics.
     void showIndexStatistics (ostream& os);
 
@@ -278,6 +282,12 @@ private:
     // It is used by create and open.
     void init();
 
+    // Read the zone maps of the columns from their file (if valid).
+    void readZoneMaps();
+
+    // Write the zone maps of the columns into their file if changed.
+    void writeZoneMaps();
+
     // Add rows to the storage manager.
     // Per column it extends the interval for which the last value written
     // is valid.
@@ -379,6 +389,8 @@ private:
     uInt rownrSize_p;
     // A temporary read/write buffer (also for other classes).
     char* tempBuffer_p;
+    // The stamp of the data file stored in the zone map file.
+    StManZoneMap::FileStamp zoneStamp_p;
 };
 
 
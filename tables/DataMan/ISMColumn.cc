@@ -126,6 +126,28 @@ void ISMColumn::addRow (rownr_t, rownr_t)
     //# Nothing to do.
 }
 
+StManZoneMap* ISMColumn::zoneMap()
+{
+    //# ISM buckets contain a varying number of rows, so zones of a fixed
+    //# number of rows are used.
+    if (!zoneMap_p  &&  StManZoneMap::canHandle (dataType())) {
+	zoneMap_p.reset (new StManZoneMap (dataType(), 4096));
+    }
+    return zoneMap_p.get();
+}
+
+Bool ISMColumn::getZoneRanges (const Vector<Double>& lower,
+                               const Vector<Double>& upper,
+                               std::vector<std::pair<rownr_t,rownr_t>>& rowRanges)
+{
+    if (! zoneMap()) {
+	return False;
+    }
+    zoneMap_p->getRanges (*this, stmanPtr_p->nrow(), lower, upper,
+			  rowRanges);
+    return True;
+}
+
 void ISMColumn::remove (rownr_t bucketRownr, ISMBucket* bucket, rownr_t bucketNrrow,
 			rownr_t newNrrow)
 {
@@ -436,34 +458,42 @@ void ISMColumn::putBool (rownr_t rownr, const Bool* value)
 void ISMColumn::putuChar (rownr_t rownr, const uChar* value)
 {
     putValue (rownr, value);
+    zoneMap()->put (rownr, value);
 }
 void ISMColumn::putShort (rownr_t rownr, const Short* value)
 {
     putValue (rownr, value);
+    zoneMap()->put (rownr, value);
 }
 void ISMColumn::putuShort (rownr_t rownr, const uShort* value)
 {
     putValue (rownr, value);
+    zoneMap()->put (rownr, value);
 }
 void ISMColumn::putInt (rownr_t rownr, const Int* value)
 {
     putValue (rownr, value);
+    zoneMap()->put (rownr, value);
 }
 void ISMColumn::putuInt (rownr_t rownr, const uInt* value)
 {
     putValue (rownr, value);
+    zoneMap()->put (rownr, value);
 }
 void ISMColumn::putInt64 (rownr_t rownr, const Int64* value)
 {
     putValue (rownr, value);
+    zoneMap()->put (rownr, value);
 }
 void ISMColumn::putfloat (rownr_t rownr, const float* value)
 {
     putValue (rownr, value);
+    zoneMap()->put (rownr, value);
 }
 void ISMColumn::putdouble (rownr_t rownr, const double* value)
 {
     putValue (rownr, value);
+    zoneMap()->put (rownr, value);
 }
 void ISMColumn::putComplex (rownr_t rownr, const Complex* value)
 {
@@ -533,57 +563,73 @@ void ISMColumn::putScaCol (const Vector<Bool>& dataPtr)
 void ISMColumn::putScaCol (const Vector<uChar>& dataPtr)
 {
     rownr_t nrrow = dataPtr.nelements();
+    StManZoneMap* zoneMap = this->zoneMap();
     for (rownr_t i=0; i<nrrow; i++) {
 	putValue (i, &(dataPtr(i)));
+	zoneMap->put (i, &(dataPtr(i)));
     }
 }
 void ISMColumn::putScaCol (const Vector<Short>& dataPtr)
 {
     rownr_t nrrow = dataPtr.nelements();
+    StManZoneMap* zoneMap = this->zoneMap();
     for (rownr_t i=0; i<nrrow; i++) {
 	putValue (i, &(dataPtr(i)));
+	zoneMap->put (i, &(dataPtr(i)));
     }
 }
 void ISMColumn::putScaCol (const Vector<uShort>& dataPtr)
 {
     rownr_t nrrow = dataPtr.nelements();
+    StManZoneMap* zoneMap = this->zoneMap();
     for (rownr_t i=0; i<nrrow; i++) {
 	putValue (i, &(dataPtr(i)));
+	zoneMap->put (i, &(dataPtr(i)));
     }
 }
 void ISMColumn::putScaCol (const Vector<Int>& dataPtr)
 {
     rownr_t nrrow = dataPtr.nelements();
+    StManZoneMap* zoneMap = this->zoneMap();
     for (rownr_t i=0; i<nrrow; i++) {
 	putValue (i, &(dataPtr(i)));
+	zoneMap->put (i, &(dataPtr(i)));
     }
 }
 void ISMColumn::putScaCol (const Vector<uInt>& dataPtr)
 {
     rownr_t nrrow = dataPtr.nelements();
+    StManZoneMap* zoneMap = this->zoneMap();
     for (rownr_t i=0; i<nrrow; i++) {
 	putValue (i, &(dataPtr(i)));
+	zoneMap->put (i, &(dataPtr(i)));
     }
 }
 void ISMColumn::putScaCol (const Vector<Int64>& dataPtr)
 {
     rownr_t nrrow = dataPtr.nelements();
+    StManZoneMap* zoneMap = this->zoneMap();
     for (rownr_t i=0; i<nrrow; i++) {
 	putValue (i, &(dataPtr(i)));
+	zoneMap->put (i, &(dataPtr(i)));
     }
 }
 void ISMColumn::putScaCol (const Vector<float>& dataPtr)
 {
     rownr_t nrrow = dataPtr.nelements();
+    StManZoneMap* zoneMap = this->zoneMap();
     for (rownr_t i=0; i<nrrow; i++) {
 	putValue (i, &(dataPtr(i)));
+	zoneMap->put (i, &(dataPtr(i)));
     }
 }
 void ISMColumn::putScaCol (const Vector<double>& dataPtr)
 {
     rownr_t nrrow = dataPtr.nelements();
+    StManZoneMap* zoneMap = this->zoneMap();
     for (rownr_t i=0; i<nrrow; i++) {
 	putValue (i, &(dataPtr(i)));
+	zoneMap->put (i, &(dataPtr(i)));
     }
 }
 void ISMColumn::putScaCol (const Vector<Complex>& dataPtr)
@@ -31,6 +31,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/StManColumnBase.h>
 #include <casacore/tables/DataMan/ISMBase.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Utilities/Compare.h>
@@ -217,6 +218,21 @@ public:
     void remove (rownr_t bucketRownr, ISMBucket* bucket, rownr_t bucketNrrow,
 		 rownr_t newNrrow);
 
+    // Get the ranges of rows that can contain values in the given value
+    // ranges using the minimum and maximum per block of rows.
+    // It returns False if the data type is not an integer or real type.
+    virtual Bool getZoneRanges (const Vector<Double>& lower,
+                                const Vector<Double>& upper,
+                                std::vector<std::pair<rownr_t,rownr_t>>& rowRanges);
+
+    // Get the zone map (a null pointer if not created yet).
+    StManZoneMap* getZoneMap()
+      { return zoneMap_p.get(); }
+
+    // Set the zone map (as read from its file).
+    void setZoneMap (std::unique_ptr<StManZoneMap> zoneMap)
+      { zoneMap_p = std::move(zoneMap); }
+
     // Get the function needed to read/write a uInt and rownr from/to
     // external format. This is used by other classes to read the length
     // of a variable data value.
@@ -285,6 +301,8 @@ protected:
     Conversion::ValueFunction* readFunc_p;
     // Pointer to a compare function.
     ObjCompareFunc*   compareFunc_p;
+    // The minimum and maximum value per block of rows (for numeric scalars).
+    std::unique_ptr<StManZoneMap> zoneMap_p;
 
 
 private:
@@ -295,6 +313,9 @@ private:
     // Clear the object (used by destructor and init).
     void clear();
 
+    // Get the zone map. It is created if not done yet.
+    StManZoneMap* zoneMap();
+
     // Put the value in all buckets from the given row on.
     void putFromRow (rownr_t rownr, const char* data, uInt lenData);
 
@@ -146,6 +146,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //          the cache size using class
 //          <linkto class=ROIncrementalStManAccessor>
 //          ROIncrementalStManAccessor</linkto>.
+// <li> For scalar columns with an integer or real data type the minimum
+//      and maximum value per block of rows are kept (see
+//      <linkto class=StManZoneMap>StManZoneMap</linkto>), so a selection
+//      on a range of such a column only evaluates the blocks that can
+//      contain matching values.
 // </ul>
 //
 // <note>This class contains many public functions which are only used
@@ -31,6 +31,7 @@
 #include <casacore/tables/DataMan/SSMIndex.h>
 #include <casacore/tables/DataMan/SSMStringHandler.h>
 #include <casacore/tables/DataMan/StArrayFile.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Containers/BlockIO.h>
 #include <casacore/casa/Containers/Record.h>
@@ -38,6 +39,7 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/IO/BucketCache.h>
 #include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/IO/FiledesIO.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/IO/MemoryIO.h>
 #include <casacore/casa/IO/CanonicalIO.h>
@@ -45,13 +47,36 @@
 #include <casacore/casa/IO/FilebufIO.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/DOos.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/tables/DataMan/DataManError.h>
 #include <casacore/casa/iostream.h>
+#include <sys/mman.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Map the entire data file for the array views.
+// The mapping is readonly, so writing into a view (which must not be done)
+// gives a segmentation fault instead of silently changing the view.
+// The file descriptor is not needed anymore once mapped.
+static std::shared_ptr<char> mapDataFile (const String& name, Int64& size)
+{
+  int fd = FiledesIO::open (name.chars());
+  size = FiledesIO(fd, name).length();
+  if (size <= 0) {
+    FiledesIO::close (fd);
+    return std::shared_ptr<char>();
+  }
+  void* ptr = ::mmap (0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  FiledesIO::close (fd);
+  if (ptr == MAP_FAILED) {
+    throw DataManError ("SSM: mmap of " + name + " failed");
+  }
+  return std::shared_ptr<char> (static_cast<char*>(ptr),
+                                [size](char* p) { ::munmap (p, size); });
+}
+
 SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
 : DataManager          (),
   itsDataManName       ("SSM"),
@@ -59,6 +84,8 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsNrRows            (0),
   itsCache             (0),
   itsFile              (0),
+  itsReadCache         (0),
+  itsMappedSize        (0),
   itsStringHandler     (0),
   itsPersCacheSize     (std::max(aCacheSize,uInt(2))),
   itsCacheSize         (0),
@@ -91,6 +118,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsNrRows            (0),
   itsCache             (0),
   itsFile              (0),
+  itsReadCache         (0),
+  itsMappedSize        (0),
   itsStringHandler     (0),
   itsPersCacheSize     (std::max(aCacheSize,uInt(2))),
   itsCacheSize         (0),
@@ -123,6 +152,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsNrRows            (0),
   itsCache             (0),
   itsFile              (0),
+  itsReadCache         (0),
+  itsMappedSize        (0),
   itsStringHandler     (0),
   itsPersCacheSize     (2),
   itsCacheSize         (0),
@@ -164,6 +195,8 @@ SSMBase::SSMBase (const SSMBase& that)
   itsNrRows            (0),
   itsCache             (0),
   itsFile              (0),
+  itsReadCache         (0),
+  itsMappedSize        (0),
   itsStringHandler     (0),
   itsPersCacheSize     (that.itsPersCacheSize),
   itsCacheSize         (0),
@@ -188,6 +221,7 @@ SSMBase::~SSMBase()
   for (uInt i=0; i<itsPtrIndex.nelements(); i++) {
     delete itsPtrIndex[i];
   }
+  delete itsReadCache;
   delete itsCache;
   delete itsFile;
   delete itsIosFile;
@@ -273,6 +307,13 @@ void SSMBase::showCacheStatistics (ostream& anOs) const
   }
 }
 
+void SSMBase::addCacheStatistics (BucketCacheStatistics& stats) const
+{
+  if (itsCache != 0) {
+    stats += itsCache->statistics();
+  }
+}
+
 void SSMBase::showIndexStatistics (ostream & anOs) const
 {
   uInt aNrIdx=itsPtrIndex.nelements();
@@ -371,6 +412,18 @@ void SSMBase::makeCache()
 				SSMBase::deleteCallBack);
     itsCache->resync (itsNrBuckets, itsFreeBucketsNr, 
 		      itsFirstFreeBucket);
+    // Map the data buckets if the file is mapped.
+    // Otherwise a readonly table uses a thread-safe cache to read them.
+    if (itsFile->mappedFile() != 0) {
+      itsMapped = mapDataFile (fileName(), itsMappedSize);
+    } else if (!table().isWritable()) {
+      itsReadCache = new ConcurrentBucketCache (itsFile, 512, itsBucketSize,
+                                                itsNrBuckets, itsCacheSize,
+                                                this,
+                                                SSMBase::readCallBack,
+                                                SSMBase::writeCallBack,
+                                                SSMBase::deleteCallBack);
+    }
 
     if (forceFill) {
       readIndexBuckets();
@@ -378,8 +431,9 @@ void SSMBase::makeCache()
   }
 }
 
-uInt SSMBase::getRowsPerBucket(uInt aColumn) const
+uInt SSMBase::getRowsPerBucket(uInt aColumn)
 {
+  getCache();
   return itsPtrIndex[itsColIndexMap[aColumn]]->getRowsPerBucket();
 }
 
@@ -910,10 +964,34 @@ char* SSMBase::find(rownr_t aRowNr,     uInt aColNr,
   return aPtr + itsColumnOffset[aColNr];
 }
 
+const char* SSMBase::findRead (rownr_t aRowNr,     uInt aColNr,
+                               rownr_t& aStartRow, rownr_t& anEndRow,
+                               const String& colName,
+                               ConcurrentBucketCache::Pin& aPin)
+{
+  // Make sure that cache is available and filled.
+  getCache();
+  if (itsMapped == 0  &&  itsReadCache == 0) {
+    return find (aRowNr, aColNr, aStartRow, anEndRow, colName);
+  }
+  SSMIndex* anIndexPtr = itsPtrIndex[itsColIndexMap[aColNr]];
+  uInt aBucketNr;
+  anIndexPtr->find(aRowNr,aBucketNr,aStartRow,anEndRow, colName);
+  if (itsMapped) {
+    return itsMapped.get() + 512 + Int64(aBucketNr) * itsBucketSize
+           + itsColumnOffset[aColNr];
+  }
+  aPin.pin (*itsReadCache, aBucketNr);
+  return aPin.data() + itsColumnOffset[aColNr];
+}
+
 
 
 void SSMBase::recreate()
 {
+  itsMapped.reset();
+  delete itsReadCache;
+  itsReadCache = 0;
   delete itsCache;
   itsCache = 0;
   delete itsFile;
@@ -970,6 +1048,7 @@ Bool SSMBase::flush (AipsIO& ios, Bool doFsync)
   if (itsIosFile) {
     itsIosFile->flush(doFsync);
   }
+  writeZoneMaps();
   ios.putstart ("SSM", 2);
   ios << itsDataManName;
   putBlock (ios, itsColumnOffset, itsColumnOffset.nelements());
@@ -984,10 +1063,20 @@ rownr_t SSMBase::resync64 (rownr_t aNrRows)
   if (itsPtrIndex.nelements() != 0) {
     readHeader();
   }
+  // The mapping has a fixed size, so use the cache if the file has grown.
+  // Note that rewritten buckets are normally seen through the mapping.
+  // Views still referencing the old mapping keep it alive.
+  if (itsMapped  &&
+      itsMappedSize < 512 + Int64(itsNrBuckets) * itsBucketSize) {
+    itsMapped.reset();
+  }
   if (itsCache != 0) {
     itsCache->resync (itsNrBuckets, itsFreeBucketsNr, 
 		      itsFirstFreeBucket);
   }
+  if (itsReadCache != 0) {
+    itsReadCache->resync (itsNrBuckets);
+  }
   if (itsPtrIndex.nelements() != 0) {
     readIndexBuckets();
   }  
@@ -1002,6 +1091,7 @@ rownr_t SSMBase::resync64 (rownr_t aNrRows)
   for (uInt i=0; i<aNrCol; i++) {
     itsPtrColumn[i]->resync (itsNrRows);
   }
+  readZoneMaps();
   return itsNrRows;
 }
 
@@ -1022,8 +1112,15 @@ rownr_t SSMBase::open64 (rownr_t aRowNr, AipsIO& ios)
   getBlock (ios,itsColIndexMap);
   ios.getend();
   
+  // The data file of a readonly table can be memory-mapped, which makes
+  // it possible to read the data without copying.
+  // It cannot be done for a MultiFile.
+  Bool mapFile = False;
+  if (!table().isWritable()  &&  !multiFile()) {
+    AipsrcValue<Bool>::find (mapFile, "table.ssm.mmap", False);
+  }
   itsFile = new BucketFile (fileName(), table().isWritable(),
-                            0, False, multiFile());
+                            0, mapFile, multiFile());
   AlwaysAssert (itsFile != 0, AipsError);
 
   // Let the column object initialize themselves (if needed)
@@ -1031,9 +1128,56 @@ rownr_t SSMBase::open64 (rownr_t aRowNr, AipsIO& ios)
   for (uInt i=0; i<aNrCol; i++) {
     itsPtrColumn[i]->getFile(itsNrRows);
   }
+  readZoneMaps();
+  // Create the caches of a readonly table immediately, so its columns
+  // can be read by multiple threads without further preparation.
+  if (!table().isWritable()) {
+    getCache();
+  }
   return itsNrRows;
 }
 
+void SSMBase::readZoneMaps()
+{
+  std::map<String,std::unique_ptr<StManZoneMap>> maps =
+    StManZoneMap::readFile (fileName() + 'z', fileName(), itsNrRows,
+                              itsZoneStamp);
+  for (uInt i=0; i<ncolumn(); i++) {
+    SSMColumn* aColumn = itsPtrColumn[i];
+    auto iter = maps.find (aColumn->columnName());
+    if (iter != maps.end()  &&
+        iter->second->dataType() == aColumn->dataType()) {
+      aColumn->setZoneMap (std::move(iter->second));
+    } else {
+      aColumn->setZoneMap (std::unique_ptr<StManZoneMap>());
+    }
+  }
+}
+
+void SSMBase::writeZoneMaps()
+{
+  // The file cannot be part of a MultiFile.
+  if (multiFile()  ||  !table().isWritable()) {
+    return;
+  }
+  std::vector<std::pair<String,StManZoneMap*>> maps;
+  Bool changed = False;
+  for (uInt i=0; i<ncolumn(); i++) {
+    StManZoneMap* aMap = itsPtrColumn[i]->getZoneMap();
+    if (aMap) {
+      maps.push_back (std::make_pair (itsPtrColumn[i]->columnName(), aMap));
+      changed = changed || aMap->isChanged();
+    }
+  }
+  // The maps also have to be written if only the data file has changed,
+  // otherwise its stamp in the file does not match anymore.
+  if (changed  ||  (!maps.empty()  &&
+                    StManZoneMap::fileStamp(fileName()) != itsZoneStamp)) {
+    itsZoneStamp = StManZoneMap::writeFile (fileName() + 'z', fileName(),
+                                            itsNrRows, maps);
+  }
+}
+
 StManArrayFile* SSMBase::openArrayFile (ByteIO::OpenOption anOpt)
 {
   if (itsIosFile == 0) {
@@ -1045,6 +1189,10 @@ StManArrayFile* SSMBase::openArrayFile (ByteIO::OpenOption anOpt)
 
 void SSMBase::reopenRW()
 {
+  // Data can be changed, so it has to be accessed via the cache.
+  itsMapped.reset();
+  delete itsReadCache;
+  itsReadCache = 0;
   if (itsFile != 0) {
     itsFile->setRW();
   }
@@ -1061,11 +1209,15 @@ void SSMBase::deleteManager()
   if (itsCache != 0) {
     itsCache->clear (0, False);
   }
+  itsMapped.reset();
+  delete itsReadCache;
+  itsReadCache = 0;
   if (itsFile != 0) {
     itsFile->remove();
     delete itsFile;
     itsFile = 0;
   }
+  DOos::remove (fileName() + 'z', False, False);
 }
 
 void SSMBase::init()
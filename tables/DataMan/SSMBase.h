@@ -30,7 +30,10 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/IO/ConcurrentBucketCache.h>
+#include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -217,6 +220,9 @@ public:
   // Show the statistics of all caches used.
   virtual void showCacheStatistics (ostream& anOs) const;
 
+  // Add the statistics of the bucket cache.
+  virtual void addCacheStatistics (BucketCacheStatistics& stats) const;
+
   // Show statistics of all indices used.
   void showIndexStatistics (ostream & anOs) const;
 
@@ -269,6 +275,30 @@ public:
 	      rownr_t& aStartRow, rownr_t& anEndRow,
               const String& colName);
 
+  // Like <src>find</src>, but only to read the data.
+  // If the data file is memory-mapped, it returns a pointer into the
+  // mapped file. Otherwise, if the table is readonly, the bucket is pinned
+  // in the concurrent read cache and the pointer stays valid as long as
+  // <src>aPin</src> is alive. This makes it possible to read columns of a
+  // readonly table in multiple threads (see
+  // <linkto class=StandardStMan>StandardStMan</linkto>).
+  // Otherwise it is the same as <src>find</src>.
+  const char* findRead (rownr_t aRowNr,     uInt aColNr,
+                        rownr_t& aStartRow, rownr_t& anEndRow,
+                        const String& colName,
+                        ConcurrentBucketCache::Pin& aPin);
+
+  // Is the data file memory-mapped? If so, the pointers returned by
+  // <src>findRead</src> stay valid as long as the mapping is alive.
+  Bool isMapped() const
+    { return bool(itsMapped); }
+
+  // Get the memory mapping of the data file (a null pointer if not mapped).
+  // An array view referencing the mapped data has to hold it, so the
+  // mapping stays alive after the table is closed, resynced or reopened.
+  std::shared_ptr<const void> mapping() const
+    { return itsMapped; }
+
   // Add a new bucket and get its bucket number.
   uInt getNewBucket();
 
@@ -279,7 +309,8 @@ public:
   void removeBucket (uInt aBucketNr);
 
   // Get rows per bucket for the given column.
-  uInt getRowsPerBucket (uInt aColumn) const;
+  // The index is read if not done yet.
+  uInt getRowsPerBucket (uInt aColumn);
 
   // Return a pointer to the (one and only) StringHandler object.
   SSMStringHandler* getStringHandler();
@@ -389,6 +420,12 @@ private:
   // Write the header and the indices.
   void writeIndex();
 
+  // Read the zone maps of the columns from their file (if valid).
+  void readZoneMaps();
+
+  // Write the zone maps of the columns into their file if changed.
+  void writeZoneMaps();
+
 
   //# Declare member variables.
   // Name of data manager.
@@ -414,6 +451,16 @@ private:
   
   // The file containing all data.
   BucketFile*  itsFile;
+
+  // The thread-safe cache to read the data buckets of a readonly table
+  // if not memory-mapped.
+  ConcurrentBucketCache* itsReadCache;
+
+  // The memory-mapped data file (only for a readonly table if
+  // aipsrc variable table.ssm.mmap is true) and its size.
+  // The mapping is shared with the array views referencing it.
+  std::shared_ptr<char> itsMapped;
+  Int64                 itsMappedSize;
   
   // String handler class
   SSMStringHandler* itsStringHandler;
@@ -458,6 +505,9 @@ private:
   
   // Has the data changed since the last flush?
   Bool isDataChanged;
+
+  // The stamp of the data file stored in the zone map file.
+  StManZoneMap::FileStamp itsZoneStamp;
 };
 
 
@@ -35,6 +35,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -117,6 +118,10 @@ void SSMColumn::deleteRow(rownr_t aRowNr)
   rownr_t anERow;
   int aDT = dataType();
 
+  if (itsZoneMap) {
+    itsZoneMap->removeRow (aRowNr);
+  }
+
   if (aDT == TpString  &&  itsMaxLen == 0) {
     Int buf[3];
     getRowValue(buf, aRowNr);
@@ -257,8 +262,9 @@ void SSMColumn::getString (rownr_t aRowNr, String* aValue)
     char* sp = const_cast<char*>(aValue->chars());
     rownr_t aStartRow;
     rownr_t anEndRow;
-    char* buf = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
-                                 columnName());
+    ConcurrentBucketCache::Pin aPin;
+    const char* buf = itsSSMPtr->findRead (aRowNr, itsColNr, aStartRow,
+                                           anEndRow, columnName(), aPin);
     itsReadFunc (sp, buf+(aRowNr-aStartRow)*itsExternalSizeBytes,
 		 itsNrCopy);
     // Append a trailing zero (in case needed).
@@ -310,9 +316,10 @@ void SSMColumn::getValue(rownr_t aRowNr)
   if (aRowNr < columnCache().start()  ||  aRowNr > columnCache().end()) {
     rownr_t aStartRow;
     rownr_t anEndRow;
-    char*   aValue;
-    aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
-                              columnName());
+    const char* aValue;
+    ConcurrentBucketCache::Pin aPin;
+    aValue = itsSSMPtr->findRead (aRowNr, itsColNr, aStartRow, anEndRow,
+                                  columnName(), aPin);
     itsReadFunc (getDataPtr(), aValue, (anEndRow-aStartRow+1) * itsNrCopy);
     columnCache().set (aStartRow, anEndRow, getDataPtr());
   }
@@ -341,6 +348,7 @@ void SSMColumn::putBool (rownr_t aRowNr, const Bool* aValue)
 void SSMColumn::putuChar (rownr_t aRowNr, const uChar* aValue)
 {
   putValue(aRowNr,aValue);
+  zoneMap()->put (aRowNr, aValue);
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uChar*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -349,6 +357,7 @@ void SSMColumn::putuChar (rownr_t aRowNr, const uChar* aValue)
 void SSMColumn::putShort (rownr_t aRowNr, const Short* aValue)
 {
   putValue(aRowNr,aValue);
+  zoneMap()->put (aRowNr, aValue);
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Short*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -357,6 +366,7 @@ void SSMColumn::putShort (rownr_t aRowNr, const Short* aValue)
 void SSMColumn::putuShort (rownr_t aRowNr, const uShort* aValue)
 {
   putValue(aRowNr,aValue);
+  zoneMap()->put (aRowNr, aValue);
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uShort*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -365,6 +375,7 @@ void SSMColumn::putuShort (rownr_t aRowNr, const uShort* aValue)
 void SSMColumn::putInt (rownr_t aRowNr, const Int* aValue)
 {
   putValue(aRowNr,aValue);
+  zoneMap()->put (aRowNr, aValue);
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Int*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -373,6 +384,7 @@ void SSMColumn::putInt (rownr_t aRowNr, const Int* aValue)
 void SSMColumn::putuInt (rownr_t aRowNr, const uInt* aValue)
 {
   putValue(aRowNr,aValue);
+  zoneMap()->put (aRowNr, aValue);
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uInt*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -381,6 +393,7 @@ void SSMColumn::putuInt (rownr_t aRowNr, const uInt* aValue)
 void SSMColumn::putInt64 (rownr_t aRowNr, const Int64* aValue)
 {
   putValue(aRowNr,aValue);
+  zoneMap()->put (aRowNr, aValue);
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Int64*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -389,6 +402,7 @@ void SSMColumn::putInt64 (rownr_t aRowNr, const Int64* aValue)
 void SSMColumn::putfloat (rownr_t aRowNr, const float* aValue)
 {
   putValue(aRowNr,aValue);
+  zoneMap()->put (aRowNr, aValue);
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<float*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -397,6 +411,7 @@ void SSMColumn::putfloat (rownr_t aRowNr, const float* aValue)
 void SSMColumn::putdouble (rownr_t aRowNr, const double* aValue)
 {
   putValue(aRowNr,aValue);
+  zoneMap()->put (aRowNr, aValue);
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<double*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -499,28 +514,38 @@ void SSMColumn::getScalarColumnV (ArrayBase& aDataPtr)
   } else {
     Bool deleteIt;
     void* anArray = aDataPtr.getVStorage(deleteIt);
-    getColumnValue(anArray, aDataPtr.nelements());
+    getColumnValue(anArray, 0, aDataPtr.nelements());
     aDataPtr.putVStorage(anArray, deleteIt);
   }
 }
 
-void SSMColumn::getColumnValue(void* anArray,rownr_t aNrRows)
+void SSMColumn::getColumnValue(void* anArray, rownr_t aRowNr,
+                               rownr_t aNrRows)
 {
   char*   aDataPtr = static_cast<char*>(anArray);
-  rownr_t aRowNr=0;
-  rownr_t rowsToDo = aNrRows;
+  uInt64  aLocalSize = localValueSize();
   
-  while (rowsToDo > 0) {
+  while (aNrRows > 0) {
     rownr_t aStartRow;
     rownr_t anEndRow;
-    char*   aValue;
-    aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
-                              columnName());
-    aRowNr = anEndRow+1;
-    rownr_t aNr = anEndRow-aStartRow+1;
-    rowsToDo -= aNr;
-    itsReadFunc (aDataPtr, aValue, aNr * itsNrCopy);
-    aDataPtr += aNr * itsLocalSize;
+    const char* aValue;
+    ConcurrentBucketCache::Pin aPin;
+    aValue = itsSSMPtr->findRead (aRowNr, itsColNr, aStartRow, anEndRow,
+                                  columnName(), aPin);
+    rownr_t aNr = std::min (anEndRow-aRowNr+1, aNrRows);
+    uInt64 anOff = aRowNr-aStartRow;
+    if (dtype() == TpBool) {
+      // Bools are stored as bits, so the start can be inside a byte.
+      anOff *= itsNrCopy;
+      Conversion::bitToBool (reinterpret_cast<Bool*>(aDataPtr),
+                             aValue + anOff/8, anOff%8, aNr * itsNrCopy);
+    } else {
+      itsReadFunc (aDataPtr, aValue + anOff*itsExternalSizeBytes,
+                   aNr * itsNrCopy);
+    }
+    aDataPtr += aNr * aLocalSize;
+    aRowNr   += aNr;
+    aNrRows  -= aNr;
   }
 }
 
@@ -534,28 +559,41 @@ void SSMColumn::putScalarColumnV (const ArrayBase& aDataPtr)
   } else {
     Bool deleteIt;
     const void* anArray = aDataPtr.getVStorage(deleteIt);
-    putColumnValue (anArray, aDataPtr.nelements());
+    putColumnValue (anArray, 0, aDataPtr.nelements());
+    if (zoneMap()) {
+      zoneMap()->put (0, aDataPtr.nelements(), anArray);
+    }
     aDataPtr.freeVStorage(anArray, deleteIt);
   }
 }
 
-void SSMColumn::putColumnValue(const void* anArray,rownr_t aNrRows)
+void SSMColumn::putColumnValue(const void* anArray, rownr_t aRowNr,
+                               rownr_t aNrRows)
 {
   const char* aDataPtr = static_cast<const char*>(anArray);
-  rownr_t aRowNr=0;
-  rownr_t rowsToDo=aNrRows;
+  uInt64      aLocalSize = localValueSize();
 
-  while (rowsToDo > 0) {
+  while (aNrRows > 0) {
     rownr_t aStartRow;
     rownr_t anEndRow;
     char*   aValPtr;
     aValPtr = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
                                columnName());
-    aRowNr = anEndRow+1;
-    rownr_t aNr = anEndRow-aStartRow+1;
-    rowsToDo -= aNr;
-    itsWriteFunc (aValPtr, aDataPtr, aNr * itsNrCopy);
-    aDataPtr += aNr * itsLocalSize;
+    rownr_t aNr = std::min (anEndRow-aRowNr+1, aNrRows);
+    uInt64 anOff = aRowNr-aStartRow;
+    if (dtype() == TpBool) {
+      // Bools are stored as bits, so the start can be inside a byte.
+      anOff *= itsNrCopy;
+      Conversion::boolToBit (aValPtr + anOff/8,
+                             reinterpret_cast<const Bool*>(aDataPtr),
+                             anOff%8, aNr * itsNrCopy);
+    } else {
+      itsWriteFunc (aValPtr + anOff*itsExternalSizeBytes, aDataPtr,
+                    aNr * itsNrCopy);
+    }
+    aDataPtr += aNr * aLocalSize;
+    aRowNr   += aNr;
+    aNrRows  -= aNr;
     itsSSMPtr->setBucketDirty();
   }
 
@@ -563,6 +601,97 @@ void SSMColumn::putColumnValue(const void* anArray,rownr_t aNrRows)
   columnCache().invalidate();
 }
 
+void SSMColumn::getColumnCellsValue (void* anArray, const RefRows& aRowNrs)
+{
+  char*  aDataPtr = static_cast<char*>(anArray);
+  uInt64 aLocalSize = localValueSize();
+  RefRowsSliceIter anIter(aRowNrs);
+  while (! anIter.pastEnd()) {
+    rownr_t aRowNr = anIter.sliceStart();
+    rownr_t anEnd  = anIter.sliceEnd();
+    rownr_t anIncr = anIter.sliceIncr();
+    if (anIncr == 1) {
+      getColumnValue (aDataPtr, aRowNr, anEnd-aRowNr+1);
+      aDataPtr += (anEnd-aRowNr+1) * aLocalSize;
+    } else {
+      for (; aRowNr<=anEnd; aRowNr+=anIncr) {
+        getColumnValue (aDataPtr, aRowNr, 1);
+        aDataPtr += aLocalSize;
+      }
+    }
+    anIter++;
+  }
+}
+
+void SSMColumn::putColumnCellsValue (const void* anArray,
+                                     const RefRows& aRowNrs)
+{
+  const char* aDataPtr = static_cast<const char*>(anArray);
+  uInt64      aLocalSize = localValueSize();
+  RefRowsSliceIter anIter(aRowNrs);
+  while (! anIter.pastEnd()) {
+    rownr_t aRowNr = anIter.sliceStart();
+    rownr_t anEnd  = anIter.sliceEnd();
+    rownr_t anIncr = anIter.sliceIncr();
+    if (anIncr == 1) {
+      putColumnValue (aDataPtr, aRowNr, anEnd-aRowNr+1);
+      aDataPtr += (anEnd-aRowNr+1) * aLocalSize;
+    } else {
+      for (; aRowNr<=anEnd; aRowNr+=anIncr) {
+        putColumnValue (aDataPtr, aRowNr, 1);
+        aDataPtr += aLocalSize;
+      }
+    }
+    anIter++;
+  }
+}
+
+void SSMColumn::getScalarColumnCellsV (const RefRows& aRowNrs,
+                                       ArrayBase& aDataPtr)
+{
+  if (dtype() == TpString) {
+    StManColumnBase::getScalarColumnCellsV (aRowNrs, aDataPtr);
+  } else {
+    Bool deleteIt;
+    void* anArray = aDataPtr.getVStorage(deleteIt);
+    getColumnCellsValue (anArray, aRowNrs);
+    aDataPtr.putVStorage(anArray, deleteIt);
+  }
+}
+
+void SSMColumn::putScalarColumnCellsV (const RefRows& aRowNrs,
+                                       const ArrayBase& aDataPtr)
+{
+  if (dtype() == TpString) {
+    StManColumnBase::putScalarColumnCellsV (aRowNrs, aDataPtr);
+  } else {
+    Bool deleteIt;
+    const void* anArray = aDataPtr.getVStorage(deleteIt);
+    putColumnCellsValue (anArray, aRowNrs);
+    if (zoneMap()) {
+      // Update the zone map per slice of rows.
+      const char* aValPtr = static_cast<const char*>(anArray);
+      RefRowsSliceIter anIter(aRowNrs);
+      while (! anIter.pastEnd()) {
+        rownr_t aRowNr = anIter.sliceStart();
+        rownr_t anEnd  = anIter.sliceEnd();
+        rownr_t anIncr = anIter.sliceIncr();
+        if (anIncr == 1) {
+          zoneMap()->put (aRowNr, anEnd-aRowNr+1, aValPtr);
+          aValPtr += (anEnd-aRowNr+1) * itsLocalSize;
+        } else {
+          for (; aRowNr<=anEnd; aRowNr+=anIncr) {
+            zoneMap()->put (aRowNr, aValPtr);
+            aValPtr += itsLocalSize;
+          }
+        }
+        anIter++;
+      }
+    }
+    aDataPtr.freeVStorage(anArray, deleteIt);
+  }
+}
+
 void SSMColumn::removeColumn()
 {
   if (dataType() == TpString  &&  itsMaxLen == 0) {
@@ -576,6 +705,27 @@ void SSMColumn::removeColumn()
   }
 }
   
+StManZoneMap* SSMColumn::zoneMap()
+{
+  if (!itsZoneMap  &&  StManZoneMap::canHandle (dataType())) {
+    itsZoneMap.reset (new StManZoneMap
+                      (dataType(), itsSSMPtr->getRowsPerBucket(itsColNr)));
+  }
+  return itsZoneMap.get();
+}
+
+Bool SSMColumn::getZoneRanges (const Vector<Double>& lower,
+                               const Vector<Double>& upper,
+                               std::vector<std::pair<rownr_t,rownr_t>>& rowRanges)
+{
+  if (! zoneMap()) {
+    return False;
+  }
+  itsZoneMap->getRanges (*this, itsSSMPtr->getNRow(), lower, upper,
+                         rowRanges);
+  return True;
+}
+
 void SSMColumn::init()
 {
   DataType aDT = static_cast<DataType>(dataType());
@@ -31,6 +31,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/StManColumnBase.h>
 #include <casacore/tables/DataMan/SSMBase.h>
+#include <casacore/tables/DataMan/StManZoneMap.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/Conversion.h>
@@ -176,6 +177,17 @@ public:
   // Put the scalar values of the entire column.
   // It invalidates the cache.
   virtual void putScalarColumnV (const ArrayBase& aDataPtr);
+
+  // Get the scalar values in some cells of the column.
+  // The values of contiguous rows are copied per data bucket.
+  virtual void getScalarColumnCellsV (const RefRows& aRowNrs,
+                                      ArrayBase& aDataPtr);
+
+  // Put the scalar values into some cells of the column.
+  // The values of contiguous rows are copied per data bucket.
+  // It invalidates the cache.
+  virtual void putScalarColumnCellsV (const RefRows& aRowNrs,
+                                      const ArrayBase& aDataPtr);
   
   // Add (NewNrRows-OldNrRows) rows to the Column and initialize
   // the new rows when needed.
@@ -185,6 +197,21 @@ public:
   // If needed, it also removes it from the cache.
   virtual void deleteRow (rownr_t aRowNr);
 
+  // Get the ranges of rows that can contain values in the given value
+  // ranges using the minimum and maximum per bucket.
+  // It returns False if the data type is not an integer or real type.
+  virtual Bool getZoneRanges (const Vector<Double>& lower,
+                              const Vector<Double>& upper,
+                              std::vector<std::pair<rownr_t,rownr_t>>& rowRanges);
+
+  // Get the zone map (a null pointer if not created yet).
+  StManZoneMap* getZoneMap()
+    { return itsZoneMap.get(); }
+
+  // Set the zone map (as read from its file).
+  void setZoneMap (std::unique_ptr<StManZoneMap> aZoneMap)
+    { itsZoneMap = std::move(aZoneMap); }
+
   // Get the size of the dataType in bytes!!
   uInt getExternalSizeBytes() const;
 
@@ -223,13 +250,29 @@ protected:
   void putValueShortString (rownr_t aRowNr, const void* aValue,
 			    const String& string);
   
-  // Get the values for the entire column.
-  // The data from all buckets is copied to the array.
-  void getColumnValue (void* anArray, rownr_t aNrRows);
+  // Get the values for the given number of rows starting at the given row.
+  // The data from all buckets involved is copied to the array.
+  // It cannot be used for strings.
+  void getColumnValue (void* anArray, rownr_t aRowNr, rownr_t aNrRows);
   
-  // Put the values from the array in the entire column.
+  // Put the values from the array in the given number of rows starting at
+  // the given row.
   // Each data bucket is filled with the the appropriate part of the array.
-  void putColumnValue (const void* anArray, rownr_t aNrRows);
+  // It cannot be used for strings.
+  void putColumnValue (const void* anArray, rownr_t aRowNr, rownr_t aNrRows);
+
+  // Get the values of the given rows, where each slice of contiguous rows
+  // is read using <src>getColumnValue</src>.
+  void getColumnCellsValue (void* anArray, const RefRows& aRowNrs);
+
+  // Put the values of the given rows, where each slice of contiguous rows
+  // is written using <src>putColumnValue</src>.
+  void putColumnCellsValue (const void* anArray, const RefRows& aRowNrs);
+
+  // Get the size of a value in local format.
+  // Note that itsLocalSize is the size of a single Bool for a Bool array.
+  uInt64 localValueSize() const
+    { return (dtype() == TpBool  ?  itsNrElem*sizeof(Bool) : itsLocalSize); }
 
 
   // Pointer to the parent storage manager.
@@ -257,6 +300,8 @@ protected:
   Conversion::ValueFunction* itsWriteFunc;
   // Pointer to a convert function for reading.
   Conversion::ValueFunction* itsReadFunc;
+  // The minimum and maximum value per bucket (for numeric scalars).
+  std::unique_ptr<StManZoneMap> itsZoneMap;
   
 private:
   // Initialize part of the object.
@@ -266,6 +311,9 @@ private:
 
   // Get the pointer to the cache. It is created if not done yet.
   char* getDataPtr();
+
+  // Get the zone map. It is created if not done yet.
+  StManZoneMap* zoneMap();
 };
 
 
@@ -27,6 +27,9 @@
 #include <casacore/tables/DataMan/SSMStringHandler.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <cstdint>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -78,11 +81,12 @@ void SSMDirColumn::getArrayV (rownr_t aRowNr, ArrayBase& aDataPtr)
     // Bools need to be converted from bits.
     rownr_t aStartRow;
     rownr_t anEndRow;
-    char*   aValue;
+    const char* aValue;
     Array<Bool>& arr = static_cast<Array<Bool>&>(aDataPtr);
     Bool* data = arr.getStorage (deleteIt);
-    aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
-                              columnName());
+    ConcurrentBucketCache::Pin aPin;
+    aValue = itsSSMPtr->findRead (aRowNr, itsColNr, aStartRow, anEndRow,
+                                  columnName(), aPin);
     uInt64 anOff = (aRowNr-aStartRow) * itsNrCopy;
     Conversion::bitToBool(data, aValue+ anOff/8, anOff%8, itsNrCopy);
     arr.putStorage (data, deleteIt);
@@ -104,13 +108,72 @@ void SSMDirColumn::getValue(rownr_t aRowNr, void* data)
 {
   rownr_t aStartRow;
   rownr_t anEndRow;
-  char*   aValue;
-  aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
-                            columnName());
+  const char* aValue;
+  ConcurrentBucketCache::Pin aPin;
+  aValue = itsSSMPtr->findRead (aRowNr, itsColNr, aStartRow, anEndRow,
+                                columnName(), aPin);
   itsReadFunc (data, aValue+(aRowNr-aStartRow)*itsExternalSizeBytes,
 	       itsNrCopy);
 }
 
+template<typename T>
+static Bool makeView (ArrayBase& aDataPtr, const IPosition& aShape,
+                      const char* aValue,
+                      const std::shared_ptr<const void>& aMapping)
+{
+  // The data must be aligned to be used as an array of T.
+  if (reinterpret_cast<std::uintptr_t>(aValue) % alignof(T) != 0) {
+    return False;
+  }
+  // The array holds the mapping, so it stays valid after the table
+  // has been closed or resynced.
+  static_cast<Array<T>&>(aDataPtr).shareStorage
+    (aShape, reinterpret_cast<T*>(const_cast<char*>(aValue)), aMapping);
+  return True;
+}
+
+Bool SSMDirColumn::getArrayViewV (rownr_t aRowNr, ArrayBase& aDataPtr)
+{
+  // A view is only possible if the data are stored in native format.
+  if (!itsSSMPtr->isMapped()  ||  itsExternalSizeBytes != itsLocalSize
+  ||  itsSSMPtr->asBigEndian() != HostInfo::bigEndian()) {
+    return False;
+  }
+  rownr_t aStartRow;
+  rownr_t anEndRow;
+  ConcurrentBucketCache::Pin aPin;
+  const char* aValue = itsSSMPtr->findRead (aRowNr, itsColNr,
+                                            aStartRow, anEndRow,
+                                            columnName(), aPin)
+    + (aRowNr-aStartRow)*itsExternalSizeBytes;
+  std::shared_ptr<const void> aMapping = itsSSMPtr->mapping();
+  switch (dtype()) {
+  case TpUChar:
+    return makeView<uChar> (aDataPtr, itsShape, aValue, aMapping);
+  case TpShort:
+    return makeView<Short> (aDataPtr, itsShape, aValue, aMapping);
+  case TpUShort:
+    return makeView<uShort> (aDataPtr, itsShape, aValue, aMapping);
+  case TpInt:
+    return makeView<Int> (aDataPtr, itsShape, aValue, aMapping);
+  case TpUInt:
+    return makeView<uInt> (aDataPtr, itsShape, aValue, aMapping);
+  case TpInt64:
+    return makeView<Int64> (aDataPtr, itsShape, aValue, aMapping);
+  case TpFloat:
+    return makeView<Float> (aDataPtr, itsShape, aValue, aMapping);
+  case TpDouble:
+    return makeView<Double> (aDataPtr, itsShape, aValue, aMapping);
+  case TpComplex:
+    return makeView<Complex> (aDataPtr, itsShape, aValue, aMapping);
+  case TpDComplex:
+    return makeView<DComplex> (aDataPtr, itsShape, aValue, aMapping);
+  default:
+    // Bools are stored as bits and Strings indirectly.
+    return False;
+  }
+}
+
 void SSMDirColumn::putArrayV (rownr_t aRowNr, const ArrayBase& aDataPtr)
 {
   Bool deleteIt;
@@ -142,6 +205,55 @@ void SSMDirColumn::putArrayV (rownr_t aRowNr, const ArrayBase& aDataPtr)
   itsSSMPtr->setBucketDirty();
 }
 
+void SSMDirColumn::getArrayColumnV (ArrayBase& aDataPtr)
+{
+  if (dtype() == TpString) {
+    SSMColumn::getArrayColumnV (aDataPtr);
+  } else {
+    Bool deleteIt;
+    void* data = aDataPtr.getVStorage (deleteIt);
+    getColumnValue (data, 0, itsSSMPtr->getNRow());
+    aDataPtr.putVStorage (data, deleteIt);
+  }
+}
 
-} //# NAMESPACE CASACORE - END
+void SSMDirColumn::putArrayColumnV (const ArrayBase& aDataPtr)
+{
+  if (dtype() == TpString) {
+    SSMColumn::putArrayColumnV (aDataPtr);
+  } else {
+    Bool deleteIt;
+    const void* data = aDataPtr.getVStorage (deleteIt);
+    putColumnValue (data, 0, itsSSMPtr->getNRow());
+    aDataPtr.freeVStorage (data, deleteIt);
+  }
+}
 
+void SSMDirColumn::getArrayColumnCellsV (const RefRows& aRowNrs,
+                                         ArrayBase& aDataPtr)
+{
+  if (dtype() == TpString) {
+    SSMColumn::getArrayColumnCellsV (aRowNrs, aDataPtr);
+  } else {
+    Bool deleteIt;
+    void* data = aDataPtr.getVStorage (deleteIt);
+    getColumnCellsValue (data, aRowNrs);
+    aDataPtr.putVStorage (data, deleteIt);
+  }
+}
+
+void SSMDirColumn::putArrayColumnCellsV (const RefRows& aRowNrs,
+                                         const ArrayBase& aDataPtr)
+{
+  if (dtype() == TpString) {
+    SSMColumn::putArrayColumnCellsV (aRowNrs, aDataPtr);
+  } else {
+    Bool deleteIt;
+    const void* data = aDataPtr.getVStorage (deleteIt);
+    putColumnCellsValue (data, aRowNrs);
+    aDataPtr.freeVStorage (data, deleteIt);
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
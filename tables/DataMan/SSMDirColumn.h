@@ -66,6 +66,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // in this class is that it maintains no cache.
 // Furthermore fixed length strings are not handled specially.
 // All string arrays are stored in the special string buckets.
+// <p>
+// If the data file is memory-mapped (see
+// <linkto class=StandardStMan>StandardStMan</linkto>), the data are read
+// directly from the mapped file. Furthermore, <src>getArrayViewV</src>
+// can give a read-only array referencing the mapped data if stored in
+// native format, thus avoiding any copying.
 // </synopsis>
 
 //# <todo asof="$DATE:$">
@@ -96,10 +102,28 @@ public:
 
   // Get an array value in the given row.
   virtual void getArrayV (rownr_t rownr, ArrayBase& dataPtr);
+
+  // Make the array reference the array value in the given row directly
+  // in the memory-mapped data file.
+  // It can only be done for a memory-mapped file holding the data in
+  // native format and properly aligned, thus not for Bool or String arrays.
+  virtual Bool getArrayViewV (rownr_t rownr, ArrayBase& dataPtr);
   
   // Put an array value in the given row.
   virtual void putArrayV (rownr_t rownr, const ArrayBase& dataPtr);
 
+  // Get or put the array values of the entire column or some cells.
+  // The values of contiguous rows are copied per data bucket, except
+  // for String arrays which are handled row by row.
+  // <group>
+  virtual void getArrayColumnV (ArrayBase& dataPtr);
+  virtual void putArrayColumnV (const ArrayBase& dataPtr);
+  virtual void getArrayColumnCellsV (const RefRows& rownrs,
+                                     ArrayBase& dataPtr);
+  virtual void putArrayColumnCellsV (const RefRows& rownrs,
+                                     const ArrayBase& dataPtr);
+  // </group>
+
   // Remove the given row from the data bucket and possibly string bucket.
   virtual void deleteRow (rownr_t aRowNr);
 
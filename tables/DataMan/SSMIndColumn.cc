@@ -127,10 +127,11 @@ StIndArray* SSMIndColumn::getArrayPtr (rownr_t aRowNr)
   Int64   anOffset;
   rownr_t aStartRow;
   rownr_t anEndRow;
-  char*   aValue;
+  const char* aValue;
 
-  aValue = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
-                            columnName());
+  ConcurrentBucketCache::Pin aPin;
+  aValue = itsSSMPtr->findRead (aRowNr, itsColNr, aStartRow, anEndRow,
+                                columnName(), aPin);
   itsReadFunc (&anOffset, aValue+(aRowNr-aStartRow)*itsExternalSizeBytes,
 	       itsNrCopy);
 
@@ -0,0 +1,329 @@
+//# StManZoneMap.cc: Minimum and maximum per block of rows of a scalar column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/StManZoneMap.h>
+#include <casacore/tables/DataMan/DataManagerColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <limits>
+#include <sys/stat.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+StManZoneMap::StManZoneMap (int dataType, uInt rowsPerZone)
+: itsDataType    (dataType),
+  itsRowsPerZone (std::max(rowsPerZone, 1u)),
+  itsChanged     (False)
+{
+  AlwaysAssert (canHandle(dataType), AipsError);
+}
+
+Bool StManZoneMap::canHandle (int dataType)
+{
+  switch (dataType) {
+  case TpUChar:
+  case TpShort:
+  case TpUShort:
+  case TpInt:
+  case TpUInt:
+  case TpInt64:
+  case TpFloat:
+  case TpDouble:
+    return True;
+  default:
+    return False;
+  }
+}
+
+Double StManZoneMap::toDouble (const void* value) const
+{
+  switch (itsDataType) {
+  case TpUChar:
+    return *static_cast<const uChar*>(value);
+  case TpShort:
+    return *static_cast<const Short*>(value);
+  case TpUShort:
+    return *static_cast<const uShort*>(value);
+  case TpInt:
+    return *static_cast<const Int*>(value);
+  case TpUInt:
+    return *static_cast<const uInt*>(value);
+  case TpInt64:
+    return *static_cast<const Int64*>(value);
+  case TpFloat:
+    return *static_cast<const Float*>(value);
+  default:
+    return *static_cast<const Double*>(value);
+  }
+}
+
+void StManZoneMap::extend (uInt zone)
+{
+  if (zone >= itsMin.size()) {
+    itsMin.resize (zone+1, std::numeric_limits<Double>::infinity());
+    itsMax.resize (zone+1, -std::numeric_limits<Double>::infinity());
+    itsNrSet.resize (zone+1, 0);
+  }
+}
+
+void StManZoneMap::put (rownr_t rownr, Double value)
+{
+  uInt zone = rownr / itsRowsPerZone;
+  extend (zone);
+  // A NaN never matches, so it does not need to be part of the range.
+  if (! std::isnan(value)) {
+    if (value < itsMin[zone]) itsMin[zone] = value;
+    if (value > itsMax[zone]) itsMax[zone] = value;
+  }
+  if (rownr == rownr_t(zone) * itsRowsPerZone + itsNrSet[zone]) {
+    itsNrSet[zone]++;
+  }
+  itsChanged = True;
+}
+
+void StManZoneMap::put (rownr_t startRow, rownr_t nrow, const void* values)
+{
+  const char* ptr = static_cast<const char*>(values);
+  uInt size = ValType::getTypeSize (DataType(itsDataType));
+  for (rownr_t i=0; i<nrow; ++i) {
+    put (startRow+i, toDouble(ptr));
+    ptr += size;
+  }
+}
+
+void StManZoneMap::removeRow (rownr_t rownr)
+{
+  // The rows shift, so the zone of the row and all zones after it
+  // have to be recalculated.
+  uInt zone = rownr / itsRowsPerZone;
+  if (zone < itsMin.size()) {
+    itsMin.resize (zone);
+    itsMax.resize (zone);
+    itsNrSet.resize (zone);
+    itsChanged = True;
+  }
+}
+
+template<typename T>
+void StManZoneMap::fillZone (DataManagerColumn& column, uInt zone,
+                             rownr_t nrow)
+{
+  rownr_t st = rownr_t(zone) * itsRowsPerZone;
+  rownr_t nr = std::min (rownr_t(itsRowsPerZone), nrow - st);
+  Vector<T> values(nr);
+  column.getScalarColumnCellsV (RefRows(st, st+nr-1), values);
+  Double mn = std::numeric_limits<Double>::infinity();
+  Double mx = -mn;
+  for (const T& v : values) {
+    Double val = v;
+    if (! std::isnan(val)) {
+      if (val < mn) mn = val;
+      if (val > mx) mx = val;
+    }
+  }
+  itsMin[zone]   = mn;
+  itsMax[zone]   = mx;
+  itsNrSet[zone] = nr;
+  itsChanged = True;
+}
+
+void StManZoneMap::getRanges (DataManagerColumn& column, rownr_t nrow,
+                              const Vector<Double>& lower,
+                              const Vector<Double>& upper,
+                              std::vector<std::pair<rownr_t,rownr_t>>& rowRanges)
+{
+  rowRanges.clear();
+  if (nrow == 0) {
+    return;
+  }
+  // Sort the ranges on lower bound and determine the running maximum of
+  // the upper bounds. A zone [mn,mx] matches if a range with a lower bound
+  // <= mx has an upper bound >= mn.
+  std::vector<std::pair<Double,Double>> ranges;
+  for (uInt i=0; i<lower.size(); ++i) {
+    ranges.push_back (std::make_pair (lower[i], upper[i]));
+  }
+  std::sort (ranges.begin(), ranges.end());
+  std::vector<Double> starts, maxEnds;
+  for (const auto& range : ranges) {
+    starts.push_back (range.first);
+    maxEnds.push_back (maxEnds.empty()  ?  range.second :
+                       std::max (maxEnds.back(), range.second));
+  }
+  uInt nz = (nrow + itsRowsPerZone - 1) / itsRowsPerZone;
+  if (nz > 0) {
+    extend (nz-1);
+  }
+  for (uInt zone=0; zone<nz; ++zone) {
+    rownr_t st = rownr_t(zone) * itsRowsPerZone;
+    rownr_t nr = std::min (rownr_t(itsRowsPerZone), nrow - st);
+    if (itsNrSet[zone] < nr) {
+      switch (itsDataType) {
+      case TpUChar:
+        fillZone<uChar> (column, zone, nrow);
+        break;
+      case TpShort:
+        fillZone<Short> (column, zone, nrow);
+        break;
+      case TpUShort:
+        fillZone<uShort> (column, zone, nrow);
+        break;
+      case TpInt:
+        fillZone<Int> (column, zone, nrow);
+        break;
+      case TpUInt:
+        fillZone<uInt> (column, zone, nrow);
+        break;
+      case TpInt64:
+        fillZone<Int64> (column, zone, nrow);
+        break;
+      case TpFloat:
+        fillZone<Float> (column, zone, nrow);
+        break;
+      default:
+        fillZone<Double> (column, zone, nrow);
+        break;
+      }
+    }
+    size_t n = std::upper_bound (starts.begin(), starts.end(), itsMax[zone])
+               - starts.begin();
+    if (n > 0  &&  maxEnds[n-1] >= itsMin[zone]) {
+      // Merge with the previous zone if adjacent.
+      if (!rowRanges.empty()  &&  rowRanges.back().second + 1 == st) {
+        rowRanges.back().second = st + nr - 1;
+      } else {
+        rowRanges.push_back (std::make_pair (st, st + nr - 1));
+      }
+    }
+  }
+}
+
+StManZoneMap::FileStamp StManZoneMap::fileStamp (const String& fileName)
+{
+  FileStamp stamp;
+  struct stat buf;
+  if (::stat (fileName.chars(), &buf) == 0) {
+    stamp.size = buf.st_size;
+#if defined(__APPLE__)
+    stamp.sec  = buf.st_mtimespec.tv_sec;
+    stamp.nsec = buf.st_mtimespec.tv_nsec;
+#else
+    stamp.sec  = buf.st_mtim.tv_sec;
+    stamp.nsec = buf.st_mtim.tv_nsec;
+#endif
+  }
+  return stamp;
+}
+
+StManZoneMap::FileStamp StManZoneMap::writeFile
+(const String& fileName, const String& dataFileName, rownr_t nrow,
+ const std::vector<std::pair<String,StManZoneMap*>>& maps)
+{
+  // The data file has been flushed, so its stamp tells the data state
+  // the maps belong to. If the file system has no subsecond resolution,
+  // a later write in the same second would not change the stamp, so
+  // such a stamp is not stored.
+  FileStamp stamp = fileStamp (dataFileName);
+  if (stamp.nsec == 0  &&  stamp.sec >= Int64(std::time(0)) - 1) {
+    stamp = FileStamp();
+  }
+  AipsIO ios(fileName, ByteIO::New);
+  ios.putstart ("StManZoneMap", 2);
+  ios << uInt64(nrow) << stamp.size << stamp.sec << stamp.nsec
+      << uInt(maps.size());
+  for (const auto& map : maps) {
+    const StManZoneMap& zmap = *map.second;
+    ios << map.first << zmap.itsDataType << zmap.itsRowsPerZone;
+    ios.put (zmap.itsMin.size(), zmap.itsMin.data());
+    ios.put (zmap.itsMax.size(), zmap.itsMax.data());
+    ios.put (zmap.itsNrSet.size(), zmap.itsNrSet.data());
+    map.second->itsChanged = False;
+  }
+  ios.putend();
+  return stamp;
+}
+
+std::map<String,std::unique_ptr<StManZoneMap>> StManZoneMap::readFile
+(const String& fileName, const String& dataFileName, rownr_t nrow,
+ FileStamp& stamp)
+{
+  std::map<String,std::unique_ptr<StManZoneMap>> maps;
+  stamp = FileStamp();
+  File file(fileName);
+  if (!file.exists()) {
+    return maps;
+  }
+  try {
+    AipsIO ios(fileName);
+    // Version 1 files do not contain the stamp, so cannot be trusted.
+    if (ios.getstart ("StManZoneMap") < 2) {
+      return maps;
+    }
+    uInt64 nrowFile;
+    FileStamp stored;
+    uInt nmap;
+    ios >> nrowFile >> stored.size >> stored.sec >> stored.nsec >> nmap;
+    // The data file must not have been changed after the maps were written.
+    if (nrowFile != nrow  ||  stored.size < 0  ||
+        stored != fileStamp (dataFileName)) {
+      return maps;
+    }
+    for (uInt i=0; i<nmap; ++i) {
+      String name;
+      int dataType;
+      uInt rowsPerZone, n;
+      ios >> name >> dataType >> rowsPerZone;
+      std::unique_ptr<StManZoneMap> zmap
+        (new StManZoneMap (dataType, rowsPerZone));
+      ios >> n;
+      zmap->itsMin.resize (n);
+      ios.get (n, zmap->itsMin.data());
+      ios >> n;
+      zmap->itsMax.resize (n);
+      ios.get (n, zmap->itsMax.data());
+      ios >> n;
+      zmap->itsNrSet.resize (n);
+      ios.get (n, zmap->itsNrSet.data());
+      maps[name] = std::move(zmap);
+    }
+    ios.getend();
+    stamp = stored;
+  } catch (const std::exception&) {
+    // A damaged file is ignored; the zone maps are recalculated.
+    maps.clear();
+  }
+  return maps;
+}
+
+} //# NAMESPACE CASACORE - END
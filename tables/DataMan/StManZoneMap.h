@@ -0,0 +1,200 @@
+//# StManZoneMap.h: Minimum and maximum per block of rows of a scalar column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_STMANZONEMAP_H
+#define TABLES_STMANZONEMAP_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class DataManagerColumn;
+
+
+// <summary>
+// Minimum and maximum per block of rows of a scalar column
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tStManZoneMap">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=StandardStMan>StandardStMan</linkto>
+//   <li> <linkto class=IncrementalStMan>IncrementalStMan</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A zone map keeps the minimum and maximum value of each block (zone)
+// of rows of a scalar column with an integer or real data type.
+// StandardStMan uses the number of rows in a bucket as the zone size,
+// IncrementalStMan a fixed number of rows.
+// <br>Function <src>getRanges</src> uses the zone map to find the rows that
+// can contain values in the given ranges, so a selection on the column
+// (e.g., on TIME in a time-ordered MeasurementSet) only has to read and
+// evaluate the buckets containing those rows.
+// <p>
+// The map is updated while values are put. For each zone it counts the
+// number of rows put in ascending order from the start of the zone;
+// the zone is complete if that count equals the number of rows in it.
+// Because a value put in a row can only widen the minimum and maximum, a
+// complete zone is always a superset of the values in it.
+// Zones that are not complete (e.g., because rows were added without
+// putting values, values were put in random order, or rows were removed)
+// are (re)calculated from the column data when needed.
+// NaN values are ignored, because they never match a range.
+// <p>
+// The zone maps of the columns in a storage manager are kept in a file
+// next to its data file (with suffix <src>z</src>). Together with the maps
+// the stamp of the data file (its size and modification time in
+// nanoseconds) is stored. The maps are only used if the number of rows
+// matches and the data file still has that exact stamp, so a table changed
+// by software not knowing about zone maps cannot give wrong results.
+// If the file system only has a resolution of seconds, a write in the same
+// second cannot be detected. In that case a stamp that is too recent is not
+// stored, so the maps are written again at a later flush.
+// </synopsis>
+
+// <motivation>
+// Selecting a small time range in a large MeasurementSet should not require
+// reading the entire TIME column.
+// </motivation>
+
+class StManZoneMap
+{
+public:
+    // The stamp of a data file, i.e., its size and modification time.
+    // A size -1 means that the stamp is invalid.
+    struct FileStamp {
+      Int64 size = -1;
+      Int64 sec  = 0;
+      Int64 nsec = 0;
+      bool operator== (const FileStamp& that) const
+        { return size == that.size  &&  sec == that.sec  &&  nsec == that.nsec; }
+      bool operator!= (const FileStamp& that) const
+        { return ! operator==(that); }
+    };
+
+    // Create an empty zone map for a column with the given data type.
+    StManZoneMap (int dataType, uInt rowsPerZone);
+
+    StManZoneMap (const StManZoneMap&) = delete;
+    StManZoneMap& operator= (const StManZoneMap&) = delete;
+
+    // Can a zone map be used for the given data type?
+    static Bool canHandle (int dataType);
+
+    // Get the data type of the column.
+    int dataType() const
+      { return itsDataType; }
+
+    // Get the number of rows per zone.
+    uInt rowsPerZone() const
+      { return itsRowsPerZone; }
+
+    // Get the number of zones.
+    uInt nzones() const
+      { return itsMin.size(); }
+
+    // Update the map for a value put in a row.
+    // The value must have the data type of the column.
+    void put (rownr_t rownr, const void* value)
+      { put (rownr, toDouble (value)); }
+
+    // Update the map for the values put in a number of rows.
+    void put (rownr_t startRow, rownr_t nrow, const void* values);
+
+    // Update the map for the removal of a row.
+    // All zones from the one containing the row on become incomplete.
+    void removeRow (rownr_t rownr);
+
+    // Get the ranges of rows (inclusive) in a column with <src>nrow</src>
+    // rows that can contain values in one of the given ranges (inclusive).
+    // Incomplete zones are (re)calculated by reading the column.
+    // The row ranges are in ascending order.
+    void getRanges (DataManagerColumn& column, rownr_t nrow,
+                    const Vector<Double>& lower, const Vector<Double>& upper,
+                    std::vector<std::pair<rownr_t,rownr_t>>& rowRanges);
+
+    // Has the map changed since the last write?
+    Bool isChanged() const
+      { return itsChanged; }
+
+    // Get the stamp of a file. It is invalid if the file does not exist.
+    static FileStamp fileStamp (const String& fileName);
+
+    // Write the zone maps of the columns of a storage manager into a file.
+    // The stamp of the data file is stored in it and returned. An invalid
+    // stamp is stored (and returned) if it is too recent to be reliable.
+    static FileStamp writeFile
+    (const String& fileName, const String& dataFileName, rownr_t nrow,
+     const std::vector<std::pair<String,StManZoneMap*>>& maps);
+
+    // Read the zone maps from the file (if it exists) and return them
+    // per column name. Nothing is returned if the file does not match
+    // the stamp of the data file or its number of rows.
+    // The stamp read is returned in <src>stamp</src> (invalid if nothing
+    // is returned).
+    static std::map<String,std::unique_ptr<StManZoneMap>> readFile
+    (const String& fileName, const String& dataFileName, rownr_t nrow,
+     FileStamp& stamp);
+
+private:
+    // Convert the value (of the column's data type) to Double.
+    Double toDouble (const void* value) const;
+
+    // Update the map for a value put in a row.
+    void put (rownr_t rownr, Double value);
+
+    // Make sure zones exist up to the given zone.
+    void extend (uInt zone);
+
+    // Calculate a zone from the column data.
+    template<typename T>
+    void fillZone (DataManagerColumn& column, uInt zone, rownr_t nrow);
+
+    //# Data members.
+    int                 itsDataType;
+    uInt                itsRowsPerZone;
+    std::vector<Double> itsMin;
+    std::vector<Double> itsMax;
+    std::vector<uInt>   itsNrSet;    //# nr of rows put in order from start
+    Bool                itsChanged;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
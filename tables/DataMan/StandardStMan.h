@@ -103,7 +103,37 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // less space.
 // <p>
 // As said above all string arrays and variable length scalar strings
-// are stored in separate string buckets. 
+// are stored in separate string buckets.
+// <p>
+// If the aipsrc variable <src>table.ssm.mmap</src> is true, the main file
+// of a table opened readonly is memory-mapped (unless the table is stored
+// in a MultiFile). The data are then read directly from the mapped file
+// instead of via the bucket cache. Furthermore, if the data are stored in
+// native format (i.e., the endianness of the table matches the host),
+// <src>ArrayColumn::getView</src> gives an array referencing the data
+// of a fixed shape array in the mapped file, so no copy is made at all.
+// Such a view keeps the mapping alive, even after the table is closed.
+// The mapping is readonly, thus a view cannot be changed.
+// That can only be done if the data of the cell are aligned, which is
+// always the case if the bucket size is a multiple of 8 and the number of
+// rows per bucket is a multiple of 64 (because Bool scalars take a bit).
+// Otherwise the data are copied.
+// Note that Bool arrays are stored as bits, so they are always copied.
+// <p>
+// If not memory-mapped, the data buckets of a readonly table are read via a
+// thread-safe <linkto class=ConcurrentBucketCache>ConcurrentBucketCache</linkto>.
+// Thus multiple threads can share a readonly table (opened without locking)
+// to get the values of fixed shape arrays or to get scalar values using
+// <src>getColumn</src>, <src>getColumnRange</src> or
+// <src>getColumnCells</src>. Getting a single scalar value is not
+// thread-safe, because it uses a column cache. Strings are also not
+// thread-safe, because they are read via the normal bucket cache.
+// <p>
+// For scalar columns with an integer or real data type the minimum and
+// maximum value per bucket are kept (see
+// <linkto class=StManZoneMap>StManZoneMap</linkto>), so a selection on
+// a range of such a column only needs to read the buckets that can
+// contain matching values.
 // </synopsis>
 
 // <motivation>
@@ -0,0 +1,182 @@
+//# TSMCacheAdapter.cc: Adapt the TSM cache size to the observed access pattern
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/TSMCacheAdapter.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <mutex>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// The global budget administration (in bytes).
+static std::mutex theBudgetMutex;
+static uInt64     theTotalReserved = 0;
+
+// The maximum number of decisions kept for showing.
+static const uInt theMaxLog = 8;
+
+
+TSMCacheAdapter::TSMCacheAdapter (uInt windowSize, uInt bucketSize,
+                                  uInt64 budget)
+: itsBucketSize      (bucketSize),
+  itsBudget          (budget),
+  itsLastTile        (~0u),
+  itsWindow          (std::max(windowSize, 2u)),
+  itsWindowPos       (0),
+  itsNrInWindow      (0),
+  itsWorkingSet      (0),
+  itsNrSinceDecision (0),
+  itsReserved        (0),
+  itsNrAccess        (0),
+  itsNrGrow          (0),
+  itsNrShrink        (0),
+  itsNrCapped        (0)
+{}
+
+TSMCacheAdapter::~TSMCacheAdapter()
+{
+    release();
+}
+
+void TSMCacheAdapter::addAccess (uInt tileNr)
+{
+    itsLastTile = tileNr;
+    uInt64 index = itsNrAccess++;
+    itsNrSinceDecision++;
+    // Forget the oldest access if the window is full (unless the tile
+    // has been accessed again).
+    uInt64 windowSize = itsWindow.size();
+    if (itsNrInWindow == windowSize) {
+        auto iter = itsLastAccess.find (itsWindow[itsWindowPos]);
+        if (iter != itsLastAccess.end()  &&
+            iter->second == index - windowSize) {
+            itsLastAccess.erase (iter);
+        }
+    } else {
+        itsNrInWindow++;
+    }
+    itsWindow[itsWindowPos] = tileNr;
+    if (++itsWindowPos == windowSize) {
+        itsWindowPos = 0;
+    }
+    // Note the reuse distance if accessed before in the window.
+    auto result = itsLastAccess.insert (std::make_pair (tileNr, index));
+    if (! result.second) {
+        itsDistances.push_back (index - result.first->second);
+        result.first->second = index;
+    }
+}
+
+uInt TSMCacheAdapter::adapt (uInt currentSize, uInt maxSize)
+{
+    // Only decide after a full window of accesses.
+    if (itsNrSinceDecision < itsWindow.size()) {
+        return 0;
+    }
+    // Determine the working set from the reuse distances.
+    itsWorkingSet = 1;
+    if (8 * itsDistances.size() >= itsNrSinceDecision) {
+        auto nth = itsDistances.begin() + itsDistances.size() * 9 / 10;
+        std::nth_element (itsDistances.begin(), nth, itsDistances.end());
+        itsWorkingSet = *nth;
+    }
+    itsDistances.clear();
+    itsNrSinceDecision = 0;
+    // Use the working set plus some margin.
+    uInt target = itsWorkingSet + itsWorkingSet/8;
+    target = std::max (1u, std::min (target, maxSize));
+    if (target > currentSize) {
+        uInt granted = reserve (target);
+        if (granted < target) {
+            itsNrCapped++;
+            logDecision ("capped by budget", currentSize, granted);
+        } else {
+            itsNrGrow++;
+            logDecision ("grow", currentSize, granted);
+        }
+        return (granted == currentSize  ?  0 : granted);
+    } else if (2*target < currentSize) {
+        itsNrShrink++;
+        logDecision ("shrink", currentSize, target);
+        return reserve (target);
+    }
+    return 0;
+}
+
+uInt TSMCacheAdapter::reserve (uInt nbuckets)
+{
+    std::lock_guard<std::mutex> locker(theBudgetMutex);
+    uInt64 others = theTotalReserved - uInt64(itsReserved) * itsBucketSize;
+    if (itsBudget > 0) {
+        uInt64 avail = (others < itsBudget  ?  itsBudget - others : 0);
+        nbuckets = std::min (uInt64(nbuckets), avail / itsBucketSize);
+    }
+    // At least one bucket is always needed.
+    nbuckets = std::max (1u, nbuckets);
+    itsReserved = nbuckets;
+    theTotalReserved = others + uInt64(nbuckets) * itsBucketSize;
+    return nbuckets;
+}
+
+void TSMCacheAdapter::release()
+{
+    std::lock_guard<std::mutex> locker(theBudgetMutex);
+    theTotalReserved -= uInt64(itsReserved) * itsBucketSize;
+    itsReserved = 0;
+}
+
+uInt64 TSMCacheAdapter::totalReserved()
+{
+    std::lock_guard<std::mutex> locker(theBudgetMutex);
+    return theTotalReserved;
+}
+
+void TSMCacheAdapter::logDecision (const char* reason, uInt oldSize,
+                                   uInt newSize)
+{
+    if (itsLog.size() == theMaxLog) {
+        itsLog.pop_front();
+    }
+    itsLog.push_back ("access " + String::toString(itsNrAccess) + ": " +
+                      reason + ' ' + String::toString(oldSize) + " -> " +
+                      String::toString(newSize) + " (working set " +
+                      String::toString(itsWorkingSet) + ')');
+}
+
+void TSMCacheAdapter::show (ostream& os) const
+{
+    os << "adaptive:  window=" << itsWindow.size()
+       << " workingSet=" << itsWorkingSet
+       << " #tileAccess=" << itsNrAccess << endl;
+    os << "  #grow=" << itsNrGrow << " #shrink=" << itsNrShrink
+       << " #capped=" << itsNrCapped
+       << " reserved=" << itsReserved << " buckets" << endl;
+    for (const String& decision : itsLog) {
+        os << "  " << decision << endl;
+    }
+}
+
+} //# NAMESPACE CASACORE - END
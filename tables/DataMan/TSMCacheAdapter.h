@@ -0,0 +1,172 @@
+//# TSMCacheAdapter.h: Adapt the TSM cache size to the observed access pattern
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TSMCACHEADAPTER_H
+#define TABLES_TSMCACHEADAPTER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/iosfwd.h>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Adapt the TSM cache size to the observed tile access pattern
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tTSMCacheAdapter">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TSMCube>TSMCube</linkto>
+//   <li> <linkto class=TSMOption>TSMOption</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Normally the cache size of a hypercube in a TiledStMan is derived from
+// the shape of the data accessed, which can result in a cache that is far
+// too small (thrashing) or far too large (wasting memory) for the actual
+// access pattern. If adaptive caching is enabled in
+// <linkto class=TSMOption>TSMOption</linkto>, a TSMCube uses a
+// TSMCacheAdapter object to keep track of the tiles accessed in a sliding
+// window of the last tile accesses.
+// <br>When a tile is accessed again within the window, the number of
+// tile accesses since its previous access (its reuse distance) is noted.
+// A least-recently-used cache of that size would have kept the tile.
+// The working set is the 90th percentile of the reuse distances.
+// After each window of accesses the cache is resized to the working set
+// (plus a margin of 1/8). The cache is only made smaller if the working set
+// is less than half the cache size, to avoid resizing back and forth.
+// If less than 1/8 of the accesses are reuses (e.g., a stream of tiles
+// used only once), a cache size of 1 is used.
+// <br>Note that reuse distances exceeding the window size cannot be seen,
+// so the window should be larger than the cache size needed.
+// <p>
+// The total size of the caches of all adaptive hypercubes (in all open
+// tables) is limited by a global budget. A cache can only grow if the
+// budget allows it. Caches sized explicitly by the user (using
+// <linkto class=ROTiledStManAccessor>ROTiledStManAccessor</linkto>)
+// are not taken into account.
+// <p>
+// The decisions made are counted and the last ones are kept, so they can be
+// shown by <src>TSMCube::showCacheStatistics</src>.
+// </synopsis>
+
+// <motivation>
+// The optimal cache size depends on the access pattern which is often
+// not known in advance.
+// </motivation>
+
+class TSMCacheAdapter
+{
+public:
+    // Create the object for a cache with the given bucket size (in bytes).
+    // The window gives the number of tile accesses to keep track of.
+    // The budget is the maximum size (in bytes) of all adaptive caches
+    // together; 0 means unlimited.
+    TSMCacheAdapter (uInt windowSize, uInt bucketSize, uInt64 budget);
+
+    // The destructor releases the reserved part of the global budget.
+    ~TSMCacheAdapter();
+
+    TSMCacheAdapter (const TSMCacheAdapter&) = delete;
+    TSMCacheAdapter& operator= (const TSMCacheAdapter&) = delete;
+
+    // Register an access to a tile.
+    // Repeated accesses to the same tile are counted only once.
+    void access (uInt tileNr)
+    {
+        if (tileNr != itsLastTile) {
+            addAccess (tileNr);
+        }
+    }
+
+    // Get the cache size (in buckets) to use if a decision has to be made.
+    // It returns 0 if the cache size does not need to change.
+    // <src>maxSize</src> is the maximum size (in buckets) allowed by the
+    // storage manager.
+    uInt adapt (uInt currentSize, uInt maxSize);
+
+    // Reserve the given number of buckets from the global budget.
+    // It returns the number of buckets that could be reserved (at least 1).
+    // It replaces a previous reservation.
+    uInt reserve (uInt nbuckets);
+
+    // Release the reservation.
+    void release();
+
+    // Get the working set size (in tiles) determined at the last decision.
+    uInt workingSet() const
+      { return itsWorkingSet; }
+
+    // Show the adaptation statistics and last decisions.
+    void show (ostream& os) const;
+
+    // Get the total number of bytes reserved by all adaptive caches.
+    static uInt64 totalReserved();
+
+private:
+    // Add an access to a tile to the window.
+    void addAccess (uInt tileNr);
+
+    // Log a decision.
+    void logDecision (const char* reason, uInt oldSize, uInt newSize);
+
+    uInt                  itsBucketSize;
+    uInt64                itsBudget;
+    uInt                  itsLastTile;
+    // The ring buffer of the tiles in the window.
+    std::vector<uInt>     itsWindow;
+    uInt                  itsWindowPos;
+    uInt                  itsNrInWindow;
+    // The index of the last access of each tile in the window.
+    std::unordered_map<uInt,uInt64> itsLastAccess;
+    // The reuse distances since the last decision.
+    std::vector<uInt>     itsDistances;
+    uInt                  itsWorkingSet;
+    // The number of accesses since the last decision.
+    uInt                  itsNrSinceDecision;
+    // The reserved number of buckets.
+    uInt                  itsReserved;
+    // Statistics.
+    uInt64                itsNrAccess;
+    uInt                  itsNrGrow;
+    uInt                  itsNrShrink;
+    uInt                  itsNrCapped;
+    std::deque<String>    itsLog;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
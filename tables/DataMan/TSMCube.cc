@@ -91,8 +91,13 @@ TSMCube::TSMCube (TiledStMan* stman, TSMFile* file,
   filePtr_p      (file),
   fileOffset_p   (0),
   cache_p        (0),
+  readCache_p    (0),
   userSetCache_p (False),
-  lastColAccess_p(NoAccess)
+  adapter_p      (0),
+  lastColAccess_p(NoAccess),
+  prevStartTile_p(-1),
+  prevEndTile_p  (-1),
+  prefetchEnd_p  (0)
 {
     if (fileOffset < 0) {
         // TiledCellStMan uses an empty shape; setShape is called later. 
@@ -118,8 +123,13 @@ TSMCube::TSMCube (TiledStMan* stman, AipsIO& ios,
   useDerived_p   (useDerived),
   filePtr_p      (0),
   cache_p        (0),
+  readCache_p    (0),
   userSetCache_p (False),
-  lastColAccess_p(NoAccess)
+  adapter_p      (0),
+  lastColAccess_p(NoAccess),
+  prevStartTile_p(-1),
+  prevEndTile_p  (-1),
+  prefetchEnd_p  (0)
 {
     Int fileSeqnr = getObject (ios);
     if (fileSeqnr >= 0) {
@@ -131,7 +141,9 @@ TSMCube::TSMCube (TiledStMan* stman, AipsIO& ios,
 
 TSMCube::~TSMCube()
 {
+    delete readCache_p;
     delete cache_p;
+    delete adapter_p;
     delete [] cachedTile_p;
 }
 
@@ -144,11 +156,14 @@ void TSMCube::clearCache (Bool doFlush)
     if (cache_p != 0) {
         cache_p->clear (0, False);
     }
+    if (readCache_p != 0) {
+        readCache_p->clear (False);
+    }
 }
 void TSMCube::emptyCache()
 {
     if (cache_p != 0) {
-        cache_p->resize (0);
+        resizeCache (0);
     }
     userSetCache_p = False;
     lastColAccess_p = NoAccess;
@@ -161,11 +176,35 @@ void TSMCube::showCacheStatistics (ostream& os) const
         os << "cubeShape: " << cubeShape_p << endl;
         os << "tileShape: " << tileShape_p << endl;
         os << "maxCacheSz:" << stmanPtr_p->maximumCacheSize() << " MiB" << endl;
-        cache_p->showStatistics (os);
+        if (readCache_p != 0) {
+            readCache_p->showStatistics (os);
+        } else {
+            cache_p->showStatistics (os);
+        }
+        if (adapter_p != 0) {
+            adapter_p->show (os);
+        }
         os << "<<<" << endl;
     }
 }
 
+void TSMCube::addCacheStatistics (BucketCacheStatistics& stats) const
+{
+    stats += deletedCacheStats_p;
+    if (cache_p != 0) {
+        stats += cache_p->statistics();
+    }
+    if (readCache_p != 0) {
+        stats += readCache_p->statistics();
+    }
+}
+
+void TSMCube::reopenRW()
+{
+    delete readCache_p;
+    readCache_p = 0;
+}
+
 uInt TSMCube::coordinateSize (const String& coordinateName) const
 {
     if (! values_p.isDefined (coordinateName)) {
@@ -378,6 +417,37 @@ void TSMCube::makeCache()
                                    readCallBack, writeCallBack,
                                    initCallBack, deleteCallBack);
     }
+    // A readonly file is read via a thread-safe cache.
+    if (readCache_p == 0  &&  !filePtr_p->bucketFile()->isWritable()) {
+        readCache_p = new ConcurrentBucketCache (filePtr_p->bucketFile(),
+                                                 fileOffset_p, bucketSize_p,
+                                                 nrTiles_p,
+                                                 cache_p->cacheSize(), this,
+                                                 readConcurrentCallBack,
+                                                 writeCallBack,
+                                                 deleteConcurrentCallBack);
+    }
+    // Adapt the cache size to the access pattern if wanted.
+    Int window = stmanPtr_p->tsmOption().adaptiveWindow();
+    if (adapter_p == 0  &&  window > 0) {
+        Int budgetMB = stmanPtr_p->tsmOption().cacheBudgetMB();
+        uInt64 budget = (budgetMB < 0  ?
+                         uInt64(HostInfo::memoryTotal(True) * 1024. * 0.25) :
+                         uInt64(budgetMB) * 1024 * 1024);
+        adapter_p = new TSMCacheAdapter (window, bucketSize_p, budget);
+        adapter_p->reserve (cache_p->cacheSize());
+    }
+}
+
+void TSMCube::adaptCache()
+{
+    if (adapter_p != 0  &&  !userSetCache_p  &&  cache_p != 0) {
+        uInt newSize = adapter_p->adapt (cache_p->cacheSize(),
+                                         validateCacheSize (nrTiles_p));
+        if (newSize > 0) {
+            resizeCache (newSize);
+        }
+    }
 }
 
 void TSMCube::flushCache()
@@ -392,12 +462,48 @@ void TSMCube::resyncCache()
     if (cache_p != 0) {
       cache_p->resync (nrTiles_p, 0, -1);
     }
+    if (readCache_p != 0) {
+      readCache_p->resync (nrTiles_p);
+    }
 }
 
 void TSMCube::deleteCache()
 {
+    if (cache_p != 0) {
+        deletedCacheStats_p += cache_p->statistics();
+    }
+    if (readCache_p != 0) {
+        deletedCacheStats_p += readCache_p->statistics();
+    }
+    delete readCache_p;
+    readCache_p = 0;
     delete cache_p;
     cache_p = 0;
+    delete adapter_p;
+    adapter_p = 0;
+}
+
+void TSMCube::resizeCache (uInt cacheSize)
+{
+    cache_p->resize (cacheSize);
+    if (readCache_p != 0) {
+        readCache_p->resize (cacheSize);
+    }
+}
+
+char* TSMCube::getTile (BucketCache* cachePtr, uInt tileNr, Bool writeFlag,
+                        ConcurrentBucketCache::Pin& pin)
+{
+    // A readonly file cannot be written, so the data are not changed.
+    if (readCache_p != 0) {
+        pin.pin (*readCache_p, tileNr);
+        return const_cast<char*>(pin.data());
+    }
+    char* dataArray = cachePtr->getBucket (tileNr);
+    if (writeFlag) {
+        cachePtr->setDirty();
+    }
+    return dataArray;
 }
 
 
@@ -675,10 +781,25 @@ char* TSMCube::readTile (const char* external)
         local = new char[localTileLength_p];
     }
 
+    readTile (local, external);
+    return local;
+}
+void TSMCube::readTile (char* local, const char* external)
+{
     stmanPtr_p->readTile (local, localOffset_p, external, externalOffset_p,
 			  tileSize_p);
+}
+char* TSMCube::readConcurrentCallBack (void* owner, const char* external)
+{
+    TSMCube* cube = (TSMCube*)owner;
+    char* local = new char[cube->localTileLength_p];
+    cube->readTile (local, external);
     return local;
 }
+void TSMCube::deleteConcurrentCallBack (void*, char* buffer)
+{
+    delete [] buffer;
+}
 void TSMCube::writeCallBack (void* owner, char* external, const char* local)
 {
     ((TSMCube*)owner)->writeTile (external, local);
@@ -740,8 +861,21 @@ void TSMCube::setCacheSize (uInt cacheSize, Bool forceSmaller, Bool userSet)
     // unless it is only 10% more.
     BucketCache* cachePtr = getCache();
     cacheSize = validateCacheSize (cacheSize);
+    // An adaptive cache has to fit in the global budget, while a cache
+    // set by the user is not part of it.
+    if (adapter_p != 0) {
+        if (userSet) {
+            adapter_p->release();
+        } else {
+            if (! forceSmaller) {
+                cacheSize = std::max (cacheSize, cachePtr->cacheSize());
+            }
+            cacheSize = adapter_p->reserve (cacheSize);
+            forceSmaller = True;
+        }
+    }
     if (forceSmaller  ||  cacheSize > cachePtr->cacheSize()) {
-        cachePtr->resize (cacheSize);
+        resizeCache (cacheSize);
     }
 ////    cout << "cachesize=" << cacheSize << endl;
     userSetCache_p = userSet;
@@ -902,6 +1036,48 @@ void TSMCube::resizeTileSections()
   return;
 }
 
+void TSMCube::prefetchTiles (const IPosition& start, const IPosition& end,
+                             Bool writeFlag)
+{
+    Int64 depth = stmanPtr_p->tsmOption().prefetchDepth();
+    if (writeFlag  ||  depth <= 0  ||  nrTiles_p == 0  ||  filePtr_p == 0) {
+        return;
+    }
+    // Determine the first and last tile of the section.
+    IPosition firstTile(nrdim_p);
+    IPosition lastTile(nrdim_p);
+    for (uInt i=0; i<nrdim_p; i++) {
+        firstTile(i) = start(i) / tileShape_p(i);
+        lastTile(i)  = end(i) / tileShape_p(i);
+    }
+    Int64 firstTileNr = expandedTilesPerDim_p.offset (firstTile);
+    Int64 lastTileNr  = expandedTilesPerDim_p.offset (lastTile);
+    // Only prefetch if the cube is read sequentially, thus if this section
+    // starts in or just after the tiles of the previous section.
+    // The first access is assumed to be the start of a sequential read.
+    Bool sequential = (prevStartTile_p < 0  ||
+                       (firstTileNr >= prevStartTile_p  &&
+                        firstTileNr <= prevEndTile_p + 1));
+    prevStartTile_p = firstTileNr;
+    prevEndTile_p   = lastTileNr;
+    if (! sequential) {
+        prefetchEnd_p = 0;
+        return;
+    }
+    // Prefetch the tiles of the next sections (assuming they have the same
+    // shape) skipping the tiles already prefetched.
+    // The tiles are stored in order, so they form a contiguous part of
+    // the file.
+    Int64 nrTiles = lastTileNr - firstTileNr + 1;
+    Int64 stTile  = std::max (lastTileNr + 1, prefetchEnd_p);
+    Int64 endTile = std::min (lastTileNr + depth*nrTiles + 1, Int64(nrTiles_p));
+    if (stTile < endTile) {
+        filePtr_p->bucketFile()->prefetch (fileOffset_p + stTile*bucketSize_p,
+                                           (endTile - stTile) * bucketSize_p);
+        prefetchEnd_p = endTile;
+    }
+}
+
 void TSMCube::accessSection (const IPosition& start, const IPosition& end,
                              char* section, uInt colnr,
                              uInt localPixelSize, uInt, Bool writeFlag)
@@ -910,6 +1086,8 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     if (writeFlag) {
 	stmanPtr_p->setDataChanged();
     }
+    // Tell the OS to read the next tiles if reading sequentially.
+    prefetchTiles (start, end, writeFlag);
     // Prepare for the iteration through the necessary tiles.
     uInt i, j;
 
@@ -943,8 +1121,11 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
             lineIndex = i;
         }
     }
-    // Get the cache.
+    // Get the cache (adapting its size if needed).
     BucketCache* cachePtr = getCache();
+    adaptCache();
+    // The pin keeping a tile in the read cache while it is accessed.
+    ConcurrentBucketCache::Pin pin;
     
 //    cout << "nrTileSection_p=" << nrTileSection_p << endl;
 //    cout << "startTile_p=" << startTile_p << endl;
@@ -963,12 +1144,11 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     if (oneEntireTile) {
         // Get the tile from the cache.
         uInt tileNr = expandedTilesPerDim_p.offset (startTile_p);
-        char* dataArray = cachePtr->getBucket (tileNr);
-        // If writing, set cache slot to dirty.
+        trackTile (tileNr);
+        char* dataArray = getTile (cachePtr, tileNr, writeFlag, pin);
         if (writeFlag) {
             memcpy (dataArray+pixelOffset, section,
 		    tileSize_p * localPixelSize);
-            cachePtr->setDirty();
         }else{
             memcpy (section, dataArray+pixelOffset,
 		    tileSize_p * localPixelSize);
@@ -980,7 +1160,7 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     // Note that a single pixel is also handled as a line.
     if (nOneLong >= nrdim_p - 1) {
         accessLine (section, pixelOffset, localPixelSize,
-                    writeFlag, cachePtr,
+                    writeFlag, cachePtr, pin,
                     startTile_p, endTile_p(lineIndex),
                     startPixelInFirstTile_p, endPixelInLastTile_p(lineIndex),
                     lineIndex);
@@ -1013,10 +1193,8 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
 //      cout << "end=" << endPixel << endl;
         // Get the tile from the cache.
         // Set it to dirty if we are writing.
-        char* dataArray = cachePtr->getBucket (tileNr);
-        if (writeFlag) {
-            cachePtr->setDirty();
-        }
+        trackTile (tileNr);
+        char* dataArray = getTile (cachePtr, tileNr, writeFlag, pin);
 
         // At this point we start looping through all pixels in the tile.
         // We do a vector at a time.
@@ -1100,6 +1278,7 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
 void TSMCube::accessLine (char* section, uInt pixelOffset,
                           uInt localPixelSize,
                           Bool writeFlag, BucketCache* cachePtr,
+                          ConcurrentBucketCache::Pin& pin,
                           const IPosition& startTile, uInt endTile,
                           const IPosition& startPixelInFirstTile,
                           uInt endPixelInLastTile,
@@ -1132,10 +1311,8 @@ void TSMCube::accessLine (char* section, uInt pixelOffset,
 //      cout << "nrpixel=" << nrPixel << endl;
         // Get the tile from the cache.
         // Set it to dirty if we are writing.
-        char* dataArray = cachePtr->getBucket (tileNr) + offset;
-        if (writeFlag) {
-            cachePtr->setDirty();
-        }
+        trackTile (tileNr);
+        char* dataArray = getTile (cachePtr, tileNr, writeFlag, pin) + offset;
         // Copy the data. If contiguous we can copy directly.
         // Otherwise loop through all pixels.
         if (contiguous) {
@@ -1311,9 +1488,14 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
     if (writeFlag) {
 	stmanPtr_p->setDataChanged();
     }
+    // Tell the OS to read the next tiles if reading sequentially.
+    prefetchTiles (start, end, writeFlag);
     uInt i, j;
-    // Get the cache (if needed).
+    // Get the cache (if needed) and adapt its size if needed.
     BucketCache* cachePtr = getCache();
+    adaptCache();
+    // The pin keeping a tile in the read cache while it is accessed.
+    ConcurrentBucketCache::Pin pin;
 
     // A tile can contain more than one data array.
     // Each array is contiguous, so the first pixel of an array
@@ -1380,10 +1562,8 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
 //      cout << "start=" << startPixel << endl;
         // Get the tile from the cache.
         // Set it to dirty if we are writing.
-        char* dataArray = cachePtr->getBucket (tileNr);
-        if (writeFlag) {
-            cachePtr->setDirty();
-        }
+        trackTile (tileNr);
+        char* dataArray = getTile (cachePtr, tileNr, writeFlag, pin);
 
         // At this point we start looping through all pixels in the tile.
         // We do a vector at a time.
@@ -33,6 +33,9 @@
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/IO/ConcurrentBucketCache.h>
+#include <casacore/tables/DataMan/TSMCacheAdapter.h>
 #include <casacore/casa/iosfwd.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -89,6 +92,18 @@ template<class T> class Block;
 // The description of class
 // <linkto class=ROTiledStManAccessor>ROTiledStManAccessor</linkto>
 // contains a discussion about the effect of setting the maximum cache size.
+// If adaptive caching is enabled in <linkto class=TSMOption>TSMOption</linkto>,
+// the cache size is adapted to the observed tile access pattern within a
+// global memory budget using a
+// <linkto class=TSMCacheAdapter>TSMCacheAdapter</linkto> object.
+// <p>
+// If the file is readonly, the tiles are read via a
+// <linkto class=ConcurrentBucketCache>ConcurrentBucketCache</linkto>
+// holding the tiles in local format. Its size follows the size of the
+// normal cache, which is still used for the bookkeeping of the size.
+// Note that only the tile cache is thread-safe; a TSMCube object keeps
+// the state of the last access, so it cannot be accessed by multiple
+// threads at the same time.
 // </synopsis> 
 
 // <motivation>
@@ -151,9 +166,16 @@ public:
     // It'll also clear the <src>userSetCache_p</src> flag.
     void emptyCache();
 
+    // The file has become writable, so the tiles have to be accessed
+    // via the normal cache instead of the read cache.
+    void reopenRW();
+
     // Show the cache statistics.
     virtual void showCacheStatistics (ostream& os) const;
 
+    // Add the statistics of the cache (including the caches deleted before).
+    void addCacheStatistics (BucketCacheStatistics& stats) const;
+
     // Put the data of the object into the AipsIO stream.
     void putObject (AipsIO& ios);
 
@@ -308,6 +330,13 @@ protected:
     // if nrdim_p changes value.
     void resizeTileSections();
 
+    // Tell the file to prefetch the tiles following the section to be
+    // read if the cube is accessed sequentially. The number of sections
+    // to prefetch is given by the prefetch depth in the TSMOption.
+    // Nothing is done when writing or if the depth is 0.
+    void prefetchTiles (const IPosition& start, const IPosition& end,
+                        Bool writeFlag);
+
 private:
     // Get the cache object.
     // This will construct the cache object if not present yet.
@@ -319,13 +348,32 @@ private:
     // Resync the cache object.
     virtual void resyncCache();
 
+    // Adapt the cache size to the access pattern if adaptive caching is used
+    // and the user did not set the cache size.
+    void adaptCache();
+
+    // Register the access to a tile for adaptive caching.
+    void trackTile (uInt tileNr);
+
     // Delete the cache object.
     virtual void deleteCache();
 
+    // Resize the cache and the read cache (if used).
+    void resizeCache (uInt cacheSize);
+
+    // Get a pointer to the tile in local format.
+    // If the read cache is used, the tile is pinned in it as long as
+    // <src>pin</src> is not pinned to another tile.
+    // Otherwise the tile is taken from the normal cache and marked as
+    // changed if writing.
+    char* getTile (BucketCache* cachePtr, uInt tileNr, Bool writeFlag,
+                   ConcurrentBucketCache::Pin& pin);
+
     // Access a line in a more optimized way.
     void accessLine (char* section, uInt pixelOffset,
 		     uInt localPixelSize,
 		     Bool writeFlag, BucketCache* cachePtr,
+		     ConcurrentBucketCache::Pin& pin,
 		     const IPosition& startTile, uInt endTile,
 		     const IPosition& startPixelInFirstTile,
 		     uInt endPixelInLastTile,
@@ -340,10 +388,19 @@ private:
     static void deleteCallBack (void* owner, char* buffer);
     // </group>
 
+    // Define the callback functions for the ConcurrentBucketCache.
+    // They can be called by multiple threads, so they do not use
+    // <src>cachedTile_p</src>.
+    // <group>
+    static char* readConcurrentCallBack (void* owner, const char* external);
+    static void deleteConcurrentCallBack (void* owner, char* buffer);
+    // </group>
+
     // Define the functions doing the actual read and write of the 
     // data in the tile and converting it to/from local format.
     // <group>
     char* readTile (const char* external);
+    void readTile (char* local, const char* external);
     void writeTile (char* external, const char* local);
     // </group>
 
@@ -392,12 +449,23 @@ protected:
     uInt            localTileLength_p;
     // The bucket cache.
     BucketCache*    cache_p;
+    // The thread-safe cache to read the tiles if the file is readonly.
+    ConcurrentBucketCache* readCache_p;
+    // The statistics of the caches deleted before.
+    BucketCacheStatistics deletedCacheStats_p;
     // Did the user set the cache size?
     Bool            userSetCache_p;
+    // The object adapting the cache size (0 = not adaptive).
+    TSMCacheAdapter* adapter_p;
     // Was the last column access to a cell, slice, or column?
     AccessType      lastColAccess_p;
     // The slice shape of the last column access to a slice.
     IPosition       lastColSlice_p;
+    // The first and last tile of the previous section read (for prefetching).
+    Int64           prevStartTile_p;
+    Int64           prevEndTile_p;
+    // The tile till which tiles have been prefetched.
+    Int64           prefetchEnd_p;
 
     // IPosition variables used in accessSection(); declared here
     // as member variables to avoid significant construction and
@@ -449,6 +517,13 @@ inline Record& TSMCube::rwValueRecord()
 {
     return values_p;
 }
+inline void TSMCube::trackTile (uInt tileNr)
+{
+    if (adapter_p != 0) {
+        adapter_p->access (tileNr);
+    }
+}
+
 inline Bool TSMCube::userSetCache() const
 {
     return userSetCache_p;
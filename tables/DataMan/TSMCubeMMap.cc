@@ -191,6 +191,8 @@ void TSMCubeMMap::accessSection (const IPosition& start, const IPosition& end,
   if (writeFlag) {
     stmanPtr_p->setDataChanged();
   }
+  // Tell the OS to read the next tiles if reading sequentially.
+  prefetchTiles (start, end, writeFlag);
 
   // Initialize the various variables and determine the number of
   // tiles needed (which will determine the cache size).
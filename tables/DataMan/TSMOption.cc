@@ -29,10 +29,14 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   TSMOption::TSMOption (TSMOption::Option option, Int bufferSize,
-                        Int maxCacheSizeMB)
-    : itsOption       (option),
-      itsBufferSize   (bufferSize),
-      itsMaxCacheSize (maxCacheSizeMB)
+                        Int maxCacheSizeMB, Int prefetchDepth,
+                        Int adaptiveWindow, Int cacheBudgetMB)
+    : itsOption         (option),
+      itsBufferSize     (bufferSize),
+      itsMaxCacheSize   (maxCacheSizeMB),
+      itsPrefetchDepth  (prefetchDepth),
+      itsAdaptiveWindow (adaptiveWindow),
+      itsCacheBudget    (cacheBudgetMB)
   {}
 
   void TSMOption::fillOption (Bool newTable)
@@ -65,6 +69,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (itsMaxCacheSize <= -2) {
       AipsrcValue<Int>::find (itsMaxCacheSize, "table.tsm.maxcachesizemb", -1);
     }
+    // Default is no prefetching.
+    if (itsPrefetchDepth <= -2) {
+      AipsrcValue<Int>::find (itsPrefetchDepth, "table.tsm.prefetchdepth", 0);
+    }
+    if (itsPrefetchDepth < 0) {
+      itsPrefetchDepth = 0;
+    }
+    // Default is no adaptive caching.
+    if (itsAdaptiveWindow <= -2) {
+      AipsrcValue<Int>::find (itsAdaptiveWindow, "table.tsm.adaptivewindow", 0);
+    }
+    if (itsAdaptiveWindow < 0) {
+      itsAdaptiveWindow = 0;
+    }
+    // Default budget is 25% of the memory.
+    if (itsCacheBudget <= -2) {
+      AipsrcValue<Int>::find (itsCacheBudget, "table.tsm.cachebudgetmb", -1);
+    }
     // Default is to use the old caching behaviour
     // Abandoned default to use mmap for existing files on 64 bit systems.
     if (itsOption == TSMOption::Default) {
@@ -107,6 +107,22 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //  <li> <src>table.tsm.buffersize</src> gives the buffer size for option
 //       <src>TSMOption::Buffer</src>. A value <=0 means use the default 4096.
 //       It defaults to 0.
+//  <li> <src>table.tsm.prefetchdepth</src> gives the number of tile sections
+//       to prefetch when reading a hypercube sequentially. It tells the
+//       operating system to read the tiles following the section being
+//       accessed in the background, so I/O is overlapped with processing.
+//       A value 0 means no prefetching.
+//       It defaults to 0.
+//  <li> <src>table.tsm.adaptivewindow</src> gives the number of tile
+//       accesses in the sliding window used to adapt the cache size
+//       to the observed access pattern for option <src>TSMOption::Cache</src>
+//       (see <linkto class=TSMCacheAdapter>TSMCacheAdapter</linkto>).
+//       A value 0 means that the cache size is not adapted.
+//       It defaults to 0.
+//  <li> <src>table.tsm.cachebudgetmb</src> gives the maximum size in MibiByte
+//       of all adaptive caches together. A value -1 means 25% of the
+//       memory. A value 0 means unlimited.
+//       It defaults to -1.
 // </ul>
 // </synopsis>
 
@@ -133,8 +149,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // A size value -2 means reading that size from the aipsrc file.
     // The buffer size has to be given in bytes.
     // The maximum cache size has to be given in MibiBytes (1024*1024 bytes).
+    // The prefetch depth has to be given in number of tile sections.
+    // The adaptive window has to be given in number of tile accesses.
     TSMOption (Option option=Aipsrc, Int bufferSize=-2,
-               Int maxCacheSizeMB=-2);
+               Int maxCacheSizeMB=-2, Int prefetchDepth=-2,
+               Int adaptiveWindow=-2, Int cacheBudgetMB=-2);
 
     // Fill the option in case Aipsrc or Default was given.
     // It is done as explained in the synopsis.
@@ -152,10 +171,27 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int maxCacheSizeMB() const
       { return itsMaxCacheSize; }
 
+    // Get the prefetch depth (in tile sections). 0 means no prefetching.
+    Int prefetchDepth() const
+      { return itsPrefetchDepth; }
+
+    // Get the adaptive cache window (in tile accesses).
+    // 0 means that the cache size is not adapted.
+    Int adaptiveWindow() const
+      { return itsAdaptiveWindow; }
+
+    // Get the budget of all adaptive caches (in MibiByte).
+    // -1 means 25% of the memory; 0 means unlimited.
+    Int cacheBudgetMB() const
+      { return itsCacheBudget; }
+
   private:
     Option itsOption;
     Int    itsBufferSize;
     Int    itsMaxCacheSize;
+    Int    itsPrefetchDepth;
+    Int    itsAdaptiveWindow;
+    Int    itsCacheBudget;
   };
 
 } //# NAMESPACE CASACORE - END
@@ -332,6 +332,11 @@ void TiledStMan::reopenRW()
 	    fileSet_p[i]->bucketFile()->setRW();
 	}
     }
+    for (uInt i=0; i<cubeSet_p.nelements(); i++) {
+	if (cubeSet_p[i] != 0) {
+	    cubeSet_p[i]->reopenRW();
+	}
+    }
 }
 
 void TiledStMan::deleteManager()
@@ -494,6 +499,15 @@ void TiledStMan::showCacheStatistics (ostream& os) const
     }
 }
 
+void TiledStMan::addCacheStatistics (BucketCacheStatistics& stats) const
+{
+    for (uInt i=0; i<cubeSet_p.nelements(); i++) {
+	if (cubeSet_p[i] != 0) {
+	    cubeSet_p[i]->addCacheStatistics (stats);
+	}
+    }
+}
+
 TSMCube* TiledStMan::singleHypercube()
 {
     if (cubeSet_p.nelements() != 1  ||  cubeSet_p[0] == 0) {
@@ -0,0 +1,141 @@
+//# tSSMConcurrent.cc: Test reading a StandardStMan table in multiple threads
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace casacore;
+
+// This program tests if multiple threads can read the same readonly
+// StandardStMan table. Its data buckets are read via a ConcurrentBucketCache.
+// A small cache is used, so buckets are removed from the cache while
+// other threads are reading.
+
+const rownr_t nrrow = 3000;
+
+Array<Float> dataValue (rownr_t row)
+{
+  Array<Float> data(IPosition(2,4,8));
+  indgen (data, Float(row));
+  return data;
+}
+
+void createTable (const String& name)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ID"));
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", IPosition(2,4,8),
+                                        ColumnDesc::Direct));
+  SetupNewTable newtab(name, td, Table::New);
+  // Use small buckets and a small cache.
+  StandardStMan ssm (-50, 4);
+  newtab.bindAll (ssm);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int> id(tab, "ID");
+  ArrayColumn<Float> data(tab, "DATA");
+  for (rownr_t i=0; i<nrrow; ++i) {
+    id.put (i, 2*i);
+    data.put (i, dataValue(i));
+  }
+}
+
+void readConcurrent (const Table& tab, uInt nthread)
+{
+  ScalarColumn<Int> id(tab, "ID");
+  ArrayColumn<Float> data(tab, "DATA");
+  std::atomic<uInt> nerr(0);
+  std::vector<std::thread> threads;
+  for (uInt t=0; t<nthread; ++t) {
+    threads.emplace_back ([&id, &data, &nerr, t, nthread]() {
+        // Each thread reads all arrays in a different order.
+        Array<Float> arr(IPosition(2,4,8));
+        for (rownr_t j=0; j<nrrow; ++j) {
+          rownr_t row = (j*(2*t+1) + 7*t) % nrrow;
+          data.get (row, arr);
+          if (! allEQ (arr, dataValue(row))) {
+            nerr++;
+          }
+        }
+        // Read the scalars in chunks.
+        for (rownr_t st=t; st<nrrow; st+=100*nthread) {
+          rownr_t n = std::min (rownr_t(100), nrrow-st);
+          Vector<Int> ids = id.getColumnRange (Slicer(IPosition(1,st),
+                                                      IPosition(1,n)));
+          for (rownr_t i=0; i<n; ++i) {
+            if (ids[i] != Int(2*(st+i))) {
+              nerr++;
+            }
+          }
+        }
+        // And the arrays in chunks.
+        for (rownr_t st=t*10; st<nrrow; st+=500) {
+          Array<Float> arrs = data.getColumnRange
+            (Slicer(IPosition(1,st), IPosition(1,10)));
+          if (! allEQ (arrs[9], dataValue(st+9))) {
+            nerr++;
+          }
+        }
+      });
+  }
+  for (auto& thr : threads) {
+    thr.join();
+  }
+  AlwaysAssertExit (nerr == 0);
+}
+
+int main()
+{
+  try {
+    createTable ("tSSMConcurrent_tmp.data");
+    Table tab("tSSMConcurrent_tmp.data", TableLock(TableLock::NoLocking));
+    readConcurrent (tab, 1);
+    readConcurrent (tab, 4);
+    readConcurrent (tab, 8);
+    // After reopening for read/write the normal bucket cache is used.
+    tab.reopenRW();
+    readConcurrent (tab, 1);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,266 @@
+//# tSSMMapped.cc: Test reading a StandardStMan table via a memory-mapped file
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <casacore/casa/fstream.h>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include <stdlib.h>
+
+using namespace casacore;
+
+// This program tests reading the fixed shape arrays of a StandardStMan
+// table via a memory-mapped file (aipsrc variable table.ssm.mmap).
+// The data of native Double and Complex arrays can be referenced without
+// copying if aligned, while Bool and String arrays are always copied.
+// The data are aligned for the column types used if a bucket contains
+// a multiple of 8 rows.
+
+const rownr_t nrrow = 2000;
+
+Array<Double> uvwValue (rownr_t row)
+{
+  Vector<Double> uvw(3);
+  indgen (uvw, Double(row), 0.5);
+  return uvw;
+}
+
+Array<Complex> dataValue (rownr_t row)
+{
+  Array<Complex> data(IPosition(2,4,2));
+  indgen (data, Complex(row, -Float(row)));
+  return data;
+}
+
+Array<Bool> flagValue (rownr_t row)
+{
+  Array<Bool> flag(IPosition(2,4,2), False);
+  flag.data()[row%8] = True;
+  return flag;
+}
+
+void createTable (const String& name, Int bucketRows)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ANTENNA1"));
+  td.addColumn (ArrayColumnDesc<Double> ("UVW", IPosition(1,3),
+                                         ColumnDesc::Direct));
+  td.addColumn (ArrayColumnDesc<Complex> ("DATA", IPosition(2,4,2),
+                                          ColumnDesc::Direct));
+  td.addColumn (ArrayColumnDesc<Bool> ("FLAG", IPosition(2,4,2),
+                                       ColumnDesc::Direct));
+  td.addColumn (ArrayColumnDesc<String> ("NAMES", IPosition(1,2),
+                                         ColumnDesc::Direct));
+  SetupNewTable newtab(name, td, Table::New);
+  // Use a small bucket size to get many buckets.
+  StandardStMan ssm (-bucketRows);
+  newtab.bindAll (ssm);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ArrayColumn<Double> uvw(tab, "UVW");
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  ArrayColumn<String> names(tab, "NAMES");
+  Vector<String> nm(2);
+  for (rownr_t i=0; i<nrrow; ++i) {
+    ant.put (i, i%27);
+    uvw.put (i, uvwValue(i));
+    data.put (i, dataValue(i));
+    flag.put (i, flagValue(i));
+    nm(0) = "a" + String::toString(i);
+    nm(1) = "b";
+    names.put (i, nm);
+  }
+}
+
+// Check the values. If expectView is true, the arrays of the native types
+// must reference the mapped data. If the data are not aligned, it is
+// not checked if the arrays reference the data.
+void checkTable (const Table& tab, const Vector<rownr_t>& rows,
+                 Bool expectView, Bool aligned=True)
+{
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ArrayColumn<Double> uvw(tab, "UVW");
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  ArrayColumn<String> names(tab, "NAMES");
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    rownr_t row = rows[i];
+    AlwaysAssertExit (ant(i) == Int(row%27));
+    Bool isView;
+    const Array<Double> uvwArr = uvw.getView (i, isView);
+    AlwaysAssertExit (isView == expectView  ||  !aligned);
+    AlwaysAssertExit (isView == False  ||  expectView);
+    AlwaysAssertExit (allEQ (uvwArr, uvwValue(row)));
+    AlwaysAssertExit (allEQ (uvw(i), uvwValue(row)));
+    const Array<Complex> dataArr = data.getView (i, isView);
+    AlwaysAssertExit (isView == expectView  ||  !aligned);
+    AlwaysAssertExit (isView == False  ||  expectView);
+    AlwaysAssertExit (allEQ (dataArr, dataValue(row)));
+    AlwaysAssertExit (allEQ (data(i), dataValue(row)));
+    // Bools are stored as bits, so they are always copied.
+    const Array<Bool> flagArr = flag.getView (i, isView);
+    AlwaysAssertExit (! isView);
+    AlwaysAssertExit (allEQ (flagArr, flagValue(row)));
+    const Array<String> namesArr = names.getView (i, isView);
+    AlwaysAssertExit (! isView);
+    AlwaysAssertExit (namesArr.data()[0] == "a" + String::toString(row));
+  }
+  // Getting the entire column gives the same result.
+  Array<Double> uvwCol = uvw.getColumn();
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (allEQ (uvwCol[i], uvwValue(rows[i])));
+  }
+  Vector<Int> antCol = ant.getColumn();
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (antCol[i] == Int(rows[i]%27));
+  }
+}
+
+// Tell if the memory at the given address is writable.
+// It can only be found out on Linux; otherwise True is returned.
+Bool isWritable (const void* ptr)
+{
+#ifdef __linux__
+  std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(ptr);
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  while (std::getline (maps, line)) {
+    std::uintptr_t start, end;
+    char perms[5];
+    if (sscanf (line.c_str(), "%" SCNxPTR "-%" SCNxPTR " %4s",
+                &start, &end, perms) == 3  &&
+        addr >= start  &&  addr < end) {
+      return perms[1] == 'w';
+    }
+  }
+#endif
+  return True;
+}
+
+void checkViews (const String& name)
+{
+  Vector<rownr_t> rows(nrrow);
+  indgen (rows);
+  {
+    // A writable table is never mapped.
+    Table tab(name, Table::Update);
+    checkTable (tab, rows, False);
+  }
+  // A view holds the mapping, so it stays valid after the table
+  // is reopened for read/write or closed.
+  Bool isView;
+  Array<Double> closedView;
+  {
+    Table tab(name);
+    checkTable (tab, rows, True);
+    ArrayColumn<Double> uvw(tab, "UVW");
+    const Array<Double> view = uvw.getView (10, isView);
+    AlwaysAssertExit (isView);
+    closedView.reference (uvw.getView (11));
+    const Array<Double> view2(view);
+    AlwaysAssertExit (view2.data() == view.data());
+    // The view is readonly memory (writing into it would crash), so a
+    // copy has to be made to change the values.
+#ifdef __linux__
+    AlwaysAssertExit (! isWritable (view.data()));
+#endif
+    Array<Double> viewCopy (view.copy());
+    AlwaysAssertExit (viewCopy.data() != view.data());
+    AlwaysAssertExit (isWritable (viewCopy.data()));
+    viewCopy = 0.;
+    AlwaysAssertExit (allEQ (view, uvwValue(10)));
+    for (rownr_t i=0; i<nrrow; ++i) {
+      uvw(i);
+    }
+    AlwaysAssertExit (allEQ (view, uvwValue(10)));
+    // Views can also be made via a reference table.
+    Vector<rownr_t> selRows(nrrow/3);
+    indgen (selRows, rownr_t(1), rownr_t(3));
+    Table sel = tab(selRows);
+    checkTable (sel, selRows, True);
+    // After reopening for read/write no views are made anymore and the
+    // data are read via the bucket cache, so changes are seen.
+    tab.reopenRW();
+    checkTable (tab, rows, False);
+    ArrayColumn<Double> uvwrw(tab, "UVW");
+    uvwrw.put (5, uvwValue(7));
+    AlwaysAssertExit (allEQ (uvwrw(5), uvwValue(7)));
+    uvwrw.put (5, uvwValue(5));
+    AlwaysAssertExit (allEQ (view, uvwValue(10)));
+  }
+  AlwaysAssertExit (allEQ (closedView, uvwValue(11)));
+}
+
+void checkUnaligned (const String& name)
+{
+  Vector<rownr_t> rows(nrrow);
+  indgen (rows);
+  Table tab(name);
+  // The data are copied if a cell is not aligned.
+  checkTable (tab, rows, True, False);
+  ArrayColumn<Double> uvw(tab, "UVW");
+  Bool isView;
+  const Array<Double> arr = uvw.getView (0, isView);
+  AlwaysAssertExit (! isView);
+  AlwaysAssertExit (allEQ (arr, uvwValue(0)));
+}
+
+int main()
+{
+  try {
+    // Use an aipsrc file telling to map the SSM files.
+    {
+      ofstream ofs("tSSMMapped_tmp.rc");
+      ofs << "table.ssm.mmap: true" << endl;
+    }
+    setenv ("CASARCFILES", "tSSMMapped_tmp.rc", 1);
+    createTable ("tSSMMapped_tmp.data", 32);
+    checkViews ("tSSMMapped_tmp.data");
+    // With 33 rows per bucket the data of UVW start at an odd Int.
+    createTable ("tSSMMapped_tmp.data2", 33);
+    checkUnaligned ("tSSMMapped_tmp.data2");
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,242 @@
+//# tStManZoneMap.cc: Test program for the zone maps in SSM and ISM
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/StManZoneMap.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for the zone maps in StandardStMan and IncrementalStMan
+// and their use in table selection.
+// </summary>
+
+typedef std::vector<std::pair<rownr_t,rownr_t>> RowRanges;
+
+// Create a time-ordered table with 10 rows per time.
+// TIME and SCAN are stored with the given storage manager, NAME with SSM.
+void createTable (const String& name, rownr_t nrrow, Bool useISM)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<Int> ("SCAN"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  SetupNewTable newtab(name, td, Table::New);
+  // Use small buckets to get many zones.
+  StandardStMan ssm("SSM", 1024);
+  IncrementalStMan ism("ISM", 1024);
+  newtab.bindAll (ssm);
+  if (useISM) {
+    newtab.bindColumn ("TIME", ism);
+    newtab.bindColumn ("SCAN", ism);
+  }
+  Table tab(newtab, nrrow);
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Int> scan(tab, "SCAN");
+  for (rownr_t i=0; i<nrrow; ++i) {
+    time.put (i, 4.5e9 + 10*(i/10));
+    scan.put (i, 1 + i/1000);
+  }
+}
+
+// Select by evaluating the expression for each row.
+Vector<rownr_t> bruteForce (const Table& tab, const TableExprNode& expr)
+{
+  std::vector<rownr_t> rows;
+  Bool value;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    expr.get (i, value);
+    if (value) {
+      rows.push_back (i);
+    }
+  }
+  return Vector<rownr_t>(rows);
+}
+
+Bool sameRows (const Vector<rownr_t>& rows1, const Vector<rownr_t>& rows2)
+{
+  return rows1.size() == rows2.size()  &&  allEQ (rows1, rows2);
+}
+
+rownr_t nrowInRanges (const RowRanges& ranges)
+{
+  rownr_t n = 0;
+  for (const auto& range : ranges) {
+    n += range.second - range.first + 1;
+  }
+  return n;
+}
+
+void checkSelect (const Table& tab, const TableExprNode& expr)
+{
+  Table sel = tab(expr);
+  AlwaysAssertExit (sameRows (sel.rowNumbers(tab), bruteForce (tab, expr)));
+}
+
+void testSelect (const String& name)
+{
+  Table tab(name);
+  const rownr_t nrrow = tab.nrow();
+  TableExprNode time = tab.col("TIME");
+  TableExprNode scan = tab.col("SCAN");
+  Double t1 = 4.5e9 + 10*100;
+  Double t2 = 4.5e9 + 10*120;
+  // The zone map must give a small part of the rows for a time range
+  // (ISM uses zones of 4096 rows).
+  RowRanges ranges;
+  Vector<Double> lower(1, t1);
+  Vector<Double> upper(1, t2);
+  AlwaysAssertExit (TableColumn(tab, "TIME").getZoneRanges (lower, upper,
+                                                            ranges));
+  AlwaysAssertExit (ranges.size() == 1);
+  AlwaysAssertExit (ranges[0].first <= 1000  &&  ranges[0].second >= 1209);
+  AlwaysAssertExit (nrowInRanges(ranges) < nrrow / 4);
+  // Columns with other types have no zone map.
+  AlwaysAssertExit (! TableColumn(tab, "NAME").getZoneRanges (lower, upper,
+                                                              ranges));
+  // Check the selection results against a full scan.
+  checkSelect (tab, time >= t1  &&  time <= t2);
+  checkSelect (tab, time > t1  &&  time < t2);
+  checkSelect (tab, time == t1);
+  checkSelect (tab, time < t1  ||  time > t2);
+  checkSelect (tab, time >= t1  &&  time <= t2  &&  scan == 1);
+  checkSelect (tab, (time >= t1  &&  time <= t2)  ||  scan == 3);
+  checkSelect (tab, time >= t1  &&  tab.col("NAME") == "");
+  checkSelect (tab, time < 0.);
+  checkSelect (tab, scan >= 2  &&  scan <= 3);
+  // A maximum number of rows and offset.
+  Table sel = tab(time >= t1, 5, 3);
+  AlwaysAssertExit (sel.nrow() == 5  &&  sel.rowNumbers(tab)[0] == 1003);
+  // Values put out of order make the zone incomplete.
+  {
+    Table tabu(name, Table::Update);
+    ScalarColumn<Double> timeCol(tabu, "TIME");
+    timeCol.put (nrrow-1, t1);
+    timeCol.put (5, t2);
+    TableExprNode timeu = tabu.col("TIME");
+    Table sel1 = tabu(timeu >= t1  &&  timeu <= t2);
+    AlwaysAssertExit (sel1.nrow() == 210 + 2);
+    AlwaysAssertExit (sel1.rowNumbers(tabu)[0] == 5);
+    AlwaysAssertExit (sel1.rowNumbers(tabu)[211] == nrrow-1);
+    // Removing a row shifts the rows after it.
+    tabu.removeRow (3);
+    sel1 = tabu(timeu >= t1  &&  timeu <= t2);
+    AlwaysAssertExit (sel1.nrow() == 212);
+    AlwaysAssertExit (sel1.rowNumbers(tabu)[0] == 4);
+    AlwaysAssertExit (sel1.rowNumbers(tabu)[1] == 999);
+    // Added rows are taken into account.
+    tabu.addRow (10);
+    for (rownr_t i=tabu.nrow()-10; i<tabu.nrow(); ++i) {
+      timeCol.put (i, t2);
+    }
+    sel1 = tabu(timeu >= t1  &&  timeu <= t2);
+    AlwaysAssertExit (sel1.nrow() == 222);
+    checkSelect (tabu, timeu >= t1  &&  timeu <= t2);
+  }
+}
+
+void testPersistent (const String& name, const String& dataFile)
+{
+  // The zone maps must have been written and match after reopening.
+  AlwaysAssertExit (File(name + "/" + dataFile + "z").exists());
+  Table tab(name);
+  Double t1 = 4.5e9 + 10*500;
+  RowRanges ranges1, ranges2;
+  Vector<Double> lower(1, t1);
+  AlwaysAssertExit (TableColumn(tab, "TIME").getZoneRanges (lower, lower,
+                                                            ranges1));
+  checkSelect (tab, tab.col("TIME") == t1);
+  {
+    Table tab2(name);
+    AlwaysAssertExit (TableColumn(tab2, "TIME").getZoneRanges (lower, lower,
+                                                               ranges2));
+  }
+  AlwaysAssertExit (ranges1 == ranges2);
+  AlwaysAssertExit (nrowInRanges(ranges1) < tab.nrow() / 4);
+}
+
+void testStamp (const String& name, const String& dataFile)
+{
+  // The zone map file holds the exact stamp of the data file.
+  String zoneFile = name + "/" + dataFile + "z";
+  String dataName = name + "/" + dataFile;
+  StManZoneMap::FileStamp stamp = StManZoneMap::fileStamp (dataName);
+  AlwaysAssertExit (stamp.size == Int64(File(dataName).size()));
+  StManZoneMap::FileStamp stampRead;
+  AlwaysAssertExit (! StManZoneMap::readFile (zoneFile, dataName,
+                                              Table(name).nrow(),
+                                              stampRead).empty());
+  AlwaysAssertExit (stampRead == stamp);
+  // A data file changed within the same second must be detected.
+  struct timespec times[2];
+  times[0].tv_sec  = stamp.sec;
+  times[0].tv_nsec = stamp.nsec;
+  times[1].tv_sec  = stamp.sec;
+  times[1].tv_nsec = (stamp.nsec + 1) % 1000000000;
+  AlwaysAssertExit (utimensat (AT_FDCWD, dataName.chars(), times, 0) == 0);
+  AlwaysAssertExit (StManZoneMap::readFile (zoneFile, dataName,
+                                            Table(name).nrow(),
+                                            stampRead).empty());
+  AlwaysAssertExit (stampRead.size < 0);
+  // Reset the time, so the zone maps can be used again.
+  times[1].tv_nsec = stamp.nsec;
+  AlwaysAssertExit (utimensat (AT_FDCWD, dataName.chars(), times, 0) == 0);
+  AlwaysAssertExit (! StManZoneMap::readFile (zoneFile, dataName,
+                                              Table(name).nrow(),
+                                              stampRead).empty());
+}
+
+int main()
+{
+  try {
+    createTable ("tStManZoneMap_tmp.ssm", 20000, False);
+    testPersistent ("tStManZoneMap_tmp.ssm", "table.f0");
+    testStamp ("tStManZoneMap_tmp.ssm", "table.f0");
+    testSelect ("tStManZoneMap_tmp.ssm");
+    createTable ("tStManZoneMap_tmp.ism", 20000, True);
+    testPersistent ("tStManZoneMap_tmp.ism", "table.f1");
+    testStamp ("tStManZoneMap_tmp.ism", "table.f1");
+    testSelect ("tStManZoneMap_tmp.ism");
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
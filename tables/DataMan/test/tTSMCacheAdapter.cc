@@ -0,0 +1,231 @@
+//# tTSMCacheAdapter.cc: Test program for the adaptive TSM cache sizing
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/TSMCacheAdapter.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class TSMCacheAdapter and its use in TSMCube.
+// </summary>
+
+// Feed the adapter a number of tile accesses and return the cache size
+// it decided on at the end of the window.
+uInt feed (TSMCacheAdapter& adapter, const std::vector<uInt>& tiles,
+           uInt currentSize)
+{
+  for (uInt tile : tiles) {
+    adapter.access (tile);
+  }
+  return adapter.adapt (currentSize, 1000000);
+}
+
+void testAdapter()
+{
+  // A cyclic pattern over 20 tiles needs a cache of 20 (plus margin).
+  {
+    TSMCacheAdapter adapter(200, 1024, 0);
+    std::vector<uInt> tiles;
+    for (uInt i=0; i<200; ++i) {
+      tiles.push_back (i%20);
+    }
+    // No decision before a full window.
+    AlwaysAssertExit (adapter.adapt (1, 1000000) == 0);
+    uInt size = feed (adapter, tiles, 1);
+    AlwaysAssertExit (adapter.workingSet() == 20);
+    AlwaysAssertExit (size == 22);
+    // The same pattern again does not change the size.
+    AlwaysAssertExit (feed (adapter, tiles, size) == 0);
+    // The maximum size is obeyed.
+    for (uInt tile : tiles) adapter.access (tile);
+    AlwaysAssertExit (adapter.adapt (1, 10) == 10);
+  }
+  // Streaming through tiles without reuse needs a single slot.
+  {
+    TSMCacheAdapter adapter(100, 1024, 0);
+    std::vector<uInt> tiles;
+    for (uInt i=0; i<100; ++i) {
+      tiles.push_back (i);
+    }
+    AlwaysAssertExit (feed (adapter, tiles, 50) == 1);
+    AlwaysAssertExit (adapter.workingSet() == 1);
+  }
+  // Repeated accesses to the same tile are counted once.
+  {
+    TSMCacheAdapter adapter(10, 1024, 0);
+    for (uInt i=0; i<100; ++i) {
+      adapter.access (3);
+    }
+    AlwaysAssertExit (adapter.adapt (1, 1000) == 0);
+  }
+  // Row-wise access where 2 rows share 4 tiles needs 4 slots.
+  // Shrinking is only done if less than half is needed.
+  {
+    TSMCacheAdapter adapter(256, 1024, 0);
+    std::vector<uInt> tiles;
+    for (uInt row=0; row<64; ++row) {
+      for (uInt j=0; j<4; ++j) {
+        tiles.push_back ((row/2)*4 + j);
+      }
+    }
+    AlwaysAssertExit (feed (adapter, tiles, 6) == 0);
+    AlwaysAssertExit (adapter.workingSet() == 4);
+    // Use the next tiles (otherwise the pattern is cyclic).
+    for (uInt& tile : tiles) {
+      tile += 128;
+    }
+    AlwaysAssertExit (feed (adapter, tiles, 100) == 4);
+  }
+  // The global budget is shared.
+  {
+    uInt64 before = TSMCacheAdapter::totalReserved();
+    TSMCacheAdapter adapter1(96, 1024, 30*1024);
+    TSMCacheAdapter adapter2(96, 1024, 30*1024);
+    AlwaysAssertExit (adapter1.reserve (20) == 20);
+    AlwaysAssertExit (TSMCacheAdapter::totalReserved() == before + 20*1024);
+    // Only 10 buckets are left for the second one.
+    // Use a multiple of the cycle length to keep the pattern cyclic.
+    std::vector<uInt> tiles;
+    for (uInt i=0; i<96; ++i) {
+      tiles.push_back (i%16);
+    }
+    AlwaysAssertExit (feed (adapter2, tiles, 1) == 10);
+    std::ostringstream os;
+    adapter2.show (os);
+    AlwaysAssertExit (String(os.str()).contains ("capped by budget 1 -> 10"));
+    // Releasing the first one makes room for the second one.
+    adapter1.release();
+    AlwaysAssertExit (feed (adapter2, tiles, 10) == 18);
+    AlwaysAssertExit (TSMCacheAdapter::totalReserved() == before + 18*1024);
+  }
+  AlwaysAssertExit (TSMCacheAdapter::totalReserved() == 0);
+}
+
+void createTable (const String& name, uInt nrrow)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", IPosition(2,16,8),
+                                        ColumnDesc::FixedShape));
+  SetupNewTable newtab(name, td, Table::New);
+  // A cell is spread over 2 tiles; each tile contains 2 rows.
+  TiledColumnStMan stman("TSM", IPosition(3,8,8,2));
+  newtab.bindAll (stman);
+  Table tab(newtab, nrrow);
+  ArrayColumn<Float> data(tab, "DATA");
+  Array<Float> arr(IPosition(2,16,8));
+  for (uInt i=0; i<nrrow; ++i) {
+    indgen (arr, Float(i));
+    data.put (i, arr);
+  }
+}
+
+void testTable (const String& name, uInt nrrow)
+{
+  // Open with adaptive caching using a window of 64 tile accesses.
+  Table tab(name, Table::Old,
+            TSMOption(TSMOption::Cache, 0, 0, 0, 64, 0));
+  ArrayColumn<Float> data(tab, "DATA");
+  ROTiledStManAccessor acc(tab, "TSM");
+  Array<Float> arr(IPosition(2,16,8));
+  // Read a slice (half a tile) in a range of 16 rows, whereafter the other
+  // half is read for the same rows. The default sizing makes a cache of
+  // 1 tile for such a slice, so all tiles would be read twice.
+  for (uInt start=0; start<nrrow; start+=16) {
+    for (uInt k=0; k<4; ++k) {
+      Slicer sl(IPosition(2,4*k,0), IPosition(2,4,8));
+      for (uInt i=start; i<start+16; ++i) {
+        Array<Float> part = data.getSlice (i, sl);
+        indgen (arr, Float(i));
+        AlwaysAssertExit (allEQ (part, arr(sl)));
+      }
+    }
+  }
+  std::ostringstream os;
+  acc.showCacheStatistics (os);
+  String stats(os.str());
+  // The decisions must have been logged and the cache must have grown
+  // to hold the 8 tiles of a slice in 16 rows.
+  AlwaysAssertExit (stats.contains ("adaptive:"));
+  AlwaysAssertExit (stats.contains ("grow"));
+  AlwaysAssertExit (acc.cacheSize(0) >= 8);
+  // Reading cells sequentially needs the 2 tiles of a cell only.
+  for (uInt i=0; i<nrrow; ++i) {
+    data.get (i, arr);
+  }
+  AlwaysAssertExit (acc.cacheSize(0) <= 3);
+  // A cache size set by the user is not changed.
+  acc.setCacheSize (0, 3);
+  for (uInt start=0; start<nrrow; start+=16) {
+    for (uInt k=0; k<4; ++k) {
+      Slicer sl(IPosition(2,4*k,0), IPosition(2,4,8));
+      for (uInt i=start; i<start+16; ++i) {
+        data.getSlice (i, sl);
+      }
+    }
+  }
+  AlwaysAssertExit (acc.cacheSize(0) == 3);
+}
+
+void testNotAdaptive (const String& name)
+{
+  // By default the cache is not adapted and no statistics are shown.
+  Table tab(name, Table::Old, TSMOption(TSMOption::Cache, 0, 0, 0, 0));
+  ArrayColumn<Float> data(tab, "DATA");
+  data.get (0);
+  ROTiledStManAccessor acc(tab, "TSM");
+  std::ostringstream os;
+  acc.showCacheStatistics (os);
+  AlwaysAssertExit (! String(os.str()).contains ("adaptive:"));
+}
+
+int main()
+{
+  try {
+    testAdapter();
+    createTable ("tTSMCacheAdapter_tmp.data", 512);
+    testTable ("tTSMCacheAdapter_tmp.data", 512);
+    testNotAdaptive ("tTSMCacheAdapter_tmp.data");
+    AlwaysAssertExit (TSMCacheAdapter::totalReserved() == 0);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,138 @@
+//# tTSMReadCache.cc: Test reading a readonly TiledStMan table via the read cache
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for reading the tiles of a readonly TiledStMan table
+// via the ConcurrentBucketCache in TSMCube.
+// </summary>
+
+const uInt nrrow = 64;
+
+void createTable (const String& name)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", IPosition(2,16,8),
+                                        ColumnDesc::FixedShape));
+  SetupNewTable newtab(name, td, Table::New);
+  // A cell is spread over 4 tiles; each tile contains 2 rows.
+  TiledColumnStMan stman("TSM", IPosition(3,8,4,2));
+  newtab.bindAll (stman);
+  Table tab(newtab, nrrow);
+  ArrayColumn<Float> data(tab, "DATA");
+  Array<Float> arr(IPosition(2,16,8));
+  for (uInt i=0; i<nrrow; ++i) {
+    indgen (arr, Float(i));
+    data.put (i, arr);
+  }
+}
+
+void checkData (ArrayColumn<Float>& data, Float offset)
+{
+  Array<Float> arr(IPosition(2,16,8));
+  // Read entire cells.
+  for (uInt i=0; i<nrrow; ++i) {
+    indgen (arr, Float(i) + offset);
+    AlwaysAssertExit (allEQ (data(i), arr));
+  }
+  // Read a line, a strided slice, and a section of the column.
+  Slicer line(IPosition(2,0,3), IPosition(2,16,1));
+  Slicer strided(IPosition(2,1,0), IPosition(2,5,3), IPosition(2,3,2));
+  for (uInt i=0; i<nrrow; ++i) {
+    indgen (arr, Float(i) + offset);
+    AlwaysAssertExit (allEQ (data.getSlice(i, line), arr(line)));
+    AlwaysAssertExit (allEQ (data.getSlice(i, strided), arr(strided)));
+  }
+  Array<Float> col = data.getColumnRange (Slicer(IPosition(1,3),
+                                                 IPosition(1,10)),
+                                          strided);
+  for (uInt i=0; i<10; ++i) {
+    indgen (arr, Float(i+3) + offset);
+    AlwaysAssertExit (allEQ (col[i], arr(strided)));
+  }
+}
+
+void testReadonly (const String& name)
+{
+  Table tab(name, Table::Old, TSMOption(TSMOption::Cache, 0, 0, 0, 0));
+  ArrayColumn<Float> data(tab, "DATA");
+  ROTiledStManAccessor acc(tab, "TSM");
+  // Use a cache that is too small for a cell, so tiles are removed.
+  acc.setCacheSize (0, 2);
+  checkData (data, 0);
+  std::ostringstream os;
+  acc.showCacheStatistics (os);
+  AlwaysAssertExit (String(os.str()).contains ("shards"));
+  // Growing the cache keeps the tiles.
+  acc.setCacheSize (0, 64);
+  AlwaysAssertExit (acc.cacheSize(0) == 64);
+  checkData (data, 0);
+  acc.clearCaches();
+  checkData (data, 0);
+  // After reopening for write, the tiles are accessed via the normal cache.
+  tab.reopenRW();
+  Array<Float> arr(IPosition(2,16,8));
+  for (uInt i=0; i<nrrow; ++i) {
+    indgen (arr, Float(i) + 100);
+    data.put (i, arr);
+  }
+  checkData (data, 100);
+  std::ostringstream os2;
+  acc.showCacheStatistics (os2);
+  AlwaysAssertExit (! String(os2.str()).contains ("shards"));
+}
+
+int main()
+{
+  try {
+    createTable ("tTSMReadCache_tmp.data");
+    testReadonly ("tTSMReadCache_tmp.data");
+    // Check the data written after reopening.
+    Table tab("tTSMReadCache_tmp.data");
+    ArrayColumn<Float> data(tab, "DATA");
+    checkData (data, 100);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -116,6 +116,10 @@ void testAll (const IPosition& arrayShape, const IPosition& tileShape)
   readTable (TSMOption::Cache);
   readTable (TSMOption::Buffer);
   readTable (TSMOption::MMap);
+  // Read with prefetching of tiles.
+  readTable (TSMOption(TSMOption::Cache, -2, -2, 2));
+  readTable (TSMOption(TSMOption::Buffer, -2, -2, 2));
+  readTable (TSMOption(TSMOption::MMap, -2, -2, 2));
 }
 
 int main()
@@ -90,6 +90,20 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   //  Functions in a command are handled by TableParseFunc.
   // </ol>
   //
+  // The TaQL style (given in a command like <src>USING STYLE PYTHON</src>)
+  // defines the origin of indices, the array axes order, and whether
+  // end values are inclusive. It can also ask for timing and tracing
+  // (TIME, NOTIME, TRACE, and NOTRACE) and tell how many threads can be
+  // used to evaluate the WHERE clause of a SELECT (THREADS=n; the default
+  // is 1). Multiple threads are only used if
+  // the WHERE clause consists of scalar constants, scalar numeric or Bool
+  // columns, and operators and functions that can be evaluated for a block
+  // of rows, and if no LIMIT or OFFSET is given (see class TaQLStyle).
+  // Array columns are not supported, thus a WHERE using an array column is
+  // evaluated by a single thread. GROUPBY and aggregate functions are
+  // always evaluated by a single thread, because the partial results of
+  // multiple threads are not merged.
+  //
   // Expression trees can also be generated directly in C++ using class
   // TableExprNode which is overloaded for many operators and functions
   // (such as sin, max, etc.). In fact, TaQLNodeHandler uses this code.
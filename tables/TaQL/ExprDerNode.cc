@@ -29,6 +29,9 @@
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/TableLock.h>
+#include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Utilities/DataType.h>
@@ -37,6 +40,8 @@
 #include <casacore/casa/OS/Time.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#include <type_traits>
 
 
 
@@ -50,6 +55,9 @@ TableExprNodeConstBool::TableExprNodeConstBool (const Bool& val)
 {}
 Bool TableExprNodeConstBool::getBool (const TableExprId&)
     { return value_p; }
+void TableExprNodeConstBool::getBoolBlock (rownr_t, rownr_t nrow,
+                                           Bool* values)
+    { std::fill (values, values+nrow, value_p); }
 
 TableExprNodeConstInt::TableExprNodeConstInt (const Int64& val)
 : TableExprNodeBinary (NTInt, VTScalar, OtLiteral, Constant),
@@ -61,6 +69,12 @@ Double TableExprNodeConstInt::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstInt::getDComplex (const TableExprId&)
     { return double(value_p); }
+void TableExprNodeConstInt::getIntBlock (rownr_t, rownr_t nrow,
+                                         Int64* values)
+    { std::fill (values, values+nrow, value_p); }
+void TableExprNodeConstInt::getDoubleBlock (rownr_t, rownr_t nrow,
+                                            Double* values)
+    { std::fill (values, values+nrow, Double(value_p)); }
 
 TableExprNodeConstDouble::TableExprNodeConstDouble (const Double& val)
 : TableExprNodeBinary (NTDouble, VTScalar, OtLiteral, Constant),
@@ -70,6 +84,9 @@ Double TableExprNodeConstDouble::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstDouble::getDComplex (const TableExprId&)
     { return value_p; }
+void TableExprNodeConstDouble::getDoubleBlock (rownr_t, rownr_t nrow,
+                                               Double* values)
+    { std::fill (values, values+nrow, value_p); }
 
 TableExprNodeConstDComplex::TableExprNodeConstDComplex (const DComplex& val)
 : TableExprNodeBinary (NTComplex, VTScalar, OtLiteral, Constant),
@@ -119,6 +136,7 @@ TableExprNodeColumn::TableExprNodeColumn (const TableExprInfo& tableInfo,
     if (! tabCol_p.columnDesc().isScalar()) {
         throw (TableInvExpr (name, " is no scalar column"));
     }
+    readMutex_p = getReadMutex (tableInfo.table(), name);
     //# Fill in the real data type and the base table pointer.
     switch (tabCol_p.columnDesc().dataType()) {
     case TpBool:
@@ -186,35 +204,187 @@ void TableExprNodeColumn::applySelection (const Vector<rownr_t>& rownrs)
 const TableColumn& TableExprNodeColumn::getColumn() const
     { return tabCol_p; }
 
-Bool TableExprNodeColumn::getBool (const TableExprId& id)
+template<typename T>
+T TableExprNodeColumn::getValue (const TableExprId& id)
 {
-    Bool val;
-    tabCol_p.getScalar (id.rownr(), val);
+    T val;
+    if (theirLockRowReads) {
+        std::lock_guard<std::mutex> lock(*readMutex_p);
+        tabCol_p.getScalar (id.rownr(), val);
+    } else {
+        tabCol_p.getScalar (id.rownr(), val);
+    }
     return val;
 }
+
+Bool TableExprNodeColumn::getBool (const TableExprId& id)
+{
+    return getValue<Bool> (id);
+}
 Int64 TableExprNodeColumn::getInt (const TableExprId& id)
 {
-    Int64 val;
-    tabCol_p.getScalar (id.rownr(), val);
-    return val;
+    return getValue<Int64> (id);
 }
 Double TableExprNodeColumn::getDouble (const TableExprId& id)
 {
-    Double val;
-    tabCol_p.getScalar (id.rownr(), val);
-    return val;
+    return getValue<Double> (id);
 }
 DComplex TableExprNodeColumn::getDComplex (const TableExprId& id)
 {
-    DComplex val;
-    tabCol_p.getScalar (id.rownr(), val);
-    return val;
+    return getValue<DComplex> (id);
 }
 String TableExprNodeColumn::getString (const TableExprId& id)
 {
-    String val;
-    tabCol_p.getScalar (id.rownr(), val);
-    return val;
+    return getValue<String> (id);
+}
+
+std::map<String, std::weak_ptr<std::mutex>>
+  TableExprNodeColumn::theirReadMutexes;
+std::mutex TableExprNodeColumn::theirMutex;
+thread_local Bool TableExprNodeColumn::theirLockRowReads = False;
+
+std::shared_ptr<std::mutex> TableExprNodeColumn::getReadMutex
+                                  (const Table& table, const String& name)
+{
+    //# Use the data manager as key if only that one is used for a read.
+    //# It is the name of the root table followed by the data manager's
+    //# sequence number. An empty key is used for all tables where that
+    //# cannot be determined (e.g., a concatenated table).
+    String key;
+    try {
+        if (! table.isNull()  &&  table.getPartNames().size() == 1) {
+            DataManager* dm = table.findDataManager (name, True);
+            const Table& root = dm->table();
+            key = root.tableName();
+            //# Locks can be acquired or released when reading, which
+            //# affects the entire table.
+            const TableLock& lockOpt = table.lockOptions();
+            Bool tableWide = ! (TableLock::lockingDisabled()  ||
+                                lockOpt.isPermanent()  ||
+                                lockOpt.option() == TableLock::NoLocking);
+            //# A virtual column engine reads other columns.
+            Vector<String> colNames = root.tableDesc().columnNames();
+            for (uInt i=0; i<colNames.size()  &&  !tableWide; ++i) {
+                tableWide = ! root.findDataManager(colNames[i], True)
+                                                 ->isStorageManager();
+            }
+            if (! tableWide) {
+                key += '/' + String::toString (dm->sequenceNr());
+            }
+        }
+    } catch (const std::exception&) {
+        key = String();
+    }
+    std::lock_guard<std::mutex> lock(theirMutex);
+    std::weak_ptr<std::mutex>& wptr = theirReadMutexes[key];
+    std::shared_ptr<std::mutex> mutex = wptr.lock();
+    if (! mutex) {
+        mutex = std::make_shared<std::mutex>();
+        wptr = mutex;
+    }
+    //# Remove the entries of mutexes no longer in use.
+    for (auto iter = theirReadMutexes.begin();
+         iter != theirReadMutexes.end();) {
+        if (iter->second.expired()) {
+            iter = theirReadMutexes.erase (iter);
+        } else {
+            ++iter;
+        }
+    }
+    return mutex;
+}
+
+// Read a block of rows from a scalar column of type T into the buffer,
+// converting the values to type U.
+// The buffer is used directly if no conversion is needed.
+template<typename T, typename U>
+void getColumnBlock (const TableColumn& tabCol, rownr_t startRow,
+                     rownr_t nrow, U* values)
+{
+    ScalarColumn<T> col (tabCol);
+    Slicer slicer (IPosition(1, startRow), IPosition(1, nrow));
+    if constexpr (std::is_same<T,U>::value) {
+        Vector<T> vec (IPosition(1, nrow), values, SHARE);
+        col.getColumnRange (slicer, vec);
+    } else {
+        Vector<T> vec (nrow);
+        col.getColumnRange (slicer, vec);
+        std::copy (vec.cbegin(), vec.cend(), values);
+    }
+}
+
+void TableExprNodeColumn::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                        Bool* values)
+{
+    // A data manager cannot be read by multiple threads at the same time.
+    std::lock_guard<std::mutex> lock(*readMutex_p);
+    if (tabCol_p.columnDesc().dataType() == TpBool) {
+        getColumnBlock<Bool> (tabCol_p, startRow, nrow, values);
+    } else {
+        TableExprNodeRep::getBoolBlock (startRow, nrow, values);
+    }
+}
+void TableExprNodeColumn::getIntBlock (rownr_t startRow, rownr_t nrow,
+                                       Int64* values)
+{
+    // A data manager cannot be read by multiple threads at the same time.
+    std::lock_guard<std::mutex> lock(*readMutex_p);
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        getColumnBlock<uChar>  (tabCol_p, startRow, nrow, values);
+        break;
+    case TpShort:
+        getColumnBlock<Short>  (tabCol_p, startRow, nrow, values);
+        break;
+    case TpUShort:
+        getColumnBlock<uShort> (tabCol_p, startRow, nrow, values);
+        break;
+    case TpInt:
+        getColumnBlock<Int>    (tabCol_p, startRow, nrow, values);
+        break;
+    case TpUInt:
+        getColumnBlock<uInt>   (tabCol_p, startRow, nrow, values);
+        break;
+    case TpInt64:
+        getColumnBlock<Int64>  (tabCol_p, startRow, nrow, values);
+        break;
+    default:
+        TableExprNodeRep::getIntBlock (startRow, nrow, values);
+    }
+}
+void TableExprNodeColumn::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                          Double* values)
+{
+    // A data manager cannot be read by multiple threads at the same time.
+    std::lock_guard<std::mutex> lock(*readMutex_p);
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        getColumnBlock<uChar>  (tabCol_p, startRow, nrow, values);
+        break;
+    case TpShort:
+        getColumnBlock<Short>  (tabCol_p, startRow, nrow, values);
+        break;
+    case TpUShort:
+        getColumnBlock<uShort> (tabCol_p, startRow, nrow, values);
+        break;
+    case TpInt:
+        getColumnBlock<Int>    (tabCol_p, startRow, nrow, values);
+        break;
+    case TpUInt:
+        getColumnBlock<uInt>   (tabCol_p, startRow, nrow, values);
+        break;
+    case TpInt64:
+        getColumnBlock<Int64>  (tabCol_p, startRow, nrow, values);
+        break;
+    case TpFloat:
+        getColumnBlock<Float>  (tabCol_p, startRow, nrow, values);
+        break;
+    case TpDouble:
+        getColumnBlock<Double> (tabCol_p, startRow, nrow, values);
+        break;
+    default:
+        TableExprNodeRep::getDoubleBlock (startRow, nrow, values);
+    }
 }
 
 Bool TableExprNodeColumn::getColumnDataType (DataType& dt) const
@@ -32,6 +32,9 @@
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/BasicMath/Random.h>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -76,6 +79,8 @@ public:
     TableExprNodeConstBool (const Bool& value);
     ~TableExprNodeConstBool() override = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
 private:
     Bool value_p;
 };
@@ -109,6 +114,10 @@ public:
     Int64    getInt      (const TableExprId& id) override;
     Double   getDouble   (const TableExprId& id) override;
     DComplex getDComplex (const TableExprId& id) override;
+    void getIntBlock    (rownr_t startRow, rownr_t nrow,
+                         Int64* values) override;
+    void getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                         Double* values) override;
 private:
     Int64 value_p;
 };
@@ -141,6 +150,8 @@ public:
     ~TableExprNodeConstDouble() override = default;
     Double   getDouble   (const TableExprId& id) override;
     DComplex getDComplex (const TableExprId& id) override;
+    void getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                         Double* values) override;
 private:
     Double value_p;
 };
@@ -313,6 +324,8 @@ public:
     Bool getColumnDataType (DataType&) const override;
 
     // Get the data for the given id.
+    // The read is serialized by the mutex used for the block reads if
+    // <src>setLockRowReads(True)</src> was done in the calling thread.
     Bool     getBool     (const TableExprId& id) override;
     Int64    getInt      (const TableExprId& id) override;
     Double   getDouble   (const TableExprId& id) override;
@@ -320,6 +333,30 @@ public:
     String   getString   (const TableExprId& id) override;
     const TableColumn& getColumn() const;
 
+    // Tell if the calling thread has to serialize the reads of single rows,
+    // so multiple threads can evaluate an expression row by row (as done
+    // by a parallel GROUPBY). By default the reads are not serialized.
+    // <br>Note that the block functions must not be used by a thread
+    // having set it, because the block functions can read single rows
+    // while holding the mutex.
+    static void setLockRowReads (Bool lockRowReads)
+      { theirLockRowReads = lockRowReads; }
+
+    // Get the data for a block of rows using a bulk read of the column.
+    // Data types not supported by a block function are handled row by row.
+    // The reads are serialized by a mutex per data manager, so multiple
+    // threads can get blocks of rows. Columns in different storage managers
+    // can be read at the same time, unless the table uses automatic locking
+    // or contains virtual columns. In that case all columns of the table
+    // share the same mutex, because a read can change the lock state or
+    // can read other columns.
+    void getBoolBlock   (rownr_t startRow, rownr_t nrow,
+                         Bool* values) override;
+    void getIntBlock    (rownr_t startRow, rownr_t nrow,
+                         Int64* values) override;
+    void getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                         Double* values) override;
+
     // Get the data for the given rows.
     Array<Bool>     getColumnBool (const Vector<rownr_t>& rownrs) override;
     Array<uChar>    getColumnuChar (const Vector<rownr_t>& rownrs) override;
@@ -341,6 +378,25 @@ protected:
     TableExprInfo tableInfo_p;
     TableColumn   tabCol_p;
     Bool          applySelection_p;
+    //# Mutex to serialize the bulk reads of column data.
+    std::shared_ptr<std::mutex> readMutex_p;
+
+private:
+    // Get the mutex to use for the bulk reads of the given column.
+    // The same mutex is returned for all columns sharing a data manager
+    // (or table, see getBoolBlock).
+    static std::shared_ptr<std::mutex> getReadMutex (const Table& table,
+                                                     const String& columnName);
+
+    // Read the value of a row, serialized if needed.
+    template<typename T> T getValue (const TableExprId& id);
+
+    //# The mutexes in use, keyed by data manager or table.
+    static std::map<String, std::weak_ptr<std::mutex>> theirReadMutexes;
+    //# Mutex to guard theirReadMutexes.
+    static std::mutex theirMutex;
+    //# Serialize the reads of single rows in this thread?
+    static thread_local Bool theirLockRowReads;
 };
 
 
@@ -863,6 +863,173 @@ Double TableExprFuncNode::getDouble (const TableExprId& id)
     return 0;
 }
 
+// Evaluate the operand for a block of rows and apply a function to each value.
+template<typename OP>
+void funcBlock1 (const TENShPtr& arg, rownr_t startRow, rownr_t nrow,
+                 Double* values, OP op)
+{
+    arg->getDoubleBlock (startRow, nrow, values);
+    for (rownr_t i=0; i<nrow; ++i) {
+        values[i] = op(values[i]);
+    }
+}
+
+// Evaluate both operands for a block of rows and apply a function
+// to each pair of values.
+template<typename RES, typename OP>
+void funcBlock2 (const TENShPtr& arg1, const TENShPtr& arg2,
+                 rownr_t startRow, rownr_t nrow, RES* values, OP op)
+{
+    Block<Double> val1(nrow);
+    Block<Double> val2(nrow);
+    arg1->getDoubleBlock (startRow, nrow, val1.storage());
+    arg2->getDoubleBlock (startRow, nrow, val2.storage());
+    for (rownr_t i=0; i<nrow; ++i) {
+        values[i] = op(val1[i], val2[i]);
+    }
+}
+
+void TableExprFuncNode::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                      Bool* values)
+{
+    // Only some elementwise functions of Double arguments are done
+    // for the entire block; all others are done row by row.
+    if (argDataType_p == NTDouble) {
+        switch (funcType_p) {
+        case near2FUNC:
+            funcBlock2 (operands_p[0], operands_p[1], startRow, nrow, values,
+                        [](Double v1, Double v2)
+                        { return near (v1, v2, 1.0e-13); });
+            return;
+        case nearabs2FUNC:
+            funcBlock2 (operands_p[0], operands_p[1], startRow, nrow, values,
+                        [](Double v1, Double v2)
+                        { return nearAbs (v1, v2, 1.0e-13); });
+            return;
+        default:
+            break;
+        }
+    }
+    TableExprNodeRep::getBoolBlock (startRow, nrow, values);
+}
+
+void TableExprFuncNode::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                        Double* values)
+{
+    // Only elementwise functions of Double values are done for the
+    // entire block; all others are done row by row.
+    // Note that getDouble uses getInt if the result is an integer.
+    if (dataType() == NTDouble) {
+        const TENShPtr& arg = operands_p.empty() ? TENShPtr() : operands_p[0];
+        switch (funcType_p) {
+        case sinFUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return sin(v); });
+            return;
+        case cosFUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return cos(v); });
+            return;
+        case expFUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return exp(v); });
+            return;
+        case logFUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return log(v); });
+            return;
+        case log10FUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return log10(v); });
+            return;
+        case squareFUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return v*v; });
+            return;
+        case cubeFUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return v*v*v; });
+            return;
+        case sqrtFUNC:
+          {
+            Double scale = scale_p;
+            funcBlock1 (arg, startRow, nrow, values,
+                        [scale](Double v) { return sqrt(v) * scale; });
+            return;
+          }
+        case floorFUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return floor(v); });
+            return;
+        case ceilFUNC:
+            funcBlock1 (arg, startRow, nrow, values,
+                        [](Double v) { return ceil(v); });
+            return;
+        case powFUNC:
+            funcBlock2 (arg, operands_p[1], startRow, nrow, values,
+                        [](Double v1, Double v2) { return pow(v1, v2); });
+            return;
+        case minFUNC:
+            funcBlock2 (arg, operands_p[1], startRow, nrow, values,
+                        [](Double v1, Double v2) { return min(v1, v2); });
+            return;
+        case maxFUNC:
+            funcBlock2 (arg, operands_p[1], startRow, nrow, values,
+                        [](Double v1, Double v2) { return max(v1, v2); });
+            return;
+        case atan2FUNC:
+            funcBlock2 (arg, operands_p[1], startRow, nrow, values,
+                        [](Double v1, Double v2) { return atan2(v1, v2); });
+            return;
+        case fmodFUNC:
+            funcBlock2 (arg, operands_p[1], startRow, nrow, values,
+                        [](Double v1, Double v2) { return fmod(v1, v2); });
+            return;
+        case absFUNC:
+            if (argDataType_p == NTDouble) {
+                funcBlock1 (arg, startRow, nrow, values,
+                            [](Double v) { return abs(v); });
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    TableExprNodeRep::getDoubleBlock (startRow, nrow, values);
+}
+
+Bool TableExprFuncNode::hasBlockEval() const
+{
+    // Note this must match the cases handled in the block functions.
+    switch (funcType_p) {
+    case near2FUNC:
+    case nearabs2FUNC:
+        return argDataType_p == NTDouble;
+    case sinFUNC:
+    case cosFUNC:
+    case expFUNC:
+    case logFUNC:
+    case log10FUNC:
+    case squareFUNC:
+    case cubeFUNC:
+    case sqrtFUNC:
+    case floorFUNC:
+    case ceilFUNC:
+    case powFUNC:
+    case minFUNC:
+    case maxFUNC:
+    case atan2FUNC:
+    case fmodFUNC:
+        return dataType() == NTDouble;
+    case absFUNC:
+        return dataType() == NTDouble  &&  argDataType_p == NTDouble;
+    default:
+        break;
+    }
+    return False;
+}
+
 DComplex TableExprFuncNode::getDComplex (const TableExprId& id)
 {
     if (dataType() == NTDouble) {
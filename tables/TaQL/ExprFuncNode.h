@@ -365,6 +365,20 @@ public:
     MVTime    getDate     (const TableExprId& id);
     // </group>
 
+    // Block versions of the get functions. Only the elementwise functions
+    // of Double values are evaluated for the entire block at once.
+    // Other functions are evaluated row by row.
+    // <group>
+    void getBoolBlock   (rownr_t startRow, rownr_t nrow,
+                         Bool* values) override;
+    void getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                         Double* values) override;
+    // </group>
+
+    // Tell if the function is evaluated for the entire block at once
+    // by the block functions above.
+    Bool hasBlockEval() const;
+
     // Check the data and value types of the operands.
     // It sets the exptected data and value types of the operands.
     // Set the value type of the function result and returns
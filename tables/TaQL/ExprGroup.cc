@@ -163,6 +163,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     { return False; }
   void TableExprGroupFuncBase::finish()
   {}
+  Bool TableExprGroupFuncBase::canMerge() const
+    { return False; }
+  void TableExprGroupFuncBase::merge (const TableExprGroupFuncBase&)
+  { throw TableInvExpr ("TableExprGroupFuncBase::merge not implemented"); }
   std::shared_ptr<vector<TableExprId>> TableExprGroupFuncBase::getIds() const
   { throw TableInvExpr ("TableExprGroupFuncBase::getIds not implemented"); }
   Bool TableExprGroupFuncBase::getBool (const vector<TableExprId>&)
@@ -216,6 +220,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsId = id;
     }
   }
+  Bool TableExprGroupFirst::canMerge() const
+    { return True; }
+  void TableExprGroupFirst::merge (const TableExprGroupFuncBase& other)
+  {
+    apply (dynamic_cast<const TableExprGroupFirst&>(other).itsId);
+  }
   Bool TableExprGroupFirst::getBool (const vector<TableExprId>&)
     { return itsOperand->getBool (itsId); }
   Int64 TableExprGroupFirst::getInt (const vector<TableExprId>&)
@@ -250,6 +260,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsId = id;
   }
+  void TableExprGroupLast::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupLast& that =
+      dynamic_cast<const TableExprGroupLast&>(other);
+    if (that.itsId.rownr() >= 0) {
+      itsId = that.itsId;
+    }
+  }
 
   TableExprGroupExprId::TableExprGroupExprId (TableExprNodeRep* node)
     : TableExprGroupFuncBase (node)
@@ -266,6 +284,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsIds->push_back (id);
   }
+  Bool TableExprGroupExprId::canMerge() const
+    { return True; }
+  void TableExprGroupExprId::merge (const TableExprGroupFuncBase& other)
+  {
+    const std::vector<TableExprId>& ids =
+      *dynamic_cast<const TableExprGroupExprId&>(other).itsIds;
+    itsIds->insert (itsIds->end(), ids.begin(), ids.end());
+  }
   std::shared_ptr<vector<TableExprId>> TableExprGroupExprId::getIds() const
   {
     return itsIds;
@@ -489,5 +515,23 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  Bool TableExprGroupFuncSet::canMerge() const
+  {
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      if (! itsFuncs[i]->canMerge()) {
+        return False;
+      }
+    }
+    return True;
+  }
+
+  void TableExprGroupFuncSet::merge (const TableExprGroupFuncSet& other)
+  {
+    itsId = other.itsId;
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      itsFuncs[i]->merge (*other.itsFuncs[i]);
+    }
+  }
+
 
 } //# NAMESPACE CASACORE - END
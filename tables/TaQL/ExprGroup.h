@@ -221,6 +221,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // If needed, finish the aggregation.
     // By default nothing is done.
     virtual void finish();
+    // Can the partial aggregation of another object of the same class
+    // be merged into this object?
+    // The default implementation returns False.
+    virtual Bool canMerge() const;
+    // Merge the partial aggregation of another object of the same class
+    // into this object. The other object has aggregated the rows following
+    // the rows aggregated by this object, so the merge is done in row order.
+    // It must be done before <src>finish</src> is called.
+    // The default implementation throws an exception.
+    virtual void merge (const TableExprGroupFuncBase& other);
     // Get the assembled TableExprIds of a group. It is specifically meant
     // for TableExprGroupExprId used for lazy aggregation.
     virtual std::shared_ptr<vector<TableExprId>> getIds() const;
@@ -285,6 +295,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupFirst (TableExprNodeRep* node);
     virtual ~TableExprGroupFirst();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& other);
     virtual Bool getBool (const vector<TableExprId>&);
     virtual Int64 getInt (const vector<TableExprId>&);
     virtual Double getDouble (const vector<TableExprId>&);
@@ -318,6 +330,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupLast (TableExprNodeRep* node);
     virtual ~TableExprGroupLast();
     virtual void apply (const TableExprId& id);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -338,6 +351,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     virtual ~TableExprGroupExprId();
     virtual Bool isLazy() const;
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& other);
     virtual std::shared_ptr<vector<TableExprId>> getIds() const;
   private:
     std::shared_ptr<vector<TableExprId>> itsIds;
@@ -815,6 +830,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Apply the functions to the given row.
     void apply (const TableExprId& id);
 
+    // Can all functions merge a partial aggregation?
+    Bool canMerge() const;
+
+    // Merge the functions of a set aggregating the rows following the rows
+    // of this set (see <src>TableExprGroupFuncBase::merge</src>).
+    // The TableExprId of the other set (thus its last row) is used.
+    void merge (const TableExprGroupFuncSet& other);
+
     // Get the vector of functions.
     const vector<std::shared_ptr<TableExprGroupFuncBase>>& getFuncs() const
       { return itsFuncs; }
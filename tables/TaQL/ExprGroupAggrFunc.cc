@@ -47,6 +47,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue++;
   }
+  Bool TableExprGroupCountAll::canMerge() const
+    { return True; }
+  void TableExprGroupCountAll::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupCountAll& that =
+      dynamic_cast<const TableExprGroupCountAll&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupCount::TableExprGroupCount (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node),
@@ -71,6 +79,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsValue++;
     }
   }
+  Bool TableExprGroupCount::canMerge() const
+    { return True; }
+  void TableExprGroupCount::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupCount& that =
+      dynamic_cast<const TableExprGroupCount&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupAny::TableExprGroupAny (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, False)
@@ -82,6 +98,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (v) itsValue = True;
   }
+  Bool TableExprGroupAny::canMerge() const
+    { return True; }
+  void TableExprGroupAny::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupAny& that =
+      dynamic_cast<const TableExprGroupAny&>(other);
+    if (that.itsValue) itsValue = True;
+  }
 
   TableExprGroupAll::TableExprGroupAll (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, True)
@@ -93,6 +117,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (!v) itsValue = False;
   }
+  Bool TableExprGroupAll::canMerge() const
+    { return True; }
+  void TableExprGroupAll::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupAll& that =
+      dynamic_cast<const TableExprGroupAll&>(other);
+    if (!that.itsValue) itsValue = False;
+  }
 
   TableExprGroupNTrue::TableExprGroupNTrue (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -104,6 +136,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (v) itsValue++;
   }
+  Bool TableExprGroupNTrue::canMerge() const
+    { return True; }
+  void TableExprGroupNTrue::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupNTrue& that =
+      dynamic_cast<const TableExprGroupNTrue&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupNFalse::TableExprGroupNFalse (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -115,6 +155,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (!v) itsValue++;
   }
+  Bool TableExprGroupNFalse::canMerge() const
+    { return True; }
+  void TableExprGroupNFalse::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupNFalse& that =
+      dynamic_cast<const TableExprGroupNFalse&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupMinInt::TableExprGroupMinInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::max())
@@ -126,6 +174,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinInt::canMerge() const
+    { return True; }
+  void TableExprGroupMinInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMinInt& that =
+      dynamic_cast<const TableExprGroupMinInt&>(other);
+    if (that.itsValue<itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupMaxInt::TableExprGroupMaxInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::min())
@@ -137,6 +193,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxInt::canMerge() const
+    { return True; }
+  void TableExprGroupMaxInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMaxInt& that =
+      dynamic_cast<const TableExprGroupMaxInt&>(other);
+    if (that.itsValue>itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupSumInt::TableExprGroupSumInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -147,6 +211,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getInt(id);
   }
+  Bool TableExprGroupSumInt::canMerge() const
+    { return True; }
+  void TableExprGroupSumInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupSumInt& that =
+      dynamic_cast<const TableExprGroupSumInt&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupProductInt::TableExprGroupProductInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, 1)
@@ -157,6 +229,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getInt(id);
   }
+  Bool TableExprGroupProductInt::canMerge() const
+    { return True; }
+  void TableExprGroupProductInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupProductInt& that =
+      dynamic_cast<const TableExprGroupProductInt&>(other);
+    itsValue *= that.itsValue;
+  }
 
   TableExprGroupSumSqrInt::TableExprGroupSumSqrInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -168,6 +248,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrInt::canMerge() const
+    { return True; }
+  void TableExprGroupSumSqrInt::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupSumSqrInt& that =
+      dynamic_cast<const TableExprGroupSumSqrInt&>(other);
+    itsValue += that.itsValue;
+  }
 
 
   TableExprGroupMinDouble::TableExprGroupMinDouble(TableExprNodeRep* node)
@@ -180,6 +268,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinDouble::canMerge() const
+    { return True; }
+  void TableExprGroupMinDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMinDouble& that =
+      dynamic_cast<const TableExprGroupMinDouble&>(other);
+    if (that.itsValue<itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupMaxDouble::TableExprGroupMaxDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, std::numeric_limits<Double>::min())
@@ -191,6 +287,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxDouble::canMerge() const
+    { return True; }
+  void TableExprGroupMaxDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMaxDouble& that =
+      dynamic_cast<const TableExprGroupMaxDouble&>(other);
+    if (that.itsValue>itsValue) itsValue = that.itsValue;
+  }
 
   TableExprGroupSumDouble::TableExprGroupSumDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node)
@@ -201,6 +305,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDouble(id);
   }
+  Bool TableExprGroupSumDouble::canMerge() const
+    { return True; }
+  void TableExprGroupSumDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupSumDouble& that =
+      dynamic_cast<const TableExprGroupSumDouble&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupProductDouble::TableExprGroupProductDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, 1)
@@ -211,6 +323,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getDouble(id);
   }
+  Bool TableExprGroupProductDouble::canMerge() const
+    { return True; }
+  void TableExprGroupProductDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupProductDouble& that =
+      dynamic_cast<const TableExprGroupProductDouble&>(other);
+    itsValue *= that.itsValue;
+  }
 
   TableExprGroupSumSqrDouble::TableExprGroupSumSqrDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node)
@@ -222,6 +342,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrDouble::canMerge() const
+    { return True; }
+  void TableExprGroupSumSqrDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupSumSqrDouble& that =
+      dynamic_cast<const TableExprGroupSumSqrDouble&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupMeanDouble::TableExprGroupMeanDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node),
@@ -234,6 +362,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDouble(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDouble::canMerge() const
+    { return True; }
+  void TableExprGroupMeanDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMeanDouble& that =
+      dynamic_cast<const TableExprGroupMeanDouble&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupMeanDouble::finish()
   {
     if (itsNr > 0) {
@@ -260,6 +397,21 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsCurMean += delta/itsNr;
     itsValue   += delta*(v-itsCurMean);   // itsValue contains the M2 value
   }
+  Bool TableExprGroupVarianceDouble::canMerge() const
+    { return True; }
+  void TableExprGroupVarianceDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupVarianceDouble& that =
+      dynamic_cast<const TableExprGroupVarianceDouble&>(other);
+    // Combine the partial means and M2 values (Chan et al.).
+    if (that.itsNr > 0) {
+      Int64 nr = itsNr + that.itsNr;
+      Double delta = that.itsCurMean - itsCurMean;
+      itsCurMean += delta * that.itsNr / nr;
+      itsValue   += that.itsValue + delta*delta * itsNr * that.itsNr / nr;
+      itsNr = nr;
+    }
+  }
   void TableExprGroupVarianceDouble::finish()
   {
     if (itsNr > itsDdof) {
@@ -292,6 +444,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += v*v;
     itsNr++;
   }
+  Bool TableExprGroupRmsDouble::canMerge() const
+    { return True; }
+  void TableExprGroupRmsDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupRmsDouble& that =
+      dynamic_cast<const TableExprGroupRmsDouble&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupRmsDouble::finish()
   {
     if (itsNr > 0) {
@@ -337,6 +498,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDComplex(id);
   }
+  Bool TableExprGroupSumDComplex::canMerge() const
+    { return True; }
+  void TableExprGroupSumDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupSumDComplex& that =
+      dynamic_cast<const TableExprGroupSumDComplex&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupProductDComplex::TableExprGroupProductDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node, DComplex(1,0))
@@ -347,6 +516,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getDComplex(id);
   }
+  Bool TableExprGroupProductDComplex::canMerge() const
+    { return True; }
+  void TableExprGroupProductDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupProductDComplex& that =
+      dynamic_cast<const TableExprGroupProductDComplex&>(other);
+    itsValue *= that.itsValue;
+  }
 
   TableExprGroupSumSqrDComplex::TableExprGroupSumSqrDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node)
@@ -358,6 +535,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     DComplex v = itsOperand->getDComplex(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrDComplex::canMerge() const
+    { return True; }
+  void TableExprGroupSumSqrDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupSumSqrDComplex& that =
+      dynamic_cast<const TableExprGroupSumSqrDComplex&>(other);
+    itsValue += that.itsValue;
+  }
 
   TableExprGroupMeanDComplex::TableExprGroupMeanDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node),
@@ -370,6 +555,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDComplex(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDComplex::canMerge() const
+    { return True; }
+  void TableExprGroupMeanDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMeanDComplex& that =
+      dynamic_cast<const TableExprGroupMeanDComplex&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupMeanDComplex::finish()
   {
     if (itsNr > 0) {
@@ -396,6 +590,21 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     DComplex d = v - itsCurMean;
     itsValue += real(delta)*real(d) + imag(delta)*imag(d);
   }
+  Bool TableExprGroupVarianceDComplex::canMerge() const
+    { return True; }
+  void TableExprGroupVarianceDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupVarianceDComplex& that =
+      dynamic_cast<const TableExprGroupVarianceDComplex&>(other);
+    // Combine the partial means and M2 values (Chan et al.).
+    if (that.itsNr > 0) {
+      Int64 nr = itsNr + that.itsNr;
+      DComplex delta = that.itsCurMean - itsCurMean;
+      itsCurMean += delta * (Double(that.itsNr) / nr);
+      itsValue   += that.itsValue + norm(delta) * itsNr * that.itsNr / nr;
+      itsNr = nr;
+    }
+  }
   void TableExprGroupVarianceDComplex::finish()
   {
     if (itsNr > itsDdof) {
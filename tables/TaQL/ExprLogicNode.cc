@@ -27,6 +27,7 @@
 #include <casacore/tables/TaQL/ExprNodeSetOpt.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprRange.h>
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/casa/Quanta/MVTime.h>
@@ -45,6 +46,12 @@ Bool TableExprNodeEQBool::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) == rnode_p->getBool(id);
 }
+void TableExprNodeEQBool::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                        Bool* values)
+{
+    getBinaryBlock<Bool> (startRow, nrow, values,
+                          [](Bool l, Bool r) { return l == r; });
+}
 
 TableExprNodeEQInt::TableExprNodeEQInt (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -53,6 +60,12 @@ Bool TableExprNodeEQInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) == rnode_p->getInt(id);
 }
+void TableExprNodeEQInt::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                       Bool* values)
+{
+    getBinaryBlock<Int64> (startRow, nrow, values,
+                           [](Int64 l, Int64 r) { return l == r; });
+}
 
 TableExprNodeEQDouble::TableExprNodeEQDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -61,6 +74,12 @@ Bool TableExprNodeEQDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) == rnode_p->getDouble(id);
 }
+void TableExprNodeEQDouble::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                          Bool* values)
+{
+    getBinaryBlock<Double> (startRow, nrow, values,
+                            [](Double l, Double r) { return l == r; });
+}
 
 TableExprNodeEQDComplex::TableExprNodeEQDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -102,6 +121,12 @@ Bool TableExprNodeNEBool::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) != rnode_p->getBool(id);
 }
+void TableExprNodeNEBool::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                        Bool* values)
+{
+    getBinaryBlock<Bool> (startRow, nrow, values,
+                          [](Bool l, Bool r) { return l != r; });
+}
 
 TableExprNodeNEInt::TableExprNodeNEInt (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -110,6 +135,12 @@ Bool TableExprNodeNEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) != rnode_p->getInt(id);
 }
+void TableExprNodeNEInt::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                       Bool* values)
+{
+    getBinaryBlock<Int64> (startRow, nrow, values,
+                           [](Int64 l, Int64 r) { return l != r; });
+}
 
 TableExprNodeNEDouble::TableExprNodeNEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -118,6 +149,12 @@ Bool TableExprNodeNEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) != rnode_p->getDouble(id);
 }
+void TableExprNodeNEDouble::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                          Bool* values)
+{
+    getBinaryBlock<Double> (startRow, nrow, values,
+                            [](Double l, Double r) { return l != r; });
+}
 
 TableExprNodeNEDComplex::TableExprNodeNEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -159,6 +196,12 @@ Bool TableExprNodeGTInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) > rnode_p->getInt(id);
 }
+void TableExprNodeGTInt::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                       Bool* values)
+{
+    getBinaryBlock<Int64> (startRow, nrow, values,
+                           [](Int64 l, Int64 r) { return l > r; });
+}
 
 TableExprNodeGTDouble::TableExprNodeGTDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -167,6 +210,12 @@ Bool TableExprNodeGTDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) > rnode_p->getDouble(id);
 }
+void TableExprNodeGTDouble::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                          Bool* values)
+{
+    getBinaryBlock<Double> (startRow, nrow, values,
+                            [](Double l, Double r) { return l > r; });
+}
 
 TableExprNodeGTDComplex::TableExprNodeGTDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -200,6 +249,12 @@ Bool TableExprNodeGEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) >= rnode_p->getInt(id);
 }
+void TableExprNodeGEInt::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                       Bool* values)
+{
+    getBinaryBlock<Int64> (startRow, nrow, values,
+                           [](Int64 l, Int64 r) { return l >= r; });
+}
 
 TableExprNodeGEDouble::TableExprNodeGEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -208,6 +263,12 @@ Bool TableExprNodeGEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) >= rnode_p->getDouble(id);
 }
+void TableExprNodeGEDouble::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                          Bool* values)
+{
+    getBinaryBlock<Double> (startRow, nrow, values,
+                            [](Double l, Double r) { return l >= r; });
+}
 
 TableExprNodeGEDComplex::TableExprNodeGEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -353,6 +414,25 @@ Bool TableExprNodeOR::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) || rnode_p->getBool(id);
 }
+void TableExprNodeOR::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                    Bool* values)
+{
+    // Like getBool, only evaluate the right operand if needed; that is
+    // for each run of rows where the left operand is false.
+    lnode_p->getBoolBlock (startRow, nrow, values);
+    rownr_t i = 0;
+    while (i < nrow) {
+        if (values[i]) {
+            ++i;
+        } else {
+            rownr_t st = i;
+            while (i < nrow  &&  !values[i]) {
+                ++i;
+            }
+            rnode_p->getBoolBlock (startRow + st, i - st, values + st);
+        }
+    }
+}
 
 
 TableExprNodeAND::TableExprNodeAND (const TableExprNodeRep& node)
@@ -362,6 +442,25 @@ Bool TableExprNodeAND::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) && rnode_p->getBool(id);
 }
+void TableExprNodeAND::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                     Bool* values)
+{
+    // Like getBool, only evaluate the right operand if needed; that is
+    // for each run of rows where the left operand is true.
+    lnode_p->getBoolBlock (startRow, nrow, values);
+    rownr_t i = 0;
+    while (i < nrow) {
+        if (! values[i]) {
+            ++i;
+        } else {
+            rownr_t st = i;
+            while (i < nrow  &&  values[i]) {
+                ++i;
+            }
+            rnode_p->getBoolBlock (startRow + st, i - st, values + st);
+        }
+    }
+}
 
 
 TableExprNodeNOT::TableExprNodeNOT (const TableExprNodeRep& node)
@@ -371,6 +470,14 @@ Bool TableExprNodeNOT::getBool (const TableExprId& id)
 {
   return ! lnode_p->getBool(id);
 }
+void TableExprNodeNOT::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                     Bool* values)
+{
+    lnode_p->getBoolBlock (startRow, nrow, values);
+    for (rownr_t i=0; i<nrow; ++i) {
+        values[i] = ! values[i];
+    }
+}
 
 
 
@@ -444,7 +551,7 @@ void TableExprNodeGTDouble::ranges (Block<TableExprRange>& blrange)
         end = DBL_MAX;
     }else{
         if (rnode_p->operType()  == TableExprNodeRep::OtColumn
-        &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
+        &&  rnode_p->valueType() == TableExprNodeRep::VTScalar
         &&  lnode_p->operType()  == TableExprNodeRep::OtLiteral) {
             tsncol = rnode_p;
             end = lnode_p->getDouble (0);
@@ -459,6 +566,121 @@ void TableExprNodeGTDouble::ranges (Block<TableExprRange>& blrange)
 }
 
 
+//# Get the column and constant in a comparison of a scalar column with a
+//# constant. A null pointer is returned if it is not such a comparison.
+//# colLeft tells if the column is the left operand.
+static TableExprNodeColumn* getColumnConst (const TENShPtr& lnode,
+                                            const TENShPtr& rnode,
+                                            Double& value, Bool& colLeft)
+{
+    colLeft = (lnode->operType() == TableExprNodeRep::OtColumn);
+    const TENShPtr& colNode = (colLeft ? lnode : rnode);
+    const TENShPtr& valNode = (colLeft ? rnode : lnode);
+    if (colNode->operType()  == TableExprNodeRep::OtColumn
+    &&  colNode->valueType() == TableExprNodeRep::VTScalar
+    &&  valNode->operType()  == TableExprNodeRep::OtLiteral) {
+        value = valNode->getDouble (0);
+        return dynamic_cast<TableExprNodeColumn*>(colNode.get());
+    }
+    return 0;
+}
+
+//# The integer comparisons give the same ranges as the double ones.
+void TableExprNodeEQInt::ranges (Block<TableExprRange>& blrange)
+{
+    Double val = 0;
+    Bool colLeft;
+    TableExprNodeColumn* col = getColumnConst (lnode_p, rnode_p,
+                                               val, colLeft);
+    TableExprNodeRep::createRange (blrange, col, val, val);
+}
+
+void TableExprNodeGEInt::ranges (Block<TableExprRange>& blrange)
+{
+    Double val = 0;
+    Bool colLeft;
+    TableExprNodeColumn* col = getColumnConst (lnode_p, rnode_p,
+                                               val, colLeft);
+    if (colLeft) {
+        TableExprNodeRep::createRange (blrange, col, val, DBL_MAX);
+    } else {
+        TableExprNodeRep::createRange (blrange, col, -DBL_MAX, val);
+    }
+}
+
+void TableExprNodeGTInt::ranges (Block<TableExprRange>& blrange)
+{
+    //# The range is inclusive, thus a superset of the selected values.
+    Double val = 0;
+    Bool colLeft;
+    TableExprNodeColumn* col = getColumnConst (lnode_p, rnode_p,
+                                               val, colLeft);
+    if (colLeft) {
+        TableExprNodeRep::createRange (blrange, col, val, DBL_MAX);
+    } else {
+        TableExprNodeRep::createRange (blrange, col, -DBL_MAX, val);
+    }
+}
+
+//# Get the ranges for a scalar column IN a constant set or array.
+//# The intervals of a set are taken as closed.
+static void getInRanges (Block<TableExprRange>& blrange,
+                         const TENShPtr& lnode, const TENShPtr& rnode)
+{
+    blrange.resize (0, True);
+    if (lnode->operType()  != TableExprNodeRep::OtColumn
+    ||  lnode->valueType() != TableExprNodeRep::VTScalar
+    ||  ! rnode->isConstant()) {
+        return;
+    }
+    std::vector<Double> starts, ends;
+    if (auto uset = dynamic_cast<TableExprNodeSetOptUSet<Int64>*>
+                                                      (rnode.get())) {
+        for (const auto& x : uset->valueMap()) {
+            starts.push_back (x.first);
+        }
+        ends = starts;
+    } else if (auto cset = dynamic_cast<TableExprNodeSetOptContSetBase<Double>*>
+                                                      (rnode.get())) {
+        starts = cset->starts();
+        ends   = cset->ends();
+    } else if (rnode->valueType() == TableExprNodeRep::VTArray  ||
+               (rnode->valueType() == TableExprNodeRep::VTSet  &&
+                dynamic_cast<TableExprNodeSet&>(*rnode).isSingle())) {
+        MArray<Double> values = rnode->getArrayDouble (0);
+        Array<Double> arr(values.array());
+        if (values.hasMask()) {
+            arr.reference (values.flatten());
+        }
+        starts.assign (arr.begin(), arr.end());
+        ends = starts;
+    } else {
+        return;
+    }
+    if (starts.empty()) {
+        return;
+    }
+    //# Combine the ranges of the elements.
+    TableExprNodeColumn* col = dynamic_cast<TableExprNodeColumn*>(lnode.get());
+    TableExprRange range(col->getColumn(), starts[0], ends[0]);
+    for (size_t i=1; i<starts.size(); ++i) {
+        range.mixOr (TableExprRange(col->getColumn(), starts[i], ends[i]));
+    }
+    blrange.resize (1, True);
+    blrange[0] = range;
+}
+
+void TableExprNodeINInt::ranges (Block<TableExprRange>& blrange)
+{
+    getInRanges (blrange, lnode_p, rnode_p);
+}
+
+void TableExprNodeINDouble::ranges (Block<TableExprRange>& blrange)
+{
+    getInRanges (blrange, lnode_p, rnode_p);
+}
+
+
 //# Or two blocks of ranges.
 void TableExprNodeOR::ranges (Block<TableExprRange>& blrange)
 {
@@ -72,6 +72,8 @@ public:
     TableExprNodeEQBool (const TableExprNodeRep&);
     ~TableExprNodeEQBool() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
 };
 
 
@@ -102,6 +104,9 @@ public:
     TableExprNodeEQInt (const TableExprNodeRep&);
     ~TableExprNodeEQInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -132,6 +137,8 @@ public:
     TableExprNodeEQDouble (const TableExprNodeRep&);
     ~TableExprNodeEQDouble() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -284,6 +291,8 @@ public:
     TableExprNodeNEBool (const TableExprNodeRep&);
     ~TableExprNodeNEBool() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
 };
 
 
@@ -314,6 +323,8 @@ public:
     TableExprNodeNEInt (const TableExprNodeRep&);
     ~TableExprNodeNEInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
 };
 
 
@@ -344,6 +355,8 @@ public:
     TableExprNodeNEDouble (const TableExprNodeRep&);
     ~TableExprNodeNEDouble() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
 };
 
 
@@ -495,6 +508,9 @@ public:
     TableExprNodeGTInt (const TableExprNodeRep&);
     ~TableExprNodeGTInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -525,6 +541,8 @@ public:
     TableExprNodeGTDouble (const TableExprNodeRep&);
     ~TableExprNodeGTDouble() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -647,6 +665,9 @@ public:
     TableExprNodeGEInt (const TableExprNodeRep&);
     ~TableExprNodeGEInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -677,6 +698,8 @@ public:
     TableExprNodeGEDouble (const TableExprNodeRep&);
     ~TableExprNodeGEDouble() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -804,6 +827,7 @@ public:
     void optimize() override;
     static void doOptimize (TENShPtr& rnode);
     Bool getBool (const TableExprId& id) override;
+    void ranges (Block<TableExprRange>&) override;
 private:
 };
 
@@ -839,6 +863,7 @@ public:
     void optimize() override;
     static void doOptimize (TENShPtr& rnode);
     Bool getBool (const TableExprId& id) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -964,6 +989,8 @@ public:
     TableExprNodeOR (const TableExprNodeRep&);
     ~TableExprNodeOR() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -993,6 +1020,8 @@ public:
     TableExprNodeAND (const TableExprNodeRep&);
     ~TableExprNodeAND() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -1022,6 +1051,8 @@ public:
     TableExprNodeNOT (const TableExprNodeRep&);
     ~TableExprNodeNOT() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBlock (rownr_t startRow, rownr_t nrow,
+                       Bool* values) override;
 };
 
 
@@ -51,6 +51,14 @@ Double TableExprNodePlusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) + rnode_p->getInt(id); }
 DComplex TableExprNodePlusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) + rnode_p->getInt(id)); }
+void TableExprNodePlusInt::getIntBlock (rownr_t startRow, rownr_t nrow,
+                                        Int64* values)
+    { getBinaryBlock<Int64> (startRow, nrow, values,
+                             [](Int64 l, Int64 r) { return l + r; }); }
+void TableExprNodePlusInt::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                           Double* values)
+    { getBinaryBlock<Int64> (startRow, nrow, values,
+                             [](Int64 l, Int64 r) { return Double(l + r); }); }
 
 TableExprNodePlusDouble::TableExprNodePlusDouble (const TableExprNodeRep& node)
 : TableExprNodePlus (NTDouble, node)
@@ -61,6 +69,10 @@ Double TableExprNodePlusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
 DComplex TableExprNodePlusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
+void TableExprNodePlusDouble::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                              Double* values)
+    { getBinaryBlock<Double> (startRow, nrow, values,
+                              [](Double l, Double r) { return l + r; }); }
 
 TableExprNodePlusDComplex::TableExprNodePlusDComplex (const TableExprNodeRep& node)
 : TableExprNodePlus (NTComplex, node)
@@ -123,6 +135,14 @@ Double TableExprNodeMinusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) - rnode_p->getInt(id); }
 DComplex TableExprNodeMinusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) - rnode_p->getInt(id)); }
+void TableExprNodeMinusInt::getIntBlock (rownr_t startRow, rownr_t nrow,
+                                         Int64* values)
+    { getBinaryBlock<Int64> (startRow, nrow, values,
+                             [](Int64 l, Int64 r) { return l - r; }); }
+void TableExprNodeMinusInt::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                            Double* values)
+    { getBinaryBlock<Int64> (startRow, nrow, values,
+                             [](Int64 l, Int64 r) { return Double(l - r); }); }
 
 TableExprNodeMinusDouble::TableExprNodeMinusDouble (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTDouble, node)
@@ -141,6 +161,10 @@ Double TableExprNodeMinusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
 DComplex TableExprNodeMinusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
+void TableExprNodeMinusDouble::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                               Double* values)
+    { getBinaryBlock<Double> (startRow, nrow, values,
+                              [](Double l, Double r) { return l - r; }); }
 
 TableExprNodeMinusDComplex::TableExprNodeMinusDComplex (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTComplex, node)
@@ -196,6 +220,14 @@ Double TableExprNodeTimesInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) * rnode_p->getInt(id); }
 DComplex TableExprNodeTimesInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) * rnode_p->getInt(id)); }
+void TableExprNodeTimesInt::getIntBlock (rownr_t startRow, rownr_t nrow,
+                                         Int64* values)
+    { getBinaryBlock<Int64> (startRow, nrow, values,
+                             [](Int64 l, Int64 r) { return l * r; }); }
+void TableExprNodeTimesInt::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                            Double* values)
+    { getBinaryBlock<Int64> (startRow, nrow, values,
+                             [](Int64 l, Int64 r) { return Double(l * r); }); }
 
 TableExprNodeTimesDouble::TableExprNodeTimesDouble (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTDouble, node)
@@ -206,6 +238,10 @@ Double TableExprNodeTimesDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
 DComplex TableExprNodeTimesDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
+void TableExprNodeTimesDouble::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                               Double* values)
+    { getBinaryBlock<Double> (startRow, nrow, values,
+                              [](Double l, Double r) { return l * r; }); }
 
 TableExprNodeTimesDComplex::TableExprNodeTimesDComplex (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTComplex, node)
@@ -262,6 +298,10 @@ Double TableExprNodeDivideDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
 DComplex TableExprNodeDivideDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
+void TableExprNodeDivideDouble::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                                Double* values)
+    { getBinaryBlock<Double> (startRow, nrow, values,
+                              [](Double l, Double r) { return l / r; }); }
 
 TableExprNodeDivideDComplex::TableExprNodeDivideDComplex (const TableExprNodeRep& node)
 : TableExprNodeDivide (NTComplex, node)
@@ -230,6 +230,33 @@ MVTime TableExprNodeRep::getDate (const TableExprId&)
     TableExprNode::throwInvDT ("(getDate not implemented)");
     return MVTime(0.);
 }
+void TableExprNodeRep::getBoolBlock (rownr_t startRow, rownr_t nrow,
+                                     Bool* values)
+{
+    TableExprId id;
+    for (rownr_t i=0; i<nrow; ++i) {
+        id.setRownr (startRow + i);
+        values[i] = getBool (id);
+    }
+}
+void TableExprNodeRep::getIntBlock (rownr_t startRow, rownr_t nrow,
+                                    Int64* values)
+{
+    TableExprId id;
+    for (rownr_t i=0; i<nrow; ++i) {
+        id.setRownr (startRow + i);
+        values[i] = getInt (id);
+    }
+}
+void TableExprNodeRep::getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                       Double* values)
+{
+    TableExprId id;
+    for (rownr_t i=0; i<nrow; ++i) {
+        id.setRownr (startRow + i);
+        values[i] = getDouble (id);
+    }
+}
 MArray<Bool> TableExprNodeRep::getArrayBool (const TableExprId&)
 {
     TableExprNode::throwInvDT ("(getArrayBool not implemented)");
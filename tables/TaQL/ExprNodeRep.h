@@ -33,6 +33,7 @@
 #include <casacore/tables/TaQL/ExprRange.h>
 #include <casacore/tables/TaQL/MArray.h>
 #include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Quanta/MVTime.h>
 #include <casacore/casa/Quanta/Unit.h>
@@ -48,7 +49,6 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class TableExprNode;
 class TableExprNodeColumn;
 class TableExprGroupFuncBase;
-template<class T> class Block;
 
 //# Define a shared pointer to the Rep class.
 class TableExprNodeRep;
@@ -319,6 +319,24 @@ public:
     virtual MVTime getDate       (const TableExprId& id);
     // </group>
 
+    // Get the scalar values for this node in a block of <src>nrow</src>
+    // consecutive rows starting at <src>startRow</src>.
+    // The values are stored in the contiguous buffer <src>values</src>,
+    // which must be large enough.
+    // This columnar evaluation mode avoids walking the expression tree
+    // for each row. Derived classes can implement it by evaluating their
+    // children for the entire block and applying the operator in a tight loop.
+    // The default implementation evaluates row by row using the scalar
+    // get functions above, so nodes not implementing it still work.
+    // <group>
+    virtual void getBoolBlock   (rownr_t startRow, rownr_t nrow,
+                                 Bool* values);
+    virtual void getIntBlock    (rownr_t startRow, rownr_t nrow,
+                                 Int64* values);
+    virtual void getDoubleBlock (rownr_t startRow, rownr_t nrow,
+                                 Double* values);
+    // </group>
+
     // Get an array value for this node in the given row.
     // The appropriate functions are implemented in the derived classes and
     // will usually invoke the get in their children and apply the
@@ -360,6 +378,16 @@ public:
       { value = getArrayString (id); }
     // </group>
 
+    // General block get functions for template purposes.
+    // <group>
+    void getBlock (rownr_t startRow, rownr_t nrow, Bool* values)
+      { getBoolBlock (startRow, nrow, values); }
+    void getBlock (rownr_t startRow, rownr_t nrow, Int64* values)
+      { getIntBlock (startRow, nrow, values); }
+    void getBlock (rownr_t startRow, rownr_t nrow, Double* values)
+      { getDoubleBlock (startRow, nrow, values); }
+    // </group>
+
     // Get a value as an array, even it it is a scalar.
     // This is useful if one could give an argument as scalar or array.
     // <group>
@@ -633,6 +661,21 @@ protected:
     static const Unit& makeEqualUnits (const TENShPtr& left,
                                        TENShPtr& right);
 
+    // Evaluate both children for a block of rows (as type T) and combine
+    // their values into <src>values</src> using the binary operator.
+    // It can be used by derived classes to implement the block get functions.
+    template<typename T, typename RES, typename OP>
+    void getBinaryBlock (rownr_t startRow, rownr_t nrow, RES* values, OP op)
+    {
+        Block<T> lval(nrow);
+        Block<T> rval(nrow);
+        lnode_p->getBlock (startRow, nrow, lval.storage());
+        rnode_p->getBlock (startRow, nrow, rval.storage());
+        for (rownr_t i=0; i<nrow; ++i) {
+            values[i] = op(lval[i], rval[i]);
+        }
+    }
+
     TENShPtr lnode_p;     //# left operand
     TENShPtr rnode_p;     //# right operand
 };
@@ -133,6 +133,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Where does a value occur in the set? -1 is no match.
     Int64 find (T value) const override;
 
+    // Get the map of the values to their index in the set.
+    const std::unordered_map<T,Int64>& valueMap() const
+      { return itsMap; }
+
   private:
     std::unordered_map<T,Int64> itsMap;
     // Explicitly hide base function to prevent warning
@@ -172,6 +176,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get the size (nr of intervals).
     size_t size() const
       { return itsStarts.size(); }
+    // Get the start and end values of the intervals.
+    // <group>
+    const std::vector<T>& starts() const
+      { return itsStarts; }
+    const std::vector<T>& ends() const
+      { return itsEnds; }
+    // </group>
     // Show the node.
     void show (ostream& os, uInt indent) const override;
     // Transform a set into an optimized one by ordering the intervals
@@ -25,7 +25,18 @@
 
 //# Includes
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprMathNode.h>
+#include <casacore/tables/TaQL/ExprLogicNode.h>
+#include <casacore/tables/TaQL/ExprFuncNode.h>
+#include <casacore/tables/TaQL/ExprRange.h>
+#include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Containers/Block.h>
+#include <exception>
+#include <typeindex>
+#include <unordered_set>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -114,7 +125,175 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       return nrow;
     }
 
-    
+    Bool isThreadSafe (TableExprNodeRep* node)
+    {
+      // The node types having a block implementation without state.
+      static const std::unordered_set<std::type_index> blockTypes {
+        typeid(TableExprNodeConstBool),  typeid(TableExprNodeConstInt),
+        typeid(TableExprNodeConstDouble),
+        typeid(TableExprNodePlusInt),    typeid(TableExprNodePlusDouble),
+        typeid(TableExprNodeMinusInt),   typeid(TableExprNodeMinusDouble),
+        typeid(TableExprNodeTimesInt),   typeid(TableExprNodeTimesDouble),
+        typeid(TableExprNodeDivideDouble),
+        typeid(TableExprNodeEQBool),     typeid(TableExprNodeEQInt),
+        typeid(TableExprNodeEQDouble),
+        typeid(TableExprNodeNEBool),     typeid(TableExprNodeNEInt),
+        typeid(TableExprNodeNEDouble),
+        typeid(TableExprNodeGTInt),      typeid(TableExprNodeGTDouble),
+        typeid(TableExprNodeGEInt),      typeid(TableExprNodeGEDouble),
+        typeid(TableExprNodeAND),        typeid(TableExprNodeOR),
+        typeid(TableExprNodeNOT)};
+      std::vector<TableExprNodeRep*> allNodes;
+      node->flattenTree (allNodes);
+      for (auto nodeP : allNodes) {
+        if (nodeP->valueType() != TableExprNodeRep::VTScalar) {
+          return False;
+        }
+        const std::type_info& type = typeid(*nodeP);
+        if (type == typeid(TableExprNodeColumn)) {
+          // Only numeric and Bool columns are read as a block.
+          switch (static_cast<TableExprNodeColumn*>(nodeP)->
+                  getColumn().columnDesc().dataType()) {
+          case TpBool:
+          case TpUChar:
+          case TpShort:
+          case TpUShort:
+          case TpInt:
+          case TpUInt:
+          case TpInt64:
+          case TpFloat:
+          case TpDouble:
+            break;
+          default:
+            return False;
+          }
+        } else if (type == typeid(TableExprFuncNode)) {
+          if (! static_cast<TableExprFuncNode*>(nodeP)->hasBlockEval()) {
+            return False;
+          }
+        } else if (blockTypes.find(type) == blockTypes.end()) {
+          return False;
+        }
+      }
+      return True;
+    }
+
+    Vector<rownr_t> parallelSelect (TableExprNodeRep* node,
+                                    const Table& table, uInt nthreads)
+    {
+      if (node->dataType() != TableExprNodeRep::NTBool  ||
+          node->valueType() != TableExprNodeRep::VTScalar) {
+        throw TableInvExpr ("select expression result is not Bool scalar");
+      }
+      rownr_t nrow = table.nrow();
+      std::vector<Table> tables (getNodeTables (node, True));
+      if (! tables.empty()  &&  getCheckNRow(tables) != nrow) {
+        throw TableInvExpr ("select expression for table " +
+                            tables[0].tableName() +
+                            " is used on a differently sized table");
+      }
+      // For a plain table only the ranges of rows that can match need
+      // to be evaluated (as done in BaseTable::select).
+      std::vector<std::pair<rownr_t,rownr_t>> rowRanges;
+      if (table.tableType() != Table::Plain  ||
+          !getZoneRanges (node, table.tableName(), rowRanges)) {
+        rowRanges.clear();
+        if (nrow > 0) {
+          rowRanges.push_back (std::make_pair (rownr_t(0), nrow-1));
+        }
+      }
+      // Split the ranges into blocks of rows.
+      const rownr_t blockSize = 4096;
+      std::vector<std::pair<rownr_t,rownr_t>> blocks;
+      for (const auto& range : rowRanges) {
+        for (rownr_t st=range.first; st<=range.second; st+=blockSize) {
+          blocks.push_back (std::make_pair
+                            (st, std::min(blockSize, range.second + 1 - st)));
+        }
+      }
+      // Each thread evaluates blocks of rows and keeps the selected rows
+      // per block, so the memory used is proportional to the block size
+      // and the number of selected rows instead of the table size.
+      // An exception cannot leave a parallel loop, so it is kept and
+      // rethrown afterwards.
+      Int64 nblock = blocks.size();
+      std::vector<std::vector<rownr_t>> blockRows(nblock);
+      std::exception_ptr excp;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+      for (Int64 i=0; i<nblock; ++i) {
+        try {
+          rownr_t start = blocks[i].first;
+          Block<Bool> mask(blocks[i].second);
+          node->getBoolBlock (start, blocks[i].second, mask.storage());
+          for (rownr_t j=0; j<blocks[i].second; ++j) {
+            if (mask[j]) {
+              blockRows[i].push_back (start + j);
+            }
+          }
+        } catch (...) {
+#pragma omp critical(TableExprNodeUtil_parallelSelect)
+          excp = std::current_exception();
+        }
+      }
+      if (excp) {
+        std::rethrow_exception (excp);
+      }
+      // Collect the selected rows in order.
+      rownr_t nsel = 0;
+      for (const auto& rows : blockRows) {
+        nsel += rows.size();
+      }
+      Vector<rownr_t> rownrs(nsel);
+      rownr_t inx = 0;
+      for (const auto& rows : blockRows) {
+        std::copy (rows.begin(), rows.end(), rownrs.data() + inx);
+        inx += rows.size();
+      }
+      return rownrs;
+    }
+
+    Bool getZoneRanges (TableExprNodeRep* node, const String& tableName,
+                        std::vector<std::pair<rownr_t,rownr_t>>& rowRanges)
+    {
+      Block<TableExprRange> ranges;
+      node->ranges (ranges);
+      Bool found = False;
+      for (size_t i=0; i<ranges.size(); ++i) {
+        const TableColumn& col = ranges[i].getColumn();
+        Table tab = col.table();
+        if (tab.tableType() != Table::Plain  ||  tab.tableName() != tableName) {
+          continue;
+        }
+        std::vector<std::pair<rownr_t,rownr_t>> colRanges;
+        if (! col.getZoneRanges (ranges[i].start(), ranges[i].end(),
+                                 colRanges)) {
+          continue;
+        }
+        if (! found) {
+          rowRanges.swap (colRanges);
+          found = True;
+          continue;
+        }
+        // Intersect with the ranges found so far (both are ascending).
+        std::vector<std::pair<rownr_t,rownr_t>> both;
+        size_t j=0, k=0;
+        while (j < rowRanges.size()  &&  k < colRanges.size()) {
+          rownr_t st = std::max (rowRanges[j].first, colRanges[k].first);
+          rownr_t end = std::min (rowRanges[j].second, colRanges[k].second);
+          if (st <= end) {
+            both.push_back (std::make_pair (st, end));
+          }
+          if (rowRanges[j].second < colRanges[k].second) {
+            j++;
+          } else {
+            k++;
+          }
+        }
+        rowRanges.swap (both);
+      }
+      return found;
+    }
+
   }
 
 } //# NAMESPACE CASACORE - END
@@ -29,6 +29,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <utility>
 #include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -75,6 +76,37 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get the nr of rows in the tables used.
     // An exception is thrown if the tables differ in the nr of rows.
     rownr_t getCheckNRow (const std::vector<Table>&);
+
+    // Test if the expression can be evaluated by multiple threads for
+    // different blocks of rows.
+    // That is the case if it consists of scalar constants, scalar numeric
+    // or Bool columns, and operators and functions that are evaluated for
+    // an entire block of rows without keeping any state.
+    // Array columns are not supported.
+    Bool isThreadSafe (TableExprNodeRep* node);
+
+    // Evaluate a Bool scalar expression for all rows of the table
+    // using at most <src>nthreads</src> threads (if OpenMP is used).
+    // As in <src>Table::operator()</src>, only the rows in the ranges found
+    // by <src>getZoneRanges</src> are evaluated for a plain table.
+    // It returns the row numbers of the rows for which the expression is
+    // true in increasing order, so the result does not depend on the
+    // number of threads.
+    // The caller should have checked the expression is thread-safe.
+    // Note that only scalar columns can be used (see <src>isThreadSafe</src>).
+    Vector<rownr_t> parallelSelect (TableExprNodeRep* node,
+                                    const Table& table, uInt nthreads);
+
+    // Get the ranges of rows (inclusive and in ascending order) of the
+    // given plain table that can match a Bool expression.
+    // The ranges of column values found by <src>TableExprNodeRep::ranges</src>
+    // are given to the storage managers of the columns of that table, which
+    // can find the matching rows using the minimum and maximum per block of
+    // rows (see class <linkto class=StManZoneMap>StManZoneMap</linkto>).
+    // The row ranges found for multiple columns are intersected.
+    // It returns False if none of the columns could be used.
+    Bool getZoneRanges (TableExprNodeRep* node, const String& tableName,
+                        std::vector<std::pair<rownr_t,rownr_t>>& rowRanges);
 }
   
 
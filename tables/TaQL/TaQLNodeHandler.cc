@@ -569,6 +569,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Add an entry to the stack.
     Bool outer = itsStack.empty();
     TableParseQuery* curSel = pushStack (TableParseQuery::PSELECT);
+    curSel->setNThreads (node.style().nThreads());
     // First handle LIMIT/OFFSET, because limit is needed when creating
     // a temp table for a select without a FROM.
     // In its turn limit/offset might use WITH tables, so do them very first.
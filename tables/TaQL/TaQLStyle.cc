@@ -35,7 +35,8 @@ TaQLStyle::TaQLStyle (uInt origin)
     itsEndExcl   (False),
     itsCOrder    (False),
     itsDoTiming  (False),
-    itsDoTracing (False)
+    itsDoTracing (False),
+    itsNThreads  (1)
 {
   // Define mscal as a synonym for derivedmscal.
   defineSynonym ("mscal", "derivedmscal");
@@ -45,6 +46,12 @@ TaQLStyle::TaQLStyle (uInt origin)
 void TaQLStyle::set (const String& value)
 {
   String val = upcase(value);
+  // A value like THREADS=n consists of a keyword and a value.
+  String::size_type pos = val.find ('=');
+  String keyw = val;
+  if (pos != String::npos) {
+    keyw = trim(String(val.before(pos)));
+  }
   if (val == "GLISH") {
     itsOrigin  = 1;
     itsEndExcl = False;
@@ -73,6 +80,22 @@ void TaQLStyle::set (const String& value)
     itsDoTracing = True;
   } else if (val == "NOTRACE") {
     itsDoTracing = False;
+  } else if (keyw == "THREADS") {
+    String nthr;
+    if (pos != String::npos) {
+      nthr = trim(String(val.after(pos)));
+    }
+    Int n = 0;
+    try {
+      n = String::toInt (nthr, True);
+    } catch (const AipsError&) {
+      n = -1;
+    }
+    if (n < 0) {
+      throw TableError(value + " is an invalid TaQL STYLE value; "
+                       "use THREADS=n with n >= 0");
+    }
+    setNThreads (n);
   } else {
     throw TableError(value + " is an invalid TaQL STYLE value");
   }
@@ -83,6 +106,7 @@ void TaQLStyle::reset()
   set ("GLISH");
   itsDoTiming  = False;
   itsDoTracing = False;
+  itsNThreads  = 1;
 }
 
 void TaQLStyle::defineSynonym (const String& synonym, const String& udfLibName)
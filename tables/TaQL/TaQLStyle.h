@@ -30,6 +30,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/stdmap.h>
+#include <algorithm>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -53,6 +54,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //
 // The class is also used to tell the TaQL execution engine if timings
 // or tracing of the various parts of the TaQL command need to be done.
+// Furthermore it tells how many threads can be used to evaluate the
+// WHERE clause and GROUPBY of a selection (using THREADS=n).
 //
 // Finally it is possible to define synonyms for UDF library names.
 // For example, 'derivedmscal' is a lot to type, so a synonym 'mscal'
@@ -71,6 +74,11 @@ public:
   // Set the style according to the (case-insensitive) value.
   // Possible values are Glish, Python, Base0, Base1, FortranOrder, Corder,
   // InclEnd, and ExclEnd.
+  // Furthermore Time, NoTime, Trace, NoTrace, and Threads=n can be given.
+  // The value of Threads must be a non-negative integer; 0 is treated
+  // as 1 (see <src>setNThreads</src>). The WHERE clause of a SELECT and
+  // GROUPBY with aggregate functions are evaluated in parallel if their
+  // expressions make it possible. The projection is done serially.
   void set (const String& value);
 
   // Define a UDF library name synonym.
@@ -113,12 +121,22 @@ public:
   Bool doTracing() const
     { return itsDoTracing; }
 
+  // Set the maximum number of threads to use in a query.
+  // A value 0 is treated as 1.
+  void setNThreads (uInt nthreads)
+    { itsNThreads = std::max (nthreads, 1u); }
+
+  // Get the maximum number of threads to use in a query.
+  uInt nThreads() const
+    { return itsNThreads; }
+
 private:
   uInt itsOrigin;
   Bool itsEndExcl;
   Bool itsCOrder;
   Bool itsDoTiming;
   Bool itsDoTracing;
+  uInt itsNThreads;
   std::map<String,String> itsUDFLibNameMap;
 };
 
@@ -201,6 +201,8 @@ NAMETABC  ([A-Za-z0-9_./+\-~$@:]|(\\.))+
 NAMETAB   {NAMETABC}|(({STRING}|{NAMETABC})+)
 /* A UDFlib synonym */
 UDFLIBSYN {NAME}{WHITE}"="{WHITE}{NAME}
+/* A style keyword with a numeric value (e.g. THREADS=4) */
+STYLEVAL  {NAME}{WHITE}"="{WHITE}{INT}
 /* A regular expression can be delimited by / % or @ optionall=y followed by i
    to indicate case-insensitive matching.
      m is a partial match (match if part of string matches the regex)
@@ -524,6 +526,15 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
             return UDFLIBSYN;
           }
 
+ /* Style keyword with a value; it is handled as a style name */
+<STYLEstate>{STYLEVAL} {
+            tableGramPosition() += yyleng;
+            lvalp->val = new TaQLConstNode(
+                new TaQLConstNodeRep (String(TableGramtext)));
+            TaQLNode::theirNodesCreated.push_back (lvalp->val);
+            return NAME;
+          }
+
  /* regular expression and pattern handling */
 <EXPRstate>{PATTREX} {
             tableGramPosition() += yyleng;
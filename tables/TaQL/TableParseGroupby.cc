@@ -29,7 +29,11 @@
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <algorithm>
+#include <exception>
+#include <typeinfo>
 
 using namespace std;
 
@@ -134,7 +138,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
   std::shared_ptr<TableExprGroupResult> TableParseGroupby::execGroupAggr
-  (Vector<rownr_t>& rownrs) const
+  (Vector<rownr_t>& rownrs, uInt nthreads) const
   {
     // If only 'select count(*)' was given, get the size of the WHERE,
     // thus the size of rownrs_p.
@@ -142,7 +146,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         (itsGroupAggrUsed & GROUPBY) == 0) {
       return countAll (rownrs);
     }
-    return aggregate (rownrs);
+    return aggregate (rownrs, nthreads);
   }
 
   Bool TableParseGroupby::execHaving
@@ -168,7 +172,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
   std::shared_ptr<TableExprGroupResult> TableParseGroupby::aggregate
-  (Vector<rownr_t>& rownrs) const
+  (Vector<rownr_t>& rownrs, uInt nthreads) const
   {
     // Get the aggregate functions to be evaluated lazily.
     std::vector<TableExprNodeRep*> immediateNodes;
@@ -195,8 +199,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       immediateNodes.push_back (&expridNode);
     }
     std::vector<std::shared_ptr<TableExprGroupFuncSet>> funcSets;
-    // Use a faster way for a single groupby key.
-    if (itsGroupbyNodes.size() == 1  &&
+    // Use multiple threads if possible, otherwise use a faster way for a
+    // single groupby key.
+    if (nthreads > 1  &&  rownrs.size() > 1  &&
+        canAggregateParallel (immediateNodes)) {
+      funcSets = parallelKey (immediateNodes, rownrs, nthreads);
+    } else if (itsGroupbyNodes.size() == 1  &&
         itsGroupbyNodes[0].dataType() == TpDouble) {
       funcSets = singleKey<Double> (immediateNodes, rownrs);
     } else if (itsGroupbyNodes.size() == 1  &&
@@ -283,4 +291,110 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  // Can the node be evaluated row by row by multiple threads?
+  // Besides the thread-safe nodes, a scalar column of any type can be used,
+  // because the reads of single rows are serialized.
+  static Bool isParallelNode (TableExprNodeRep* node)
+  {
+    return TableExprNodeUtil::isThreadSafe (node)  ||
+      (typeid(*node) == typeid(TableExprNodeColumn)  &&
+       node->valueType() == TableExprNodeRep::VTScalar);
+  }
+
+  Bool TableParseGroupby::canAggregateParallel
+  (const std::vector<TableExprNodeRep*>& nodes) const
+  {
+    for (uInt i=0; i<itsGroupbyNodes.size(); ++i) {
+      if (! isParallelNode (itsGroupbyNodes[i].getRep().get())) {
+        return False;
+      }
+    }
+    for (uInt i=0; i<nodes.size(); ++i) {
+      TableExprAggrNode* aggr = dynamic_cast<TableExprAggrNode*>(nodes[i]);
+      if (! aggr) {
+        return False;
+      }
+      for (const TENShPtr& oper : aggr->operands()) {
+        if (oper  &&  ! isParallelNode (oper.get())) {
+          return False;
+        }
+      }
+    }
+    return TableExprGroupFuncSet(nodes).canMerge();
+  }
+
+  std::vector<std::shared_ptr<TableExprGroupFuncSet>> TableParseGroupby::parallelKey
+  (const std::vector<TableExprNodeRep*>& nodes, const Vector<rownr_t>& rownrs,
+   uInt nthreads) const
+  {
+    // Split the rows into chunks of a fixed size, so the merged results
+    // do not depend on the number of threads.
+    // Each chunk is grouped as in multiKey into its own sets of aggregate
+    // function objects. An exception cannot leave a parallel loop, so it
+    // is kept and rethrown afterwards.
+    const rownr_t chunkSize = 4096;
+    rownr_t nrow = rownrs.size();
+    Int64 nchunk = (nrow + chunkSize - 1) / chunkSize;
+    std::vector<std::vector<TableExprGroupKeySet>> chunkKeys(nchunk);
+    std::vector<std::vector<std::shared_ptr<TableExprGroupFuncSet>>>
+      chunkSets(nchunk);
+    std::exception_ptr excp;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+    for (Int64 chunk=0; chunk<nchunk; ++chunk) {
+      // The columns are read by multiple threads.
+      TableExprNodeColumn::setLockRowReads (True);
+      try {
+        std::vector<std::shared_ptr<TableExprGroupFuncSet>>& funcSets =
+          chunkSets[chunk];
+        std::map<TableExprGroupKeySet, Int> keyFuncMap;
+        TableExprGroupKeySet keySet(itsGroupbyNodes);
+        TableExprId rowid(0);
+        rownr_t end = std::min (nrow, rownr_t(chunk+1) * chunkSize);
+        for (rownr_t i=chunk*chunkSize; i<end; ++i) {
+          rowid.setRownr (rownrs[i]);
+          keySet.fill (itsGroupbyNodes, rowid);
+          Int groupnr = funcSets.size();
+          std::map<TableExprGroupKeySet, Int>::iterator iter=keyFuncMap.find (keySet);
+          if (iter == keyFuncMap.end()) {
+            keyFuncMap[keySet] = groupnr;
+            chunkKeys[chunk].push_back (keySet);
+            // Making the aggregate function objects changes the nodes.
+            std::shared_ptr<TableExprGroupFuncSet> funcSet;
+#pragma omp critical(TableParseGroupby_parallelKey)
+            funcSet = std::make_shared<TableExprGroupFuncSet>(nodes);
+            funcSets.push_back (funcSet);
+          } else {
+            groupnr = iter->second;
+          }
+          funcSets[groupnr]->apply (rowid);
+        }
+      } catch (...) {
+#pragma omp critical(TableParseGroupby_parallelKey_excp)
+        excp = std::current_exception();
+      }
+      TableExprNodeColumn::setLockRowReads (False);
+    }
+    if (excp) {
+      std::rethrow_exception (excp);
+    }
+    // Merge the chunks in order. A group gets the number of its first
+    // occurrence, which is the same as in multiKey.
+    std::vector<std::shared_ptr<TableExprGroupFuncSet>> funcSets;
+    std::map<TableExprGroupKeySet, Int> keyFuncMap;
+    for (Int64 chunk=0; chunk<nchunk; ++chunk) {
+      for (size_t j=0; j<chunkSets[chunk].size(); ++j) {
+        const TableExprGroupKeySet& keySet = chunkKeys[chunk][j];
+        std::map<TableExprGroupKeySet, Int>::iterator iter=keyFuncMap.find (keySet);
+        if (iter == keyFuncMap.end()) {
+          keyFuncMap[keySet] = funcSets.size();
+          funcSets.push_back (chunkSets[chunk][j]);
+        } else {
+          funcSets[iter->second]->merge (*chunkSets[chunk][j]);
+        }
+      }
+    }
+    return funcSets;
+  }
+
+
 } //# NAMESPACE CASACORE - END
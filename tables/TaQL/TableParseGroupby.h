@@ -101,7 +101,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Execute the grouping and aggregation and return the results.
     // The rownrs are adapted to the resulting rownrs consisting of the
     // first row of each group.
-    std::shared_ptr<TableExprGroupResult> execGroupAggr (Vector<rownr_t>& rownrs) const;
+    // At most <src>nthreads</src> threads are used if the groupby keys
+    // and aggregate functions can be evaluated in parallel
+    // (see <src>canAggregateParallel</src>).
+    std::shared_ptr<TableExprGroupResult> execGroupAggr (Vector<rownr_t>& rownrs,
+                                                         uInt nthreads=1) const;
 
     // Execute the HAVING clause (if present).
     // Return False in no HAVING.
@@ -113,7 +117,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // It distinguishes the immediate and lazy aggregate functions.
     // The rownrs are adapted to the resulting rownrs consisting of the
     // first row of each group.
-    std::shared_ptr<TableExprGroupResult> aggregate (Vector<rownr_t>& rownrs) const;
+    std::shared_ptr<TableExprGroupResult> aggregate (Vector<rownr_t>& rownrs,
+                                                     uInt nthreads) const;
 
     // Do the grouping and aggregation and return the results.
     // It consists of a single COUNTALL operation.
@@ -125,6 +130,21 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     std::vector<std::shared_ptr<TableExprGroupFuncSet>> multiKey
     (const std::vector<TableExprNodeRep*>&, const Vector<rownr_t>& rownrs) const;
 
+    // Can the groupby keys and the given aggregate functions be evaluated
+    // by multiple threads? It is possible if the keys and operands are
+    // thread-safe (see <src>TableExprNodeUtil::isThreadSafe</src>) or are
+    // scalar columns, and if the partial results of all aggregate functions
+    // can be merged.
+    Bool canAggregateParallel (const std::vector<TableExprNodeRep*>&) const;
+
+    // Create the set of aggregate functions and groupby keys using
+    // multiple threads. Each thread aggregates chunks of rows into
+    // its own sets which are merged in chunk order, so the groups are in
+    // the same order as with <src>multiKey</src>.
+    std::vector<std::shared_ptr<TableExprGroupFuncSet>> parallelKey
+    (const std::vector<TableExprNodeRep*>&, const Vector<rownr_t>& rownrs,
+     uInt nthreads) const;
+
     // Create the set of aggregate functions and groupby keys in case
     // a single groupby key is given.
     // This offers much faster map access then the general multipleKeys.
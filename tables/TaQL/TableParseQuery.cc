@@ -35,6 +35,7 @@
 #include <casacore/tables/TaQL/ExprRange.h>
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ColumnIndexFile.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/TableCopy.h>
@@ -59,6 +60,9 @@
 #include <casacore/casa/OS/Timer.h>
 #include <casacore/casa/ostream.h>
 #include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -74,6 +78,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       overwrite_p     (True),
       resultSet_p     (0),
       distinct_p      (False),
+      nthreads_p      (1),
       limit_p         (0),
       endrow_p        (0),
       offset_p        (0),
@@ -776,12 +781,113 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  //# Convert the Double bounds of TaQL ranges to Int64 keys.
+  //# Beyond 2^53 the constant can have been rounded when converted to
+  //# Double, so such a bound is widened by one unit in the last place to
+  //# keep the range a superset of the matching values.
+  static Vector<Int64> rangeToInt64 (const Vector<Double>& bounds,
+                                     Bool lower)
+  {
+    const Double limit  = 9007199254740992.;       //# 2^53
+    const Double maxVal = Double(std::numeric_limits<Int64>::max());
+    const Double dir = (lower  ?  -1 : 1) *
+                       std::numeric_limits<Double>::infinity();
+    Vector<Int64> keys(bounds.size());
+    for (size_t i=0; i<bounds.size(); ++i) {
+      Double v = bounds[i];
+      if (std::abs(v) >= limit) {
+        v = std::nextafter (v, dir);
+      }
+      v = (lower  ?  std::ceil(v) : std::floor(v));
+      if (v >= maxVal) {
+        keys[i] = std::numeric_limits<Int64>::max();
+      } else if (v <= -maxVal) {
+        keys[i] = std::numeric_limits<Int64>::min();
+      } else {
+        keys[i] = Int64(v);
+      }
+    }
+    return keys;
+  }
+
+  //# Select the rows using the persistent column indices (if possible).
+  Bool TableParseQuery::doIndexSelect (const Table& table, rownr_t nrmax,
+                                       Bool doTracing, Table& resultTable)
+  {
+    //# Indices only exist for persistent root tables.
+    if (table.tableType() != Table::Plain  ||  !table.isRootTable()) {
+      return False;
+    }
+    //# Get the ranges of the columns in the expression; they give a
+    //# superset of the rows matching the expression.
+    Block<TableExprRange> ranges;
+    node_p.ranges (ranges);
+    Bool found = False;
+    Vector<rownr_t> rows;
+    for (size_t i=0; i<ranges.size(); ++i) {
+      const TableColumn& col = ranges[i].getColumn();
+      const String& name = col.columnDesc().name();
+      if (!col.table().isRootTable()  ||  !col.table().isSameRoot (table)  ||
+          !ColumnIndexFile::exists (table, name)) {
+        continue;
+      }
+      ColumnIndexFile index(table, name);
+      if (! index.isValid()) {
+        if (doTracing) {
+          cerr << "index of column " << name << " is stale" << endl;
+        }
+        continue;
+      }
+      //# Int64 keys are looked up as integers to avoid rounding errors.
+      RowNumbers indRows;
+      if (col.columnDesc().dataType() == TpInt64) {
+        indRows = index.getRowNumbers (rangeToInt64 (ranges[i].start(), True),
+                                       rangeToInt64 (ranges[i].end(), False));
+      } else {
+        indRows = index.getRowNumbers (ranges[i].start(), ranges[i].end());
+      }
+      if (doTracing) {
+        cerr << "index of column " << name << " gave " << indRows.size()
+             << " rows (" << index.nrBytesRead() << " bytes read)" << endl;
+      }
+      //# Row numbers are in ascending order, so intersection is easy.
+      if (found) {
+        std::vector<rownr_t> both;
+        std::set_intersection (rows.begin(), rows.end(),
+                               indRows.begin(), indRows.end(),
+                               std::back_inserter(both));
+        rows.reference (Vector<rownr_t>(both));
+      } else {
+        rows.reference (indRows);
+        found = True;
+      }
+    }
+    if (! found) {
+      return False;
+    }
+    //# Evaluate the full expression for the rows found.
+    std::vector<rownr_t> selRows;
+    Bool valid;
+    for (rownr_t row : rows) {
+      node_p.get (TableExprId(row), valid);
+      if (valid) {
+        selRows.push_back (row);
+        if (nrmax > 0  &&  selRows.size() >= nrmax) {
+          break;
+        }
+      }
+    }
+    resultTable = table(RowNumbers(selRows));
+    return True;
+  }
+
   //# Execute the groupby.
   std::shared_ptr<TableExprGroupResult> TableParseQuery::doGroupby
   (Bool showTimings)
   {
     Timer timer;
-    std::shared_ptr<TableExprGroupResult> result = groupby_p.execGroupAggr(rownrs_p);
+    std::shared_ptr<TableExprGroupResult> result = groupby_p.execGroupAggr
+      (rownrs_p, nthreads_p);
     if (showTimings) {
       timer.show ("  Groupby     ");
     }
@@ -1247,7 +1353,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       //#//                 << rang[i].end() << endl;
       //#//        }
       Timer timer;
-      resultTable = table(node_p, nrmax);
+      //# First try if persistent column indices can be used.
+      if (doIndexSelect (table, nrmax, doTracing, resultTable)) {
+        if (doTracing) {
+          cerr << "WHERE evaluated using column indices" << endl;
+        }
+      //# The selection can be done in parallel if no pre-emption is needed
+      //# and all parts of the expression can be evaluated thread-safely.
+      } else if (nthreads_p > 1  &&  nrmax == 0  &&
+          TableExprNodeUtil::isThreadSafe (node_p.getRep().get())) {
+        if (doTracing) {
+          cerr << "WHERE evaluated using at most " << nthreads_p
+               << " threads" << endl;
+        }
+        resultTable = table(TableExprNodeUtil::parallelSelect
+                            (node_p.getRep().get(), table, nthreads_p));
+      } else {
+        resultTable = table(node_p, nrmax);
+      }
       if (showTimings) {
         timer.show ("  Where       ");
       }
@@ -302,6 +302,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     void setDMInfo (const Record& dminfo)
       { tableProject_p.setDMInfo (dminfo); }
 
+    // Set the maximum number of threads to use for the WHERE selection.
+    void setNThreads (uInt nthreads)
+      { nthreads_p = nthreads; }
+
     // Get the projected column names.
     const Block<String>& getColumnNames() const
       { return tableProject_p.getColumnNames(); }
@@ -366,6 +370,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // It returns the Table containing the subset of rows in the input Table.
     Table adjustApplySelNodes (const Table&);
 
+    // Do the WHERE step using the persistent column indices
+    // (see <linkto class=ColumnIndexFile>ColumnIndexFile</linkto>)
+    // of the columns in the ranges of the WHERE expression.
+    // The full expression is evaluated for the rows found in the indices.
+    // It returns False if no index could be used.
+    Bool doIndexSelect (const Table& table, rownr_t nrmax, Bool doTracing,
+                        Table& resultTable);
+
     // Do the groupby/aggregate step and return its result.
     std::shared_ptr<TableExprGroupResult> doGroupby (bool showTimings);
 
@@ -422,6 +434,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     TableParseGroupby groupby_p;
     //# Distinct values in output?
     Bool distinct_p;
+    //# The maximum number of threads to use for the WHERE selection.
+    uInt nthreads_p;
     //# The possible limit (= max nr of selected rows) (0 means no limit).
     Int64 limit_p;
     //# The possible last row (0 means no end; can be <0).
@@ -58,6 +58,39 @@ Bool foundError = False;
   }\
 }
 
+// Aggregate the records and finish the aggregation.
+// If the aggregate function can merge partial results, the records are
+// also aggregated in two parts that are merged (as done by a parallel
+// GROUPBY). That function object is returned as well.
+vector<std::shared_ptr<TableExprGroupFuncBase>> aggregate
+(TableExprAggrNode& aggr, const vector<Record>& recs)
+{
+  vector<std::shared_ptr<TableExprGroupFuncBase>> funcs;
+  funcs.push_back (aggr.makeGroupAggrFunc());
+  for (uInt i=0; i<recs.size(); ++i) {
+    TableExprId id(recs[i]);
+    funcs[0]->apply (id);
+  }
+  if (funcs[0]->canMerge()) {
+    std::shared_ptr<TableExprGroupFuncBase> part1 = aggr.makeGroupAggrFunc();
+    std::shared_ptr<TableExprGroupFuncBase> part2 = aggr.makeGroupAggrFunc();
+    for (uInt i=0; i<recs.size(); ++i) {
+      TableExprId id(recs[i]);
+      if (i < recs.size()/3) {
+        part1->apply (id);
+      } else {
+        part2->apply (id);
+      }
+    }
+    part1->merge (*part2);
+    funcs.push_back (part1);
+  }
+  for (const auto& func : funcs) {
+    func->finish();
+  }
+  return funcs;
+}
+
 void check (const TableExprNode& expr,
             const vector<Record>& recs,
             Bool expVal, const String& str)
@@ -66,17 +99,13 @@ void check (const TableExprNode& expr,
   // Get the aggregation node.
   TableExprAggrNode& aggr = const_cast<TableExprAggrNode&>
     (dynamic_cast<const TableExprAggrNode&>(*expr.getRep().get()));
-  std::shared_ptr<TableExprGroupFuncBase> func = aggr.makeGroupAggrFunc();
-  for (uInt i=0; i<recs.size(); ++i) {
-    TableExprId id(recs[i]);
-    func->apply (id);
-  }
-  func->finish();
-  Bool val = func->getBool();
-  if (val != expVal) {
-    foundError = True;
-    cout << str << ": found value " << val << "; expected "
-         << expVal << endl;
+  for (const auto& func : aggregate (aggr, recs)) {
+    Bool val = func->getBool();
+    if (val != expVal) {
+      foundError = True;
+      cout << str << ": found value " << val << "; expected "
+           << expVal << endl;
+    }
   }
 }
 
@@ -88,17 +117,13 @@ void check (const TableExprNode& expr,
   // Get the aggregation node.
   TableExprAggrNode& aggr = const_cast<TableExprAggrNode&>
     (dynamic_cast<const TableExprAggrNode&>(*expr.getRep().get()));
-  std::shared_ptr<TableExprGroupFuncBase> func = aggr.makeGroupAggrFunc();
-  for (uInt i=0; i<recs.size(); ++i) {
-    TableExprId id(recs[i]);
-    func->apply (id);
-  }
-  func->finish();
-  Int val = func->getInt();
-  if (val != expVal) {
-    foundError = True;
-    cout << str << ": found value " << val << "; expected "
-         << expVal << endl;
+  for (const auto& func : aggregate (aggr, recs)) {
+    Int val = func->getInt();
+    if (val != expVal) {
+      foundError = True;
+      cout << str << ": found value " << val << "; expected "
+           << expVal << endl;
+    }
   }
 }
 
@@ -110,17 +135,13 @@ void check (const TableExprNode& expr,
   // Get the aggregation node.
   TableExprAggrNode& aggr = const_cast<TableExprAggrNode&>
     (dynamic_cast<const TableExprAggrNode&>(*expr.getRep().get()));
-  std::shared_ptr<TableExprGroupFuncBase> func = aggr.makeGroupAggrFunc();
-  for (uInt i=0; i<recs.size(); ++i) {
-    TableExprId id(recs[i]);
-    func->apply (id);
-  }
-  func->finish();
-  Double val = func->getDouble();
-  if (!near (val, expVal, 1.e-10)) {
-    foundError = True;
-    cout << str << ": found value " << val << "; expected "
-         << expVal << endl;
+  for (const auto& func : aggregate (aggr, recs)) {
+    Double val = func->getDouble();
+    if (!near (val, expVal, 1.e-10)) {
+      foundError = True;
+      cout << str << ": found value " << val << "; expected "
+           << expVal << endl;
+    }
   }
 }
 
@@ -132,17 +153,13 @@ void check (const TableExprNode& expr,
   // Get the aggregation node.
   TableExprAggrNode& aggr = const_cast<TableExprAggrNode&>
     (dynamic_cast<const TableExprAggrNode&>(*expr.getRep().get()));
-  std::shared_ptr<TableExprGroupFuncBase> func = aggr.makeGroupAggrFunc();
-  for (uInt i=0; i<recs.size(); ++i) {
-    TableExprId id(recs[i]);
-    func->apply (id);
-  }
-  func->finish();
-  DComplex val = func->getDComplex();
-  if (!near (val, expVal, 1.e-10)) {
-    foundError = True;
-    cout << str << ": found value " << val << "; expected "
-         << expVal << endl;
+  for (const auto& func : aggregate (aggr, recs)) {
+    DComplex val = func->getDComplex();
+    if (!near (val, expVal, 1.e-10)) {
+      foundError = True;
+      cout << str << ": found value " << val << "; expected "
+           << expVal << endl;
+    }
   }
 }
 
@@ -154,12 +171,20 @@ void checkLazy (const TableExprNode& expr,
   // Get the aggregation node.
   TableExprAggrNode& aggr = const_cast<TableExprAggrNode&>
     (dynamic_cast<const TableExprAggrNode&>(*expr.getRep().get()));
+  // Collect the ids in two parts that are merged.
   TableExprGroupExprId funcid(0);
+  TableExprGroupExprId funcid2(0);
   for (uInt i=0; i<recs.size(); ++i) {
     TableExprId id(recs[i]);
-    funcid.apply (id);
+    if (i < recs.size()/2) {
+      funcid.apply (id);
+    } else {
+      funcid2.apply (id);
+    }
   }
+  funcid.merge (funcid2);
   funcid.finish();
+  AlwaysAssertExit (funcid.getIds()->size() == recs.size());
   std::shared_ptr<TableExprGroupFuncBase> func = aggr.makeGroupAggrFunc();
   Double val = func->getDouble (*funcid.getIds());
   if (val != expVal) {
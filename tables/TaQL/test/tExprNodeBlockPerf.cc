@@ -0,0 +1,203 @@
+//# tExprNodeBlockPerf.cc: Test program for block-wise expression evaluation
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <stdexcept>
+#include <iostream>
+using namespace casacore;
+using namespace std;
+
+// <summary>
+// Test program comparing the row-wise and block-wise evaluation of
+// table expressions. It checks that both give the same result and shows
+// the number of rows per second.
+// It also checks that a parallel selection gives the same rows and that
+// a parallel GROUPBY gives the same groups.
+// An optional argument gives the number of rows to use.
+// </summary>
+
+void createTable (rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double>("TIME"));
+  td.addColumn (ScalarColumnDesc<Int>("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<Int>("ANTENNA2"));
+  SetupNewTable newtab("tExprNodeBlockPerf_tmp.data", td, Table::New);
+  StandardStMan ssm;
+  newtab.bindAll (ssm);
+  Table tab(newtab, nrow);
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Int> ant1(tab, "ANTENNA1");
+  ScalarColumn<Int> ant2(tab, "ANTENNA2");
+  // Mimic an MS with 10 antennas (including autocorrelations).
+  rownr_t row = 0;
+  for (Int t=0; row<nrow; ++t) {
+    for (Int a1=0; a1<10 && row<nrow; ++a1) {
+      for (Int a2=a1; a2<10 && row<nrow; ++a2) {
+        time.put (row, 4.5e9 + t);
+        ant1.put (row, a1);
+        ant2.put (row, a2);
+        ++row;
+      }
+    }
+  }
+}
+
+void showRate (const String& name, rownr_t nrow, Timer& timer)
+{
+  Double sec = timer.real();
+  cout << "  " << name << ' ';
+  if (sec > 0) {
+    cout << Int64(nrow / sec) << " rows/s";
+  }
+  cout << endl;
+}
+
+void checkExpr (const String& name, const TableExprNode& expr, rownr_t nrow)
+{
+  cout << name << endl;
+  // Evaluate row by row.
+  Timer timer;
+  Block<Bool> rowVals(nrow);
+  TableExprId id;
+  for (rownr_t i=0; i<nrow; ++i) {
+    id.setRownr (i);
+    expr.get (id, rowVals[i]);
+  }
+  showRate ("per row", nrow, timer);
+  // Evaluate in blocks of rows.
+  timer.mark();
+  Block<Bool> blockVals(nrow);
+  const rownr_t blockSize = 4096;
+  for (rownr_t st=0; st<nrow; st+=blockSize) {
+    expr.getRep()->getBoolBlock (st, std::min(blockSize, nrow-st),
+                                 blockVals.storage() + st);
+  }
+  showRate ("blocked", nrow, timer);
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (rowVals[i] == blockVals[i]);
+  }
+}
+
+void checkGroups (const Table& tab1, const Table& tab2)
+{
+  AlwaysAssertExit (tab1.nrow() == tab2.nrow());
+  Vector<String> names = tab1.tableDesc().columnNames();
+  for (uInt i=0; i<names.size(); ++i) {
+    TableColumn col1(tab1, names[i]);
+    TableColumn col2(tab2, names[i]);
+    for (rownr_t row=0; row<tab1.nrow(); ++row) {
+      AlwaysAssertExit (near (col1.asdouble(row), col2.asdouble(row), 1e-10));
+    }
+  }
+}
+
+void testPerf (rownr_t nrow)
+{
+  cout << "testPerf with " << nrow << " rows ..." << endl;
+  createTable (nrow);
+  Table tab("tExprNodeBlockPerf_tmp.data");
+  Double tmid = 4.5e9 + nrow / 110;
+  checkExpr ("TIME > x && ANTENNA1 != ANTENNA2",
+             tab.col("TIME") > tmid && tab.col("ANTENNA1") != tab.col("ANTENNA2"),
+             nrow);
+  checkExpr ("ANTENNA1 == 3 || ANTENNA2+1 >= 8",
+             tab.col("ANTENNA1") == 3 || tab.col("ANTENNA2") + 1 >= 8,
+             nrow);
+  checkExpr ("!(sqrt(TIME-4.5e9) < 10 || ANTENNA1*ANTENNA2 > 20)",
+             !(sqrt(tab.col("TIME") - 4.5e9) < 10. ||
+               tab.col("ANTENNA1") * tab.col("ANTENNA2") > 20),
+             nrow);
+  // Check if a selection gives the same result in TaQL and row-wise.
+  Timer timer;
+  Table sel = tableCommand ("select from $1 where TIME > " +
+                            String::toString(tmid) +
+                            " && ANTENNA1 != ANTENNA2", tab).table();
+  showRate ("TaQL   ", nrow, timer);
+  rownr_t nsel = 0;
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Int> ant1(tab, "ANTENNA1");
+  ScalarColumn<Int> ant2(tab, "ANTENNA2");
+  for (rownr_t i=0; i<nrow; ++i) {
+    if (time(i) > tmid  &&  ant1(i) != ant2(i)) {
+      ++nsel;
+    }
+  }
+  AlwaysAssertExit (sel.nrow() == nsel);
+  // Check if a parallel selection gives the same rows.
+  TableExprNode expr (tab.col("TIME") > tmid &&
+                      tab.col("ANTENNA1") != tab.col("ANTENNA2"));
+  AlwaysAssertExit (TableExprNodeUtil::isThreadSafe (expr.getRep().get()));
+  timer.mark();
+  Vector<rownr_t> rows = TableExprNodeUtil::parallelSelect
+    (expr.getRep().get(), tab, 4);
+  showRate ("4 threads", nrow, timer);
+  AlwaysAssertExit (allEQ (rows, sel.rowNumbers(tab)));
+  timer.mark();
+  Table selthr = tableCommand ("using style threads=4 select from $1 where "
+                               "TIME > " + String::toString(tmid) +
+                               " && ANTENNA1 != ANTENNA2", tab).table();
+  showRate ("TaQL 4 threads", nrow, timer);
+  AlwaysAssertExit (allEQ (selthr.rowNumbers(tab), sel.rowNumbers(tab)));
+  // Check if a parallel GROUPBY gives the same groups and results.
+  String groupCmd ("select ANTENNA1, gsum(TIME-4.5e9) as S, gmean(ANTENNA2)"
+                   " as M, gcount() as N from $1 groupby ANTENNA1");
+  timer.mark();
+  Table grp = tableCommand (groupCmd, tab).table();
+  showRate ("GROUPBY", nrow, timer);
+  timer.mark();
+  Table grpthr = tableCommand ("using style threads=4 " + groupCmd,
+                               tab).table();
+  showRate ("GROUPBY 4 threads", nrow, timer);
+  checkGroups (grpthr, grp);
+  // An expression containing a non-block function cannot be parallelized.
+  AlwaysAssertExit (! TableExprNodeUtil::isThreadSafe
+                    ((tab.col("ANTENNA1") % 2 == 0).getRep().get()));
+  // Check if a limit is applied correctly.
+  Table sellim = tab(tab.col("ANTENNA1") != tab.col("ANTENNA2"), 10);
+  AlwaysAssertExit (sellim.nrow() == std::min(rownr_t(10), nrow));
+}
+
+int main (int argc, const char* argv[])
+{
+  rownr_t nrow = 10000;
+  if (argc > 1) {
+    nrow = atol(argv[1]);
+  }
+  try {
+    testPerf (nrow);
+  } catch (const exception& x) {
+    cout << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
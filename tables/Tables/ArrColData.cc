@@ -28,6 +28,7 @@
 #include <casacore/tables/Tables/ColumnSet.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/tables/Tables/TableTrace.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayIter.h>
@@ -168,10 +169,32 @@ void ArrayColumnData::getArray (rownr_t rownr, ArrayBase& array) const
                          array.shape());
     }
     checkReadLock (True);
-    dataColPtr_p->getArrayV (rownr, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ,
+                                1, array.nelements());
+      dataColPtr_p->getArrayV (rownr, array);
+    }
     autoReleaseLock();
 }
 
+Bool ArrayColumnData::getArrayView (rownr_t rownr, ArrayBase& array) const
+{
+    checkReadLock (True);
+    Bool done;
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ, 1, 0);
+      done = dataColPtr_p->getArrayViewV (rownr, array);
+    }
+    autoReleaseLock();
+    // The shape is only known after the array is filled. If no view is
+    // possible, the caller reads the value which is traced by getArray.
+    if (done  &&  rtraceColumn_p) {
+      TableTrace::trace (traceId(), columnDesc().name(), 'r', rownr,
+                         array.shape());
+    }
+    return done;
+}
+
 void ArrayColumnData::getSlice (rownr_t rownr, const Slicer& ns,
                                 ArrayBase& array) const
 {
@@ -181,7 +204,11 @@ void ArrayColumnData::getSlice (rownr_t rownr, const Slicer& ns,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
-    dataColPtr_p->getSliceV (rownr, ns, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ,
+                                1, array.nelements());
+      dataColPtr_p->getSliceV (rownr, ns, array);
+    }
     autoReleaseLock();
 }
 
@@ -196,7 +223,11 @@ void ArrayColumnData::putArray (rownr_t rownr, const ArrayBase& array)
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
-    dataColPtr_p->putArrayV (rownr, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE,
+                                1, array.nelements());
+      dataColPtr_p->putArrayV (rownr, array);
+    }
     autoReleaseLock();
 }
 
@@ -212,7 +243,11 @@ void ArrayColumnData::putSlice (rownr_t rownr, const Slicer& ns,
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
-    dataColPtr_p->putSliceV (rownr, ns, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE,
+                                1, array.nelements());
+      dataColPtr_p->putSliceV (rownr, ns, array);
+    }
     autoReleaseLock();
 }
 
@@ -228,7 +263,11 @@ void ArrayColumnData::getArrayColumn (ArrayBase& array) const
                          array.shape());
     }
     checkReadLock (True);
-    dataColPtr_p->getArrayColumnV (array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ,
+                                nrow(), array.nelements());
+      dataColPtr_p->getArrayColumnV (array);
+    }
     autoReleaseLock();
 }
 
@@ -241,7 +280,11 @@ void ArrayColumnData::getArrayColumnCells (const RefRows& rownrs,
                          array.shape());
     }
     checkReadLock (True);
-    dataColPtr_p->getArrayColumnCellsV (rownrs, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ,
+                                rownrs.nrow(), array.nelements());
+      dataColPtr_p->getArrayColumnCellsV (rownrs, array);
+    }
     autoReleaseLock();
 }
 
@@ -254,7 +297,11 @@ void ArrayColumnData::getColumnSlice (const Slicer& ns,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
-    dataColPtr_p->getColumnSliceV (ns, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ,
+                                nrow(), array.nelements());
+      dataColPtr_p->getColumnSliceV (ns, array);
+    }
     autoReleaseLock();
 }
 
@@ -268,7 +315,11 @@ void ArrayColumnData::getColumnSliceCells (const RefRows& rownrs,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
-    dataColPtr_p->getColumnSliceCellsV (rownrs, ns, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ,
+                                rownrs.nrow(), array.nelements());
+      dataColPtr_p->getColumnSliceCellsV (rownrs, ns, array);
+    }
     autoReleaseLock();
 }
 
@@ -282,7 +333,11 @@ void ArrayColumnData::putArrayColumn (const ArrayBase& array)
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
-    dataColPtr_p->putArrayColumnV (array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE,
+                                nrow(), array.nelements());
+      dataColPtr_p->putArrayColumnV (array);
+    }
     autoReleaseLock();
 }
 
@@ -297,7 +352,11 @@ void ArrayColumnData::putArrayColumnCells (const RefRows& rownrs,
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
-    dataColPtr_p->putArrayColumnCellsV (rownrs, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE,
+                                rownrs.nrow(), array.nelements());
+      dataColPtr_p->putArrayColumnCellsV (rownrs, array);
+    }
     autoReleaseLock();
 }
 
@@ -313,7 +372,11 @@ void ArrayColumnData::putColumnSlice (const Slicer& ns,
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
-    dataColPtr_p->putColumnSliceV (ns, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE,
+                                nrow(), array.nelements());
+      dataColPtr_p->putColumnSliceV (ns, array);
+    }
     autoReleaseLock();
 }
 
@@ -330,7 +393,11 @@ void ArrayColumnData::putColumnSliceCells (const RefRows& rownrs,
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
-    dataColPtr_p->putColumnSliceCellsV (rownrs, ns, array);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE,
+                                rownrs.nrow(), array.nelements());
+      dataColPtr_p->putColumnSliceCellsV (rownrs, ns, array);
+    }
     autoReleaseLock();
 }
 
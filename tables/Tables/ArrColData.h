@@ -156,6 +156,9 @@ public:
     // the actual length. This is checked by ArrayColumn.
     void getArray (rownr_t rownr, ArrayBase& arrayPtr) const;
 
+    // Try to reference the array in a particular cell without copying it.
+    Bool getArrayView (rownr_t rownr, ArrayBase& arrayPtr) const;
+
     // Get a slice of an N-dimensional array in a particular cell.
     // The length of the array given by ArrayBase must match
     // the actual length. This is checked by ArrayColumn.
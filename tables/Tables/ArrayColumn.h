@@ -168,6 +168,27 @@ public:
     Array<T> operator() (rownr_t rownr) const;
     // </group>
 
+    // Get the array value in a particular cell without copying it if
+    // possible. The array references the data in the storage manager's
+    // memory if the storage manager supports it (e.g., StandardStMan with
+    // a memory-mapped file, see its description). Otherwise the value is
+    // copied into a new array. <src>isView</src> tells if the array
+    // references the data.
+    // <br>The array is const, because a view must not be changed.
+    // Note that a copy made by the Array copy constructor or by
+    // <src>reference</src> shares the data, so it is not const. The data
+    // referenced by a view are readonly memory, so writing into the view
+    // or such a copy gives a segmentation fault. Use <src>copy()</src> to
+    // get an array that can be changed.
+    // The referenced data are kept alive by the array, so it stays valid
+    // after the table is closed, resynced or reopened for read/write.
+    // However, the values can reflect later changes made by another
+    // process.
+    // <group>
+    const Array<T> getView (rownr_t rownr) const;
+    const Array<T> getView (rownr_t rownr, Bool& isView) const;
+    // </group>
+
     // Get a slice of an N-dimensional array in a particular cell
     // (i.e. table row).
     // The row numbers count from 0 until #rows-1.
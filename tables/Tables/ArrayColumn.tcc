@@ -133,6 +133,26 @@ void ArrayColumn<T>::get (rownr_t rownr, Array<T>& arr, Bool resize) const
 }
 
 
+template<class T>
+const Array<T> ArrayColumn<T>::getView (rownr_t rownr) const
+{
+    Bool isView;
+    return getView (rownr, isView);
+}
+
+template<class T>
+const Array<T> ArrayColumn<T>::getView (rownr_t rownr, Bool& isView) const
+{
+    TABLECOLUMNCHECKROW(rownr);
+    Array<T> arr;
+    isView = baseColPtr_p->getArrayView (rownr, arr);
+    if (!isView) {
+        get (rownr, arr, True);
+    }
+    return arr;
+}
+
+
 template<class T>
 Array<T> ArrayColumn<T>::getSlice (rownr_t rownr,
                                    const Slicer& arraySection) const
@@ -105,6 +105,17 @@ void BaseColumn::getArray (rownr_t, ArrayBase&) const
                        colDesc_p.name() + "; only valid for an array"));
 }
 
+Bool BaseColumn::getArrayView (rownr_t, ArrayBase&) const
+{
+  return False;
+}
+
+Bool BaseColumn::getZoneRanges (const Vector<Double>&, const Vector<Double>&,
+                                std::vector<std::pair<rownr_t,rownr_t>>&) const
+{
+  return False;
+}
+
 void BaseColumn::getSlice (rownr_t, const Slicer&, ArrayBase&) const
 {
   throw (TableInvOper ("getSlice() not implemented for column " +
@@ -34,6 +34,8 @@
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -159,9 +161,23 @@ public:
     // Get an array from a particular cell.
     virtual void getArray (rownr_t rownr, ArrayBase& dataPtr) const;
 
+    // Try to reference the array in a particular cell without copying it
+    // (see DataManagerColumn::getArrayViewV).
+    // It returns False if not possible.
+    // The default implementation returns False.
+    virtual Bool getArrayView (rownr_t rownr, ArrayBase& dataPtr) const;
+
     // Get a slice of an N-dimensional array in a particular cell.
     virtual void getSlice (rownr_t rownr, const Slicer&, ArrayBase& dataPtr) const;
 
+    // Get the ranges of rows that can contain values in the given value
+    // ranges (see DataManagerColumn::getZoneRanges).
+    // It returns False if not possible.
+    // The default implementation returns False.
+    virtual Bool getZoneRanges (const Vector<Double>& lower,
+                                const Vector<Double>& upper,
+                                std::vector<std::pair<rownr_t,rownr_t>>& rowRanges) const;
+
     // Get the vector of all scalar values in a column.
     virtual void getScalarColumn (ArrayBase& dataPtr) const;
 
@@ -91,7 +91,8 @@ BaseTableIterator::BaseTableIterator (const std::shared_ptr<BaseTable>& btp,
         colPtr_p[i] = sortTab_p->getColumn (keys[i]);
         colPtr_p[i]->allocIterBuf (lastVal_p[i], curVal_p[i], cmpObj_p[i]);
     }
-    if (cacheIterationBoundaries) {
+    // Boundaries are only cached if the table has been sorted.
+    if (sortIterBoundaries_p) {
         sortIterBoundariesIt_p   = sortIterBoundaries_p->begin();
         sortIterKeyIdxChangeIt_p = sortIterKeyIdxChange_p->begin();
         aBaseTable_p = sortTab_p->makeRefTable (False, 0);
@@ -197,8 +198,7 @@ std::shared_ptr<BaseTable> BaseTableIterator::next()
     ++sortIterKeyIdxChangeIt_p;
 
     //# Adjust rownrs in case source table is already a RefTable.
-    Vector<rownr_t>& rownrs = aRefTable_p->rowStorage();
-    sortTab_p->adjustRownrs (aRefTable_p->nrow(), rownrs, False);
+    aRefTable_p->adjustToRoot (sortTab_p.get(), False);
     return aBaseTable_p;
 }
 
@@ -214,8 +214,8 @@ std::shared_ptr<BaseTable> BaseTableIterator::noCachedIterBoundariesNext()
     if (lastRow_p >= sortTab_p->nrow()) {
 	return baseTabPtr;                         // the end of the table
     }
-    // Add the last found rownr to this iteration group.
-    itp->addRownr (lastRow_p);
+    // The last found rownr starts this iteration group.
+    rownr_t startThisGroup = lastRow_p;
     for (uInt i=0; i<nrkeys_p; i++) {
 	colPtr_p[i]->get (lastRow_p, lastVal_p[i]);
     }
@@ -235,16 +235,16 @@ std::shared_ptr<BaseTable> BaseTableIterator::noCachedIterBoundariesNext()
 	if (!match) {
 	    break;
 	}
-	itp->addRownr (lastRow_p);
     }
+    // The rows of the group are contiguous, so add them as a range.
+    itp->addRownrRange (startThisGroup, lastRow_p - 1);
 
     // If we've reached the end of the table, clear the keyCh_p
     if (lastRow_p == nr) {
       keyChangeAtLastNext_p=String();
     }
     //# Adjust rownrs in case source table is already a RefTable.
-    Vector<rownr_t>& rownrs = itp->rowStorage();
-    sortTab_p->adjustRownrs (itp->nrow(), rownrs, False);
+    itp->adjustToRoot (sortTab_p.get(), False);
     return baseTabPtr;
 }
 
@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/RefTable.h>
 #include <casacore/tables/Tables/TableCopy.h>
 #include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/TableExternalSort.h>
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
@@ -84,6 +85,7 @@ void BaseTable::BaseTableCommon (const String& name, int option, rownr_t nrrow)
     delete_p = False;
     madeDir_p = True;
     itsTraceId = -1;
+    rowRemoveCounter_p = 0;
 
     if (name_p.empty()) {
         name_p = File::newUniqueName ("", "tab").originalName();
@@ -520,11 +522,13 @@ void BaseTable::trueDeepCopy (const String& newName,
     //# Prepare the copy (do some extra checks).
     prepareCopyRename (absNewName, tableOption);
     // Create the new table and copy everything.
+    // The new table is not used by others yet, so it can be locked
+    // permanently, which makes it possible to copy the columns in parallel.
     Table oldtab(ncThis);
     Table newtab = TableCopy::makeEmptyTable
                         (absNewName, dataManagerInfo, oldtab, Table::New,
 			 Table::EndianFormat(endianFormat), True, noRows,
-                         stopt);
+                         stopt, TableLock(TableLock::PermanentLocking));
     if (!noRows) {
       TableCopy::copyRows (newtab, oldtab);
     }
@@ -597,6 +601,11 @@ Bool BaseTable::canRemoveRow() const
 void BaseTable::addRow (rownr_t, Bool)
     { throw (TableInvOper ("Table: cannot add a row to table " + name_p)); }
 
+uInt64 BaseTable::getRowRemoveCounter() const
+{
+    return rowRemoveCounter_p;
+}
+
 void BaseTable::removeRow (rownr_t)
     { throw (TableInvOper ("Table: cannot remove a row from table " + name_p)); }
 
@@ -713,6 +722,22 @@ std::shared_ptr<BaseTable> BaseTable::doSort
  std::shared_ptr<Vector<rownr_t>> sortIterBoundaries,
  std::shared_ptr<Vector<size_t>> sortIterKeyIdxChange)
 {
+    //# Use an external merge sort if the keys do not fit in the
+    //# memory budget.
+    uInt64 budget = TableExternalSort::memoryBudget();
+    if (budget > 0  &&
+        nrow() * TableExternalSort::rowSize (sortCol) > budget) {
+        rownr_t nrrow = nrow();
+        std::shared_ptr<RefTable> resultTable = makeRefTable (False, nrrow);
+        Vector<rownr_t>& rows = resultTable->rowStorage();
+        TableExternalSort extSort (sortCol, cmpObj, order, option, budget);
+        nrrow = extSort.sort (rows, nrrow, sortIterBoundaries.get(),
+                              sortIterKeyIdxChange.get());
+        adjustRownrs (nrrow, rows, False);
+        resultTable->setNrrow (nrrow);
+        resultTable->compactRows();
+        return resultTable;
+    }
     uInt nrkey = sortCol.nelements();
     //# Create a sort object.
     //# Pass all keys (and their data) to it.
@@ -738,6 +763,8 @@ std::shared_ptr<BaseTable> BaseTable::doSort
     }
     adjustRownrs (nrrow, rows, False);
     resultTable->setNrrow (nrrow);
+    //# A table that was (nearly) in order results in long runs of rows.
+    resultTable->compactRows();
     return resultTable;
 }
 
@@ -805,30 +832,59 @@ std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
     }
     //# Create a reference table, which will be in row order.
     //# Loop through all rows and add to reference table if true.
+    //# The expression is evaluated for a block of rows at a time, which
+    //# makes it possible to use bulk column reads and to avoid walking the
+    //# expression tree for each row.
+    //# If a maximum number of rows is given, the block size is limited to
+    //# the number of rows still needed to avoid evaluating too many rows.
     //# Add the rownr of the root table (one may search a reference table).
     //# Adjust the row numbers to reflect row numbers in the root table.
+    //# For a plain table the storage managers can tell which ranges of
+    //# rows can match the ranges of column values in the expression,
+    //# so only those rows need to be evaluated.
     std::shared_ptr<RefTable> resultTable = makeRefTable (True, 0);
     DebugAssert (static_cast<bool>(resultTable), AipsError);
-    Bool val;
+    const rownr_t blockSize = 4096;
+    Block<Bool> vals(blockSize);
     rownr_t nrrow = nrow();
-    TableExprId id;
-    for (rownr_t i=0; i<nrrow; i++) {
-      id.setRownr (i);
-      node.get (id, val);
-      if (val) {
-        if (offset == 0) {
-          resultTable->addRownr (i);                  // add row
-          // Stop if max #rows reached (note that maxRow==0 means no limit).
-          if (resultTable->nrow() == maxRow) {
-            break;
+    std::vector<std::pair<rownr_t,rownr_t>> rowRanges;
+    if (tableType() != Table::Plain  ||
+        !TableExprNodeUtil::getZoneRanges (node.getRep().get(), tableName(),
+                                           rowRanges)) {
+      rowRanges.clear();
+      if (nrrow > 0) {
+        rowRanges.push_back (std::make_pair (rownr_t(0), nrrow-1));
+      }
+    }
+    Bool done = False;
+    for (size_t i=0; i<rowRanges.size()  &&  !done; ++i) {
+      rownr_t st = rowRanges[i].first;
+      rownr_t end = rowRanges[i].second + 1;
+      while (st < end  &&  !done) {
+        rownr_t nr = std::min (blockSize, end - st);
+        if (maxRow > 0) {
+          nr = std::min (nr, maxRow + offset - resultTable->nrow());
+        }
+        node.getRep()->getBoolBlock (st, nr, vals.storage());
+        for (rownr_t j=0; j<nr; ++j) {
+          if (vals[j]) {
+            if (offset == 0) {
+              resultTable->addRownr (st+j);             // add row
+              // Stop if max #rows reached (note that maxRow==0 means no limit).
+              if (resultTable->nrow() == maxRow) {
+                done = True;
+                break;
+              }
+            } else {
+              // Skip first offset matching rows.
+              offset--;
+            }
           }
-        } else {
-          // Skip first offset matching rows.
-          offset--;
         }
+        st += nr;
       }
     }
-    adjustRownrs (resultTable->nrow(), resultTable->rowStorage(), False);
+    resultTable->adjustToRoot (this, False);
     return resultTable;
 }
 
@@ -865,14 +921,14 @@ std::shared_ptr<BaseTable> BaseTable::tabAnd (BaseTable* that)
       return this->shared_from_this();                    // that is root
     }
     //# There is no root table involved, so we have to deal with RefTables.
-    //# Get both rownr arrays which are sorted if not in row order.
-    Vector<rownr_t> r1 = this->logicRows();
-    Vector<rownr_t> r2 = that->logicRows();
+    //# Get the runs of both rownr arrays which are sorted if not in row order.
+    RowRunMap r1 = this->logicRuns();
+    RowRunMap r2 = that->logicRuns();
     // Create RefTable which will be in row order.
     std::shared_ptr<RefTable> rtp = makeRefTable (True, 0);
     DebugAssert (static_cast<bool>(rtp), AipsError);
     // Store rownrs in new RefTable.
-    rtp->refAnd (r1.size(), r1.data(), r2.size(), r2.data());
+    rtp->refAnd (r1, r2);
     return rtp;
 }
 
@@ -888,14 +944,14 @@ std::shared_ptr<BaseTable> BaseTable::tabOr (BaseTable* that)
         return root()->shared_from_this();
     }
     //# There is no root table involved, so we have to deal with RefTables.
-    //# Get both rownr arrays which are sorted if not in row order.
-    Vector<rownr_t> r1 = this->logicRows();
-    Vector<rownr_t> r2 = that->logicRows();
+    //# Get the runs of both rownr arrays which are sorted if not in row order.
+    RowRunMap r1 = this->logicRuns();
+    RowRunMap r2 = that->logicRuns();
     // Create RefTable which will be in row order.
     std::shared_ptr<RefTable> rtp = makeRefTable (True, 0);
     DebugAssert (static_cast<bool>(rtp), AipsError);
     // Store rownrs in new RefTable.
-    rtp->refOr (r1.size(), r1.data(), r2.size(), r2.data());
+    rtp->refOr (r1, r2);
     return rtp;
 }
 
@@ -914,14 +970,14 @@ std::shared_ptr<BaseTable> BaseTable::tabSub (BaseTable* that)
 	return that->tabNot();
     }
     //# There is no root table involved, so we have to deal with RefTables.
-    //# Get both rownr arrays which are sorted if not in row order.
-    Vector<rownr_t> r1 = this->logicRows();
-    Vector<rownr_t> r2 = that->logicRows();
+    //# Get the runs of both rownr arrays which are sorted if not in row order.
+    RowRunMap r1 = this->logicRuns();
+    RowRunMap r2 = that->logicRuns();
     // Create RefTable which will be in row order.
     std::shared_ptr<RefTable> rtp = makeRefTable (True, 0);
     DebugAssert (static_cast<bool>(rtp), AipsError);
     // Store rownrs in new RefTable.
-    rtp->refSub (r1.size(), r1.data(), r2.size(), r2.data());
+    rtp->refSub (r1, r2);
     return rtp;
 }
 
@@ -939,14 +995,14 @@ std::shared_ptr<BaseTable> BaseTable::tabXor (BaseTable* that)
 	return tabNot();
     }
     //# There is no root table involved, so we have to deal with RefTables.
-    //# Get both rownr arrays which are sorted if not in row order.
-    Vector<rownr_t> r1 = this->logicRows();
-    Vector<rownr_t> r2 = that->logicRows();
+    //# Get the runs of both rownr arrays which are sorted if not in row order.
+    RowRunMap r1 = this->logicRuns();
+    RowRunMap r2 = that->logicRuns();
     // Create RefTable which will be in row order.
     std::shared_ptr<RefTable> rtp = makeRefTable (True, 0);
     DebugAssert (static_cast<bool>(rtp), AipsError);
     // Store rownrs in new RefTable.
-    rtp->refXor (r1.size(), r1.data(), r2.size(), r2.data());
+    rtp->refXor (r1, r2);
     return rtp;
 }
 
@@ -959,13 +1015,13 @@ std::shared_ptr<BaseTable> BaseTable::tabNot()
 	return makeRefTable (True, 0);
     }
     //# There is no root table involved, so we have to deal with RefTables.
-    //# Get rownr array which is sorted if not in row order.
-    Vector<rownr_t> r1 = this->logicRows();
+    //# Get the runs of the rownr array which is sorted if not in row order.
+    RowRunMap r1 = this->logicRuns();
     // Create RefTable which will be in row order.
     std::shared_ptr<RefTable> rtp = makeRefTable (True, 0);
     DebugAssert (static_cast<bool>(rtp), AipsError);
     // Store rownrs in new RefTable.
-    rtp->refNot (r1.size(), r1.data(), root()->nrow());
+    rtp->refNot (r1, root()->nrow());
     return rtp;
 }
 
@@ -977,21 +1033,25 @@ void BaseTable::logicCheck (BaseTable* that)
     }
 }
 
-//# Get the rownrs from the reference table.
-//# Note that rowStorage() throws an exception if it is not a RefTable.
-//# Sort them if not in row order.
-Vector<rownr_t> BaseTable::logicRows()
+//# Get the runs of the rownrs from the reference table.
+//# The runs of a RefTable in row order are used as such, so its rownrs
+//# do not need to be expanded. Otherwise the rownrs are sorted.
+RowRunMap BaseTable::logicRuns()
 {
     AlwaysAssert (!isNull(), AipsError);
-    Vector<rownr_t> rows (rowStorage());
-    if (rowOrder()) {
-      return rows;
-    }
-    //# rows are not in order, so sort them.
-    //# They have to be copied, because the original should not be changed.
-    Vector<rownr_t> rowscp (rows.copy());
-    GenSort<rownr_t>::sort (rowscp);
-    return rowscp;
+    const RefTable* rtp = dynamic_cast<const RefTable*>(this);
+    if (rtp  &&  rtp->hasRowRuns()  &&  rowOrder()) {
+        return rtp->rowRuns();
+    }
+    Vector<rownr_t> rows (rowNumbers());
+    if (! rowOrder()) {
+        //# rows are not in order, so sort them.
+        //# They have to be copied, because the original should not be changed.
+        Vector<rownr_t> rowscp (rows.copy());
+        GenSort<rownr_t>::sort (rowscp);
+        return RowRunMap (rowscp);
+    }
+    return RowRunMap (rows);
 }
 
 
@@ -46,6 +46,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
 class RefTable;
+class RowRunMap;
 // class TableDesc;  !Forward declaration not recognized SGI compiler
 class TableLock;
 class BaseColumn;
@@ -171,6 +172,14 @@ public:
     // Get the modify counter.
     virtual uInt getModifyCounter() const = 0;
 
+    // Get the counter telling how often rows can have been removed from
+    // the table. It is incremented when rows are removed in this process
+    // and when the table is synchronized with changes made by another
+    // process (which could have removed rows). If unchanged, a change in
+    // the number of rows means that rows have been added at the end.
+    // The default implementation returns the counter of this object.
+    virtual uInt64 getRowRemoveCounter() const;
+
     // Set the table to being changed. By default it does nothing.
     virtual void setTableChanged();
 
@@ -507,6 +516,7 @@ protected:
     TableInfo      info_p;              //# Table information (type, etc.)
     Bool           madeDir_p;           //# True = table dir has been created
     int            itsTraceId;          //# table-id for TableTrace tracing
+    uInt64         rowRemoveCounter_p;  //# #times rows may have been removed
 
     // Do the callback for scratch tables (if callback is set).
     void scratchCallback (Bool isScratch, const String& oldName) const;
@@ -574,9 +584,9 @@ private:
     // same root.
     void logicCheck (BaseTable* that);
 
-    // Get the rownrs of the table in ascending order to be
+    // Get the runs of the rownrs of the table in ascending order to be
     // used in the logical operation on the table.
-    Vector<rownr_t> logicRows();
+    RowRunMap logicRuns();
 
     // Make an empty table description.
     // This is used if one asks for the description of a NullTable.
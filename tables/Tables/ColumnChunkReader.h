@@ -0,0 +1,177 @@
+//# ColumnChunkReader.h: Read a table column in chunks of rows
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_COLUMNCHUNKREADER_H
+#define TABLES_COLUMNCHUNKREADER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <future>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Read a table column in chunks of rows into a reusable buffer
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tColumnChunkReader">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=ScalarColumn>ScalarColumn</linkto>
+//   <li> <linkto class=ArrayColumn>ArrayColumn</linkto>
+//   <li> <linkto class=RefRows>RefRows</linkto>
+// </prerequisite>
+
+// <synopsis>
+// ColumnChunkReader reads all rows of a scalar or array column in chunks
+// of a given number of rows. Each chunk is read into a buffer owned by
+// the caller, which is only resized if its shape does not match the chunk
+// (thus normally only for the last chunk). In this way a loop over a
+// large column does not allocate an array per chunk.
+// <br>For a scalar column the buffer is a Vector with a length of the
+// number of rows in the chunk. For an array column the buffer has the
+// cell shape with the rows as the last axis, so all cells must have the
+// same shape (as for <src>ArrayColumn::getColumnRange</src>).
+// <p>
+// The table can be a root table or a selection (a RefTable). In the latter
+// case the rows of a chunk are mapped to rows in the root table, where
+// contiguous runs of rows are read as a single slice by the storage
+// manager.
+// <p>
+// Optionally the next chunk is read on a background thread while the
+// caller processes the current one. Its data are handed over by swapping
+// the storage of the buffer with the internal prefetch buffer, so no data
+// are copied. It means that the data of a chunk are only valid until the
+// next call to <src>next</src>, also for references to the buffer.
+// <note role=caution>
+// A table is not thread-safe, so while prefetching the table (including
+// its other columns) should not be accessed by the caller, not even by
+// another ColumnChunkReader. It means that prefetching should only be
+// used in a loop processing a single column.
+// </note>
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms");
+//   ColumnChunkReader<Complex> reader(tab, "DATA", 10000);
+//   Array<Complex> buffer;
+//   while (reader.next (buffer)) {
+//     // buffer has shape [ncorr,nchan,nrow] for rows
+//     // reader.firstRow() till reader.firstRow() + reader.nrowChunk()
+//   }
+// </srcblock>
+// </example>
+
+// <motivation>
+// Reading a column in chunks using getColumnRange allocates a result array
+// per chunk, which dominates the time when the chunks are small.
+// </motivation>
+
+// <templating arg=T>
+//  <li> Any data type supported by ScalarColumn and ArrayColumn.
+// </templating>
+
+template<class T>
+class ColumnChunkReader
+{
+public:
+    // Construct the reader for the given column in the table.
+    // Each chunk contains at most <src>chunkSize</src> rows.
+    // If <src>prefetch=True</src>, the next chunk is read on a
+    // background thread.
+    ColumnChunkReader (const Table& table, const String& columnName,
+                       rownr_t chunkSize, Bool prefetch = False);
+
+    // The destructor waits for an outstanding prefetch.
+    ~ColumnChunkReader();
+
+    ColumnChunkReader (const ColumnChunkReader<T>&) = delete;
+    ColumnChunkReader<T>& operator= (const ColumnChunkReader<T>&) = delete;
+
+    // Read the next chunk into the buffer.
+    // It returns False (leaving the buffer untouched) if all rows have
+    // been read.
+    Bool next (Array<T>& buffer);
+
+    // Start reading at the first row again.
+    void reset();
+
+    // Get the row number (in the table) of the first row of the chunk
+    // read by the last call to <src>next</src>.
+    rownr_t firstRow() const
+      { return itsFirstRow; }
+
+    // Get the number of rows in the chunk read by the last call to
+    // <src>next</src>.
+    rownr_t nrowChunk() const
+      { return itsNrowChunk; }
+
+    // Get the chunk size.
+    rownr_t chunkSize() const
+      { return itsChunkSize; }
+
+private:
+    // Read the rows of the chunk starting at the given row into the buffer.
+    void readChunk (rownr_t startRow, Array<T>& buffer);
+
+    // Start the background read of the chunk starting at the given row.
+    void startPrefetch (rownr_t startRow);
+
+    // Wait for the outstanding background read (if any).
+    void waitPrefetch();
+
+    //# Data members.
+    Table           itsTable;
+    Bool            itsIsScalar;
+    ScalarColumn<T> itsScaCol;
+    ArrayColumn<T>  itsArrCol;
+    rownr_t         itsChunkSize;
+    Bool            itsPrefetch;
+    rownr_t         itsNextRow;
+    rownr_t         itsFirstRow;
+    rownr_t         itsNrowChunk;
+    Array<T>        itsPrefetchBuffer;
+    rownr_t         itsPrefetchRow;
+    std::future<void> itsFuture;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <casacore/tables/Tables/ColumnChunkReader.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+#endif
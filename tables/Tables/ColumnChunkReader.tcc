@@ -0,0 +1,154 @@
+//# ColumnChunkReader.tcc: Read a table column in chunks of rows
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_COLUMNCHUNKREADER_TCC
+#define TABLES_COLUMNCHUNKREADER_TCC
+
+#include <casacore/tables/Tables/ColumnChunkReader.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+template<class T>
+ColumnChunkReader<T>::ColumnChunkReader (const Table& table,
+                                         const String& columnName,
+                                         rownr_t chunkSize, Bool prefetch)
+: itsTable       (table),
+  itsIsScalar    (True),
+  itsChunkSize   (chunkSize),
+  itsPrefetch    (prefetch),
+  itsNextRow     (0),
+  itsFirstRow    (0),
+  itsNrowChunk   (0),
+  itsPrefetchRow (0)
+{
+  if (chunkSize == 0) {
+    throw TableError ("ColumnChunkReader: chunk size of column " +
+                      columnName + " must be > 0");
+  }
+  itsIsScalar = TableColumn(table, columnName).columnDesc().isScalar();
+  if (itsIsScalar) {
+    itsScaCol.attach (table, columnName);
+  } else {
+    itsArrCol.attach (table, columnName);
+  }
+}
+
+template<class T>
+ColumnChunkReader<T>::~ColumnChunkReader()
+{
+  // Do not throw in a destructor; an exception in the prefetch is lost.
+  if (itsFuture.valid()) {
+    itsFuture.wait();
+  }
+}
+
+template<class T>
+Bool ColumnChunkReader<T>::next (Array<T>& buffer)
+{
+  rownr_t nrow = itsTable.nrow();
+  if (itsNextRow >= nrow) {
+    return False;
+  }
+  if (itsPrefetch) {
+    // Read the first chunk in the background as well, so the other
+    // chunks are always handled the same way.
+    if (! itsFuture.valid()) {
+      startPrefetch (itsNextRow);
+    }
+    waitPrefetch();
+    swap (buffer, itsPrefetchBuffer);
+  } else {
+    readChunk (itsNextRow, buffer);
+  }
+  itsFirstRow  = itsNextRow;
+  itsNrowChunk = std::min (itsChunkSize, nrow - itsNextRow);
+  itsNextRow  += itsNrowChunk;
+  if (itsPrefetch  &&  itsNextRow < nrow) {
+    startPrefetch (itsNextRow);
+  }
+  return True;
+}
+
+template<class T>
+void ColumnChunkReader<T>::reset()
+{
+  if (itsFuture.valid()) {
+    itsFuture.wait();
+    itsFuture = std::future<void>();
+  }
+  itsNextRow   = 0;
+  itsFirstRow  = 0;
+  itsNrowChunk = 0;
+}
+
+template<class T>
+void ColumnChunkReader<T>::readChunk (rownr_t startRow, Array<T>& buffer)
+{
+  rownr_t nrow = std::min (itsChunkSize, itsTable.nrow() - startRow);
+  RefRows rows(startRow, startRow + nrow - 1);
+  if (itsIsScalar) {
+    IPosition shape(1, nrow);
+    if (! buffer.shape().isEqual (shape)) {
+      buffer.resize (shape);
+    }
+    Vector<T> vec(buffer);
+    itsScaCol.getColumnCells (rows, vec);
+  } else {
+    IPosition shape = itsArrCol.shape(startRow);
+    shape.append (IPosition(1, nrow));
+    if (! buffer.shape().isEqual (shape)) {
+      buffer.resize (shape);
+    }
+    itsArrCol.getColumnCells (rows, buffer);
+  }
+}
+
+template<class T>
+void ColumnChunkReader<T>::startPrefetch (rownr_t startRow)
+{
+  itsPrefetchRow = startRow;
+  itsFuture = std::async (std::launch::async,
+                          [this]() { readChunk (itsPrefetchRow,
+                                                itsPrefetchBuffer); });
+}
+
+template<class T>
+void ColumnChunkReader<T>::waitPrefetch()
+{
+  if (itsFuture.valid()) {
+    // get() rethrows an exception thrown in the background read.
+    itsFuture.get();
+  }
+}
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,690 @@
+//# ColumnIndexFile.cc: Persistent index on a scalar column of a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/ColumnIndexFile.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableLocker.h>
+#include <casacore/tables/Tables/BaseTable.h>
+#include <casacore/tables/Tables/PlainColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The file starts with a header of 8 Int64 values (in canonical format):
+//# magic, version, data type, valid flag, #rows indexed, #runs, block size,
+//# and a spare one. Thereafter the runs follow. Each run consists of
+//# #entries and #blocks, the fences (first key of each block and the last
+//# key), the sorted keys, and their row numbers.
+static const Int64 theMagic      = 0x43494458;    //# "CIDX"
+static const Int64 theVersion    = 1;
+static const Int64 theHeaderSize = 8*8;
+static const Int64 theValidOffset = 3*8;
+//# The maximum number of runs before the index is recreated.
+static const uInt theMaxRuns     = 8;
+//# The number of rows read at a time when scanning the column.
+static const rownr_t theChunkSize = 65536;
+
+
+//# Read the given part of a column as keys.
+template<typename T, typename K>
+static void getKeys (const Table& table, const String& columnName,
+                     rownr_t start, rownr_t nrow, std::vector<K>& keys)
+{
+    ScalarColumn<T> column(table, columnName);
+    Vector<T> vec = column.getColumnRange (Slicer(IPosition(1, start),
+                                                  IPosition(1, nrow)));
+    keys.resize (nrow);
+    std::copy (vec.begin(), vec.end(), keys.begin());
+}
+
+static void readKeys (const Table& table, const String& columnName,
+                      Int dataType, rownr_t start, rownr_t nrow,
+                      std::vector<Int64>& keys)
+{
+    switch (dataType) {
+    case TpUChar:
+        getKeys<uChar> (table, columnName, start, nrow, keys);
+        break;
+    case TpShort:
+        getKeys<Short> (table, columnName, start, nrow, keys);
+        break;
+    case TpUShort:
+        getKeys<uShort> (table, columnName, start, nrow, keys);
+        break;
+    case TpInt:
+        getKeys<Int> (table, columnName, start, nrow, keys);
+        break;
+    case TpUInt:
+        getKeys<uInt> (table, columnName, start, nrow, keys);
+        break;
+    case TpInt64:
+        getKeys<Int64> (table, columnName, start, nrow, keys);
+        break;
+    default:
+        throw TableError ("ColumnIndexFile: column " + columnName +
+                          " has no integer data type");
+    }
+}
+
+static void readKeys (const Table& table, const String& columnName,
+                      Int dataType, rownr_t start, rownr_t nrow,
+                      std::vector<Double>& keys)
+{
+    switch (dataType) {
+    case TpFloat:
+        getKeys<Float> (table, columnName, start, nrow, keys);
+        break;
+    case TpDouble:
+        getKeys<Double> (table, columnName, start, nrow, keys);
+        break;
+    default:
+        throw TableError ("ColumnIndexFile: column " + columnName +
+                          " has no real data type");
+    }
+}
+
+//# Tell if the data type has real keys; throw if not supported.
+static Bool hasRealKeys (Int dataType, const String& columnName)
+{
+    switch (dataType) {
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+        return False;
+    case TpFloat:
+    case TpDouble:
+        return True;
+    default:
+        break;
+    }
+    throw TableInvOper ("ColumnIndexFile: column " + columnName +
+                        " does not have an integer or real data type");
+}
+
+//# Write a number of values in canonical format.
+static void writeValues (ByteIO& file, Int64 n, const Int64* values)
+{
+    std::vector<char> buf(8*n);
+    CanonicalConversion::fromLocal (buf.data(), values, n);
+    file.write (buf.size(), buf.data());
+}
+static void writeValues (ByteIO& file, Int64 n, const Double* values)
+{
+    std::vector<char> buf(8*n);
+    CanonicalConversion::fromLocal (buf.data(), values, n);
+    file.write (buf.size(), buf.data());
+}
+
+//# Sort the keys (and row numbers) and write them as a run at the end.
+//# NaN keys are left out; they cannot be sorted and never match a range.
+template<typename K>
+static void writeRun (ByteIO& file, Int64 offset, const std::vector<K>& keys,
+                      rownr_t firstRow, Int64 blockSize)
+{
+    std::vector<std::pair<K,Int64>> entries;
+    entries.reserve (keys.size());
+    for (size_t i=0; i<keys.size(); ++i) {
+        if (! std::isnan (keys[i])) {
+            entries.push_back (std::make_pair (keys[i], Int64(firstRow + i)));
+        }
+    }
+    Int64 n = entries.size();
+    std::sort (entries.begin(), entries.end());
+    Int64 nrBlocks = (n + blockSize - 1) / blockSize;
+    Int64 head[2] = {n, nrBlocks};
+    file.seek (offset);
+    writeValues (file, 2, head);
+    //# Write the fences, thereafter the keys and row numbers.
+    std::vector<K> fences;
+    fences.reserve (nrBlocks + 1);
+    for (Int64 i=0; i<n; i+=blockSize) {
+        fences.push_back (entries[i].first);
+    }
+    fences.push_back (n == 0  ?  K() : entries[n-1].first);
+    writeValues (file, fences.size(), fences.data());
+    std::vector<K> kbuf;
+    std::vector<Int64> rbuf;
+    for (Int pass=0; pass<2; ++pass) {
+        for (Int64 st=0; st<n; st+=blockSize) {
+            Int64 nr = std::min (blockSize, n-st);
+            if (pass == 0) {
+                kbuf.resize (nr);
+                for (Int64 i=0; i<nr; ++i) kbuf[i] = entries[st+i].first;
+                writeValues (file, nr, kbuf.data());
+            } else {
+                rbuf.resize (nr);
+                for (Int64 i=0; i<nr; ++i) rbuf[i] = entries[st+i].second;
+                writeValues (file, nr, rbuf.data());
+            }
+        }
+    }
+}
+
+//# Write (or rewrite) the header.
+static void writeHeader (ByteIO& file, Int dataType, Bool valid,
+                         rownr_t nrow, uInt nrRuns, uInt blockSize)
+{
+    Int64 head[8] = {theMagic, theVersion, dataType, valid, Int64(nrow),
+                     nrRuns, blockSize, 0};
+    file.seek (0);
+    writeValues (file, 8, head);
+}
+
+//# Convert the double bounds to integer keys.
+static void toKeys (const std::vector<Double>& lower,
+                    const std::vector<Double>& upper,
+                    std::vector<Int64>& klow, std::vector<Int64>& kupp)
+{
+    const Double maxVal = Double(std::numeric_limits<Int64>::max());
+    for (size_t i=0; i<lower.size(); ++i) {
+        Double lo = std::ceil (lower[i]);
+        Double hi = std::floor (upper[i]);
+        if (lo <= hi  &&  lo < maxVal  &&  hi >= -maxVal) {
+            klow.push_back (lo <= -maxVal  ?
+                            std::numeric_limits<Int64>::min() : Int64(lo));
+            kupp.push_back (hi >= maxVal  ?
+                            std::numeric_limits<Int64>::max() : Int64(hi));
+        }
+    }
+}
+
+//# Convert the integer bounds to the key type (removing empty ranges).
+static void toKeys (const std::vector<Int64>& lower,
+                    const std::vector<Int64>& upper,
+                    std::vector<Int64>& klow, std::vector<Int64>& kupp)
+{
+    for (size_t i=0; i<lower.size(); ++i) {
+        if (lower[i] <= upper[i]) {
+            klow.push_back (lower[i]);
+            kupp.push_back (upper[i]);
+        }
+    }
+}
+static void toKeys (const std::vector<Int64>& lower,
+                    const std::vector<Int64>& upper,
+                    std::vector<Double>& klow, std::vector<Double>& kupp)
+{
+    //# A Double cannot hold all Int64 values, so the bounds are rounded
+    //# inwards to the nearest Double inside the range.
+    //# Double(2^63) is the only rounded value outside the Int64 range.
+    const Double maxVal = Double(std::numeric_limits<Int64>::max());
+    const Double inf = std::numeric_limits<Double>::infinity();
+    for (size_t i=0; i<lower.size(); ++i) {
+        Double lo = Double(lower[i]);
+        if (lo < maxVal  &&  Int64(lo) < lower[i]) {
+            lo = std::nextafter (lo, inf);
+        }
+        Double hi = Double(upper[i]);
+        if (hi >= maxVal  ||  Int64(hi) > upper[i]) {
+            hi = std::nextafter (hi, -inf);
+        }
+        if (lower[i] <= upper[i]  &&  lo <= hi) {
+            klow.push_back (lo);
+            kupp.push_back (hi);
+        }
+    }
+}
+
+
+String ColumnIndexFile::fileName (const String& tableName,
+                                  const String& columnName)
+{
+    return tableName + "/table.idx_" + columnName;
+}
+
+void ColumnIndexFile::create (const Table& table, const String& columnName,
+                              uInt blockSize)
+{
+    if (table.tableType() != Table::Plain  ||  !table.isRootTable()) {
+        throw TableInvOper ("ColumnIndexFile: an index can only be created "
+                            "on a persistent root table");
+    }
+    const TableDesc& tdesc = table.tableDesc();
+    if (! tdesc.isColumn (columnName)) {
+        throw TableInvOper ("ColumnIndexFile: column " + columnName +
+                            " does not exist in table " + table.tableName());
+    }
+    const ColumnDesc& cdesc = tdesc[columnName];
+    if (! cdesc.isScalar()  ||  ! table.isColumnStored (columnName)) {
+        throw TableInvOper ("ColumnIndexFile: column " + columnName +
+                            " is not a stored scalar column");
+    }
+    Int dtype = cdesc.dataType();
+    Bool realKeys = hasRealKeys (dtype, columnName);
+    blockSize = std::max (blockSize, 2u);
+    //# Write into a temporary file, which is renamed at the end.
+    String name = fileName (table.tableName(), columnName);
+    String tmpName = name + "_tmp";
+    rownr_t nrow;
+    {
+        Table tab(table);
+        TableLocker locker(tab, FileLocker::Read);
+        nrow = table.nrow();
+        RegularFileIO file(RegularFile(tmpName), ByteIO::New);
+        writeHeader (file, dtype, False, nrow, 1, blockSize);
+        if (realKeys) {
+            std::vector<Double> keys;
+            readKeys (table, columnName, dtype, 0, nrow, keys);
+            writeRun (file, theHeaderSize, keys, 0, blockSize);
+        } else {
+            std::vector<Int64> keys;
+            readKeys (table, columnName, dtype, 0, nrow, keys);
+            writeRun (file, theHeaderSize, keys, 0, blockSize);
+        }
+        writeHeader (file, dtype, True, nrow, 1, blockSize);
+    }
+    RegularFile(tmpName).move (name);
+    indexChanged (table, columnName);
+}
+
+Bool ColumnIndexFile::exists (const Table& table, const String& columnName)
+{
+    return File(fileName (table.tableName(), columnName)).exists();
+}
+
+void ColumnIndexFile::remove (const Table& table, const String& columnName)
+{
+    removeFile (table.tableName(), columnName);
+    indexChanged (table, columnName);
+}
+
+void ColumnIndexFile::removeFile (const String& tableName,
+                                  const String& columnName)
+{
+    String name = fileName (tableName, columnName);
+    if (File(name).exists()) {
+        RegularFile(name).remove();
+    }
+}
+
+void ColumnIndexFile::rename (const String& tableName,
+                              const String& newName, const String& oldName)
+{
+    String name = fileName (tableName, oldName);
+    if (File(name).exists()) {
+        RegularFile(name).move (fileName (tableName, newName));
+    }
+}
+
+rownr_t ColumnIndexFile::indexedRows (const String& tableName,
+                                      const String& columnName)
+{
+    String name = fileName (tableName, columnName);
+    if (! File(name).exists()) {
+        return 0;
+    }
+    RegularFileIO file(RegularFile(name), ByteIO::Old);
+    char buf[theHeaderSize];
+    Int64 head[8];
+    if (file.read (theHeaderSize, buf, False) != theHeaderSize) {
+        return 0;
+    }
+    CanonicalConversion::toLocal (head, buf, 8);
+    if (head[0] != theMagic  ||  head[3] == 0) {
+        return 0;
+    }
+    return head[4];
+}
+
+void ColumnIndexFile::markStale (const String& tableName,
+                                 const String& columnName)
+{
+    String name = fileName (tableName, columnName);
+    if (File(name).exists()) {
+        RegularFileIO file(RegularFile(name), ByteIO::Update);
+        Int64 valid = 0;
+        char buf[8];
+        CanonicalConversion::fromLocal (buf, &valid, 1);
+        file.pwrite (8, theValidOffset, buf);
+    }
+}
+
+void ColumnIndexFile::indexChanged (const Table& table,
+                                    const String& columnName)
+{
+    PlainColumn* col = dynamic_cast<PlainColumn*>
+        (table.baseTablePtr()->getColumn (columnName));
+    if (col) {
+        col->resetIndexState();
+    }
+}
+
+
+ColumnIndexFile::ColumnIndexFile (const Table& table,
+                                  const String& columnName)
+: itsTable       (table),
+  itsColumnName  (columnName),
+  itsDataType    (TpOther),
+  itsRealKeys    (False),
+  itsValid       (False),
+  itsNrow        (0),
+  itsBlockSize   (0),
+  itsFileEnd     (0),
+  itsNrBytesRead (0)
+{
+    if (! exists (table, columnName)) {
+        throw TableError ("ColumnIndexFile: no index exists for column " +
+                          columnName + " in table " + table.tableName());
+    }
+    readHeader();
+}
+
+ColumnIndexFile::~ColumnIndexFile()
+{}
+
+void ColumnIndexFile::readHeader()
+{
+    //# Reopen the file to be sure no stale buffered data are used.
+    itsFile.reset();
+    itsFile.reset (new RegularFileIO
+                   (RegularFile(fileName (itsTable.tableName(),
+                                          itsColumnName)),
+                    ByteIO::Old, 4096));
+    Int64 head[8];
+    readValues (0, 8, head);
+    if (head[0] != theMagic  ||  head[1] > theVersion) {
+        throw TableError ("ColumnIndexFile: index file of column " +
+                          itsColumnName + " in table " +
+                          itsTable.tableName() + " has an unknown format");
+    }
+    itsDataType  = head[2];
+    itsRealKeys  = (itsDataType == TpFloat  ||  itsDataType == TpDouble);
+    itsValid     = (head[3] != 0);
+    itsNrow      = head[4];
+    itsBlockSize = head[6];
+    //# An index with more rows than the table cannot be valid.
+    if (itsNrow > itsTable.nrow()) {
+        itsValid = False;
+    }
+    itsRuns.resize (head[5]);
+    Int64 offset = theHeaderSize;
+    for (Run& run : itsRuns) {
+        Int64 rhead[2];
+        readValues (offset, 2, rhead);
+        run.offset    = offset + 2*8;
+        run.nrEntries = rhead[0];
+        run.nrBlocks  = rhead[1];
+        offset = run.offset + 8*(run.nrBlocks + 1) + 2*8*run.nrEntries;
+    }
+    itsFileEnd = offset;
+}
+
+void ColumnIndexFile::readValues (Int64 offset, Int64 n, Int64* values)
+{
+    std::vector<char> buf(8*n);
+    itsFile->pread (buf.size(), offset, buf.data());
+    CanonicalConversion::toLocal (values, buf.data(), n);
+    itsNrBytesRead += buf.size();
+}
+
+void ColumnIndexFile::readValues (Int64 offset, Int64 n, Double* values)
+{
+    std::vector<char> buf(8*n);
+    itsFile->pread (buf.size(), offset, buf.data());
+    CanonicalConversion::toLocal (values, buf.data(), n);
+    itsNrBytesRead += buf.size();
+}
+
+Bool ColumnIndexFile::isValid()
+{
+    readHeader();
+    return itsValid;
+}
+
+rownr_t ColumnIndexFile::nrowIndexed()
+{
+    readHeader();
+    return itsNrow;
+}
+
+uInt ColumnIndexFile::nrRuns()
+{
+    readHeader();
+    return itsRuns.size();
+}
+
+void ColumnIndexFile::update()
+{
+    readHeader();
+    if (! itsValid) {
+        throw TableError ("ColumnIndexFile: index of column " +
+                          itsColumnName + " in table " +
+                          itsTable.tableName() + " is stale");
+    }
+    TableLocker locker(itsTable, FileLocker::Read);
+    rownr_t nrow = itsTable.nrow();
+    if (nrow == itsNrow) {
+        return;
+    }
+    if (itsRuns.size() >= theMaxRuns) {
+        //# Too many runs; recreate the index as a single run.
+        itsFile.reset();
+        create (itsTable, itsColumnName, itsBlockSize);
+    } else {
+        itsFile.reset();
+        RegularFileIO file(RegularFile(fileName (itsTable.tableName(),
+                                                 itsColumnName)),
+                           ByteIO::Update);
+        if (itsRealKeys) {
+            std::vector<Double> keys;
+            readKeys (itsTable, itsColumnName, itsDataType, itsNrow,
+                      nrow - itsNrow, keys);
+            writeRun (file, itsFileEnd, keys, itsNrow, itsBlockSize);
+        } else {
+            std::vector<Int64> keys;
+            readKeys (itsTable, itsColumnName, itsDataType, itsNrow,
+                      nrow - itsNrow, keys);
+            writeRun (file, itsFileEnd, keys, itsNrow, itsBlockSize);
+        }
+        //# Only now the new run becomes part of the index.
+        writeHeader (file, itsDataType, True, nrow, itsRuns.size() + 1,
+                     itsBlockSize);
+        indexChanged (itsTable, itsColumnName);
+    }
+    readHeader();
+}
+
+RowNumbers ColumnIndexFile::getRowNumbers (Double key)
+{
+    return getRowNumbers (Vector<Double>(1, key), Vector<Double>(1, key));
+}
+
+RowNumbers ColumnIndexFile::getRowNumbers (Double lower, Double upper,
+                                           Bool lowerInclusive,
+                                           Bool upperInclusive)
+{
+    //# Make the bounds inclusive.
+    if (! lowerInclusive) {
+        lower = std::nextafter (lower, std::numeric_limits<Double>::max());
+    }
+    if (! upperInclusive) {
+        upper = std::nextafter (upper, -std::numeric_limits<Double>::max());
+    }
+    return getRowNumbers (Vector<Double>(1, lower), Vector<Double>(1, upper));
+}
+
+RowNumbers ColumnIndexFile::getRowNumbers (const Vector<Double>& keys)
+{
+    return getRowNumbers (keys, keys);
+}
+
+RowNumbers ColumnIndexFile::getRowNumbers (const Vector<Double>& lower,
+                                           const Vector<Double>& upper)
+{
+    AlwaysAssert (lower.size() == upper.size(), AipsError);
+    std::vector<Double> low(lower.begin(), lower.end());
+    std::vector<Double> upp(upper.begin(), upper.end());
+    readHeader();
+    if (itsRealKeys) {
+        return find (low, upp);
+    }
+    std::vector<Int64> klow, kupp;
+    toKeys (low, upp, klow, kupp);
+    return find (klow, kupp);
+}
+
+RowNumbers ColumnIndexFile::getRowNumbers (const Vector<Int64>& keys)
+{
+    return getRowNumbers (keys, keys);
+}
+
+RowNumbers ColumnIndexFile::getRowNumbers (const Vector<Int64>& lower,
+                                           const Vector<Int64>& upper)
+{
+    AlwaysAssert (lower.size() == upper.size(), AipsError);
+    std::vector<Int64> low(lower.begin(), lower.end());
+    std::vector<Int64> upp(upper.begin(), upper.end());
+    readHeader();
+    if (itsRealKeys) {
+        std::vector<Double> klow, kupp;
+        toKeys (low, upp, klow, kupp);
+        return find (klow, kupp);
+    }
+    std::vector<Int64> klow, kupp;
+    toKeys (low, upp, klow, kupp);
+    return find (klow, kupp);
+}
+
+template<typename T>
+RowNumbers ColumnIndexFile::find (const std::vector<T>& lower,
+                                  const std::vector<T>& upper)
+{
+    if (! itsValid) {
+        throw TableError ("ColumnIndexFile: index of column " +
+                          itsColumnName + " in table " +
+                          itsTable.tableName() + " is stale");
+    }
+    std::vector<rownr_t> rows;
+    if (! lower.empty()) {
+        for (const Run& run : itsRuns) {
+            findInRun (run, lower, upper, rows);
+        }
+        findInTail (lower, upper, rows);
+    }
+    //# Ranges can overlap, so remove duplicates.
+    std::sort (rows.begin(), rows.end());
+    rows.erase (std::unique (rows.begin(), rows.end()), rows.end());
+    return RowNumbers(rows);
+}
+
+template<typename T>
+void ColumnIndexFile::findInRun (const Run& run, const std::vector<T>& lower,
+                                 const std::vector<T>& upper,
+                                 std::vector<rownr_t>& rows)
+{
+    const Int64 n  = run.nrEntries;
+    const Int64 nb = run.nrBlocks;
+    if (n == 0) {
+        return;
+    }
+    const Int64 bs = itsBlockSize;
+    const Int64 keysOffset = run.offset + 8*(nb+1);
+    const Int64 rowsOffset = keysOffset + 8*n;
+    T first, last;
+    readValues (run.offset, 1, &first);
+    readValues (run.offset + 8*nb, 1, &last);
+    std::vector<T> keys;
+    std::vector<Int64> rownrs;
+    for (size_t r=0; r<lower.size(); ++r) {
+        const T lo = lower[r];
+        const T hi = upper[r];
+        if (hi < first  ||  lo > last) {
+            continue;
+        }
+        //# Binary search in the fences for the number of blocks starting
+        //# before lo. The last of them can still contain lo (as can
+        //# the next one).
+        Int64 b0 = 0;
+        Int64 b1 = nb;
+        while (b0 < b1) {
+            Int64 mid = (b0 + b1) / 2;
+            T fence;
+            readValues (run.offset + 8*mid, 1, &fence);
+            if (fence < lo) {
+                b0 = mid + 1;
+            } else {
+                b1 = mid;
+            }
+        }
+        for (Int64 blk = std::max(b0-1, Int64(0)); blk < nb; ++blk) {
+            Int64 st = blk*bs;
+            Int64 nr = std::min (bs, n-st);
+            keys.resize (nr);
+            readValues (keysOffset + 8*st, nr, keys.data());
+            if (keys[0] > hi) {
+                break;
+            }
+            auto b = std::lower_bound (keys.begin(), keys.end(), lo);
+            auto e = std::upper_bound (b, keys.end(), hi);
+            if (b != e) {
+                rownrs.resize (e-b);
+                readValues (rowsOffset + 8*(st + (b-keys.begin())),
+                            e-b, rownrs.data());
+                rows.insert (rows.end(), rownrs.begin(), rownrs.end());
+            }
+            if (e != keys.end()) {
+                break;
+            }
+        }
+    }
+}
+
+template<typename T>
+void ColumnIndexFile::findInTail (const std::vector<T>& lower,
+                                  const std::vector<T>& upper,
+                                  std::vector<rownr_t>& rows)
+{
+    TableLocker locker(itsTable, FileLocker::Read);
+    rownr_t nrow = itsTable.nrow();
+    std::vector<T> keys;
+    for (rownr_t st=itsNrow; st<nrow; st+=theChunkSize) {
+        rownr_t nr = std::min (theChunkSize, nrow-st);
+        readKeys (itsTable, itsColumnName, itsDataType, st, nr, keys);
+        for (rownr_t i=0; i<nr; ++i) {
+            for (size_t r=0; r<lower.size(); ++r) {
+                if (keys[i] >= lower[r]  &&  keys[i] <= upper[r]) {
+                    rows.push_back (st+i);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,257 @@
+//# ColumnIndexFile.h: Persistent index on a scalar column of a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_COLUMNINDEXFILE_H
+#define TABLES_COLUMNINDEXFILE_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/RowNumbers.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <memory>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class ByteIO;
+
+
+// <summary>
+// Persistent index on a scalar column of a table.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tColumnIndexFile.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=Table>Table</linkto>
+//   <li> <linkto class=ColumnsIndex>ColumnsIndex</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Contrary to <linkto class=ColumnsIndex>ColumnsIndex</linkto>, which reads
+// and sorts the key columns in memory each time it is created, this class
+// stores an index on a scalar column in a file in the table directory
+// (named <src>table.idx_COLUMN</src>). Looking up a key or key range
+// only reads the small parts of the file needed, so it is cheap even for
+// tables with hundreds of millions of rows.
+// <p>
+// The index is only possible for stored scalar columns with an integer
+// or real data type. It consists of one or more sorted runs of keys and
+// row numbers. The keys of a run are divided in blocks; the first key of
+// each block (the fence pointers) is used to do a binary search for the
+// blocks containing the keys to look up. Rows with a NaN key are not
+// stored in the index, because NaN never matches a key or key range.
+// <p>
+// Rows added to the table after the index was created (or updated) are
+// not part of the index, but are scanned by each lookup. Function
+// <src>update</src> adds those rows to the index as a new sorted run.
+// When too many runs exist, the index is recreated as a single run.
+// <br>Changing the value of an indexed row or removing a row from the
+// table marks the index as stale. A stale index is not used anymore
+// and has to be recreated. Renaming or removing the column renames or
+// removes its index file.
+// <p>
+// TaQL uses the index automatically for equality, range and IN
+// comparisons of an indexed column with constants in the WHERE clause
+// if the query is done on the table itself (not on a reference table).
+// The full WHERE expression is evaluated for the rows found in the index.
+// <p>
+// A process that opened the table before the index was created (or
+// updated or removed by another process) notices it after its next resync,
+// thus when it acquires a lock on the table.
+// </synopsis>
+
+// <example>
+// <srcblock>
+// // Create the index once.
+// Table tab("my.ms", Table::Update);
+// ColumnIndexFile::create (tab, "ANTENNA1");
+// // Thereafter it can be used by TaQL or directly.
+// ColumnIndexFile index(tab, "ANTENNA1");
+// RowNumbers rows = index.getRowNumbers (3);
+// // Add new rows to the index.
+// tab.addRow (100);
+// ...
+// index.update();
+// </srcblock>
+// </example>
+
+// <motivation>
+// Selecting a few rows on a key column in a large table should not require
+// reading the entire column.
+// </motivation>
+
+
+class ColumnIndexFile
+{
+public:
+    // Create (or recreate) the index for the given column.
+    // <src>blockSize</src> gives the number of keys per block.
+    // An exception is thrown if the column cannot be indexed.
+    static void create (const Table& table, const String& columnName,
+                        uInt blockSize = 1024);
+
+    // Does a (possibly stale) index exist for the given column?
+    static Bool exists (const Table& table, const String& columnName);
+
+    // Remove the index of the given column (if it exists).
+    static void remove (const Table& table, const String& columnName);
+
+    // Open the index of the given column.
+    // An exception is thrown if it does not exist.
+    ColumnIndexFile (const Table& table, const String& columnName);
+
+    ~ColumnIndexFile();
+
+    ColumnIndexFile (const ColumnIndexFile&) = delete;
+    ColumnIndexFile& operator= (const ColumnIndexFile&) = delete;
+
+    // Is the index still valid (i.e., not stale)?
+    Bool isValid();
+
+    // Get the number of rows in the index. Rows after it are scanned
+    // by the lookup functions.
+    rownr_t nrowIndexed();
+
+    // Get the number of sorted runs in the index.
+    uInt nrRuns();
+
+    // Add the rows added to the table since the index was created or
+    // updated as a new run.
+    void update();
+
+    // Find the row numbers matching the key.
+    RowNumbers getRowNumbers (Double key);
+
+    // Find the row numbers matching the key range.
+    RowNumbers getRowNumbers (Double lower, Double upper,
+                              Bool lowerInclusive, Bool upperInclusive);
+
+    // Find the row numbers matching one of the keys.
+    RowNumbers getRowNumbers (const Vector<Double>& keys);
+
+    // Find the row numbers in the given ranges (inclusive).
+    // The row numbers are returned in ascending order.
+    // An exception is thrown if the index is stale.
+    RowNumbers getRowNumbers (const Vector<Double>& lower,
+                              const Vector<Double>& upper);
+
+    // Find the row numbers matching one of the integer keys or in the
+    // given integer ranges (inclusive). For an integer column the keys
+    // are compared as integers, thus exactly, also for Int64 values
+    // beyond 2^53 which cannot be represented by a Double.
+    // <group>
+    RowNumbers getRowNumbers (const Vector<Int64>& keys);
+    RowNumbers getRowNumbers (const Vector<Int64>& lower,
+                              const Vector<Int64>& upper);
+    // </group>
+
+    // Get the number of bytes read from the index file since opened.
+    uInt64 nrBytesRead() const
+      { return itsNrBytesRead; }
+
+    // Get the name of the index file of a column.
+    static String fileName (const String& tableName,
+                            const String& columnName);
+
+    // The following functions are used by the table system.
+    // <group>
+    // Get the number of rows in the index of the column of a table
+    // (0 if there is no valid index).
+    static rownr_t indexedRows (const String& tableName,
+                                const String& columnName);
+    // Mark the index of the column of a table as stale.
+    static void markStale (const String& tableName,
+                           const String& columnName);
+    // Rename the index file of a column.
+    static void rename (const String& tableName,
+                        const String& newName, const String& oldName);
+    // Remove the index file of a column.
+    static void removeFile (const String& tableName,
+                            const String& columnName);
+    // </group>
+
+private:
+    // The description of a sorted run in the file.
+    struct Run {
+        Int64 offset;           //# offset of the fences in the file
+        Int64 nrEntries;
+        Int64 nrBlocks;
+    };
+
+    // Read the header and the run descriptions.
+    void readHeader();
+
+    // Read a number of 8-byte values at the given offset.
+    // <group>
+    void readValues (Int64 offset, Int64 n, Int64* values);
+    void readValues (Int64 offset, Int64 n, Double* values);
+    // </group>
+
+    // Find the rows in the given ranges in a run.
+    template<typename T>
+    void findInRun (const Run& run, const std::vector<T>& lower,
+                    const std::vector<T>& upper,
+                    std::vector<rownr_t>& rows);
+
+    // Find the rows in the given ranges in the rows not indexed.
+    template<typename T>
+    void findInTail (const std::vector<T>& lower,
+                     const std::vector<T>& upper,
+                     std::vector<rownr_t>& rows);
+
+    // Find the rows in the given ranges of the key type T.
+    // The row numbers are returned in ascending order.
+    template<typename T>
+    RowNumbers find (const std::vector<T>& lower,
+                     const std::vector<T>& upper);
+
+    // Tell the table column that the index changed.
+    static void indexChanged (const Table& table, const String& columnName);
+
+    Table               itsTable;
+    String              itsColumnName;
+    std::unique_ptr<ByteIO> itsFile;
+    Int                 itsDataType;
+    Bool                itsRealKeys;
+    Bool                itsValid;
+    rownr_t             itsNrow;
+    uInt                itsBlockSize;
+    std::vector<Run>    itsRuns;
+    Int64               itsFileEnd;     //# end of the last run in the file
+    uInt64              itsNrBytesRead;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
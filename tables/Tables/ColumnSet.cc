@@ -26,11 +26,13 @@
 #include <casacore/tables/Tables/ColumnSet.h>
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/tables/Tables/PlainColumn.h>
+#include <casacore/tables/Tables/ColumnIndexFile.h>
 #include <casacore/tables/Tables/TableAttr.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/TableMetrics.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/IO/MultiFile.h>
@@ -196,6 +198,10 @@ void ColumnSet::openMultiFile (uInt from, const Table& tab,
 
 rownr_t ColumnSet::resync (rownr_t nrrow, Bool forceSync)
 {
+    //# Another process may have changed a persistent column index.
+    for (auto& x : colMap_p) {
+	COLMAPCAST(x.second)->resetIndexState();
+    }
     //# There may be no sync data (when new table locked for first time).
     if (dataManChanged_p.nelements() > 0) {
 	AlwaysAssert (dataManChanged_p.nelements() ==
@@ -223,6 +229,37 @@ void ColumnSet::invalidateColumnCaches()
 }
 
 
+void ColumnSet::initMetrics (const String& tableName)
+{
+    if (TableMetrics::enabled()) {
+        for (auto& x : colMap_p) {
+	    COLMAPCAST(x.second)->initMetrics (tableName);
+	}
+    }
+}
+
+void ColumnSet::updateMetrics (const String& tableName, Bool closing) const
+{
+    if (! TableMetrics::enabled()) {
+        return;
+    }
+    for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
+        const DataManager* dmPtr = BLOCKDATAMANVAL(i);
+        BucketCacheStatistics stats;
+	dmPtr->addCacheStatistics (stats);
+	if (stats.naccess > 0  ||  stats.ninit > 0  ||  stats.nwrite > 0) {
+	    // Use the type and sequence number if the data manager is unnamed.
+	    String name = dmPtr->dataManagerName();
+	    if (name.empty()) {
+	        name = dmPtr->dataManagerType() + '_' +
+		       String::toString(dmPtr->sequenceNr());
+	    }
+	    TableMetrics::setCacheStatistics (tableName, name, stats, closing);
+	}
+    }
+}
+
+
 //# Do all data managers allow to add and remove rows and columns?
 Bool ColumnSet::canAddRow() const
 {
@@ -294,6 +331,11 @@ void ColumnSet::removeRow (rownr_t rownr)
 			     " too high in table " + baseTablePtr_p->tableName() +
 			     " (#rows=" + String::toString(nrrow_p) + ")"));
     }
+    // Removing a row shifts the rows after it, so a persistent index
+    // containing the row is not valid anymore.
+    for (const auto& x : colMap_p) {
+        COLMAPCAST(x.second)->checkIndex (rownr);
+    }
     for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
 	BLOCKDATAMANVAL(i)->removeRow64 (rownr);
     }
@@ -534,6 +576,7 @@ void ColumnSet::removeColumn (const Vector<String>& columnNames)
 	}
 	delete colPtr;
 	colMap_p.erase (name);
+	ColumnIndexFile::removeFile (baseTablePtr_p->tableName(), name);
     }
     autoReleaseLock();
 }
@@ -594,6 +637,7 @@ void ColumnSet::renameColumn (const String& newName, const String& oldName)
     void* ptr = colMap_p.at(oldName);
     colMap_p.erase (oldName);
     colMap_p.insert (std::make_pair(newName, ptr));
+    ColumnIndexFile::rename (baseTablePtr_p->tableName(), newName, oldName);
     autoReleaseLock();
 }
 
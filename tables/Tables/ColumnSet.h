@@ -215,6 +215,18 @@ public:
     int traceId() const
       { return baseTablePtr_p->traceId(); }
 
+    // Get the name of the table.
+    const String& tableName() const
+      { return baseTablePtr_p->tableName(); }
+
+    // Let the columns collect IO metrics if enabled
+    // (see <linkto class=TableMetrics>TableMetrics</linkto>).
+    void initMetrics (const String& tableName);
+
+    // Pass the cache statistics of the data managers to TableMetrics.
+    // <src>closing=True</src> means that the table is being closed.
+    void updateMetrics (const String& tableName, Bool closing) const;
+
     // Initialize rows startRownr till endRownr (inclusive).
     void initialize (rownr_t startRownr, rownr_t endRownr);
 
@@ -243,6 +255,8 @@ public:
     // <src>forceSync=True</src> means that the data managers are forced
     // to do a sync. Otherwise the contents of the lock file tell if a data
     // manager has to sync.
+    // <br>The persistent index state of the columns is reset, because
+    // another process may have created, updated or removed an index.
     rownr_t resync (rownr_t nrrow, Bool forceSync);
 
     // Invalidate the column caches for all columns.
@@ -31,14 +31,93 @@
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Containers/RecordField.h>
+#include <casacore/casa/Arrays/Slice.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Mix the bits of a hash value (the finalizer of splitmix64).
+static inline uInt64 hashMix (uInt64 h)
+{
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+//# Get the hash value of a key value.
+//# Values comparing equal (like -0 and 0) must give the same hash value.
+template<typename T> static inline uInt64 hashValue (T value)
+  { return uInt64(value); }
+static inline uInt64 hashValue (Double value)
+{
+  if (value == 0) {
+    value = 0;
+  }
+  uInt64 h;
+  memcpy (&h, &value, sizeof(h));
+  return h;
+}
+static inline uInt64 hashValue (Float value)
+  { return hashValue (Double(value)); }
+//# Complex values are compared by their norm, so hash the norm.
+static inline uInt64 hashValue (const DComplex& value)
+  { return hashValue (norm(value)); }
+static inline uInt64 hashValue (const Complex& value)
+  { return hashValue (Double(norm(value))); }
+static inline uInt64 hashValue (const String& value)
+  { return std::hash<std::string>() (value); }
+
+//# Combine the hashes of the rows with the values of the next key column.
+template<typename T>
+static void hashColumn (const void* data, rownr_t start, rownr_t end,
+                        uInt64* hashes)
+{
+  const T* values = static_cast<const T*>(data);
+  for (rownr_t i=start; i<end; ++i) {
+    hashes[i] = hashMix (hashes[i] ^ hashValue (values[i]));
+  }
+}
+
+//# Combine the hash with the value of the next field in the key.
+template<typename T>
+static inline uInt64 hashField (const void* fieldPtr, uInt64 hash)
+{
+  return hashMix (hash ^ hashValue
+                  (**static_cast<const RecordFieldPtr<T>*>(fieldPtr)));
+}
+
+//# Test if the key values in two rows are equal.
+template<typename T>
+static inline Bool equalValues (const void* data, rownr_t row1, rownr_t row2)
+{
+  const T* values = static_cast<const T*>(data);
+  return values[row1] == values[row2];
+}
+//# Like the sorted index, compare complex values by their norm.
+template<>
+inline Bool equalValues<Complex> (const void* data, rownr_t row1, rownr_t row2)
+{
+  const Complex* values = static_cast<const Complex*>(data);
+  return norm(values[row1]) == norm(values[row2]);
+}
+template<>
+inline Bool equalValues<DComplex> (const void* data, rownr_t row1, rownr_t row2)
+{
+  const DComplex* values = static_cast<const DComplex*>(data);
+  return norm(values[row1]) == norm(values[row2]);
+}
+
+
 ColumnsIndex::ColumnsIndex (const Table& table, const String& columnName,
 			    Compare* compareFunction, Bool noSort)
 : itsLowerKeyPtr (0),
@@ -52,10 +131,31 @@ ColumnsIndex::ColumnsIndex (const Table& table, const String& columnName,
 ColumnsIndex::ColumnsIndex (const Table& table,
 			    const Vector<String>& columnNames,
 			    Compare* compareFunction, Bool noSort)
+: itsLowerKeyPtr (0),
+  itsUpperKeyPtr (0)
 {
   create (table, columnNames, compareFunction, noSort);
 }
 
+ColumnsIndex::ColumnsIndex (const Table& table, const String& columnName,
+			    IndexType indexType)
+: itsLowerKeyPtr (0),
+  itsUpperKeyPtr (0)
+{
+  Vector<String> columnNames(1);
+  columnNames(0) = columnName;
+  create (table, columnNames, 0, False, indexType);
+}
+
+ColumnsIndex::ColumnsIndex (const Table& table,
+			    const Vector<String>& columnNames,
+			    IndexType indexType)
+: itsLowerKeyPtr (0),
+  itsUpperKeyPtr (0)
+{
+  create (table, columnNames, 0, False, indexType);
+}
+
 ColumnsIndex::ColumnsIndex (const ColumnsIndex& that)
 : itsLowerKeyPtr (0),
   itsUpperKeyPtr (0)
@@ -80,8 +180,10 @@ void ColumnsIndex::copy (const ColumnsIndex& that)
     deleteObjects();
     itsTable = that.itsTable;
     itsNrrow   = itsTable.nrow();
+    itsRemoveCounter = itsTable.getRowRemoveCounter();
     itsNoSort  = that.itsNoSort;
     itsCompare = that.itsCompare;
+    itsIndexType = that.itsIndexType;
     makeObjects (that.itsLowerKeyPtr->description());
   }
 }
@@ -186,12 +288,15 @@ void ColumnsIndex::addColumnToDesc (RecordDesc& description,
 void ColumnsIndex::create (const Table& table,
 			   const Vector<String>& columnNames,
 			   Compare* compareFunction,
-			   Bool noSort)
+			   Bool noSort,
+			   IndexType indexType)
 {
   itsTable = table;
   itsNrrow = itsTable.nrow();
+  itsRemoveCounter = itsTable.getRowRemoveCounter();
   itsCompare = (compareFunction == 0  ?  compare : compareFunction);
   itsNoSort = noSort;
+  itsIndexType = indexType;
   // Loop through all column names.
   // Always add it to the RecordDesc.
   RecordDesc description;
@@ -317,136 +422,76 @@ void ColumnsIndex::readData()
   // Acquire a lock if needed.
   TableLocker locker(itsTable, FileLocker::Read);
   rownr_t nrrow = itsTable.nrow();
-  if (nrrow != itsNrrow) {
-    itsColumnChanged.set (True);
+  // If only rows have been added, only the new rows need to be read.
+  // That is the case if the row remove counter is unchanged (rows might
+  // have been removed and added again).
+  // Otherwise the changed columns are reread entirely.
+  uInt64 removeCounter = itsTable.getRowRemoveCounter();
+  rownr_t startRow = 0;
+  if (nrrow != itsNrrow  ||  removeCounter != itsRemoveCounter) {
+    if (nrrow > itsNrrow  &&  removeCounter == itsRemoveCounter
+    &&  !itsChanged) {
+      startRow = itsNrrow;
+    } else {
+      itsColumnChanged.set (True);
+    }
     itsChanged = True;
     itsNrrow = nrrow;
+    itsRemoveCounter = removeCounter;
   }
   if (!itsChanged) {
     return;
   }
-  Sort sort;
-  Bool deleteIt;
-  const RecordDesc& desc = itsLowerKeyPtr->description();
   uInt nrfield = itsDataTypes.nelements();
   for (uInt i=0; i<nrfield; i++) {
-    const String& name = desc.name(i);
     switch (itsDataTypes[i]) {
     case TpBool:
-    {
-      Vector<Bool>* vecptr = (Vector<Bool>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<Bool>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<Bool> (i, startRow);
       break;
-    }
     case TpUChar:
-    {
-      Vector<uChar>* vecptr = (Vector<uChar>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<uChar>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<uChar> (i, startRow);
       break;
-    }
     case TpShort:
-    {
-      Vector<Short>* vecptr = (Vector<Short>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<Short>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<Short> (i, startRow);
       break;
-    }
     case TpInt:
-    {
-      Vector<Int>* vecptr = (Vector<Int>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<Int>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<Int> (i, startRow);
       break;
-    }
     case TpUInt:
-    {
-      Vector<uInt>* vecptr = (Vector<uInt>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<uInt>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<uInt> (i, startRow);
       break;
-    }
     case TpInt64:
-    {
-      Vector<Int64>* vecptr = (Vector<Int64>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<Int64>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<Int64> (i, startRow);
       break;
-    }
     case TpFloat:
-    {
-      Vector<Float>* vecptr = (Vector<Float>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<Float>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<Float> (i, startRow);
       break;
-    }
     case TpDouble:
-    {
-      Vector<Double>* vecptr = (Vector<Double>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<Double>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<Double> (i, startRow);
       break;
-    }
     case TpComplex:
-    {
-      Vector<Complex>* vecptr = (Vector<Complex>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<Complex>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<Complex> (i, startRow);
       break;
-    }
     case TpDComplex:
-    {
-      Vector<DComplex>* vecptr = (Vector<DComplex>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<DComplex>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<DComplex> (i, startRow);
       break;
-    }
     case TpString:
-    {
-      Vector<String>* vecptr = (Vector<String>*)itsDataVectors[i];
-      if (itsColumnChanged[i]) {
-	ScalarColumn<String>(itsTable, name).getColumn (*vecptr, True);
-      }
-      itsData[i] = vecptr->getStorage (deleteIt);
-      sort.sortKey (itsData[i], desc.type(i));
+      readColumn<String> (i, startRow);
       break;
-    }
     default:
       throw (TableError ("ColumnsIndex: unknown data type"));
     }
     itsColumnChanged[i] = False;
   }
+  itsChanged = False;
+  if (itsIndexType == Hashed) {
+    buildHash (startRow);
+    return;
+  }
+  Sort sort;
+  for (uInt i=0; i<nrfield; i++) {
+    sort.sortKey (itsData[i], DataType(itsDataTypes[i]));
+  }
   // Sort the data if needed.
   // Otherwise fill the index vector with 0..n.
   itsDataIndex.resize (itsNrrow);
@@ -458,9 +503,227 @@ void ColumnsIndex::readData()
   // Determine all unique keys (itsUniqueIndex will contain the index of
   // each first unique entry in itsDataIndex).
   sort.unique (itsUniqueIndex, itsDataIndex);
+  Bool deleteIt;
   itsDataInx = itsDataIndex.getStorage (deleteIt);
   itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
-  itsChanged = False;
+}
+
+template<typename T>
+void ColumnsIndex::readColumn (uInt field, rownr_t startRow)
+{
+  Vector<T>* vecptr = (Vector<T>*)itsDataVectors[field];
+  ScalarColumn<T> column(itsTable, itsLowerKeyPtr->description().name(field));
+  if (startRow == 0) {
+    if (itsColumnChanged[field]) {
+      column.getColumn (*vecptr, True);
+    }
+  } else {
+    // Extend the vector and read the new rows only.
+    vecptr->resize (itsNrrow, True);
+    Vector<T> part ((*vecptr)(Slice(startRow, itsNrrow-startRow)));
+    column.getColumnRange (Slicer(IPosition(1, startRow),
+                                  IPosition(1, itsNrrow-startRow)),
+                           part);
+  }
+  Bool deleteIt;
+  itsData[field] = vecptr->getStorage (deleteIt);
+}
+
+void ColumnsIndex::buildHash (rownr_t startRow)
+{
+  if (startRow == 0) {
+    itsHashSlots.clear();
+    itsHashFirst.clear();
+    itsHashLast.clear();
+  }
+  itsRowHash.resize (itsNrrow);
+  itsHashNext.resize (itsNrrow);
+  std::fill (itsRowHash.begin() + startRow, itsRowHash.end(), 0);
+  std::fill (itsHashNext.begin() + startRow, itsHashNext.end(), -1);
+  // Calculate the hash of the key in each new row.
+  uInt64* hashes = itsRowHash.data();
+  uInt nrfield = itsDataTypes.nelements();
+  for (uInt i=0; i<nrfield; i++) {
+    switch (itsDataTypes[i]) {
+    case TpBool:
+      hashColumn<Bool> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpUChar:
+      hashColumn<uChar> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpShort:
+      hashColumn<Short> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpInt:
+      hashColumn<Int> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpUInt:
+      hashColumn<uInt> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpInt64:
+      hashColumn<Int64> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpFloat:
+      hashColumn<Float> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpDouble:
+      hashColumn<Double> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpComplex:
+      hashColumn<Complex> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpDComplex:
+      hashColumn<DComplex> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    case TpString:
+      hashColumn<String> (itsData[i], startRow, itsNrrow, hashes);
+      break;
+    default:
+      throw (TableError ("ColumnsIndex: unknown data type"));
+    }
+  }
+  // Keep the load factor at most 0.5 (assuming all new keys are unique).
+  // If the table has to grow, the existing keys are inserted again.
+  size_t needed = 2 * (itsHashFirst.size() + itsNrrow - startRow);
+  if (itsHashSlots.size() < needed) {
+    size_t size = 16;
+    while (size < needed) {
+      size *= 2;
+    }
+    itsHashSlots.assign (size, -1);
+    const uInt64 mask = size - 1;
+    for (size_t key=0; key<itsHashFirst.size(); ++key) {
+      uInt64 pos = itsRowHash[itsHashFirst[key]] & mask;
+      while (itsHashSlots[pos] >= 0) {
+        pos = (pos+1) & mask;
+      }
+      itsHashSlots[pos] = key;
+    }
+  }
+  // Add the new rows using linear probing.
+  // Rows with the same key are chained in ascending order.
+  const uInt64 mask = itsHashSlots.size() - 1;
+  for (rownr_t row=startRow; row<itsNrrow; ++row) {
+    const uInt64 hash = itsRowHash[row];
+    uInt64 pos = hash & mask;
+    while (True) {
+      Int64 key = itsHashSlots[pos];
+      if (key < 0) {
+        itsHashSlots[pos] = itsHashFirst.size();
+        itsHashFirst.push_back (row);
+        itsHashLast.push_back (row);
+        break;
+      }
+      rownr_t first = itsHashFirst[key];
+      if (itsRowHash[first] == hash) {
+        Bool equal = True;
+        for (uInt i=0; equal && i<nrfield; i++) {
+          switch (itsDataTypes[i]) {
+          case TpBool:
+            equal = equalValues<Bool> (itsData[i], first, row);
+            break;
+          case TpUChar:
+            equal = equalValues<uChar> (itsData[i], first, row);
+            break;
+          case TpShort:
+            equal = equalValues<Short> (itsData[i], first, row);
+            break;
+          case TpInt:
+            equal = equalValues<Int> (itsData[i], first, row);
+            break;
+          case TpUInt:
+            equal = equalValues<uInt> (itsData[i], first, row);
+            break;
+          case TpInt64:
+            equal = equalValues<Int64> (itsData[i], first, row);
+            break;
+          case TpFloat:
+            equal = equalValues<Float> (itsData[i], first, row);
+            break;
+          case TpDouble:
+            equal = equalValues<Double> (itsData[i], first, row);
+            break;
+          case TpComplex:
+            equal = equalValues<Complex> (itsData[i], first, row);
+            break;
+          case TpDComplex:
+            equal = equalValues<DComplex> (itsData[i], first, row);
+            break;
+          case TpString:
+            equal = equalValues<String> (itsData[i], first, row);
+            break;
+          }
+        }
+        if (equal) {
+          itsHashNext[itsHashLast[key]] = row;
+          itsHashLast[key] = row;
+          break;
+        }
+      }
+      pos = (pos+1) & mask;
+    }
+  }
+}
+
+Int64 ColumnsIndex::hashFind (const Block<void*>& fieldPtrs) const
+{
+  // Calculate the hash of the key in the same way as for the rows.
+  uInt64 hash = 0;
+  uInt nrfield = itsDataTypes.nelements();
+  for (uInt i=0; i<nrfield; i++) {
+    switch (itsDataTypes[i]) {
+    case TpBool:
+      hash = hashField<Bool> (fieldPtrs[i], hash);
+      break;
+    case TpUChar:
+      hash = hashField<uChar> (fieldPtrs[i], hash);
+      break;
+    case TpShort:
+      hash = hashField<Short> (fieldPtrs[i], hash);
+      break;
+    case TpInt:
+      hash = hashField<Int> (fieldPtrs[i], hash);
+      break;
+    case TpUInt:
+      hash = hashField<uInt> (fieldPtrs[i], hash);
+      break;
+    case TpInt64:
+      hash = hashField<Int64> (fieldPtrs[i], hash);
+      break;
+    case TpFloat:
+      hash = hashField<Float> (fieldPtrs[i], hash);
+      break;
+    case TpDouble:
+      hash = hashField<Double> (fieldPtrs[i], hash);
+      break;
+    case TpComplex:
+      hash = hashField<Complex> (fieldPtrs[i], hash);
+      break;
+    case TpDComplex:
+      hash = hashField<DComplex> (fieldPtrs[i], hash);
+      break;
+    case TpString:
+      hash = hashField<String> (fieldPtrs[i], hash);
+      break;
+    default:
+      throw (TableError ("ColumnsIndex: unknown data type"));
+    }
+  }
+  // The table always contains empty slots, so the loop ends.
+  const uInt64 mask = itsHashSlots.size() - 1;
+  uInt64 pos = hash & mask;
+  while (True) {
+    Int64 key = itsHashSlots[pos];
+    if (key < 0) {
+      return -1;
+    }
+    rownr_t row = itsHashFirst[key];
+    if (itsRowHash[row] == hash  &&
+        compare (fieldPtrs, itsData, itsDataTypes, row) == 0) {
+      return key;
+    }
+    pos = (pos+1) & mask;
+  }
 }
 
 rownr_t ColumnsIndex::bsearch (Bool& found, const Block<void*>& fieldPtrs) const
@@ -637,6 +900,11 @@ rownr_t ColumnsIndex::getRowNumber (Bool& found)
   }
   // Read the data (if needed).
   readData();
+  if (itsIndexType == Hashed) {
+    Int64 key = hashFind (itsLowerFields);
+    found = (key >= 0);
+    return (found  ?  itsHashFirst[key] : 0);
+  }
   rownr_t inx = bsearch (found, itsLowerFields);
   if (found) {
     inx = itsDataInx[inx];
@@ -654,6 +922,16 @@ RowNumbers ColumnsIndex::getRowNumbers()
 {
   // Read the data (if needed).
   readData();
+  if (itsIndexType == Hashed) {
+    std::vector<rownr_t> rows;
+    Int64 key = hashFind (itsLowerFields);
+    if (key >= 0) {
+      for (Int64 row=itsHashFirst[key]; row>=0; row=itsHashNext[row]) {
+        rows.push_back (row);
+      }
+    }
+    return RowNumbers(rows);
+  }
   Bool found;
   rownr_t inx = bsearch (found, itsLowerFields);
   RowNumbers rows;
@@ -676,6 +954,10 @@ RowNumbers ColumnsIndex::getRowNumbers (const Record& lowerKey,
 RowNumbers ColumnsIndex::getRowNumbers (Bool lowerInclusive,
                                         Bool upperInclusive)
 {
+  if (itsIndexType == Hashed) {
+    throw (TableError ("ColumnsIndex: a key range cannot be looked up "
+                       "in a hashed index"));
+  }
   // Read the data (if needed).
   readData();
   Bool found;
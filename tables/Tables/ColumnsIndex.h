@@ -33,6 +33,7 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/Record.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -67,6 +68,15 @@ template<typename T> class RecordFieldPtr;
 // will be read, sorted (if needed), and stored in memory.
 // When looking up a key or key range, the class will use a fast binary
 // search on the data held in memory.
+// <br>Alternatively a hashed index can be created. It puts the keys in
+// a hash table (using open addressing), so looking up a key takes
+// constant time instead of a binary search. The hash of the key of each
+// row is calculated once when the data are read. A hashed index can only
+// be used to look up keys, not key ranges. A user-defined compare
+// function cannot be used for a hashed index.
+// <br>Note that in both modes complex values are compared by their norm
+// (as done by the complex comparison operators), so for example the keys
+// (1,0) and (0,1) are the same.
 // <p>
 // The <src>ColumnsIndex</src> object contains a
 // <linkto class=Record>Record</linkto> object which can be used
@@ -108,6 +118,12 @@ template<typename T> class RecordFieldPtr;
 // <br>If data have changed, the entire index will be recreated by
 // rereading and optionally resorting the data. This will be deferred
 // until the next key lookup.
+// <br>If rows have been added to the table (and no data have changed),
+// only the data in the new rows are read. A hashed index adds their
+// keys to the hash table, while a sorted index is resorted.
+// If rows have been removed (or could have been removed by another
+// process, see <src>Table::getRowRemoveCounter</src>), the data are
+// reread entirely, even if the number of rows has not changed.
 // </synopsis>
 
 // <example>
@@ -214,6 +230,18 @@ template<typename T> class RecordFieldPtr;
 //     rownr_t rownr = colInx.getRowNumber (found);
 // }
 // </srcblock>
+//
+// A hashed index is used in the same way, but can only look up keys.
+// <srcblock>
+// Table tab("sometable")
+// ColumnsIndex colInx(tab, stringToVector("ANTENNA1,ANTENNA2"),
+//                     ColumnsIndex::Hashed);
+// RecordFieldPtr<Int> ant1(colInx.accessKey(), "ANTENNA1");
+// RecordFieldPtr<Int> ant2(colInx.accessKey(), "ANTENNA2");
+// *ant1 = 1;
+// *ant2 = 3;
+// RowNumbers rows = colInx.getRowNumbers();
+// </srcblock>
 // </example>
 
 // <motivation>
@@ -239,6 +267,16 @@ public:
 			 const Block<Int>& dataTypes,
 			 rownr_t index);
 
+    // Define the type of index.
+    enum IndexType {
+      // The keys are sorted and a binary search is used to look up
+      // a key or key range.
+      Sorted,
+      // The keys are put in a hash table, which can only be used
+      // to look up a key.
+      Hashed
+    };
+
     // Create an index on the given table for the given column.
     // The column has to be a scalar column.
     // If <src>noSort==True</src>, the table is already in order of that
@@ -258,6 +296,14 @@ public:
     ColumnsIndex (const Table&, const Vector<String>& columnNames,
 		  Compare* compareFunction = 0, Bool noSort = False);
 
+    // Create an index of the given type on the given table for the given
+    // column(s). The default compare function is used.
+    // <group>
+    ColumnsIndex (const Table&, const String& columnName, IndexType);
+    ColumnsIndex (const Table&, const Vector<String>& columnNames,
+                  IndexType);
+    // </group>
+
     // Copy constructor (copy semantics).
     ColumnsIndex (const ColumnsIndex& that);
 
@@ -269,6 +315,9 @@ public:
     // Are all keys in the index unique?
     Bool isUnique() const;
 
+    // Get the type of the index.
+    IndexType indexType() const;
+
     // Return the names of the columns forming the index.
     Vector<String> columnNames() const;
 
@@ -322,6 +371,7 @@ public:
 
     // Find the row numbers matching the key range. The boolean arguments
     // tell if the lower and upper key are part of the range.
+    // An exception is thrown for a hashed index.
     // The 2nd version makes it possible to pass in your own Records
     // instead of using the internal records via the
     // <src>accessLower/UpperKey</src> functions.
@@ -350,7 +400,8 @@ protected:
 
     // Create the various members in the object.
     void create (const Table& table, const Vector<String>& columnNames,
-		 Compare* compareFunction, Bool noSort);
+		 Compare* compareFunction, Bool noSort,
+                 IndexType indexType = Sorted);
 
     // Make the various internal <src>RecordFieldPtr</src> objects.
     void makeObjects (const RecordDesc& description);
@@ -359,6 +410,19 @@ protected:
     // form the index.
     void readData();
 
+    // Read the data of a column from the given row on.
+    template<typename T>
+    void readColumn (uInt field, rownr_t startRow);
+
+    // Add the keys of the rows from <src>startRow</src> on to the hash table.
+    // The hash table is cleared first if <src>startRow==0</src>.
+    void buildHash (rownr_t startRow);
+
+    // Look up the key in <src>fieldPtrs</src> in the hash table.
+    // It returns the index of the key in <src>itsHashFirst</src>
+    // or -1 if not found.
+    Int64 hashFind (const Block<void*>& fieldPtrs) const;
+
     // Do a binary search on <src>itsUniqueIndex</src> for the key in
     // <src>fieldPtrs</src>.
     // If the key is found, <src>found</src> is set to True and the index
@@ -392,6 +456,7 @@ private:
 
     Table   itsTable;
     rownr_t itsNrrow;
+    uInt64  itsRemoveCounter;
     Record* itsLowerKeyPtr;
     Record* itsUpperKeyPtr;
     Block<Int>      itsDataTypes;
@@ -410,13 +475,27 @@ private:
     Vector<rownr_t> itsUniqueIndex;
     rownr_t*        itsDataInx;           //# pointer to data in itsDataIndex
     rownr_t*        itsUniqueInx;         //# pointer to data in itsUniqueIndex
+    IndexType       itsIndexType;
+    //# The following vectors are used by a hashed index.
+    std::vector<uInt64>  itsRowHash;      //# hash of the key of each row
+    std::vector<Int64>   itsHashSlots;    //# index in itsHashFirst or -1
+    std::vector<rownr_t> itsHashFirst;    //# first row of each unique key
+    std::vector<rownr_t> itsHashLast;     //# last row of each unique key
+    std::vector<Int64>   itsHashNext;     //# next row with same key or -1
 };
 
 
 inline Bool ColumnsIndex::isUnique() const
 {
+    if (itsIndexType == Hashed) {
+      return (itsHashFirst.size() == itsHashNext.size());
+    }
     return (itsDataIndex.nelements() == itsUniqueIndex.nelements());
 }
+inline ColumnsIndex::IndexType ColumnsIndex::indexType() const
+{
+    return itsIndexType;
+}
 inline const Table& ColumnsIndex::table() const
 {
     return itsTable;
@@ -163,6 +163,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     refColPtr_p[tableNr]->getArray (tabRownr, arr);
   }
 
+  Bool ConcatColumn::getArrayView (rownr_t rownr, ArrayBase& arr) const
+  {
+    uInt tableNr;
+    rownr_t tabRownr;
+    refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
+    return refColPtr_p[tableNr]->getArrayView (tabRownr, arr);
+  }
+
   void ConcatColumn::getSlice (rownr_t rownr, const Slicer& ns,
 			       ArrayBase& arr) const
   {
@@ -163,6 +163,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get an array from a particular cell.
     virtual void getArray (rownr_t rownr, ArrayBase& dataPtr) const;
 
+    // Try to reference the array in a particular cell without copying it.
+    virtual Bool getArrayView (rownr_t rownr, ArrayBase& dataPtr) const;
+
     // Get the array of some array values in a column.
     // If the column contains n-dim arrays, the resulting array is (n+1)-dim.
     // The arrays in the column have to have the same shape in all cells.
@@ -231,6 +231,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return tables_p[0].baseTablePtr()->getModifyCounter();
   }
 
+  uInt64 ConcatTable::getRowRemoveCounter() const
+  {
+    uInt64 counter = rowRemoveCounter_p;
+    for (uInt i=0; i<tables_p.nelements(); ++i) {
+      counter += tables_p[i].baseTablePtr()->getRowRemoveCounter();
+    }
+    return counter;
+  }
+
 
   //# Write a concatenate table into a file.
   void ConcatTable::writeConcatTable (Bool)
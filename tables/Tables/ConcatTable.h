@@ -216,6 +216,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
+    // Get the row remove counter as the sum of the underlying tables.
+    virtual uInt64 getRowRemoveCounter() const;
+
     // Test if all underlying tables are opened as writable.
     virtual Bool isWritable() const;
 
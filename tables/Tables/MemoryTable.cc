@@ -239,6 +239,7 @@ void MemoryTable::removeRow (rownr_t rownr)
 {
   colSetPtr_p->removeRow (rownr);
   nrrow_p--;
+  rowRemoveCounter_p++;
 }
 
 void MemoryTable::addColumn (const ColumnDesc& columnDesc, Bool)
@@ -28,11 +28,15 @@
 #include <casacore/tables/Tables/TableTrace.h>
 #include <casacore/tables/Tables/BaseColDesc.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/ColumnIndexFile.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayIter.h>
 #include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/Utilities/ValType.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -42,7 +46,9 @@ PlainColumn::PlainColumn (const BaseColumnDesc* cdp, ColumnSet* csp)
   dataManPtr_p  (0),
   dataColPtr_p  (0),
   colSetPtr_p   (csp),
-  originalName_p(cdp->name())
+  originalName_p(cdp->name()),
+  metrics_p     (0),
+  indexNrow_p   (-1)
 {
   int trace = TableTrace::traceColumn (columnDesc());
   rtraceColumn_p = (trace&TableTrace::READ)  != 0;
@@ -52,6 +58,44 @@ PlainColumn::PlainColumn (const BaseColumnDesc* cdp, ColumnSet* csp)
 PlainColumn::~PlainColumn()
 {}
 
+void PlainColumn::initMetrics (const String& tableName)
+{
+  metrics_p = TableMetrics::column (tableName, columnDesc().name(),
+                                    ValType::getTypeSize (columnDesc().dataType()));
+}
+
+void PlainColumn::doCheckIndex (rownr_t rownr)
+{
+  // Find out if there is an index (done again after a resync).
+  if (indexNrow_p < 0) {
+    indexNrow_p = ColumnIndexFile::indexedRows (colSetPtr_p->tableName(),
+                                                columnDesc().name());
+  }
+  // Rows added after the index was made can be changed freely.
+  if (indexNrow_p > 0  &&  rownr < rownr_t(indexNrow_p)) {
+    ColumnIndexFile::markStale (colSetPtr_p->tableName(),
+                                columnDesc().name());
+    indexNrow_p = 0;
+  }
+}
+
+void PlainColumn::checkIndex (const RefRows& rownrs)
+{
+  if (indexNrow_p != 0) {
+    // Only the lowest row matters, so the rows are not expanded.
+    // The start of a slice is its lowest row.
+    const Vector<rownr_t>& rows = rownrs.rowVector();
+    const size_t step = (rownrs.isSliced()  ?  3 : 1);
+    if (! rows.empty()) {
+      rownr_t minRow = rows[0];
+      for (size_t i=step; i<rows.size(); i+=step) {
+        minRow = std::min (minRow, rows[i]);
+      }
+      doCheckIndex (minRow);
+    }
+  }
+}
+
 
 rownr_t PlainColumn:: nrow() const
     { return colSetPtr_p->nrow(); }
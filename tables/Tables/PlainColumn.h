@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/Tables/ColumnSet.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/TableMetrics.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -135,6 +136,23 @@ public:
     // Read the column.
     void getFile (AipsIO&, const ColumnSet&, const TableAttr&);
 
+    // Let the column collect IO metrics in the given table if enabled.
+    void initMetrics (const String& tableName);
+
+    // A persistent index (see <linkto class=ColumnIndexFile>ColumnIndexFile
+    // </linkto>) of the column has been created, updated, or removed
+    // (by this or another process).
+    void resetIndexState()
+      { indexNrow_p = -1; }
+
+    // Check if a write in the given row(s) invalidates a persistent index
+    // of the column. If so, the index is marked as stale.
+    // <group>
+    void checkIndex (rownr_t rownr)
+      { if (indexNrow_p != 0) doCheckIndex (rownr); }
+    void checkIndex (const RefRows& rownrs);
+    // </group>
+
 protected:
     DataManager*        dataManPtr_p;    //# Pointer to data manager.
     DataManagerColumn*  dataColPtr_p;    //# Pointer to column in data manager.
@@ -142,6 +160,8 @@ protected:
     String              originalName_p;  //# Column name before any rename
     Bool                rtraceColumn_p;  //# trace reads of the column?
     Bool                wtraceColumn_p;  //# trace writes of the column?
+    TableMetrics::ColumnMetrics* metrics_p; //# IO metrics (0 = not used)
+    Int64               indexNrow_p;     //# #rows in index (-1 = unknown)
 
     // Get the trace-id of the table.
     int traceId() const
@@ -174,6 +194,9 @@ protected:
     void checkWriteLock (Bool wait) const;
     // </group>
 
+    // Invalidate a persistent index if the row is part of it.
+    void doCheckIndex (rownr_t rownr);
+
     // Inspect the auto lock when the inspection interval has expired and
     // release it when another process needs the lock.
     void autoReleaseLock() const;
@@ -156,6 +156,7 @@ void PlainTable::PlainTableCommon (SetupNewTable& newtab, rownr_t nrrow,
     tableCache().define (name_p, this);
     //# Trace if needed.
     itsTraceId = TableTrace::traceTable (name_p, 'n');
+    colSetPtr_p->initMetrics (name_p);
   } catch (std::exception&) {
     delete lockPtr_p;
     lockPtr_p = 0;
@@ -279,6 +280,7 @@ PlainTable::PlainTable (AipsIO&, uInt version, const String& tabname,
     }
     //# Trace if needed.
     itsTraceId = TableTrace::traceTable (name_p, 'o');
+    colSetPtr_p->initMetrics (name_p);
 }
 
 
@@ -333,7 +335,8 @@ void PlainTable::closeObject()
     if (addToCache_p) {
       tableCache().remove (name_p);
     }
-    //# Trace if needed.
+    //# Collect the final cache statistics and trace if needed.
+    colSetPtr_p->updateMetrics (name_p, True);
     TableTrace::traceClose (name_p);
     //# Delete everything.
     delete lockPtr_p;
@@ -446,10 +449,15 @@ Bool PlainTable::lock (FileLocker::LockType type, uInt nattempts)
 	    // Skip the sync-ing in that case.
 	    uInt ncolumn;
             rownr_t nrrow;
+            uInt modifyCounter = lockSync_p.getModifyCounter();
 	    if (! lockSync_p.read (nrrow, ncolumn, tableChanged,
 				   colSetPtr_p->dataManChanged())) {
 		tableChanged = False;
 	    } else {
+                // Another process could have removed rows.
+                if (lockSync_p.getModifyCounter() != modifyCounter) {
+                    rowRemoveCounter_p++;
+                }
 		if (ncolumn != tableDesc().ncolumn()) {
 		    throw (TableError ("Table::lock cannot sync table "
                                        + tableName() + "; another process "
@@ -519,6 +527,7 @@ void PlainTable::flush (Bool fsync, Bool recursive)
             keywordSet().flushTables (fsync);
         }
     }
+    colSetPtr_p->updateMetrics (name_p, False);
 }
 
 void PlainTable::resync()
@@ -530,8 +539,12 @@ void PlainTable::resync()
     // Skip the sync-ing in that case.
     uInt ncolumn;
     rownr_t nrrow;
+    uInt modifyCounter = lockSync_p.getModifyCounter();
     if (lockSync_p.read (nrrow, ncolumn, tableChanged,
                          colSetPtr_p->dataManChanged())) {
+        if (lockSync_p.getModifyCounter() != modifyCounter) {
+            rowRemoveCounter_p++;
+        }
         if (ncolumn != tableDesc().ncolumn()) {
             throw (TableError ("Table::resync cannot sync table " +
                                tableName() + "; another process "
@@ -699,6 +712,7 @@ void PlainTable::removeRow (rownr_t rownr)
     colSetPtr_p->checkWriteLock (True);
     colSetPtr_p->removeRow (rownr);
     nrrow_p--;
+    rowRemoveCounter_p++;
     colSetPtr_p->autoReleaseLock();
 }
 
@@ -707,6 +721,7 @@ void PlainTable::addColumn (const ColumnDesc& columnDesc, Bool)
     checkWritable("addColumn");
     Table tab(this);
     colSetPtr_p->addColumn (columnDesc, bigEndian_p, tsmOption_p, tab);
+    colSetPtr_p->initMetrics (name_p);
     tableChanged_p = True;
 }
 void PlainTable::addColumn (const ColumnDesc& columnDesc,
@@ -716,6 +731,7 @@ void PlainTable::addColumn (const ColumnDesc& columnDesc,
     Table tab(this);
     colSetPtr_p->addColumn (columnDesc, dataManager, byName, bigEndian_p,
                             tsmOption_p, tab);
+    colSetPtr_p->initMetrics (name_p);
     tableChanged_p = True;
 }
 void PlainTable::addColumn (const ColumnDesc& columnDesc,
@@ -725,6 +741,7 @@ void PlainTable::addColumn (const ColumnDesc& columnDesc,
     Table tab(this);
     colSetPtr_p->addColumn (columnDesc, dataManager, bigEndian_p,
                             tsmOption_p, tab);
+    colSetPtr_p->initMetrics (name_p);
     tableChanged_p = True;
 }
 void PlainTable::addColumn (const TableDesc& tableDesc,
@@ -734,6 +751,7 @@ void PlainTable::addColumn (const TableDesc& tableDesc,
     Table tab(this);
     colSetPtr_p->addColumn (tableDesc, dataManager, bigEndian_p,
                             tsmOption_p, tab);
+    colSetPtr_p->initMetrics (name_p);
     tableChanged_p = True;
 }
 
@@ -100,6 +100,9 @@ void RefColumn::get (rownr_t rownr, void* dataPtr) const
 void RefColumn::getArray (rownr_t rownr, ArrayBase& data) const
     { colPtr_p->getArray (refTabPtr_p->rootRownr(rownr), data); }
 
+Bool RefColumn::getArrayView (rownr_t rownr, ArrayBase& data) const
+    { return colPtr_p->getArrayView (refTabPtr_p->rootRownr(rownr), data); }
+
 void RefColumn::getSlice (rownr_t rownr, const Slicer& ns, ArrayBase& data) const
     { colPtr_p->getSlice (refTabPtr_p->rootRownr(rownr), ns, data); }
 
@@ -114,67 +117,61 @@ void RefColumn::putSlice (rownr_t rownr, const Slicer& ns, const ArrayBase& data
 
 void RefColumn::getScalarColumn (ArrayBase& data) const
 {
-    colPtr_p->getScalarColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->getScalarColumnCells (refTabPtr_p->rootRows(), data);
 }
 void RefColumn::getArrayColumn (ArrayBase& data) const
 {
-    colPtr_p->getArrayColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->getArrayColumnCells (refTabPtr_p->rootRows(), data);
 }
 void RefColumn::getColumnSlice (const Slicer& ns,
 				ArrayBase& data) const
 {
-    colPtr_p->getColumnSliceCells (refTabPtr_p->rowNumbers(), ns, data); 
+    colPtr_p->getColumnSliceCells (refTabPtr_p->rootRows(), ns, data);
 }
 void RefColumn::getScalarColumnCells (const RefRows& rownrs,
 				      ArrayBase& data) const
 {
-    colPtr_p->getScalarColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
-				    data);
+    colPtr_p->getScalarColumnCells (refTabPtr_p->rootRows(rownrs), data);
 }
 void RefColumn::getArrayColumnCells (const RefRows& rownrs,
 				     ArrayBase& data) const
 {
-    colPtr_p->getArrayColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
-				   data);
+    colPtr_p->getArrayColumnCells (refTabPtr_p->rootRows(rownrs), data);
 }
 void RefColumn::getColumnSliceCells (const RefRows& rownrs,
 				     const Slicer& ns,
 				     ArrayBase& data) const
 {
-    colPtr_p->getColumnSliceCells (rownrs.convert(refTabPtr_p->rowNumbers()),
-				   ns, data);
+    colPtr_p->getColumnSliceCells (refTabPtr_p->rootRows(rownrs), ns, data);
 }
 void RefColumn::putScalarColumn (const ArrayBase& data)
 {
-    colPtr_p->putScalarColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->putScalarColumnCells (refTabPtr_p->rootRows(), data);
 }
 void RefColumn::putArrayColumn (const ArrayBase& data)
 {
-    colPtr_p->putArrayColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->putArrayColumnCells (refTabPtr_p->rootRows(), data);
 }
 void RefColumn::putColumnSlice (const Slicer& ns,
 				const ArrayBase& data)
 {
-    colPtr_p->putColumnSliceCells (refTabPtr_p->rowNumbers(), ns, data); 
+    colPtr_p->putColumnSliceCells (refTabPtr_p->rootRows(), ns, data); 
 }
 void RefColumn::putScalarColumnCells (const RefRows& rownrs,
 				      const ArrayBase& data)
 {
-    colPtr_p->putScalarColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
-				    data);
+    colPtr_p->putScalarColumnCells (refTabPtr_p->rootRows(rownrs), data);
 }
 void RefColumn::putArrayColumnCells (const RefRows& rownrs,
 				     const ArrayBase& data)
 {
-    colPtr_p->putArrayColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
-				   data);
+    colPtr_p->putArrayColumnCells (refTabPtr_p->rootRows(rownrs), data);
 }
 void RefColumn::putColumnSliceCells (const RefRows& rownrs,
 				     const Slicer& ns,
 				     const ArrayBase& data)
 {
-    colPtr_p->putColumnSliceCells (rownrs.convert(refTabPtr_p->rowNumbers()),
-				   ns, data);
+    colPtr_p->putColumnSliceCells (refTabPtr_p->rootRows(rownrs), ns, data);
 }
 
 
@@ -190,6 +187,13 @@ void RefColumn::makeSortKey (Sort& sortobj, std::shared_ptr<BaseCompare>& cmpObj
     { colPtr_p->makeRefSortKey (sortobj, cmpObj, order,
 				refTabPtr_p->rowNumbers(), dataSave); }
 
+void RefColumn::makeRefSortKey (Sort& sortobj,
+                                std::shared_ptr<BaseCompare>& cmpObj,
+				Int order, const Vector<rownr_t>& rownrs,
+				std::shared_ptr<ArrayBase>& dataSave)
+    { colPtr_p->makeRefSortKey (sortobj, cmpObj, order,
+				refTabPtr_p->rootRownr(rownrs), dataSave); }
+
 void RefColumn::allocIterBuf (void*& lastVal, void*& curVal,
 			      std::shared_ptr<BaseCompare>& cmpObj)
     { colPtr_p->allocIterBuf (lastVal, curVal, cmpObj); }
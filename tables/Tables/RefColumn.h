@@ -149,6 +149,9 @@ public:
     // Get an array from a particular cell.
     virtual void getArray (rownr_t rownr, ArrayBase& dataPtr) const;
 
+    // Try to reference the array in a particular cell without copying it.
+    virtual Bool getArrayView (rownr_t rownr, ArrayBase& dataPtr) const;
+
     // Get a slice of an N-dimensional array in a particular cell.
     virtual void getSlice (rownr_t rownr, const Slicer&, ArrayBase& dataPtr) const;
 
@@ -230,8 +233,14 @@ public:
     // It may allocate some storage on the heap, which will be saved
     // in the argument dataSave.
     // The function freeSortKey must be called to free this storage.
+    // <group>
     virtual void makeSortKey (Sort&, std::shared_ptr<BaseCompare>& cmpObj,
 			      Int order, std::shared_ptr<ArrayBase>& dataSave);
+    // Do it only for the given row numbers.
+    virtual void makeRefSortKey (Sort&, std::shared_ptr<BaseCompare>& cmpObj,
+				 Int order, const Vector<rownr_t>& rownrs,
+				 std::shared_ptr<ArrayBase>& dataSave);
+    // </group>
 
     // Allocate value buffers for the table iterator.
     // Also get a comparison functiuon if undefined.
@@ -58,7 +58,7 @@ void RefRows::init (const Vector<rownr_t>& rowNumbers, Bool isSliced,
 	//# Stop doing that when the number of elements in the
 	//# resulting array would exceed the input length, because
 	//# in that case we gain not anything at all.
-	Vector<rownr_t> rows(itsNrows+3);
+	Vector<rownr_t> rows(itsNrows+6);
 	rownr_t start = 0;
 	rownr_t end = 0;
 	rownr_t incr = 0;
@@ -90,13 +90,22 @@ void RefRows::init (const Vector<rownr_t>& rowNumbers, Bool isSliced,
 		    rows(nr++) = incr;
 		    start = value;
 		    nv = 1;
-		} else {
+		} else if (value > end) {
 		    rows(nr++) = start;
 		    rows(nr++) = 1;
 		    start = end;
 		    end = value;
 		    incr = end - start;
 		    nv = 2;
+		} else {
+		    // Decreasing row number, so both are single rows.
+		    rows(nr++) = start;
+		    rows(nr++) = 1;
+		    rows(nr++) = end;
+		    rows(nr++) = end;
+		    rows(nr++) = 1;
+		    start = value;
+		    nv = 1;
 		}
 	    }
 	}
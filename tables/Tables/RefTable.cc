@@ -25,6 +25,7 @@
 
 #include <casacore/tables/Tables/RefTable.h>
 #include <casacore/tables/Tables/RefColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableLock.h>
@@ -40,6 +41,8 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/BasicSL/STLIO.h>
+#include <algorithm>
+#include <limits>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -47,6 +50,7 @@ RefTable::RefTable (AipsIO& ios, const String& name, rownr_t nrrow, int opt,
 		    const TableLock& lockOptions, const TSMOption& tsmOption)
 : BaseTable    (name, opt, nrrow),
   rowStorage_p (0),              // initially empty vector of rownrs
+  useRuns_p    (False),
   changed_p    (False)
 {
     //# Read the file in.
@@ -65,6 +69,7 @@ RefTable::RefTable (BaseTable* btp, Bool order, rownr_t nrall)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (order),
   rowStorage_p (nrall),       // allocate vector of rownrs
+  useRuns_p    (nrall == 0),  // rows are added as runs
   changed_p    (True)
 {
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
@@ -80,6 +85,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<rownr_t>& rownrs)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (True),
   rowStorage_p (0),
+  useRuns_p    (False),
   changed_p    (True)
 {
     //# Copy the table description and create the columns.
@@ -97,6 +103,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<rownr_t>& rownrs)
     }
     //# Adjust rownrs in case input table is a reference table.
     rowOrd_p = btp->adjustRownrs (nrrow_p, rowStorage_p, True);
+    compactRows();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 's');
 }
 
@@ -105,6 +112,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),              // initially empty vector of rownrs
+  useRuns_p    (True),           // rows are added as runs
   changed_p    (True)
 {
     //# Copy the table description and create the columns.
@@ -118,7 +126,8 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
 	}
     }
     //# Adjust rownrs in case input table is a reference table.
-    rowOrd_p = btp->adjustRownrs (nrrow_p, rowStorage_p, True);
+    rowOrd_p = adjustToRoot (btp, True);
+    compactRows();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 's');
 }
 
@@ -127,6 +136,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),
+  useRuns_p    (False),
   changed_p    (True)
 {
     //# Create table description by copying the selected columns.
@@ -139,9 +149,20 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
     }
     setup (btp, columnNames);
     //# Get the row numbers from the input table.
-    //# Copy them to this table.
-    rowStorage_p = btp->rowNumbers();
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
+    //# Copy them to this table. All rows of a root table form a single run.
+    const RefTable* rtp = dynamic_cast<const RefTable*>(btp);
+    if (rtp == 0) {
+        if (nrrow_p > 0) {
+            rowRuns_p.addRange (0, nrrow_p-1);
+        }
+        useRuns_p = True;
+    } else if (rtp->useRuns_p) {
+        rowRuns_p = rtp->rowRuns_p;
+        useRuns_p = True;
+    } else {
+        rowStorage_p = btp->rowNumbers();
+        AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
+    }
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 'p');
 }
 
@@ -236,6 +257,11 @@ uInt RefTable::getModifyCounter() const
     return baseTabPtr_p->getModifyCounter();
 }
 
+uInt64 RefTable::getRowRemoveCounter() const
+{
+    return rowRemoveCounter_p + baseTabPtr_p->getRowRemoveCounter();
+}
+
 
 //# Adjust the input rownrs to the actual rownrs in the root table.
 Bool RefTable::adjustRownrs (rownr_t nr, Vector<rownr_t>& rowStorage,
@@ -245,11 +271,15 @@ Bool RefTable::adjustRownrs (rownr_t nr, Vector<rownr_t>& rowStorage,
     AlwaysAssert (nr <= rowStorage.size(), AipsError);
     rowStorage.resize (nr, True);
     AlwaysAssert (rowStorage.contiguousStorage(), AipsError);
-    const rownr_t* rows = rowStorage_p.data();
     rownr_t* rownrs = rowStorage.data();
     Bool rowOrder = True;
-    for (rownr_t i=0; i<nr; i++) {
-	rownrs[i] = rows[rownrs[i]];
+    if (useRuns_p) {
+        rowRuns_p.map (nr, rownrs, rownrs);
+    } else {
+        const rownr_t* rows = rowStorage_p.data();
+        for (rownr_t i=0; i<nr; i++) {
+            rownrs[i] = rows[rownrs[i]];
+        }
     }
     if (determineOrder) {
 	for (rownr_t i=1; i<nr; i++) {
@@ -270,11 +300,14 @@ void RefTable::writeRefTable (Bool)
     //# Do this only when something has changed.
     if (changed_p) {
         TableTrace::traceRefTable (baseTabPtr_p->tableName(), 'w');
+        // The row numbers are always written as a vector (also if kept
+        // as runs), so older versions can read the table.
+        Vector<rownr_t> rowvec (rowNumbers());
         // Write old version if all row numbers fit in 32 bits.
         Int version = 3;
         if (nrrow_p < std::numeric_limits<uInt>::max()  &&
             baseTabPtr_p->nrow() < std::numeric_limits<uInt>::max()  &&
-            allLT (rowStorage_p, rownr_t(std::numeric_limits<uInt>::max()))) {
+            allLT (rowvec, rownr_t(std::numeric_limits<uInt>::max()))) {
           version = 2;
         }
 	AipsIO ios;
@@ -304,7 +337,7 @@ void RefTable::writeRefTable (Bool)
         Vector<uInt> rows32;
         if (version == 2) {
           rows32.resize (nrrow_p);
-          convertArray (rows32, rowStorage_p(Slice(0, nrrow_p)));
+          convertArray (rows32, rowvec);
         }
         const uInt* rows32p = rows32.data();
         rownr_t done = 0;
@@ -313,7 +346,7 @@ void RefTable::writeRefTable (Bool)
           if (version == 2) {
             ios.put (todo, rows32p+done, False);
           } else {
-            ios.put (todo, rowStorage_p.data()+done, False);
+            ios.put (todo, rowvec.data()+done, False);
           }
           done += todo;
         }
@@ -376,6 +409,7 @@ void RefTable::getRef (AipsIO& ios, int opt, const TableLock& lockOptions,
       convertArray (rowStorage_p, rows);
     }
     ios.getend();
+    compactRows();
     //# Now read in the root table referenced to.
     //# Check if #rows has not decreased, which is about the only thing
     //# we can do to make sure the referenced rows are still the same.
@@ -524,6 +558,10 @@ void RefTable::addRefCol (const TableDesc& tdesc)
 //# Add a row number of the root table.
 void RefTable::addRownr (rownr_t rnr)
 {
+    if (useRuns_p) {
+        addRownrRange (rnr, rnr);
+        return;
+    }
     rownr_t nrow = rowStorage_p.nelements();
     if (nrrow_p >= nrow) {
         nrow = max ( nrow + 1024, rownr_t(1.2f * nrow));
@@ -537,10 +575,22 @@ void RefTable::addRownr (rownr_t rnr)
 //# Add a row number range of the root table.
 void RefTable::addRownrRange (rownr_t startRownr, rownr_t endRownr)
 {
+    if (useRuns_p) {
+        rowRuns_p.addRange (startRownr, endRownr);
+        nrrow_p = rowRuns_p.nrow();
+        changed_p = True;
+        //# Use a row number vector if the rows get fragmented.
+        if (rowRuns_p.nrun() > 64  &&  4 * rowRuns_p.nrun() > nrrow_p) {
+            expandRows();
+        }
+        return;
+    }
     rownr_t nrow = rowStorage_p.nelements();
     rownr_t new_nrrow_p = nrrow_p + endRownr - startRownr + 1;
     if (new_nrrow_p > nrow) {
-        rowStorage_p.resize (new_nrrow_p, True);
+        //# Grow like addRownr to avoid many small resizes.
+        nrow = max (new_nrrow_p, rownr_t(1.2f * nrow));
+        rowStorage_p.resize (nrow, True);
         AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     }
     rownr_t* rows = rowStorage_p.data();
@@ -556,6 +606,9 @@ void RefTable::setNrrow (rownr_t nrrow)
     if (nrrow > nrrow_p) {
 	throw (TableError ("RefTable::setNrrow: exceeds current nrrow"));
     }
+    if (useRuns_p) {
+        rowRuns_p.resize (nrrow);
+    }
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     nrrow_p = nrrow;
     changed_p = True;
@@ -709,19 +762,74 @@ BaseColumn* RefTable::getColumn (uInt columnIndex) const
     
 
 Vector<rownr_t>& RefTable::rowStorage()
-    { return rowStorage_p; }
+{
+    expandRows();
+    return rowStorage_p;
+}
 
 //# Convert a vector of row numbers to row numbers in this table.
 Vector<rownr_t> RefTable::rootRownr (const Vector<rownr_t>& rownrs) const
 {
-    const rownr_t* rows = rowStorage_p.data();
     rownr_t nrow = rownrs.nelements();
     Vector<rownr_t> rnr(nrow);
     for (rownr_t i=0; i<nrow; i++) {
-	rnr(i) = rows[rownrs(i)];
+	rnr(i) = rootRownr (rownrs(i));
     }
     return rnr;
 }
+
+RefRows RefTable::rootRows (const RefRows& rownrs) const
+{
+    if (useRuns_p) {
+        return rowRuns_p.convert (rownrs);
+    }
+    return RefRows (rownrs.convert (rowNumbers()), False, True);
+}
+
+RefRows RefTable::rootRows() const
+{
+    if (useRuns_p) {
+        return rowRuns_p.refRows();
+    }
+    return RefRows (rowNumbers(), False, True);
+}
+
+void RefTable::compactRows()
+{
+    //# Use the runs if their average length is at least 4.
+    if (!useRuns_p  &&
+        4 * RowRunMap::countRuns (rowStorage_p.data(), nrrow_p) <= nrrow_p) {
+        rowRuns_p = RowRunMap (rowNumbers());
+        rowStorage_p.resize (0);
+        useRuns_p = True;
+    }
+}
+
+void RefTable::expandRows()
+{
+    if (useRuns_p) {
+        rowStorage_p.reference (rowRuns_p.rowNumbers());
+        rowRuns_p.clear();
+        useRuns_p = False;
+    }
+}
+
+Bool RefTable::adjustToRoot (const BaseTable* parent, Bool determineOrder)
+{
+    //# Row numbers in another type of table are root row numbers.
+    const RefTable* rtp = dynamic_cast<const RefTable*>(parent);
+    if (rtp == 0) {
+        return True;
+    }
+    changed_p = True;
+    if (useRuns_p  &&  rtp->useRuns_p) {
+        rowRuns_p = rtp->rowRuns_p.map (rowRuns_p);
+        return (!determineOrder  ||  rowRuns_p.isAscending());
+    }
+    Bool rowOrder = rtp->adjustRownrs (nrrow_p, rowStorage(), determineOrder);
+    compactRows();
+    return rowOrder;
+}
 	
 
 BaseTable* RefTable::root()
@@ -731,6 +839,9 @@ Bool RefTable::rowOrder() const
 
 Vector<rownr_t> RefTable::rowNumbers() const
 {
+    if (useRuns_p) {
+        return rowRuns_p.rowNumbers();
+    }
     if (nrrow_p == rowStorage_p.nelements()) {
 	return rowStorage_p;
     }
@@ -817,17 +928,21 @@ void RefTable::removeRow (rownr_t rownr)
     if (rownr >= nrrow_p) {
 	throw (TableInvOper ("removeRow: rownr out of bounds"));
     }
+    expandRows();
     rownr_t* rows = rowStorage_p.data();
     if (rownr < nrrow_p - 1) {
 	objmove (rows+rownr, rows+rownr+1, nrrow_p-rownr-1);
     }
     nrrow_p--;
+    rowRemoveCounter_p++;
     changed_p = True;
 }
 
 void RefTable::removeAllRow ()
 {
+    rowRuns_p.clear();
     nrrow_p=0;
+    rowRemoveCounter_p++;
     changed_p = True;
 }
 
@@ -874,179 +989,83 @@ DataManager* RefTable::findDataManager (const String& name, Bool byColumn) const
 }
 
 
-// And 2 index arrays, which are both in ascending order.
-void RefTable::refAnd (rownr_t nr1, const rownr_t* inx1,
-		       rownr_t nr2, const rownr_t* inx2)
+namespace {
+  Bool opAnd (Bool in1, Bool in2)
+    { return in1 && in2; }
+  Bool opOr (Bool in1, Bool in2)
+    { return in1 || in2; }
+  Bool opSub (Bool in1, Bool in2)
+    { return in1 && !in2; }
+  Bool opXor (Bool in1, Bool in2)
+    { return in1 != in2; }
+  Bool opNot (Bool in1, Bool)
+    { return !in1; }
+}
+
+// Sweep through the runs of both tables, which are in ascending order.
+// Each step handles the rows up to the next begin or end of a run.
+void RefTable::combineRuns (const RowRunMap& rows1, const RowRunMap& rows2,
+                            rownr_t nrmain, Bool (*op)(Bool, Bool))
 {
-    rownr_t allrow = (nr1 < nr2  ?  nr1 : nr2);  // max #output rows
-    rowStorage_p.resize (allrow);             // allocate output storage
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
-    rownr_t* rows = rowStorage_p.data();
-    rownr_t i1, i2, row1, row2;
-    i1 = i2 = 0;
-    while (True) {
-	if (i1 >= nr1) {
-            row1 = std::numeric_limits<rownr_t>::max();   // end of inx1
-	}else{
-	    row1 = inx1[i1];                  // next element in inx1
-	}
-	if (i2 >= nr2) {
-            row2 = std::numeric_limits<rownr_t>::max();   // end of inx2
-	}else{
-	    row2 = inx2[i2];                  // next element in inx2
-	}
-	if (row1 == row2) {
-	    if (row1 == std::numeric_limits<rownr_t>::max()) break; // end of both inx
-	    rows[nrrow_p++] = row1;
-	    i1++;
-	    i2++;
-	}else{
-	    if (row1 < row2) {
-		i1++;                         // next inx1
-	    }else{
-		i2++;                         // next inx2
-	    }
-	}
+    rowStorage_p.resize (0);
+    rowRuns_p.clear();
+    nrrow_p = 0;
+    useRuns_p = True;                         // rows are added as runs
+    const rownr_t endRow = std::numeric_limits<rownr_t>::max();
+    size_t i1 = 0;
+    size_t i2 = 0;
+    rownr_t row = 0;
+    while (row < nrmain) {
+        Bool in1 = False;
+        Bool in2 = False;
+        rownr_t next1 = endRow;
+        rownr_t next2 = endRow;
+        if (i1 < rows1.nrun()) {
+            rownr_t st = rows1.runStart(i1);
+            in1 = (row >= st);
+            next1 = (in1  ?  st + rows1.runLength(i1) : st);
+        }
+        if (i2 < rows2.nrun()) {
+            rownr_t st = rows2.runStart(i2);
+            in2 = (row >= st);
+            next2 = (in2  ?  st + rows2.runLength(i2) : st);
+        }
+        rownr_t next = std::min (std::min (next1, next2), nrmain);
+        if (op (in1, in2)) {
+            addRownrRange (row, next-1);
+        }
+        row = next;
+        if (in1  &&  row == next1) i1++;      // end of run in rows1
+        if (in2  &&  row == next2) i2++;      // end of run in rows2
     }
+    compactRows();
     changed_p = True;
 }
 
-// Or 2 index arrays, which are both in ascending order.
-void RefTable::refOr (rownr_t nr1, const rownr_t* inx1,
-		      rownr_t nr2, const rownr_t* inx2)
+void RefTable::refAnd (const RowRunMap& rows1, const RowRunMap& rows2)
 {
-    rownr_t allrow = nr1 + nr2;                  // max #output rows
-    rowStorage_p.resize (allrow);             // allocate output storage
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
-    rownr_t* rows = rowStorage_p.data();
-    rownr_t i1, i2, row1, row2;
-    i1 = i2 = 0;
-    while (True) {
-	if (i1 >= nr1) {
-            row1 = std::numeric_limits<rownr_t>::max();   // end of inx1
-	}else{
-	    row1 = inx1[i1];                  // next element in inx1
-	}
-	if (i2 >= nr2) {
-	    row2 = std::numeric_limits<rownr_t>::max();   // end of inx2
-	}else{
-	    row2 = inx2[i2];                  // next element in inx2
-	}
-	if (row1 == row2) {
-	    if (row1 == std::numeric_limits<rownr_t>::max()) break; // end of both inx
-	    rows[nrrow_p++] = row1;
-	    i1++;
-	    i2++;
-	}else{
-	    if (row1 < row2) {
-		rows[nrrow_p++] = row1;
-		i1++;                         // next inx1
-	    }else{
-		rows[nrrow_p++] = row2;
-		i2++;                         // next inx2
-	    }
-	}
-    }
-    changed_p = True;
+    combineRuns (rows1, rows2, baseTabPtr_p->nrow(), opAnd);
 }
 
-// Subtract 2 index arrays, which are both in ascending order.
-void RefTable::refSub (rownr_t nr1, const rownr_t* inx1,
-		       rownr_t nr2, const rownr_t* inx2)
+void RefTable::refOr (const RowRunMap& rows1, const RowRunMap& rows2)
 {
-    rownr_t allrow = nr1;                        // max #output rows
-    rowStorage_p.resize (allrow);             // allocate output storage
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
-    rownr_t* rows = rowStorage_p.data();
-    rownr_t i1, i2, row1, row2;
-    i1 = i2 = 0;
-    while (True) {
-	if (i1 >= nr1) {
-	    row1 = std::numeric_limits<rownr_t>::max();  // end of inx1
-	}else{
-	    row1 = inx1[i1];                  // next element in inx1
-	}
-	if (i2 >= nr2) {
-	    row2 = std::numeric_limits<rownr_t>::max();  // end of inx2
-	}else{
-	    row2 = inx2[i2];                  // next element in inx2
-	}
-	if (row1 == row2) {
-	    if (row1 == std::numeric_limits<rownr_t>::max()) break; // end of both inx
-	    i1++;
-	    i2++;
-	}else{
-	    if (row1 < row2) {
-		rows[nrrow_p++] = row1;
-		i1++;                         // next inx1
-	    }else{
-		i2++;                         // next inx2
-	    }
-	}
-    }
-    changed_p = True;
+    combineRuns (rows1, rows2, baseTabPtr_p->nrow(), opOr);
 }
 
-// Xor 2 index arrays, which are both in ascending order.
-void RefTable::refXor (rownr_t nr1, const rownr_t* inx1,
-		       rownr_t nr2, const rownr_t* inx2)
+void RefTable::refSub (const RowRunMap& rows1, const RowRunMap& rows2)
 {
-    rownr_t allrow = nr1 + nr2;                  // max #output rows
-    rowStorage_p.resize (allrow);             // allocate output storage
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
-    rownr_t* rows = rowStorage_p.data();
-    rownr_t i1, i2, row1, row2;
-    i1 = i2 = 0;
-    while (True) {
-	if (i1 >= nr1) {
-	    row1 = std::numeric_limits<rownr_t>::max();  // end of inx1
-	}else{
-	    row1 = inx1[i1];                  // next element in inx1
-	}
-	if (i2 >= nr2) {
-	    row2 = std::numeric_limits<rownr_t>::max();  // end of inx2
-	}else{
-	    row2 = inx2[i2];                  // next element in inx2
-	}
-	if (row1 == row2) {
-	    if (row1 == std::numeric_limits<rownr_t>::max()) break; // end of both inx
-	    i1++;
-	    i2++;
-	}else{
-	    if (row1 < row2) {
-		rows[nrrow_p++] = row1;
-		i1++;                         // next inx1
-	    }else{
-		rows[nrrow_p++] = row2;
-		i2++;                         // next inx2
-	    }
-	}
-    }
-    changed_p = True;
+    combineRuns (rows1, rows2, baseTabPtr_p->nrow(), opSub);
 }
 
-// Negate a table.
-void RefTable::refNot (rownr_t nr, const rownr_t* inx, rownr_t nrtot)
+void RefTable::refXor (const RowRunMap& rows1, const RowRunMap& rows2)
 {
-    // All rows not in the original table must be "selected".
-    // The original table has NRTOT rows.
-    // So loop through the inx-array and store all rownrs not in the array.
-    rownr_t allrow = nrtot - nr;                 // #output rows
-    rowStorage_p.resize (allrow);             // allocate output storage
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
-    rownr_t* rows = rowStorage_p.data();
-    rownr_t start = 0;
-    rownr_t i, j;
-    for (i=0; i<nr; i++) {                    // loop through inx-array
-	for (j=start; j<inx[i]; j++) {
-	    rows[nrrow_p++] = j;            // not in inx-array
-	}
-	start = inx[i] + 1;
-    }
-    for (j=start; j<nrtot; j++) {             // handle last interval
-	rows[nrrow_p++] = j;
-    }
-    changed_p = True;
+    combineRuns (rows1, rows2, baseTabPtr_p->nrow(), opXor);
+}
+
+// Negate a table (all rows of the root table not in the table).
+void RefTable::refNot (const RowRunMap& rows1, rownr_t nrmain)
+{
+    combineRuns (rows1, RowRunMap(), nrmain, opNot);
 }
 
 } //# NAMESPACE CASACORE - END
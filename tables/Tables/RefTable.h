@@ -30,6 +30,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/Tables/BaseTable.h>
+#include <casacore/tables/Tables/RowRunMap.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <map>
@@ -39,6 +40,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //# Forward Declarations
 class TSMOption;
 class RefColumn;
+class RefRows;
 class AipsIO;
 
 
@@ -73,6 +75,12 @@ class AipsIO;
 // while (if needed) converting the given row number to the row number
 // in the referenced table. For that purpose RefTable maintains a
 // Vector of the row numbers in the referenced table.
+// <br>If the row numbers consist of long runs of contiguous rows (as is
+// usually the case for a selection), they are kept as a
+// <linkto class=RowRunMap>RowRunMap</linkto> instead, which takes far
+// less memory. RefColumn then reads or writes each run as a single slice.
+// The row number vector is only created when needed by functions
+// like <src>rowStorage</src> (which is used by, e.g., a sort).
 //
 // The RefTable constructor acts in a way that it will always reference
 // the original table. This means that if a select is done on a RefTable,
@@ -81,14 +89,12 @@ class AipsIO;
 // However, if ever some other kind of table views are introduced
 // (like a join or a concatenation of similar tables), this cannot be
 // used anymore. Most software already anticipates on that. The only
-// exception is the code anding, oring tables (refAnd, etc.).
+// exception is the code anding, oring tables (refAnd, etc.), which
+// combines the runs of root row numbers of the tables.
 // </synopsis> 
 
 // <todo asof="$DATE:$">
 //# A List of bugs, limitations, extensions or planned refinements.
-//   <li> Maybe not allocating the row number vector for a projection.
-//          This saves space and time, but each rownr conversion will
-//          take a bit more time because it has to test if there is a vector.
 //   <li> Maybe maintain a Vector<String> telling on which columns
 //          the table is ordered. This may speed up selection, but
 //          it is hard to check if the order is changed by a put.
@@ -204,6 +210,9 @@ public:
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
+    // Get the row remove counter. It includes the counter of the parent.
+    virtual uInt64 getRowRemoveCounter() const;
+
     // Test if the parent table is opened as writable.
     virtual Bool isWritable() const;
 
@@ -311,8 +320,30 @@ public:
 
     // Get row number vector.
     // This is used by the BaseTable logic and sort routines.
+    // If the row numbers are kept as runs, the vector is created.
     virtual Vector<rownr_t>& rowStorage();
 
+    // Get the row numbers in the root table of the given rows as a
+    // RefRows object, where contiguous rows in the root table form a slice.
+    RefRows rootRows (const RefRows& rownrs) const;
+
+    // Get the row numbers in the root table of all rows as a RefRows object,
+    // where contiguous rows in the root table form a slice.
+    RefRows rootRows() const;
+
+    // Are the row numbers kept as runs (instead of a vector)?
+    Bool hasRowRuns() const
+      { return useRuns_p; }
+
+    // Get the runs of row numbers. They are only valid if
+    // <src>hasRowRuns()</src> is True.
+    const RowRunMap& rowRuns() const
+      { return rowRuns_p; }
+
+    // Keep the row numbers as runs if they mainly consist of runs of
+    // contiguous rows. It is done automatically after a selection.
+    void compactRows();
+
     // Add a rownr to reference table.
     void addRownr (rownr_t rownr);
 
@@ -322,6 +353,13 @@ void addRownrRange (rownr_t startRownr, rownr_t endRownr);
     // An exception is thrown if more than current nrrow.
     void setNrrow (rownr_t nrrow);
 
+    // Adjust the row numbers (being row numbers in the given parent table)
+    // to the row numbers in the root table like <src>adjustRownrs</src>.
+    // The row runs are kept if possible. Nothing is done if the parent is
+    // a root table. Optionally it also determines if the resulting rows
+    // are in row order.
+    Bool adjustToRoot (const BaseTable* parent, Bool determineOrder);
+
     // Adjust the row numbers to be the actual row numbers in the
     // root table. This is, for instance, used when a RefTable is sorted.
     // Optionally it also determines if the resulting rows are in row order.
@@ -329,16 +367,22 @@ void addRownrRange (rownr_t startRownr, rownr_t endRownr);
 			       Bool determineOrder) const;
 
     // And, or, subtract or xor the row numbers of 2 tables.
-    void refAnd (rownr_t nr1, const rownr_t* rows1, rownr_t nr2, const rownr_t* rows2);
-    void refOr  (rownr_t nr1, const rownr_t* rows1, rownr_t nr2, const rownr_t* rows2);
-    void refSub (rownr_t nr1, const rownr_t* rows1, rownr_t nr2, const rownr_t* rows2);
-    void refXor (rownr_t nr1, const rownr_t* rows1, rownr_t nr2, const rownr_t* rows2);
-    void refNot (rownr_t nr1, const rownr_t* rows1, rownr_t nrmain);
+    // The row numbers are given as runs in ascending order.
+    // The result is stored as runs if possible.
+    // <group>
+    void refAnd (const RowRunMap& rows1, const RowRunMap& rows2);
+    void refOr  (const RowRunMap& rows1, const RowRunMap& rows2);
+    void refSub (const RowRunMap& rows1, const RowRunMap& rows2);
+    void refXor (const RowRunMap& rows1, const RowRunMap& rows2);
+    void refNot (const RowRunMap& rows1, rownr_t nrmain);
+    // </group>
 
 private:
     std::shared_ptr<BaseTable> baseTabPtr_p;//# pointer to parent table
     Bool            rowOrd_p;               //# True = table is in row order
     Vector<rownr_t> rowStorage_p;           //# row numbers in parent table
+    RowRunMap       rowRuns_p;              //# or runs of those row numbers
+    Bool            useRuns_p;              //# True = rowRuns_p is used
     std::map<String,String> nameMap_p;      //# map to column name in parent
     std::map<String,RefColumn*> colMap_p;   //# map name to column
     Bool            changed_p;              //# True = changed since last write
@@ -367,6 +411,16 @@ private:
     // Create the RefColumn objects for all columns in the description.
     void makeRefCol();
 
+    // Convert the row runs (if used) to the row number vector.
+    void expandRows();
+
+    // Combine the runs of 2 tables for a logical operation. It adds the
+    // rows (of the <src>nrmain</src> rows in the root) for which
+    // <src>op</src> is True given if the row is part of the first
+    // and/or second table.
+    void combineRuns (const RowRunMap& rows1, const RowRunMap& rows2,
+                      rownr_t nrmain, Bool (*op)(Bool in1, Bool in2));
+
     // Write a reference table.
     void writeRefTable (Bool fsync);
 
@@ -386,7 +440,7 @@ private:
 
 
 inline rownr_t RefTable::rootRownr (rownr_t rnr) const
-    { return rowStorage_p[rnr]; }
+    { return (useRuns_p  ?  rowRuns_p[rnr] : rowStorage_p[rnr]); }
 
 
 
@@ -0,0 +1,286 @@
+//# RowRunMap.cc: Run-length encoded mapping of row numbers
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/tables/Tables/RowRunMap.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+  // Add the slice start..end (with increment 1) to the slices,
+  // where it is combined with the last slice if contiguous.
+  void appendSlice (std::vector<rownr_t>& slices, rownr_t start, rownr_t end)
+  {
+    size_t n = slices.size();
+    if (n > 0  &&  slices[n-1] == 1  &&  slices[n-2] + 1 == start) {
+      slices[n-2] = end;
+    } else {
+      slices.push_back (start);
+      slices.push_back (end);
+      slices.push_back (1);
+    }
+  }
+}
+
+
+RowRunMap::RowRunMap()
+: itsOffsets (1, 0),
+  itsLastRun (0)
+{}
+
+RowRunMap::RowRunMap (const Vector<rownr_t>& rownrs)
+: itsOffsets (1, 0),
+  itsLastRun (0)
+{
+  for (const rownr_t& row : rownrs) {
+    addRange (row, row);
+  }
+}
+
+RowRunMap::RowRunMap (const RefRows& rownrs)
+: itsOffsets (1, 0),
+  itsLastRun (0)
+{
+  RefRowsSliceIter iter(rownrs);
+  while (! iter.pastEnd()) {
+    if (iter.sliceIncr() == 1) {
+      addRange (iter.sliceStart(), iter.sliceEnd());
+    } else {
+      for (rownr_t row=iter.sliceStart(); row<=iter.sliceEnd();
+           row+=iter.sliceIncr()) {
+        addRange (row, row);
+      }
+    }
+    iter++;
+  }
+}
+
+RowRunMap::RowRunMap (const RowRunMap& that)
+: itsStarts  (that.itsStarts),
+  itsOffsets (that.itsOffsets),
+  itsLastRun (0)
+{}
+
+RowRunMap::RowRunMap (RowRunMap&& that)
+: itsStarts  (std::move (that.itsStarts)),
+  itsOffsets (std::move (that.itsOffsets)),
+  itsLastRun (0)
+{
+  that.itsStarts.clear();
+  that.itsOffsets.assign (1, 0);
+}
+
+RowRunMap& RowRunMap::operator= (const RowRunMap& that)
+{
+  if (this != &that) {
+    itsStarts  = that.itsStarts;
+    itsOffsets = that.itsOffsets;
+    itsLastRun = 0;
+  }
+  return *this;
+}
+
+RowRunMap& RowRunMap::operator= (RowRunMap&& that)
+{
+  if (this != &that) {
+    itsStarts  = std::move (that.itsStarts);
+    itsOffsets = std::move (that.itsOffsets);
+    that.itsStarts.clear();
+    that.itsOffsets.assign (1, 0);
+    itsLastRun = 0;
+  }
+  return *this;
+}
+
+rownr_t RowRunMap::countRuns (const rownr_t* rownrs, rownr_t nrow)
+{
+  if (nrow == 0) {
+    return 0;
+  }
+  rownr_t nrun = 1;
+  for (rownr_t i=1; i<nrow; ++i) {
+    if (rownrs[i] != rownrs[i-1] + 1) {
+      nrun++;
+    }
+  }
+  return nrun;
+}
+
+void RowRunMap::addRange (rownr_t start, rownr_t end)
+{
+  rownr_t n = end - start + 1;
+  if (!itsStarts.empty()  &&
+      itsStarts.back() + (itsOffsets.back() - itsOffsets[nrun()-1]) == start) {
+    itsOffsets.back() += n;
+  } else {
+    itsStarts.push_back (start);
+    itsOffsets.push_back (itsOffsets.back() + n);
+  }
+}
+
+void RowRunMap::resize (rownr_t nrow)
+{
+  if (nrow > this->nrow()) {
+    throw TableError ("RowRunMap::resize: " + String::toString(nrow) +
+                      " exceeds current nrow " +
+                      String::toString(this->nrow()));
+  }
+  if (nrow == 0) {
+    clear();
+  } else {
+    size_t run = findRun (nrow-1);
+    itsStarts.resize (run+1);
+    itsOffsets.resize (run+2);
+    itsOffsets.back() = nrow;
+  }
+}
+
+void RowRunMap::clear()
+{
+  itsStarts.clear();
+  itsOffsets.resize (1);
+}
+
+size_t RowRunMap::findRun (rownr_t rownr) const
+{
+  if (rownr >= nrow()) {
+    throw TableError ("RowRunMap: row number " + String::toString(rownr) +
+                      " exceeds nrow " + String::toString(nrow()));
+  }
+  return std::upper_bound (itsOffsets.begin(), itsOffsets.end(), rownr) -
+    itsOffsets.begin() - 1;
+}
+
+void RowRunMap::map (rownr_t nrow, const rownr_t* rownrs,
+                     rownr_t* result) const
+{
+  if (nrow == 0) {
+    return;
+  }
+  // Keep the current run, because the rows are usually in order.
+  size_t run = findRun (rownrs[0]);
+  for (rownr_t i=0; i<nrow; ++i) {
+    rownr_t row = rownrs[i];
+    if (row < itsOffsets[run]  ||  row >= itsOffsets[run+1]) {
+      run = findRun (row);
+    }
+    result[i] = itsStarts[run] + row - itsOffsets[run];
+  }
+}
+
+RowRunMap RowRunMap::map (const RowRunMap& rownrs) const
+{
+  RowRunMap result;
+  for (size_t i=0; i<rownrs.nrun(); ++i) {
+    rownr_t st  = rownrs.runStart(i);
+    rownr_t end = st + rownrs.runLength(i) - 1;
+    findRun (end);                    // check if end is in range
+    size_t run = findRun (st);
+    while (st <= end) {
+      rownr_t runEnd = std::min (end, itsOffsets[run+1] - 1);
+      result.addRange (itsStarts[run] + st - itsOffsets[run],
+                       itsStarts[run] + runEnd - itsOffsets[run]);
+      st = runEnd + 1;
+      run++;
+    }
+  }
+  return result;
+}
+
+Vector<rownr_t> RowRunMap::rowNumbers() const
+{
+  Vector<rownr_t> rownrs(nrow());
+  rownr_t* rows = rownrs.data();
+  for (size_t i=0; i<nrun(); ++i) {
+    std::iota (rows + itsOffsets[i], rows + itsOffsets[i+1], itsStarts[i]);
+  }
+  return rownrs;
+}
+
+RefRows RowRunMap::refRows() const
+{
+  if (empty()) {
+    return RefRows (Vector<rownr_t>());
+  }
+  Vector<rownr_t> slices(3*nrun());
+  for (size_t i=0; i<nrun(); ++i) {
+    slices[3*i]   = itsStarts[i];
+    slices[3*i+1] = itsStarts[i] + runLength(i) - 1;
+    slices[3*i+2] = 1;
+  }
+  return RefRows (slices, True);
+}
+
+RefRows RowRunMap::convert (const RefRows& rownrs) const
+{
+  std::vector<rownr_t> slices;
+  RefRowsSliceIter iter(rownrs);
+  while (! iter.pastEnd()) {
+    rownr_t st   = iter.sliceStart();
+    rownr_t end  = iter.sliceEnd();
+    rownr_t incr = iter.sliceIncr();
+    if (incr == 1) {
+      // Split the slice at the run boundaries.
+      findRun (end);                  // check if end is in range
+      size_t run = findRun (st);
+      while (st <= end) {
+        rownr_t runEnd = std::min (end, itsOffsets[run+1] - 1);
+        appendSlice (slices, itsStarts[run] + st - itsOffsets[run],
+                     itsStarts[run] + runEnd - itsOffsets[run]);
+        st = runEnd + 1;
+        run++;
+      }
+    } else {
+      for (rownr_t row=st; row<=end; row+=incr) {
+        rownr_t rootRow = (*this)[row];
+        appendSlice (slices, rootRow, rootRow);
+      }
+    }
+    iter++;
+  }
+  if (slices.empty()) {
+    return RefRows (Vector<rownr_t>());
+  }
+  return RefRows (Vector<rownr_t>(slices), True);
+}
+
+Bool RowRunMap::isAscending() const
+{
+  for (size_t i=1; i<nrun(); ++i) {
+    if (itsStarts[i] < itsStarts[i-1] + runLength(i-1)) {
+      return False;
+    }
+  }
+  return True;
+}
+
+
+} //# NAMESPACE CASACORE - END
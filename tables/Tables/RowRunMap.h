@@ -0,0 +1,198 @@
+//# RowRunMap.h: Run-length encoded mapping of row numbers
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_ROWRUNMAP_H
+#define TABLES_ROWRUNMAP_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <atomic>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class RefRows;
+
+
+// <summary>
+// Run-length encoded mapping of row numbers
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tRowRunMap">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=RefTable>RefTable</linkto>
+//   <li> <linkto class=RefRows>RefRows</linkto>
+// </prerequisite>
+
+// <synopsis>
+// RowRunMap maps row numbers 0..nrow-1 (e.g., of a RefTable) to row
+// numbers in another table (e.g., the root table). Instead of storing
+// the mapped row number of each row, it stores runs of contiguous
+// row numbers. Each run is defined by its first mapped row number and
+// the (cumulative) number of rows. Thus a selection consisting of a few
+// long runs of rows takes hardly any memory.
+// <p>
+// Mapping a row number requires a binary search on the runs, so it is
+// somewhat slower than indexing a vector of row numbers. The run found
+// last is remembered, so mapping rows in sequential order mostly does not
+// need a search. Furthermore, a
+// <linkto class=RefRows>RefRows</linkto> object can be converted as
+// a whole, resulting in a slice per run, so storage managers can read
+// the runs sequentially.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   RowRunMap runs;
+//   runs.addRange (100, 199);
+//   runs.addRange (300, 349);
+//   // Row 120 is mapped to 320.
+//   AlwaysAssert (runs[120] == 320, AipsError);
+// </srcblock>
+// </example>
+
+// <motivation>
+// A RefTable for a selection of 100M rows needed 800 MB for its row
+// numbers, even though a selection usually consists of long runs.
+// </motivation>
+
+class RowRunMap
+{
+public:
+    // Construct an empty map.
+    RowRunMap();
+
+    // Construct from a vector of row numbers (in any order).
+    explicit RowRunMap (const Vector<rownr_t>& rownrs);
+
+    // Construct from a RefRows object. Each slice with increment 1
+    // results in a single run.
+    explicit RowRunMap (const RefRows& rownrs);
+
+    // Copy and move constructor and assignment.
+    // <group>
+    RowRunMap (const RowRunMap& that);
+    RowRunMap (RowRunMap&& that);
+    RowRunMap& operator= (const RowRunMap& that);
+    RowRunMap& operator= (RowRunMap&& that);
+    // </group>
+
+    // Count the number of runs in the given row numbers.
+    static rownr_t countRuns (const rownr_t* rownrs, rownr_t nrow);
+
+    // Get the number of rows mapped.
+    rownr_t nrow() const
+      { return itsOffsets.back(); }
+
+    // Get the number of runs.
+    size_t nrun() const
+      { return itsStarts.size(); }
+
+    // Get the first mapped row number of a run.
+    rownr_t runStart (size_t run) const
+      { return itsStarts[run]; }
+
+    // Get the number of rows in a run.
+    rownr_t runLength (size_t run) const
+      { return itsOffsets[run+1] - itsOffsets[run]; }
+
+    // Is the map empty?
+    Bool empty() const
+      { return itsStarts.empty(); }
+
+    // Add a row number at the end. It extends the last run if possible.
+    void addRow (rownr_t rownr)
+      { addRange (rownr, rownr); }
+
+    // Add the range of row numbers start..end at the end.
+    // It extends the last run if possible.
+    void addRange (rownr_t start, rownr_t end);
+
+    // Reduce the number of rows to the given value.
+    // An exception is thrown if larger than the current number of rows.
+    void resize (rownr_t nrow);
+
+    // Remove all rows.
+    void clear();
+
+    // Map a row number.
+    rownr_t operator[] (rownr_t rownr) const
+      { size_t run = itsLastRun.load (std::memory_order_relaxed);
+        if (run >= itsStarts.size()  ||  rownr < itsOffsets[run]  ||
+            rownr >= itsOffsets[run+1]) {
+          run = findRun (rownr);
+          itsLastRun.store (run, std::memory_order_relaxed);
+        }
+        return itsStarts[run] + rownr - itsOffsets[run]; }
+
+    // Map the given row numbers and store them in <src>result</src>.
+    // The input and output buffers can be the same.
+    void map (rownr_t nrow, const rownr_t* rownrs, rownr_t* result) const;
+
+    // Map the rows in another map, which gives the runs of the rows
+    // <src>rownrs</src> is mapped to by this object.
+    RowRunMap map (const RowRunMap& rownrs) const;
+
+    // Get all mapped row numbers as a vector.
+    Vector<rownr_t> rowNumbers() const;
+
+    // Get all mapped row numbers as a RefRows object containing a slice
+    // per run.
+    RefRows refRows() const;
+
+    // Map the rows in the RefRows object to a RefRows object where each
+    // run of contiguous mapped rows is a slice.
+    RefRows convert (const RefRows& rownrs) const;
+
+    // Are the mapped row numbers in strictly ascending order?
+    Bool isAscending() const;
+
+private:
+    // Find the run containing the given row.
+    // An exception is thrown if the row number is out of range.
+    size_t findRun (rownr_t rownr) const;
+
+    //# Data members.
+    //# The first mapped row number of each run.
+    std::vector<rownr_t> itsStarts;
+    //# The first row of each run followed by the total number of rows
+    //# (thus it has nrun+1 elements).
+    std::vector<rownr_t> itsOffsets;
+    //# The run found last by operator[] (atomic, because a map can be
+    //# used by multiple threads).
+    mutable std::atomic<size_t> itsLastRun;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
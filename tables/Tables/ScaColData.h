@@ -121,6 +121,12 @@ public:
     virtual void getScalarColumnCells (const RefRows& rownrs,
                                        ArrayBase& dataPtr) const;
 
+    // Get the ranges of rows that can contain values in the given value
+    // ranges (see DataManagerColumn::getZoneRanges).
+    virtual Bool getZoneRanges (const Vector<Double>& lower,
+                                const Vector<Double>& upper,
+                                std::vector<std::pair<rownr_t,rownr_t>>& rowRanges) const;
+
     // Put the value in a particular cell.
     // The length of the buffer pointed to by dataPtr must match
     // the actual length. This is checked by ScalarColumn.
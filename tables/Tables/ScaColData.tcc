@@ -101,7 +101,10 @@ void ScalarColumnData<T>::get (rownr_t rownr, void* val) const
       TableTrace::trace (traceId(), columnDesc().name(), 'r', rownr);
     }
     checkReadLock (True);
-    dataColPtr_p->get (rownr, static_cast<T*>(val));
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ, 1, 1);
+      dataColPtr_p->get (rownr, static_cast<T*>(val));
+    }
     autoReleaseLock();
 }
 
@@ -116,8 +119,23 @@ void ScalarColumnData<T>::getScalarColumn (ArrayBase& val) const
 	throw (TableArrayConformanceError("ScalarColumnData::getScalarColumn"));
     }
     checkReadLock (True);
-    dataColPtr_p->getScalarColumnV (val);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ,
+                                val.nelements(), val.nelements());
+      dataColPtr_p->getScalarColumnV (val);
+    }
+    autoReleaseLock();
+}
+
+template<class T>
+Bool ScalarColumnData<T>::getZoneRanges
+(const Vector<Double>& lower, const Vector<Double>& upper,
+ std::vector<std::pair<rownr_t,rownr_t>>& rowRanges) const
+{
+    checkReadLock (True);
+    Bool done = dataColPtr_p->getZoneRanges (lower, upper, rowRanges);
     autoReleaseLock();
+    return done;
 }
 
 template<class T>
@@ -131,7 +149,11 @@ void ScalarColumnData<T>::getScalarColumnCells (const RefRows& rownrs,
 	throw (TableArrayConformanceError("ScalarColumnData::getScalarColumnCells"));
     }
     checkReadLock (True);
-    dataColPtr_p->getScalarColumnCellsV (rownrs, val);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::READ,
+                                val.nelements(), val.nelements());
+      dataColPtr_p->getScalarColumnCellsV (rownrs, val);
+    }
     autoReleaseLock();
 }
 
@@ -144,7 +166,11 @@ void ScalarColumnData<T>::put (rownr_t rownr, const void* val)
     }
     checkValueLength (static_cast<const T*>(val));
     checkWriteLock (True);
-    dataColPtr_p->put (rownr, static_cast<const T*>(val));
+    checkIndex (rownr);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE, 1, 1);
+      dataColPtr_p->put (rownr, static_cast<const T*>(val));
+    }
     autoReleaseLock();
 }
 
@@ -159,7 +185,12 @@ void ScalarColumnData<T>::putScalarColumn (const ArrayBase& val)
     }
     checkValueLength (static_cast<const Array<T>*>(&val));
     checkWriteLock (True);
-    dataColPtr_p->putScalarColumnV (val);
+    checkIndex (0);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE,
+                                val.nelements(), val.nelements());
+      dataColPtr_p->putScalarColumnV (val);
+    }
     autoReleaseLock();
 }
 
@@ -175,7 +206,12 @@ void ScalarColumnData<T>::putScalarColumnCells (const RefRows& rownrs,
     }
     checkValueLength (static_cast<const Array<T>*>(&val));
     checkWriteLock (True);
-    dataColPtr_p->putScalarColumnCellsV (rownrs, val);
+    checkIndex (rownrs);
+    {
+      TableMetrics::Timer timer(metrics_p, TableMetrics::WRITE,
+                                val.nelements(), val.nelements());
+      dataColPtr_p->putScalarColumnCellsV (rownrs, val);
+    }
     autoReleaseLock();
 }
 
@@ -561,6 +561,17 @@ Bool Table::hasDataChanged()
     return False;
 }
 
+uInt Table::getModifyCounter()
+{
+    if (! hasLock (FileLocker::Read)) {
+	if (! lock (FileLocker::Read, 1)) {
+	    return 0;
+	}
+	unlock();
+    }
+    return baseTabPtr_p->getModifyCounter();
+}
+
 uInt Table::nAutoLocks()
 {
   return PlainTable::tableCache().nAutoLocks();
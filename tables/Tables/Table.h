@@ -163,6 +163,7 @@ friend class RefTable;
 friend class ConcatTable;
 friend class TableIterator;
 friend class RODataManAccessor;
+friend class ColumnIndexFile;
 friend class TableExprNode;
 friend class TableExprNodeRep;
 
@@ -463,6 +464,20 @@ public:
     // (or is being changed) since the last time this function was called.
     Bool hasDataChanged();
 
+    // Get the counter telling how often the table data have been changed.
+    // It is kept in the lock file, so it can be used by other processes
+    // to determine if the table has changed since a given moment.
+    // A read lock is acquired (without waiting) to get the latest value.
+    // It returns 0 if no lock could be acquired (thus if another process
+    // is writing the table) or if no change has been registered.
+    uInt getModifyCounter();
+
+    // Get the counter telling how often rows can have been removed.
+    // It is incremented when rows are removed and when the table has been
+    // synchronized with changes made by another process. So if unchanged,
+    // a larger number of rows means that rows have only been added.
+    uInt64 getRowRemoveCounter() const;
+
     // Flush the table, i.e. write out the buffers. If <src>sync=True</src>,
     // it is ensured that all data are physically written to disk.
     // Nothing will be done if the table is not writable.
@@ -836,6 +851,10 @@ public:
     // the standard compare function defined in Compare.h will be used.
     // Default sort order is ascending.
     // Default sorting algorithm is the parallel sort.
+    // <br>If the data of the sort keys do not fit in the memory budget
+    // given by the aipsrc variable <src>table.sort.memory</src> (in MB),
+    // an external merge sort is done using scratch files (see class
+    // <linkto class=TableExternalSort>TableExternalSort</linkto>).
     // <group>
     // Sort on one column.
     Table sort (const String& columnName,
@@ -1184,6 +1203,8 @@ inline void Table::unmarkForDelete()
 inline Bool Table::isMarkedForDelete() const
     { return baseTabPtr_p->isMarkedForDelete(); }
 
+inline uInt64 Table::getRowRemoveCounter() const
+    { return baseTabPtr_p->getRowRemoveCounter(); }
 inline rownr_t Table::nrow() const
     { return baseTabPtr_p->nrow(); }
 inline BaseTable* Table::baseTablePtr() const
@@ -0,0 +1,74 @@
+//# TableAppender.cc: Append blocks of rows to a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/tables/Tables/TableAppender.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/BasicSL/String.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TableAppender::TableAppender (const Table& table)
+: itsTable    (table),
+  itsFirstRow (table.nrow()),
+  itsNrow     (0)
+{
+  if (! itsTable.isWritable()) {
+    throw TableError ("TableAppender: table " + itsTable.tableName() +
+                      " is not writable");
+  }
+}
+
+rownr_t TableAppender::addRows (rownr_t nrow)
+{
+  itsFirstRow = itsTable.nrow();
+  itsTable.addRow (nrow, False);
+  itsNrow = nrow;
+  return itsFirstRow;
+}
+
+TableColumn& TableAppender::getColumn (const String& column)
+{
+  auto iter = itsColumns.find (column);
+  if (iter == itsColumns.end()) {
+    iter = itsColumns.insert (std::make_pair (column,
+                                              TableColumn(itsTable, column))).first;
+  }
+  return iter->second;
+}
+
+void TableAppender::checkNrow (const String& column, rownr_t nrow) const
+{
+  if (nrow != itsNrow) {
+    throw TableConformanceError ("TableAppender: " + String::toString(nrow) +
+                                 " values given for column " + column +
+                                 ", but the block has " +
+                                 String::toString(itsNrow) + " rows");
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,160 @@
+//# TableAppender.h: Append blocks of rows to a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TABLEAPPENDER_H
+#define TABLES_TABLEAPPENDER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <map>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Append blocks of rows to a table writing a column per call
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tTableAppender">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=ScalarColumn>ScalarColumn</linkto>
+//   <li> <linkto class=ArrayColumn>ArrayColumn</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TableAppender adds a block of rows to the end of a table, after which
+// the data of the block are written column by column, each column in a
+// single call. The data of a scalar column are given as a Vector with
+// a value per row. The data of an array column are given as an Array
+// with the rows as the last axis, thus all cells in the block get the
+// same shape.
+// <br>Writing a column of a block results in a single call to the data
+// manager (using <src>putColumnRange</src>). StandardStMan copies the
+// values per data bucket and the tiled storage managers per tile,
+// which is much faster than writing the rows one by one. It makes it
+// suitable for the high data rates of, for instance, a correlator
+// writing a MeasurementSet.
+// <p>
+// The rows added are not initialized, so all columns should be written.
+// The column objects are kept, so it is cheap to write many blocks.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   MeasurementSet ms("my.ms", Table::Update);
+//   TableAppender appender(ms);
+//   for (each time slot) {
+//     appender.addRows (nbaseline);
+//     appender.putScalar ("TIME", Vector<Double>(nbaseline, time));
+//     appender.putScalar ("ANTENNA1", ant1);
+//     appender.putArray ("DATA", data);     // shape [ncorr,nchan,nbaseline]
+//     ...
+//   }
+// </srcblock>
+// </example>
+
+// <motivation>
+// Writing a MeasurementSet row by row, a cell per call, is dominated by
+// the overhead of the calls through the various table layers.
+// </motivation>
+
+class TableAppender
+{
+public:
+    // Construct the appender for the given table.
+    // An exception is thrown if the table is not writable.
+    explicit TableAppender (const Table& table);
+
+    // Add a block of rows at the end of the table.
+    // Thereafter the columns of the block can be written.
+    // It returns the row number of the first row added.
+    rownr_t addRows (rownr_t nrow);
+
+    // Get the row number of the first row of the last block added.
+    rownr_t firstRow() const
+      { return itsFirstRow; }
+
+    // Get the number of rows in the last block added.
+    rownr_t nrow() const
+      { return itsNrow; }
+
+    // Get the table.
+    const Table& table() const
+      { return itsTable; }
+
+    // Put the values of a scalar column in the rows of the block.
+    // The vector length must be the number of rows in the block.
+    template<typename T>
+    void putScalar (const String& column, const Vector<T>& values);
+
+    // Put the arrays of an array column in the rows of the block.
+    // The last axis of the array is the row axis, which must have the
+    // number of rows in the block.
+    template<typename T>
+    void putArray (const String& column, const Array<T>& values);
+
+    // Put the same value in the scalar column for all rows of the block.
+    template<typename T>
+    void fillScalar (const String& column, const T& value);
+
+    // Put the same array in the array column for all rows of the block.
+    template<typename T>
+    void fillArray (const String& column, const Array<T>& value);
+
+private:
+    // Get the (cached) column object for the given column.
+    TableColumn& getColumn (const String& column);
+
+    // Get the row range of the block.
+    Slicer rowRange() const
+      { return Slicer (IPosition(1, itsFirstRow), IPosition(1, itsNrow)); }
+
+    // Check if the number of values matches the number of rows.
+    void checkNrow (const String& column, rownr_t nrow) const;
+
+    //# Data members.
+    Table   itsTable;
+    rownr_t itsFirstRow;
+    rownr_t itsNrow;
+    std::map<String, TableColumn> itsColumns;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#ifndef CASACORE_NO_AUTO_TEMPLATES
+#include <casacore/tables/Tables/TableAppender.tcc>
+#endif //# CASACORE_NO_AUTO_TEMPLATES
+#endif
@@ -0,0 +1,80 @@
+//# TableAppender.tcc: Append blocks of rows to a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TABLEAPPENDER_TCC
+#define TABLES_TABLEAPPENDER_TCC
+
+#include <casacore/tables/Tables/TableAppender.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+template<typename T>
+void TableAppender::putScalar (const String& column, const Vector<T>& values)
+{
+  checkNrow (column, values.size());
+  ScalarColumn<T> col(getColumn (column));
+  col.putColumnRange (rowRange(), values);
+}
+
+template<typename T>
+void TableAppender::putArray (const String& column, const Array<T>& values)
+{
+  checkNrow (column, values.ndim() == 0  ?  0 : values.shape().last());
+  ArrayColumn<T> col(getColumn (column));
+  col.putColumnRange (rowRange(), values);
+}
+
+template<typename T>
+void TableAppender::fillScalar (const String& column, const T& value)
+{
+  putScalar (column, Vector<T>(itsNrow, value));
+}
+
+template<typename T>
+void TableAppender::fillArray (const String& column, const Array<T>& value)
+{
+  // Replicate the array for each row.
+  IPosition shape = value.shape();
+  shape.append (IPosition(1, itsNrow));
+  Array<T> block(shape);
+  size_t n = value.size();
+  Bool deleteIt;
+  const T* src = value.getStorage (deleteIt);
+  T* dst = block.data();
+  for (rownr_t i=0; i<itsNrow; ++i) {
+    std::copy (src, src+n, dst + i*n);
+  }
+  value.freeStorage (src, deleteIt);
+  putArray (column, block);
+}
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
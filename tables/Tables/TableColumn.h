@@ -233,6 +233,16 @@ public:
     IPosition tileShape (rownr_t rownr) const
 	{ TABLECOLUMNCHECKROW(rownr); return baseColPtr_p->tileShape (rownr); }
 
+    // Get the ranges of rows (inclusive and in ascending order) that can
+    // contain values in one of the given value ranges (inclusive).
+    // It uses the minimum and maximum per block of rows kept by the storage
+    // manager of a scalar column (e.g., StandardStMan); it returns False if
+    // the storage manager cannot do it.
+    Bool getZoneRanges (const Vector<Double>& lower,
+                        const Vector<Double>& upper,
+                        std::vector<std::pair<rownr_t,rownr_t>>& rowRanges) const
+	{ return baseColPtr_p->getZoneRanges (lower, upper, rowRanges); }
+
     // Get the value of a scalar in the given row.
     // Data type promotion is possible.
     // These functions only work for the standard data types.
@@ -30,6 +30,8 @@
 #include <casacore/tables/Tables/TableRow.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/TableLocker.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/tables/DataMan/DataManager.h>
@@ -37,12 +39,259 @@
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Utilities/LinearSearch.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/OS/Path.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// The number of threads set explicitly; -1 means that the aipsrc value is used.
+static std::atomic<Int> theirNThreads(-1);
+
+namespace {
+
+  // The approximate number of bytes copied per chunk of a column.
+  const uInt64 theirChunkBytes = 4*1024*1024;
+
+  // Copy a scalar column in chunks of rows.
+  template<typename T>
+  void copyScalarChunks (const TableColumn& incol, TableColumn& outcol,
+                         rownr_t startout, rownr_t startin, rownr_t nrrow)
+  {
+    ScalarColumn<T> in(incol);
+    ScalarColumn<T> out(outcol);
+    rownr_t chunk = std::max (rownr_t(1), rownr_t(theirChunkBytes / sizeof(T)));
+    Vector<T> buf;
+    for (rownr_t done=0; done<nrrow; done+=chunk) {
+      rownr_t n = std::min (chunk, nrrow-done);
+      in.getColumnRange (Slicer(IPosition(1, startin+done), IPosition(1, n)),
+                         buf, True);
+      out.putColumnRange (Slicer(IPosition(1, startout+done), IPosition(1, n)),
+                          buf);
+    }
+  }
+
+  // Copy an array column in chunks of rows.
+  // A chunk is copied as a whole if all its cells have the same shape,
+  // otherwise cell by cell (skipping undefined cells).
+  template<typename T>
+  void copyArrayChunks (const TableColumn& incol, TableColumn& outcol,
+                        rownr_t startout, rownr_t startin, rownr_t nrrow)
+  {
+    ArrayColumn<T> in(incol);
+    ArrayColumn<T> out(outcol);
+    Bool fixedShape = in.columnDesc().isFixedShape();
+    Array<T> buf;
+    rownr_t done = 0;
+    while (done < nrrow) {
+      // Determine the chunk size from the shape of its first cell.
+      rownr_t row = startin + done;
+      rownr_t chunk = 1;
+      Bool sameShape = in.isDefined (row);
+      IPosition shape;
+      if (sameShape) {
+        shape = in.shape (row);
+        uInt64 nbytes = std::max (uInt64(1), uInt64(shape.product() * sizeof(T)));
+        chunk = std::max (rownr_t(1), rownr_t(theirChunkBytes / nbytes));
+      }
+      rownr_t n = std::min (chunk, nrrow-done);
+      for (rownr_t i=1; i<n && sameShape && !fixedShape; ++i) {
+        sameShape = in.isDefined (row+i)  &&  in.shape(row+i).isEqual (shape);
+      }
+      if (sameShape) {
+        in.getColumnRange (Slicer(IPosition(1, row), IPosition(1, n)),
+                           buf, True);
+        out.putColumnRange (Slicer(IPosition(1, startout+done),
+                                   IPosition(1, n)),
+                            buf);
+      } else {
+        for (rownr_t i=0; i<n; ++i) {
+          if (in.isDefined (row+i)) {
+            in.get (row+i, buf, True);
+            out.put (startout+done+i, buf);
+          }
+        }
+      }
+      done += n;
+    }
+  }
+
+  // Copy a scalar or array column in chunks.
+  template<typename T>
+  void copyChunks (const TableColumn& incol, TableColumn& outcol,
+                   rownr_t startout, rownr_t startin, rownr_t nrrow)
+  {
+    if (incol.columnDesc().isScalar()) {
+      copyScalarChunks<T> (incol, outcol, startout, startin, nrrow);
+    } else {
+      copyArrayChunks<T> (incol, outcol, startout, startin, nrrow);
+    }
+  }
+
+  // Can the column be copied in chunks?
+  // It requires the same data type and kind (scalar or array).
+  Bool canCopyChunks (const ColumnDesc& indesc, const ColumnDesc& outdesc)
+  {
+    if (indesc.dataType() != outdesc.dataType()  ||
+        indesc.isScalar() != outdesc.isScalar()  ||
+        indesc.isArray() != outdesc.isArray()) {
+      return False;
+    }
+    switch (indesc.dataType()) {
+    case TpBool:
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+    case TpComplex:
+    case TpDComplex:
+    case TpString:
+      return True;
+    default:
+      return False;
+    }
+  }
+
+  // Copy a column in chunks of rows.
+  void copyColumnChunks (const TableColumn& incol, TableColumn& outcol,
+                         rownr_t startout, rownr_t startin, rownr_t nrrow)
+  {
+    switch (incol.columnDesc().dataType()) {
+    case TpBool:
+      copyChunks<Bool> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpUChar:
+      copyChunks<uChar> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpShort:
+      copyChunks<Short> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpUShort:
+      copyChunks<uShort> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpInt:
+      copyChunks<Int> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpUInt:
+      copyChunks<uInt> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpInt64:
+      copyChunks<Int64> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpFloat:
+      copyChunks<Float> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpDouble:
+      copyChunks<Double> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpComplex:
+      copyChunks<Complex> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpDComplex:
+      copyChunks<DComplex> (incol, outcol, startout, startin, nrrow);
+      break;
+    case TpString:
+      copyChunks<String> (incol, outcol, startout, startin, nrrow);
+      break;
+    default:
+      throw TableError ("TableCopy: cannot copy column " +
+                        incol.columnDesc().name() + " in chunks");
+    }
+  }
+
+  // Is the data manager one of the storage managers that can be used
+  // by one thread while other instances are used by other threads?
+  Bool isThreadSafeStMan (DataManager* dm)
+  {
+    if (!dm  ||  dm->multiFile()) {
+      return False;
+    }
+    const String type = dm->dataManagerType();
+    return (type == "StandardStMan"     ||  type == "IncrementalStMan"  ||
+            type == "TiledShapeStMan"   ||  type == "TiledColumnStMan"  ||
+            type == "TiledCellStMan"    ||  type == "TiledDataStMan"    ||
+            type == "StManAipsIO"       ||  type == "MemoryStMan");
+  }
+
+  // Can the columns of the tables be copied in parallel?
+  // Auto-releasing a lock is not thread-safe, so AutoLocking cannot be
+  // used. The data managers of a ConcatTable cannot be determined.
+  Bool canCopyParallel (const Table& out, const Table& in)
+  {
+    return (out.lockOptions().option() != TableLock::AutoLocking  &&
+            in.lockOptions().option() != TableLock::AutoLocking  &&
+            out.getPartNames(True).size() == 1  &&
+            in.getPartNames(True).size() == 1);
+  }
+
+  // Partition the columns in groups, where columns sharing an input or
+  // output data manager are in the same group.
+  // Columns that cannot be copied in parallel are put in
+  // <src>serialCols</src>.
+  std::vector<std::vector<uInt>> groupColumns
+  (const Table& out, const Table& in, const Vector<String>& cols,
+   std::vector<uInt>& serialCols)
+  {
+    std::vector<std::vector<uInt>> groups;
+    std::map<DataManager*, size_t> dmGroup;
+    for (uInt i=0; i<cols.size(); ++i) {
+      DataManager* indm  = in.findDataManager (cols[i], True);
+      DataManager* outdm = out.findDataManager (cols[i], True);
+      if (! (isThreadSafeStMan(indm)  &&  isThreadSafeStMan(outdm))) {
+        serialCols.push_back (i);
+        continue;
+      }
+      auto initer  = dmGroup.find (indm);
+      auto outiter = dmGroup.find (outdm);
+      size_t grp;
+      if (initer == dmGroup.end()  &&  outiter == dmGroup.end()) {
+        grp = groups.size();
+        groups.resize (grp+1);
+      } else if (outiter == dmGroup.end()) {
+        grp = initer->second;
+      } else {
+        grp = outiter->second;
+        if (initer != dmGroup.end()  &&  initer->second != grp) {
+          // The column links two groups, so merge them.
+          size_t old = initer->second;
+          groups[grp].insert (groups[grp].end(),
+                              groups[old].begin(), groups[old].end());
+          groups[old].clear();
+          for (auto& dg : dmGroup) {
+            if (dg.second == old) {
+              dg.second = grp;
+            }
+          }
+        }
+      }
+      groups[grp].push_back (i);
+      dmGroup[indm]  = grp;
+      dmGroup[outdm] = grp;
+    }
+    // Remove the groups emptied by a merge.
+    groups.erase (std::remove_if (groups.begin(), groups.end(),
+                                  [](const std::vector<uInt>& g)
+                                  { return g.empty(); }),
+                  groups.end());
+    return groups;
+  }
+
+}
+
+
 Table TableCopy::makeEmptyTable (const String& newName,
 				 const Record& dataManagerInfo,
 				 const Table& tab,
@@ -50,7 +299,8 @@ Table TableCopy::makeEmptyTable (const String& newName,
 				 Table::EndianFormat endianFormat,
 				 Bool replaceTSM,
 				 Bool noRows,
-                                 const StorageOption& stopt)
+                                 const StorageOption& stopt,
+                                 const TableLock& lockOptions)
 {
   TableDesc tabDesc = tab.actualTableDesc();
   Record dminfo (dataManagerInfo);
@@ -71,7 +321,8 @@ Table TableCopy::makeEmptyTable (const String& newName,
   dminfo = DataManInfo::adjustStMan (dminfo, "StandardStMan", True);
   SetupNewTable newtab (newName, tabDesc, option, stopt);
   newtab.bindCreate (dminfo);
-  return Table(newtab, (noRows ? 0 : tab.nrow()), False, endianFormat);
+  return Table(newtab, lockOptions, (noRows ? 0 : tab.nrow()), False,
+               endianFormat);
 }
 
 Table TableCopy::makeEmptyMemoryTable (const String& newName,
@@ -111,11 +362,32 @@ void TableCopy::copyRows (Table& out, const Table& in, rownr_t startout,
     if (startout + nrrow > out.nrow()) {
       out.addRow (startout + nrrow - out.nrow());
     }
-    ROTableRow inrow(in, cols);
-    outrow = TableRow(out, cols);
-    for (rownr_t i=0; i<nrrow; i++) {
-      inrow.get (startin + i);
-      outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
+    // Columns with equal data types are copied in chunks.
+    // The others (e.g. record columns or columns needing type promotion)
+    // are copied by means of a TableRow.
+    Vector<String> chunkCols(nrcol);
+    Vector<String> rowCols(nrcol);
+    uInt nrchunk = 0;
+    uInt nrrowcol = 0;
+    for (uInt i=0; i<nrcol; ++i) {
+      if (canCopyChunks (tdesc[cols[i]], out.tableDesc()[cols[i]])) {
+        chunkCols[nrchunk++] = cols[i];
+      } else {
+        rowCols[nrrowcol++] = cols[i];
+      }
+    }
+    chunkCols.resize (nrchunk, True);
+    rowCols.resize (nrrowcol, True);
+    if (nrchunk > 0  &&  nrrow > 0) {
+      copyChunkColumns (out, in, chunkCols, startout, startin, nrrow);
+    }
+    if (nrrowcol > 0) {
+      ROTableRow inrow(in, rowCols);
+      outrow = TableRow(out, rowCols);
+      for (rownr_t i=0; i<nrrow; i++) {
+        inrow.get (startin + i);
+        outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
+      }
     }
     if (flush) {
       out.flush();
@@ -123,6 +395,88 @@ void TableCopy::copyRows (Table& out, const Table& in, rownr_t startout,
   }
 }
 
+void TableCopy::copyChunkColumns (Table& out, const Table& in,
+                                  const Vector<String>& cols,
+                                  rownr_t startout, rownr_t startin,
+                                  rownr_t nrrow)
+{
+  // Create the column objects beforehand, so the threads do not need to
+  // access the table objects.
+  std::vector<TableColumn> incols;
+  std::vector<TableColumn> outcols;
+  for (const String& col : cols) {
+    incols.push_back (TableColumn(in, col));
+    outcols.push_back (TableColumn(out, col));
+  }
+  uInt nthr = nthreads();
+  if (nthr == 0) {
+    nthr = std::max (1u, std::thread::hardware_concurrency());
+  }
+  std::vector<uInt> serialCols;
+  std::vector<std::vector<uInt>> groups;
+  if (nthr > 1  &&  cols.size() > 1  &&  canCopyParallel (out, in)) {
+    groups = groupColumns (out, in, cols, serialCols);
+  } else {
+    for (uInt i=0; i<cols.size(); ++i) {
+      serialCols.push_back (i);
+    }
+  }
+  if (groups.size() > 1) {
+    // Acquire the locks, so the threads do not need to do it.
+    // Note that a TableLocker keeps the lock if already locked.
+    Table intab(in);
+    TableLocker inLocker (intab, FileLocker::Read);
+    TableLocker outLocker (out, FileLocker::Write);
+    // Let each thread copy the columns of its groups.
+    uInt nworker = std::min (nthr, uInt(groups.size()));
+    std::vector<std::future<void>> futures;
+    for (uInt w=0; w<nworker; ++w) {
+      futures.push_back (std::async (std::launch::async, [&, w]() {
+            for (size_t g=w; g<groups.size(); g+=nworker) {
+              for (uInt i : groups[g]) {
+                copyColumnChunks (incols[i], outcols[i],
+                                  startout, startin, nrrow);
+              }
+            }
+          }));
+    }
+    // Wait for all threads before rethrowing a possible exception.
+    for (auto& fut : futures) {
+      fut.wait();
+    }
+    for (auto& fut : futures) {
+      fut.get();
+    }
+  } else {
+    // Zero or one group, so copy those columns serially as well.
+    for (const auto& grp : groups) {
+      serialCols.insert (serialCols.end(), grp.begin(), grp.end());
+    }
+  }
+  for (uInt i : serialCols) {
+    copyColumnChunks (incols[i], outcols[i], startout, startin, nrrow);
+  }
+}
+
+uInt TableCopy::nthreads()
+{
+  Int nthr = theirNThreads;
+  if (nthr >= 0) {
+    return nthr;
+  }
+  static Int aipsrcNThreads = 0;
+  static std::once_flag onceFlag;
+  std::call_once (onceFlag, []() {
+      AipsrcValue<Int>::find (aipsrcNThreads, "table.copy.nthreads", 0);
+    });
+  return std::max (0, aipsrcNThreads);
+}
+
+void TableCopy::setNThreads (uInt nthreads)
+{
+  theirNThreads = nthreads;
+}
+
 void TableCopy::copyInfo (Table& out, const Table& in)
 {
   out.tableInfo() = in.tableInfo();
@@ -63,10 +63,29 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //       existing table.
 //  <li> <src>copyRows</src> copies the data of one to another table.
 //       It is possible to specify where to start in the input and output.
+//       The data are copied column by column in chunks of rows. Columns
+//       bound to different storage managers can be copied in parallel
+//       (see below).
 //  <li> <src>CopyInfo</src> copies the table info data.
 //  <li> <src>copySubTables</src> copies all the subtables in table and
 //       column keywords. It is done recursively.
 // </ol>
+// <p>
+// <src>copyRows</src> copies each column in chunks of rows using
+// <src>getColumnRange</src> and <src>putColumnRange</src>, provided the
+// data types of the input and output column are the same and the cells in
+// a chunk have the same shape. Otherwise the cells are copied one by one.
+// <br>The columns are copied in parallel if possible. Columns sharing an
+// input or output data manager are copied by the same thread, because a
+// data manager is not thread-safe. It is only done for the well-known
+// storage managers (thus not for virtual columns) and if neither table
+// uses AutoLocking (because auto-releasing a lock is not thread-safe),
+// so open the input table with UserLocking or NoLocking to copy in
+// parallel. Other columns are copied serially.
+// The maximum number of threads is defined by the aipsrc variable
+// <src>table.copy.nthreads</src>. The default 0 means the number of
+// cores. It can also be set using the static function
+// <src>setNThreads</src>.
 // </synopsis> 
 
 //# <todo asof="$DATE:$">
@@ -87,6 +106,7 @@ public:
   // <br>By default, the TiledDataStMan will be replaced by the TiledShapeStMan.
   // <br>By default, the new table has the same nr of rows as the input table.
   // If <src>noRows=True</src> is given, it does not contain any row.
+  // <br>The new table is opened with the given lock options.
   static Table makeEmptyTable (const String& newName,
 			       const Record& dataManagerInfo,
 			       const Table& tab,
@@ -94,7 +114,8 @@ public:
 			       Table::EndianFormat endianFormat,
 			       Bool replaceTSM = True,
 			       Bool noRows = False,
-                               const StorageOption& = StorageOption());
+                               const StorageOption& = StorageOption(),
+                               const TableLock& lockOptions = TableLock());
 
   // Make an (empty) memory table with the same layout as the input one.
   // It has the same keywords and columns as the input one.
@@ -112,6 +133,8 @@ public:
   // column with the same name in table <src>in</src>. In principle only
   // stored columns will be filled; however if the output table has only
   // one column, it can also be a virtual one.
+  // <br>The columns are copied in chunks of rows, possibly in parallel
+  // as explained in the synopsis.
   // <group>
   static void copyRows (Table& out, const Table& in, Bool flush=True)
     { copyRows (out, in, 0, 0, in.nrow(), flush); }
@@ -120,6 +143,17 @@ public:
                         Bool flush=True);
   // </group>
 
+  // Get the maximum number of threads used by <src>copyRows</src>.
+  // It is the value set by <src>setNThreads</src> or, if not set, the
+  // value of the aipsrc variable <src>table.copy.nthreads</src>.
+  // A value 0 means the number of cores.
+  static uInt nthreads();
+
+  // Set the maximum number of threads used by <src>copyRows</src>.
+  // 1 means copying serially; 0 means the number of cores.
+  // It overrides the value defined in the aipsrc variable.
+  static void setNThreads (uInt nthreads);
+
   // Copy the table info block from input to output table.
   static void copyInfo (Table& out, const Table& in);
 
@@ -224,6 +258,13 @@ public:
                       preserveTileShape); }
 
 private:
+  // Copy the given columns in chunks of rows, in parallel if possible.
+  // The columns must have the same data type in both tables.
+  static void copyChunkColumns (Table& out, const Table& in,
+                                const Vector<String>& columns,
+                                rownr_t startout, rownr_t startin,
+                                rownr_t nrrow);
+
   static void doCloneColumn (const Table& fromTable, const String& fromColumn,
                              Table& toTable, const ColumnDesc& newColumn,
                              const String& dataManagerName,
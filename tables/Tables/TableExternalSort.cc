@@ -0,0 +1,421 @@
+//# TableExternalSort.cc: Sort a table using a bounded amount of memory
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableExternalSort.h>
+#include <casacore/tables/Tables/BaseColumn.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/EnvVar.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <casacore/casa/Utilities/Sort.h>
+#include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// The budget set explicitly; -1 means that the aipsrc value is used.
+static std::atomic<Int64> theirMemoryBudget(-1);
+
+
+//# The keys of a chunk are read from the columns into data. The keys of
+//# a block of a run are read from the scratch file into values (or strings
+//# for a String key) in the sorted order of the rows.
+struct TableExternalSort::KeyBlock
+{
+  uInt                              runNr;
+  Vector<rownr_t>                   rownrs;   //# rows in sorted order
+  Block<std::shared_ptr<ArrayBase>> data;     //# key data of a chunk
+  std::vector<std::vector<char>>    values;   //# key data of a block
+  std::vector<std::vector<String>>  strings;  //# String key data of a block
+  std::vector<const char*>          ptrs;     //# pointer to key data
+  std::vector<uInt>                 incr;     //# size of a key value
+};
+
+//# A run is written in blocks of itsBlockSize rows. A block contains the
+//# row numbers followed by the values of each key. The values of a String
+//# key are stored as their lengths followed by their characters.
+struct TableExternalSort::Run
+{
+  std::unique_ptr<RegularFileIO>    file;
+  uInt                              runNr;
+  rownr_t                           nrow;     //# nr of rows in the run
+  rownr_t                           nread;    //# nr of rows read
+  std::shared_ptr<KeyBlock>         block;    //# current block
+  rownr_t                           index;    //# current row in block
+};
+
+
+TableExternalSort::TableExternalSort
+(const PtrBlock<BaseColumn*>& sortCol,
+ const Block<std::shared_ptr<BaseCompare>>& cmpObj,
+ const Block<Int>& order, int option, uInt64 memoryBudget)
+  : itsSortCol (sortCol),
+    itsCmpObj  (cmpObj),
+    itsOrder   (order),
+    itsOption  (option),
+    itsBudget  (memoryBudget),
+    itsRowSize (rowSize(sortCol)),
+    itsBlockSize (0),
+    itsTempDir (tempDirectory())
+{
+  for (uInt i=0; i<itsSortCol.size(); ++i) {
+    itsDataTypes.push_back (itsSortCol[i]->columnDesc().dataType());
+  }
+  // Determine the overall order the same way as Sort does.
+  for (uInt i=0; i<itsOrder.size(); ++i) {
+    if (itsOrder[i] != Sort::Descending) {
+      itsOrder[i] = Sort::Ascending;
+    }
+    if (i == 0) {
+      itsOverallOrder = itsOrder[i];
+    } else if (itsOverallOrder != itsOrder[i]) {
+      itsOverallOrder = 0;
+    }
+  }
+}
+
+TableExternalSort::~TableExternalSort()
+{}
+
+uInt64 TableExternalSort::rowSize (const PtrBlock<BaseColumn*>& sortCol)
+{
+  // Take the row number and index vector into account.
+  uInt64 size = 2 * sizeof(rownr_t);
+  for (uInt i=0; i<sortCol.size(); ++i) {
+    DataType dtype = sortCol[i]->columnDesc().dataType();
+    size += ValType::getTypeSize (dtype);
+    // Assume an average string length.
+    if (dtype == TpString) {
+      size += 16;
+    }
+  }
+  return size;
+}
+
+uInt64 TableExternalSort::memoryBudget()
+{
+  Int64 budget = theirMemoryBudget;
+  if (budget >= 0) {
+    return budget;
+  }
+  static Double budgetMB = -1;
+  static std::once_flag onceFlag;
+  std::call_once (onceFlag, []() {
+      AipsrcValue<Double>::find (budgetMB, "table.sort.memory", 0.);
+    });
+  return budgetMB <= 0  ?  0 : uInt64(budgetMB * 1024 * 1024);
+}
+
+void TableExternalSort::setMemoryBudget (uInt64 nbytes)
+{
+  theirMemoryBudget = nbytes;
+}
+
+String TableExternalSort::tempDirectory()
+{
+  String dir;
+  AipsrcValue<String>::find (dir, "table.sort.tmpdir", "");
+  if (dir.empty()) {
+    dir = EnvironmentVariable::get ("TMPDIR");
+    if (dir.empty()) {
+      dir = "/tmp";
+    }
+  }
+  return dir;
+}
+
+void TableExternalSort::readKeys (Sort& sortobj, const Vector<rownr_t>& rownrs,
+                                  KeyBlock& block)
+{
+  uInt nrkey = itsSortCol.size();
+  block.data.resize (nrkey);
+  block.ptrs.resize (nrkey);
+  block.incr.resize (nrkey);
+  for (uInt i=0; i<nrkey; ++i) {
+    itsSortCol[i]->makeRefSortKey (sortobj, itsCmpObj[i], itsOrder[i],
+                                   rownrs, block.data[i]);
+    // The key data are contiguous vectors, so no copy is made.
+    bool deleteIt;
+    const ArrayBase& arr = *block.data[i];
+    block.ptrs[i] = static_cast<const char*>(arr.getVStorage (deleteIt));
+    AlwaysAssert (!deleteIt, AipsError);
+    block.incr[i] = ValType::getTypeSize (itsDataTypes[i]);
+  }
+}
+
+int TableExternalSort::compare (const KeyBlock& b1, rownr_t i1,
+                                const KeyBlock& b2, rownr_t i2,
+                                size_t& idxComp) const
+{
+  for (size_t i=0; i<b1.ptrs.size(); ++i) {
+    int seq = itsCmpObj[i]->comp (b1.ptrs[i] + i1*b1.incr[i],
+                                  b2.ptrs[i] + i2*b2.incr[i]);
+    if (seq == itsOrder[i]) {
+      idxComp = i;
+      return 2;                       // in order
+    }
+    if (seq != 0) {
+      idxComp = i;
+      return 0;                       // out-of-order
+    }
+  }
+  // Equal keys, so use the run number to maintain stability
+  // (the runs contain consecutive chunks of rows).
+  if (b1.runNr < b2.runNr) {
+    return (itsOverallOrder == Sort::Descending  ?  -1 : 1);
+  }
+  return (itsOverallOrder == Sort::Descending  ?  1 : -1);
+}
+
+void TableExternalSort::sortChunk (Sort& sortobj,
+                                   const Vector<rownr_t>& rownrs,
+                                   const KeyBlock& keys)
+{
+  Vector<rownr_t> inx;
+  rownr_t nr = sortobj.sort (inx, rownrs.size(), itsOption);
+  std::unique_ptr<Run> run(new Run);
+  String name = File::newUniqueName (itsTempDir,
+                                     "tablesort_").absoluteName();
+  // A scratch file is deleted when closed.
+  run->file.reset (new RegularFileIO (RegularFile(name), ByteIO::Scratch));
+  // Write the row numbers and keys in sorted order in blocks.
+  std::vector<rownr_t> rbuf;
+  std::vector<char> kbuf;
+  std::vector<uInt> lbuf;
+  for (rownr_t st=0; st<nr; st+=itsBlockSize) {
+    rownr_t n = std::min (itsBlockSize, nr-st);
+    rbuf.resize (n);
+    for (rownr_t i=0; i<n; ++i) {
+      rbuf[i] = rownrs[inx[st+i]];
+    }
+    run->file->write (n * sizeof(rownr_t), rbuf.data());
+    for (size_t k=0; k<keys.ptrs.size(); ++k) {
+      if (itsDataTypes[k] == TpString) {
+        const String* strs = reinterpret_cast<const String*>(keys.ptrs[k]);
+        lbuf.resize (n);
+        for (rownr_t i=0; i<n; ++i) {
+          lbuf[i] = strs[inx[st+i]].size();
+        }
+        run->file->write (n * sizeof(uInt), lbuf.data());
+        for (rownr_t i=0; i<n; ++i) {
+          const String& str = strs[inx[st+i]];
+          if (! str.empty()) {
+            run->file->write (str.size(), str.data());
+          }
+        }
+      } else {
+        uInt sz = keys.incr[k];
+        kbuf.resize (n*sz);
+        for (rownr_t i=0; i<n; ++i) {
+          std::copy_n (keys.ptrs[k] + inx[st+i]*sz, sz, &kbuf[i*sz]);
+        }
+        run->file->write (kbuf.size(), kbuf.data());
+      }
+    }
+  }
+  run->file->seek (0);
+  run->runNr = itsRuns.size();
+  run->nrow  = nr;
+  run->nread = 0;
+  run->index = 0;
+  itsRuns.push_back (std::move(run));
+}
+
+void TableExternalSort::makeRuns (rownr_t nrrow, rownr_t chunkSize)
+{
+  struct Chunk {
+    Sort            sortobj;
+    Vector<rownr_t> rownrs;
+    KeyBlock        keys;
+  };
+  std::future<void> pending;
+  for (rownr_t st=0; st<nrrow; st+=chunkSize) {
+    std::shared_ptr<Chunk> chunk(new Chunk);
+    chunk->rownrs.resize (std::min(chunkSize, nrrow-st));
+    indgen (chunk->rownrs, st);
+    readKeys (chunk->sortobj, chunk->rownrs, chunk->keys);
+    // Sort the chunk while the next one is read.
+    // The runs are added in order, because the previous sort has finished.
+    if (pending.valid()) {
+      pending.get();
+    }
+    pending = std::async (std::launch::async, [this, chunk]() {
+        sortChunk (chunk->sortobj, chunk->rownrs, chunk->keys);
+      });
+  }
+  if (pending.valid()) {
+    pending.get();
+  }
+}
+
+Bool TableExternalSort::nextBlock (Run& run)
+{
+  rownr_t nr = std::min (itsBlockSize, run.nrow - run.nread);
+  if (nr == 0) {
+    return False;
+  }
+  // Make a new block, because the previous one might still be in use.
+  std::shared_ptr<KeyBlock> block(new KeyBlock);
+  block->runNr = run.runNr;
+  block->rownrs.resize (nr);
+  run.file->read (nr * sizeof(rownr_t), block->rownrs.data());
+  run.nread += nr;
+  size_t nrkey = itsDataTypes.size();
+  block->values.resize (nrkey);
+  block->strings.resize (nrkey);
+  block->ptrs.resize (nrkey);
+  block->incr.resize (nrkey);
+  std::vector<uInt> lbuf;
+  for (size_t k=0; k<nrkey; ++k) {
+    block->incr[k] = ValType::getTypeSize (itsDataTypes[k]);
+    if (itsDataTypes[k] == TpString) {
+      lbuf.resize (nr);
+      run.file->read (nr * sizeof(uInt), lbuf.data());
+      std::vector<String>& strs = block->strings[k];
+      strs.resize (nr);
+      for (rownr_t i=0; i<nr; ++i) {
+        if (lbuf[i] > 0) {
+          strs[i].resize (lbuf[i]);
+          run.file->read (lbuf[i], &(strs[i][0]));
+        }
+      }
+      block->ptrs[k] = reinterpret_cast<const char*>(strs.data());
+    } else {
+      std::vector<char>& vals = block->values[k];
+      vals.resize (nr * block->incr[k]);
+      run.file->read (vals.size(), vals.data());
+      block->ptrs[k] = vals.data();
+    }
+  }
+  run.block = block;
+  run.index = 0;
+  return True;
+}
+
+rownr_t TableExternalSort::sort (Vector<rownr_t>& rows, rownr_t nrrow,
+                                 Vector<rownr_t>* iterBoundaries,
+                                 Vector<size_t>* iterKeyIdxChange)
+{
+  itsRuns.clear();
+  if (nrrow == 0) {
+    rows.resize (0);
+    if (iterBoundaries  &&  iterKeyIdxChange) {
+      iterBoundaries->resize (0);
+      iterKeyIdxChange->resize (0);
+    }
+    return 0;
+  }
+  // The resulting row numbers are part of the budget.
+  uInt64 resultSize = nrrow * sizeof(rownr_t);
+  uInt64 budget = (itsBudget > resultSize  ?  itsBudget - resultSize : 0);
+  // A chunk being sorted and the next chunk being read must fit
+  // in the budget.
+  rownr_t chunkSize = std::max (rownr_t(1024), budget / (2*itsRowSize));
+  // Divide the budget over the runs to merge. The runs are written
+  // in blocks of that size.
+  rownr_t nrun = (nrrow + chunkSize - 1) / chunkSize;
+  itsBlockSize = std::max (rownr_t(64), budget / (nrun*itsRowSize));
+  makeRuns (nrrow, chunkSize);
+  for (auto& run : itsRuns) {
+    nextBlock (*run);
+  }
+  // Merge the runs using a heap (with the smallest on top).
+  size_t idxComp;
+  auto after = [this, &idxComp](const Run* r1, const Run* r2) {
+    int cmp = compare (*r1->block, r1->index, *r2->block, r2->index, idxComp);
+    return cmp != 2  &&  cmp != 1;
+  };
+  std::vector<Run*> heap;
+  for (auto& run : itsRuns) {
+    if (run->nrow > 0) {
+      heap.push_back (run.get());
+    }
+  }
+  std::make_heap (heap.begin(), heap.end(), after);
+  Bool noDup = (itsOption & Sort::NoDuplicates) != 0;
+  Bool doUnique = iterBoundaries != 0  &&  iterKeyIdxChange != 0;
+  std::vector<rownr_t> uniq;
+  std::vector<size_t> change;
+  rows.resize (nrrow);
+  rownr_t nr = 0;
+  // Keep the previous record (and its block) for the duplicate check.
+  std::shared_ptr<KeyBlock> prevBlock;
+  rownr_t prevIndex = 0;
+  while (! heap.empty()) {
+    std::pop_heap (heap.begin(), heap.end(), after);
+    Run* run = heap.back();
+    Bool skip = False;
+    if (prevBlock) {
+      int cmp = compare (*prevBlock, prevIndex, *run->block, run->index,
+                         idxComp);
+      Bool equal = (cmp == 1  ||  cmp == -1);
+      if (equal) {
+        skip = noDup;
+      } else if (doUnique) {
+        change.push_back (idxComp);
+        uniq.push_back (nr);
+      }
+    } else if (doUnique) {
+      uniq.push_back (0);
+    }
+    if (! skip) {
+      rows[nr++] = run->block->rownrs[run->index];
+      prevBlock = run->block;
+      prevIndex = run->index;
+    }
+    // Advance in the run.
+    if (++run->index < run->block->rownrs.size()  ||
+        nextBlock (*run)) {
+      std::push_heap (heap.begin(), heap.end(), after);
+    } else {
+      heap.pop_back();
+    }
+  }
+  itsRuns.clear();
+  if (nr < nrrow) {
+    rows.resize (nr, True);
+  }
+  if (doUnique) {
+    // The key change of the last group is undefined; use 0.
+    change.push_back (0);
+    iterBoundaries->resize (uniq.size());
+    iterKeyIdxChange->resize (change.size());
+    std::copy (uniq.begin(), uniq.end(), iterBoundaries->begin());
+    std::copy (change.begin(), change.end(), iterKeyIdxChange->begin());
+  }
+  return nr;
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,180 @@
+//# TableExternalSort.h: Sort a table using a bounded amount of memory
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TABLEEXTERNALSORT_H
+#define TABLES_TABLEEXTERNALSORT_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Utilities/Compare.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <memory>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class BaseColumn;
+class Sort;
+
+
+// <summary>
+// Sort a table using a bounded amount of memory
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tTableExternalSort">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=Sort>Sort</linkto>
+//   <li> <linkto class=BaseTable>BaseTable</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A normal table sort reads the data of all sort keys into memory and
+// sorts the row numbers using class <linkto class=Sort>Sort</linkto>.
+// For a large table (e.g., a MeasurementSet sorted by MSIter on
+// ARRAY_ID, FIELD_ID, DATA_DESC_ID and TIME) the key data might not fit
+// in memory. In that case BaseTable::doSort uses this class, which does
+// an external merge sort:
+// <ol>
+//  <li> The rows are divided in chunks that fit in half of the memory
+//       budget. The keys of a chunk are read and sorted (using ParSort,
+//       thus in parallel), while the keys of the next chunk are read.
+//       The sorted row numbers and keys of each chunk (a run) are written
+//       in blocks into a scratch file in the temporary directory.
+//  <li> The runs are merged using a heap. The row numbers and keys of
+//       each run are read back a block at a time, so the columns are
+//       not accessed again.
+// </ol>
+// The merge takes the first run for equal keys, so the result is the same
+// as that of an in-memory sort (except for the row kept for equal keys if
+// Sort::NoDuplicates is used with a non-stable algorithm like QuickSort).
+// The memory used is approximately the budget, which includes the
+// resulting row number vector (8 bytes per row).
+// <p>
+// The memory budget (in MB) is defined by the aipsrc variable
+// <src>table.sort.memory</src>. The default 0 means no limit, thus
+// always an in-memory sort. The budget can also be set using the static
+// function <src>setMemoryBudget</src>.
+// The directory for the scratch files is defined by the aipsrc variable
+// <src>table.sort.tmpdir</src>. It defaults to the environment
+// variable TMPDIR or <src>/tmp</src>.
+// </synopsis>
+
+// <motivation>
+// Sorting a MeasurementSet that is larger than the available memory
+// should not fail.
+// </motivation>
+
+class TableExternalSort
+{
+public:
+    // Set up the sort for the given columns. The arguments are the same
+    // as given to BaseTable::doSort.
+    TableExternalSort (const PtrBlock<BaseColumn*>& sortCol,
+                       const Block<std::shared_ptr<BaseCompare>>& cmpObj,
+                       const Block<Int>& order, int option,
+                       uInt64 memoryBudget);
+
+    ~TableExternalSort();
+
+    TableExternalSort (const TableExternalSort&) = delete;
+    TableExternalSort& operator= (const TableExternalSort&) = delete;
+
+    // Sort the <src>nrrow</src> rows of the table (containing the columns)
+    // and put the sorted row numbers in <src>rows</src> (which is resized).
+    // It returns the resulting number of rows (less than nrrow if
+    // Sort::NoDuplicates is given).
+    // If <src>iterBoundaries</src> and <src>iterKeyIdxChange</src> are
+    // given, they are filled like function <src>Sort::unique</src> does.
+    rownr_t sort (Vector<rownr_t>& rows, rownr_t nrrow,
+                  Vector<rownr_t>* iterBoundaries = 0,
+                  Vector<size_t>* iterKeyIdxChange = 0);
+
+    // Get the approximate number of bytes per row needed to hold the keys.
+    static uInt64 rowSize (const PtrBlock<BaseColumn*>& sortCol);
+
+    // Get the memory budget in bytes (0 is no limit).
+    static uInt64 memoryBudget();
+
+    // Set the memory budget in bytes (0 is no limit).
+    // It overrides the value defined in the aipsrc variable.
+    static void setMemoryBudget (uInt64 nbytes);
+
+    // Get the directory for the scratch files.
+    static String tempDirectory();
+
+private:
+    // The key data of a block of rows.
+    struct KeyBlock;
+    // A sorted run in a scratch file.
+    struct Run;
+
+    // Read the keys of the given rows into the Sort object and
+    // fill the data pointers in the KeyBlock object.
+    void readKeys (Sort& sortobj, const Vector<rownr_t>& rownrs,
+                   KeyBlock& block);
+
+    // Compare record i1 in block b1 with record i2 in block b2.
+    // It returns the same as the private function Sort::compareChangeIdx,
+    // where records with equal keys are ordered on run number.
+    int compare (const KeyBlock& b1, rownr_t i1,
+                 const KeyBlock& b2, rownr_t i2, size_t& idxComp) const;
+
+    // Sort the rows in chunks and write each sorted chunk as a run.
+    void makeRuns (rownr_t nrrow, rownr_t chunkSize);
+
+    // Sort a chunk and write its row numbers and keys as a run.
+    void sortChunk (Sort& sortobj, const Vector<rownr_t>& rownrs,
+                    const KeyBlock& keys);
+
+    // Read the next block of a run. It returns False if at the end.
+    Bool nextBlock (Run& run);
+
+    //# Data members.
+    PtrBlock<BaseColumn*>               itsSortCol;
+    Block<std::shared_ptr<BaseCompare>> itsCmpObj;
+    Block<Int>                          itsOrder;
+    int                                 itsOverallOrder;  //# as Sort::order_p
+    int                                 itsOption;
+    uInt64                              itsBudget;
+    uInt64                              itsRowSize;
+    std::vector<DataType>               itsDataTypes;
+    rownr_t                             itsBlockSize;     //# rows per block
+    String                              itsTempDir;
+    std::vector<std::unique_ptr<Run>>   itsRuns;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
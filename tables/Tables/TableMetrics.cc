@@ -0,0 +1,316 @@
+//# TableMetrics.cc: Class collecting IO metrics of tables and columns
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableMetrics.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Json/JsonOut.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <casacore/casa/OS/EnvVar.h>
+#include <casacore/casa/OS/Path.h>
+#include <iostream>
+#include <limits>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  LatencyHistogram::LatencyHistogram()
+  {
+    clear();
+  }
+
+  void LatencyHistogram::clear()
+  {
+    itsCount = 0;
+    itsSum   = 0;
+    itsMin   = std::numeric_limits<uInt64>::max();
+    itsMax   = 0;
+    for (uInt i=0; i<NBINS; ++i) {
+      itsBins[i] = 0;
+    }
+  }
+
+  uInt LatencyHistogram::binIndex (uInt64 value)
+  {
+    if (value < 16) {
+      return value;
+    }
+    // Find the highest bit set (at least 4).
+    uInt exp = 4;
+    while (exp < 63  &&  (value >> (exp+1)) != 0) {
+      exp++;
+    }
+    // Use the 3 bits below the highest bit as the sub-bin.
+    return 16 + (exp-4)*8 + ((value >> (exp-3)) & 7);
+  }
+
+  uInt64 LatencyHistogram::binStart (uInt index)
+  {
+    if (index < 16) {
+      return index;
+    }
+    uInt exp = (index-16) / 8 + 4;
+    uInt64 sub = (index-16) % 8;
+    return (8+sub) << (exp-3);
+  }
+
+  void LatencyHistogram::add (uInt64 value)
+  {
+    itsBins[binIndex(value)]++;
+    itsCount++;
+    itsSum += value;
+    uInt64 prev = itsMin;
+    while (value < prev  &&  !itsMin.compare_exchange_weak (prev, value)) {}
+    prev = itsMax;
+    while (value > prev  &&  !itsMax.compare_exchange_weak (prev, value)) {}
+  }
+
+  uInt64 LatencyHistogram::min() const
+  {
+    return itsCount == 0  ?  0 : uInt64(itsMin);
+  }
+
+  uInt64 LatencyHistogram::quantile (Double fraction) const
+  {
+    uInt64 count = itsCount;
+    if (count == 0) {
+      return 0;
+    }
+    uInt64 limit = uInt64(fraction * count + 0.5);
+    if (limit < 1) limit = 1;
+    uInt64 sum = 0;
+    for (uInt i=0; i<NBINS; ++i) {
+      sum += itsBins[i];
+      if (sum >= limit) {
+        uInt64 upper = (i+1 < NBINS  ?  binStart(i+1) - 1 : itsMax.load());
+        return std::min (upper, itsMax.load());
+      }
+    }
+    return itsMax;
+  }
+
+  void LatencyHistogram::toJson (JsonOut& jout, const String& name) const
+  {
+    jout.startNested (name);
+    uInt64 count = itsCount;
+    jout.write ("count", count);
+    jout.write ("sum_ns", sum());
+    jout.write ("min_ns", min());
+    jout.write ("max_ns", max());
+    jout.write ("mean_ns", count == 0  ?  0. : Double(sum()) / count);
+    jout.write ("p50_ns", quantile(0.5));
+    jout.write ("p90_ns", quantile(0.9));
+    jout.write ("p99_ns", quantile(0.99));
+    jout.write ("p999_ns", quantile(0.999));
+    // Write the non-empty bins as the start value and count.
+    std::vector<uInt64> starts, counts;
+    for (uInt i=0; i<NBINS; ++i) {
+      if (itsBins[i] > 0) {
+        starts.push_back (binStart(i));
+        counts.push_back (itsBins[i]);
+      }
+    }
+    jout.write ("bin_start_ns", Vector<uInt64>(starts));
+    jout.write ("bin_count", Vector<uInt64>(counts));
+    jout.endNested();
+  }
+
+
+  void TableMetrics::ColumnMetrics::clear()
+  {
+    for (int i=0; i<2; ++i) {
+      ncells[i] = 0;
+      nbytes[i] = 0;
+      latency[i].clear();
+    }
+  }
+
+  void TableMetrics::ColumnMetrics::toJson (JsonOut& jout,
+                                            const String& name) const
+  {
+    jout.startNested (name);
+    jout.write ("cells_read", uInt64(ncells[READ]));
+    jout.write ("cells_written", uInt64(ncells[WRITE]));
+    jout.write ("bytes_read", uInt64(nbytes[READ]));
+    jout.write ("bytes_written", uInt64(nbytes[WRITE]));
+    latency[READ].toJson (jout, "read_latency");
+    latency[WRITE].toJson (jout, "write_latency");
+    jout.endNested();
+  }
+
+
+  void TableMetrics::Timer::stop()
+  {
+    std::chrono::nanoseconds dur = std::chrono::steady_clock::now() - itsStart;
+    itsMetrics->ncells[itsOper] += itsNcells;
+    itsMetrics->nbytes[itsOper] += itsNvalues * itsMetrics->valueSize;
+    itsMetrics->latency[itsOper].add (dur.count());
+  }
+
+
+  TableMetrics::Registry::Registry()
+    : itsEnabled (False)
+  {
+    // The environment variable has precedence over the aipsrc variable.
+    String fname = EnvironmentVariable::get ("CASACORE_TABLE_METRICS");
+    if (fname.empty()) {
+      AipsrcValue<String>::find (fname, "table.metrics.filename", "");
+    }
+    if (! fname.empty()) {
+      itsEnabled  = True;
+      itsFileName = fname;
+    }
+  }
+
+  TableMetrics::Registry::~Registry()
+  {
+    // Write the metrics at the end of the program if needed.
+    // Do not throw an exception in a destructor.
+    if (itsFileName.empty()  ||  itsFileName == "-") {
+      return;
+    }
+    try {
+      if (itsFileName == "stdout") {
+        JsonOut jout(std::cout);
+        writeLocked (*this, jout);
+      } else if (itsFileName == "stderr") {
+        JsonOut jout(std::cerr);
+        writeLocked (*this, jout);
+      } else {
+        JsonOut jout(Path(itsFileName).expandedName());
+        writeLocked (*this, jout);
+      }
+    } catch (const std::exception& x) {
+      std::cerr << "Could not write table metrics to " << itsFileName
+                << ": " << x.what() << std::endl;
+    }
+  }
+
+  TableMetrics::Registry& TableMetrics::registry()
+  {
+    // Thread-safe initialization on first use; destructed at exit.
+    static Registry theRegistry;
+    return theRegistry;
+  }
+
+  Bool TableMetrics::enabled()
+  {
+    return registry().itsEnabled;
+  }
+
+  void TableMetrics::setEnabled (Bool enable)
+  {
+    registry().itsEnabled = enable;
+  }
+
+  TableMetrics::ColumnMetrics* TableMetrics::column (const String& tableName,
+                                                     const String& columnName,
+                                                     uInt valueSize)
+  {
+    Registry& reg = registry();
+    if (! reg.itsEnabled) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> locker(reg.itsMutex);
+    std::unique_ptr<ColumnMetrics>& col =
+      reg.itsTables[tableName].columns[columnName];
+    if (! col) {
+      col.reset (new ColumnMetrics(valueSize));
+    }
+    return col.get();
+  }
+
+  void TableMetrics::setCacheStatistics (const String& tableName,
+                                         const String& dataManagerName,
+                                         const BucketCacheStatistics& stats,
+                                         Bool closing)
+  {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> locker(reg.itsMutex);
+    CacheMetrics& cache = reg.itsTables[tableName].caches[dataManagerName];
+    if (closing) {
+      cache.closed += stats;
+      cache.current = BucketCacheStatistics();
+    } else {
+      cache.current = stats;
+    }
+  }
+
+  void TableMetrics::write (JsonOut& jout)
+  {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> locker(reg.itsMutex);
+    writeLocked (reg, jout);
+  }
+
+  void TableMetrics::write (const String& fileName)
+  {
+    JsonOut jout(Path(fileName).expandedName());
+    write (jout);
+  }
+
+  void TableMetrics::writeLocked (Registry& reg, JsonOut& jout)
+  {
+    jout.start();
+    jout.startNested ("tables");
+    for (const auto& tab : reg.itsTables) {
+      jout.startNested (JsonOut::escapeString(tab.first));
+      jout.startNested ("columns");
+      for (const auto& col : tab.second.columns) {
+        col.second->toJson (jout, JsonOut::escapeString(col.first));
+      }
+      jout.endNested();
+      jout.startNested ("caches");
+      for (const auto& cache : tab.second.caches) {
+        BucketCacheStatistics stats(cache.second.closed);
+        stats += cache.second.current;
+        jout.startNested (JsonOut::escapeString(cache.first));
+        jout.write ("accesses", stats.naccess);
+        jout.write ("hits", stats.nhit());
+        jout.write ("misses", stats.nread);
+        jout.write ("inits", stats.ninit);
+        jout.write ("writes", stats.nwrite);
+        jout.write ("evictions", stats.nevict);
+        jout.endNested();
+      }
+      jout.endNested();
+      jout.endNested();
+    }
+    jout.endNested();
+    jout.end();
+  }
+
+  void TableMetrics::clear()
+  {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> locker(reg.itsMutex);
+    for (auto& tab : reg.itsTables) {
+      for (auto& col : tab.second.columns) {
+        col.second->clear();
+      }
+      tab.second.caches.clear();
+    }
+  }
+
+} //# NAMESPACE CASACORE - END
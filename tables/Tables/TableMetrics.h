@@ -0,0 +1,304 @@
+//# TableMetrics.h: Class collecting IO metrics of tables and columns
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TABLEMETRICS_H
+#define TABLES_TABLEMETRICS_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/IO/BucketCache.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations.
+class JsonOut;
+
+
+// <summary>
+// Histogram of latencies with a fixed relative precision
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// The histogram uses logarithmic bins like an HDR histogram. Each power
+// of 2 is divided into 8 linear sub-bins, so a value is kept with a
+// relative precision of 12.5%. Values below 16 are kept exactly.
+// Values are added atomically, so the histogram can be filled by
+// multiple threads.
+// </synopsis>
+
+class LatencyHistogram
+{
+public:
+  // The number of bins (covering the entire uInt64 range).
+  static const uInt NBINS = 16 + 60*8;
+
+  LatencyHistogram();
+
+  // Add a value (in nanoseconds).
+  void add (uInt64 value);
+
+  // Get the statistics.
+  // <group>
+  uInt64 count() const
+    { return itsCount; }
+  uInt64 sum() const
+    { return itsSum; }
+  uInt64 min() const;
+  uInt64 max() const
+    { return itsMax; }
+  // </group>
+
+  // Get the value at the given fraction (0-1) of the distribution.
+  // It returns the upper limit of the bin containing it, but at most
+  // the maximum value. It returns 0 if the histogram is empty.
+  uInt64 quantile (Double fraction) const;
+
+  // Get the bin index of a value.
+  static uInt binIndex (uInt64 value);
+
+  // Get the lowest value in a bin.
+  static uInt64 binStart (uInt index);
+
+  // Write the histogram as a JSON struct with the given name.
+  // Only non-empty bins are written.
+  void toJson (JsonOut& jout, const String& name) const;
+
+  // Clear the histogram.
+  void clear();
+
+private:
+  std::atomic<uInt64> itsCount;
+  std::atomic<uInt64> itsSum;
+  std::atomic<uInt64> itsMin;
+  std::atomic<uInt64> itsMax;
+  std::atomic<uInt64> itsBins[NBINS];
+};
+
+
+// <summary>
+// Class collecting IO metrics of tables and columns
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tTableMetrics">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TableTrace>TableTrace</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Where <linkto class=TableTrace>TableTrace</linkto> logs the individual
+// table and column accesses, TableMetrics keeps counters telling where
+// the time goes. For each column of a plain table it keeps:
+// <ul>
+//  <li> the number of cells read and written.
+//  <li> the number of bytes read and written (the number of values times
+//       the size of the data type; for a String the size of the String
+//       object).
+//  <li> histograms of the time spent in the data manager get and put
+//       calls (see <linkto class=LatencyHistogram>LatencyHistogram</linkto>).
+// </ul>
+// For each data manager of a table it keeps the BucketCache accesses,
+// hits, misses (reads), initializations, writes and evictions.
+// The cache statistics are collected when a table is flushed or closed.
+// The metrics are kept per table name, so they are accumulated if a table
+// is opened multiple times.
+// <p>
+// The metrics are collected if the environment variable
+// <src>CASACORE_TABLE_METRICS</src> or otherwise the aipsrc variable
+// <src>table.metrics.filename</src> is set. Its value is the name of the
+// file in which the metrics are written as JSON at the end of the program.
+// If 'stdout' or 'stderr' is given, they are written to stdout or stderr.
+// If the value is '-', the metrics are collected, but not written at
+// the end. The function <src>write</src> can be used to write them
+// at any time.
+// <br>The function <src>setEnabled</src> can be used to switch the
+// collection on or off; it only affects the tables opened thereafter.
+// <p>
+// The overhead when disabled is a single test of a null pointer per get
+// or put. When enabled, the get and put calls of the data managers are timed.
+// Note that scalar values obtained via the column cache (see
+// <linkto class=ColumnCache>ColumnCache</linkto>) do not result in a
+// data manager call, so they are not counted.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   TableMetrics::setEnabled (True);
+//   {
+//     Table tab("my.ms");
+//     ArrayColumn<Complex> data(tab, "DATA");
+//     for (rownr_t i=0; i<tab.nrow(); ++i) data.get(i);
+//   }
+//   TableMetrics::write ("metrics.json");
+// </srcblock>
+// </example>
+
+class TableMetrics
+{
+public:
+  enum Oper {
+    READ  = 0,
+    WRITE = 1
+  };
+
+  // The metrics of a column.
+  struct ColumnMetrics
+  {
+    explicit ColumnMetrics (uInt valueSize)
+      : valueSize (valueSize)
+    {
+      for (int i=0; i<2; ++i) {
+        ncells[i] = 0;
+        nbytes[i] = 0;
+      }
+    }
+    // Clear the counters.
+    void clear();
+    // Write as a JSON struct with the given name.
+    void toJson (JsonOut& jout, const String& name) const;
+
+    uInt                valueSize;
+    std::atomic<uInt64> ncells[2];
+    std::atomic<uInt64> nbytes[2];
+    LatencyHistogram    latency[2];
+  };
+
+  // Timer for a column get or put. The time and counts are added
+  // to the column metrics when the object is destructed.
+  // Nothing is done if the metrics pointer is null.
+  class Timer
+  {
+  public:
+    Timer (ColumnMetrics* metrics, Oper oper, uInt64 ncells,
+           uInt64 nvalues)
+      : itsMetrics (metrics),
+        itsOper    (oper),
+        itsNcells  (ncells),
+        itsNvalues (nvalues)
+    {
+      if (itsMetrics) {
+        itsStart = std::chrono::steady_clock::now();
+      }
+    }
+    ~Timer()
+    {
+      if (itsMetrics) {
+        stop();
+      }
+    }
+    Timer (const Timer&) = delete;
+    Timer& operator= (const Timer&) = delete;
+  private:
+    void stop();
+    ColumnMetrics* itsMetrics;
+    Oper           itsOper;
+    uInt64         itsNcells;
+    uInt64         itsNvalues;
+    std::chrono::steady_clock::time_point itsStart;
+  };
+
+  // Are metrics collected?
+  static Bool enabled();
+
+  // Switch collecting metrics on or off for tables opened thereafter.
+  static void setEnabled (Bool enable);
+
+  // Get the metrics object of a column in a table.
+  // It returns a null pointer if metrics are not collected.
+  // The object stays alive until the end of the program.
+  static ColumnMetrics* column (const String& tableName,
+                                const String& columnName,
+                                uInt valueSize);
+
+  // Set the cache statistics of a data manager in a table.
+  // If <src>closing=True</src>, they are added to the statistics of
+  // the table's previous instances, otherwise they replace the
+  // statistics of its current instance.
+  static void setCacheStatistics (const String& tableName,
+                                  const String& dataManagerName,
+                                  const BucketCacheStatistics& stats,
+                                  Bool closing);
+
+  // Write the metrics as JSON.
+  // <group>
+  static void write (JsonOut& jout);
+  static void write (const String& fileName);
+  // </group>
+
+  // Clear all counters (but keep the tables and columns).
+  static void clear();
+
+private:
+  // The cache statistics of a data manager.
+  struct CacheMetrics
+  {
+    BucketCacheStatistics closed;
+    BucketCacheStatistics current;
+  };
+  // The metrics of a table.
+  struct TableData
+  {
+    std::map<String, std::unique_ptr<ColumnMetrics>> columns;
+    std::map<String, CacheMetrics> caches;
+  };
+
+  // The object holding the metrics of all tables.
+  // It writes them at the end of the program if needed.
+  class Registry
+  {
+  public:
+    Registry();
+    ~Registry();
+    std::mutex                      itsMutex;
+    std::atomic<Bool>               itsEnabled;
+    String                          itsFileName;
+    std::map<String, TableData>     itsTables;
+  };
+
+  // Get the registry (which is initialized on first use).
+  static Registry& registry();
+
+  // Write the metrics while the registry is locked.
+  static void writeLocked (Registry& reg, JsonOut& jout);
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -86,6 +86,9 @@ class IPosition;
 // </ul>
 // If both <src>table.trace.columntype</src> and <src>table.trace.column</src>
 // have an empty value, all array columns are traced.
+// <p>
+// Aggregated counts and latency histograms of the column accesses can be
+// collected using <linkto class=TableMetrics>TableMetrics</linkto>.
 
 class TableTrace
 {
@@ -0,0 +1,197 @@
+//# tColumnChunkReader.cc: Test program for class ColumnChunkReader
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/ColumnChunkReader.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class ColumnChunkReader.
+// </summary>
+
+// Create a table with a scalar column and array columns in the
+// standard storage manager and the tiled storage manager.
+void createTable (const String& name, rownr_t nrrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("SCA"));
+  td.addColumn (ArrayColumnDesc<Float> ("ARR", IPosition(2,3,4),
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Float> ("TSM", IPosition(2,2,5),
+                                        ColumnDesc::FixedShape));
+  SetupNewTable newtab(name, td, Table::New);
+  TiledShapeStMan tsm("TSM", IPosition(3,2,5,16));
+  newtab.bindColumn ("TSM", tsm);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int> sca(tab, "SCA");
+  ArrayColumn<Float> arr(tab, "ARR");
+  ArrayColumn<Float> tsmcol(tab, "TSM");
+  Matrix<Float> arrv(3,4);
+  Matrix<Float> tsmv(2,5);
+  for (rownr_t i=0; i<nrrow; ++i) {
+    sca.put (i, i);
+    indgen (arrv, Float(i*12));
+    arr.put (i, arrv);
+    indgen (tsmv, Float(i*10));
+    tsmcol.put (i, tsmv);
+  }
+}
+
+// Read a column in chunks and check the data against per-row gets.
+void checkScalar (const Table& tab, rownr_t chunkSize, Bool prefetch)
+{
+  ScalarColumn<Int> sca(tab, "SCA");
+  ColumnChunkReader<Int> reader(tab, "SCA", chunkSize, prefetch);
+  AlwaysAssertExit (reader.chunkSize() == chunkSize);
+  Array<Int> buffer;
+  rownr_t nrow = 0;
+  uInt nchunk = 0;
+  while (reader.next (buffer)) {
+    AlwaysAssertExit (reader.firstRow() == nrow);
+    AlwaysAssertExit (buffer.shape() == IPosition(1, reader.nrowChunk()));
+    AlwaysAssertExit (reader.nrowChunk() == chunkSize  ||
+                      nrow + reader.nrowChunk() == tab.nrow());
+    Vector<Int> vec(buffer);
+    for (rownr_t i=0; i<reader.nrowChunk(); ++i) {
+      AlwaysAssertExit (vec[i] == sca(nrow+i));
+    }
+    nrow += reader.nrowChunk();
+    nchunk++;
+  }
+  AlwaysAssertExit (nrow == tab.nrow());
+  AlwaysAssertExit (nchunk == (tab.nrow() + chunkSize - 1) / chunkSize);
+  // Reading past the end leaves the buffer untouched.
+  AlwaysAssertExit (! reader.next (buffer));
+  // Reading again after a reset gives the same data.
+  reader.reset();
+  AlwaysAssertExit (reader.next (buffer));
+  AlwaysAssertExit (reader.firstRow() == 0);
+  AlwaysAssertExit (allEQ (buffer,
+                           sca.getColumnRange (Slicer(IPosition(1,0),
+                                                      buffer.shape()))));
+}
+
+void checkArray (const Table& tab, const String& colName,
+                 rownr_t chunkSize, Bool prefetch)
+{
+  ArrayColumn<Float> arr(tab, colName);
+  ColumnChunkReader<Float> reader(tab, colName, chunkSize, prefetch);
+  Array<Float> buffer;
+  rownr_t nrow = 0;
+  while (reader.next (buffer)) {
+    AlwaysAssertExit (reader.firstRow() == nrow);
+    IPosition shape = arr.shape(0);
+    shape.append (IPosition(1, reader.nrowChunk()));
+    AlwaysAssertExit (buffer.shape() == shape);
+    IPosition blc(shape.size(), 0);
+    IPosition trc(shape - 1);
+    for (rownr_t i=0; i<reader.nrowChunk(); ++i) {
+      blc[shape.size()-1] = trc[shape.size()-1] = i;
+      AlwaysAssertExit (allEQ (buffer(blc,trc).nonDegenerate(shape.size()-1),
+                               arr(nrow+i)));
+    }
+    nrow += reader.nrowChunk();
+  }
+  AlwaysAssertExit (nrow == tab.nrow());
+}
+
+void checkAll (const Table& tab)
+{
+  for (int prefetch=0; prefetch<2; ++prefetch) {
+    for (rownr_t chunkSize : {1, 7, 64, 1000}) {
+      checkScalar (tab, chunkSize, prefetch);
+      checkArray (tab, "ARR", chunkSize, prefetch);
+      checkArray (tab, "TSM", chunkSize, prefetch);
+    }
+  }
+}
+
+// Check that the buffer is only resized if its shape changes.
+void checkBuffer (const Table& tab)
+{
+  ColumnChunkReader<Float> reader(tab, "ARR", 10);
+  Array<Float> buffer;
+  AlwaysAssertExit (reader.next (buffer));
+  const Float* data = buffer.data();
+  AlwaysAssertExit (reader.next (buffer));
+  AlwaysAssertExit (buffer.data() == data);
+}
+
+void checkErrors (const Table& tab)
+{
+  Bool caught = False;
+  try {
+    ColumnChunkReader<Int> reader(tab, "SCA", 0);
+  } catch (const TableError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+  caught = False;
+  try {
+    ColumnChunkReader<Int> reader(tab, "NONE", 10);
+  } catch (const TableError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+}
+
+int main()
+{
+  try {
+    createTable ("tColumnChunkReader_tmp.data", 200);
+    Table tab("tColumnChunkReader_tmp.data");
+    checkAll (tab);
+    checkBuffer (tab);
+    checkErrors (tab);
+    // A selection with runs of rows.
+    Table sel = tab(tab.col("SCA") % 10 < 7);
+    AlwaysAssertExit (sel.nrow() == 140);
+    checkAll (sel);
+    // A sorted selection, thus decreasing row numbers.
+    Table sorted = tab.sort ("SCA", Sort::Descending);
+    checkAll (sorted);
+    checkAll (sorted(sorted.col("SCA") % 3 != 0));
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,331 @@
+//# tColumnIndexFile.cc: Test program for class ColumnIndexFile
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/ColumnIndexFile.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <limits>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class ColumnIndexFile and its use in TaQL.
+// </summary>
+
+void createTable (const String& name, rownr_t nrrow, Int offset)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  SetupNewTable newtab(name, td, Table::New);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ScalarColumn<Double> time(tab, "TIME");
+  for (rownr_t i=0; i<nrrow; ++i) {
+    ant.put (i, i%27 + offset);
+    time.put (i, 10. * (i/27));
+  }
+}
+
+// Get the row numbers using a brute force search.
+Vector<rownr_t> bruteForce (const Table& tab, Double lower, Double upper)
+{
+  ScalarColumn<Double> col(tab, "TIME");
+  std::vector<rownr_t> rows;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    if (col(i) >= lower  &&  col(i) <= upper) {
+      rows.push_back (i);
+    }
+  }
+  return Vector<rownr_t>(rows);
+}
+
+Vector<rownr_t> bruteForce (const Table& tab, Int ant)
+{
+  ScalarColumn<Int> col(tab, "ANTENNA1");
+  std::vector<rownr_t> rows;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    if (col(i) == ant) {
+      rows.push_back (i);
+    }
+  }
+  return Vector<rownr_t>(rows);
+}
+
+Bool sameRows (const Vector<rownr_t>& rows1, const Vector<rownr_t>& rows2)
+{
+  return rows1.size() == rows2.size()  &&  allEQ (rows1, rows2);
+}
+
+void testLookup (const String& name)
+{
+  Table tab(name, Table::Update);
+  const rownr_t nrrow = tab.nrow();
+  ColumnIndexFile::create (tab, "ANTENNA1", 64);
+  ColumnIndexFile::create (tab, "TIME", 64);
+  AlwaysAssertExit (ColumnIndexFile::exists (tab, "ANTENNA1"));
+  AlwaysAssertExit (! ColumnIndexFile::exists (tab, "NAME"));
+  ColumnIndexFile antIndex(tab, "ANTENNA1");
+  ColumnIndexFile timeIndex(tab, "TIME");
+  AlwaysAssertExit (antIndex.isValid());
+  AlwaysAssertExit (antIndex.nrowIndexed() == nrrow);
+  AlwaysAssertExit (antIndex.nrRuns() == 1);
+  // Lookup a single key.
+  for (Int ant=-1; ant<=27; ++ant) {
+    AlwaysAssertExit (sameRows (antIndex.getRowNumbers (ant),
+                                bruteForce (tab, ant)));
+  }
+  AlwaysAssertExit (antIndex.getRowNumbers (3.5).empty());
+  // Lookup ranges.
+  AlwaysAssertExit (sameRows (timeIndex.getRowNumbers (100., 200., True, True),
+                              bruteForce (tab, 100., 200.)));
+  AlwaysAssertExit (sameRows (timeIndex.getRowNumbers (100., 200., False, False),
+                              bruteForce (tab, 101., 199.)));
+  AlwaysAssertExit (sameRows (timeIndex.getRowNumbers (-1e30, 1e30, True, True),
+                              bruteForce (tab, -1., 1e30)));
+  AlwaysAssertExit (timeIndex.getRowNumbers (1e10, 1e11, True, True).empty());
+  // Integer keys with real bounds.
+  AlwaysAssertExit (sameRows (antIndex.getRowNumbers (2.5, 3.5, True, True),
+                              bruteForce (tab, 3)));
+  AlwaysAssertExit (sameRows (antIndex.getRowNumbers (2., 4., False, False),
+                              bruteForce (tab, 3)));
+  // Lookup several keys (in random order).
+  Vector<Double> keys(3);
+  keys[0] = 7; keys[1] = 1; keys[2] = 7;
+  Vector<rownr_t> rows = antIndex.getRowNumbers (keys);
+  AlwaysAssertExit (rows.size() == bruteForce(tab, 1).size() +
+                                   bruteForce(tab, 7).size());
+  for (uInt i=1; i<rows.size(); ++i) {
+    AlwaysAssertExit (rows[i] > rows[i-1]);
+  }
+  // A lookup must read only a small part of the index.
+  ColumnIndexFile index2(tab, "TIME");
+  index2.getRowNumbers (5000.);
+  AlwaysAssertExit (index2.nrBytesRead() < 16*nrrow / 10);
+  // Columns with other types cannot be indexed.
+  Bool failed = False;
+  try {
+    ColumnIndexFile::create (tab, "NAME");
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+void testUpdate (const String& name)
+{
+  Table tab(name, Table::Update);
+  rownr_t nrrow = tab.nrow();
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  // Added rows are not in the index, but are found.
+  tab.addRow (100);
+  for (rownr_t i=nrrow; i<nrrow+100; ++i) {
+    ant.put (i, 3);
+  }
+  ColumnIndexFile index(tab, "ANTENNA1");
+  AlwaysAssertExit (index.isValid());
+  AlwaysAssertExit (index.nrowIndexed() == nrrow);
+  AlwaysAssertExit (sameRows (index.getRowNumbers (3), bruteForce (tab, 3)));
+  // Add them to the index as a new run.
+  index.update();
+  AlwaysAssertExit (index.nrowIndexed() == nrrow + 100);
+  AlwaysAssertExit (index.nrRuns() == 2);
+  AlwaysAssertExit (sameRows (index.getRowNumbers (3), bruteForce (tab, 3)));
+  // Too many runs recreate the index.
+  for (uInt i=0; i<8; ++i) {
+    tab.addRow (1);
+    ant.put (tab.nrow() - 1, 4);
+    index.update();
+  }
+  AlwaysAssertExit (index.nrRuns() < 8);
+  AlwaysAssertExit (index.nrowIndexed() == tab.nrow());
+  AlwaysAssertExit (sameRows (index.getRowNumbers (4), bruteForce (tab, 4)));
+  // Changing an indexed row makes the index stale.
+  AlwaysAssertExit (ColumnIndexFile(tab, "TIME").isValid());
+  ant.put (5, 100);
+  AlwaysAssertExit (! index.isValid());
+  // The index of the other column is still fine.
+  AlwaysAssertExit (ColumnIndexFile(tab, "TIME").isValid());
+  Bool failed = False;
+  try {
+    index.getRowNumbers (3);
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  // Recreate it; removing a row makes it stale again.
+  ColumnIndexFile::create (tab, "ANTENNA1", 64);
+  AlwaysAssertExit (index.isValid());
+  AlwaysAssertExit (sameRows (index.getRowNumbers (100), bruteForce (tab, 100)));
+  tab.removeRow (tab.nrow() - 1);
+  AlwaysAssertExit (! index.isValid());
+  ColumnIndexFile::create (tab, "ANTENNA1", 64);
+}
+
+void testTaQL (const String& name, const String& name2)
+{
+  Table tab(name);
+  const char* queries[] = {
+    "select from $1 where ANTENNA1 == 3",
+    "select from $1 where 3 == ANTENNA1 && TIME < 500",
+    "select from $1 where ANTENNA1 > 20 || ANTENNA1 <= 1",
+    "select from $1 where ANTENNA1 in [1,7,11] && TIME > 1000",
+    "select from $1 where TIME between 100 and 200",
+    "select from $1 where TIME in [100=:<200, 1000<:=1200]",
+    "select from $1 where TIME >= 100 && NAME == ''",
+    "select from $1 where ANTENNA1 == 2 limit 5"
+  };
+  for (const char* query : queries) {
+    Table sel = tableCommand (query, tab).table();
+    // Compare with the result without using an index (on a reference table).
+    Table sel2 = tableCommand (query, tab(tab.rowNumbers())).table();
+    AlwaysAssertExit (sameRows (sel.rowNumbers(tab), sel2.rowNumbers(tab)));
+    AlwaysAssertExit (sel.nrow() > 0);
+  }
+  // Check that the index is really used by TaQL by using the index of the
+  // first table for the second one which has other values.
+  Table tab2(name2);
+  RegularFile(ColumnIndexFile::fileName (name, "ANTENNA1")).copy
+    (ColumnIndexFile::fileName (name2, "ANTENNA1"));
+  AlwaysAssertExit (tableCommand ("select from $1 where ANTENNA1 == 2",
+                                  tab2).table().nrow() == 0);
+  ColumnIndexFile::remove (tab2, "ANTENNA1");
+  AlwaysAssertExit (tableCommand ("select from $1 where ANTENNA1 == 2",
+                                  tab2).table().nrow() > 0);
+}
+
+void testRename (const String& name)
+{
+  Table tab(name, Table::Update);
+  tab.renameColumn ("ANT", "ANTENNA1");
+  AlwaysAssertExit (! ColumnIndexFile::exists (tab, "ANTENNA1"));
+  AlwaysAssertExit (ColumnIndexFile::exists (tab, "ANT"));
+  AlwaysAssertExit (ColumnIndexFile(tab, "ANT").isValid());
+  tab.removeColumn ("ANT");
+  AlwaysAssertExit (! ColumnIndexFile::exists (tab, "ANT"));
+}
+
+void testNaN (const String& name)
+{
+  // NaN keys are not part of the index and never match.
+  Table tab(name, Table::Update);
+  ScalarColumn<Double> time(tab, "TIME");
+  for (rownr_t i=0; i<tab.nrow(); i+=7) {
+    time.put (i, std::numeric_limits<Double>::quiet_NaN());
+  }
+  ColumnIndexFile::create (tab, "TIME", 64);
+  ColumnIndexFile index(tab, "TIME");
+  AlwaysAssertExit (index.isValid());
+  AlwaysAssertExit (index.nrowIndexed() == tab.nrow());
+  AlwaysAssertExit (sameRows (index.getRowNumbers (100., 200., True, True),
+                              bruteForce (tab, 100., 200.)));
+  AlwaysAssertExit (sameRows (index.getRowNumbers (-1e30, 1e30, True, True),
+                              bruteForce (tab, -1e30, 1e30)));
+  // Also for NaN in rows added thereafter.
+  tab.addRow (10);
+  for (rownr_t i=tab.nrow()-10; i<tab.nrow(); ++i) {
+    time.put (i, (i%2 == 0  ?  std::numeric_limits<Double>::quiet_NaN() : 150.));
+  }
+  AlwaysAssertExit (sameRows (index.getRowNumbers (100., 200., True, True),
+                              bruteForce (tab, 100., 200.)));
+  index.update();
+  AlwaysAssertExit (index.nrowIndexed() == tab.nrow());
+  AlwaysAssertExit (sameRows (index.getRowNumbers (100., 200., True, True),
+                              bruteForce (tab, 100., 200.)));
+  Table sel = tableCommand ("select from $1 where TIME between 100 and 200",
+                            tab).table();
+  AlwaysAssertExit (sameRows (sel.rowNumbers(tab), bruteForce (tab, 100., 200.)));
+}
+
+void testInt64 (const String& name)
+{
+  // Int64 keys beyond 2^53 are compared exactly.
+  const Int64 base = Int64(1) << 60;
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int64> ("ID"));
+  SetupNewTable newtab(name, td, Table::New);
+  Table tab(newtab, 1000);
+  ScalarColumn<Int64> id(tab, "ID");
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    id.put (i, base + Int64(i%5));
+  }
+  ColumnIndexFile::create (tab, "ID", 64);
+  ColumnIndexFile index(tab, "ID");
+  for (Int64 k=0; k<5; ++k) {
+    RowNumbers rows = index.getRowNumbers (Vector<Int64>(1, base+k));
+    AlwaysAssertExit (rows.size() == 200);
+    for (rownr_t row : rows) {
+      AlwaysAssertExit (id(row) == base+k);
+    }
+  }
+  AlwaysAssertExit (index.getRowNumbers (Vector<Int64>(1, base+1),
+                                         Vector<Int64>(1, base+3)).size() == 600);
+  AlwaysAssertExit (index.getRowNumbers (Vector<Int64>(1, base+3),
+                                         Vector<Int64>(1, base+1)).empty());
+  // A Double cannot hold base+1, so it is looked up as base.
+  AlwaysAssertExit (sameRows (index.getRowNumbers (Double(base+1)),
+                              index.getRowNumbers (Vector<Int64>(1, base))));
+  // TaQL gives the same result with and without the index.
+  Table sel = tableCommand ("select from $1 where ID == " +
+                            String::toString(base+3), tab).table();
+  AlwaysAssertExit (sel.nrow() == 200);
+  Table sel2 = tableCommand ("select from $1 where ID == " +
+                             String::toString(base+3),
+                             tab(tab.rowNumbers())).table();
+  AlwaysAssertExit (sameRows (sel.rowNumbers(tab), sel2.rowNumbers(tab)));
+  // Writing a slice of indexed rows makes the index stale.
+  id.putColumnCells (RefRows(500, 599, 1), Vector<Int64>(100, base));
+  AlwaysAssertExit (! index.isValid());
+}
+
+int main()
+{
+  try {
+    createTable ("tColumnIndexFile_tmp.tab", 10000, 0);
+    createTable ("tColumnIndexFile_tmp.tab2", 10000, 1);
+    testLookup ("tColumnIndexFile_tmp.tab");
+    testUpdate ("tColumnIndexFile_tmp.tab");
+    testTaQL ("tColumnIndexFile_tmp.tab", "tColumnIndexFile_tmp.tab2");
+    testRename ("tColumnIndexFile_tmp.tab");
+    testNaN ("tColumnIndexFile_tmp.tab2");
+    testInt64 ("tColumnIndexFile_tmp.tab3");
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -323,6 +323,140 @@ void d()
     cout << "<<<" << endl;
 }
 
+// Compare the results of a hashed and sorted index on the same columns.
+void compareHashed (const Table& tab, const String& columns,
+                    const Record& key)
+{
+    ColumnsIndex sortInx (tab, stringToVector(columns));
+    ColumnsIndex hashInx (tab, stringToVector(columns), ColumnsIndex::Hashed);
+    AlwaysAssertExit (hashInx.indexType() == ColumnsIndex::Hashed);
+    AlwaysAssertExit (hashInx.isUnique() == sortInx.isUnique());
+    RowNumbers rows1 = sortInx.getRowNumbers (key);
+    RowNumbers rows2 = hashInx.getRowNumbers (key);
+    AlwaysAssertExit (rows1.size() == rows2.size());
+    for (uInt i=0; i<rows1.size(); i++) {
+        AlwaysAssertExit (rows1[i] == rows2[i]);
+    }
+}
+
+void e()
+{
+    Table tab("tColumnsIndex_tmp.data", Table::Update);
+    const Int nrrow = tab.nrow();
+    // Compare the hashed index with the sorted index for all data types.
+    for (Int i=-1; i<12; i++) {
+        Record rec;
+        rec.define ("abool", i%2 == 0);
+        rec.define ("auchar", uChar(i));
+        rec.define ("ashort", Short(i));
+        rec.define ("aint", -i);
+        rec.define ("auint", uInt(i));
+        rec.define ("afloat", Float(i));
+        rec.define ("adouble", Double(i));
+        // Both index types compare complex values by norm, so the
+        // negative value finds the row with the positive value.
+        rec.define ("acomplex", Complex(i,0));
+        rec.define ("adcomplex", DComplex(0,i));
+        rec.define ("astring", "V" + String::toString(i));
+        compareHashed (tab, "abool", rec);
+        compareHashed (tab, "auchar", rec);
+        compareHashed (tab, "ashort", rec);
+        compareHashed (tab, "aint", rec);
+        compareHashed (tab, "auint", rec);
+        compareHashed (tab, "afloat", rec);
+        compareHashed (tab, "adouble", rec);
+        compareHashed (tab, "acomplex", rec);
+        compareHashed (tab, "adcomplex", rec);
+        compareHashed (tab, "astring", rec);
+        compareHashed (tab, "abool,auint", rec);
+        compareHashed (tab, "astring,adouble,aint", rec);
+    }
+    // Look up unique keys.
+    ColumnsIndex colInx (tab, "adouble", ColumnsIndex::Hashed);
+    RecordFieldPtr<Double> adouble (colInx.accessKey(), "adouble");
+    AlwaysAssertExit (colInx.isUnique());
+    Bool found;
+    for (Int i=0; i<nrrow; i++) {
+        *adouble = i;
+        AlwaysAssertExit (colInx.getRowNumber(found) == rownr_t(i)  &&  found);
+    }
+    *adouble = -0.;
+    AlwaysAssertExit (colInx.getRowNumber(found) == 0  &&  found);
+    *adouble = 0.5;
+    colInx.getRowNumber(found);
+    AlwaysAssertExit (!found);
+    // A key range cannot be looked up.
+    Bool failed = False;
+    try {
+        colInx.getRowNumbers (True, True);
+    } catch (std::exception&) {
+        failed = True;
+    }
+    AlwaysAssertExit (failed);
+    // Added rows are added to the index.
+    ColumnsIndex colInx2 (colInx);
+    AlwaysAssertExit (colInx2.indexType() == ColumnsIndex::Hashed);
+    ScalarColumn<Double> cdouble(tab, "adouble");
+    for (Int j=0; j<3; j++) {
+        tab.addRow (100);
+        for (rownr_t i=tab.nrow()-100; i<tab.nrow(); i++) {
+            cdouble.put (i, i);
+        }
+        *adouble = tab.nrow() - 1;
+        AlwaysAssertExit (colInx.getRowNumber(found) == tab.nrow() - 1  &&
+                          found);
+        *adouble = 5;
+        AlwaysAssertExit (colInx.getRowNumber(found) == 5  &&  found);
+    }
+    AlwaysAssertExit (colInx.isUnique());
+    // A duplicate key is chained.
+    tab.addRow (1);
+    cdouble.put (tab.nrow() - 1, 5);
+    RowNumbers rows = colInx.getRowNumbers();
+    AlwaysAssertExit (rows.size() == 2  &&  rows[0] == 5  &&
+                      rows[1] == tab.nrow() - 1);
+    AlwaysAssertExit (!colInx.isUnique());
+    // The copy has its own data.
+    RecordFieldPtr<Double> adouble2 (colInx2.accessKey(), "adouble");
+    *adouble2 = 5;
+    AlwaysAssertExit (colInx2.getRowNumbers().size() == 2);
+    // Changed data are reread.
+    cdouble.put (7, -7);
+    colInx.setChanged ("adouble");
+    *adouble = -7;
+    AlwaysAssertExit (colInx.getRowNumbers().size() == 1);
+    *adouble = 7;
+    AlwaysAssertExit (colInx.getRowNumbers().size() == 0);
+    // Removed rows are detected, even if the number of rows is the same
+    // or larger, so the data are reread.
+    ColumnsIndex sortInx (tab, "adouble");
+    RecordFieldPtr<Double> sdouble (sortInx.accessKey(), "adouble");
+    *sdouble = 5;
+    *adouble = 5;
+    AlwaysAssertExit (sortInx.getRowNumbers().size() == 2);
+    AlwaysAssertExit (colInx.getRowNumbers().size() == 2);
+    tab.removeRow (5);
+    tab.addRow (1);
+    cdouble.put (tab.nrow() - 1, 1000);
+    rows = colInx.getRowNumbers();
+    AlwaysAssertExit (rows.size() == 1  &&  rows[0] == tab.nrow() - 2);
+    rows = sortInx.getRowNumbers();
+    AlwaysAssertExit (rows.size() == 1  &&  rows[0] == tab.nrow() - 2);
+    tab.removeRow (0);
+    tab.addRow (2);
+    cdouble.put (tab.nrow() - 2, 2000);
+    cdouble.put (tab.nrow() - 1, 2001);
+    *adouble = 1;
+    *sdouble = 1;
+    rows = colInx.getRowNumbers();
+    AlwaysAssertExit (rows.size() == 1  &&  rows[0] == 0);
+    rows = sortInx.getRowNumbers();
+    AlwaysAssertExit (rows.size() == 1  &&  rows[0] == 0);
+    *adouble = 2001;
+    rows = colInx.getRowNumbers();
+    AlwaysAssertExit (rows.size() == 1  &&  rows[0] == tab.nrow() - 1);
+}
+
 int main()
 {
     try {
@@ -330,6 +464,7 @@ int main()
 	b();
 	c();
 	d();
+	e();
     } catch (std::exception& x) {
         cout << "Exception caught: " << x.what() << endl;
 	return 1;
@@ -0,0 +1,148 @@
+//# tColumnsIndexPerf.cc: Test program for the performance of ColumnsIndex
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables.h>
+#include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
+#include <casacore/casa/Containers/RecordField.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <stdexcept>
+#include <iostream>
+using namespace casacore;
+using namespace std;
+
+// Compare the lookup performance of a sorted and hashed ColumnsIndex
+// on a calibration-like table with key ANTENNA,SPECTRAL_WINDOW_ID,TIME.
+// The number of time slots can be given as argument.
+
+void testPerf (Int ntime)
+{
+  const Int nant = 64;
+  const Int nspw = 16;
+  cout << "testPerf with " << ntime << " times ..." << endl;
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ANTENNA"));
+  td.addColumn (ScalarColumnDesc<Int>("SPECTRAL_WINDOW_ID"));
+  td.addColumn (ScalarColumnDesc<Double>("TIME"));
+  SetupNewTable newtab("tColumnsIndexPerf_tmp.data", td, Table::New);
+  Table tab(newtab, ntime*nspw*nant);
+  ScalarColumn<Int> ant(tab, "ANTENNA");
+  ScalarColumn<Int> spw(tab, "SPECTRAL_WINDOW_ID");
+  ScalarColumn<Double> time(tab, "TIME");
+  rownr_t row = 0;
+  for (Int t=0; t<ntime; ++t) {
+    for (Int s=0; s<nspw; ++s) {
+      for (Int a=0; a<nant; ++a) {
+        ant.put (row, a);
+        spw.put (row, s);
+        time.put (row, 4.5e9 + 10*t);
+        ++row;
+      }
+    }
+  }
+  Vector<String> keys = stringToVector ("ANTENNA,SPECTRAL_WINDOW_ID,TIME");
+  Timer timer;
+  ColumnsIndex sortInx (tab, keys);
+  timer.show ("create sorted");
+  timer.mark();
+  ColumnsIndex hashInx (tab, keys, ColumnsIndex::Hashed);
+  timer.show ("create hashed");
+  RecordFieldPtr<Int> ant1 (sortInx.accessKey(), "ANTENNA");
+  RecordFieldPtr<Int> spw1 (sortInx.accessKey(), "SPECTRAL_WINDOW_ID");
+  RecordFieldPtr<Double> time1 (sortInx.accessKey(), "TIME");
+  RecordFieldPtr<Int> ant2 (hashInx.accessKey(), "ANTENNA");
+  RecordFieldPtr<Int> spw2 (hashInx.accessKey(), "SPECTRAL_WINDOW_ID");
+  RecordFieldPtr<Double> time2 (hashInx.accessKey(), "TIME");
+  // Look up all keys a few times in a solver-like order.
+  const Int nloop = 5;
+  Bool found;
+  rownr_t sum1 = 0;
+  timer.mark();
+  for (Int i=0; i<nloop; ++i) {
+    for (Int t=0; t<ntime; ++t) {
+      for (Int a=0; a<nant; ++a) {
+        for (Int s=0; s<nspw; ++s) {
+          *ant1 = a;
+          *spw1 = s;
+          *time1 = 4.5e9 + 10*t;
+          sum1 += sortInx.getRowNumber (found);
+        }
+      }
+    }
+  }
+  timer.show ("lookup sorted");
+  rownr_t sum2 = 0;
+  timer.mark();
+  for (Int i=0; i<nloop; ++i) {
+    for (Int t=0; t<ntime; ++t) {
+      for (Int a=0; a<nant; ++a) {
+        for (Int s=0; s<nspw; ++s) {
+          *ant2 = a;
+          *spw2 = s;
+          *time2 = 4.5e9 + 10*t;
+          sum2 += hashInx.getRowNumber (found);
+        }
+      }
+    }
+  }
+  timer.show ("lookup hashed");
+  AlwaysAssertExit (sum1 == sum2);
+  // Add rows for a new time slot and look them up.
+  tab.addRow (nspw*nant);
+  for (Int s=0; s<nspw; ++s) {
+    for (Int a=0; a<nant; ++a) {
+      ant.put (row, a);
+      spw.put (row, s);
+      time.put (row, 4.5e9 + 10*ntime);
+      ++row;
+    }
+  }
+  *ant1 = *ant2 = nant-1;
+  *spw1 = *spw2 = nspw-1;
+  *time1 = *time2 = 4.5e9 + 10*ntime;
+  timer.mark();
+  rownr_t row1 = sortInx.getRowNumber (found);
+  timer.show ("update sorted");
+  timer.mark();
+  rownr_t row2 = hashInx.getRowNumber (found);
+  timer.show ("update hashed");
+  AlwaysAssertExit (row1 == row-1  &&  row2 == row-1);
+}
+
+int main (int argc, const char* argv[])
+{
+  Int ntime = 10;
+  if (argc > 1) {
+    ntime = atoi(argv[1]);
+  }
+  try {
+    testPerf (ntime);
+  } catch (const exception& x) {
+    cout << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -129,6 +129,18 @@ void doIt()
 	}
 	cout << ref.convert(vec) << endl;;
     }
+    {
+	// Collapsing a pair followed by a lower row number.
+	Vector<rownr_t> rows(24);
+	indgen (rows, rownr_t(0));
+	rows(21) = 10;
+	rows(22) = 12;
+	rows(23) = 5;
+	RefRows ref(rows, False, True);
+	AlwaysAssertExit (ref.nrows() == 24);
+	AlwaysAssertExit (ref.isSliced());
+	AlwaysAssertExit (allEQ (ref.convert(), rows));
+    }
 }
 
 int main()
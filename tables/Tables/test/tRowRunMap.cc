@@ -0,0 +1,319 @@
+//# tRowRunMap.cc: Test program for class RowRunMap and its use in RefTable
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/RowRunMap.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/Tables/RefTable.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableIter.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class RowRunMap and the row runs in RefTable.
+// </summary>
+
+void testMap()
+{
+  RowRunMap runs;
+  AlwaysAssertExit (runs.empty()  &&  runs.nrow() == 0);
+  runs.addRange (100, 199);
+  runs.addRange (300, 349);
+  runs.addRow (350);
+  runs.addRow (10);
+  AlwaysAssertExit (runs.nrun() == 3);
+  AlwaysAssertExit (runs.nrow() == 152);
+  AlwaysAssertExit (runs.runStart(1) == 300  &&  runs.runLength(1) == 51);
+  AlwaysAssertExit (runs[0] == 100  &&  runs[99] == 199);
+  AlwaysAssertExit (runs[100] == 300  &&  runs[150] == 350);
+  AlwaysAssertExit (runs[151] == 10);
+  AlwaysAssertExit (! runs.isAscending());
+  Vector<rownr_t> rows = runs.rowNumbers();
+  AlwaysAssertExit (rows.size() == 152);
+  for (rownr_t i=0; i<rows.size(); ++i) {
+    AlwaysAssertExit (rows[i] == runs[i]);
+  }
+  AlwaysAssertExit (RowRunMap::countRuns (rows.data(), rows.size()) == 3);
+  // Construct from a vector and a RefRows object.
+  RowRunMap runs2(rows);
+  AlwaysAssertExit (runs2.nrun() == 3  &&  allEQ (runs2.rowNumbers(), rows));
+  RefRows refrows = runs.refRows();
+  AlwaysAssertExit (refrows.isSliced()  &&  refrows.nrows() == 152);
+  AlwaysAssertExit (allEQ (refrows.convert(), rows));
+  RowRunMap runs3(refrows);
+  AlwaysAssertExit (runs3.nrun() == 3  &&  allEQ (runs3.rowNumbers(), rows));
+  // Map all rows forward and backward (using the last run found)
+  // in a copy and an assigned map.
+  RowRunMap runs4(runs);
+  RowRunMap runs5;
+  runs5 = runs;
+  for (rownr_t i=0; i<rows.size(); ++i) {
+    AlwaysAssertExit (runs4[i] == rows[i]);
+    AlwaysAssertExit (runs5[rows.size()-1-i] == rows[rows.size()-1-i]);
+  }
+  // Map some rows.
+  Vector<rownr_t> in(4);
+  in[0] = 151; in[1] = 5; in[2] = 6; in[3] = 120;
+  Vector<rownr_t> out(4);
+  runs.map (4, in.data(), out.data());
+  AlwaysAssertExit (out[0] == 10  &&  out[1] == 105  &&  out[2] == 106  &&
+                    out[3] == 320);
+  // Convert a RefRows object; rows 98..101 are split at the run boundary.
+  RefRows conv = runs.convert (RefRows(98, 101));
+  AlwaysAssertExit (conv.isSliced()  &&  conv.nrows() == 4);
+  AlwaysAssertExit (conv.rowVector().size() == 6);
+  Vector<rownr_t> exp(4);
+  exp[0] = 198; exp[1] = 199; exp[2] = 300; exp[3] = 301;
+  AlwaysAssertExit (allEQ (conv.convert(), exp));
+  conv = runs.convert (RefRows(0, 150, 50));
+  exp.resize (4);
+  exp[0] = 100; exp[1] = 150; exp[2] = 300; exp[3] = 350;
+  AlwaysAssertExit (allEQ (conv.convert(), exp));
+  conv = runs.convert (RefRows(in));
+  AlwaysAssertExit (allEQ (conv.convert(), out));
+  // Map the rows of another map.
+  RowRunMap sub;
+  sub.addRange (90, 110);
+  sub.addRange (0, 1);
+  RowRunMap comp = runs.map (sub);
+  AlwaysAssertExit (comp.nrun() == 3  &&  comp.nrow() == 23);
+  for (rownr_t i=0; i<comp.nrow(); ++i) {
+    AlwaysAssertExit (comp[i] == runs[sub[i]]);
+  }
+  // Reduce the size.
+  runs.resize (101);
+  AlwaysAssertExit (runs.nrun() == 2  &&  runs.nrow() == 101);
+  AlwaysAssertExit (runs[100] == 300  &&  runs.isAscending());
+  // Errors.
+  Bool caught = False;
+  try {
+    runs[101];
+  } catch (const TableError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+  caught = False;
+  try {
+    runs.resize (200);
+  } catch (const TableError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+  runs.clear();
+  AlwaysAssertExit (runs.empty()  &&  runs.nrow() == 0);
+  AlwaysAssertExit (runs.refRows().nrows() == 0);
+}
+
+void createTable (const String& name, rownr_t nrrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("SCA"));
+  td.addColumn (ScalarColumnDesc<Int> ("GRP"));
+  td.addColumn (ArrayColumnDesc<Float> ("ARR", IPosition(1,3),
+                                        ColumnDesc::FixedShape));
+  SetupNewTable newtab(name, td, Table::New);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int> sca(tab, "SCA");
+  ScalarColumn<Int> grp(tab, "GRP");
+  ArrayColumn<Float> arr(tab, "ARR");
+  Vector<Float> arrv(3);
+  for (rownr_t i=0; i<nrrow; ++i) {
+    sca.put (i, i);
+    grp.put (i, (i/100) % 3);
+    indgen (arrv, Float(3*i));
+    arr.put (i, arrv);
+  }
+}
+
+// Check that the table columns give the same values as the root table.
+void checkTable (const Table& tab, const Table& root)
+{
+  RowNumbers rows = tab.rowNumbers();
+  AlwaysAssertExit (rows.size() == tab.nrow());
+  ScalarColumn<Int> sca(tab, "SCA");
+  ArrayColumn<Float> arr(tab, "ARR");
+  ArrayColumn<Float> rootArr(root, "ARR");
+  Vector<Int> scav = sca.getColumn();
+  for (rownr_t i=0; i<rows.size(); ++i) {
+    AlwaysAssertExit (scav[i] == Int(rows[i]));
+    AlwaysAssertExit (sca(i) == Int(rows[i]));
+  }
+  Array<Float> arrv = arr.getColumn();
+  Array<Float> exp = rootArr.getColumnCells (RefRows(rows));
+  AlwaysAssertExit (allEQ (arrv, exp));
+  if (tab.nrow() > 10) {
+    Vector<Int> cells = sca.getColumnCells (RefRows(3, tab.nrow()-1, 2));
+    for (rownr_t i=0; i<cells.size(); ++i) {
+      AlwaysAssertExit (cells[i] == Int(rows[3+2*i]));
+    }
+  }
+}
+
+// Check the logical operations against the set operations on the rows.
+void checkLogic (const Table& tab1, const Table& tab2, const Table& root)
+{
+  std::vector<rownr_t> r1 = tab1.rowNumbers().tovector();
+  std::vector<rownr_t> r2 = tab2.rowNumbers().tovector();
+  std::sort (r1.begin(), r1.end());
+  std::sort (r2.begin(), r2.end());
+  std::vector<rownr_t> all(root.nrow());
+  std::iota (all.begin(), all.end(), rownr_t(0));
+  std::vector<rownr_t> res;
+  std::set_intersection (r1.begin(), r1.end(), r2.begin(), r2.end(),
+                         std::back_inserter(res));
+  AlwaysAssertExit (allEQ ((tab1 & tab2).rowNumbers(), Vector<rownr_t>(res)));
+  res.clear();
+  std::set_union (r1.begin(), r1.end(), r2.begin(), r2.end(),
+                  std::back_inserter(res));
+  AlwaysAssertExit (allEQ ((tab1 | tab2).rowNumbers(), Vector<rownr_t>(res)));
+  res.clear();
+  std::set_difference (r1.begin(), r1.end(), r2.begin(), r2.end(),
+                       std::back_inserter(res));
+  AlwaysAssertExit (allEQ ((tab1 - tab2).rowNumbers(), Vector<rownr_t>(res)));
+  res.clear();
+  std::set_symmetric_difference (r1.begin(), r1.end(), r2.begin(), r2.end(),
+                                 std::back_inserter(res));
+  AlwaysAssertExit (allEQ ((tab1 ^ tab2).rowNumbers(), Vector<rownr_t>(res)));
+  res.clear();
+  std::set_difference (all.begin(), all.end(), r1.begin(), r1.end(),
+                       std::back_inserter(res));
+  AlwaysAssertExit (allEQ ((!tab1).rowNumbers(), Vector<rownr_t>(res)));
+}
+
+void testRefTable()
+{
+  createTable ("tRowRunMap_tmp.data", 3000);
+  Table tab("tRowRunMap_tmp.data");
+  // Select rows in long runs.
+  Table sel = tab(tab.col("GRP") != 1);
+  AlwaysAssertExit (sel.nrow() == 2000);
+  checkTable (sel, tab);
+  // A fragmented selection.
+  Table frag = tab(tab.col("SCA") % 3 == 0);
+  AlwaysAssertExit (frag.nrow() == 1000);
+  checkTable (frag, tab);
+  // A selection of a selection, also on the fragmented one.
+  Table sel2 = sel(sel.col("SCA") > 150);
+  AlwaysAssertExit (sel2.nrow() == 1900);
+  checkTable (sel2, tab);
+  checkTable (frag(frag.col("GRP") == 2), tab);
+  checkTable (sel(sel.col("SCA") % 2 == 1), tab);
+  // Selection by row numbers and projection.
+  Vector<rownr_t> rownrs(500);
+  indgen (rownrs, rownr_t(1000));
+  Table sel3 = sel(rownrs);
+  AlwaysAssertExit (sel3.nrow() == 500);
+  AlwaysAssertExit (sel3.rowNumbers()[0] == 1500);
+  checkTable (sel3, tab);
+  Block<String> cols(2);
+  cols[0] = "SCA";
+  cols[1] = "ARR";
+  checkTable (sel.project (cols), tab);
+  checkTable (tab.project (cols), tab);
+  // Sort on a column in reverse and normal order.
+  Table sorted = sel.sort ("SCA", Sort::Descending);
+  checkTable (sorted, tab);
+  AlwaysAssertExit (sorted.rowNumbers()[0] == 2999);
+  checkTable (sorted.sort ("SCA"), tab);
+  checkTable (sorted(sorted.col("SCA") < 2500), tab);
+  // Logical operations.
+  checkTable (sel & sel2, tab);
+  checkTable (sel | frag, tab);
+  checkTable (sel - sel2, tab);
+  checkTable (sel ^ frag, tab);
+  checkTable (!sel, tab);
+  checkLogic (sel, frag, tab);
+  checkLogic (sel2, sel, tab);
+  checkLogic (sorted, frag(frag.col("GRP") == 2), tab);
+  checkLogic (sel3, frag, tab);
+  // Iterate through the selection.
+  Block<String> names(1, "GRP");
+  TableIterator iter(sel, names);
+  uInt ngroup = 0;
+  while (!iter.pastEnd()) {
+    checkTable (iter.table(), tab);
+    ScalarColumn<Int> grp(iter.table(), "GRP");
+    AlwaysAssertExit (allEQ (grp.getColumn(), grp(0)));
+    iter.next();
+    ngroup++;
+  }
+  AlwaysAssertExit (ngroup == 2);
+  // Put data via the selection.
+  {
+    Table tabw("tRowRunMap_tmp.data", Table::Update);
+    Table selw = tabw(tabw.col("GRP") == 2);
+    ScalarColumn<Int> grp(selw, "GRP");
+    grp.putColumn (Vector<Int>(selw.nrow(), 4));
+    grp.putColumnCells (RefRows(0, 99), Vector<Int>(100, 5));
+    AlwaysAssertExit (tabw(tabw.col("GRP") == 4).nrow() == 900);
+    AlwaysAssertExit (tabw(tabw.col("GRP") == 5).nrow() == 100);
+    ScalarColumn<Int> tgrp(tabw, "GRP");
+    AlwaysAssertExit (tgrp(200) == 5  &&  tgrp(500) == 4);
+    // Remove a row from the selection.
+    selw.removeRow (0);
+    AlwaysAssertExit (selw.nrow() == 999  &&  selw.rowNumbers()[0] == 201);
+    checkTable (selw, tabw);
+  }
+  // Persist a selection and read it back.
+  {
+    Table tabr("tRowRunMap_tmp.data");
+    Table selr = tabr(tabr.col("SCA") >= 1000  &&  tabr.col("SCA") < 1300);
+    selr.rename ("tRowRunMap_tmp.sel", Table::New);
+  }
+  Table selr("tRowRunMap_tmp.sel");
+  AlwaysAssertExit (selr.nrow() == 300);
+  AlwaysAssertExit (selr.rowNumbers()[0] == 1000);
+  checkTable (selr, tab);
+}
+
+int main()
+{
+  try {
+    testMap();
+    testRefTable();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
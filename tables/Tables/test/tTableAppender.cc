@@ -0,0 +1,230 @@
+//# tTableAppender.cc: Test appending blocks of rows to a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableAppender.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test appending blocks of rows to a table using TableAppender.
+// </summary>
+
+// Create a table with scalar and array columns in a StandardStMan
+// (with small buckets, so blocks span several buckets) and a
+// TiledShapeStMan.
+void createTable (const String& name)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("ID"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<Bool>   ("FLAGROW"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  td.addColumn (ArrayColumnDesc<Double>  ("UVW", IPosition(1,3),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Bool>    ("SSMFLAG", IPosition(1,5),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Float>   ("WEIGHT", 1));
+  td.addColumn (ArrayColumnDesc<Complex> ("DATA", 2));
+  SetupNewTable newtab(name, td, Table::New);
+  StandardStMan ssm("SSM", 256);
+  newtab.bindAll (ssm);
+  TiledShapeStMan tsm("TSM", IPosition(3,4,8,16));
+  newtab.bindColumn ("DATA", tsm);
+  Table tab(newtab);
+}
+
+// Append a block of nrow rows with values based on the block number.
+void appendBlock (TableAppender& appender, Int block, rownr_t nrow)
+{
+  rownr_t first = appender.addRows (nrow);
+  AlwaysAssertExit (appender.firstRow() == first);
+  AlwaysAssertExit (appender.nrow() == nrow);
+  AlwaysAssertExit (appender.table().nrow() == first + nrow);
+  Vector<Int> ids(nrow);
+  indgen (ids, Int(first));
+  appender.putScalar ("ID", ids);
+  appender.fillScalar ("TIME", Double(block));
+  Vector<Bool> flagRow(nrow);
+  for (rownr_t i=0; i<nrow; ++i) {
+    flagRow[i] = ((first+i) % 3 == 0);
+  }
+  appender.putScalar ("FLAGROW", flagRow);
+  appender.fillScalar ("NAME", "block" + String::toString(block));
+  Matrix<Double> uvw(3, nrow);
+  indgen (uvw, Double(3*first));
+  appender.putArray ("UVW", uvw);
+  Matrix<Bool> flags(5, nrow);
+  for (size_t i=0; i<flags.size(); ++i) {
+    flags.data()[i] = ((5*first+i) % 7 == 0);
+  }
+  appender.putArray ("SSMFLAG", flags);
+  appender.fillArray ("WEIGHT", Vector<Float>(2+block%2, Float(block)));
+  Cube<Complex> data(4, 8, nrow);
+  indgen (data, Complex(32*first, 1));
+  appender.putArray ("DATA", data);
+}
+
+// Check the contents of all rows, cell by cell.
+void checkTable (const Table& tab, const Vector<rownr_t>& blockStarts)
+{
+  ScalarColumn<Int>    id(tab, "ID");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Bool>   flagRow(tab, "FLAGROW");
+  ScalarColumn<String> name(tab, "NAME");
+  ArrayColumn<Double>  uvw(tab, "UVW");
+  ArrayColumn<Bool>    flag(tab, "SSMFLAG");
+  ArrayColumn<Float>   weight(tab, "WEIGHT");
+  ArrayColumn<Complex> data(tab, "DATA");
+  Int block = -1;
+  for (rownr_t row=0; row<tab.nrow(); ++row) {
+    if (block+1 < Int(blockStarts.size())  &&  row == blockStarts[block+1]) {
+      block++;
+    }
+    AlwaysAssertExit (id(row) == Int(row));
+    AlwaysAssertExit (time(row) == block);
+    AlwaysAssertExit (flagRow(row) == (row%3 == 0));
+    AlwaysAssertExit (name(row) == "block" + String::toString(block));
+    Vector<Double> expUvw(3);
+    indgen (expUvw, Double(3*row));
+    AlwaysAssertExit (allEQ (uvw(row), expUvw));
+    Array<Bool> fl = flag(row);
+    for (size_t i=0; i<5; ++i) {
+      AlwaysAssertExit (fl.data()[i] == ((5*row+i) % 7 == 0));
+    }
+    AlwaysAssertExit (allEQ (weight(row),
+                             Vector<Float>(2+block%2, Float(block))));
+    Matrix<Complex> expData(4, 8);
+    indgen (expData, Complex(32*row, 1));
+    AlwaysAssertExit (allEQ (data(row), expData));
+  }
+}
+
+// Check reading the SSM columns in bulk with a stride.
+void checkStrided (const Table& tab)
+{
+  rownr_t nrow = tab.nrow();
+  RefRows rows(1, nrow-1, 3);
+  Vector<Int> ids = ScalarColumn<Int>(tab, "ID").getColumnCells (rows);
+  Vector<Bool> flagRow = ScalarColumn<Bool>(tab, "FLAGROW").getColumnCells
+    (rows);
+  Array<Bool> flags = ArrayColumn<Bool>(tab, "SSMFLAG").getColumnCells (rows);
+  AlwaysAssertExit (ids.size() == rows.nrow());
+  AlwaysAssertExit (flags.shape() == IPosition(2, 5, rows.nrow()));
+  for (rownr_t i=0; i<rows.nrow(); ++i) {
+    rownr_t row = 1 + 3*i;
+    AlwaysAssertExit (ids[i] == Int(row));
+    AlwaysAssertExit (flagRow[i] == (row%3 == 0));
+    for (size_t j=0; j<5; ++j) {
+      AlwaysAssertExit (flags.data()[5*i+j] == ((5*row+j) % 7 == 0));
+    }
+  }
+  // Write with a stride and check the result.
+  ScalarColumn<Bool> fcol(tab, "FLAGROW");
+  fcol.putColumnCells (rows, Vector<Bool>(rows.nrow(), True));
+  for (rownr_t row=0; row<nrow; ++row) {
+    AlwaysAssertExit (fcol(row) == ((row%3 == 0)  ||  (row%3 == 1)));
+  }
+}
+
+// Check that the number of values must match the block size.
+void checkErrors()
+{
+  createTable ("tTableAppender_tmp.err");
+  Table tab("tTableAppender_tmp.err", Table::Update);
+  TableAppender appender(tab);
+  appender.addRows (4);
+  Bool caught = False;
+  try {
+    appender.putScalar ("ID", Vector<Int>(3));
+  } catch (const TableConformanceError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+  caught = False;
+  try {
+    appender.putArray ("UVW", Matrix<Double>(3, 5));
+  } catch (const TableConformanceError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+}
+
+int main()
+{
+  try {
+    createTable ("tTableAppender_tmp.data");
+    // Use blocks of odd sizes to get Bool values at odd bit offsets.
+    Vector<rownr_t> sizes({17, 1, 100, 33, 250, 7});
+    Vector<rownr_t> starts(sizes.size());
+    {
+      Table tab("tTableAppender_tmp.data", Table::Update);
+      TableAppender appender(tab);
+      for (size_t i=0; i<sizes.size(); ++i) {
+        starts[i] = tab.nrow();
+        appendBlock (appender, i, sizes[i]);
+      }
+      checkTable (tab, starts);
+    }
+    {
+      Table tab("tTableAppender_tmp.data", Table::Update);
+      checkTable (tab, starts);
+      checkStrided (tab);
+    }
+    {
+      // A read-only table cannot be appended.
+      Table tab("tTableAppender_tmp.data");
+      Bool caught = False;
+      try {
+        TableAppender appender(tab);
+      } catch (const TableError&) {
+        caught = True;
+      }
+      AlwaysAssertExit (caught);
+    }
+    checkErrors();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,211 @@
+//# tTableCopyParallel.cc: Test copying the columns of a table in parallel
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableLocker.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScaRecordColDesc.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test copying the rows of a table column by column, in parallel or not.
+// </summary>
+
+// Create a table with columns in various storage managers.
+// The array column VARDATA has a varying shape and some undefined cells.
+void createTable (const String& name, rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("ID"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  td.addColumn (ScalarColumnDesc<Int>    ("ANT"));
+  td.addColumn (ArrayColumnDesc<Complex> ("DATA", IPosition(2,4,8),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Float>   ("VARDATA", 1));
+  td.addColumn (ArrayColumnDesc<Bool>    ("FLAG", 2));
+  td.addColumn (ScalarRecordColumnDesc   ("REC"));
+  SetupNewTable newtab(name, td, Table::New);
+  IncrementalStMan ism("ISM");
+  TiledShapeStMan tsm1("TSM1", IPosition(3,4,8,16));
+  TiledShapeStMan tsm2("TSM2", IPosition(3,4,8,16));
+  newtab.bindColumn ("ANT", ism);
+  newtab.bindColumn ("DATA", tsm1);
+  newtab.bindColumn ("FLAG", tsm2);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int>    id(tab, "ID");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<String> nm(tab, "NAME");
+  ScalarColumn<Int>    ant(tab, "ANT");
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Float>   vardata(tab, "VARDATA");
+  ArrayColumn<Bool>    flag(tab, "FLAG");
+  ScalarColumn<TableRecord> rec(tab, "REC");
+  Matrix<Complex> arr(4,8);
+  Matrix<Bool> farr(4,8);
+  for (rownr_t row=0; row<nrow; ++row) {
+    id.put (row, row);
+    time.put (row, 1e9 + row*0.5);
+    nm.put (row, "name" + String::toString(row%7));
+    ant.put (row, row/10);
+    indgen (arr, Complex(row, -Float(row)));
+    data.put (row, arr);
+    if (row%5 != 3) {
+      Vector<Float> vec(1 + row%3);
+      indgen (vec, Float(row));
+      vardata.put (row, vec);
+    }
+    farr = (row%2 == 0);
+    flag.put (row, farr);
+    TableRecord r;
+    r.define ("row", Int(row));
+    rec.put (row, r);
+  }
+}
+
+// Check that the given rows of both tables have the same contents.
+void checkTable (const Table& out, const Table& in,
+                 rownr_t startout, rownr_t startin, rownr_t nrow)
+{
+  ScalarColumn<Int>    id1(in, "ID"), id2(out, "ID");
+  ScalarColumn<Double> time1(in, "TIME"), time2(out, "TIME");
+  ScalarColumn<String> nm1(in, "NAME"), nm2(out, "NAME");
+  ScalarColumn<Int>    ant1(in, "ANT"), ant2(out, "ANT");
+  ArrayColumn<Complex> data1(in, "DATA"), data2(out, "DATA");
+  ArrayColumn<Float>   var1(in, "VARDATA"), var2(out, "VARDATA");
+  ArrayColumn<Bool>    flag1(in, "FLAG"), flag2(out, "FLAG");
+  ScalarColumn<TableRecord> rec1(in, "REC"), rec2(out, "REC");
+  for (rownr_t i=0; i<nrow; ++i) {
+    rownr_t r1 = startin + i;
+    rownr_t r2 = startout + i;
+    AlwaysAssertExit (id1(r1) == id2(r2));
+    AlwaysAssertExit (time1(r1) == time2(r2));
+    AlwaysAssertExit (nm1(r1) == nm2(r2));
+    AlwaysAssertExit (ant1(r1) == ant2(r2));
+    AlwaysAssertExit (allEQ (data1(r1), data2(r2)));
+    AlwaysAssertExit (var1.isDefined(r1) == var2.isDefined(r2));
+    if (var1.isDefined(r1)) {
+      AlwaysAssertExit (allEQ (var1(r1), var2(r2)));
+    }
+    AlwaysAssertExit (allEQ (flag1(r1), flag2(r2)));
+    AlwaysAssertExit (rec1(r1).asInt("row") == rec2(r2).asInt("row"));
+  }
+}
+
+// Copy the rows into an empty table with the same layout.
+void testCopy (const Table& in, uInt nthreads, rownr_t startin, rownr_t nrow)
+{
+  TableCopy::setNThreads (nthreads);
+  AlwaysAssertExit (TableCopy::nthreads() == nthreads);
+  Table out = TableCopy::makeEmptyTable ("tTableCopyParallel_tmp.out",
+                                         Record(), in, Table::New,
+                                         Table::AipsrcEndian, True, True,
+                                         StorageOption(),
+                                         TableLock(TableLock::UserLocking));
+  AlwaysAssertExit (out.nrow() == 0);
+  TableLocker locker(out, FileLocker::Write);
+  // Copy in two parts to test the start rows.
+  rownr_t n1 = nrow/3;
+  TableCopy::copyRows (out, in, 0, startin, n1);
+  TableCopy::copyRows (out, in, n1, startin+n1, nrow-n1);
+  AlwaysAssertExit (out.nrow() == nrow);
+  checkTable (out, in, 0, startin, nrow);
+}
+
+// Copy to a table where a column has another data type.
+void testPromotion (const Table& in)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double> ("ID"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ArrayColumnDesc<DComplex> ("DATA", 2));
+  SetupNewTable newtab("tTableCopyParallel_tmp.prom", td, Table::New);
+  Table out(newtab, TableLock::UserLocking);
+  TableLocker locker(out, FileLocker::Write);
+  TableCopy::copyRows (out, in);
+  AlwaysAssertExit (out.nrow() == in.nrow());
+  ScalarColumn<Int>     id1(in, "ID");
+  ScalarColumn<Double>  id2(out, "ID");
+  ArrayColumn<Complex>  data1(in, "DATA");
+  ArrayColumn<DComplex> data2(out, "DATA");
+  for (rownr_t row=0; row<in.nrow(); ++row) {
+    AlwaysAssertExit (id2(row) == id1(row));
+    Array<DComplex> arr(data1.shape(row));
+    convertArray (arr, data1(row));
+    AlwaysAssertExit (allEQ (data2(row), arr));
+  }
+}
+
+int main()
+{
+  try {
+    const rownr_t nrow = 5000;
+    createTable ("tTableCopyParallel_tmp.data", nrow);
+    {
+      // Use UserLocking, otherwise the copy is done serially.
+      Table in("tTableCopyParallel_tmp.data", TableLock::UserLocking);
+      TableLocker locker(in, FileLocker::Read);
+      for (uInt nthr : {1, 4, 0}) {
+        testCopy (in, nthr, 0, nrow);
+        testCopy (in, nthr, 1234, 2000);
+        // Copy a selection, thus from a RefTable.
+        Table sel = in(in.col("ID") % 3 != 0);
+        testCopy (sel, nthr, 10, sel.nrow() - 20);
+      }
+      testPromotion (in);
+    }
+    {
+      // Also copy from a table using AutoLocking.
+      Table in("tTableCopyParallel_tmp.data");
+      testCopy (in, 4, 0, nrow);
+      // A deep copy uses copyRows as well.
+      in.deepCopy ("tTableCopyParallel_tmp.deep", Table::New, True);
+      Table deep("tTableCopyParallel_tmp.deep");
+      AlwaysAssertExit (deep.nrow() == nrow);
+      checkTable (deep, in, 0, 0, nrow);
+    }
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
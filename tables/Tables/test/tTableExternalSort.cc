@@ -0,0 +1,179 @@
+//# tTableExternalSort.cc: Test program for the external table sort
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableExternalSort.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/TableIter.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/EnvVar.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for the external merge sort used by Table::sort if
+// the sort keys do not fit in the memory budget.
+// </summary>
+
+// Create a table with columns like the MSIter sort keys.
+void createTable (const String& name, rownr_t nrrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("FIELD_ID"));
+  td.addColumn (ScalarColumnDesc<Int> ("ANTENNA"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  SetupNewTable newtab(name, td, Table::New);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int> field(tab, "FIELD_ID");
+  ScalarColumn<Int> ant(tab, "ANTENNA");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<String> nm(tab, "NAME");
+  uInt seed = 1;
+  for (rownr_t i=0; i<nrrow; ++i) {
+    seed = seed * 1103515245 + 12345;
+    field.put (i, (seed >> 16) % 4);
+    ant.put (i, i % 63);
+    time.put (i, 4.5e9 + 10*(i/200));
+    // Also use empty strings.
+    uInt nmval = (seed >> 8) % 17;
+    nm.put (i, nmval == 0  ?  String() : "name" + String::toString(nmval));
+  }
+}
+
+// Sort with and without the memory budget and check the results are equal.
+void checkSort (const Table& tab, const Block<String>& keys,
+                const Block<Int>& orders, int option)
+{
+  TableExternalSort::setMemoryBudget (0);
+  Table sort1 = tab.sort (keys, orders, option);
+  TableExternalSort::setMemoryBudget (64*1024);
+  Table sort2 = tab.sort (keys, orders, option);
+  AlwaysAssertExit (sort1.nrow() == sort2.nrow());
+  if ((option & Sort::NoDuplicates) == 0) {
+    AlwaysAssertExit (allEQ (sort1.rowNumbers(), sort2.rowNumbers()));
+  } else {
+    // Which row of equal keys is kept depends on the sort algorithm,
+    // so only check the keys.
+    for (uInt i=0; i<keys.size(); ++i) {
+      TableColumn col1(sort1, keys[i]);
+      TableColumn col2(sort2, keys[i]);
+      for (rownr_t row=0; row<sort1.nrow(); ++row) {
+        AlwaysAssertExit (col1.asdouble(row) == col2.asdouble(row));
+      }
+    }
+  }
+}
+
+// Iterate with and without the memory budget and check the groups.
+void checkIter (const Table& tab, const Block<String>& keys)
+{
+  Block<std::shared_ptr<BaseCompare>> cmpObjs(keys.size());
+  Block<Int> orders(keys.size(), TableIterator::Ascending);
+  TableExternalSort::setMemoryBudget (0);
+  TableIterator iter1 (tab, keys, cmpObjs, orders, TableIterator::ParSort,
+                       true);
+  TableExternalSort::setMemoryBudget (64*1024);
+  TableIterator iter2 (tab, keys, cmpObjs, orders, TableIterator::ParSort,
+                       true);
+  uInt ngroup = 0;
+  while (!iter1.pastEnd()) {
+    AlwaysAssertExit (!iter2.pastEnd());
+    AlwaysAssertExit (allEQ (iter1.table().rowNumbers(),
+                             iter2.table().rowNumbers()));
+    iter1.next();
+    iter2.next();
+    ngroup++;
+  }
+  AlwaysAssertExit (iter2.pastEnd());
+  AlwaysAssertExit (ngroup > 1);
+}
+
+void testSort (const String& name)
+{
+  Table tab(name);
+  // The budget of 64 KB results in many runs.
+  Block<String> keys(1, "TIME");
+  Block<Int> asc(1, Sort::Ascending);
+  Block<Int> desc(1, Sort::Descending);
+  checkSort (tab, keys, asc, Sort::ParSort);
+  checkSort (tab, keys, desc, Sort::ParSort);
+  checkSort (tab, keys, asc, Sort::QuickSort | Sort::NoDuplicates);
+  // Sort on the MSIter keys with mixed orders.
+  keys.resize (3);
+  keys[0] = "FIELD_ID";
+  keys[1] = "ANTENNA";
+  keys[2] = "TIME";
+  Block<Int> orders(3, Sort::Ascending);
+  checkSort (tab, keys, orders, Sort::ParSort);
+  checkSort (tab, keys, orders, Sort::HeapSort | Sort::NoDuplicates);
+  orders[1] = Sort::Descending;
+  checkSort (tab, keys, orders, Sort::ParSort);
+  orders = Block<Int>(3, Sort::Descending);
+  checkSort (tab, keys, orders, Sort::ParSort);
+  checkSort (tab, keys, orders, Sort::QuickSort | Sort::NoDuplicates);
+  // Sort on a string column.
+  keys.resize (2, True, True);
+  keys[1] = "NAME";
+  orders.resize (2, True, True);
+  checkSort (tab, keys, orders, Sort::ParSort);
+  // Sort a selection (thus a RefTable).
+  Table sel = tab(tab.col("ANTENNA") > 10);
+  checkSort (sel, keys, orders, Sort::ParSort);
+  // Iterate (which uses the iteration boundaries of the sort).
+  keys.resize (3, True, True);
+  keys[2] = "TIME";
+  checkIter (tab, keys);
+  checkIter (sel, keys);
+}
+
+int main()
+{
+  try {
+    // Put the scratch files in a separate directory to check they are
+    // removed.
+    Directory dir("tTableExternalSort_tmp.dir");
+    dir.create();
+    EnvironmentVariable::set ("TMPDIR", dir.path().absoluteName());
+    createTable ("tTableExternalSort_tmp.data", 50000);
+    testSort ("tTableExternalSort_tmp.data");
+    AlwaysAssertExit (dir.isEmpty());
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  TableExternalSort::setMemoryBudget (0);
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,208 @@
+//# tTableMetrics.cc: Test program for class TableMetrics
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableMetrics.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/casa/Json/JsonOut.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+
+#include <casacore/casa/namespace.h>
+
+// This program tests the class TableMetrics.
+
+void testHistogram()
+{
+  // Small values are kept exactly.
+  for (uInt64 i=0; i<16; ++i) {
+    AlwaysAssertExit (LatencyHistogram::binIndex(i) == i);
+    AlwaysAssertExit (LatencyHistogram::binStart(i) == i);
+  }
+  // Each power of 2 has 8 bins.
+  AlwaysAssertExit (LatencyHistogram::binIndex(16) == 16);
+  AlwaysAssertExit (LatencyHistogram::binIndex(17) == 16);
+  AlwaysAssertExit (LatencyHistogram::binIndex(18) == 17);
+  AlwaysAssertExit (LatencyHistogram::binIndex(31) == 23);
+  AlwaysAssertExit (LatencyHistogram::binIndex(32) == 24);
+  AlwaysAssertExit (LatencyHistogram::binIndex(1000) == 63);
+  AlwaysAssertExit (LatencyHistogram::binStart(63) == 960);
+  AlwaysAssertExit (LatencyHistogram::binIndex(~uInt64(0)) ==
+                    LatencyHistogram::NBINS - 1);
+  // Each value must be in the bin starting at or before it.
+  for (uInt64 v=1; v<1000000000; v=v*3+1) {
+    uInt bin = LatencyHistogram::binIndex(v);
+    AlwaysAssertExit (LatencyHistogram::binStart(bin) <= v);
+    AlwaysAssertExit (LatencyHistogram::binStart(bin+1) > v);
+  }
+  LatencyHistogram hist;
+  AlwaysAssertExit (hist.count() == 0  &&  hist.min() == 0);
+  AlwaysAssertExit (hist.quantile(0.5) == 0);
+  for (uInt64 i=1; i<=100; ++i) {
+    hist.add (i*100);
+  }
+  AlwaysAssertExit (hist.count() == 100);
+  AlwaysAssertExit (hist.sum() == 505000);
+  AlwaysAssertExit (hist.min() == 100  &&  hist.max() == 10000);
+  // The quantiles have a precision of 12.5%.
+  uInt64 p50 = hist.quantile(0.5);
+  AlwaysAssertExit (p50 >= 5000  &&  p50 <= 5000*1.125);
+  uInt64 p99 = hist.quantile(0.99);
+  AlwaysAssertExit (p99 >= 9900  &&  p99 <= 10000);
+  AlwaysAssertExit (hist.quantile(1.) == 10000);
+  hist.clear();
+  AlwaysAssertExit (hist.count() == 0  &&  hist.max() == 0);
+}
+
+void createTable (const String& name, rownr_t nrrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ANTENNA"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", IPosition(1,16),
+                                        ColumnDesc::Direct));
+  SetupNewTable newtab(name, td, Table::New);
+  StandardStMan ssm("SSM", -32);
+  newtab.bindAll (ssm);
+  IncrementalStMan ism;
+  newtab.bindColumn ("TIME", ism);
+  Table tab(newtab, nrrow);
+  ScalarColumn<Int> ant(tab, "ANTENNA");
+  ScalarColumn<Double> time(tab, "TIME");
+  ArrayColumn<Float> data(tab, "DATA");
+  Vector<Float> vec(16);
+  for (rownr_t i=0; i<nrrow; ++i) {
+    ant.put (i, i%10);
+    time.put (i, i/10);
+    vec = i;
+    data.put (i, vec);
+  }
+}
+
+void readTable (const String& name, rownr_t nrrow)
+{
+  Table tab(name);
+  ScalarColumn<Int> ant(tab, "ANTENNA");
+  ArrayColumn<Float> data(tab, "DATA");
+  for (rownr_t i=0; i<nrrow; ++i) {
+    AlwaysAssertExit (ant(i) == Int(i%10));
+    AlwaysAssertExit (data(i).data()[0] == i);
+  }
+  Vector<Int> antCol = ant.getColumn();
+  AlwaysAssertExit (antCol.size() == nrrow);
+}
+
+void testTable()
+{
+  const rownr_t nrrow = 500;
+  createTable ("tTableMetrics_tmp.tab", nrrow);
+  readTable ("tTableMetrics_tmp.tab", nrrow);
+  std::ostringstream ostr;
+  {
+    JsonOut jout(ostr);
+    TableMetrics::write (jout);
+  }
+  String json(ostr.str());
+  // The table and its columns must be present.
+  AlwaysAssertExit (json.contains ("tTableMetrics_tmp.tab"));
+  AlwaysAssertExit (json.contains ("\"ANTENNA\""));
+  AlwaysAssertExit (json.contains ("\"DATA\""));
+  AlwaysAssertExit (json.contains ("\"TIME\""));
+  // 500 puts and gets of a DATA cell. Note that scalar gets can be
+  // served by the column cache, thus not by the data manager.
+  AlwaysAssertExit (json.contains ("\"cells_read\": 500"));
+  AlwaysAssertExit (json.contains ("\"cells_written\": 500"));
+  // DATA has 500 cells of 16 floats.
+  AlwaysAssertExit (json.contains ("\"bytes_written\": 32000"));
+  AlwaysAssertExit (json.contains ("\"bytes_read\": 32000"));
+  AlwaysAssertExit (json.contains ("\"read_latency\""));
+  AlwaysAssertExit (json.contains ("\"p99_ns\""));
+  // The cache statistics of both data managers must be present.
+  AlwaysAssertExit (json.contains ("\"SSM\""));
+  AlwaysAssertExit (json.contains ("\"IncrementalStMan_"));
+  AlwaysAssertExit (json.contains ("\"evictions\""));
+  // After clearing the counters must be zero.
+  TableMetrics::clear();
+  std::ostringstream ostr2;
+  {
+    JsonOut jout(ostr2);
+    TableMetrics::write (jout);
+  }
+  String json2(ostr2.str());
+  AlwaysAssertExit (! json2.contains ("\"cells_read\": 500"));
+  AlwaysAssertExit (json2.contains ("\"cells_read\": 0"));
+  AlwaysAssertExit (! json2.contains ("\"SSM\""));
+  // Reading again accumulates for the same table.
+  readTable ("tTableMetrics_tmp.tab", nrrow);
+  std::ostringstream ostr3;
+  {
+    JsonOut jout(ostr3);
+    TableMetrics::write (jout);
+  }
+  String json3(ostr3.str());
+  AlwaysAssertExit (json3.contains ("\"cells_read\": 500"));
+  AlwaysAssertExit (json3.contains ("\"SSM\""));
+}
+
+void testDisabled()
+{
+  // Tables opened when disabled are not measured.
+  TableMetrics::setEnabled (False);
+  AlwaysAssertExit (! TableMetrics::enabled());
+  AlwaysAssertExit (TableMetrics::column ("a", "b", 4) == 0);
+  createTable ("tTableMetrics_tmp.tab2", 10);
+  TableMetrics::setEnabled (True);
+  std::ostringstream ostr;
+  {
+    JsonOut jout(ostr);
+    TableMetrics::write (jout);
+  }
+  AlwaysAssertExit (! String(ostr.str()).contains ("tTableMetrics_tmp.tab2"));
+}
+
+int main()
+{
+  try {
+    testHistogram();
+    TableMetrics::setEnabled (True);
+    testTable();
+    testDisabled();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}